@@ -0,0 +1,438 @@
+#include "BlockCompression.h"
+#include "../../Core/JobSystem.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace Orca
+{
+	namespace
+	{
+		// BC7 index weights, out of 64.
+		constexpr int k_BC7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		// The block as one float array per channel, so four texels go through each SSE operation.
+		struct BlockSoA
+		{
+			alignas(16) float Channel[4][16];
+		};
+
+		void ToSoA(const uint8_t* rgba, BlockSoA& block)
+		{
+			for (int i = 0; i < 16; ++i)
+			{
+				for (int c = 0; c < 4; ++c)
+				{
+					block.Channel[c][i] = rgba[i * 4 + c];
+				}
+			}
+		}
+
+		// Writes, for every texel, its position t along start + t * axis.
+		void Project(const BlockSoA& block, int channels, const float* start, const float* axis, float* t)
+		{
+			float lengthSq = 0.0f;
+			for (int c = 0; c < channels; ++c)
+			{
+				lengthSq += axis[c] * axis[c];
+			}
+
+			if (lengthSq < 1e-6f)
+			{
+				std::fill(t, t + 16, 0.0f);
+				return;
+			}
+
+			const __m128 scale = _mm_set1_ps(1.0f / lengthSq);
+			for (int i = 0; i < 16; i += 4)
+			{
+				__m128 dot = _mm_setzero_ps();
+				for (int c = 0; c < channels; ++c)
+				{
+					const __m128 offset = _mm_sub_ps(_mm_load_ps(&block.Channel[c][i]), _mm_set1_ps(start[c]));
+					dot = _mm_add_ps(dot, _mm_mul_ps(offset, _mm_set1_ps(axis[c])));
+				}
+				_mm_storeu_ps(&t[i], _mm_mul_ps(dot, scale));
+			}
+		}
+
+		// Endpoints at the extremes of the principal axis (power iteration on the covariance),
+		// pulled in by insetFraction of the range to cut the error at the ends.
+		void FitEndpoints(const BlockSoA& block, int channels, float insetFraction, float* low, float* high)
+		{
+			float mean[4] = {};
+			for (int c = 0; c < channels; ++c)
+			{
+				for (int i = 0; i < 16; ++i)
+				{
+					mean[c] += block.Channel[c][i];
+				}
+				mean[c] /= 16.0f;
+			}
+
+			float covariance[4][4] = {};
+			for (int i = 0; i < 16; ++i)
+			{
+				for (int a = 0; a < channels; ++a)
+				{
+					for (int b = a; b < channels; ++b)
+					{
+						covariance[a][b] += (block.Channel[a][i] - mean[a]) * (block.Channel[b][i] - mean[b]);
+					}
+				}
+			}
+			for (int a = 0; a < channels; ++a)
+			{
+				for (int b = 0; b < a; ++b)
+				{
+					covariance[a][b] = covariance[b][a];
+				}
+			}
+
+			float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			for (int iteration = 0; iteration < 8; ++iteration)
+			{
+				float next[4] = {};
+				float largest = 0.0f;
+				for (int a = 0; a < channels; ++a)
+				{
+					for (int b = 0; b < channels; ++b)
+					{
+						next[a] += covariance[a][b] * axis[b];
+					}
+					largest = std::max(largest, std::abs(next[a]));
+				}
+
+				if (largest < 1e-6f)
+				{
+					break;
+				}
+				for (int c = 0; c < channels; ++c)
+				{
+					axis[c] = next[c] / largest;
+				}
+			}
+
+			float t[16];
+			Project(block, channels, mean, axis, t);
+			float minT = *std::min_element(t, t + 16);
+			float maxT = *std::max_element(t, t + 16);
+
+			const float inset = (maxT - minT) * insetFraction;
+			minT += inset;
+			maxT -= inset;
+
+			for (int c = 0; c < channels; ++c)
+			{
+				low[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+				high[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			}
+		}
+
+		uint16_t To565(const float* color)
+		{
+			const int r = static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f);
+			const int g = static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f);
+			const int b = static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f);
+			return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		void From565(uint16_t value, float* color)
+		{
+			const int r = (value >> 11) & 31;
+			const int g = (value >> 5) & 63;
+			const int b = value & 31;
+			color[0] = static_cast<float>((r << 3) | (r >> 2));
+			color[1] = static_cast<float>((g << 2) | (g >> 4));
+			color[2] = static_cast<float>((b << 3) | (b >> 2));
+		}
+
+		void WriteLittleEndian(uint8_t* out, uint64_t value, int bytes)
+		{
+			for (int i = 0; i < bytes; ++i)
+			{
+				out[i] = static_cast<uint8_t>(value >> (i * 8));
+			}
+		}
+
+		// 4-colour BC1 block; BC3 reuses it for colour, where the 3-colour mode doesn't exist.
+		void EncodeColorBlock(const BlockSoA& block, uint8_t* out)
+		{
+			float low[4], high[4];
+			FitEndpoints(block, 3, 1.0f / 32.0f, low, high);
+
+			uint16_t color0 = To565(high);
+			uint16_t color1 = To565(low);
+			if (color0 < color1)
+			{
+				std::swap(color0, color1);
+			}
+
+			uint32_t indices = 0;
+			if (color0 != color1)
+			{
+				float start[4], end[4], axis[4];
+				From565(color0, start);
+				From565(color1, end);
+				for (int c = 0; c < 3; ++c)
+				{
+					axis[c] = end[c] - start[c];
+				}
+
+				float t[16];
+				Project(block, 3, start, axis, t);
+
+				// Palette order is color0, color1, 2/3 color0 + 1/3 color1, 1/3 color0 + 2/3 color1.
+				static constexpr uint32_t k_Order[4] = { 0, 2, 3, 1 };
+				for (int i = 0; i < 16; ++i)
+				{
+					const int step = std::clamp(static_cast<int>(t[i] * 3.0f + 0.5f), 0, 3);
+					indices |= k_Order[step] << (i * 2);
+				}
+			}
+
+			WriteLittleEndian(out, color0, 2);
+			WriteLittleEndian(out + 2, color1, 2);
+			WriteLittleEndian(out + 4, indices, 4);
+		}
+
+		// One channel in the 8-value mode (BC4, also the alpha of BC3 and each half of BC5).
+		void EncodeChannelBlock(const BlockSoA& block, int channel, uint8_t* out)
+		{
+			const float* values = block.Channel[channel];
+			const uint8_t high = static_cast<uint8_t>(*std::max_element(values, values + 16));
+			const uint8_t low = static_cast<uint8_t>(*std::min_element(values, values + 16));
+
+			uint64_t indices = 0;
+			if (high > low)
+			{
+				// Palette order is high, low, then six steps from high towards low.
+				const float scale = 7.0f / static_cast<float>(high - low);
+				for (int i = 0; i < 16; ++i)
+				{
+					const int step = std::clamp(static_cast<int>((high - values[i]) * scale + 0.5f), 0, 7);
+					const uint64_t code = step == 0 ? 0 : step == 7 ? 1 : static_cast<uint64_t>(step + 1);
+					indices |= code << (i * 3);
+				}
+			}
+
+			out[0] = high;
+			out[1] = low;
+			WriteLittleEndian(out + 2, indices, 6);
+		}
+
+		class BitWriter
+		{
+		public:
+			explicit BitWriter(uint8_t* out) : m_Out(out) { std::memset(out, 0, 16); }
+
+			void Write(uint32_t value, int bits)
+			{
+				for (int i = 0; i < bits; ++i, ++m_Position)
+				{
+					if (value & (1u << i))
+					{
+						m_Out[m_Position >> 3] |= static_cast<uint8_t>(1u << (m_Position & 7));
+					}
+				}
+			}
+
+		private:
+			uint8_t* m_Out;
+			int m_Position = 0;
+		};
+
+		// 7 bits per channel plus a p-bit shared by the endpoint's channels; picks the p-bit that
+		// reproduces the endpoint best.
+		void QuantizeBC7Endpoint(const float* endpoint, uint32_t* quantized, uint32_t& pBit)
+		{
+			float bestError = 1e30f;
+			for (uint32_t p = 0; p < 2; ++p)
+			{
+				uint32_t candidate[4];
+				float error = 0.0f;
+				for (int c = 0; c < 4; ++c)
+				{
+					candidate[c] = static_cast<uint32_t>(std::clamp(static_cast<int>((endpoint[c] - p) * 0.5f + 0.5f), 0, 127));
+					const float difference = static_cast<float>(candidate[c] * 2 + p) - endpoint[c];
+					error += difference * difference;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+					pBit = p;
+					std::copy(candidate, candidate + 4, quantized);
+				}
+			}
+		}
+	}
+
+	bool IsBlockCompressed(TextureFormat format)
+	{
+		return format != TextureFormat::RGBA8;
+	}
+
+	uint32_t GetBlockBytes(TextureFormat format)
+	{
+		switch (format)
+		{
+		case TextureFormat::BC1: return 8;
+		case TextureFormat::BC3:
+		case TextureFormat::BC5:
+		case TextureFormat::BC7: return 16;
+		default: return 4;
+		}
+	}
+
+	size_t GetImageBytes(TextureFormat format, uint32_t width, uint32_t height)
+	{
+		if (!IsBlockCompressed(format))
+		{
+			return size_t(width) * height * 4;
+		}
+		return size_t((width + 3) / 4) * ((height + 3) / 4) * GetBlockBytes(format);
+	}
+
+	namespace BlockCompression
+	{
+		void EncodeBC1(const uint8_t* rgba, uint8_t* out)
+		{
+			BlockSoA block;
+			ToSoA(rgba, block);
+			EncodeColorBlock(block, out);
+		}
+
+		void EncodeBC3(const uint8_t* rgba, uint8_t* out)
+		{
+			BlockSoA block;
+			ToSoA(rgba, block);
+			EncodeChannelBlock(block, 3, out);
+			EncodeColorBlock(block, out + 8);
+		}
+
+		void EncodeBC5(const uint8_t* rgba, uint8_t* out)
+		{
+			BlockSoA block;
+			ToSoA(rgba, block);
+			EncodeChannelBlock(block, 0, out);
+			EncodeChannelBlock(block, 1, out + 8);
+		}
+
+		void EncodeBC7(const uint8_t* rgba, uint8_t* out)
+		{
+			BlockSoA block;
+			ToSoA(rgba, block);
+
+			float low[4], high[4];
+			FitEndpoints(block, 4, 1.0f / 64.0f, low, high);
+
+			uint32_t endpoints[2][4];
+			uint32_t pBits[2];
+			QuantizeBC7Endpoint(low, endpoints[0], pBits[0]);
+			QuantizeBC7Endpoint(high, endpoints[1], pBits[1]);
+
+			float start[4], axis[4];
+			for (int c = 0; c < 4; ++c)
+			{
+				start[c] = static_cast<float>(endpoints[0][c] * 2 + pBits[0]);
+				axis[c] = static_cast<float>(endpoints[1][c] * 2 + pBits[1]) - start[c];
+			}
+
+			float t[16];
+			Project(block, 4, start, axis, t);
+
+			uint32_t indices[16];
+			for (int i = 0; i < 16; ++i)
+			{
+				const float target = std::clamp(t[i], 0.0f, 1.0f) * 64.0f;
+				uint32_t best = 0;
+				while (best < 15 && std::abs(k_BC7Weights[best + 1] - target) <= std::abs(k_BC7Weights[best] - target))
+				{
+					best++;
+				}
+				indices[i] = best;
+			}
+
+			// The first index is stored without its top bit; the weights are symmetric, so swapping
+			// the endpoints and mirroring every index keeps the block identical.
+			if (indices[0] & 8)
+			{
+				std::swap(endpoints[0], endpoints[1]);
+				std::swap(pBits[0], pBits[1]);
+				for (uint32_t& index : indices)
+				{
+					index = 15 - index;
+				}
+			}
+
+			BitWriter bits(out);
+			bits.Write(1u << 6, 7);
+			for (int c = 0; c < 4; ++c)
+			{
+				bits.Write(endpoints[0][c], 7);
+				bits.Write(endpoints[1][c], 7);
+			}
+			bits.Write(pBits[0], 1);
+			bits.Write(pBits[1], 1);
+			bits.Write(indices[0], 3);
+			for (int i = 1; i < 16; ++i)
+			{
+				bits.Write(indices[i], 4);
+			}
+		}
+
+		std::vector<uint8_t> CompressImage(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height)
+		{
+			if (!IsBlockCompressed(format))
+			{
+				return std::vector<uint8_t>(rgba, rgba + size_t(width) * height * 4);
+			}
+
+			void (*encode)(const uint8_t*, uint8_t*) =
+				format == TextureFormat::BC1 ? EncodeBC1 :
+				format == TextureFormat::BC3 ? EncodeBC3 :
+				format == TextureFormat::BC5 ? EncodeBC5 : EncodeBC7;
+
+			const uint32_t blocksX = (width + 3) / 4;
+			const uint32_t blocksY = (height + 3) / 4;
+			const uint32_t blockBytes = GetBlockBytes(format);
+			std::vector<uint8_t> compressed(size_t(blocksX) * blocksY * blockBytes);
+
+			auto encodeRows = [&](unsigned int, size_t begin, size_t end)
+				{
+					uint8_t texels[64];
+					for (size_t by = begin; by < end; ++by)
+					{
+						for (uint32_t bx = 0; bx < blocksX; ++bx)
+						{
+							for (uint32_t y = 0; y < 4; ++y)
+							{
+								const uint32_t sourceY = std::min(static_cast<uint32_t>(by) * 4 + y, height - 1);
+								for (uint32_t x = 0; x < 4; ++x)
+								{
+									const uint32_t sourceX = std::min(bx * 4 + x, width - 1);
+									std::memcpy(&texels[(y * 4 + x) * 4], &rgba[(size_t(sourceY) * width + sourceX) * 4], 4);
+								}
+							}
+
+							encode(texels, &compressed[(by * blocksX + bx) * blockBytes]);
+						}
+					}
+				};
+
+			if (JobSystem::IsInitialized())
+			{
+				JobSystem::ParallelFor(blocksY, 4, encodeRows);
+			}
+			else
+			{
+				encodeRows(0, 0, blocksY);
+			}
+
+			return compressed;
+		}
+	}
+}
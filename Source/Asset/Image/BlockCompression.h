@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef BLOCK_COMPRESSION_H
+#define BLOCK_COMPRESSION_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "../../OrcaAPI.h"
+
+namespace Orca
+{
+	enum class TextureFormat : uint32_t
+	{
+		RGBA8,
+		BC1,	// RGB, 4 bpp
+		BC3,	// RGBA, 8 bpp
+		BC5,	// Two channels (normal map XY), 8 bpp
+		BC7		// RGBA, 8 bpp, best quality
+	};
+
+	ORCA_API bool IsBlockCompressed(TextureFormat format);
+
+	// Bytes per 4x4 block, or per texel for RGBA8.
+	ORCA_API uint32_t GetBlockBytes(TextureFormat format);
+
+	ORCA_API size_t GetImageBytes(TextureFormat format, uint32_t width, uint32_t height);
+
+	// Each encoder takes one 4x4 block of RGBA8 texels in row order.
+	namespace BlockCompression
+	{
+		ORCA_API void EncodeBC1(const uint8_t* rgba, uint8_t* out);
+		ORCA_API void EncodeBC3(const uint8_t* rgba, uint8_t* out);
+		ORCA_API void EncodeBC5(const uint8_t* rgba, uint8_t* out);	// Red and green
+		ORCA_API void EncodeBC7(const uint8_t* rgba, uint8_t* out);	// Mode 6 only
+
+		// Compresses a whole RGBA8 image; partial edge blocks repeat their last row and column.
+		// Rows of blocks are spread over the job system when it is running.
+		ORCA_API std::vector<uint8_t> CompressImage(TextureFormat format, const uint8_t* rgba, uint32_t width, uint32_t height);
+	}
+}
+
+#endif
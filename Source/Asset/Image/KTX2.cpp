@@ -0,0 +1,365 @@
+#include "KTX2.h"
+#include "../../Core/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint8_t k_Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+		constexpr size_t k_HeaderBytes = 80;			// Identifier, header and index
+		constexpr size_t k_LevelIndexBytes = 24;
+
+		// VkFormat values.
+		constexpr uint32_t k_VkR8G8B8A8Unorm = 37;
+		constexpr uint32_t k_VkR8G8B8A8Srgb = 43;
+		constexpr uint32_t k_VkBC1RGBUnorm = 131;
+		constexpr uint32_t k_VkBC1RGBSrgb = 132;
+		constexpr uint32_t k_VkBC3Unorm = 137;
+		constexpr uint32_t k_VkBC3Srgb = 138;
+		constexpr uint32_t k_VkBC5Unorm = 141;
+		constexpr uint32_t k_VkBC7Unorm = 145;
+		constexpr uint32_t k_VkBC7Srgb = 146;
+
+		// Data format descriptor values (Khronos Data Format Specification).
+		constexpr uint32_t k_ModelRGBSDA = 1;
+		constexpr uint32_t k_ModelBC1A = 128;
+		constexpr uint32_t k_ModelBC3 = 130;
+		constexpr uint32_t k_ModelBC5 = 132;
+		constexpr uint32_t k_ModelBC7 = 134;
+		constexpr uint32_t k_PrimariesBT709 = 1;
+		constexpr uint32_t k_TransferLinear = 1;
+		constexpr uint32_t k_TransferSRGB = 2;
+		constexpr uint32_t k_ChannelAlpha = 15;
+		constexpr uint32_t k_SampleLinear = 0x10;		// Alpha stays linear in sRGB formats
+
+		struct LevelIndex
+		{
+			uint64_t Offset;
+			uint64_t Length;
+		};
+
+		uint32_t GetVkFormat(TextureFormat format, bool srgb)
+		{
+			switch (format)
+			{
+			case TextureFormat::BC1: return srgb ? k_VkBC1RGBSrgb : k_VkBC1RGBUnorm;
+			case TextureFormat::BC3: return srgb ? k_VkBC3Srgb : k_VkBC3Unorm;
+			case TextureFormat::BC5: return k_VkBC5Unorm;
+			case TextureFormat::BC7: return srgb ? k_VkBC7Srgb : k_VkBC7Unorm;
+			default: return srgb ? k_VkR8G8B8A8Srgb : k_VkR8G8B8A8Unorm;
+			}
+		}
+
+		bool FromVkFormat(uint32_t vkFormat, TextureFormat& format, bool& srgb)
+		{
+			switch (vkFormat)
+			{
+			case k_VkR8G8B8A8Unorm: format = TextureFormat::RGBA8; srgb = false; return true;
+			case k_VkR8G8B8A8Srgb: format = TextureFormat::RGBA8; srgb = true; return true;
+			case k_VkBC1RGBUnorm: format = TextureFormat::BC1; srgb = false; return true;
+			case k_VkBC1RGBSrgb: format = TextureFormat::BC1; srgb = true; return true;
+			case k_VkBC3Unorm: format = TextureFormat::BC3; srgb = false; return true;
+			case k_VkBC3Srgb: format = TextureFormat::BC3; srgb = true; return true;
+			case k_VkBC5Unorm: format = TextureFormat::BC5; srgb = false; return true;
+			case k_VkBC7Unorm: format = TextureFormat::BC7; srgb = false; return true;
+			case k_VkBC7Srgb: format = TextureFormat::BC7; srgb = true; return true;
+			default: return false;
+			}
+		}
+
+		uint32_t Read32(const uint8_t* data)
+		{
+			return uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24;
+		}
+
+		uint64_t Read64(const uint8_t* data)
+		{
+			return uint64_t(Read32(data)) | uint64_t(Read32(data + 4)) << 32;
+		}
+
+		void Write32(std::vector<uint8_t>& out, size_t offset, uint32_t value)
+		{
+			for (int i = 0; i < 4; ++i)
+			{
+				out[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+			}
+		}
+
+		void Write64(std::vector<uint8_t>& out, size_t offset, uint64_t value)
+		{
+			Write32(out, offset, static_cast<uint32_t>(value));
+			Write32(out, offset + 4, static_cast<uint32_t>(value >> 32));
+		}
+
+		// One basic descriptor block: a 24 byte header then 16 bytes per sample.
+		std::vector<uint32_t> BuildDataFormatDescriptor(TextureFormat format, bool srgb)
+		{
+			struct Sample
+			{
+				uint32_t BitOffset, BitLength, Channel, Upper;
+			};
+
+			std::vector<Sample> samples;
+			uint32_t model = k_ModelRGBSDA;
+			switch (format)
+			{
+			case TextureFormat::BC1:
+				model = k_ModelBC1A;
+				samples = { { 0, 64, 0, ~0u } };
+				break;
+			case TextureFormat::BC3:
+				model = k_ModelBC3;
+				samples = { { 0, 64, k_ChannelAlpha, ~0u }, { 64, 64, 0, ~0u } };
+				break;
+			case TextureFormat::BC5:
+				model = k_ModelBC5;
+				samples = { { 0, 64, 0, ~0u }, { 64, 64, 1, ~0u } };
+				break;
+			case TextureFormat::BC7:
+				model = k_ModelBC7;
+				samples = { { 0, 128, 0, ~0u } };
+				break;
+			default:
+				samples = { { 0, 8, 0, 255 }, { 8, 8, 1, 255 }, { 16, 8, 2, 255 }, { 24, 8, k_ChannelAlpha, 255 } };
+				break;
+			}
+
+			const uint32_t blockSize = 24 + 16 * static_cast<uint32_t>(samples.size());
+			const uint32_t blockDimension = IsBlockCompressed(format) ? 0x0303 : 0;
+
+			std::vector<uint32_t> words;
+			words.push_back(4 + blockSize);		// dfdTotalSize
+			words.push_back(0);					// Khronos vendor, basic descriptor type
+			words.push_back(2u | blockSize << 16);	// Version 1.3
+			words.push_back(model | k_PrimariesBT709 << 8 | (srgb ? k_TransferSRGB : k_TransferLinear) << 16);
+			words.push_back(blockDimension);
+			words.push_back(GetBlockBytes(format));
+			words.push_back(0);
+
+			for (const Sample& sample : samples)
+			{
+				uint32_t channel = sample.Channel;
+				if (srgb && channel == k_ChannelAlpha)
+				{
+					channel |= k_SampleLinear;
+				}
+
+				words.push_back(sample.BitOffset | (sample.BitLength - 1) << 16 | channel << 24);
+				words.push_back(0);
+				words.push_back(0);
+				words.push_back(sample.Upper);
+			}
+			return words;
+		}
+
+		void AddKeyValue(std::vector<uint8_t>& out, const std::string& key, const std::string& value)
+		{
+			const uint32_t length = static_cast<uint32_t>(key.size() + 1 + value.size() + 1);
+			const size_t start = out.size();
+			out.resize(start + 4);
+			Write32(out, start, length);
+
+			out.insert(out.end(), key.begin(), key.end());
+			out.push_back(0);
+			out.insert(out.end(), value.begin(), value.end());
+			out.push_back(0);
+			out.resize((out.size() + 3) & ~size_t(3));
+		}
+
+		uint32_t MipDimension(uint32_t size, uint32_t mip)
+		{
+			return std::max(1u, size >> mip);
+		}
+
+		bool ReadIndex(std::ifstream& file, const std::string& path, KTX2Image& image, std::vector<LevelIndex>& levels)
+		{
+			uint8_t header[k_HeaderBytes];
+			if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+				std::memcmp(header, k_Identifier, sizeof(k_Identifier)) != 0)
+			{
+				Logger::Log(LogLevel::Error, "Not a KTX2 file: " + path);
+				return false;
+			}
+
+			const uint32_t vkFormat = Read32(header + 12);
+			const uint32_t depth = Read32(header + 28);
+			const uint32_t layers = Read32(header + 32);
+			const uint32_t faces = Read32(header + 36);
+			const uint32_t supercompression = Read32(header + 44);
+
+			image.Width = Read32(header + 20);
+			image.Height = Read32(header + 24);
+			image.LevelCount = std::max(1u, Read32(header + 40));
+
+			if (!FromVkFormat(vkFormat, image.Format, image.SRGB) || depth > 1 || layers > 1 || faces != 1 ||
+				supercompression != 0 || image.Width == 0 || image.Height == 0 || image.LevelCount > 32)
+			{
+				Logger::Log(LogLevel::Error, "Unsupported KTX2 layout or format: " + path);
+				return false;
+			}
+
+			std::vector<uint8_t> index(size_t(image.LevelCount) * k_LevelIndexBytes);
+			if (!file.read(reinterpret_cast<char*>(index.data()), index.size()))
+			{
+				Logger::Log(LogLevel::Error, "Truncated KTX2 file: " + path);
+				return false;
+			}
+
+			levels.resize(image.LevelCount);
+			for (uint32_t mip = 0; mip < image.LevelCount; ++mip)
+			{
+				levels[mip].Offset = Read64(&index[mip * k_LevelIndexBytes]);
+				levels[mip].Length = Read64(&index[mip * k_LevelIndexBytes + 8]);
+
+				const size_t expected = GetImageBytes(image.Format, MipDimension(image.Width, mip), MipDimension(image.Height, mip));
+				if (levels[mip].Length != expected)
+				{
+					Logger::Log(LogLevel::Error, "KTX2 level " + std::to_string(mip) + " has the wrong size: " + path);
+					return false;
+				}
+			}
+
+			image.Levels.assign(image.LevelCount, {});
+			return true;
+		}
+	}
+
+	namespace KTX2
+	{
+		bool IsKTX2Path(const std::string& path)
+		{
+			std::string extension = std::filesystem::path(path).extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension == ".ktx2";
+		}
+
+		bool Write(const std::string& path, const KTX2Image& image)
+		{
+			if (image.LevelCount == 0 || image.Levels.size() != image.LevelCount)
+			{
+				Logger::Log(LogLevel::Error, "KTX2 image has no levels: " + path);
+				return false;
+			}
+
+			for (uint32_t mip = 0; mip < image.LevelCount; ++mip)
+			{
+				if (image.Levels[mip].size() != GetImageBytes(image.Format, MipDimension(image.Width, mip), MipDimension(image.Height, mip)))
+				{
+					Logger::Log(LogLevel::Error, "KTX2 level " + std::to_string(mip) + " has the wrong size: " + path);
+					return false;
+				}
+			}
+
+			const std::vector<uint32_t> descriptor = BuildDataFormatDescriptor(image.Format, image.SRGB);
+
+			std::vector<uint8_t> keyValues;
+			AddKeyValue(keyValues, "KTXorientation", "ru");
+			AddKeyValue(keyValues, "KTXwriter", "Orca TextureCooker");
+
+			const size_t descriptorOffset = k_HeaderBytes + size_t(image.LevelCount) * k_LevelIndexBytes;
+			const size_t descriptorBytes = descriptor.size() * 4;
+			const size_t keyValueOffset = descriptorOffset + descriptorBytes;
+
+			// Levels are aligned to the block size (at least 4) and stored smallest first, so a
+			// streamer reading the small mips reads from the front of the file.
+			const size_t alignment = std::max<size_t>(4, GetBlockBytes(image.Format));
+			std::vector<LevelIndex> levels(image.LevelCount);
+			size_t end = keyValueOffset + keyValues.size();
+			for (uint32_t mip = image.LevelCount; mip-- > 0;)
+			{
+				end = (end + alignment - 1) / alignment * alignment;
+				levels[mip] = { end, image.Levels[mip].size() };
+				end += image.Levels[mip].size();
+			}
+
+			std::vector<uint8_t> file(end, 0);
+			std::memcpy(file.data(), k_Identifier, sizeof(k_Identifier));
+			Write32(file, 12, GetVkFormat(image.Format, image.SRGB));
+			Write32(file, 16, 1);							// typeSize
+			Write32(file, 20, image.Width);
+			Write32(file, 24, image.Height);
+			Write32(file, 28, 0);							// depth
+			Write32(file, 32, 0);							// layers
+			Write32(file, 36, 1);							// faces
+			Write32(file, 40, image.LevelCount);
+			Write32(file, 44, 0);							// supercompression
+			Write32(file, 48, static_cast<uint32_t>(descriptorOffset));
+			Write32(file, 52, static_cast<uint32_t>(descriptorBytes));
+			Write32(file, 56, static_cast<uint32_t>(keyValueOffset));
+			Write32(file, 60, static_cast<uint32_t>(keyValues.size()));
+			Write64(file, 64, 0);							// No supercompression global data
+			Write64(file, 72, 0);
+
+			for (uint32_t mip = 0; mip < image.LevelCount; ++mip)
+			{
+				const size_t entry = k_HeaderBytes + size_t(mip) * k_LevelIndexBytes;
+				Write64(file, entry, levels[mip].Offset);
+				Write64(file, entry + 8, levels[mip].Length);
+				Write64(file, entry + 16, levels[mip].Length);
+				std::memcpy(&file[levels[mip].Offset], image.Levels[mip].data(), image.Levels[mip].size());
+			}
+
+			for (size_t i = 0; i < descriptor.size(); ++i)
+			{
+				Write32(file, descriptorOffset + i * 4, descriptor[i]);
+			}
+			std::copy(keyValues.begin(), keyValues.end(), file.begin() + keyValueOffset);
+
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			if (!out.write(reinterpret_cast<const char*>(file.data()), file.size()))
+			{
+				Logger::Log(LogLevel::Error, "Failed to write KTX2 file: " + path);
+				return false;
+			}
+			return true;
+		}
+
+		bool ReadHeader(const std::string& path, KTX2Image& image)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file)
+			{
+				return false;
+			}
+
+			std::vector<LevelIndex> levels;
+			return ReadIndex(file, path, image, levels);
+		}
+
+		bool Read(const std::string& path, KTX2Image& image, uint32_t firstLevel, uint32_t endLevel)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file)
+			{
+				Logger::Log(LogLevel::Error, "Failed to open KTX2 file: " + path);
+				return false;
+			}
+
+			std::vector<LevelIndex> levels;
+			if (!ReadIndex(file, path, image, levels))
+			{
+				return false;
+			}
+
+			endLevel = std::min(endLevel, image.LevelCount);
+			for (uint32_t mip = firstLevel; mip < endLevel; ++mip)
+			{
+				std::vector<uint8_t>& level = image.Levels[mip];
+				level.resize(static_cast<size_t>(levels[mip].Length));
+
+				file.seekg(static_cast<std::streamoff>(levels[mip].Offset));
+				if (!file.read(reinterpret_cast<char*>(level.data()), level.size()))
+				{
+					Logger::Log(LogLevel::Error, "Truncated KTX2 file: " + path);
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#ifndef KTX2_H
+#define KTX2_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "BlockCompression.h"
+#include "../../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// A 2D texture with its mip chain. Rows are stored bottom to top, the order GL uploads them in,
+	// and the file says so through KTXorientation.
+	struct ORCA_API KTX2Image
+	{
+		TextureFormat Format = TextureFormat::RGBA8;
+		bool SRGB = false;
+		uint32_t Width = 0, Height = 0;
+		uint32_t LevelCount = 0;
+		std::vector<std::vector<uint8_t>> Levels;		// Indexed by mip; levels that weren't read are empty
+	};
+
+	// Reads and writes the subset of KTX2 the engine produces: one 2D image, no array layers or
+	// faces, no supercompression, in one of the TextureFormat formats.
+	namespace KTX2
+	{
+		ORCA_API bool IsKTX2Path(const std::string& path);
+
+		ORCA_API bool Write(const std::string& path, const KTX2Image& image);
+
+		// Header and level index only.
+		ORCA_API bool ReadHeader(const std::string& path, KTX2Image& image);
+
+		// Reads mips [firstLevel, endLevel), clamped to the level count.
+		ORCA_API bool Read(const std::string& path, KTX2Image& image, uint32_t firstLevel = 0, uint32_t endLevel = ~0u);
+	}
+#pragma warning(pop)
+}
+
+#endif
@@ -0,0 +1,197 @@
+#include "TextureCooker.h"
+#include "KTX2.h"
+#include "../../Core/Logger.h"
+#include "../../Core/JobSystem.h"
+#include <stb_image.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+namespace Orca
+{
+	namespace
+	{
+		bool IsSourceImage(const std::filesystem::path& path)
+		{
+			std::string extension = path.extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+		}
+
+		bool HasTranslucency(const std::vector<unsigned char>& pixels)
+		{
+			for (size_t i = 3; i < pixels.size(); i += 4)
+			{
+				if (pixels[i] != 255)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+
+	bool TextureCooker::Cook(const std::string& sourcePath, const std::string& outputPath, const TextureCookSettings& settings)
+	{
+		int width = 0, height = 0, channels = 0;
+		unsigned char* pixels = stbi_load(sourcePath.c_str(), &width, &height, &channels, 4);
+		if (!pixels)
+		{
+			Logger::Log(LogLevel::Error, "Failed to load texture: " + sourcePath);
+			return false;
+		}
+
+		// Stored bottom row first like every other texture the engine uploads; the blocks are
+		// encoded after the flip since they can't be flipped afterwards.
+		const size_t rowBytes = size_t(width) * 4;
+		std::vector<unsigned char> current(rowBytes * height);
+		for (int y = 0; y < height; ++y)
+		{
+			std::memcpy(&current[y * rowBytes], pixels + (height - 1 - y) * rowBytes, rowBytes);
+		}
+		stbi_image_free(pixels);
+
+		KTX2Image image;
+		image.Width = static_cast<uint32_t>(width);
+		image.Height = static_cast<uint32_t>(height);
+		image.SRGB = settings.SRGB && !settings.NormalMap;
+		image.Format = settings.Format;
+		if (settings.AutoFormat)
+		{
+			image.Format = settings.NormalMap ? TextureFormat::BC5 :
+				channels == 4 && HasTranslucency(current) ? TextureFormat::BC3 : TextureFormat::BC1;
+		}
+		if (image.Format == TextureFormat::BC5)
+		{
+			image.SRGB = false;
+		}
+
+		image.LevelCount = settings.GenerateMips ? 1 + static_cast<uint32_t>(std::log2(static_cast<float>(std::max(width, height)))) : 1;
+
+		uint32_t mipWidth = image.Width;
+		uint32_t mipHeight = image.Height;
+		std::vector<unsigned char> next;
+		for (uint32_t mip = 0; mip < image.LevelCount; ++mip)
+		{
+			image.Levels.push_back(BlockCompression::CompressImage(image.Format, current.data(), mipWidth, mipHeight));
+
+			if (mip + 1 < image.LevelCount)
+			{
+				Downsample(current, mipWidth, mipHeight, next);
+				current.swap(next);
+				mipWidth = std::max(1u, mipWidth / 2);
+				mipHeight = std::max(1u, mipHeight / 2);
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(outputPath).parent_path(), error);
+		return KTX2::Write(outputPath, image);
+	}
+
+	TextureCookStats TextureCooker::CookFolder(const std::string& folderPath, const std::string& outputFolder, const TextureCookSettings& settings)
+	{
+		std::vector<std::filesystem::directory_entry> sources;
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(folderPath, error))
+		{
+			if (entry.is_regular_file() && IsSourceImage(entry.path()))
+			{
+				sources.push_back(entry);
+			}
+		}
+
+		std::atomic<uint32_t> cooked{ 0 };
+		std::atomic<uint32_t> upToDate{ 0 };
+		std::atomic<uint32_t> failed{ 0 };
+
+		// Each image is decoded, compressed and written on its own; nothing is shared between them.
+		auto cookSource = [&](unsigned int index)
+			{
+				const std::filesystem::directory_entry& entry = sources[index];
+				const std::string sourcePath = entry.path().string();
+				const std::string outputPath = GetCookedPath(sourcePath, outputFolder);
+
+				std::error_code timeError;
+				const auto outputTime = std::filesystem::last_write_time(outputPath, timeError);
+				if (!timeError && outputTime >= entry.last_write_time())
+				{
+					++upToDate;
+					return;
+				}
+
+				TextureCookSettings imageSettings = settings;
+				const std::string stem = entry.path().stem().string();
+				const std::string& suffix = settings.NormalMapSuffix;
+				if (!suffix.empty() && stem.size() >= suffix.size() && stem.compare(stem.size() - suffix.size(), suffix.size(), suffix) == 0)
+				{
+					imageSettings.NormalMap = true;
+				}
+
+				if (Cook(sourcePath, outputPath, imageSettings))
+				{
+					++cooked;
+				}
+				else
+				{
+					++failed;
+				}
+			};
+
+		if (JobSystem::IsInitialized())
+		{
+			JobSystem::Dispatch(static_cast<unsigned int>(sources.size()), cookSource);
+		}
+		else
+		{
+			for (unsigned int i = 0; i < sources.size(); ++i)
+			{
+				cookSource(i);
+			}
+		}
+
+		TextureCookStats stats;
+		stats.Cooked = cooked.load();
+		stats.UpToDate = upToDate.load();
+		stats.Failed = failed.load();
+		return stats;
+	}
+
+	std::string TextureCooker::GetCookedPath(const std::string& sourcePath, const std::string& outputFolder)
+	{
+		return (std::filesystem::path(outputFolder) / std::filesystem::path(sourcePath).stem()).string() + ".ktx2";
+	}
+
+	void TextureCooker::Downsample(const std::vector<unsigned char>& src, uint32_t width, uint32_t height, std::vector<unsigned char>& dst)
+	{
+		const uint32_t dstWidth = std::max(1u, width / 2);
+		const uint32_t dstHeight = std::max(1u, height / 2);
+		dst.resize(size_t(dstWidth) * dstHeight * 4);
+
+		for (uint32_t y = 0; y < dstHeight; ++y)
+		{
+			const uint32_t y0 = std::min(y * 2, height - 1);
+			const uint32_t y1 = std::min(y * 2 + 1, height - 1);
+
+			for (uint32_t x = 0; x < dstWidth; ++x)
+			{
+				const uint32_t x0 = std::min(x * 2, width - 1);
+				const uint32_t x1 = std::min(x * 2 + 1, width - 1);
+
+				const unsigned char* a = &src[(size_t(y0) * width + x0) * 4];
+				const unsigned char* b = &src[(size_t(y0) * width + x1) * 4];
+				const unsigned char* c = &src[(size_t(y1) * width + x0) * 4];
+				const unsigned char* d = &src[(size_t(y1) * width + x1) * 4];
+				unsigned char* out = &dst[(size_t(y) * dstWidth + x) * 4];
+
+				for (int channel = 0; channel < 4; ++channel)
+				{
+					out[channel] = static_cast<unsigned char>((a[channel] + b[channel] + c[channel] + d[channel] + 2) >> 2);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef TEXTURE_COOKER_H
+#define TEXTURE_COOKER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "BlockCompression.h"
+#include "../../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	struct TextureCookSettings
+	{
+		// With AutoFormat, normal maps get BC5, images with alpha BC3 and the rest BC1.
+		bool AutoFormat = true;
+		TextureFormat Format = TextureFormat::BC7;
+		bool SRGB = false;					// Off to sample like the uncooked RGBA8 textures; ignored for normal maps
+		bool NormalMap = false;				// Keeps X and Y only; the shader rebuilds Z
+		bool GenerateMips = true;
+
+		// CookFolder only: images whose name (without extension) ends in this are cooked as normal maps.
+		std::string NormalMapSuffix = "_normal";
+	};
+
+	struct TextureCookStats
+	{
+		uint32_t Cooked = 0;
+		uint32_t UpToDate = 0;
+		uint32_t Failed = 0;
+	};
+
+	// Turns source images into KTX2 files with a full, precomputed mip chain in a block-compressed
+	// format, so loading is a file read and an upload instead of a decode plus glGenerateMipmap.
+	class ORCA_API TextureCooker
+	{
+	public:
+		static bool Cook(const std::string& sourcePath, const std::string& outputPath, const TextureCookSettings& settings = {});
+
+		// Cooks every image in the folder to outputFolder/<name>.ktx2, skipping outputs newer than
+		// their source. Images are cooked in parallel when the JobSystem is running.
+		static TextureCookStats CookFolder(const std::string& folderPath, const std::string& outputFolder, const TextureCookSettings& settings = {});
+
+		static std::string GetCookedPath(const std::string& sourcePath, const std::string& outputFolder);
+
+		// 2x2 box filter over RGBA8; odd sizes reuse the last row or column.
+		static void Downsample(const std::vector<unsigned char>& src, uint32_t width, uint32_t height, std::vector<unsigned char>& dst);
+	};
+#pragma warning(pop)
+}
+
+#endif
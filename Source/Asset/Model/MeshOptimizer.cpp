@@ -0,0 +1,461 @@
+#include "MeshOptimizer.h"
+#include "Core/Logger.h"
+#include <unordered_map>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint32_t k_InvalidIndex = UINT32_MAX;
+
+		// Forsyth's tuning constants, from "Linear-Speed Vertex Cache Optimisation".
+		constexpr int k_ForsythCacheSize = 32;
+		constexpr float k_CacheDecayPower = 1.5f;
+		constexpr float k_LastTriangleScore = 0.75f;
+		constexpr float k_ValenceBoostScale = 2.0f;
+		constexpr float k_ValenceBoostPower = 0.5f;
+
+		struct VertexHash
+		{
+			size_t operator()(const Vertex& vertex) const
+			{
+				const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+				uint64_t hash = 14695981039346656037ull;
+				for (size_t i = 0; i < sizeof(Vertex); ++i)
+				{
+					hash ^= bytes[i];
+					hash *= 1099511628211ull;
+				}
+				return static_cast<size_t>(hash);
+			}
+		};
+
+		struct VertexEqual
+		{
+			bool operator()(const Vertex& a, const Vertex& b) const
+			{
+				return std::memcmp(&a, &b, sizeof(Vertex)) == 0;
+			}
+		};
+
+		float ScoreVertex(int cachePosition, uint32_t remainingTriangles)
+		{
+			if (remainingTriangles == 0)
+			{
+				return -1.0f;
+			}
+
+			float score = 0.0f;
+			if (cachePosition >= 0)
+			{
+				if (cachePosition < 3)
+				{
+					// The last triangle's vertices get a fixed score so its neighbours are not favoured unfairly.
+					score = k_LastTriangleScore;
+				}
+				else
+				{
+					const float scaler = 1.0f / (k_ForsythCacheSize - 3);
+					score = std::pow(1.0f - (cachePosition - 3) * scaler, k_CacheDecayPower);
+				}
+			}
+
+			// Vertices with few triangles left are finished off first so they leave the cache for good.
+			score += k_ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -k_ValenceBoostPower);
+			return score;
+		}
+	}
+
+	MeshOptimizationStats MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+		const MeshOptimizationSettings& settings)
+	{
+		MeshOptimizationStats stats;
+		stats.SourceVertexCount = static_cast<uint32_t>(vertices.size());
+		stats.VertexCount = stats.SourceVertexCount;
+		stats.TriangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+		if (indices.size() % 3 != 0)
+		{
+			Logger::Log(LogLevel::Warning, "MeshOptimizer::Optimize skipped: index count is not a multiple of 3.");
+			return stats;
+		}
+
+		stats.Before = AnalyzeVertexCache(indices, stats.VertexCount, settings.CacheSize);
+
+		if (settings.WeldVertices)
+		{
+			stats.VertexCount = WeldVertices(vertices, indices);
+		}
+
+		if (settings.OptimizeVertexCache)
+		{
+			OptimizeVertexCache(indices, stats.VertexCount);
+		}
+
+		if (settings.OptimizeOverdraw)
+		{
+			OptimizeOverdraw(indices, vertices, settings.OverdrawThreshold, settings.CacheSize);
+		}
+
+		if (settings.OptimizeVertexFetch)
+		{
+			stats.VertexCount = OptimizeVertexFetch(vertices, indices);
+		}
+
+		stats.After = AnalyzeVertexCache(indices, stats.VertexCount, settings.CacheSize);
+		return stats;
+	}
+
+	uint32_t MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+	{
+		std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> unique;
+		unique.reserve(vertices.size());
+
+		std::vector<Vertex> welded;
+		welded.reserve(vertices.size());
+
+		std::vector<uint32_t> remap(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			auto result = unique.emplace(vertices[i], static_cast<uint32_t>(welded.size()));
+			if (result.second)
+			{
+				welded.push_back(vertices[i]);
+			}
+			remap[i] = result.first->second;
+		}
+
+		for (auto& index : indices)
+		{
+			index = remap[index];
+		}
+
+		vertices.swap(welded);
+		return static_cast<uint32_t>(vertices.size());
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, uint32_t vertexCount)
+	{
+		const size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0 || vertexCount == 0)
+		{
+			return;
+		}
+
+		// Vertex -> triangle adjacency in CSR form. Each vertex's live triangles occupy
+		// [offset, offset + remaining), so emitted triangles are removed with a swap.
+		std::vector<uint32_t> remaining(vertexCount, 0);
+		for (unsigned int index : indices)
+		{
+			remaining[index]++;
+		}
+
+		std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+		for (uint32_t v = 0; v < vertexCount; ++v)
+		{
+			adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+		}
+
+		std::vector<uint32_t> adjacency(indices.size());
+		{
+			std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					adjacency[fill[indices[t * 3 + corner]]++] = static_cast<uint32_t>(t);
+				}
+			}
+		}
+
+		std::vector<float> vertexScore(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; ++v)
+		{
+			vertexScore[v] = ScoreVertex(-1, remaining[v]);
+		}
+
+		std::vector<float> triangleScore(triangleCount);
+		std::vector<bool> emitted(triangleCount, false);
+		uint32_t bestTriangle = k_InvalidIndex;
+		float bestScore = -1.0f;
+
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+			if (triangleScore[t] > bestScore)
+			{
+				bestScore = triangleScore[t];
+				bestTriangle = static_cast<uint32_t>(t);
+			}
+		}
+
+		std::vector<unsigned int> output;
+		output.reserve(indices.size());
+
+		std::vector<uint32_t> cache;
+		std::vector<uint32_t> nextCache;
+		cache.reserve(k_ForsythCacheSize + 3);
+		nextCache.reserve(k_ForsythCacheSize + 3);
+
+		size_t scanCursor = 0;
+
+		for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+		{
+			if (bestTriangle == k_InvalidIndex)
+			{
+				// Nothing in the cache touches a live triangle; restart from the next unused one in input order.
+				while (emitted[scanCursor])
+				{
+					scanCursor++;
+				}
+				bestTriangle = static_cast<uint32_t>(scanCursor);
+			}
+
+			const uint32_t triangle = bestTriangle;
+			emitted[triangle] = true;
+
+			const uint32_t corners[3] = { indices[triangle * 3], indices[triangle * 3 + 1], indices[triangle * 3 + 2] };
+			for (uint32_t v : corners)
+			{
+				output.push_back(v);
+
+				uint32_t* begin = adjacency.data() + adjacencyOffset[v];
+				uint32_t* end = begin + remaining[v];
+				uint32_t* found = std::find(begin, end, triangle);
+				if (found != end)
+				{
+					*found = *(end - 1);
+					remaining[v]--;
+				}
+			}
+
+			// Most recently used first; vertices pushed past the cache size fall out.
+			nextCache.assign(corners, corners + 3);
+			for (uint32_t v : cache)
+			{
+				if (v != corners[0] && v != corners[1] && v != corners[2])
+				{
+					nextCache.push_back(v);
+				}
+			}
+
+			if (nextCache.size() > static_cast<size_t>(k_ForsythCacheSize))
+			{
+				for (size_t i = k_ForsythCacheSize; i < nextCache.size(); ++i)
+				{
+					const uint32_t v = nextCache[i];
+					vertexScore[v] = ScoreVertex(-1, remaining[v]);
+
+					for (uint32_t a = 0; a < remaining[v]; ++a)
+					{
+						const uint32_t t = adjacency[adjacencyOffset[v] + a];
+						triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+					}
+				}
+				nextCache.resize(k_ForsythCacheSize);
+			}
+
+			for (size_t i = 0; i < nextCache.size(); ++i)
+			{
+				vertexScore[nextCache[i]] = ScoreVertex(static_cast<int>(i), remaining[nextCache[i]]);
+			}
+
+			// Only triangles touching the cache changed score, so the next pick is searched among them.
+			bestTriangle = k_InvalidIndex;
+			bestScore = -1.0f;
+			for (uint32_t v : nextCache)
+			{
+				for (uint32_t a = 0; a < remaining[v]; ++a)
+				{
+					const uint32_t t = adjacency[adjacencyOffset[v] + a];
+					triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+					if (triangleScore[t] > bestScore)
+					{
+						bestScore = triangleScore[t];
+						bestTriangle = t;
+					}
+				}
+			}
+
+			cache.swap(nextCache);
+		}
+
+		indices.swap(output);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+		float threshold, uint32_t cacheSize)
+	{
+		const size_t triangleCount = indices.size() / 3;
+		if (triangleCount < 2)
+		{
+			return;
+		}
+
+		// A triangle whose three vertices all miss the cache starts a cluster. Reordering whole clusters
+		// then costs almost nothing in cache efficiency, since each one started cold anyway.
+		std::vector<size_t> clusterStarts;
+		{
+			std::vector<uint32_t> cacheStamp(vertices.size(), 0);
+			uint32_t timestamp = cacheSize + 1;
+
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				int misses = 0;
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					const unsigned int v = indices[t * 3 + corner];
+					if (timestamp - cacheStamp[v] > cacheSize)
+					{
+						cacheStamp[v] = timestamp++;
+						misses++;
+					}
+				}
+
+				if (t == 0 || misses == 3)
+				{
+					clusterStarts.push_back(t);
+				}
+			}
+		}
+
+		if (clusterStarts.size() < 2)
+		{
+			return;
+		}
+
+		glm::vec3 meshCentroid(0.0f);
+		float meshArea = 0.0f;
+
+		struct Cluster
+		{
+			size_t Begin;
+			size_t End;
+			glm::vec3 Centroid;
+			glm::vec3 Normal;
+			float SortKey;
+		};
+
+		std::vector<Cluster> clusters(clusterStarts.size());
+		for (size_t c = 0; c < clusterStarts.size(); ++c)
+		{
+			Cluster& cluster = clusters[c];
+			cluster.Begin = clusterStarts[c];
+			cluster.End = c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : triangleCount;
+			cluster.Centroid = glm::vec3(0.0f);
+			cluster.Normal = glm::vec3(0.0f);
+
+			float clusterArea = 0.0f;
+			for (size_t t = cluster.Begin; t < cluster.End; ++t)
+			{
+				const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+				const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+				const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+
+				const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+				const float area = glm::length(normal);
+
+				cluster.Centroid += (p0 + p1 + p2) * (area / 3.0f);
+				cluster.Normal += normal;
+				clusterArea += area;
+			}
+
+			meshCentroid += cluster.Centroid;
+			meshArea += clusterArea;
+
+			cluster.Centroid = clusterArea > 0.0f ? cluster.Centroid / clusterArea : vertices[indices[cluster.Begin * 3]].Position;
+			const float normalLength = glm::length(cluster.Normal);
+			cluster.Normal = normalLength > 0.0f ? cluster.Normal / normalLength : glm::vec3(0.0f);
+		}
+
+		if (meshArea <= 0.0f)
+		{
+			return;
+		}
+
+		meshCentroid /= meshArea;
+
+		// Clusters facing away from the center are on the silhouette and likely to occlude the others.
+		for (auto& cluster : clusters)
+		{
+			cluster.SortKey = glm::dot(cluster.Centroid - meshCentroid, cluster.Normal);
+		}
+
+		std::stable_sort(clusters.begin(), clusters.end(),
+			[](const Cluster& a, const Cluster& b) { return a.SortKey > b.SortKey; });
+
+		std::vector<unsigned int> reordered;
+		reordered.reserve(indices.size());
+		for (const auto& cluster : clusters)
+		{
+			reordered.insert(reordered.end(), indices.begin() + cluster.Begin * 3, indices.begin() + cluster.End * 3);
+		}
+
+		// Keep the new order only while the vertex cache cost stays within the threshold.
+		const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+		const float before = AnalyzeVertexCache(indices, vertexCount, cacheSize).ACMR;
+		const float after = AnalyzeVertexCache(reordered, vertexCount, cacheSize).ACMR;
+
+		if (after <= before * threshold)
+		{
+			indices.swap(reordered);
+		}
+	}
+
+	uint32_t MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices)
+	{
+		std::vector<uint32_t> remap(vertices.size(), k_InvalidIndex);
+		std::vector<Vertex> reordered;
+		reordered.reserve(vertices.size());
+
+		for (auto& index : indices)
+		{
+			if (remap[index] == k_InvalidIndex)
+			{
+				remap[index] = static_cast<uint32_t>(reordered.size());
+				reordered.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+
+		vertices.swap(reordered);
+		return static_cast<uint32_t>(vertices.size());
+	}
+
+	VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<unsigned int>& indices, uint32_t vertexCount, uint32_t cacheSize)
+	{
+		VertexCacheStats stats;
+		if (indices.empty() || vertexCount == 0)
+		{
+			return stats;
+		}
+
+		// A vertex is resident while fewer than cacheSize misses have happened since it was loaded.
+		std::vector<uint32_t> cacheStamp(vertexCount, 0);
+		std::vector<bool> referenced(vertexCount, false);
+		uint32_t timestamp = cacheSize + 1;
+		uint32_t uniqueVertices = 0;
+
+		for (unsigned int index : indices)
+		{
+			if (timestamp - cacheStamp[index] > cacheSize)
+			{
+				cacheStamp[index] = timestamp++;
+				stats.Misses++;
+			}
+
+			if (!referenced[index])
+			{
+				referenced[index] = true;
+				uniqueVertices++;
+			}
+		}
+
+		stats.ACMR = static_cast<float>(stats.Misses) / static_cast<float>(indices.size() / 3);
+		stats.ATVR = static_cast<float>(stats.Misses) / static_cast<float>(uniqueVertices);
+		return stats;
+	}
+}
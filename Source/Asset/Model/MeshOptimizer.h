@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <vector>
+#include <cstdint>
+#include "Renderer/Vertex.h"
+#include "../../OrcaAPI.h"
+
+namespace Orca
+{
+	struct MeshOptimizationSettings
+	{
+		bool WeldVertices = true;
+		bool OptimizeVertexCache = true;
+		bool OptimizeOverdraw = true;
+		bool OptimizeVertexFetch = true;
+
+		// Overdraw reordering is kept only if ACMR stays within this factor of the cache-optimized result.
+		float OverdrawThreshold = 1.05f;
+
+		// FIFO size used when reporting ACMR/ATVR. 16-32 matches most current GPUs.
+		uint32_t CacheSize = 32;
+	};
+
+	struct VertexCacheStats
+	{
+		uint32_t Misses = 0;
+		float ACMR = 0.0f;	// Transformed vertices per triangle; 0.5 is the ideal for a regular grid, 3.0 the worst case.
+		float ATVR = 0.0f;	// Transformed vertices per unique vertex; 1.0 is ideal.
+	};
+
+	struct MeshOptimizationStats
+	{
+		uint32_t SourceVertexCount = 0;
+		uint32_t VertexCount = 0;
+		uint32_t TriangleCount = 0;
+
+		VertexCacheStats Before;
+		VertexCacheStats After;
+	};
+
+	// Offline index/vertex reordering run by the importers.
+	// Every pass operates in place on a triangle list and keeps the mesh visually identical.
+	class ORCA_API MeshOptimizer
+	{
+	public:
+		static MeshOptimizationStats Optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+			const MeshOptimizationSettings& settings = {});
+
+		// Merges bitwise-identical vertices and rewrites the indices. Returns the new vertex count.
+		static uint32_t WeldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		// Forsyth's linear-speed vertex cache optimization.
+		static void OptimizeVertexCache(std::vector<unsigned int>& indices, uint32_t vertexCount);
+
+		// Splits the cache-optimized list into clusters at cold-cache boundaries (as in Tipsify)
+		// and draws outward-facing clusters first, so they occlude the rest of the mesh.
+		static void OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+			float threshold, uint32_t cacheSize);
+
+		// Renumbers vertices in first-use order so fetches walk the vertex buffer linearly.
+		// Unreferenced vertices are dropped. Returns the new vertex count.
+		static uint32_t OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+		// Simulates a FIFO post-transform cache of the given size.
+		static VertexCacheStats AnalyzeVertexCache(const std::vector<unsigned int>& indices, uint32_t vertexCount, uint32_t cacheSize);
+	};
+}
+
+#endif
@@ -0,0 +1,398 @@
+#include "MeshSimplifier.h"
+#include <unordered_map>
+#include <queue>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+namespace Orca
+{
+	namespace
+	{
+		// Border edges get extra perpendicular planes so open boundaries do not shrink inward.
+		constexpr double k_BorderWeight = 10.0;
+
+		// Symmetric 4x4 error quadric, stored as the upper triangle plus the accumulated area weight.
+		struct Quadric
+		{
+			double A00 = 0.0, A01 = 0.0, A02 = 0.0, A11 = 0.0, A12 = 0.0, A22 = 0.0;
+			double B0 = 0.0, B1 = 0.0, B2 = 0.0;
+			double C = 0.0;
+			double Weight = 0.0;
+
+			static Quadric FromPlane(const glm::dvec3& normal, double distance, double weight)
+			{
+				Quadric q;
+				q.A00 = weight * normal.x * normal.x;
+				q.A01 = weight * normal.x * normal.y;
+				q.A02 = weight * normal.x * normal.z;
+				q.A11 = weight * normal.y * normal.y;
+				q.A12 = weight * normal.y * normal.z;
+				q.A22 = weight * normal.z * normal.z;
+				q.B0 = weight * normal.x * distance;
+				q.B1 = weight * normal.y * distance;
+				q.B2 = weight * normal.z * distance;
+				q.C = weight * distance * distance;
+				q.Weight = weight;
+				return q;
+			}
+
+			Quadric& operator+=(const Quadric& other)
+			{
+				A00 += other.A00; A01 += other.A01; A02 += other.A02;
+				A11 += other.A11; A12 += other.A12; A22 += other.A22;
+				B0 += other.B0; B1 += other.B1; B2 += other.B2;
+				C += other.C;
+				Weight += other.Weight;
+				return *this;
+			}
+
+			// Area-normalized squared distance from p to the accumulated planes.
+			double Evaluate(const glm::dvec3& p) const
+			{
+				double error =
+					A00 * p.x * p.x + 2.0 * A01 * p.x * p.y + 2.0 * A02 * p.x * p.z +
+					A11 * p.y * p.y + 2.0 * A12 * p.y * p.z + A22 * p.z * p.z +
+					2.0 * (B0 * p.x + B1 * p.y + B2 * p.z) + C;
+
+				return Weight > 0.0 ? std::max(error, 0.0) / Weight : 0.0;
+			}
+		};
+
+		struct Collapse
+		{
+			double Cost;
+			uint32_t From;
+			uint32_t To;
+			uint32_t FromVersion;
+			uint32_t ToVersion;
+
+			bool operator>(const Collapse& other) const { return Cost > other.Cost; }
+		};
+
+		struct PositionHash
+		{
+			size_t operator()(const glm::vec3& p) const
+			{
+				uint32_t bits[3];
+				std::memcpy(bits, &p, sizeof(bits));
+				return static_cast<size_t>(bits[0] * 73856093u ^ bits[1] * 19349663u ^ bits[2] * 83492791u);
+			}
+		};
+
+		float AttributeDistance(const Vertex& a, const Vertex& b)
+		{
+			glm::vec3 dn = a.Normal - b.Normal;
+			glm::vec2 duv = a.TexCoords - b.TexCoords;
+			return glm::dot(dn, dn) + glm::dot(duv, duv);
+		}
+	}
+
+	std::vector<unsigned int> MeshSimplifier::Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+		size_t targetIndexCount, float maxError, float* outError)
+	{
+		if (outError)
+		{
+			*outError = 0.0f;
+		}
+
+		const size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0 || targetIndexCount >= indices.size())
+		{
+			return indices;
+		}
+
+		// Collapses work on positions; vertices that differ only in normal or UV share one position.
+		std::unordered_map<glm::vec3, uint32_t, PositionHash> positionLookup;
+		std::vector<uint32_t> positionOf(vertices.size());
+		std::vector<glm::dvec3> positions;
+		std::vector<std::vector<uint32_t>> verticesAt;
+
+		for (size_t v = 0; v < vertices.size(); ++v)
+		{
+			auto result = positionLookup.emplace(vertices[v].Position, static_cast<uint32_t>(positions.size()));
+			if (result.second)
+			{
+				positions.push_back(glm::dvec3(vertices[v].Position));
+				verticesAt.emplace_back();
+			}
+			positionOf[v] = result.first->second;
+			verticesAt[result.first->second].push_back(static_cast<uint32_t>(v));
+		}
+
+		const size_t positionCount = positions.size();
+
+		std::vector<uint32_t> triangles(indices.size());
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			triangles[i] = positionOf[indices[i]];
+		}
+
+		std::vector<bool> removed(triangleCount, false);
+		std::vector<std::vector<uint32_t>> trianglesAt(positionCount);
+		std::vector<Quadric> quadrics(positionCount);
+		size_t liveTriangles = 0;
+
+		glm::dvec3 boundsMin = positions[0];
+		glm::dvec3 boundsMax = positions[0];
+		for (const auto& p : positions)
+		{
+			boundsMin = glm::min(boundsMin, p);
+			boundsMax = glm::max(boundsMax, p);
+		}
+		const double extent = std::max(glm::length(boundsMax - boundsMin), 1e-12);
+		const double maxCost = (maxError * extent) * (maxError * extent);
+
+		std::unordered_map<uint64_t, uint32_t> directedEdges;
+		directedEdges.reserve(indices.size());
+
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			const uint32_t* tri = &triangles[t * 3];
+			if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2])
+			{
+				removed[t] = true;
+				continue;
+			}
+
+			liveTriangles++;
+
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				trianglesAt[tri[corner]].push_back(static_cast<uint32_t>(t));
+				directedEdges[(static_cast<uint64_t>(tri[corner]) << 32) | tri[(corner + 1) % 3]]++;
+			}
+
+			glm::dvec3 normal = glm::cross(positions[tri[1]] - positions[tri[0]], positions[tri[2]] - positions[tri[0]]);
+			double area = glm::length(normal);
+			if (area <= 0.0)
+			{
+				continue;
+			}
+
+			normal /= area;
+			Quadric plane = Quadric::FromPlane(normal, -glm::dot(normal, positions[tri[0]]), area);
+			quadrics[tri[0]] += plane;
+			quadrics[tri[1]] += plane;
+			quadrics[tri[2]] += plane;
+		}
+
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			if (removed[t])
+			{
+				continue;
+			}
+
+			const uint32_t* tri = &triangles[t * 3];
+			glm::dvec3 faceNormal = glm::cross(positions[tri[1]] - positions[tri[0]], positions[tri[2]] - positions[tri[0]]);
+			if (glm::length(faceNormal) <= 0.0)
+			{
+				continue;
+			}
+			faceNormal = glm::normalize(faceNormal);
+
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				const uint32_t a = tri[corner];
+				const uint32_t b = tri[(corner + 1) % 3];
+				if (directedEdges.count((static_cast<uint64_t>(b) << 32) | a) != 0)
+				{
+					continue;
+				}
+
+				glm::dvec3 edge = positions[b] - positions[a];
+				double length = glm::length(edge);
+				if (length <= 0.0)
+				{
+					continue;
+				}
+
+				glm::dvec3 normal = glm::normalize(glm::cross(edge, faceNormal));
+				Quadric plane = Quadric::FromPlane(normal, -glm::dot(normal, positions[a]), k_BorderWeight * length * length);
+				quadrics[a] += plane;
+				quadrics[b] += plane;
+			}
+		}
+
+		std::vector<uint32_t> version(positionCount, 0);
+		std::vector<bool> dead(positionCount, false);
+		std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+		auto pushCollapse = [&](uint32_t from, uint32_t to)
+			{
+				Quadric q = quadrics[from];
+				q += quadrics[to];
+				heap.push({ q.Evaluate(positions[to]), from, to, version[from], version[to] });
+			};
+
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			if (removed[t])
+			{
+				continue;
+			}
+
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				pushCollapse(triangles[t * 3 + corner], triangles[t * 3 + (corner + 1) % 3]);
+				pushCollapse(triangles[t * 3 + (corner + 1) % 3], triangles[t * 3 + corner]);
+			}
+		}
+
+		// Rejects collapses that would turn a surviving triangle around.
+		auto flipsTriangle = [&](uint32_t from, uint32_t to)
+			{
+				for (uint32_t t : trianglesAt[from])
+				{
+					if (removed[t])
+					{
+						continue;
+					}
+
+					const uint32_t* tri = &triangles[t * 3];
+					if (tri[0] == to || tri[1] == to || tri[2] == to)
+					{
+						continue;
+					}
+
+					glm::dvec3 before[3];
+					glm::dvec3 after[3];
+					for (int corner = 0; corner < 3; ++corner)
+					{
+						before[corner] = positions[tri[corner]];
+						after[corner] = tri[corner] == from ? positions[to] : positions[tri[corner]];
+					}
+
+					glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+					glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+					if (glm::dot(normalBefore, normalAfter) <= 0.0)
+					{
+						return true;
+					}
+				}
+
+				return false;
+			};
+
+		double largestCost = 0.0;
+
+		while (liveTriangles * 3 > targetIndexCount && !heap.empty())
+		{
+			Collapse collapse = heap.top();
+			heap.pop();
+
+			if (dead[collapse.From] || dead[collapse.To] ||
+				version[collapse.From] != collapse.FromVersion || version[collapse.To] != collapse.ToVersion)
+			{
+				continue;
+			}
+
+			// Every live edge has a current entry, so the first valid one over budget ends simplification.
+			if (collapse.Cost > maxCost)
+			{
+				break;
+			}
+
+			if (flipsTriangle(collapse.From, collapse.To))
+			{
+				continue;
+			}
+
+			const uint32_t from = collapse.From;
+			const uint32_t to = collapse.To;
+
+			for (uint32_t t : trianglesAt[from])
+			{
+				if (removed[t])
+				{
+					continue;
+				}
+
+				uint32_t* tri = &triangles[t * 3];
+				if (tri[0] == to || tri[1] == to || tri[2] == to)
+				{
+					removed[t] = true;
+					liveTriangles--;
+					continue;
+				}
+
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					if (tri[corner] == from)
+					{
+						tri[corner] = to;
+					}
+				}
+				trianglesAt[to].push_back(t);
+			}
+
+			trianglesAt[from].clear();
+			dead[from] = true;
+			quadrics[to] += quadrics[from];
+			version[to]++;
+			largestCost = std::max(largestCost, collapse.Cost);
+
+			// Only edges touching the surviving vertex changed cost.
+			auto& around = trianglesAt[to];
+			around.erase(std::remove_if(around.begin(), around.end(), [&](uint32_t t) { return removed[t]; }), around.end());
+
+			for (uint32_t t : around)
+			{
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					const uint32_t neighbour = triangles[t * 3 + corner];
+					if (neighbour != to)
+					{
+						pushCollapse(to, neighbour);
+						pushCollapse(neighbour, to);
+					}
+				}
+			}
+		}
+
+		std::vector<unsigned int> result;
+		result.reserve(liveTriangles * 3);
+
+		for (size_t t = 0; t < triangleCount; ++t)
+		{
+			if (removed[t])
+			{
+				continue;
+			}
+
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				const uint32_t original = indices[t * 3 + corner];
+				const uint32_t position = triangles[t * 3 + corner];
+
+				if (positionOf[original] == position)
+				{
+					result.push_back(original);
+					continue;
+				}
+
+				uint32_t best = verticesAt[position][0];
+				float bestDistance = AttributeDistance(vertices[original], vertices[best]);
+				for (uint32_t candidate : verticesAt[position])
+				{
+					float distance = AttributeDistance(vertices[original], vertices[candidate]);
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						best = candidate;
+					}
+				}
+				result.push_back(best);
+			}
+		}
+
+		if (outError)
+		{
+			*outError = static_cast<float>(std::sqrt(largestCost) / extent);
+		}
+
+		return result;
+	}
+}
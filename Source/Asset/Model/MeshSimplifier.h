@@ -0,0 +1,28 @@
+#pragma once
+
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <vector>
+#include <cstddef>
+#include "Renderer/Vertex.h"
+#include "../../OrcaAPI.h"
+
+namespace Orca
+{
+	// Quadric error metric edge-collapse simplifier (Garland & Heckbert).
+	// Collapses move a vertex onto one of its neighbours, so the result indexes the input
+	// vertex buffer and no new vertices are created. Attribute seams are resolved by picking,
+	// on the surviving position, the vertex whose normal and UV are closest to the removed one.
+	class ORCA_API MeshSimplifier
+	{
+	public:
+		// Returns at most targetIndexCount indices, or fewer collapses if the next one would move the
+		// surface by more than maxError (as a fraction of the mesh's bounding box diagonal).
+		// outError receives the largest error actually introduced, in the same units.
+		static std::vector<unsigned int> Simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+			size_t targetIndexCount, float maxError, float* outError = nullptr);
+	};
+}
+
+#endif
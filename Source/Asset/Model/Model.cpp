@@ -5,9 +5,12 @@ namespace Orca {
     Model::Model(const std::string& name)
         : name(name) {}
 
-    void Model::AddMesh(const Mesh& mesh) 
+    void Model::AddMesh(std::shared_ptr<Mesh> mesh) 
     {
-        meshes.push_back(mesh);
+        if (mesh)
+        {
+            meshes.push_back(std::move(mesh));
+        }
     }
 
     void Model::AddMaterial(const Material& material) 
@@ -20,7 +23,7 @@ namespace Orca {
         return name;
     }
 
-    const std::vector<Mesh>& Model::GetMesh() const 
+    const std::vector<std::shared_ptr<Mesh>>& Model::GetMesh() const 
     {
         return meshes;
     }
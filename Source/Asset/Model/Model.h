@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include "Renderer/Mesh.h"
 #include "Material/Material.h"
 
@@ -19,16 +20,17 @@ namespace Orca
 	public:
 		Model(const std::string& name);
 
-		void AddMesh(const Mesh& mesh);
+		void AddMesh(std::shared_ptr<Mesh> mesh);
 		void AddMaterial(const Material& mat);
 
 		const std::string& GetName() const;
-		const std::vector<Mesh>& GetMesh() const;
+		const std::vector<std::shared_ptr<Mesh>>& GetMesh() const;
 		const std::vector<Material>& GetMaterial() const;
 
 	private:
 		std::string name;
-		std::vector<Mesh> meshes;
+		// Meshes own GL handles, so they are shared rather than copied.
+		std::vector<std::shared_ptr<Mesh>> meshes;
 		std::vector<Material> materials;
 	};
 #pragma warning(pop)
@@ -2,10 +2,13 @@
 #include <tiny_obj_loader.h>
 #include <tiny_gltf.h>
 #include <iostream>
+#include <sstream>
+#include <iomanip>
+#include "Core/Logger.h"
 
 namespace Orca
 {
-	Model ModelImporter::ImportFromOBJ(const std::string& filePath)
+	Model ModelImporter::ImportFromOBJ(const std::string& filePath, const MeshImportSettings& settings)
 	{
 		tinyobj::attrib_t attribute;
 		std::vector<tinyobj::shape_t> shapes;
@@ -24,7 +27,10 @@ namespace Orca
 
 		for (const auto& shape : shapes)
 		{
-			Mesh mesh(shape.name);
+			std::vector<Vertex> vertices;
+			std::vector<unsigned int> indices;
+			vertices.reserve(shape.mesh.indices.size());
+			indices.reserve(shape.mesh.indices.size());
 
 			for (const auto& index : shape.mesh.indices)
 			{
@@ -48,18 +54,88 @@ namespace Orca
 				if (index.texcoord_index >= 0)
 				{
 					uv = {
-						attribute.texcoords[3 * index.texcoord_index + 0],
-						attribute.texcoords[3 * index.texcoord_index + 1]
+						attribute.texcoords[2 * index.texcoord_index + 0],
+						attribute.texcoords[2 * index.texcoord_index + 1]
 					};
 				}
 
-				mesh.AddVertex(position, normal, uv);
+				indices.push_back(static_cast<unsigned int>(vertices.size()));
+				vertices.push_back({ position, normal, uv });
+			}
+
+			// The loop above emits one vertex per index; welding and reordering happen here.
+			if (settings.OptimizeMeshes)
+			{
+				MeshOptimizationStats stats = MeshOptimizer::Optimize(vertices, indices, settings.Optimization);
+
+				std::ostringstream message;
+				message << std::fixed << std::setprecision(3)
+					<< "Optimized mesh '" << shape.name << "': "
+					<< stats.SourceVertexCount << " -> " << stats.VertexCount << " vertices, "
+					<< stats.TriangleCount << " triangles, ACMR " << stats.Before.ACMR << " -> " << stats.After.ACMR
+					<< ", ATVR " << stats.Before.ATVR << " -> " << stats.After.ATVR;
+				Logger::Log(LogLevel::Info, message.str());
+			}
+
+			// Vertex data is packed into the compact layout here, once, rather than at load time.
+			std::shared_ptr<Mesh> mesh = Mesh::Create(vertices, indices, settings.Compression);
+			if (mesh)
+			{
+				mesh->SetName(shape.name);
+				GenerateLods(*mesh, vertices, indices, settings);
+				model.AddMesh(mesh);
 			}
 		}
 
 		return model;
 	}
 
+	void ModelImporter::GenerateLods(Mesh& mesh, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+		const MeshImportSettings& settings)
+	{
+		size_t previousIndexCount = indices.size();
+		float targetRatio = 1.0f;
+		float screenSize = settings.LodScreenSize;
+
+		for (uint32_t level = 1; level <= settings.LodCount; ++level)
+		{
+			targetRatio *= settings.LodReduction;
+			size_t targetIndexCount = static_cast<size_t>(indices.size() * targetRatio) / 3 * 3;
+
+			// Every level is simplified from the full mesh so errors do not compound between levels.
+			float error = 0.0f;
+			std::vector<unsigned int> lodIndices = MeshSimplifier::Simplify(vertices, indices, targetIndexCount, settings.LodMaxError, &error);
+
+			// Stop once the error budget prevents a meaningful reduction.
+			if (lodIndices.empty() || lodIndices.size() > previousIndexCount * 9 / 10)
+			{
+				break;
+			}
+
+			std::vector<Vertex> lodVertices = vertices;
+			MeshOptimizer::OptimizeVertexCache(lodIndices, static_cast<uint32_t>(lodVertices.size()));
+			MeshOptimizer::OptimizeVertexFetch(lodVertices, lodIndices);
+
+			std::shared_ptr<Mesh> lod = Mesh::Create(lodVertices, lodIndices, settings.Compression);
+			if (!lod)
+			{
+				break;
+			}
+
+			lod->SetName(mesh.GetName() + "_LOD" + std::to_string(level));
+			mesh.AddLod(lod, screenSize);
+
+			std::ostringstream message;
+			message << std::fixed << std::setprecision(4)
+				<< "Generated LOD" << level << " for '" << mesh.GetName() << "': "
+				<< lodIndices.size() / 3 << " / " << indices.size() / 3 << " triangles, error " << error;
+			Logger::Log(LogLevel::Info, message.str());
+
+			previousIndexCount = lodIndices.size();
+			screenSize *= 0.5f;
+		}
+	}
+
 	Model ModelImporter::ImportFromGLB(const std::string& filePath)
 	{
 		tinygltf::Model gltfmodel;
@@ -5,18 +5,40 @@
 
 #include <string>
 #include "Model.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 
 namespace Orca
 {
 #pragma warning(push)
 #pragma warning(disable: 4251)
 
+	struct MeshImportSettings
+	{
+		VertexCompressionSettings Compression = VertexCompressionSettings::Compact();
+
+		bool OptimizeMeshes = true;
+		MeshOptimizationSettings Optimization;
+
+		// Each LOD keeps LodReduction of the previous level's triangles, within LodMaxError
+		// (fraction of the mesh's bounding box diagonal). LOD 1 is used below LodScreenSize of the
+		// viewport height, and each further level at half the previous threshold.
+		uint32_t LodCount = 3;
+		float LodReduction = 0.5f;
+		float LodMaxError = 0.02f;
+		float LodScreenSize = 0.25f;
+	};
+
 	class ORCA_API ModelImporter
 	{
 	public:
-		static Model ImportFromOBJ(const std::string& filePath);
+		static Model ImportFromOBJ(const std::string& filePath, const MeshImportSettings& settings = {});
 		static Model ImportFromGLB(const std::string& filePath);
 		static Model ImportFromGLTF(const std::string& filePath);
+
+	private:
+		static void GenerateLods(Mesh& mesh, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+			const MeshImportSettings& settings);
 	};
 #pragma warning(pop)
 }
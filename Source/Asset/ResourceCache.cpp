@@ -0,0 +1,176 @@
+#include "ResourceCache.h"
+#include "../Core/Logger.h"
+#include "../Renderer/TextureStreamer.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <sstream>
+
+namespace Orca
+{
+	std::unordered_map<std::string, std::shared_ptr<Texture>> ResourceCache::s_Textures;
+	std::unordered_map<std::string, std::shared_ptr<Model>> ResourceCache::s_Models;
+
+	namespace
+	{
+		std::string GetExtension(const std::string& path)
+		{
+			std::string extension = std::filesystem::path(path).extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return extension;
+		}
+
+		// Drops entries only the cache still references and inUse doesn't claim.
+		template<typename T, typename InUse>
+		uint32_t CollectUnused(std::unordered_map<std::string, std::shared_ptr<T>>& entries, InUse inUse)
+		{
+			uint32_t unloaded = 0;
+			for (auto it = entries.begin(); it != entries.end();)
+			{
+				if (it->second.use_count() == 1 && !inUse(*it->second))
+				{
+					it = entries.erase(it);
+					unloaded++;
+				}
+				else
+				{
+					++it;
+				}
+			}
+			return unloaded;
+		}
+	}
+
+	std::shared_ptr<Texture> ResourceCache::LoadTexture(const std::string& path, float priority)
+	{
+		const std::string key = GetCanonicalPath(path);
+		auto existing = s_Textures.find(key);
+		if (existing != s_Textures.end())
+		{
+			// Raises the priority if this user needs it more.
+			TextureStreamer::Load(key, priority);
+			return existing->second;
+		}
+
+		Texture* texture = TextureStreamer::Load(key, priority);
+		if (!texture)
+		{
+			return nullptr;
+		}
+
+		// TextureStreamer owns the texture; the last handle, normally the cache's own, gives it back.
+		std::shared_ptr<Texture> handle(texture, [](Texture* released) { TextureStreamer::Release(*released); });
+		s_Textures.emplace(key, handle);
+		return handle;
+	}
+
+	std::shared_ptr<Model> ResourceCache::LoadModel(const std::string& path, const MeshImportSettings& settings)
+	{
+		const std::string key = MakeModelKey(path, settings);
+		auto existing = s_Models.find(key);
+		if (existing != s_Models.end())
+		{
+			return existing->second;
+		}
+
+		const std::string canonicalPath = GetCanonicalPath(path);
+		if (!std::filesystem::exists(canonicalPath))
+		{
+			Logger::Log(LogLevel::Error, "Failed to load model: " + path);
+			return nullptr;
+		}
+
+		const std::string extension = GetExtension(canonicalPath);
+		std::shared_ptr<Model> model;
+		if (extension == ".obj")
+		{
+			model = std::make_shared<Model>(ModelImporter::ImportFromOBJ(canonicalPath, settings));
+		}
+		else if (extension == ".glb")
+		{
+			model = std::make_shared<Model>(ModelImporter::ImportFromGLB(canonicalPath));
+		}
+		else if (extension == ".gltf")
+		{
+			model = std::make_shared<Model>(ModelImporter::ImportFromGLTF(canonicalPath));
+		}
+		else
+		{
+			Logger::Log(LogLevel::Error, "Unsupported model format: " + path);
+			return nullptr;
+		}
+
+		s_Models.emplace(key, model);
+		return model;
+	}
+
+	std::shared_ptr<Texture> ResourceCache::FindTexture(const std::string& path)
+	{
+		auto it = s_Textures.find(GetCanonicalPath(path));
+		return it != s_Textures.end() ? it->second : nullptr;
+	}
+
+	std::shared_ptr<Model> ResourceCache::FindModel(const std::string& path, const MeshImportSettings& settings)
+	{
+		auto it = s_Models.find(MakeModelKey(path, settings));
+		return it != s_Models.end() ? it->second : nullptr;
+	}
+
+	uint32_t ResourceCache::Collect()
+	{
+		// Models first: their meshes are freed with them, and their materials may hold the last
+		// outside references to textures. A MeshComponent holds meshes, not the model, so a model
+		// whose meshes are still in use is kept for the next LoadModel of it to share.
+		uint32_t unloaded = CollectUnused(s_Models, [](const Model& model)
+			{
+				const auto& meshes = model.GetMesh();
+				return std::any_of(meshes.begin(), meshes.end(), [](const std::shared_ptr<Mesh>& mesh) { return mesh.use_count() > 1; });
+			});
+		unloaded += CollectUnused(s_Textures, [](const Texture&) { return false; });
+		return unloaded;
+	}
+
+	void ResourceCache::Clear()
+	{
+		s_Models.clear();
+		s_Textures.clear();
+	}
+
+	std::string ResourceCache::GetCanonicalPath(const std::string& path)
+	{
+		std::error_code error;
+		std::filesystem::path canonical = std::filesystem::weakly_canonical(std::filesystem::absolute(path, error), error);
+		if (error)
+		{
+			canonical = std::filesystem::path(path).lexically_normal();
+		}
+
+		std::string result = canonical.generic_string();
+#ifdef _WIN32
+		std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+		return result;
+	}
+
+	std::string ResourceCache::MakeModelKey(const std::string& path, const MeshImportSettings& settings)
+	{
+		const std::string canonicalPath = GetCanonicalPath(path);
+		if (GetExtension(canonicalPath) != ".obj")
+		{
+			return canonicalPath;
+		}
+
+		// Only OBJ import takes settings; a model imported two ways is two resources.
+		const VertexCompressionSettings& compression = settings.Compression;
+		const MeshOptimizationSettings& optimization = settings.Optimization;
+
+		std::ostringstream key;
+		key << canonicalPath << '|'
+			<< static_cast<int>(compression.Positions) << compression.OctahedralNormals << compression.HalfTexCoords << '|'
+			<< settings.OptimizeMeshes << optimization.WeldVertices << optimization.OptimizeVertexCache
+			<< optimization.OptimizeOverdraw << optimization.OptimizeVertexFetch << ',' << optimization.OverdrawThreshold
+			<< ',' << optimization.CacheSize << '|'
+			<< settings.LodCount << ',' << settings.LodReduction << ',' << settings.LodMaxError << ',' << settings.LodScreenSize;
+		return key.str();
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef RESOURCE_CACHE_H
+#define RESOURCE_CACHE_H
+
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "Model/ModelImporter.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	class Texture;
+
+	// Hands out shared handles to textures and models so every user of a file gets the same GPU
+	// resource. Entries are keyed by canonical path, plus the import settings for models.
+	//
+	// The cache keeps its own reference, so dropping the last outside handle doesn't free anything
+	// mid-frame; Collect() unloads what nobody else holds, at a point where no draw can still use it.
+	// A texture handle that outlives its cache entry (after Clear()) hands the texture back to
+	// TextureStreamer::Release when it goes, so it is unloaded on the next streamer update.
+	// Main thread only, not while recording jobs are running.
+	class ORCA_API ResourceCache
+	{
+	public:
+		// Null if the file can't be read. Textures are streamed; see TextureStreamer.
+		static std::shared_ptr<Texture> LoadTexture(const std::string& path, float priority = 1.0f);
+		static std::shared_ptr<Model> LoadModel(const std::string& path, const MeshImportSettings& settings = {});
+
+		// Weak lookups: only return what is already loaded, never load.
+		static std::shared_ptr<Texture> FindTexture(const std::string& path);
+		static std::shared_ptr<Model> FindModel(const std::string& path, const MeshImportSettings& settings = {});
+
+		// GL thread, between frames. Returns how many resources were dropped. A model stays while
+		// anyone still holds one of its meshes, so reloading it can't duplicate the geometry.
+		// Textures are unloaded on the next TextureStreamer::Update().
+		static uint32_t Collect();
+
+		// Drops every cached reference. Before TextureStreamer::Shutdown; handles kept past that
+		// point must not be used.
+		static void Clear();
+
+		static uint32_t GetTextureCount() { return static_cast<uint32_t>(s_Textures.size()); }
+		static uint32_t GetModelCount() { return static_cast<uint32_t>(s_Models.size()); }
+
+		// Absolute, normalized path with forward slashes; lower case on Windows.
+		static std::string GetCanonicalPath(const std::string& path);
+
+	private:
+		static std::unordered_map<std::string, std::shared_ptr<Texture>> s_Textures;
+		static std::unordered_map<std::string, std::shared_ptr<Model>> s_Models;
+
+		static std::string MakeModelKey(const std::string& path, const MeshImportSettings& settings);
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "Engine.h"
 #include "Timer.h"
+#include "Logger.h"
 #include "Runtime/SystemManager.h"
 
 namespace Orca 
@@ -44,6 +45,9 @@ namespace Orca
     {
         SystemManager::Shutdown();
 
+        // Writes out whatever is still queued and joins the writer thread before the DLL unloads.
+        Logger::Shutdown();
+
         window = nullptr;
 
         m_Running = false;
@@ -0,0 +1,222 @@
+#include "JobSystem.h"
+#include "Logger.h"
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+
+namespace Orca
+{
+	namespace
+	{
+		struct JobQueue
+		{
+			std::vector<std::thread> workers;
+			std::deque<std::function<void()>> tasks;
+			std::mutex mutex;
+			std::condition_variable wake;
+			std::atomic<bool> running{ false };
+		};
+
+		JobQueue s_Queue;
+
+		// Shared by the caller of Dispatch() and the queue tasks it posts. Whoever runs first claims
+		// the next job index, so the caller only ever runs its own jobs. Tasks a worker picks up after
+		// every index is claimed return without touching Job, which may be gone by then.
+		struct DispatchState
+		{
+			const std::function<void(unsigned int jobIndex)>* Job = nullptr;
+			unsigned int Count = 0;
+			std::atomic<unsigned int> Next{ 0 };
+			std::atomic<unsigned int> Remaining{ 0 };
+		};
+
+		void RunDispatchJobs(DispatchState& state)
+		{
+			unsigned int index;
+			while ((index = state.Next.fetch_add(1, std::memory_order_relaxed)) < state.Count)
+			{
+				try
+				{
+					(*state.Job)(index);
+				}
+				catch (const std::exception& e)
+				{
+					Logger::Log(LogLevel::Error, std::string("JobSystem::Dispatch job threw: ") + e.what());
+				}
+				catch (...)
+				{
+					Logger::Log(LogLevel::Error, "JobSystem::Dispatch job threw a non-standard exception.");
+				}
+				state.Remaining.fetch_sub(1, std::memory_order_acq_rel);
+			}
+		}
+
+		void WorkerLoop()
+		{
+			while (true)
+			{
+				std::function<void()> task;
+				{
+					std::unique_lock<std::mutex> lock(s_Queue.mutex);
+					s_Queue.wake.wait(lock, [] { return !s_Queue.running || !s_Queue.tasks.empty(); });
+
+					if (!s_Queue.running && s_Queue.tasks.empty())
+					{
+						return;
+					}
+
+					task = std::move(s_Queue.tasks.front());
+					s_Queue.tasks.pop_front();
+				}
+
+				task();
+			}
+		}
+	}
+
+	void JobSystem::Initialize(unsigned int workerCount)
+	{
+		if (s_Queue.running)
+		{
+			return;
+		}
+
+		if (workerCount == 0)
+		{
+			unsigned int hardware = std::thread::hardware_concurrency();
+			workerCount = hardware > 1 ? hardware - 1 : 1;
+		}
+
+		s_Queue.running = true;
+		s_Queue.workers.reserve(workerCount);
+		for (unsigned int i = 0; i < workerCount; ++i)
+		{
+			s_Queue.workers.emplace_back(WorkerLoop);
+		}
+
+		Logger::Log(LogLevel::Info, "JobSystem initialized with " + std::to_string(workerCount) + " worker threads.");
+	}
+
+	void JobSystem::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_Queue.mutex);
+			if (!s_Queue.running)
+			{
+				return;
+			}
+			s_Queue.running = false;
+		}
+
+		s_Queue.wake.notify_all();
+		for (auto& worker : s_Queue.workers)
+		{
+			if (worker.joinable())
+			{
+				worker.join();
+			}
+		}
+		s_Queue.workers.clear();
+	}
+
+	bool JobSystem::IsInitialized()
+	{
+		return s_Queue.running;
+	}
+
+	unsigned int JobSystem::GetWorkerCount()
+	{
+		return static_cast<unsigned int>(s_Queue.workers.size());
+	}
+
+	void JobSystem::Dispatch(unsigned int jobCount, const std::function<void(unsigned int jobIndex)>& job)
+	{
+		if (jobCount == 0)
+		{
+			return;
+		}
+
+		if (!s_Queue.running || jobCount == 1)
+		{
+			for (unsigned int i = 0; i < jobCount; ++i)
+			{
+				job(i);
+			}
+			return;
+		}
+
+		auto state = std::make_shared<DispatchState>();
+		state->Job = &job;
+		state->Count = jobCount;
+		state->Remaining.store(jobCount, std::memory_order_relaxed);
+
+		// The caller takes a share too, so one task per other job is enough.
+		const unsigned int taskCount = std::min(jobCount - 1, GetWorkerCount());
+		{
+			std::lock_guard<std::mutex> lock(s_Queue.mutex);
+			for (unsigned int i = 0; i < taskCount; ++i)
+			{
+				s_Queue.tasks.emplace_back([state]() { RunDispatchJobs(*state); });
+			}
+		}
+		s_Queue.wake.notify_all();
+
+		// Help out instead of sleeping; the caller is usually the render thread. It only runs this
+		// dispatch's jobs, never unrelated Submit() tasks such as texture decodes.
+		RunDispatchJobs(*state);
+		while (state->Remaining.load(std::memory_order_acquire) > 0)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	unsigned int JobSystem::ParallelFor(size_t itemCount, size_t minItemsPerJob,
+		const std::function<void(unsigned int jobIndex, size_t begin, size_t end)>& job)
+	{
+		if (itemCount == 0)
+		{
+			return 0;
+		}
+
+		minItemsPerJob = std::max<size_t>(1, minItemsPerJob);
+		size_t maxJobs = static_cast<size_t>(GetWorkerCount()) + 1;
+		size_t jobCount = std::min(maxJobs, (itemCount + minItemsPerJob - 1) / minItemsPerJob);
+		size_t itemsPerJob = (itemCount + jobCount - 1) / jobCount;
+
+		Dispatch(static_cast<unsigned int>(jobCount), [&](unsigned int jobIndex)
+			{
+				size_t begin = jobIndex * itemsPerJob;
+				size_t end = std::min(itemCount, begin + itemsPerJob);
+				if (begin < end)
+				{
+					job(jobIndex, begin, end);
+				}
+			});
+
+		return static_cast<unsigned int>(jobCount);
+	}
+
+	std::future<void> JobSystem::Submit(std::function<void()> task)
+	{
+		auto packaged = std::make_shared<std::packaged_task<void()>>(std::move(task));
+		std::future<void> future = packaged->get_future();
+
+		if (!s_Queue.running)
+		{
+			(*packaged)();
+			return future;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(s_Queue.mutex);
+			s_Queue.tasks.emplace_back([packaged]() { (*packaged)(); });
+		}
+		s_Queue.wake.notify_one();
+
+		return future;
+	}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <functional>
+#include <future>
+#include <cstdint>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Fixed pool of worker threads shared by the engine systems.
+	// Dispatch() blocks until every job has run; the calling thread runs the dispatch's own
+	// jobs alongside the workers, never other queued tasks, so it is safe to call from the
+	// thread that owns the GL context.
+	class ORCA_API JobSystem
+	{
+	public:
+		static void Initialize(unsigned int workerCount = 0);
+		static void Shutdown();
+
+		static bool IsInitialized();
+		static unsigned int GetWorkerCount();
+
+		// Runs job(jobIndex) for jobIndex in [0, jobCount) across the pool and waits for completion.
+		static void Dispatch(unsigned int jobCount, const std::function<void(unsigned int jobIndex)>& job);
+
+		// Splits [0, itemCount) into at most GetWorkerCount() + 1 contiguous ranges.
+		// Returns the number of jobs used so callers can size per-job storage.
+		static unsigned int ParallelFor(size_t itemCount, size_t minItemsPerJob,
+			const std::function<void(unsigned int jobIndex, size_t begin, size_t end)>& job);
+
+		// Fire-and-forget task. The future becomes ready when the task has run.
+		static std::future<void> Submit(std::function<void()> task);
+	};
+#pragma warning(pop)
+}
+
+#endif
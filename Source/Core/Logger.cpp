@@ -1,10 +1,125 @@
 #include "Logger.h"
+#include <ctime>
+#include <thread>
 
 namespace Orca
 {
 	std::mutex Logger::s_Mutex;
 	std::ofstream Logger::s_LogStream;
-	LogLevel Logger::s_CurrentLevel = LogLevel::Info;
+	std::atomic<LogLevel> Logger::s_CurrentLevel{ LogLevel::Info };
+
+	namespace
+	{
+		constexpr size_t k_RingCapacity = 1024;			// Power of two
+		constexpr size_t k_MaxMessageLength = 4096;
+
+		struct LogSlot
+		{
+			std::atomic<size_t> Sequence{ 0 };
+			LogLevel Level = LogLevel::Info;
+			int64_t Time = 0;						// system_clock ticks
+			std::string Message;					// Keeps its capacity, so steady-state logging doesn't allocate
+		};
+
+		// Bounded multi-producer queue. A slot's sequence says whose turn it is: equal to a position,
+		// the slot is free for the producer that claims that position; one past it, the message is
+		// published for the writer; a lap later, the writer is done with it.
+		struct LogRing
+		{
+			LogSlot Slots[k_RingCapacity];
+			std::atomic<size_t> EnqueuePosition{ 0 };
+			size_t DequeuePosition = 0;				// Writer thread, or DrainQueue() once it is joined
+
+			LogRing()
+			{
+				for (size_t i = 0; i < k_RingCapacity; ++i)
+				{
+					Slots[i].Sequence.store(i, std::memory_order_relaxed);
+				}
+			}
+
+			LogSlot* Claim(size_t& position)
+			{
+				position = EnqueuePosition.load(std::memory_order_relaxed);
+				while (true)
+				{
+					LogSlot& slot = Slots[position & (k_RingCapacity - 1)];
+					const intptr_t diff = static_cast<intptr_t>(slot.Sequence.load(std::memory_order_acquire)) - static_cast<intptr_t>(position);
+
+					if (diff == 0)
+					{
+						if (EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							return &slot;
+						}
+					}
+					else if (diff < 0)
+					{
+						return nullptr;		// Full: the writer hasn't freed this slot from the last lap
+					}
+					else
+					{
+						position = EnqueuePosition.load(std::memory_order_relaxed);
+					}
+				}
+			}
+
+			LogSlot* Peek()
+			{
+				LogSlot& slot = Slots[DequeuePosition & (k_RingCapacity - 1)];
+				return slot.Sequence.load(std::memory_order_acquire) == DequeuePosition + 1 ? &slot : nullptr;
+			}
+
+			void Release(LogSlot& slot)
+			{
+				slot.Sequence.store(DequeuePosition + k_RingCapacity, std::memory_order_release);
+				DequeuePosition++;
+			}
+		};
+
+		struct LoggerState
+		{
+			LogRing Ring;
+			std::thread Writer;
+		};
+
+		// Created on the first Log(), so logging works from other static initializers, and never
+		// destroyed: a destructor would have to stop the writer during static destruction, which in
+		// the engine DLL runs under the loader lock. Shutdown() is the only place the writer stops.
+		LoggerState& GetState()
+		{
+			static LoggerState* state = new LoggerState;
+			return *state;
+		}
+
+		std::mutex s_WriterMutex;					// Starting and stopping the writer
+		std::atomic<bool> s_WriterRunning{ false };
+		bool s_ShutDown = false;					// Under s_WriterMutex; no writer is started after Shutdown()
+		std::atomic<bool> s_StopWriter{ false };
+		std::atomic<bool> s_WriterStopped{ false };	// Set once Shutdown() has joined; the ring is drained inline from then on
+		std::atomic<bool> s_WriterIdle{ false };
+		std::atomic<uint32_t> s_Wake{ 0 };
+		std::atomic<size_t> s_Written{ 0 };		// Ring positions below this are on disk
+		std::atomic<uint64_t> s_Dropped{ 0 };
+
+		void WakeWriter()
+		{
+			s_Wake.fetch_add(1, std::memory_order_release);
+			s_Wake.notify_one();
+		}
+
+		const char* LevelTag(LogLevel level)
+		{
+			switch (level)
+			{
+			case LogLevel::Info:    return "[INFO] ";
+			case LogLevel::Warning: return "[WARNING] ";
+			case LogLevel::Error:   return "[ERROR] ";
+			case LogLevel::Fatal:   return "[FATAL] ";
+			}
+			return "";
+		}
+	}
 
 	void Logger::Init(const std::string& logFile)
 	{
@@ -17,69 +132,283 @@ namespace Orca
 
 	void Logger::Log(LogLevel level, const std::string& msg)
 	{
-		std::lock_guard<std::mutex> lock(s_Mutex);
-		if (level < s_CurrentLevel)
+		if (level < s_CurrentLevel.load(std::memory_order_relaxed))
 		{
 			return;
 		}
 
-		std::string formatted = FormatMessage(level, msg);
+		if (!s_WriterRunning.load(std::memory_order_acquire) && !StartWriter())
+		{
+			WriteNow(level, msg);
+			if (level == LogLevel::Fatal)
+			{
+				std::terminate();
+			}
+			return;
+		}
 
-		std::cout << formatted << std::endl;
+		const int64_t time = static_cast<int64_t>(std::chrono::system_clock::now().time_since_epoch().count());
 
-		if (s_LogStream.is_open())
+		LogRing& ring = GetState().Ring;
+		size_t position = 0;
+		LogSlot* slot = ring.Claim(position);
+
+		while (!slot)
 		{
-			s_LogStream << formatted << std::endl;
+			if (level != LogLevel::Fatal)
+			{
+				s_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			WakeWriter();
+			std::this_thread::yield();
+			slot = ring.Claim(position);
+		}
+
+		slot->Level = level;
+		slot->Time = time;
+		slot->Message.assign(msg, 0, k_MaxMessageLength);
+		slot->Sequence.store(position + 1, std::memory_order_release);
+
+		// Pairs with the fences in WriterLoop and Shutdown: either the writer or Shutdown's drain
+		// sees this message, or this thread sees the writer idle and wakes it, or sees it gone and
+		// writes the message out itself.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (s_WriterStopped.load(std::memory_order_relaxed))
+		{
+			DrainQueue();
+		}
+		else if (s_WriterIdle.load(std::memory_order_relaxed))
+		{
+			WakeWriter();
 		}
 
 		if (level == LogLevel::Fatal)
 		{
+			Flush();
 			std::terminate();
 		}
 	}
 
+	void Logger::Flush()
+	{
+		if (!s_WriterRunning.load(std::memory_order_acquire))
+		{
+			if (s_WriterStopped.load(std::memory_order_acquire))
+			{
+				DrainQueue();
+			}
+			return;
+		}
+
+		const size_t target = GetState().Ring.EnqueuePosition.load(std::memory_order_acquire);
+		WakeWriter();
+
+		size_t written = s_Written.load(std::memory_order_acquire);
+		while (written < target)
+		{
+			if (s_WriterStopped.load(std::memory_order_acquire))
+			{
+				DrainQueue();
+				return;
+			}
+
+			// A stopping writer may exit without reaching target, so only a running one is waited on.
+			if (s_StopWriter.load(std::memory_order_acquire))
+			{
+				std::this_thread::yield();
+			}
+			else
+			{
+				s_Written.wait(written, std::memory_order_acquire);
+			}
+			written = s_Written.load(std::memory_order_acquire);
+		}
+	}
+
+	void Logger::Shutdown()
+	{
+		std::lock_guard<std::mutex> lock(s_WriterMutex);
+		s_ShutDown = true;
+		if (!s_WriterRunning.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		LoggerState& state = GetState();
+		s_StopWriter.store(true, std::memory_order_release);
+		WakeWriter();
+		state.Writer.join();
+
+		// Producers that got past the running check may still publish after the writer's last
+		// look; from here on they drain themselves, and this picks up anyone who didn't see the flag.
+		s_WriterRunning.store(false, std::memory_order_release);
+		s_WriterStopped.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		DrainQueue();
+	}
+
 	void Logger::SetLogLevel(LogLevel level)
 	{
-		std::lock_guard<std::mutex> lock(s_Mutex);
-		s_CurrentLevel = level;
+		s_CurrentLevel.store(level, std::memory_order_relaxed);
 	}
 
 	LogLevel Logger::GetLogLevel()
 	{
+		return s_CurrentLevel.load(std::memory_order_relaxed);
+	}
+
+	uint64_t Logger::GetDroppedCount()
+	{
+		return s_Dropped.load(std::memory_order_relaxed);
+	}
+
+	bool Logger::StartWriter()
+	{
+		std::lock_guard<std::mutex> lock(s_WriterMutex);
+		if (s_WriterRunning.load(std::memory_order_relaxed))
+		{
+			return true;
+		}
+
+		if (s_ShutDown)
+		{
+			return false;
+		}
+
+		GetState().Writer = std::thread(&Logger::WriterLoop);
+		s_WriterRunning.store(true, std::memory_order_release);
+		return true;
+	}
+
+	void Logger::WriteNow(LogLevel level, const std::string& msg)
+	{
+		// The writer has stopped for good, so its formatting cache is free; the lock keeps
+		// concurrent callers off it and off the streams.
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		std::string line;
+		FormatMessage(level, static_cast<int64_t>(std::chrono::system_clock::now().time_since_epoch().count()), msg, line);
+		WriteLocked(line);
+	}
+
+	void Logger::DrainQueue()
+	{
+		// Only called once the writer has been joined, so the lock makes this thread the consumer.
 		std::lock_guard<std::mutex> lock(s_Mutex);
-		return s_CurrentLevel;
+
+		LogRing& ring = GetState().Ring;
+		std::string batch;
+		while (LogSlot* slot = ring.Peek())
+		{
+			FormatMessage(slot->Level, slot->Time, slot->Message, batch);
+			ring.Release(*slot);
+		}
+
+		if (!batch.empty())
+		{
+			WriteLocked(batch);
+		}
+
+		s_Written.store(ring.DequeuePosition, std::memory_order_release);
+		s_Written.notify_all();
 	}
 
-	std::string Logger::FormatMessage(LogLevel level, const std::string& msg)
+	void Logger::WriteLocked(const std::string& text)
 	{
-		std::ostringstream oss;
-		oss << Timestamp() << " ";
-		
-		switch (level)
+		std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+		std::cout.flush();
+		if (s_LogStream.is_open())
 		{
-		case LogLevel::Info:    oss << "[INFO] "; break;
-		case LogLevel::Warning: oss << "[WARNING] "; break;
-		case LogLevel::Error:   oss << "[ERROR] "; break;
-		case LogLevel::Fatal:   oss << "[FATAL] "; break;
+			s_LogStream.write(text.data(), static_cast<std::streamsize>(text.size()));
+			s_LogStream.flush();
 		}
+	}
+
+	void Logger::WriterLoop()
+	{
+		LogRing& ring = GetState().Ring;
+		std::string batch;
+		uint64_t reportedDrops = s_Dropped.load(std::memory_order_relaxed);
 
-		oss << msg;
-		return oss.str();
+		while (true)
+		{
+			batch.clear();
+			while (LogSlot* slot = ring.Peek())
+			{
+				FormatMessage(slot->Level, slot->Time, slot->Message, batch);
+				ring.Release(*slot);
+			}
+
+			const uint64_t dropped = s_Dropped.load(std::memory_order_relaxed);
+			if (dropped != reportedDrops)
+			{
+				const std::string note = std::to_string(dropped - reportedDrops) + " log messages dropped, the queue was full";
+				FormatMessage(LogLevel::Warning, static_cast<int64_t>(std::chrono::system_clock::now().time_since_epoch().count()), note, batch);
+				reportedDrops = dropped;
+			}
+
+			if (!batch.empty())
+			{
+				std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+				std::cout.flush();
+
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				if (s_LogStream.is_open())
+				{
+					s_LogStream.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+					s_LogStream.flush();
+				}
+			}
+
+			s_Written.store(ring.DequeuePosition, std::memory_order_release);
+			s_Written.notify_all();
+
+			// Only stops once nothing is left, so Shutdown() doubles as a flush.
+			const bool stop = s_StopWriter.load(std::memory_order_acquire);
+			if (stop && !ring.Peek())
+			{
+				break;
+			}
+
+			const uint32_t wake = s_Wake.load(std::memory_order_acquire);
+			s_WriterIdle.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (!ring.Peek() && !s_StopWriter.load(std::memory_order_acquire))
+			{
+				s_Wake.wait(wake, std::memory_order_acquire);
+			}
+			s_WriterIdle.store(false, std::memory_order_relaxed);
+		}
 	}
 
-	std::string Logger::Timestamp()
+	void Logger::FormatMessage(LogLevel level, int64_t time, const std::string& msg, std::string& out)
 	{
-		auto now = std::chrono::system_clock::now();
-		auto time = std::chrono::system_clock::to_time_t(now);
-		std::tm tm;
+		// Writer thread only, or under s_Mutex once it has stopped. Messages come in bursts, so the date
+		// is formatted once per second.
+		static int64_t s_CachedSecond = -1;
+		static char s_CachedStamp[32] = {};
+
+		const std::chrono::system_clock::time_point point{ std::chrono::system_clock::duration(time) };
+		const std::time_t seconds = std::chrono::system_clock::to_time_t(point);
+
+		if (static_cast<int64_t>(seconds) != s_CachedSecond)
+		{
+			std::tm tm;
 #if defined(_WIN32)
-		localtime_s(&tm, &time);
+			localtime_s(&tm, &seconds);
 #else
-		localtime_r(&time, &tm);
+			localtime_r(&seconds, &tm);
 #endif
+			std::strftime(s_CachedStamp, sizeof(s_CachedStamp), "%Y-%m-%d %H:%M:%S", &tm);
+			s_CachedSecond = static_cast<int64_t>(seconds);
+		}
 
-		std::ostringstream oss;
-		oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-		return oss.str();
+		out += s_CachedStamp;
+		out += ' ';
+		out += LevelTag(level);
+		out += msg;
+		out += '\n';
 	}
-}
\ No newline at end of file
+}
@@ -10,6 +10,8 @@
 #include <mutex>
 #include <chrono>
 #include <iomanip>
+#include <atomic>
+#include <cstdint>
 #include"../OrcaAPI.h"
 
 namespace Orca
@@ -25,21 +27,46 @@ namespace Orca
 #pragma warning(push)
 #pragma warning(disable: 4251)
 
+	// Log() never blocks and never touches I/O: the message and its time go into a fixed ring of
+	// slots that any thread can claim without locking, and a background thread formats and writes
+	// them to stdout and the log file, flushing once per batch. When the ring is full, messages
+	// below Fatal are dropped and counted; the writer reports the count once it catches up.
+	// Messages are cut to 4 KB, so the ring never holds more than a few megabytes.
+	//
+	// Fatal waits for a slot, flushes everything logged before it and terminates.
+	//
+	// The writer is only ever stopped by Shutdown(), never from a static destructor, so a process
+	// must call it (Engine::Shutdown does) or lose whatever is still queued when it exits.
 	class ORCA_API Logger
 	{
 	public:
 		static void Init(const std::string& logFile = "");
 		static void Log(LogLevel level, const std::string& msg);
+
+		// Blocks until everything logged so far is written.
+		static void Flush();
+
+		// Flushes and joins the writer thread, for good: later messages are written synchronously on
+		// the logging thread.
+		static void Shutdown();
 		
 		static void SetLogLevel(LogLevel level);
 		static LogLevel GetLogLevel();
 
+		static uint64_t GetDroppedCount();
+
 	private:
-		static std::mutex s_Mutex;
+		static std::mutex s_Mutex;				// The file stream, shared by Init() and the writer thread
 		static std::ofstream s_LogStream;	
-		static LogLevel s_CurrentLevel;
-		static std::string FormatMessage(LogLevel level, const std::string& msg);
-		static std::string Timestamp();
+		static std::atomic<LogLevel> s_CurrentLevel;
+		// False once Shutdown() has run.
+		static bool StartWriter();
+		static void WriteNow(LogLevel level, const std::string& msg);
+		// Writes out what is left in the queue once the writer has been joined.
+		static void DrainQueue();
+		static void WriteLocked(const std::string& text);
+		static void WriterLoop();
+		static void FormatMessage(LogLevel level, int64_t time, const std::string& msg, std::string& out);
 	};
 #pragma warning(pop)
 }
@@ -1,12 +1,41 @@
 #include "Material.h"
 #include "../Renderer/ShaderRegistry.h"
+#include "../Renderer/TextureStreamer.h"
+#include "../Asset/ResourceCache.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <stdexcept>
 
 namespace Orca
 {
-    Material::Material(const std::string& vertPath, const std::string& fragPath) 
-        : vertPath(vertPath), fragPath(fragPath) {}
-	Material::Material(const std::string& name) : name(name) {}
+    namespace
+    {
+        constexpr const char* k_DefaultShaderName = "DefaultLit";
+
+        // Wraps after 65535 materials; see GetID().
+        std::atomic<uint16_t> s_NextMaterialID{ 1 };
+    }
+
+    Material::ParameterBuffer::~ParameterBuffer()
+    {
+        if (ID != 0)
+        {
+            glDeleteBuffers(1, &ID);
+        }
+    }
+
+    Material::Material(const std::string& vertPath, const std::string& fragPath)
+        : id(s_NextMaterialID.fetch_add(1, std::memory_order_relaxed))
+    {
+        SetShaderPaths(vertPath, fragPath);
+    }
+
+	Material::Material(const std::string& name) : name(name), id(s_NextMaterialID.fetch_add(1, std::memory_order_relaxed))
+    {
+        SetShaderName(k_DefaultShaderName);
+    }
 
     void Material::SetAlbedoColor(const glm::vec3& color) 
     {
@@ -16,26 +45,173 @@ namespace Orca
     void Material::SetMetallic(float value) 
     {
         metallic = value;
+        SetFloat("u_Metallic", value);
     }
 
     void Material::SetRoughness(float value) 
     {
         roughness = value;
+        SetFloat("u_Roughness", value);
     }
 
     void Material::SetAlbedoTexture(const std::string& path) 
     {
         albedoTexture = path;
+        SetTexture("u_AlbedoMap", path);
+        SetInt("u_HasAlbedoMap", path.empty() ? 0 : 1);
     }
 
     void Material::SetMetallicTexture(const std::string& path) 
     {
         metallicTexture = path;
+        SetTexture("u_MetallicMap", path);
     }
 
     void Material::SetRoughnessTexture(const std::string& path) 
     {
         roughnessTexture = path;
+        SetTexture("u_RoughnessMap", path);
+    }
+
+    void Material::SetFloat(const std::string& name, float value)
+    {
+        SetParam(name, MaterialParamType::Float, &value);
+    }
+
+    void Material::SetInt(const std::string& name, int value)
+    {
+        SetParam(name, MaterialParamType::Int, &value);
+    }
+
+    void Material::SetVec2(const std::string& name, const glm::vec2& value)
+    {
+        SetParam(name, MaterialParamType::Vec2, &value[0]);
+    }
+
+    void Material::SetVec3(const std::string& name, const glm::vec3& value)
+    {
+        SetParam(name, MaterialParamType::Vec3, &value[0]);
+    }
+
+    void Material::SetVec4(const std::string& name, const glm::vec4& value)
+    {
+        SetParam(name, MaterialParamType::Vec4, &value[0]);
+    }
+
+    void Material::SetMat4(const std::string& name, const glm::mat4& value)
+    {
+        SetParam(name, MaterialParamType::Mat4, &value[0][0]);
+    }
+
+    void Material::SetParam(const std::string& name, MaterialParamType type, const void* value)
+    {
+        const MaterialParam* param = materialTemplate->FindParam(name);
+        if (!param || param->Type != type)
+        {
+            return;
+        }
+
+        uint8_t* target = parameters.data() + param->Offset;
+        if (std::memcmp(target, value, param->Size) != 0)
+        {
+            std::memcpy(target, value, param->Size);
+            buffer.Dirty = true;
+        }
+    }
+
+    void Material::SetTexture(const std::string& samplerName, const std::string& path)
+    {
+        auto it = std::find_if(textures.begin(), textures.end(),
+            [&](const auto& texture) { return texture.first == samplerName; });
+
+        if (path.empty())
+        {
+            if (it != textures.end())
+            {
+                textures.erase(it);
+            }
+            return;
+        }
+
+        std::shared_ptr<Texture> texture = ResourceCache::LoadTexture(path);
+        if (it != textures.end())
+        {
+            it->second = std::move(texture);
+        }
+        else
+        {
+            textures.emplace_back(samplerName, std::move(texture));
+        }
+    }
+
+    void Material::ApplyTemplate(std::shared_ptr<MaterialTemplate> newTemplate)
+    {
+        std::vector<uint8_t> packed(newTemplate->GetBlockSize(), 0);
+
+        // Carries over what both layouts declare alike; the rest starts zeroed.
+        if (materialTemplate)
+        {
+            for (const MaterialParam& param : newTemplate->GetParams())
+            {
+                const MaterialParam* old = materialTemplate->FindParam(param.Name);
+                if (old && old->Type == param.Type)
+                {
+                    std::memcpy(packed.data() + param.Offset, parameters.data() + old->Offset, param.Size);
+                }
+            }
+        }
+
+        materialTemplate = std::move(newTemplate);
+        parameters = std::move(packed);
+        buffer.Dirty = true;
+
+        SetFloat("u_Metallic", metallic);
+        SetFloat("u_Roughness", roughness);
+        SetInt("u_HasAlbedoMap", albedoTexture.empty() ? 0 : 1);
+    }
+
+    void Material::Bind() const
+    {
+        const uint32_t size = static_cast<uint32_t>(parameters.size());
+        if (buffer.ID == 0 || buffer.Size != size)
+        {
+            if (buffer.ID == 0)
+            {
+                glGenBuffers(1, &buffer.ID);
+            }
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer.ID);
+            glBufferData(GL_UNIFORM_BUFFER, size, parameters.data(), GL_DYNAMIC_DRAW);
+            buffer.Size = size;
+            buffer.Dirty = false;
+        }
+        else if (buffer.Dirty)
+        {
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer.ID);
+            glBufferSubData(GL_UNIFORM_BUFFER, 0, size, parameters.data());
+            buffer.Dirty = false;
+        }
+        glBindBufferBase(GL_UNIFORM_BUFFER, MaterialTemplate::k_BlockBinding, buffer.ID);
+
+        for (const auto& texture : textures)
+        {
+            const int unit = materialTemplate->FindTexture(texture.first);
+            if (unit >= 0 && texture.second)
+            {
+                texture.second->Bind(static_cast<unsigned int>(unit));
+            }
+        }
+    }
+
+    uint32_t Material::GetParameterUploadSize() const
+    {
+        const uint32_t size = static_cast<uint32_t>(parameters.size());
+        return (buffer.ID == 0 || buffer.Size != size || buffer.Dirty) ? size : 0;
+    }
+
+    uint32_t Material::GetTextureBindCount() const
+    {
+        return static_cast<uint32_t>(std::count_if(textures.begin(), textures.end(),
+            [this](const auto& texture) { return texture.second && materialTemplate->FindTexture(texture.first) >= 0; }));
     }
 
     const std::string& Material::GetName() const 
@@ -72,26 +248,112 @@ namespace Orca
     {
         return roughnessTexture;
     }
+    void Material::RequestTextures(float screenTexels) const
+    {
+        for (const auto& texture : textures)
+        {
+            if (texture.second)
+            {
+                TextureStreamer::Request(*texture.second, screenTexels);
+            }
+        }
+    }
+
+    void Material::ResolveVariant() const
+    {
+        const uint32_t generation = ShaderRegistry::GetGeneration();
+        ShaderVariantSet* variants = ShaderRegistry::FindVariants(shaderName);
+
+        variantCache.Variants.store(variants, std::memory_order_relaxed);
+        variantCache.Index.store(variants ? variants->GetVariantIndex(keywords) : 0, std::memory_order_relaxed);
+        variantCache.Generation.store(generation, std::memory_order_release);
+    }
+
     Shader& Material::GetShader()
     {
-        Shader* shader = ShaderRegistry::Get(shaderName);
+        // The registry only changes on the GL thread between frames, never while jobs record.
+        if (variantCache.Generation.load(std::memory_order_acquire) != ShaderRegistry::GetGeneration())
+        {
+            ResolveVariant();
+        }
+
+        ShaderVariantSet* variants = variantCache.Variants.load(std::memory_order_relaxed);
+        Shader* shader = variants ? variants->GetVariant(0) : nullptr;
         if (!shader)
         {
             throw std::runtime_error("Material::GetShader failed! Shader not found! [" + shaderName + "]");
         }
 
+        // A variant that isn't ready yet is queued, and the base variant draws meanwhile.
+        if (Shader* variant = variants->Request(variantCache.Index.load(std::memory_order_relaxed)))
+        {
+            if (variant->GetStatus() == ShaderStatus::Ready)
+            {
+                return *variant;
+            }
+        }
+
+        // Keeps the material drawing while its program is still compiling in the background.
+        if (shader->GetStatus() == ShaderStatus::Compiling)
+        {
+            if (Shader* placeholder = ShaderRegistry::GetPlaceholder())
+            {
+                return *placeholder;
+            }
+        }
+
         return *shader;
     }
 
+    uint32_t Material::GetProgramKey() const
+    {
+        if (variantCache.Generation.load(std::memory_order_acquire) != ShaderRegistry::GetGeneration())
+        {
+            ResolveVariant();
+        }
+
+        // Variant indices stay below 256; see ShaderVariantSet::k_MaxKeywords.
+        ShaderVariantSet* variants = variantCache.Variants.load(std::memory_order_relaxed);
+        return variants ? (variants->GetID() << 8) | variantCache.Index.load(std::memory_order_relaxed) : 0;
+    }
+
     void Material::SetShaderPaths(const std::string& vertex, const std::string& fragment)
     {
-        vertPath = vertex;
-        fragPath = fragment;
-        shader = new Shader(vertPath, fragPath);
+        const std::string key = vertex + " | " + fragment;
+        if (!ShaderRegistry::FindVariants(key))
+        {
+            ShaderRegistry::Preload(key, vertex, fragment);
+        }
+
+        SetShaderName(key);
     }
 
     void Material::SetShaderName(const std::string& name)
     {
         shaderName = name;
+        ApplyTemplate(MaterialTemplate::Get(name));
+        ResolveVariant();
+    }
+
+    void Material::EnableKeyword(const std::string& keyword)
+    {
+        keywords |= ShaderKeywords::Get(keyword);
+        ResolveVariant();
+    }
+
+    void Material::DisableKeyword(const std::string& keyword)
+    {
+        keywords &= ~ShaderKeywords::Get(keyword);
+        ResolveVariant();
+    }
+
+    bool Material::IsKeywordEnabled(const std::string& keyword) const
+    {
+        return (keywords & ShaderKeywords::Get(keyword)) != 0;
+    }
+
+    ShaderKeywordMask Material::GetKeywords() const
+    {
+        return keywords;
     }
 }
\ No newline at end of file
@@ -6,18 +6,29 @@
 #include <string>
 #include <glm/glm.hpp>
 #include "Renderer/Shader.h"
+#include "Renderer/ShaderVariants.h"
+#include "MaterialTemplate.h"
 #include "../OrcaAPI.h"
 #include <memory>
+#include <vector>
+#include <utility>
+#include <atomic>
 
 namespace Orca
 {
 #pragma warning(push)
 #pragma warning(disable: 4251)
 
+	class Texture;
+
+	// An instance of a MaterialTemplate: parameter values packed in the template's std140 layout and
+	// a texture per sampler. Instances of a shader share its programs, and the parameter block is
+	// uploaded to its uniform buffer only after it changes.
 	class ORCA_API Material
 	{
 	public:
         Material(const std::string& vertPath, const std::string& fragPath);
+		// Uses the DefaultLit shader until SetShaderName or SetShaderPaths picks another.
 		Material(const std::string& name);	
 
         void SetAlbedoColor(const glm::vec3& color);
@@ -37,23 +48,107 @@ namespace Orca
         const std::string& GetMetallicTexture() const;
         const std::string& GetRoughnessTexture() const;
 
+        // By uniform name in the MaterialParams block; names the template doesn't declare, or
+        // declares with another type, are ignored.
+        void SetFloat(const std::string& name, float value);
+        void SetInt(const std::string& name, int value);
+        void SetVec2(const std::string& name, const glm::vec2& value);
+        void SetVec3(const std::string& name, const glm::vec3& value);
+        void SetVec4(const std::string& name, const glm::vec4& value);
+        void SetMat4(const std::string& name, const glm::mat4& value);
+        void SetTexture(const std::string& samplerName, const std::string& path);
+
+        const MaterialTemplate& GetTemplate() const { return *materialTemplate; }
+
+        // Small and stable, for sort keys, which keep all 16 bits. Ids wrap after 65535 materials;
+        // materials sharing an id only sort next to each other, since the executor compares the
+        // material itself before binding.
+        uint16_t GetID() const { return id; }
+
+        // GL thread: uploads the parameter block if it changed, then binds it and the textures the
+        // template declares. The program must have been set up with MaterialTemplate::SetupProgram.
+        void Bind() const;
+
+        // What the next Bind() does: the parameter bytes it uploads (0 while the uniform buffer is
+        // current) and the textures it binds.
+        uint32_t GetParameterUploadSize() const;
+        uint32_t GetTextureBindCount() const;
+
+        // Tells TextureStreamer how many texels across this material's textures are needed.
+        // Safe from the recording jobs.
+        void RequestTextures(float screenTexels) const;
+
+        // The variant for the enabled keywords. Until it has compiled, the keyword-free variant (or
+        // the registry placeholder) stands in. The variant is resolved when the shader or keywords
+        // change, so a draw does no lookups unless ShaderRegistry changed since.
         Shader& GetShader();
+        // Names the program GetShader() asks for, by variant set and keyword variant, without needing
+        // it compiled; sort keys and batching use it so headless recordings group draws as GL would.
+        // 0 while the shader isn't registered.
+        uint32_t GetProgramKey() const;
+        // Registers the pair with ShaderRegistry under "vertex | fragment" unless it already is, so
+        // every material using the same files shares one program.
         void SetShaderPaths(const std::string& vertex, const std::string& fragment);
+
+        // Switches to the shader's template; parameters and textures both templates declare are kept.
         void SetShaderName(const std::string& name);
 
+        // Keywords select a shader variant; ones the shader doesn't declare are ignored.
+        void EnableKeyword(const std::string& keyword);
+        void DisableKeyword(const std::string& keyword);
+        bool IsKeywordEnabled(const std::string& keyword) const;
+        ShaderKeywordMask GetKeywords() const;
+
     private:
         std::string name;
         std::string shaderName;
+        ShaderKeywordMask keywords = 0;
 
         glm::vec3 albedoColor = glm::vec3(1.0f);
         float metallic = 0.0f;
         float roughness = 1.0f;
 
-        std::string vertPath, fragPath;
+        std::string albedoTexture, metallicTexture, roughnessTexture;
 
-        Shader* shader = new Shader(vertPath, fragPath);
+        std::shared_ptr<MaterialTemplate> materialTemplate;
+        std::vector<uint8_t> parameters;
 
-        std::string albedoTexture, metallicTexture, roughnessTexture;
+        // By sampler name. Shared through ResourceCache, so materials using the same file share one texture.
+        std::vector<std::pair<std::string, std::shared_ptr<Texture>>> textures;
+
+        // The parameter block's uniform buffer. Copies of a material create their own.
+        struct ParameterBuffer
+        {
+            unsigned int ID = 0;
+            uint32_t Size = 0;
+            bool Dirty = true;
+
+            ParameterBuffer() = default;
+            ParameterBuffer(const ParameterBuffer&) {}
+            ParameterBuffer& operator=(const ParameterBuffer&) { Dirty = true; return *this; }
+            ~ParameterBuffer();
+        };
+        mutable ParameterBuffer buffer;
+
+        // The shader's variant set and the index for keywords, as of a ShaderRegistry generation.
+        // Recording jobs may refresh it concurrently; they all store the same values.
+        struct VariantCache
+        {
+            std::atomic<ShaderVariantSet*> Variants{ nullptr };
+            std::atomic<uint32_t> Index{ 0 };
+            std::atomic<uint32_t> Generation{ 0 };		// 0: not resolved
+
+            VariantCache() = default;
+            VariantCache(const VariantCache&) {}
+            VariantCache& operator=(const VariantCache&) { Generation = 0; return *this; }
+        };
+        mutable VariantCache variantCache;
+
+        uint16_t id;
+
+        void SetParam(const std::string& name, MaterialParamType type, const void* value);
+        void ApplyTemplate(std::shared_ptr<MaterialTemplate> newTemplate);
+        void ResolveVariant() const;
 	};
 }
 
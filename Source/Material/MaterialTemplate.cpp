@@ -0,0 +1,131 @@
+#include "MaterialTemplate.h"
+#include "../Core/Logger.h"
+#include <GL/glew.h>
+#include <algorithm>
+
+namespace Orca
+{
+    std::unordered_map<std::string, std::shared_ptr<MaterialTemplate>> MaterialTemplate::s_Templates;
+    uint16_t MaterialTemplate::s_NextID = 1;
+
+    namespace
+    {
+        // std140 base alignment and size; a vec3 is aligned like a vec4 but only 12 bytes long.
+        void GetLayout(MaterialParamType type, uint32_t& alignment, uint32_t& size)
+        {
+            switch (type)
+            {
+            case MaterialParamType::Vec2: alignment = 8; size = 8; break;
+            case MaterialParamType::Vec3: alignment = 16; size = 12; break;
+            case MaterialParamType::Vec4: alignment = 16; size = 16; break;
+            case MaterialParamType::Mat4: alignment = 16; size = 64; break;
+            default: alignment = 4; size = 4; break;
+            }
+        }
+    }
+
+    MaterialTemplate::MaterialTemplate(const std::string& shaderName)
+        : m_ShaderName(shaderName), m_ID(s_NextID++)
+    {
+    }
+
+    MaterialTemplate& MaterialTemplate::AddParam(const std::string& name, MaterialParamType type)
+    {
+        if (FindParam(name))
+        {
+            return *this;
+        }
+
+        uint32_t alignment = 0, size = 0;
+        GetLayout(type, alignment, size);
+
+        const uint32_t offset = (m_BlockEnd + alignment - 1) / alignment * alignment;
+        m_Params.push_back({ name, type, offset, size });
+        m_BlockEnd = offset + size;
+        return *this;
+    }
+
+    MaterialTemplate& MaterialTemplate::AddTexture(const std::string& samplerName)
+    {
+        if (m_Textures.size() >= k_MaxTextures)
+        {
+            Logger::Log(LogLevel::Error, "Too many textures in material template " + m_ShaderName + ", ignoring: " + samplerName);
+            return *this;
+        }
+
+        if (FindTexture(samplerName) < 0)
+        {
+            m_Textures.push_back(samplerName);
+        }
+        return *this;
+    }
+
+    const MaterialParam* MaterialTemplate::FindParam(const std::string& name) const
+    {
+        auto it = std::find_if(m_Params.begin(), m_Params.end(), [&](const MaterialParam& param) { return param.Name == name; });
+        return it != m_Params.end() ? &*it : nullptr;
+    }
+
+    int MaterialTemplate::FindTexture(const std::string& samplerName) const
+    {
+        auto it = std::find(m_Textures.begin(), m_Textures.end(), samplerName);
+        return it != m_Textures.end() ? static_cast<int>(it - m_Textures.begin()) : -1;
+    }
+
+    uint32_t MaterialTemplate::GetBlockSize() const
+    {
+        return std::max(16u, (m_BlockEnd + 15) / 16 * 16);
+    }
+
+    void MaterialTemplate::SetupProgram(unsigned int program) const
+    {
+        const GLuint blockIndex = glGetUniformBlockIndex(program, k_BlockName);
+        if (blockIndex != GL_INVALID_INDEX)
+        {
+            glUniformBlockBinding(program, blockIndex, k_BlockBinding);
+        }
+
+        // Sampler uniforms belong to the program, which is bound by now.
+        for (size_t unit = 0; unit < m_Textures.size(); ++unit)
+        {
+            const GLint location = glGetUniformLocation(program, m_Textures[unit].c_str());
+            if (location != -1)
+            {
+                glUniform1i(location, static_cast<GLint>(unit));
+            }
+        }
+    }
+
+    std::shared_ptr<MaterialTemplate> MaterialTemplate::Get(const std::string& shaderName)
+    {
+        auto it = s_Templates.find(shaderName);
+        if (it != s_Templates.end())
+        {
+            return it->second;
+        }
+
+        std::shared_ptr<MaterialTemplate> standard = CreateStandard(shaderName);
+        s_Templates[shaderName] = standard;
+        return standard;
+    }
+
+    void MaterialTemplate::Register(std::shared_ptr<MaterialTemplate> materialTemplate)
+    {
+        if (materialTemplate)
+        {
+            s_Templates[materialTemplate->GetShaderName()] = std::move(materialTemplate);
+        }
+    }
+
+    std::shared_ptr<MaterialTemplate> MaterialTemplate::CreateStandard(const std::string& shaderName)
+    {
+        auto standard = std::make_shared<MaterialTemplate>(shaderName);
+        standard->AddParam("u_Metallic", MaterialParamType::Float)
+            .AddParam("u_Roughness", MaterialParamType::Float)
+            .AddParam("u_HasAlbedoMap", MaterialParamType::Int)
+            .AddTexture("u_AlbedoMap")
+            .AddTexture("u_MetallicMap")
+            .AddTexture("u_RoughnessMap");
+        return standard;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#ifndef MATERIAL_TEMPLATE_H
+#define MATERIAL_TEMPLATE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+    enum class MaterialParamType : uint8_t
+    {
+        Float,
+        Int,
+        Vec2,
+        Vec3,
+        Vec4,
+        Mat4
+    };
+
+    struct MaterialParam
+    {
+        std::string Name;
+        MaterialParamType Type;
+        uint32_t Offset;        // std140
+        uint32_t Size;
+    };
+
+    // What every instance of a shader shares: the program, by ShaderRegistry name, and the layout of
+    // its MaterialParams uniform block and texture samplers. Instances only carry values.
+    //
+    // Shaders declare the block as
+    //     layout(std140) uniform MaterialParams { ... };
+    // with members in the order the parameters were added.
+    class ORCA_API MaterialTemplate
+    {
+    public:
+        static constexpr const char* k_BlockName = "MaterialParams";
+        static constexpr uint32_t k_BlockBinding = 1;
+        static constexpr uint32_t k_MaxTextures = 8;     // Units 0..7; lighting and shadows use 10..15
+
+        explicit MaterialTemplate(const std::string& shaderName);
+
+        MaterialTemplate& AddParam(const std::string& name, MaterialParamType type);
+        MaterialTemplate& AddTexture(const std::string& samplerName);
+
+        const std::string& GetShaderName() const { return m_ShaderName; }
+        uint16_t GetID() const { return m_ID; }
+
+        const std::vector<MaterialParam>& GetParams() const { return m_Params; }
+        const MaterialParam* FindParam(const std::string& name) const;
+
+        const std::vector<std::string>& GetTextures() const { return m_Textures; }
+        int FindTexture(const std::string& samplerName) const;
+
+        // Multiple of 16, at least 16 so an empty block is still a valid buffer.
+        uint32_t GetBlockSize() const;
+
+        // GL thread, once per linked program: points its MaterialParams block at k_BlockBinding and
+        // each sampler at its texture unit.
+        void SetupProgram(unsigned int program) const;
+
+        // The template registered for the shader, or the standard layout if none was.
+        static std::shared_ptr<MaterialTemplate> Get(const std::string& shaderName);
+        static void Register(std::shared_ptr<MaterialTemplate> materialTemplate);
+
+        // u_Metallic, u_Roughness and u_HasAlbedoMap; u_AlbedoMap, u_MetallicMap and u_RoughnessMap.
+        static std::shared_ptr<MaterialTemplate> CreateStandard(const std::string& shaderName);
+
+    private:
+        std::string m_ShaderName;
+        uint16_t m_ID;
+        std::vector<MaterialParam> m_Params;
+        std::vector<std::string> m_Textures;
+        uint32_t m_BlockEnd = 0;
+
+        static std::unordered_map<std::string, std::shared_ptr<MaterialTemplate>> s_Templates;
+        static uint16_t s_NextID;
+    };
+#pragma warning(pop)
+}
+
+#endif
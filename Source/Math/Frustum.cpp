@@ -0,0 +1,75 @@
+#include "Frustum.h"
+#include <cmath>
+
+namespace Orca
+{
+	Frustum::Frustum(const glm::mat4& viewProjection)
+	{
+		Extract(viewProjection);
+	}
+
+	void Frustum::Extract(const glm::mat4& m)
+	{
+		// Gribb/Hartmann plane extraction on the row vectors of a column-major matrix.
+		glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+		glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+		glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+		glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+		m_Planes[0] = row3 + row0; // Left
+		m_Planes[1] = row3 - row0; // Right
+		m_Planes[2] = row3 + row1; // Bottom
+		m_Planes[3] = row3 - row1; // Top
+		m_Planes[4] = row3 + row2; // Near
+		m_Planes[5] = row3 - row2; // Far
+
+		for (auto& plane : m_Planes)
+		{
+			float length = glm::length(glm::vec3(plane));
+			if (length > 0.0f)
+			{
+				plane /= length;
+			}
+		}
+	}
+
+	void Frustum::TransformBounds(const Bounds& localBounds, const glm::mat4& model, glm::vec3& outMin, glm::vec3& outMax)
+	{
+		// Arvo's method: transform center and absolute extents instead of eight corners.
+		glm::vec3 center = localBounds.GetCenter();
+		glm::vec3 extents = localBounds.GetSize() * 0.5f;
+
+		glm::vec3 worldCenter = glm::vec3(model * glm::vec4(center, 1.0f));
+		glm::mat3 absBasis(glm::abs(glm::vec3(model[0])), glm::abs(glm::vec3(model[1])), glm::abs(glm::vec3(model[2])));
+		glm::vec3 worldExtents = absBasis * extents;
+
+		outMin = worldCenter - worldExtents;
+		outMax = worldCenter + worldExtents;
+	}
+
+	bool Frustum::Intersects(const Bounds& localBounds, const glm::mat4& model) const
+	{
+		glm::vec3 worldMin, worldMax;
+		TransformBounds(localBounds, model, worldMin, worldMax);
+		return Intersects(worldMin, worldMax);
+	}
+
+	bool Frustum::Intersects(const glm::vec3& worldMin, const glm::vec3& worldMax) const
+	{
+		for (const auto& plane : m_Planes)
+		{
+			// Positive vertex: the corner furthest along the plane normal.
+			glm::vec3 positive(
+				plane.x >= 0.0f ? worldMax.x : worldMin.x,
+				plane.y >= 0.0f ? worldMax.y : worldMin.y,
+				plane.z >= 0.0f ? worldMax.z : worldMin.z);
+
+			if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <array>
+#include <glm/glm.hpp>
+#include "Bounds.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	class ORCA_API Frustum
+	{
+	public:
+		Frustum() = default;
+		explicit Frustum(const glm::mat4& viewProjection);
+
+		void Extract(const glm::mat4& viewProjection);
+
+		// Tests a local-space box transformed by model against the six planes.
+		bool Intersects(const Bounds& localBounds, const glm::mat4& model) const;
+		bool Intersects(const glm::vec3& worldMin, const glm::vec3& worldMax) const;
+
+		static void TransformBounds(const Bounds& localBounds, const glm::mat4& model, glm::vec3& outMin, glm::vec3& outMax);
+
+	private:
+		// xyz = normal, w = distance; points with dot(n, p) + w < 0 are outside.
+		std::array<glm::vec4, 6> m_Planes{};
+	};
+#pragma warning(pop)
+}
+
+#endif
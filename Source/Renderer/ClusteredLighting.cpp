@@ -0,0 +1,293 @@
+#include "ClusteredLighting.h"
+#include "Shader.h"
+#include "../Core/JobSystem.h"
+#include <GL/glew.h>
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace Orca
+{
+	namespace
+	{
+		// Fixed units so the cluster buffers never collide with material textures.
+		constexpr int k_LightDataUnit = 13;
+		constexpr int k_ClusterGridUnit = 14;
+		constexpr int k_LightIndexUnit = 15;
+
+		void UploadTextureBuffer(unsigned int& buffer, unsigned int& texture, GLenum format, const void* data, size_t bytes, size_t minimumBytes)
+		{
+			if (buffer == 0)
+			{
+				glGenBuffers(1, &buffer);
+				glGenTextures(1, &texture);
+
+				glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+				glBufferData(GL_TEXTURE_BUFFER, minimumBytes, nullptr, GL_STREAM_DRAW);
+
+				glBindTexture(GL_TEXTURE_BUFFER, texture);
+				glTexBuffer(GL_TEXTURE_BUFFER, format, buffer);
+				glBindTexture(GL_TEXTURE_BUFFER, 0);
+			}
+
+			// Orphan every frame; a texture buffer stays attached to the buffer object across reallocation.
+			glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+			glBufferData(GL_TEXTURE_BUFFER, std::max(bytes, minimumBytes), nullptr, GL_STREAM_DRAW);
+			if (bytes > 0)
+			{
+				glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, data);
+			}
+			glBindBuffer(GL_TEXTURE_BUFFER, 0);
+		}
+	}
+
+	void ClusteredLighting::Build(const std::vector<ClusterLight>& lights, const std::vector<DirectionalLight>& directionalLights,
+		const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane)
+	{
+		m_Stats = {};
+		m_Stats.LightCount = static_cast<uint32_t>(lights.size());
+
+		m_DirectionalLights.assign(directionalLights.begin(),
+			directionalLights.begin() + std::min<size_t>(directionalLights.size(), k_MaxDirectionalLights));
+
+		if (projection != m_CachedProjection || nearPlane != m_Near || farPlane != m_Far || m_ClusterBounds.empty())
+		{
+			m_Near = nearPlane;
+			m_Far = farPlane;
+			m_CachedProjection = projection;
+			BuildClusterBounds(projection);
+		}
+
+		m_LightData.resize(lights.size() * 4);
+		std::vector<glm::vec4> viewSpheres(lights.size());
+
+		for (size_t i = 0; i < lights.size(); ++i)
+		{
+			const ClusterLight& light = lights[i];
+			float cosHalfAngle = std::cos(glm::radians(light.SpotAngle * 0.5f));
+
+			m_LightData[i * 4 + 0] = glm::vec4(light.Position, light.Range);
+			m_LightData[i * 4 + 1] = glm::vec4(light.Color, static_cast<float>(light.Type));
+			m_LightData[i * 4 + 2] = glm::vec4(glm::normalize(light.Direction), cosHalfAngle);
+			m_LightData[i * 4 + 3] = glm::vec4(static_cast<float>(light.ShadowIndex), 0.0f, 0.0f, 0.0f);
+
+			// Spot lights are binned by their bounding sphere; the cone is applied per fragment.
+			viewSpheres[i] = glm::vec4(glm::vec3(view * glm::vec4(light.Position, 1.0f)), light.Range);
+		}
+
+		m_Slices.resize(k_ClustersZ);
+
+		auto binSlice = [&](unsigned int slice)
+			{
+				SliceOutput& output = m_Slices[slice];
+				output.Offsets.assign(k_ClustersX * k_ClustersY, 0);
+				output.Counts.assign(k_ClustersX * k_ClustersY, 0);
+				output.Indices.clear();
+
+				const ClusterBounds& first = m_ClusterBounds[slice * k_ClustersX * k_ClustersY];
+				const float sliceMinZ = first.Min.z;
+				const float sliceMaxZ = first.Max.z;
+
+				// Lights overlapping this slice in depth, gathered as padded SoA for the SIMD test.
+				std::vector<float> xs, ys, zs, radii;
+				std::vector<uint32_t> ids;
+				for (size_t i = 0; i < viewSpheres.size(); ++i)
+				{
+					const glm::vec4& sphere = viewSpheres[i];
+					if (sphere.z - sphere.w > sliceMaxZ || sphere.z + sphere.w < sliceMinZ)
+					{
+						continue;
+					}
+
+					xs.push_back(sphere.x);
+					ys.push_back(sphere.y);
+					zs.push_back(sphere.z);
+					radii.push_back(sphere.w);
+					ids.push_back(static_cast<uint32_t>(i));
+				}
+
+				if (ids.empty())
+				{
+					return;
+				}
+
+				while (xs.size() % 4 != 0)
+				{
+					// Padding lanes can never pass the overlap test.
+					xs.push_back(1e30f);
+					ys.push_back(1e30f);
+					zs.push_back(1e30f);
+					radii.push_back(0.0f);
+				}
+
+				const __m128 zero = _mm_setzero_ps();
+
+				for (uint32_t tile = 0; tile < k_ClustersX * k_ClustersY; ++tile)
+				{
+					const ClusterBounds& bounds = m_ClusterBounds[slice * k_ClustersX * k_ClustersY + tile];
+					const __m128 minX = _mm_set1_ps(bounds.Min.x), maxX = _mm_set1_ps(bounds.Max.x);
+					const __m128 minY = _mm_set1_ps(bounds.Min.y), maxY = _mm_set1_ps(bounds.Max.y);
+					const __m128 minZ = _mm_set1_ps(bounds.Min.z), maxZ = _mm_set1_ps(bounds.Max.z);
+
+					output.Offsets[tile] = static_cast<uint32_t>(output.Indices.size());
+
+					for (size_t i = 0; i < xs.size(); i += 4)
+					{
+						const __m128 x = _mm_loadu_ps(&xs[i]);
+						const __m128 y = _mm_loadu_ps(&ys[i]);
+						const __m128 z = _mm_loadu_ps(&zs[i]);
+						const __m128 r = _mm_loadu_ps(&radii[i]);
+
+						// Squared distance from each sphere center to the box.
+						const __m128 dx = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minX, x), _mm_sub_ps(x, maxX)));
+						const __m128 dy = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minY, y), _mm_sub_ps(y, maxY)));
+						const __m128 dz = _mm_max_ps(zero, _mm_max_ps(_mm_sub_ps(minZ, z), _mm_sub_ps(z, maxZ)));
+						const __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+						int mask = _mm_movemask_ps(_mm_cmple_ps(distance2, _mm_mul_ps(r, r)));
+						while (mask != 0)
+						{
+							int lane = 0;
+							while ((mask & (1 << lane)) == 0)
+							{
+								lane++;
+							}
+							mask &= ~(1 << lane);
+							output.Indices.push_back(ids[i + lane]);
+						}
+					}
+
+					output.Counts[tile] = static_cast<uint32_t>(output.Indices.size()) - output.Offsets[tile];
+				}
+			};
+
+		if (JobSystem::IsInitialized())
+		{
+			JobSystem::Dispatch(k_ClustersZ, binSlice);
+		}
+		else
+		{
+			for (uint32_t slice = 0; slice < k_ClustersZ; ++slice)
+			{
+				binSlice(slice);
+			}
+		}
+
+		// Stitch the per-slice lists into one index buffer.
+		m_ClusterGrid.resize(k_ClusterCount * 2);
+		m_LightIndices.clear();
+
+		for (uint32_t slice = 0; slice < k_ClustersZ; ++slice)
+		{
+			const SliceOutput& output = m_Slices[slice];
+			const uint32_t base = static_cast<uint32_t>(m_LightIndices.size());
+			m_LightIndices.insert(m_LightIndices.end(), output.Indices.begin(), output.Indices.end());
+
+			for (uint32_t tile = 0; tile < k_ClustersX * k_ClustersY; ++tile)
+			{
+				const uint32_t cluster = slice * k_ClustersX * k_ClustersY + tile;
+				const uint32_t count = output.Counts[tile];
+				m_ClusterGrid[cluster * 2 + 0] = base + output.Offsets[tile];
+				m_ClusterGrid[cluster * 2 + 1] = count;
+				m_Stats.MaxLightsPerCluster = std::max(m_Stats.MaxLightsPerCluster, count);
+			}
+		}
+
+		m_Stats.LightIndexCount = static_cast<uint32_t>(m_LightIndices.size());
+	}
+
+	void ClusteredLighting::BuildClusterBounds(const glm::mat4& projection)
+	{
+		m_ClusterBounds.resize(k_ClusterCount);
+
+		// Symmetric perspective: view-space x = ndc.x * depth / P[0][0], likewise for y.
+		const float invScaleX = projection[0][0] != 0.0f ? 1.0f / projection[0][0] : 1.0f;
+		const float invScaleY = projection[1][1] != 0.0f ? 1.0f / projection[1][1] : 1.0f;
+		const float depthRatio = m_Far / m_Near;
+
+		for (uint32_t z = 0; z < k_ClustersZ; ++z)
+		{
+			// Exponential slices keep clusters roughly cubic in view space.
+			const float d0 = m_Near * std::pow(depthRatio, static_cast<float>(z) / k_ClustersZ);
+			const float d1 = m_Near * std::pow(depthRatio, static_cast<float>(z + 1) / k_ClustersZ);
+
+			for (uint32_t y = 0; y < k_ClustersY; ++y)
+			{
+				const float ny0 = -1.0f + 2.0f * y / k_ClustersY;
+				const float ny1 = -1.0f + 2.0f * (y + 1) / k_ClustersY;
+
+				for (uint32_t x = 0; x < k_ClustersX; ++x)
+				{
+					const float nx0 = -1.0f + 2.0f * x / k_ClustersX;
+					const float nx1 = -1.0f + 2.0f * (x + 1) / k_ClustersX;
+
+					ClusterBounds& bounds = m_ClusterBounds[(z * k_ClustersY + y) * k_ClustersX + x];
+					bounds.Min.x = std::min({ nx0 * d0, nx0 * d1, nx1 * d0, nx1 * d1 }) * invScaleX;
+					bounds.Max.x = std::max({ nx0 * d0, nx0 * d1, nx1 * d0, nx1 * d1 }) * invScaleX;
+					bounds.Min.y = std::min({ ny0 * d0, ny0 * d1, ny1 * d0, ny1 * d1 }) * invScaleY;
+					bounds.Max.y = std::max({ ny0 * d0, ny0 * d1, ny1 * d0, ny1 * d1 }) * invScaleY;
+					bounds.Min.z = -d1;
+					bounds.Max.z = -d0;
+				}
+			}
+		}
+	}
+
+	void ClusteredLighting::Upload()
+	{
+		UploadTextureBuffer(m_LightBuffer, m_LightTexture, GL_RGBA32F,
+			m_LightData.data(), m_LightData.size() * sizeof(glm::vec4), sizeof(glm::vec4) * 4);
+		UploadTextureBuffer(m_GridBuffer, m_GridTexture, GL_RG32UI,
+			m_ClusterGrid.data(), m_ClusterGrid.size() * sizeof(uint32_t), sizeof(uint32_t) * 2);
+		UploadTextureBuffer(m_IndexBuffer, m_IndexTexture, GL_R32UI,
+			m_LightIndices.data(), m_LightIndices.size() * sizeof(uint32_t), sizeof(uint32_t));
+	}
+
+	uint64_t ClusteredLighting::GetUploadSize() const
+	{
+		return m_LightData.size() * sizeof(glm::vec4) + m_ClusterGrid.size() * sizeof(uint32_t) + m_LightIndices.size() * sizeof(uint32_t);
+	}
+
+	void ClusteredLighting::Apply(const Shader& shader, float viewportWidth, float viewportHeight) const
+	{
+		glActiveTexture(GL_TEXTURE0 + k_LightDataUnit);
+		glBindTexture(GL_TEXTURE_BUFFER, m_LightTexture);
+		glActiveTexture(GL_TEXTURE0 + k_ClusterGridUnit);
+		glBindTexture(GL_TEXTURE_BUFFER, m_GridTexture);
+		glActiveTexture(GL_TEXTURE0 + k_LightIndexUnit);
+		glBindTexture(GL_TEXTURE_BUFFER, m_IndexTexture);
+		glActiveTexture(GL_TEXTURE0);
+
+		shader.SetInt("u_LightData", k_LightDataUnit);
+		shader.SetInt("u_ClusterGrid", k_ClusterGridUnit);
+		shader.SetInt("u_LightIndices", k_LightIndexUnit);
+
+		// slice = log(depth) * scale + bias, matching the exponential split in BuildClusterBounds.
+		const float logRatio = std::log(m_Far / m_Near);
+		shader.SetVec2("u_ClusterTileSize", glm::vec2(viewportWidth / k_ClustersX, viewportHeight / k_ClustersY));
+		shader.SetFloat("u_ClusterDepthScale", k_ClustersZ / logRatio);
+		shader.SetFloat("u_ClusterDepthBias", -static_cast<float>(k_ClustersZ) * std::log(m_Near) / logRatio);
+		shader.SetFloat("u_ClusterNear", m_Near);
+		shader.SetFloat("u_ClusterFar", m_Far);
+
+		shader.SetInt("u_DirectionalLightCount", static_cast<int>(m_DirectionalLights.size()));
+		for (size_t i = 0; i < m_DirectionalLights.size(); ++i)
+		{
+			const std::string index = "[" + std::to_string(i) + "]";
+			shader.SetVec3("u_DirectionalLightDirections" + index, glm::normalize(m_DirectionalLights[i].Direction));
+			shader.SetVec3("u_DirectionalLightColors" + index, m_DirectionalLights[i].Color);
+		}
+	}
+
+	void ClusteredLighting::Release()
+	{
+		unsigned int buffers[] = { m_LightBuffer, m_GridBuffer, m_IndexBuffer };
+		unsigned int textures[] = { m_LightTexture, m_GridTexture, m_IndexTexture };
+		glDeleteBuffers(3, buffers);
+		glDeleteTextures(3, textures);
+
+		m_LightBuffer = m_GridBuffer = m_IndexBuffer = 0;
+		m_LightTexture = m_GridTexture = m_IndexTexture = 0;
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#ifndef CLUSTERED_LIGHTING_H
+#define CLUSTERED_LIGHTING_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	class Shader;
+
+	enum class ClusterLightType : uint32_t
+	{
+		Point = 0,
+		Spot = 1
+	};
+
+	// World-space description of a point or spot light, already scaled by intensity.
+	struct ClusterLight
+	{
+		glm::vec3 Position = glm::vec3(0.0f);
+		float Range = 10.0f;
+		glm::vec3 Color = glm::vec3(1.0f);
+		ClusterLightType Type = ClusterLightType::Point;
+		glm::vec3 Direction = glm::vec3(0.0f, 0.0f, -1.0f);
+		float SpotAngle = 45.0f;	// Full cone angle in degrees
+		int ShadowIndex = -1;		// First matrix in the shadow matrix buffer, -1 for unshadowed
+	};
+
+	struct DirectionalLight
+	{
+		glm::vec3 Direction = glm::vec3(0.0f, -1.0f, 0.0f);	// Direction the light travels
+		glm::vec3 Color = glm::vec3(1.0f);
+	};
+
+	struct ClusterStats
+	{
+		uint32_t LightCount = 0;
+		uint32_t LightIndexCount = 0;
+		uint32_t MaxLightsPerCluster = 0;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Clustered forward lighting. The view frustum is split into a froxel grid (screen tiles by
+	// exponential depth slices). Build() bins lights into it on the CPU, one depth slice per job,
+	// testing four lights at a time against each cluster's view-space box with SSE. Upload() copies
+	// the grid, index lists and light data into texture buffers that DefaultLit reads per fragment.
+	class ORCA_API ClusteredLighting
+	{
+	public:
+		// Must match the constants in DefaultLit.frag.
+		static constexpr uint32_t k_ClustersX = 16;
+		static constexpr uint32_t k_ClustersY = 9;
+		static constexpr uint32_t k_ClustersZ = 24;
+		static constexpr uint32_t k_ClusterCount = k_ClustersX * k_ClustersY * k_ClustersZ;
+		static constexpr uint32_t k_MaxDirectionalLights = 4;
+
+		void Build(const std::vector<ClusterLight>& lights, const std::vector<DirectionalLight>& directionalLights,
+			const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane);
+
+		// GL thread only.
+		void Upload();
+		// What Upload() copies for the last Build(): light data, cluster grid and index lists.
+		uint64_t GetUploadSize() const;
+		void Apply(const Shader& shader, float viewportWidth, float viewportHeight) const;
+		void Release();
+
+		const ClusterStats& GetStats() const { return m_Stats; }
+
+	private:
+		struct ClusterBounds
+		{
+			glm::vec3 Min;
+			glm::vec3 Max;
+		};
+
+		// Per-job output, concatenated after the parallel pass.
+		struct SliceOutput
+		{
+			std::vector<uint32_t> Offsets;	// Relative to Indices, k_ClustersX * k_ClustersY entries
+			std::vector<uint32_t> Counts;
+			std::vector<uint32_t> Indices;
+		};
+
+		std::vector<ClusterBounds> m_ClusterBounds;
+		glm::mat4 m_CachedProjection = glm::mat4(0.0f);
+		float m_Near = 0.1f;
+		float m_Far = 1000.0f;
+
+		std::vector<glm::vec4> m_LightData;		// Four texels per light
+		std::vector<uint32_t> m_ClusterGrid;	// (offset, count) per cluster
+		std::vector<uint32_t> m_LightIndices;
+		std::vector<DirectionalLight> m_DirectionalLights;
+		std::vector<SliceOutput> m_Slices;
+
+		ClusterStats m_Stats;
+
+		unsigned int m_LightBuffer = 0;
+		unsigned int m_GridBuffer = 0;
+		unsigned int m_IndexBuffer = 0;
+		unsigned int m_LightTexture = 0;
+		unsigned int m_GridTexture = 0;
+		unsigned int m_IndexTexture = 0;
+
+		void BuildClusterBounds(const glm::mat4& projection);
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "CommandExecutor.h"
+#include "Mesh.h"
+
+namespace Orca
+{
+	namespace
+	{
+		// Packets can share a multi-draw when they agree on program, material and arena pool. The
+		// arena keeps one pool, and so one VAO, per vertex layout; comparing layouts rather than VAOs
+		// batches headless recordings, whose meshes have no arena allocation, the same way.
+		bool CanShareMultiDraw(const RenderPacket& a, const RenderPacket& b)
+		{
+			return a.Program == b.Program && a.ProgramKey == b.ProgramKey && a.MaterialInstance == b.MaterialInstance &&
+				a.Geometry->GetLayout() == b.Geometry->GetLayout();
+		}
+	}
+
+	void CommandExecutor::Release()
+	{
+		m_Batches.clear();
+		m_Commands.clear();
+		m_Instances.clear();
+	}
+
+	void CommandExecutor::BuildBatches(const CommandList& list, bool multiDraw)
+	{
+		m_Batches.clear();
+		m_Commands.clear();
+		m_Instances.clear();
+
+		const auto& packets = list.GetPackets();
+		size_t i = 0;
+
+		while (i < packets.size())
+		{
+			size_t end = i + 1;
+			while (end < packets.size() && CanShareMultiDraw(packets[i], packets[end]))
+			{
+				end++;
+			}
+
+			Batch batch{ i, end - i, static_cast<uint32_t>(m_Commands.size()), multiDraw && end - i > 1 };
+
+			if (batch.MultiDraw)
+			{
+				for (size_t p = i; p < end; ++p)
+				{
+					const RenderPacket& packet = packets[p];
+					const GeometryRange& range = packet.Geometry->GetGeometryRange();
+					const DrawConstants& constants = list.GetConstants(packet.ConstantsIndex);
+					const VertexDequantization& dequantization = packet.Geometry->GetDequantization();
+
+					DrawElementsIndirectCommand command;
+					command.Count = packet.Geometry->GetIndexCount();
+					command.InstanceCount = 1;
+					command.FirstIndex = range.FirstIndex;
+					command.BaseVertex = static_cast<int32_t>(range.BaseVertex);
+					command.BaseInstance = static_cast<uint32_t>(m_Instances.size());
+					m_Commands.push_back(command);
+
+					InstanceData instance;
+					instance.Model = constants.Model;
+					instance.AlbedoColor = constants.AlbedoColor;
+					instance.PositionScale = glm::vec4(dequantization.Scale, 0.0f);
+					instance.PositionOffset = glm::vec4(dequantization.Offset, 0.0f);
+					m_Instances.push_back(instance);
+				}
+			}
+
+			m_Batches.push_back(batch);
+			i = end;
+		}
+	}
+
+	uint64_t CommandExecutor::GetBatchUploadSize() const
+	{
+		return m_Commands.size() * sizeof(DrawElementsIndirectCommand) + m_Instances.size() * sizeof(InstanceData);
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#ifndef COMMAND_EXECUTOR_H
+#define COMMAND_EXECUTOR_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "CommandList.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	class ClusteredLighting;
+	class ShadowRenderer;
+
+	struct FrameConstants
+	{
+		glm::mat4 ViewProjection = glm::mat4(1.0f);
+		glm::vec3 CameraPosition = glm::vec3(0.0f);
+		glm::vec2 ViewportSize = glm::vec2(1.0f);
+
+		// Bound to every program the frame uses; null leaves lighting uniforms untouched.
+		const ClusteredLighting* Lighting = nullptr;
+		const ShadowRenderer* Shadows = nullptr;
+	};
+
+	struct SubmissionStats
+	{
+		uint32_t DrawCalls = 0;
+		uint32_t MultiDrawCalls = 0;
+		uint32_t ProgramBinds = 0;
+		uint32_t MaterialBinds = 0;
+		uint32_t GeometryBinds = 0;
+		uint32_t TextureBinds = 0;		// Material textures; lighting and shadow textures go with ProgramBinds
+		uint64_t UploadBytes = 0;		// Indirect commands, instance data, material parameter blocks and light lists
+
+		uint32_t GetStateChanges() const { return ProgramBinds + MaterialBinds + GeometryBinds; }
+	};
+
+	// Matches the GL_DRAW_INDIRECT_BUFFER record layout consumed by glMultiDrawElementsIndirect.
+	struct DrawElementsIndirectCommand
+	{
+		uint32_t Count;
+		uint32_t InstanceCount;
+		uint32_t FirstIndex;
+		int32_t BaseVertex;
+		uint32_t BaseInstance;
+	};
+
+	// Per-draw data fetched through instanced attributes (locations 4..10) on the multi-draw path.
+	// BaseInstance in each indirect command selects the record.
+	struct InstanceData
+	{
+		glm::mat4 Model;
+		glm::vec4 AlbedoColor;
+		glm::vec4 PositionScale;
+		glm::vec4 PositionOffset;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// The backend a merged CommandList is submitted to. Every backend batches the list the same way,
+	// so a recording of what a backend would do matches what GLCommandExecutor does.
+	class ORCA_API CommandExecutor
+	{
+	public:
+		virtual ~CommandExecutor() = default;
+
+		virtual void Execute(const CommandList& list, const FrameConstants& frame) = 0;
+		virtual void Release();
+
+		const SubmissionStats& GetStats() const { return m_Stats; }
+
+	protected:
+		struct Batch
+		{
+			size_t FirstPacket;
+			size_t PacketCount;
+			uint32_t FirstCommand;
+			bool MultiDraw;
+		};
+
+		SubmissionStats m_Stats;
+
+		std::vector<Batch> m_Batches;
+		std::vector<DrawElementsIndirectCommand> m_Commands;
+		std::vector<InstanceData> m_Instances;
+
+		// Splits the list into runs of packets sharing a program, a material and a vertex layout,
+		// and so a geometry arena pool. With multiDraw, runs longer than one packet get indirect
+		// commands and instance data.
+		void BuildBatches(const CommandList& list, bool multiDraw);
+
+		uint64_t GetBatchUploadSize() const;
+	};
+#pragma warning(pop)
+}
+
+#endif
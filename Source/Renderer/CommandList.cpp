@@ -0,0 +1,107 @@
+#include "CommandList.h"
+#include <algorithm>
+#include <queue>
+
+namespace Orca
+{
+	namespace RenderSortKey
+	{
+		uint64_t Make(uint32_t programId, uint32_t materialId, uint32_t geometryId, float normalizedDepth)
+		{
+			constexpr uint32_t depthMax = (1u << 16) - 1;
+
+			float depth = std::clamp(normalizedDepth, 0.0f, 1.0f);
+			uint64_t quantizedDepth = static_cast<uint64_t>(depth * static_cast<float>(depthMax));
+
+			return (static_cast<uint64_t>(programId & 0xFFFFu) << 48) |
+				(static_cast<uint64_t>(materialId & 0xFFFFu) << 32) |
+				(static_cast<uint64_t>(geometryId & 0xFFFFu) << 16) |
+				(quantizedDepth & depthMax);
+		}
+	}
+
+	void CommandList::Reset()
+	{
+		// clear() keeps capacity, so steady-state frames do not allocate.
+		m_Packets.clear();
+		m_Constants.clear();
+	}
+
+	void CommandList::Reserve(size_t packetCount)
+	{
+		m_Packets.reserve(packetCount);
+		m_Constants.reserve(packetCount);
+	}
+
+	void CommandList::RecordDraw(uint64_t sortKey, const Shader* program, uint32_t programKey, const Mesh* geometry, const Material* material, const DrawConstants& constants)
+	{
+		RenderPacket packet;
+		packet.SortKey = sortKey;
+		packet.Type = RenderPacketType::DrawIndexed;
+		packet.Program = program;
+		packet.ProgramKey = programKey;
+		packet.Geometry = geometry;
+		packet.MaterialInstance = material;
+		packet.ConstantsIndex = static_cast<uint32_t>(m_Constants.size());
+
+		m_Constants.push_back(constants);
+		m_Packets.push_back(packet);
+	}
+
+	void CommandList::Sort()
+	{
+		std::sort(m_Packets.begin(), m_Packets.end(),
+			[](const RenderPacket& a, const RenderPacket& b) { return a.SortKey < b.SortKey; });
+	}
+
+	void CommandList::Merge(const std::vector<CommandList>& lists, CommandList& out)
+	{
+		out.Reset();
+
+		size_t total = 0;
+		for (const auto& list : lists)
+		{
+			total += list.GetSize();
+		}
+		out.Reserve(total);
+
+		struct Cursor
+		{
+			uint64_t key;
+			size_t list;
+			size_t index;
+		};
+
+		auto greater = [](const Cursor& a, const Cursor& b)
+			{
+				// Ties are broken by list index so the merged order is deterministic.
+				return a.key != b.key ? a.key > b.key : a.list > b.list;
+			};
+
+		std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> heads(greater);
+		for (size_t i = 0; i < lists.size(); ++i)
+		{
+			if (!lists[i].IsEmpty())
+			{
+				heads.push({ lists[i].m_Packets[0].SortKey, i, 0 });
+			}
+		}
+
+		while (!heads.empty())
+		{
+			Cursor cursor = heads.top();
+			heads.pop();
+
+			const CommandList& source = lists[cursor.list];
+			const RenderPacket& packet = source.m_Packets[cursor.index];
+			out.RecordDraw(packet.SortKey, packet.Program, packet.ProgramKey, packet.Geometry, packet.MaterialInstance, source.m_Constants[packet.ConstantsIndex]);
+			out.m_Packets.back().Type = packet.Type;
+
+			size_t next = cursor.index + 1;
+			if (next < source.m_Packets.size())
+			{
+				heads.push({ source.m_Packets[next].SortKey, cursor.list, next });
+			}
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#ifndef COMMAND_LIST_H
+#define COMMAND_LIST_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	class Shader;
+	class Mesh;
+	class Material;
+
+	enum class RenderPacketType : uint8_t
+	{
+		DrawIndexed
+	};
+
+	// Per-draw data packed by the recording thread; uploaded verbatim by the submission thread.
+	struct DrawConstants
+	{
+		glm::mat4 Model;
+		glm::vec4 AlbedoColor;
+	};
+
+	// API-agnostic draw packet. Nothing in here touches the graphics API, so packets
+	// can be recorded on any thread and executed later by the thread that owns the context.
+	struct RenderPacket
+	{
+		uint64_t SortKey = 0;
+		RenderPacketType Type = RenderPacketType::DrawIndexed;
+		const Shader* Program = nullptr;		// Null in headless recordings, which have no programs
+		uint32_t ProgramKey = 0;				// CPU-side program identity, e.g. Material::GetProgramKey()
+		const Mesh* Geometry = nullptr;
+		const Material* MaterialInstance = nullptr;	// Parameter block and textures; null for depth-only passes
+		uint32_t ConstantsIndex = 0;
+	};
+
+	namespace RenderSortKey
+	{
+		// [63..48] program, [47..32] material, [31..16] geometry, [15..0] front-to-back depth, so
+		// a material's draws stay together and its parameter block is bound once per program. The
+		// material field holds the whole Material::GetID(); only ids that wrapped can collide.
+		ORCA_API uint64_t Make(uint32_t programId, uint32_t materialId, uint32_t geometryId, float normalizedDepth);
+	}
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	class ORCA_API CommandList
+	{
+	public:
+		CommandList() = default;
+
+		void Reset();
+		void Reserve(size_t packetCount);
+
+		void RecordDraw(uint64_t sortKey, const Shader* program, uint32_t programKey, const Mesh* geometry, const Material* material, const DrawConstants& constants);
+
+		// Sorts packets by key. Each job sorts its own list so the merge stays linear.
+		void Sort();
+
+		bool IsEmpty() const { return m_Packets.empty(); }
+		size_t GetSize() const { return m_Packets.size(); }
+
+		const std::vector<RenderPacket>& GetPackets() const { return m_Packets; }
+		const DrawConstants& GetConstants(uint32_t index) const { return m_Constants[index]; }
+
+		// K-way merge of already sorted lists into out (which is reset first).
+		static void Merge(const std::vector<CommandList>& lists, CommandList& out);
+
+	private:
+		std::vector<RenderPacket> m_Packets;
+		std::vector<DrawConstants> m_Constants;
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -0,0 +1,590 @@
+#include "DebugDraw.h"
+
+#if ORCA_DEBUG_DRAW
+
+#include "Shader.h"
+#include "ShaderRegistry.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr size_t k_MaxStringLength = 64;
+		constexpr uint32_t k_SphereSegments = 24;
+		constexpr uint32_t k_ChunkSize = 1024;
+
+		struct DebugLine
+		{
+			glm::vec3 From;
+			uint32_t Color;
+			glm::vec3 To;
+			float Duration;
+			DebugDepth Depth;
+		};
+
+		struct DebugString
+		{
+			glm::vec3 Position;
+			uint32_t Color;
+			float Height;
+			float Duration;
+			DebugDepth Depth;
+			char Text[k_MaxStringLength];
+		};
+
+		struct DebugVertex
+		{
+			glm::vec3 Position;
+			uint32_t Color;		// RGBA8
+		};
+
+		// Written by one thread, drained by the render thread, neither side locking. Items go into
+		// fixed chunks; a chunk's count is published with a release store after the item is
+		// written, so the reader never sees a half-written item. Chunks the reader has moved past
+		// are recycled by the writer.
+		template<typename T>
+		class ThreadQueue
+		{
+		public:
+			ThreadQueue() : m_Head(new Chunk()), m_Tail(m_Head), m_Read(m_Head) {}
+
+			~ThreadQueue()
+			{
+				while (m_Head)
+				{
+					Chunk* next = m_Head->Next.load(std::memory_order_relaxed);
+					delete m_Head;
+					m_Head = next;
+				}
+			}
+
+			ThreadQueue(const ThreadQueue&) = delete;
+			ThreadQueue& operator=(const ThreadQueue&) = delete;
+
+			// Owning thread only.
+			void Push(const T& item)
+			{
+				uint32_t count = m_Tail->Count.load(std::memory_order_relaxed);
+				if (count == k_ChunkSize)
+				{
+					Chunk* next = nullptr;
+					if (m_Head != m_Tail && m_Head != m_Read.load(std::memory_order_acquire))
+					{
+						next = m_Head;
+						m_Head = m_Head->Next.load(std::memory_order_relaxed);
+						next->Count.store(0, std::memory_order_relaxed);
+						next->Next.store(nullptr, std::memory_order_relaxed);
+					}
+					else
+					{
+						next = new Chunk();
+					}
+
+					m_Tail->Next.store(next, std::memory_order_release);
+					m_Tail = next;
+					count = 0;
+				}
+
+				m_Tail->Items[count] = item;
+				m_Tail->Count.store(count + 1, std::memory_order_release);
+			}
+
+			// Render thread only. Appends everything published so far.
+			void Drain(std::vector<T>& out)
+			{
+				Chunk* chunk = m_Read.load(std::memory_order_relaxed);
+				while (true)
+				{
+					const uint32_t count = chunk->Count.load(std::memory_order_acquire);
+					out.insert(out.end(), chunk->Items + m_ReadIndex, chunk->Items + count);
+					m_ReadIndex = count;
+
+					Chunk* next = count == k_ChunkSize ? chunk->Next.load(std::memory_order_acquire) : nullptr;
+					if (!next)
+					{
+						break;
+					}
+
+					chunk = next;
+					m_ReadIndex = 0;
+					m_Read.store(chunk, std::memory_order_release);
+				}
+			}
+
+		private:
+			struct Chunk
+			{
+				T Items[k_ChunkSize];
+				std::atomic<uint32_t> Count{ 0 };
+				std::atomic<Chunk*> Next{ nullptr };
+			};
+
+			Chunk* m_Head;					// Writer: oldest chunk not yet recycled
+			Chunk* m_Tail;					// Writer: chunk being filled
+			std::atomic<Chunk*> m_Read;		// Reader: chunk being drained
+			uint32_t m_ReadIndex = 0;		// Reader
+		};
+
+		struct ThreadBuffer
+		{
+			ThreadQueue<DebugLine> Lines;
+			ThreadQueue<DebugString> Strings;
+		};
+
+		// Registration is the only locked step, once per thread.
+		std::mutex s_BuffersMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> s_Buffers;
+		std::atomic<uint32_t> s_Generation{ 1 };
+
+		thread_local ThreadBuffer* t_Buffer = nullptr;
+		thread_local uint32_t t_Generation = 0;
+
+		// Render thread state.
+		std::vector<DebugLine> s_Lines;
+		std::vector<DebugString> s_Strings;
+		std::vector<DebugVertex> s_Vertices;
+		DebugDrawStats s_Stats;
+		unsigned int s_VAO = 0;
+		unsigned int s_Buffer = 0;
+		size_t s_Capacity = 0;
+
+		ThreadBuffer& GetThreadBuffer()
+		{
+			const uint32_t generation = s_Generation.load(std::memory_order_acquire);
+			if (t_Generation != generation)
+			{
+				std::lock_guard<std::mutex> lock(s_BuffersMutex);
+				s_Buffers.push_back(std::make_unique<ThreadBuffer>());
+				t_Buffer = s_Buffers.back().get();
+				t_Generation = generation;
+			}
+			return *t_Buffer;
+		}
+
+		uint32_t PackColor(const glm::vec4& color)
+		{
+			const glm::vec4 scaled = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+			return static_cast<uint32_t>(scaled.x) | (static_cast<uint32_t>(scaled.y) << 8) |
+				(static_cast<uint32_t>(scaled.z) << 16) | (static_cast<uint32_t>(scaled.w) << 24);
+		}
+
+		void PushLine(ThreadBuffer& buffer, const glm::vec3& from, const glm::vec3& to, uint32_t color, float duration, DebugDepth depth)
+		{
+			buffer.Lines.Push({ from, color, to, duration, depth });
+		}
+
+		// 16-segment glyphs on a 1 x 2 cell, origin at the bottom left.
+		enum GlyphSegment : uint16_t
+		{
+			T1 = 1 << 0,	// Top, left half
+			T2 = 1 << 1,	// Top, right half
+			RU = 1 << 2,	// Right, upper
+			RL = 1 << 3,	// Right, lower
+			B1 = 1 << 4,	// Bottom, right half
+			B2 = 1 << 5,	// Bottom, left half
+			LL = 1 << 6,	// Left, lower
+			LU = 1 << 7,	// Left, upper
+			M1 = 1 << 8,	// Middle, left half
+			M2 = 1 << 9,	// Middle, right half
+			DTL = 1 << 10,	// Diagonal to the top left corner
+			CU = 1 << 11,	// Centre, upper
+			DTR = 1 << 12,	// Diagonal to the top right corner
+			DBR = 1 << 13,	// Diagonal to the bottom right corner
+			CL = 1 << 14,	// Centre, lower
+			DBL = 1 << 15	// Diagonal to the bottom left corner
+		};
+
+		constexpr float k_SegmentLines[16][4] =
+		{
+			{ 0.0f, 2.0f, 0.5f, 2.0f }, { 0.5f, 2.0f, 1.0f, 2.0f }, { 1.0f, 2.0f, 1.0f, 1.0f }, { 1.0f, 1.0f, 1.0f, 0.0f },
+			{ 1.0f, 0.0f, 0.5f, 0.0f }, { 0.5f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f, 2.0f },
+			{ 0.0f, 1.0f, 0.5f, 1.0f }, { 0.5f, 1.0f, 1.0f, 1.0f }, { 0.0f, 2.0f, 0.5f, 1.0f }, { 0.5f, 2.0f, 0.5f, 1.0f },
+			{ 1.0f, 2.0f, 0.5f, 1.0f }, { 0.5f, 1.0f, 1.0f, 0.0f }, { 0.5f, 1.0f, 0.5f, 0.0f }, { 0.5f, 1.0f, 0.0f, 0.0f }
+		};
+
+		constexpr uint16_t k_Outline = T1 | T2 | RU | RL | B1 | B2 | LL | LU;
+
+		// ASCII 32 (space) to 95 (underscore).
+		constexpr uint16_t k_Glyphs[64] =
+		{
+			0,											// space
+			CU,											// !
+			LU | CU,									// "
+			CU | CL | RU | RL | M1 | M2 | B1 | B2,		// #
+			T1 | T2 | LU | M1 | M2 | RL | B1 | B2 | CU | CL,	// $
+			T1 | LU | M1 | CU | DTR | DBL | M2 | RL | B1 | CL,	// %
+			T1 | CU | DTL | M1 | LL | B2 | B1 | DBR,	// &
+			DTR,										// '
+			DTR | DBR,									// (
+			DTL | DBL,									// )
+			DTL | DTR | DBL | DBR | CU | CL | M1 | M2,	// *
+			CU | CL | M1 | M2,							// +
+			DBL,										// ,
+			M1 | M2,									// -
+			B2,											// .
+			DTR | DBL,									// /
+			k_Outline | DTR | DBL,						// 0
+			RU | RL,									// 1
+			T1 | T2 | RU | M1 | M2 | LL | B1 | B2,		// 2
+			T1 | T2 | RU | M2 | RL | B1 | B2,			// 3
+			LU | M1 | M2 | RU | RL,						// 4
+			T1 | T2 | LU | M1 | M2 | RL | B1 | B2,		// 5
+			T1 | T2 | LU | LL | B1 | B2 | RL | M1 | M2,	// 6
+			T1 | T2 | RU | RL,							// 7
+			k_Outline | M1 | M2,						// 8
+			T1 | T2 | LU | RU | M1 | M2 | RL | B1 | B2,	// 9
+			CU | CL,									// :
+			CU | DBL,									// ;
+			DTR | DBR,									// <
+			M1 | M2 | B1 | B2,							// =
+			DTL | DBL,									// >
+			T1 | T2 | RU | M2 | CL,						// ?
+			T1 | T2 | RU | CU | M2 | LU | LL | B1 | B2,	// @
+			T1 | T2 | LU | RU | M1 | M2 | LL | RL,		// A
+			T1 | T2 | RU | RL | B1 | B2 | CU | CL | M2,	// B
+			T1 | T2 | LU | LL | B1 | B2,				// C
+			T1 | T2 | RU | RL | B1 | B2 | CU | CL,		// D
+			T1 | T2 | LU | LL | B1 | B2 | M1,			// E
+			T1 | T2 | LU | LL | M1,						// F
+			T1 | T2 | LU | LL | B1 | B2 | RL | M2,		// G
+			LU | LL | RU | RL | M1 | M2,				// H
+			T1 | T2 | CU | CL | B1 | B2,				// I
+			RU | RL | B1 | B2 | LL,						// J
+			LU | LL | M1 | DTR | DBR,					// K
+			LU | LL | B1 | B2,							// L
+			LU | LL | RU | RL | DTL | DTR,				// M
+			LU | LL | RU | RL | DTL | DBR,				// N
+			k_Outline,									// O
+			T1 | T2 | LU | LL | RU | M1 | M2,			// P
+			k_Outline | DBR,							// Q
+			T1 | T2 | LU | LL | RU | M1 | M2 | DBR,		// R
+			T1 | T2 | LU | M1 | M2 | RL | B1 | B2,		// S
+			T1 | T2 | CU | CL,							// T
+			LU | LL | B1 | B2 | RL | RU,				// U
+			LU | LL | DBL | DTR,						// V
+			LU | LL | RU | RL | DBL | DBR,				// W
+			DTL | DTR | DBL | DBR,						// X
+			DTL | DTR | CL,								// Y
+			T1 | T2 | DTR | DBL | B1 | B2,				// Z
+			T1 | LU | LL | B2,							// [
+			DTL | DBR,									// backslash
+			T2 | RU | RL | B1,							// ]
+			DBL | DBR,									// ^
+			B1 | B2										// _
+		};
+
+		constexpr float k_GlyphAdvance = 1.5f;
+		constexpr float k_LineAdvance = 3.0f;
+
+		// Lays the string out in the plane spanned by right and up, one unit being a glyph's half height.
+		void AppendString(const DebugString& text, const glm::vec3& right, const glm::vec3& up, float unit, std::vector<DebugVertex>& out)
+		{
+			float x = 0.0f;
+			float y = 0.0f;
+
+			for (const char* c = text.Text; *c; ++c)
+			{
+				if (*c == '\n')
+				{
+					x = 0.0f;
+					y -= k_LineAdvance;
+					continue;
+				}
+
+				const int code = std::toupper(static_cast<unsigned char>(*c));
+				const uint16_t glyph = code >= 32 && code < 96 ? k_Glyphs[code - 32] : 0;
+
+				for (uint32_t segment = 0; segment < 16; ++segment)
+				{
+					if ((glyph & (1u << segment)) == 0)
+					{
+						continue;
+					}
+
+					const float* line = k_SegmentLines[segment];
+					out.push_back({ text.Position + (right * (x + line[0]) + up * (y + line[1])) * unit, text.Color });
+					out.push_back({ text.Position + (right * (x + line[2]) + up * (y + line[3])) * unit, text.Color });
+				}
+
+				x += k_GlyphAdvance;
+			}
+		}
+
+		void CreateResources()
+		{
+			glGenVertexArrays(1, &s_VAO);
+			glGenBuffers(1, &s_Buffer);
+
+			glBindVertexArray(s_VAO);
+			glBindBuffer(GL_ARRAY_BUFFER, s_Buffer);
+			glEnableVertexAttribArray(0);
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), reinterpret_cast<const void*>(offsetof(DebugVertex, Position)));
+			glEnableVertexAttribArray(1);
+			glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DebugVertex), reinterpret_cast<const void*>(offsetof(DebugVertex, Color)));
+			glBindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+	}
+
+	void DebugDraw::DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float duration, DebugDepth depth)
+	{
+		PushLine(GetThreadBuffer(), from, to, PackColor(color), duration, depth);
+	}
+
+	void DebugDraw::DrawBox(const glm::mat4& transform, const glm::vec3& size, const glm::vec4& color, float duration, DebugDepth depth)
+	{
+		const glm::vec3 half = size * 0.5f;
+		glm::vec3 corners[8];
+		for (int i = 0; i < 8; ++i)
+		{
+			const glm::vec3 local((i & 1) ? half.x : -half.x, (i & 2) ? half.y : -half.y, (i & 4) ? half.z : -half.z);
+			corners[i] = glm::vec3(transform * glm::vec4(local, 1.0f));
+		}
+
+		// Corners differing in exactly one bit share an edge.
+		ThreadBuffer& buffer = GetThreadBuffer();
+		const uint32_t packed = PackColor(color);
+		for (int i = 0; i < 8; ++i)
+		{
+			for (int bit = 1; bit < 8; bit <<= 1)
+			{
+				if ((i & bit) == 0)
+				{
+					PushLine(buffer, corners[i], corners[i | bit], packed, duration, depth);
+				}
+			}
+		}
+	}
+
+	void DebugDraw::DrawBounds(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, float duration, DebugDepth depth)
+	{
+		glm::mat4 transform(1.0f);
+		transform[3] = glm::vec4((min + max) * 0.5f, 1.0f);
+		DrawBox(transform, max - min, color, duration, depth);
+	}
+
+	void DebugDraw::DrawSphere(const glm::vec3& center, float radius, const glm::vec4& color, float duration, DebugDepth depth)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		const uint32_t packed = PackColor(color);
+		const float step = 6.28318530718f / static_cast<float>(k_SphereSegments);
+
+		glm::vec2 previous(radius, 0.0f);
+		for (uint32_t i = 1; i <= k_SphereSegments; ++i)
+		{
+			const float angle = step * static_cast<float>(i);
+			const glm::vec2 current(std::cos(angle) * radius, std::sin(angle) * radius);
+
+			PushLine(buffer, center + glm::vec3(previous.x, previous.y, 0.0f), center + glm::vec3(current.x, current.y, 0.0f), packed, duration, depth);
+			PushLine(buffer, center + glm::vec3(previous.x, 0.0f, previous.y), center + glm::vec3(current.x, 0.0f, current.y), packed, duration, depth);
+			PushLine(buffer, center + glm::vec3(0.0f, previous.x, previous.y), center + glm::vec3(0.0f, current.x, current.y), packed, duration, depth);
+
+			previous = current;
+		}
+	}
+
+	void DebugDraw::DrawAxes(const glm::mat4& transform, float length, float duration, DebugDepth depth)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+		const glm::vec3 origin(transform[3]);
+
+		PushLine(buffer, origin, origin + glm::normalize(glm::vec3(transform[0])) * length, PackColor(DebugColor::Red), duration, depth);
+		PushLine(buffer, origin, origin + glm::normalize(glm::vec3(transform[1])) * length, PackColor(DebugColor::Green), duration, depth);
+		PushLine(buffer, origin, origin + glm::normalize(glm::vec3(transform[2])) * length, PackColor(DebugColor::Blue), duration, depth);
+	}
+
+	void DebugDraw::DrawString(const glm::vec3& position, const std::string& text, const glm::vec4& color, float height, float duration, DebugDepth depth)
+	{
+		DebugString item;
+		item.Position = position;
+		item.Color = PackColor(color);
+		item.Height = height;
+		item.Duration = duration;
+		item.Depth = depth;
+
+		const size_t length = std::min(text.size(), k_MaxStringLength - 1);
+		std::memcpy(item.Text, text.data(), length);
+		item.Text[length] = '\0';
+
+		GetThreadBuffer().Strings.Push(item);
+	}
+
+	void DebugDraw::Render(const glm::mat4& view, const glm::mat4& projection, const glm::vec2& viewportSize, float deltaTime)
+	{
+		s_Stats = {};
+
+		{
+			std::lock_guard<std::mutex> lock(s_BuffersMutex);
+			for (auto& buffer : s_Buffers)
+			{
+				buffer->Lines.Drain(s_Lines);
+				buffer->Strings.Drain(s_Strings);
+			}
+		}
+
+		if (s_Lines.empty() && s_Strings.empty())
+		{
+			return;
+		}
+
+		const glm::mat4 inverseView = glm::inverse(view);
+		const glm::vec3 right(inverseView[0]);
+		const glm::vec3 up(inverseView[1]);
+		const glm::vec3 forward = -glm::vec3(inverseView[2]);
+		const glm::vec3 eye(inverseView[3]);
+		const bool perspective = projection[3][3] == 0.0f;
+		const float pixelSize = 2.0f / (projection[1][1] * std::max(viewportSize.y, 1.0f));
+
+		// Depth-tested vertices first, then overlay, so each mode is one contiguous draw.
+		s_Vertices.clear();
+		GLsizei counts[2] = {};
+		for (int mode = 0; mode < 2; ++mode)
+		{
+			const DebugDepth depth = mode == 0 ? DebugDepth::Test : DebugDepth::Overlay;
+			const size_t first = s_Vertices.size();
+
+			for (const DebugLine& line : s_Lines)
+			{
+				if (line.Depth == depth)
+				{
+					s_Vertices.push_back({ line.From, line.Color });
+					s_Vertices.push_back({ line.To, line.Color });
+				}
+			}
+
+			for (const DebugString& text : s_Strings)
+			{
+				const float distance = perspective ? glm::dot(text.Position - eye, forward) : 1.0f;
+				if (text.Depth == depth && distance > 0.0f)
+				{
+					AppendString(text, right, up, distance * pixelSize * text.Height * 0.5f, s_Vertices);
+				}
+			}
+
+			counts[mode] = static_cast<GLsizei>(s_Vertices.size() - first);
+		}
+
+		Shader* shader = ShaderRegistry::Find("DebugDraw");
+		if (shader && shader->IsValid() && !s_Vertices.empty())
+		{
+			if (s_VAO == 0)
+			{
+				CreateResources();
+			}
+
+			// Orphaned each frame, like the sprite buffer.
+			const size_t bytes = s_Vertices.size() * sizeof(DebugVertex);
+			glBindBuffer(GL_ARRAY_BUFFER, s_Buffer);
+			if (bytes > s_Capacity)
+			{
+				s_Capacity = std::max(bytes, s_Capacity * 2);
+			}
+			glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(s_Capacity), nullptr, GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), s_Vertices.data());
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			s_Stats.UploadBytes = bytes;
+
+			const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+			const GLboolean blend = glIsEnabled(GL_BLEND);
+			glEnable(GL_BLEND);
+			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			glDepthMask(GL_FALSE);
+
+			shader->Bind();
+			shader->SetMat4("u_ViewProjection", projection * view);
+			glBindVertexArray(s_VAO);
+
+			if (counts[0] > 0)
+			{
+				glEnable(GL_DEPTH_TEST);
+				glDrawArrays(GL_LINES, 0, counts[0]);
+				s_Stats.DrawCalls++;
+			}
+
+			if (counts[1] > 0)
+			{
+				glDisable(GL_DEPTH_TEST);
+				glDrawArrays(GL_LINES, counts[0], counts[1]);
+				s_Stats.DrawCalls++;
+			}
+
+			glBindVertexArray(0);
+			shader->Unbind();
+
+			glDepthMask(GL_TRUE);
+			if (depthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+			if (!blend) glDisable(GL_BLEND);
+		}
+
+		s_Stats.Lines = static_cast<uint32_t>(s_Lines.size());
+		s_Stats.Strings = static_cast<uint32_t>(s_Strings.size());
+
+		// Whatever has run out of time was just drawn for the last time.
+		auto expire = [deltaTime](auto& items)
+		{
+			items.erase(std::remove_if(items.begin(), items.end(), [](const auto& item) { return item.Duration <= 0.0f; }), items.end());
+			for (auto& item : items)
+			{
+				item.Duration -= deltaTime;
+			}
+		};
+		expire(s_Lines);
+		expire(s_Strings);
+	}
+
+	void DebugDraw::Clear()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_BuffersMutex);
+			for (auto& buffer : s_Buffers)
+			{
+				buffer->Lines.Drain(s_Lines);
+				buffer->Strings.Drain(s_Strings);
+			}
+		}
+
+		s_Lines.clear();
+		s_Strings.clear();
+	}
+
+	void DebugDraw::Shutdown()
+	{
+		if (s_VAO != 0)
+		{
+			glDeleteVertexArrays(1, &s_VAO);
+			glDeleteBuffers(1, &s_Buffer);
+		}
+
+		s_VAO = 0;
+		s_Buffer = 0;
+		s_Capacity = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(s_BuffersMutex);
+			s_Buffers.clear();
+			s_Generation.fetch_add(1, std::memory_order_release);
+		}
+
+		s_Lines.clear();
+		s_Strings.clear();
+		s_Vertices.clear();
+		s_Stats = {};
+	}
+
+	const DebugDrawStats& DebugDraw::GetStats()
+	{
+		return s_Stats;
+	}
+}
+
+#endif
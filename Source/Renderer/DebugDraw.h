@@ -0,0 +1,121 @@
+#pragma once
+
+#ifndef DEBUG_DRAW_H
+#define DEBUG_DRAW_H
+
+#include <cstdint>
+#include <string>
+#include <glm/glm.hpp>
+#include "../OrcaAPI.h"
+
+// Shipping builds define ORCA_SHIPPING; every DebugDraw call then inlines to nothing.
+#ifndef ORCA_DEBUG_DRAW
+#ifdef ORCA_SHIPPING
+#define ORCA_DEBUG_DRAW 0
+#else
+#define ORCA_DEBUG_DRAW 1
+#endif
+#endif
+
+namespace Orca
+{
+	enum class DebugDepth : uint8_t
+	{
+		Test,		// Hidden behind scene geometry
+		Overlay		// Always on top
+	};
+
+	struct DebugDrawStats
+	{
+		uint32_t Lines = 0;
+		uint32_t Strings = 0;
+		uint32_t DrawCalls = 0;
+		uint64_t UploadBytes = 0;
+	};
+
+	namespace DebugColor
+	{
+		inline const glm::vec4 White(1.0f, 1.0f, 1.0f, 1.0f);
+		inline const glm::vec4 Red(1.0f, 0.0f, 0.0f, 1.0f);
+		inline const glm::vec4 Green(0.0f, 1.0f, 0.0f, 1.0f);
+		inline const glm::vec4 Blue(0.0f, 0.0f, 1.0f, 1.0f);
+		inline const glm::vec4 Yellow(1.0f, 1.0f, 0.0f, 1.0f);
+		inline const glm::vec4 Cyan(0.0f, 1.0f, 1.0f, 1.0f);
+		inline const glm::vec4 Magenta(1.0f, 0.0f, 1.0f, 1.0f);
+	}
+
+#if ORCA_DEBUG_DRAW
+
+	// Immediate-mode lines, boxes, spheres and text for debugging and editor gizmos.
+	//
+	// The Draw functions may be called from any thread, including jobs. Each thread appends to
+	// its own queue without locking; shapes are broken into lines right there, on the caller.
+	// Render() drains the queues on the GL thread and draws everything in at most two calls:
+	// depth-tested lines, then overlay lines. Text is drawn as lines too, with a built-in stroke
+	// font covering ASCII 32-95 (lowercase draws as uppercase), facing the camera at a fixed pixel
+	// height.
+	//
+	// duration is in seconds; 0 draws for exactly one frame.
+	class ORCA_API DebugDraw
+	{
+	public:
+		static void DrawLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color,
+			float duration = 0.0f, DebugDepth depth = DebugDepth::Test);
+
+		// A size-sized cube centred on the transform's origin.
+		static void DrawBox(const glm::mat4& transform, const glm::vec3& size, const glm::vec4& color,
+			float duration = 0.0f, DebugDepth depth = DebugDepth::Test);
+		static void DrawBounds(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color,
+			float duration = 0.0f, DebugDepth depth = DebugDepth::Test);
+
+		// Three great circles.
+		static void DrawSphere(const glm::vec3& center, float radius, const glm::vec4& color,
+			float duration = 0.0f, DebugDepth depth = DebugDepth::Test);
+
+		// The transform's x, y and z axes in red, green and blue.
+		static void DrawAxes(const glm::mat4& transform, float length,
+			float duration = 0.0f, DebugDepth depth = DebugDepth::Overlay);
+
+		// Starts at position and runs along the camera's right axis; height is in pixels.
+		// Longer than 63 characters is cut off.
+		static void DrawString(const glm::vec3& position, const std::string& text, const glm::vec4& color,
+			float height = 16.0f, float duration = 0.0f, DebugDepth depth = DebugDepth::Overlay);
+
+		// GL thread, once per frame, into the bound framebuffer. Ages timed items by deltaTime.
+		static void Render(const glm::mat4& view, const glm::mat4& projection, const glm::vec2& viewportSize, float deltaTime);
+
+		// Drops everything queued or still timed.
+		static void Clear();
+
+		// GL thread, with no Draw calls in flight. Threads that draw afterwards get new queues.
+		static void Shutdown();
+
+		static const DebugDrawStats& GetStats();
+	};
+
+#else
+
+	class DebugDraw
+	{
+	public:
+		static void DrawLine(const glm::vec3&, const glm::vec3&, const glm::vec4&, float = 0.0f, DebugDepth = DebugDepth::Test) {}
+		static void DrawBox(const glm::mat4&, const glm::vec3&, const glm::vec4&, float = 0.0f, DebugDepth = DebugDepth::Test) {}
+		static void DrawBounds(const glm::vec3&, const glm::vec3&, const glm::vec4&, float = 0.0f, DebugDepth = DebugDepth::Test) {}
+		static void DrawSphere(const glm::vec3&, float, const glm::vec4&, float = 0.0f, DebugDepth = DebugDepth::Test) {}
+		static void DrawAxes(const glm::mat4&, float, float = 0.0f, DebugDepth = DebugDepth::Overlay) {}
+		static void DrawString(const glm::vec3&, const std::string&, const glm::vec4&, float = 16.0f, float = 0.0f, DebugDepth = DebugDepth::Overlay) {}
+		static void Render(const glm::mat4&, const glm::mat4&, const glm::vec2&, float) {}
+		static void Clear() {}
+		static void Shutdown() {}
+
+		static const DebugDrawStats& GetStats()
+		{
+			static const DebugDrawStats stats;
+			return stats;
+		}
+	};
+
+#endif
+}
+
+#endif
@@ -0,0 +1,177 @@
+#include "DynamicResolution.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Orca
+{
+	DynamicResolution::~DynamicResolution()
+	{
+		Release();
+	}
+
+	void DynamicResolution::SetSettings(const DynamicResolutionSettings& settings)
+	{
+		m_Settings = settings;
+		m_Settings.MinScale = std::clamp(m_Settings.MinScale, 0.1f, 1.0f);
+		m_Settings.MaxScale = std::clamp(m_Settings.MaxScale, m_Settings.MinScale, 1.0f);
+		m_Settings.HysteresisFrames = std::max(m_Settings.HysteresisFrames, 1u);
+
+		m_Scale = std::clamp(Snap(m_Scale), m_Settings.MinScale, m_Settings.MaxScale);
+		m_Stats.Scale = GetScale();
+		m_Window.clear();
+	}
+
+	void DynamicResolution::Update()
+	{
+		if (!m_Settings.Enabled)
+		{
+			m_Stats.Scale = 1.0f;
+			return;
+		}
+
+		if (m_Queries[0].ID == 0)
+		{
+			for (TimerQuery& query : m_Queries)
+			{
+				glGenQueries(1, &query.ID);
+			}
+		}
+
+		Collect();
+		Adjust();
+	}
+
+	void DynamicResolution::BeginFrame()
+	{
+		if (!m_Settings.Enabled || m_Timing || m_Queries[0].ID == 0)
+		{
+			return;
+		}
+
+		// Every query still in flight means the GPU is that many frames behind; skip timing
+		// this frame rather than wait.
+		TimerQuery& query = m_Queries[m_NextQuery];
+		if (!query.Pending)
+		{
+			glBeginQuery(GL_TIME_ELAPSED, query.ID);
+			query.Pending = true;
+			query.Scale = m_Scale;
+			m_NextQuery = (m_NextQuery + 1) % k_QueryCount;
+			m_Timing = true;
+		}
+	}
+
+	void DynamicResolution::EndFrame()
+	{
+		if (m_Timing)
+		{
+			glEndQuery(GL_TIME_ELAPSED);
+			m_Timing = false;
+		}
+	}
+
+	glm::uvec2 DynamicResolution::GetRenderSize(uint32_t width, uint32_t height) const
+	{
+		const float scale = GetScale();
+		return glm::uvec2(
+			std::max(1u, static_cast<uint32_t>(std::lround(static_cast<float>(width) * scale))),
+			std::max(1u, static_cast<uint32_t>(std::lround(static_cast<float>(height) * scale))));
+	}
+
+	void DynamicResolution::Release()
+	{
+		if (m_Timing)
+		{
+			glEndQuery(GL_TIME_ELAPSED);
+			m_Timing = false;
+		}
+
+		for (TimerQuery& query : m_Queries)
+		{
+			if (query.ID != 0)
+			{
+				glDeleteQueries(1, &query.ID);
+			}
+			query = {};
+		}
+
+		m_NextQuery = 0;
+		m_Window.clear();
+	}
+
+	void DynamicResolution::Collect()
+	{
+		// Oldest first, so the window stays in frame order.
+		for (uint32_t i = 0; i < k_QueryCount; ++i)
+		{
+			TimerQuery& query = m_Queries[(m_NextQuery + i) % k_QueryCount];
+			if (!query.Pending)
+			{
+				continue;
+			}
+
+			GLint available = 0;
+			glGetQueryObjectiv(query.ID, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+			{
+				break;
+			}
+
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(query.ID, GL_QUERY_RESULT, &elapsed);
+			query.Pending = false;
+
+			if (query.Scale == m_Scale)
+			{
+				m_Window.push_back(static_cast<float>(elapsed) * 1e-6f);
+			}
+		}
+	}
+
+	void DynamicResolution::Adjust()
+	{
+		if (m_Window.size() < m_Settings.HysteresisFrames)
+		{
+			return;
+		}
+
+		float total = 0.0f;
+		for (float ms : m_Window)
+		{
+			total += ms;
+		}
+		const float average = total / static_cast<float>(m_Window.size());
+		m_Stats.GpuFrameMs = average;
+		m_Window.clear();
+
+		const float budget = m_Settings.TargetFrameMs;
+		float scale = m_Scale;
+
+		if (average > budget * m_Settings.DecreaseThreshold)
+		{
+			scale = Snap(std::min(m_Scale * std::sqrt(budget / average), m_Scale - m_Settings.ScaleStep));
+		}
+		else if (average < budget * m_Settings.IncreaseThreshold)
+		{
+			scale = Snap(m_Scale + m_Settings.ScaleStep);
+		}
+
+		scale = std::clamp(scale, m_Settings.MinScale, m_Settings.MaxScale);
+		if (scale != m_Scale)
+		{
+			m_Scale = scale;
+			m_Stats.Adjustments++;
+		}
+		m_Stats.Scale = m_Scale;
+	}
+
+	float DynamicResolution::Snap(float scale) const
+	{
+		if (m_Settings.ScaleStep <= 0.0f)
+		{
+			return scale;
+		}
+		return std::round(scale / m_Settings.ScaleStep) * m_Settings.ScaleStep;
+	}
+}
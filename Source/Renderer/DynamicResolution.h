@@ -0,0 +1,101 @@
+#pragma once
+
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	struct DynamicResolutionSettings
+	{
+		bool Enabled = true;
+		float TargetFrameMs = 16.0f;		// GPU budget per frame
+		float MinScale = 0.5f;				// Per axis
+		float MaxScale = 1.0f;
+		float ScaleStep = 0.05f;			// Scales snap to multiples of this, so render targets are reused
+		uint32_t HysteresisFrames = 8;		// Frames averaged, at the current scale, before each decision
+		float IncreaseThreshold = 0.85f;	// Scale up only below this fraction of the budget
+		float DecreaseThreshold = 1.0f;		// Scale down above this fraction of the budget
+		float Sharpness = 0.3f;				// Upscale sharpening, 0 disables it
+	};
+
+	struct DynamicResolutionStats
+	{
+		float Scale = 1.0f;
+		float GpuFrameMs = 0.0f;			// Average over the current window
+		uint32_t Adjustments = 0;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Picks the resolution the scene renders at from measured GPU frame time. Each frame is
+	// bracketed by a GL_TIME_ELAPSED query; results are read a few frames later without stalling.
+	// Once a full window of frames at the current scale is over budget the scale drops by the
+	// square root of the overshoot (cost follows pixel count); once a full window is comfortably
+	// under budget it rises a step. Measurements from before a change are discarded, so the
+	// controller never reacts twice to the same spike.
+	//
+	// GL thread only.
+	class ORCA_API DynamicResolution
+	{
+	public:
+		DynamicResolution() = default;
+		~DynamicResolution();
+
+		DynamicResolution(const DynamicResolution&) = delete;
+		DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+		void SetSettings(const DynamicResolutionSettings& settings);
+		const DynamicResolutionSettings& GetSettings() const { return m_Settings; }
+
+		// Reads finished queries and updates the scale; call before sizing this frame's targets.
+		void Update();
+
+		// Bracket the frame's GPU work. GL_TIME_ELAPSED counts GPU idle time in between, so CPU
+		// work belongs outside.
+		void BeginFrame();
+		void EndFrame();
+
+		float GetScale() const { return m_Settings.Enabled ? m_Scale : 1.0f; }
+
+		// The output size scaled, at least 1x1.
+		glm::uvec2 GetRenderSize(uint32_t width, uint32_t height) const;
+
+		const DynamicResolutionStats& GetStats() const { return m_Stats; }
+
+		void Release();
+
+	private:
+		static constexpr uint32_t k_QueryCount = 4;
+
+		struct TimerQuery
+		{
+			unsigned int ID = 0;
+			bool Pending = false;
+			float Scale = 1.0f;		// The scale the frame was rendered at
+		};
+
+		DynamicResolutionSettings m_Settings;
+		DynamicResolutionStats m_Stats;
+		float m_Scale = 1.0f;
+
+		std::array<TimerQuery, k_QueryCount> m_Queries;
+		uint32_t m_NextQuery = 0;
+		bool m_Timing = false;
+
+		std::vector<float> m_Window;	// GPU milliseconds at the current scale
+
+		void Collect();
+		void Adjust();
+		float Snap(float scale) const;
+	};
+#pragma warning(pop)
+}
+
+#endif
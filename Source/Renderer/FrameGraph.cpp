@@ -0,0 +1,662 @@
+#include "FrameGraph.h"
+#include "../Core/Logger.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <queue>
+
+namespace Orca
+{
+	namespace
+	{
+		// Pool objects nobody asked for in this many frames are deleted.
+		constexpr uint32_t k_MaxUnusedFrames = 8;
+
+		struct FormatInfo
+		{
+			GLenum InternalFormat;
+			GLenum Format;
+			GLenum Type;
+			uint32_t BytesPerPixel;
+		};
+
+		FormatInfo GetFormatInfo(RenderTargetFormat format)
+		{
+			switch (format)
+			{
+			case RenderTargetFormat::RGBA16F: return { GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT, 8 };
+			case RenderTargetFormat::RG16F: return { GL_RG16F, GL_RG, GL_HALF_FLOAT, 4 };
+			case RenderTargetFormat::R11G11B10F: return { GL_R11F_G11F_B10F, GL_RGB, GL_FLOAT, 4 };
+			case RenderTargetFormat::R32F: return { GL_R32F, GL_RED, GL_FLOAT, 4 };
+			case RenderTargetFormat::Depth24Stencil8: return { GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, 4 };
+			case RenderTargetFormat::Depth32F: return { GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT, 4 };
+			default: return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE, 4 };
+			}
+		}
+
+		GLenum GetDepthAttachment(RenderTargetFormat format)
+		{
+			return format == RenderTargetFormat::Depth24Stencil8 ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+		}
+
+		uint64_t GetTextureBytes(const FrameGraphTextureDesc& desc)
+		{
+			return static_cast<uint64_t>(desc.Width) * desc.Height * GetFormatInfo(desc.Format).BytesPerPixel;
+		}
+	}
+
+	FrameGraphResource FrameGraphBuilder::Read(FrameGraphResource resource)
+	{
+		if (resource.Index >= m_Graph.m_Resources.size())
+		{
+			Logger::Log(LogLevel::Error, "FrameGraph: pass " + m_Graph.m_Passes[m_Pass].Name + " reads an invalid resource.");
+			return {};
+		}
+
+		FrameGraph::PassNode& pass = m_Graph.m_Passes[m_Pass];
+		if (std::find(pass.Reads.begin(), pass.Reads.end(), resource.Index) == pass.Reads.end())
+		{
+			pass.Reads.push_back(resource.Index);
+			m_Graph.m_Resources[resource.Index].Readers.push_back(m_Pass);
+		}
+		return resource;
+	}
+
+	FrameGraphResource FrameGraphBuilder::Write(FrameGraphResource resource)
+	{
+		if (resource.Index >= m_Graph.m_Resources.size())
+		{
+			Logger::Log(LogLevel::Error, "FrameGraph: pass " + m_Graph.m_Passes[m_Pass].Name + " writes an invalid resource.");
+			return {};
+		}
+
+		FrameGraph::PassNode& pass = m_Graph.m_Passes[m_Pass];
+		if (std::find(pass.Writes.begin(), pass.Writes.end(), resource.Index) == pass.Writes.end())
+		{
+			pass.Writes.push_back(resource.Index);
+			m_Graph.m_Resources[resource.Index].Writers.push_back(m_Pass);
+		}
+		return resource;
+	}
+
+	void FrameGraphBuilder::SetSideEffect()
+	{
+		m_Graph.m_Passes[m_Pass].SideEffect = true;
+	}
+
+	unsigned int FrameGraphContext::GetTexture(FrameGraphResource resource) const
+	{
+		return resource.IsValid() ? m_Graph.m_Resources[resource.Index].Object : 0;
+	}
+
+	unsigned int FrameGraphContext::GetBuffer(FrameGraphResource resource) const
+	{
+		return resource.IsValid() ? m_Graph.m_Resources[resource.Index].Object : 0;
+	}
+
+	const FrameGraphTextureDesc& FrameGraphContext::GetTextureDesc(FrameGraphResource resource) const
+	{
+		return m_Graph.m_Resources[resource.Index].TextureDesc;
+	}
+
+	void FrameGraphContext::BindRenderTarget(std::initializer_list<FrameGraphResource> colors, FrameGraphResource depth) const
+	{
+		const FrameGraph::ResourceNode* first = nullptr;
+		std::vector<unsigned int> key;
+		key.reserve(colors.size() + 1);
+
+		for (FrameGraphResource color : colors)
+		{
+			const FrameGraph::ResourceNode& node = m_Graph.m_Resources[color.Index];
+			if (node.Type == FrameGraph::ResourceType::RenderTarget)
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, node.Object);
+				glViewport(0, 0, static_cast<GLsizei>(node.TextureDesc.Width), static_cast<GLsizei>(node.TextureDesc.Height));
+				return;
+			}
+
+			first = first ? first : &node;
+			key.push_back(node.Object);
+		}
+
+		const FrameGraph::ResourceNode* depthNode = depth.IsValid() ? &m_Graph.m_Resources[depth.Index] : nullptr;
+		key.push_back(depthNode ? depthNode->Object : 0);
+		first = first ? first : depthNode;
+		if (!first)
+		{
+			return;
+		}
+
+		GLuint& framebuffer = m_Graph.m_Framebuffers[key];
+		if (framebuffer == 0)
+		{
+			glGenFramebuffers(1, &framebuffer);
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+			std::vector<GLenum> drawBuffers;
+			for (size_t i = 0; i + 1 < key.size(); ++i)
+			{
+				const GLenum attachment = GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+				glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, key[i], 0);
+				drawBuffers.push_back(attachment);
+			}
+
+			if (depthNode)
+			{
+				glFramebufferTexture2D(GL_FRAMEBUFFER, GetDepthAttachment(depthNode->TextureDesc.Format), GL_TEXTURE_2D, depthNode->Object, 0);
+			}
+
+			if (drawBuffers.empty())
+			{
+				glDrawBuffer(GL_NONE);
+				glReadBuffer(GL_NONE);
+			}
+			else
+			{
+				glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+			}
+
+			if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			{
+				Logger::Log(LogLevel::Error, "FrameGraph: incomplete framebuffer for " + first->Name);
+			}
+		}
+		else
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		}
+
+		glViewport(0, 0, static_cast<GLsizei>(first->TextureDesc.Width), static_cast<GLsizei>(first->TextureDesc.Height));
+	}
+
+	FrameGraph::~FrameGraph()
+	{
+		Release();
+	}
+
+	FrameGraphResource FrameGraph::AddResource(ResourceNode node)
+	{
+		m_Resources.push_back(std::move(node));
+		m_Compiled = false;
+		return { static_cast<uint32_t>(m_Resources.size() - 1) };
+	}
+
+	FrameGraphResource FrameGraph::CreateTexture(const std::string& name, const FrameGraphTextureDesc& desc)
+	{
+		ResourceNode node;
+		node.Name = name;
+		node.Type = ResourceType::Texture;
+		node.TextureDesc = desc;
+		return AddResource(std::move(node));
+	}
+
+	FrameGraphResource FrameGraph::CreateBuffer(const std::string& name, const FrameGraphBufferDesc& desc)
+	{
+		ResourceNode node;
+		node.Name = name;
+		node.Type = ResourceType::Buffer;
+		node.BufferDesc = desc;
+		return AddResource(std::move(node));
+	}
+
+	FrameGraphResource FrameGraph::ImportTexture(const std::string& name, unsigned int texture, const FrameGraphTextureDesc& desc)
+	{
+		ResourceNode node;
+		node.Name = name;
+		node.Type = ResourceType::Texture;
+		node.TextureDesc = desc;
+		node.Imported = true;
+		node.Object = texture;
+		return AddResource(std::move(node));
+	}
+
+	FrameGraphResource FrameGraph::ImportBuffer(const std::string& name, unsigned int buffer, const FrameGraphBufferDesc& desc)
+	{
+		ResourceNode node;
+		node.Name = name;
+		node.Type = ResourceType::Buffer;
+		node.BufferDesc = desc;
+		node.Imported = true;
+		node.Object = buffer;
+		return AddResource(std::move(node));
+	}
+
+	FrameGraphResource FrameGraph::ImportRenderTarget(const std::string& name, unsigned int framebuffer, const FrameGraphTextureDesc& desc)
+	{
+		ResourceNode node;
+		node.Name = name;
+		node.Type = ResourceType::RenderTarget;
+		node.TextureDesc = desc;
+		node.Imported = true;
+		node.Object = framebuffer;
+		return AddResource(std::move(node));
+	}
+
+	void FrameGraph::AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute)
+	{
+		PassNode pass;
+		pass.Name = name;
+		pass.Execute = std::move(execute);
+		m_Passes.push_back(std::move(pass));
+		m_Compiled = false;
+
+		FrameGraphBuilder builder(*this, static_cast<uint32_t>(m_Passes.size() - 1));
+		if (setup)
+		{
+			setup(builder);
+		}
+	}
+
+	bool FrameGraph::Compile()
+	{
+		m_Order.clear();
+		m_Stats = {};
+		m_Stats.Passes = static_cast<uint32_t>(m_Passes.size());
+
+		// Culling: a pass is referenced by what it writes, a resource by who reads it. Transient
+		// resources nobody reads release their writers, which may in turn release what those read.
+		std::vector<uint32_t> unreferenced;
+		for (uint32_t i = 0; i < m_Resources.size(); ++i)
+		{
+			ResourceNode& resource = m_Resources[i];
+			resource.RefCount = static_cast<uint32_t>(resource.Readers.size());
+			resource.Physical = -1;
+			if (!resource.Imported)
+			{
+				resource.Object = 0;
+				if (resource.RefCount == 0)
+				{
+					unreferenced.push_back(i);
+				}
+			}
+		}
+
+		for (PassNode& pass : m_Passes)
+		{
+			pass.RefCount = static_cast<uint32_t>(pass.Writes.size());
+			pass.Culled = pass.RefCount == 0 && !pass.SideEffect;
+			pass.Acquire.clear();
+			pass.Release.clear();
+		}
+
+		auto releaseReads = [&](const PassNode& pass)
+			{
+				for (uint32_t read : pass.Reads)
+				{
+					ResourceNode& resource = m_Resources[read];
+					if (resource.RefCount > 0 && --resource.RefCount == 0 && !resource.Imported)
+					{
+						unreferenced.push_back(read);
+					}
+				}
+			};
+
+		for (const PassNode& pass : m_Passes)
+		{
+			if (pass.Culled)
+			{
+				releaseReads(pass);
+			}
+		}
+
+		while (!unreferenced.empty())
+		{
+			const uint32_t index = unreferenced.back();
+			unreferenced.pop_back();
+
+			for (uint32_t writer : m_Resources[index].Writers)
+			{
+				PassNode& pass = m_Passes[writer];
+				if (!pass.Culled && pass.RefCount > 0 && --pass.RefCount == 0 && !pass.SideEffect)
+				{
+					pass.Culled = true;
+					releaseReads(pass);
+				}
+			}
+		}
+
+		// Ordering: writers of a resource run in declaration order, and passes that only read it
+		// run after all of them. Ties go to declaration order, so a graph built in a sensible
+		// order executes as written.
+		std::vector<std::vector<uint32_t>> edges(m_Passes.size());
+		std::vector<uint32_t> incoming(m_Passes.size(), 0);
+		auto addEdge = [&](uint32_t from, uint32_t to)
+			{
+				if (from != to && !m_Passes[from].Culled && !m_Passes[to].Culled &&
+					std::find(edges[from].begin(), edges[from].end(), to) == edges[from].end())
+				{
+					edges[from].push_back(to);
+					incoming[to]++;
+				}
+			};
+
+		for (const ResourceNode& resource : m_Resources)
+		{
+			for (size_t i = 1; i < resource.Writers.size(); ++i)
+			{
+				addEdge(resource.Writers[i - 1], resource.Writers[i]);
+			}
+
+			for (uint32_t reader : resource.Readers)
+			{
+				if (std::find(resource.Writers.begin(), resource.Writers.end(), reader) != resource.Writers.end())
+				{
+					continue;
+				}
+				for (uint32_t writer : resource.Writers)
+				{
+					addEdge(writer, reader);
+				}
+			}
+		}
+
+		std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+		uint32_t kept = 0;
+		for (uint32_t i = 0; i < m_Passes.size(); ++i)
+		{
+			if (m_Passes[i].Culled)
+			{
+				m_Stats.CulledPasses++;
+				continue;
+			}
+
+			kept++;
+			if (incoming[i] == 0)
+			{
+				ready.push(i);
+			}
+		}
+
+		while (!ready.empty())
+		{
+			const uint32_t pass = ready.top();
+			ready.pop();
+			m_Order.push_back(pass);
+
+			for (uint32_t next : edges[pass])
+			{
+				if (--incoming[next] == 0)
+				{
+					ready.push(next);
+				}
+			}
+		}
+
+		bool acyclic = true;
+		if (m_Order.size() != kept)
+		{
+			Logger::Log(LogLevel::Error, "FrameGraph: passes depend on each other in a cycle, running them in declaration order.");
+			m_Order.clear();
+			for (uint32_t i = 0; i < m_Passes.size(); ++i)
+			{
+				if (!m_Passes[i].Culled)
+				{
+					m_Order.push_back(i);
+				}
+			}
+			acyclic = false;
+		}
+
+		// Lifetimes: a transient resource gets memory before its first user and gives it back
+		// after its last one.
+		std::vector<int> firstUse(m_Resources.size(), -1);
+		std::vector<int> lastUse(m_Resources.size(), -1);
+		for (int position = 0; position < static_cast<int>(m_Order.size()); ++position)
+		{
+			const PassNode& pass = m_Passes[m_Order[position]];
+			for (const std::vector<uint32_t>* accesses : { &pass.Reads, &pass.Writes })
+			{
+				for (uint32_t index : *accesses)
+				{
+					if (firstUse[index] < 0)
+					{
+						firstUse[index] = position;
+					}
+					lastUse[index] = position;
+				}
+			}
+		}
+
+		for (uint32_t i = 0; i < m_Resources.size(); ++i)
+		{
+			const ResourceNode& resource = m_Resources[i];
+			if (resource.Imported || firstUse[i] < 0)
+			{
+				continue;
+			}
+
+			m_Passes[m_Order[firstUse[i]]].Acquire.push_back(i);
+			m_Passes[m_Order[lastUse[i]]].Release.push_back(i);
+
+			if (resource.Type == ResourceType::Texture)
+			{
+				m_Stats.TransientTextures++;
+				m_Stats.TransientBytes += GetTextureBytes(resource.TextureDesc);
+			}
+		}
+
+		m_Compiled = true;
+		return acyclic;
+	}
+
+	void FrameGraph::Execute()
+	{
+		if (!m_Compiled)
+		{
+			Compile();
+		}
+
+		FrameGraphContext context(*this);
+		for (uint32_t index : m_Order)
+		{
+			PassNode& pass = m_Passes[index];
+
+			for (uint32_t resource : pass.Acquire)
+			{
+				Acquire(m_Resources[resource]);
+			}
+
+			if (pass.Execute)
+			{
+				pass.Execute(context);
+			}
+
+			for (uint32_t resource : pass.Release)
+			{
+				ReleaseResource(m_Resources[resource]);
+			}
+		}
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		for (const PhysicalTexture& texture : m_Textures)
+		{
+			if (texture.UnusedFrames == 0)
+			{
+				m_Stats.PhysicalTextures++;
+				m_Stats.PhysicalBytes += GetTextureBytes(texture.Desc);
+			}
+		}
+
+		CollectUnused();
+	}
+
+	void FrameGraph::Acquire(ResourceNode& resource)
+	{
+		if (resource.Type == ResourceType::Texture)
+		{
+			for (size_t i = 0; i < m_Textures.size(); ++i)
+			{
+				PhysicalTexture& texture = m_Textures[i];
+				if (!texture.InUse && texture.Desc == resource.TextureDesc)
+				{
+					texture.InUse = true;
+					texture.UnusedFrames = 0;
+					resource.Physical = static_cast<int>(i);
+					resource.Object = texture.ID;
+					return;
+				}
+			}
+
+			const FormatInfo info = GetFormatInfo(resource.TextureDesc.Format);
+
+			PhysicalTexture texture;
+			texture.Desc = resource.TextureDesc;
+			texture.InUse = true;
+			glGenTextures(1, &texture.ID);
+			glBindTexture(GL_TEXTURE_2D, texture.ID);
+			glTexImage2D(GL_TEXTURE_2D, 0, info.InternalFormat, static_cast<GLsizei>(texture.Desc.Width),
+				static_cast<GLsizei>(texture.Desc.Height), 0, info.Format, info.Type, nullptr);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glBindTexture(GL_TEXTURE_2D, 0);
+
+			resource.Physical = static_cast<int>(m_Textures.size());
+			resource.Object = texture.ID;
+			m_Textures.push_back(texture);
+		}
+		else if (resource.Type == ResourceType::Buffer)
+		{
+			// Smallest free buffer that fits.
+			int best = -1;
+			for (size_t i = 0; i < m_Buffers.size(); ++i)
+			{
+				const PhysicalBuffer& buffer = m_Buffers[i];
+				if (!buffer.InUse && buffer.Size >= resource.BufferDesc.Size && (best < 0 || buffer.Size < m_Buffers[best].Size))
+				{
+					best = static_cast<int>(i);
+				}
+			}
+
+			if (best < 0)
+			{
+				PhysicalBuffer buffer;
+				buffer.Size = resource.BufferDesc.Size;
+				glGenBuffers(1, &buffer.ID);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, buffer.ID);
+				glBufferData(GL_COPY_WRITE_BUFFER, buffer.Size, nullptr, GL_DYNAMIC_DRAW);
+				glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+				best = static_cast<int>(m_Buffers.size());
+				m_Buffers.push_back(buffer);
+			}
+
+			m_Buffers[best].InUse = true;
+			m_Buffers[best].UnusedFrames = 0;
+			resource.Physical = best;
+			resource.Object = m_Buffers[best].ID;
+		}
+	}
+
+	void FrameGraph::ReleaseResource(ResourceNode& resource)
+	{
+		if (resource.Physical < 0)
+		{
+			return;
+		}
+
+		if (resource.Type == ResourceType::Texture)
+		{
+			m_Textures[resource.Physical].InUse = false;
+		}
+		else if (resource.Type == ResourceType::Buffer)
+		{
+			m_Buffers[resource.Physical].InUse = false;
+		}
+		resource.Physical = -1;
+	}
+
+	void FrameGraph::CollectUnused()
+	{
+		for (auto it = m_Textures.begin(); it != m_Textures.end();)
+		{
+			if (it->UnusedFrames++ < k_MaxUnusedFrames)
+			{
+				++it;
+				continue;
+			}
+
+			const unsigned int id = it->ID;
+			for (auto framebuffer = m_Framebuffers.begin(); framebuffer != m_Framebuffers.end();)
+			{
+				if (std::find(framebuffer->first.begin(), framebuffer->first.end(), id) != framebuffer->first.end())
+				{
+					glDeleteFramebuffers(1, &framebuffer->second);
+					framebuffer = m_Framebuffers.erase(framebuffer);
+				}
+				else
+				{
+					++framebuffer;
+				}
+			}
+
+			glDeleteTextures(1, &it->ID);
+			it = m_Textures.erase(it);
+		}
+
+		for (auto it = m_Buffers.begin(); it != m_Buffers.end();)
+		{
+			if (it->UnusedFrames++ < k_MaxUnusedFrames)
+			{
+				++it;
+				continue;
+			}
+
+			glDeleteBuffers(1, &it->ID);
+			it = m_Buffers.erase(it);
+		}
+	}
+
+	void FrameGraph::Reset()
+	{
+		// Physical indices are only meaningful within one execution.
+		for (PhysicalTexture& texture : m_Textures)
+		{
+			texture.InUse = false;
+		}
+		for (PhysicalBuffer& buffer : m_Buffers)
+		{
+			buffer.InUse = false;
+		}
+
+		m_Passes.clear();
+		m_Resources.clear();
+		m_Order.clear();
+		m_Compiled = false;
+	}
+
+	void FrameGraph::Release()
+	{
+		Reset();
+
+		for (auto& [attachments, framebuffer] : m_Framebuffers)
+		{
+			glDeleteFramebuffers(1, &framebuffer);
+		}
+		m_Framebuffers.clear();
+
+		for (PhysicalTexture& texture : m_Textures)
+		{
+			glDeleteTextures(1, &texture.ID);
+		}
+		m_Textures.clear();
+
+		for (PhysicalBuffer& buffer : m_Buffers)
+		{
+			glDeleteBuffers(1, &buffer.ID);
+		}
+		m_Buffers.clear();
+	}
+
+	std::vector<std::string> FrameGraph::GetExecutionOrder() const
+	{
+		std::vector<std::string> names;
+		names.reserve(m_Order.size());
+		for (uint32_t index : m_Order)
+		{
+			names.push_back(m_Passes[index].Name);
+		}
+		return names;
+	}
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#ifndef FRAME_GRAPH_H
+#define FRAME_GRAPH_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	enum class RenderTargetFormat : uint8_t
+	{
+		RGBA8,
+		RGBA16F,
+		RG16F,
+		R11G11B10F,
+		R32F,
+		Depth24Stencil8,
+		Depth32F
+	};
+
+	struct FrameGraphTextureDesc
+	{
+		uint32_t Width = 1;
+		uint32_t Height = 1;
+		RenderTargetFormat Format = RenderTargetFormat::RGBA8;
+
+		bool operator==(const FrameGraphTextureDesc&) const = default;
+	};
+
+	struct FrameGraphBufferDesc
+	{
+		uint32_t Size = 0;
+	};
+
+	// A virtual resource. Only valid in the graph that created it, until its next Reset().
+	struct FrameGraphResource
+	{
+		static constexpr uint32_t k_Invalid = ~0u;
+
+		uint32_t Index = k_Invalid;
+
+		bool IsValid() const { return Index != k_Invalid; }
+	};
+
+	struct FrameGraphStats
+	{
+		uint32_t Passes = 0;
+		uint32_t CulledPasses = 0;
+		uint32_t TransientTextures = 0;		// Virtual textures the kept passes use
+		uint32_t PhysicalTextures = 0;		// GL textures they were mapped to
+		uint64_t TransientBytes = 0;		// What giving every virtual texture its own memory would cost
+		uint64_t PhysicalBytes = 0;
+	};
+
+	class FrameGraph;
+
+	// Handed to a pass's setup function to declare what it reads and writes.
+	class ORCA_API FrameGraphBuilder
+	{
+	public:
+		FrameGraphResource Read(FrameGraphResource resource);
+		FrameGraphResource Write(FrameGraphResource resource);
+
+		// Keeps the pass even when nothing reads its output, e.g. for readbacks and queries.
+		void SetSideEffect();
+
+	private:
+		friend class FrameGraph;
+
+		FrameGraphBuilder(FrameGraph& graph, uint32_t pass) : m_Graph(graph), m_Pass(pass) {}
+
+		FrameGraph& m_Graph;
+		uint32_t m_Pass;
+	};
+
+	// Handed to a pass's execute function; resolves its resources to GL objects.
+	class ORCA_API FrameGraphContext
+	{
+	public:
+		unsigned int GetTexture(FrameGraphResource resource) const;
+		unsigned int GetBuffer(FrameGraphResource resource) const;
+		const FrameGraphTextureDesc& GetTextureDesc(FrameGraphResource resource) const;
+
+		// Binds a framebuffer with these attachments and sets the viewport to their size. An
+		// imported render target is bound as is.
+		void BindRenderTarget(std::initializer_list<FrameGraphResource> colors, FrameGraphResource depth = {}) const;
+
+	private:
+		friend class FrameGraph;
+
+		explicit FrameGraphContext(FrameGraph& graph) : m_Graph(graph) {}
+
+		FrameGraph& m_Graph;
+	};
+
+	// Passes declare the textures and buffers they read and write instead of being called in a
+	// fixed order. Compile() culls passes whose output nobody reads, orders the rest so every
+	// pure reader of a resource runs after all of its writers (writers of one resource keep their
+	// declaration order), and works out how long each transient resource lives. Execute() then
+	// maps transient resources onto a pool of GL objects: once a resource's last reader has run,
+	// its texture is handed to the next resource with the same size and format, so a chain of
+	// post-processing passes ping-pongs between two textures instead of owning one per step.
+	//
+	// Imported resources are owned elsewhere and count as outputs, so passes writing them are
+	// never culled. Rebuild the graph every frame; the pool outlives Reset().
+	//
+	// GL thread only.
+	class ORCA_API FrameGraph
+	{
+	public:
+		using SetupFunction = std::function<void(FrameGraphBuilder& builder)>;
+		using ExecuteFunction = std::function<void(const FrameGraphContext& context)>;
+
+		FrameGraph() = default;
+		~FrameGraph();
+
+		FrameGraph(const FrameGraph&) = delete;
+		FrameGraph& operator=(const FrameGraph&) = delete;
+
+		// Transient: memory is only assigned for the passes between first and last use.
+		FrameGraphResource CreateTexture(const std::string& name, const FrameGraphTextureDesc& desc);
+		FrameGraphResource CreateBuffer(const std::string& name, const FrameGraphBufferDesc& desc);
+
+		FrameGraphResource ImportTexture(const std::string& name, unsigned int texture, const FrameGraphTextureDesc& desc);
+		FrameGraphResource ImportBuffer(const std::string& name, unsigned int buffer, const FrameGraphBufferDesc& desc);
+
+		// framebuffer 0 is the window.
+		FrameGraphResource ImportRenderTarget(const std::string& name, unsigned int framebuffer, const FrameGraphTextureDesc& desc);
+
+		// setup runs immediately; execute runs from Execute() if the pass survives culling.
+		void AddPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+		// Called by Execute() if needed; returns false if the passes form a cycle, in which case
+		// they run in declaration order.
+		bool Compile();
+		void Execute();
+
+		// Drops passes and resources, keeps the pool.
+		void Reset();
+
+		// Deletes the pool.
+		void Release();
+
+		const FrameGraphStats& GetStats() const { return m_Stats; }
+
+		// Names of the passes Execute() runs, in order. Valid after Compile().
+		std::vector<std::string> GetExecutionOrder() const;
+
+	private:
+		friend class FrameGraphBuilder;
+		friend class FrameGraphContext;
+
+		enum class ResourceType : uint8_t
+		{
+			Texture,
+			Buffer,
+			RenderTarget
+		};
+
+		struct ResourceNode
+		{
+			std::string Name;
+			ResourceType Type = ResourceType::Texture;
+			FrameGraphTextureDesc TextureDesc;
+			FrameGraphBufferDesc BufferDesc;
+			bool Imported = false;
+			unsigned int Object = 0;			// Imported, or the pool object while alive
+
+			std::vector<uint32_t> Writers;		// Passes, in declaration order
+			std::vector<uint32_t> Readers;
+			uint32_t RefCount = 0;
+			int Physical = -1;
+		};
+
+		struct PassNode
+		{
+			std::string Name;
+			ExecuteFunction Execute;
+			std::vector<uint32_t> Reads;
+			std::vector<uint32_t> Writes;
+			bool SideEffect = false;
+			uint32_t RefCount = 0;
+			bool Culled = false;
+
+			// Filled by Compile(), as resource indices.
+			std::vector<uint32_t> Acquire;
+			std::vector<uint32_t> Release;
+		};
+
+		struct PhysicalTexture
+		{
+			FrameGraphTextureDesc Desc;
+			unsigned int ID = 0;
+			bool InUse = false;
+			uint32_t UnusedFrames = 0;
+		};
+
+		struct PhysicalBuffer
+		{
+			uint32_t Size = 0;
+			unsigned int ID = 0;
+			bool InUse = false;
+			uint32_t UnusedFrames = 0;
+		};
+
+		std::vector<PassNode> m_Passes;
+		std::vector<ResourceNode> m_Resources;
+		std::vector<uint32_t> m_Order;
+		bool m_Compiled = false;
+
+		std::vector<PhysicalTexture> m_Textures;
+		std::vector<PhysicalBuffer> m_Buffers;
+		std::map<std::vector<unsigned int>, unsigned int> m_Framebuffers;	// By attachments, depth last
+
+		FrameGraphStats m_Stats;
+
+		FrameGraphResource AddResource(ResourceNode node);
+		void Acquire(ResourceNode& resource);
+		void ReleaseResource(ResourceNode& resource);
+		void CollectUnused();
+	};
+#pragma warning(pop)
+}
+
+#endif
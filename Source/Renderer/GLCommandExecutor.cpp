@@ -0,0 +1,237 @@
+#include "GLCommandExecutor.h"
+#include "Shader.h"
+#include "Mesh.h"
+#include "ClusteredLighting.h"
+#include "ShadowRenderer.h"
+#include "../Material/Material.h"
+#include <GL/glew.h>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr GLuint k_InstanceModelLocation = 4;
+		constexpr GLuint k_InstanceColorLocation = 8;
+		constexpr GLuint k_InstanceScaleLocation = 9;
+		constexpr GLuint k_InstanceOffsetLocation = 10;
+	}
+
+	void GLCommandExecutor::Execute(const CommandList& list, const FrameConstants& frame)
+	{
+		m_Stats = {};
+
+		if (m_MultiDrawSupport < 0)
+		{
+			// Instance attributes are fetched through each command's baseInstance, which drivers only
+			// honour with GL 4.2 or ARB_base_instance; without it every draw would read instance 0.
+			const bool multiDraw = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+			const bool baseInstance = GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+			m_MultiDrawSupport = (multiDraw && baseInstance) ? 1 : 0;
+		}
+
+		BuildBatches(list, m_MultiDrawSupport == 1);
+		UploadBatches();
+
+		// The lighting pass uploads the light lists once for everything this frame draws.
+		m_Stats.UploadBytes = GetBatchUploadSize() + (frame.Lighting ? frame.Lighting->GetUploadSize() : 0);
+
+		const auto& packets = list.GetPackets();
+		const Shader* boundProgram = nullptr;
+		uint32_t boundProgramKey = 0;
+		const Mesh* boundGeometry = nullptr;
+		const Mesh* decodedGeometry = nullptr;
+		const Material* boundMaterial = nullptr;
+		int instanceMode = -1;
+
+		for (const Batch& batch : m_Batches)
+		{
+			const RenderPacket& first = packets[batch.FirstPacket];
+
+			if (first.Program != boundProgram || first.ProgramKey != boundProgramKey)
+			{
+				boundProgram = first.Program;
+				boundProgramKey = first.ProgramKey;
+				boundProgram->Bind();
+				boundProgram->SetMat4("u_ViewProjection", frame.ViewProjection);
+				boundProgram->SetVec3("u_CameraPos", frame.CameraPosition);
+				if (frame.Lighting)
+				{
+					frame.Lighting->Apply(*boundProgram, frame.ViewportSize.x, frame.ViewportSize.y);
+				}
+				if (frame.Shadows)
+				{
+					frame.Shadows->Apply(*boundProgram);
+				}
+				m_Stats.ProgramBinds++;
+
+				// Uniform state belongs to the program, so everything cached against the old one is stale.
+				decodedGeometry = nullptr;
+				boundMaterial = nullptr;
+				instanceMode = -1;
+			}
+
+			if (first.MaterialInstance && first.MaterialInstance != boundMaterial)
+			{
+				boundMaterial = first.MaterialInstance;
+
+				const MaterialTemplate& materialTemplate = boundMaterial->GetTemplate();
+				auto setup = m_ProgramTemplates.find(boundProgram->GetID());
+				if (setup == m_ProgramTemplates.end() || setup->second != materialTemplate.GetID())
+				{
+					materialTemplate.SetupProgram(boundProgram->GetID());
+					m_ProgramTemplates[boundProgram->GetID()] = materialTemplate.GetID();
+				}
+
+				m_Stats.UploadBytes += boundMaterial->GetParameterUploadSize();
+				m_Stats.TextureBinds += boundMaterial->GetTextureBindCount();
+				boundMaterial->Bind();
+				m_Stats.MaterialBinds++;
+			}
+
+			int batchMode = batch.MultiDraw ? 1 : 0;
+			if (batchMode != instanceMode)
+			{
+				instanceMode = batchMode;
+				boundProgram->SetInt("u_UseInstanceData", instanceMode);
+			}
+
+			if (batch.MultiDraw)
+			{
+				// The whole bucket shares one VAO; per-draw data comes from the instance buffer.
+				first.Geometry->Bind();
+				boundGeometry = first.Geometry;
+				decodedGeometry = nullptr;
+				m_Stats.GeometryBinds++;
+
+				BindInstanceAttributes();
+				boundProgram->SetInt("u_OctNormals", first.Geometry->GetLayout().UsesOctahedralNormals() ? 1 : 0);
+
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+				glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+					reinterpret_cast<const void*>(static_cast<uintptr_t>(batch.FirstCommand) * sizeof(DrawElementsIndirectCommand)),
+					static_cast<GLsizei>(batch.PacketCount), 0);
+				glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+				m_Stats.MultiDrawCalls++;
+				continue;
+			}
+
+			for (size_t i = batch.FirstPacket; i < batch.FirstPacket + batch.PacketCount; ++i)
+			{
+				const RenderPacket& packet = packets[i];
+
+				if (packet.Geometry != boundGeometry)
+				{
+					boundGeometry = packet.Geometry;
+					boundGeometry->Bind();
+					m_Stats.GeometryBinds++;
+				}
+
+				// Vertex decoding parameters are per mesh on this path, and reset whenever the program changes.
+				if (boundGeometry != decodedGeometry)
+				{
+					decodedGeometry = boundGeometry;
+					const VertexDequantization& dequantization = boundGeometry->GetDequantization();
+					boundProgram->SetVec3("u_PositionScale", dequantization.Scale);
+					boundProgram->SetVec3("u_PositionOffset", dequantization.Offset);
+					boundProgram->SetInt("u_OctNormals", boundGeometry->GetLayout().UsesOctahedralNormals() ? 1 : 0);
+				}
+
+				const DrawConstants& constants = list.GetConstants(packet.ConstantsIndex);
+				boundProgram->SetMat4("u_Model", constants.Model);
+				boundProgram->SetVec3("u_AlbedoColor", glm::vec3(constants.AlbedoColor));
+
+				switch (packet.Type)
+				{
+				case RenderPacketType::DrawIndexed:
+				{
+					const GeometryRange& range = boundGeometry->GetGeometryRange();
+					glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.IndexCount), GL_UNSIGNED_INT,
+						reinterpret_cast<const void*>(static_cast<uintptr_t>(range.FirstIndex) * sizeof(uint32_t)),
+						static_cast<GLint>(range.BaseVertex));
+					m_Stats.DrawCalls++;
+					break;
+				}
+				}
+			}
+		}
+
+		if (boundGeometry)
+		{
+			boundGeometry->Unbind();
+		}
+
+		if (boundProgram)
+		{
+			boundProgram->Unbind();
+		}
+	}
+
+	void GLCommandExecutor::Release()
+	{
+		if (m_IndirectBuffer != 0)
+		{
+			glDeleteBuffers(1, &m_IndirectBuffer);
+			m_IndirectBuffer = 0;
+		}
+
+		if (m_InstanceBuffer != 0)
+		{
+			glDeleteBuffers(1, &m_InstanceBuffer);
+			m_InstanceBuffer = 0;
+		}
+
+		m_ProgramTemplates.clear();
+		CommandExecutor::Release();
+	}
+
+	void GLCommandExecutor::UploadBatches()
+	{
+		if (m_Commands.empty())
+		{
+			return;
+		}
+
+		if (m_IndirectBuffer == 0)
+		{
+			glGenBuffers(1, &m_IndirectBuffer);
+			glGenBuffers(1, &m_InstanceBuffer);
+		}
+
+		// Orphan and refill once per frame; the driver hands back fresh storage instead of stalling.
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+		glBufferData(GL_DRAW_INDIRECT_BUFFER, m_Commands.size() * sizeof(DrawElementsIndirectCommand), m_Commands.data(), GL_STREAM_DRAW);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBuffer);
+		glBufferData(GL_ARRAY_BUFFER, m_Instances.size() * sizeof(InstanceData), m_Instances.data(), GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void GLCommandExecutor::BindInstanceAttributes() const
+	{
+		const GLsizei stride = sizeof(InstanceData);
+		glBindBuffer(GL_ARRAY_BUFFER, m_InstanceBuffer);
+
+		for (GLuint column = 0; column < 4; ++column)
+		{
+			GLuint location = k_InstanceModelLocation + column;
+			glEnableVertexAttribArray(location);
+			glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+				reinterpret_cast<const void*>(offsetof(InstanceData, Model) + column * sizeof(glm::vec4)));
+			glVertexAttribDivisor(location, 1);
+		}
+
+		const GLuint locations[] = { k_InstanceColorLocation, k_InstanceScaleLocation, k_InstanceOffsetLocation };
+		const size_t offsets[] = { offsetof(InstanceData, AlbedoColor), offsetof(InstanceData, PositionScale), offsetof(InstanceData, PositionOffset) };
+
+		for (int i = 0; i < 3; ++i)
+		{
+			glEnableVertexAttribArray(locations[i]);
+			glVertexAttribPointer(locations[i], 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(offsets[i]));
+			glVertexAttribDivisor(locations[i], 1);
+		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#ifndef GL_COMMAND_EXECUTOR_H
+#define GL_COMMAND_EXECUTOR_H
+
+#include <cstdint>
+#include <unordered_map>
+#include "CommandExecutor.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Replays a merged CommandList on the thread that owns the GL context.
+	// Redundant program and vertex array binds are skipped, which is where the sort key pays off.
+	// Runs of packets sharing a program, a material and a geometry arena pool are submitted as a single
+	// glMultiDrawElementsIndirect call when the driver supports it.
+	class ORCA_API GLCommandExecutor : public CommandExecutor
+	{
+	public:
+		void Execute(const CommandList& list, const FrameConstants& frame) override;
+		void Release() override;
+
+	private:
+		unsigned int m_IndirectBuffer = 0;
+		unsigned int m_InstanceBuffer = 0;
+		int m_MultiDrawSupport = -1;
+
+		// Template each program was last set up for, by GL program name.
+		std::unordered_map<unsigned int, uint16_t> m_ProgramTemplates;
+
+		void UploadBatches();
+		void BindInstanceAttributes() const;
+	};
+#pragma warning(pop)
+}
+
+#endif
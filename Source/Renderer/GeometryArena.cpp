@@ -0,0 +1,414 @@
+#include "GeometryArena.h"
+#include "../Core/Logger.h"
+#include <GL/glew.h>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint32_t k_InitialVertexCapacity = 256 * 1024;
+		constexpr uint32_t k_InitialIndexCapacity = 1024 * 1024;
+
+		// First-fit free list over [0, capacity) with coalescing on free.
+		class RangeAllocator
+		{
+		public:
+			void Reset(uint32_t capacity, uint32_t used)
+			{
+				m_Capacity = capacity;
+				m_Free.clear();
+				if (used < capacity)
+				{
+					m_Free[used] = capacity - used;
+				}
+			}
+
+			bool Allocate(uint32_t size, uint32_t& outOffset)
+			{
+				for (auto it = m_Free.begin(); it != m_Free.end(); ++it)
+				{
+					if (it->second < size)
+					{
+						continue;
+					}
+
+					outOffset = it->first;
+					uint32_t remaining = it->second - size;
+					m_Free.erase(it);
+					if (remaining > 0)
+					{
+						m_Free[outOffset + size] = remaining;
+					}
+					return true;
+				}
+
+				return false;
+			}
+
+			void Free(uint32_t offset, uint32_t size)
+			{
+				auto next = m_Free.lower_bound(offset);
+				if (next != m_Free.end() && offset + size == next->first)
+				{
+					size += next->second;
+					next = m_Free.erase(next);
+				}
+
+				if (next != m_Free.begin())
+				{
+					auto prev = std::prev(next);
+					if (prev->first + prev->second == offset)
+					{
+						prev->second += size;
+						return;
+					}
+				}
+
+				m_Free[offset] = size;
+			}
+
+			void Grow(uint32_t newCapacity)
+			{
+				if (newCapacity > m_Capacity)
+				{
+					Free(m_Capacity, newCapacity - m_Capacity);
+					m_Capacity = newCapacity;
+				}
+			}
+
+			uint32_t GetCapacity() const { return m_Capacity; }
+
+			uint32_t GetFreeTotal() const
+			{
+				uint32_t total = 0;
+				for (const auto& [offset, size] : m_Free)
+				{
+					total += size;
+				}
+				return total;
+			}
+
+		private:
+			std::map<uint32_t, uint32_t> m_Free;
+			uint32_t m_Capacity = 0;
+		};
+
+		struct Pool
+		{
+			VertexLayout Layout;
+			GLuint VAO = 0;
+			GLuint VBO = 0;
+			GLuint EBO = 0;
+			RangeAllocator Vertices;
+			RangeAllocator Indices;
+		};
+
+		struct Slot
+		{
+			GeometryRange Range;
+			bool Live = false;
+		};
+
+		std::vector<Pool> s_Pools;
+		std::vector<Slot> s_Slots;
+		std::vector<uint32_t> s_FreeSlots;
+
+		const GeometryRange s_EmptyRange{};
+
+		void BuildVertexArray(Pool& pool)
+		{
+			if (pool.VAO == 0)
+			{
+				glGenVertexArrays(1, &pool.VAO);
+			}
+
+			glBindVertexArray(pool.VAO);
+			glBindBuffer(GL_ARRAY_BUFFER, pool.VBO);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, pool.EBO);
+			pool.Layout.Apply();
+			glBindVertexArray(0);
+		}
+
+		// Moves a pool into freshly sized buffers. With compact == true live ranges are packed
+		// to the front; otherwise they keep their offsets (used when growing).
+		void Reallocate(uint32_t poolIndex, uint32_t vertexCapacity, uint32_t indexCapacity, bool compact)
+		{
+			Pool& pool = s_Pools[poolIndex];
+			const uint32_t stride = pool.Layout.GetStride();
+
+			GLuint newVBO = 0, newEBO = 0;
+			glGenBuffers(1, &newVBO);
+			glGenBuffers(1, &newEBO);
+
+			glBindBuffer(GL_COPY_WRITE_BUFFER, newVBO);
+			glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(vertexCapacity) * stride, nullptr, GL_STATIC_DRAW);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, newEBO);
+			glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(indexCapacity) * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+
+			if (pool.VBO != 0)
+			{
+				std::vector<Slot*> live;
+				for (auto& slot : s_Slots)
+				{
+					if (slot.Live && slot.Range.Pool == poolIndex)
+					{
+						live.push_back(&slot);
+					}
+				}
+
+				std::sort(live.begin(), live.end(),
+					[](const Slot* a, const Slot* b) { return a->Range.BaseVertex < b->Range.BaseVertex; });
+
+				uint32_t vertexCursor = 0;
+				uint32_t indexCursor = 0;
+
+				for (Slot* slot : live)
+				{
+					GeometryRange& range = slot->Range;
+					uint32_t dstVertex = compact ? vertexCursor : range.BaseVertex;
+					uint32_t dstIndex = compact ? indexCursor : range.FirstIndex;
+
+					glBindBuffer(GL_COPY_READ_BUFFER, pool.VBO);
+					glBindBuffer(GL_COPY_WRITE_BUFFER, newVBO);
+					glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+						static_cast<GLintptr>(range.BaseVertex) * stride, static_cast<GLintptr>(dstVertex) * stride,
+						static_cast<GLsizeiptr>(range.VertexCount) * stride);
+
+					glBindBuffer(GL_COPY_READ_BUFFER, pool.EBO);
+					glBindBuffer(GL_COPY_WRITE_BUFFER, newEBO);
+					glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+						static_cast<GLintptr>(range.FirstIndex) * sizeof(uint32_t), static_cast<GLintptr>(dstIndex) * sizeof(uint32_t),
+						static_cast<GLsizeiptr>(range.IndexCount) * sizeof(uint32_t));
+
+					range.BaseVertex = dstVertex;
+					range.FirstIndex = dstIndex;
+					vertexCursor = dstVertex + range.VertexCount;
+					indexCursor = dstIndex + range.IndexCount;
+				}
+
+				if (compact)
+				{
+					pool.Vertices.Reset(vertexCapacity, vertexCursor);
+					pool.Indices.Reset(indexCapacity, indexCursor);
+				}
+				else
+				{
+					pool.Vertices.Grow(vertexCapacity);
+					pool.Indices.Grow(indexCapacity);
+				}
+
+				glDeleteBuffers(1, &pool.VBO);
+				glDeleteBuffers(1, &pool.EBO);
+			}
+			else
+			{
+				pool.Vertices.Reset(vertexCapacity, 0);
+				pool.Indices.Reset(indexCapacity, 0);
+			}
+
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+			pool.VBO = newVBO;
+			pool.EBO = newEBO;
+			BuildVertexArray(pool);
+		}
+
+		uint32_t FindOrCreatePool(const VertexLayout& layout)
+		{
+			for (uint32_t i = 0; i < s_Pools.size(); ++i)
+			{
+				if (s_Pools[i].Layout == layout)
+				{
+					return i;
+				}
+			}
+
+			s_Pools.emplace_back();
+			s_Pools.back().Layout = layout;
+
+			uint32_t index = static_cast<uint32_t>(s_Pools.size() - 1);
+			Reallocate(index, k_InitialVertexCapacity, k_InitialIndexCapacity, false);
+			return index;
+		}
+
+		// Tries defragmenting before growing, since growing doubles the VRAM footprint of the pool.
+		bool Reserve(uint32_t poolIndex, uint32_t vertexCount, uint32_t indexCount, uint32_t& outVertex, uint32_t& outIndex)
+		{
+			Pool& pool = s_Pools[poolIndex];
+
+			for (int attempt = 0; attempt < 3; ++attempt)
+			{
+				uint32_t vertexOffset = 0, indexOffset = 0;
+				bool vertexOk = pool.Vertices.Allocate(vertexCount, vertexOffset);
+				bool indexOk = vertexOk && pool.Indices.Allocate(indexCount, indexOffset);
+
+				if (vertexOk && indexOk)
+				{
+					outVertex = vertexOffset;
+					outIndex = indexOffset;
+					return true;
+				}
+
+				if (vertexOk)
+				{
+					pool.Vertices.Free(vertexOffset, vertexCount);
+				}
+
+				bool fitsAfterCompaction = pool.Vertices.GetFreeTotal() >= vertexCount && pool.Indices.GetFreeTotal() >= indexCount;
+				if (attempt == 0 && fitsAfterCompaction)
+				{
+					Reallocate(poolIndex, pool.Vertices.GetCapacity(), pool.Indices.GetCapacity(), true);
+					continue;
+				}
+
+				uint32_t vertexCapacity = pool.Vertices.GetCapacity();
+				uint32_t indexCapacity = pool.Indices.GetCapacity();
+				while (vertexCapacity - (pool.Vertices.GetCapacity() - pool.Vertices.GetFreeTotal()) < vertexCount)
+				{
+					vertexCapacity *= 2;
+				}
+				while (indexCapacity - (pool.Indices.GetCapacity() - pool.Indices.GetFreeTotal()) < indexCount)
+				{
+					indexCapacity *= 2;
+				}
+
+				Reallocate(poolIndex, vertexCapacity, indexCapacity, true);
+			}
+
+			return false;
+		}
+	}
+
+	GeometryHandle GeometryArena::Allocate(const VertexLayout& layout, const void* vertexData, uint32_t vertexCount,
+		const uint32_t* indices, uint32_t indexCount)
+	{
+		GeometryHandle handle;
+
+		if (vertexCount == 0 || indexCount == 0)
+		{
+			Logger::Log(LogLevel::Warning, "GeometryArena::Allocate called with empty geometry.");
+			return handle;
+		}
+
+		uint32_t poolIndex = FindOrCreatePool(layout);
+		uint32_t baseVertex = 0, firstIndex = 0;
+
+		if (!Reserve(poolIndex, vertexCount, indexCount, baseVertex, firstIndex))
+		{
+			Logger::Log(LogLevel::Error, "GeometryArena::Allocate failed to reserve " + std::to_string(vertexCount) + " vertices.");
+			return handle;
+		}
+
+		Pool& pool = s_Pools[poolIndex];
+		const uint32_t stride = layout.GetStride();
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, pool.VBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(baseVertex) * stride,
+			static_cast<GLsizeiptr>(vertexCount) * stride, vertexData);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, pool.EBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(firstIndex) * sizeof(uint32_t),
+			static_cast<GLsizeiptr>(indexCount) * sizeof(uint32_t), indices);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+		if (!s_FreeSlots.empty())
+		{
+			handle.Index = s_FreeSlots.back();
+			s_FreeSlots.pop_back();
+		}
+		else
+		{
+			handle.Index = static_cast<uint32_t>(s_Slots.size());
+			s_Slots.emplace_back();
+		}
+
+		Slot& slot = s_Slots[handle.Index];
+		slot.Live = true;
+		slot.Range = { poolIndex, baseVertex, vertexCount, firstIndex, indexCount };
+
+		return handle;
+	}
+
+	void GeometryArena::Free(GeometryHandle handle)
+	{
+		if (!handle.IsValid() || handle.Index >= s_Slots.size() || !s_Slots[handle.Index].Live)
+		{
+			return;
+		}
+
+		Slot& slot = s_Slots[handle.Index];
+		Pool& pool = s_Pools[slot.Range.Pool];
+		pool.Vertices.Free(slot.Range.BaseVertex, slot.Range.VertexCount);
+		pool.Indices.Free(slot.Range.FirstIndex, slot.Range.IndexCount);
+
+		slot.Live = false;
+		s_FreeSlots.push_back(handle.Index);
+	}
+
+	const GeometryRange& GeometryArena::GetRange(GeometryHandle handle)
+	{
+		if (!handle.IsValid() || handle.Index >= s_Slots.size())
+		{
+			return s_EmptyRange;
+		}
+
+		return s_Slots[handle.Index].Range;
+	}
+
+	unsigned int GeometryArena::GetVertexArray(GeometryHandle handle)
+	{
+		if (!handle.IsValid() || handle.Index >= s_Slots.size())
+		{
+			return 0;
+		}
+
+		return GetPoolVertexArray(s_Slots[handle.Index].Range.Pool);
+	}
+
+	unsigned int GeometryArena::GetPoolVertexArray(uint32_t pool)
+	{
+		return pool < s_Pools.size() ? s_Pools[pool].VAO : 0;
+	}
+
+	void GeometryArena::Defragment()
+	{
+		for (uint32_t i = 0; i < s_Pools.size(); ++i)
+		{
+			Reallocate(i, s_Pools[i].Vertices.GetCapacity(), s_Pools[i].Indices.GetCapacity(), true);
+		}
+	}
+
+	void GeometryArena::Shutdown()
+	{
+		for (auto& pool : s_Pools)
+		{
+			glDeleteVertexArrays(1, &pool.VAO);
+			glDeleteBuffers(1, &pool.VBO);
+			glDeleteBuffers(1, &pool.EBO);
+		}
+
+		s_Pools.clear();
+		s_Slots.clear();
+		s_FreeSlots.clear();
+	}
+
+	GeometryArenaStats GeometryArena::GetStats()
+	{
+		GeometryArenaStats stats;
+		stats.PoolCount = static_cast<uint32_t>(s_Pools.size());
+
+		for (const auto& pool : s_Pools)
+		{
+			const size_t stride = pool.Layout.GetStride();
+			stats.VertexBytesReserved += pool.Vertices.GetCapacity() * stride;
+			stats.VertexBytesUsed += (pool.Vertices.GetCapacity() - pool.Vertices.GetFreeTotal()) * stride;
+			stats.IndexBytesReserved += pool.Indices.GetCapacity() * sizeof(uint32_t);
+			stats.IndexBytesUsed += (pool.Indices.GetCapacity() - pool.Indices.GetFreeTotal()) * sizeof(uint32_t);
+		}
+
+		return stats;
+	}
+}
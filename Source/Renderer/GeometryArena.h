@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef GEOMETRY_ARENA_H
+#define GEOMETRY_ARENA_H
+
+#include <cstdint>
+#include <cstddef>
+#include "VertexLayout.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	// Stable handle into the arena. Offsets behind it may move on defragmentation.
+	struct GeometryHandle
+	{
+		uint32_t Index = UINT32_MAX;
+
+		bool IsValid() const { return Index != UINT32_MAX; }
+	};
+
+	// Where a mesh lives inside its pool, in elements rather than bytes.
+	// Indices are stored mesh-local, so draws pass BaseVertex instead of rewriting them.
+	struct GeometryRange
+	{
+		uint32_t Pool = 0;
+		uint32_t BaseVertex = 0;
+		uint32_t VertexCount = 0;
+		uint32_t FirstIndex = 0;
+		uint32_t IndexCount = 0;
+	};
+
+	struct GeometryArenaStats
+	{
+		uint32_t PoolCount = 0;
+		size_t VertexBytesUsed = 0;
+		size_t VertexBytesReserved = 0;
+		size_t IndexBytesUsed = 0;
+		size_t IndexBytesReserved = 0;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// One large vertex buffer and one index buffer per vertex layout, sub-allocated between meshes.
+	// Every mesh in a pool shares the pool's VAO, so a whole pool can be drawn with glMultiDrawElementsIndirect.
+	class ORCA_API GeometryArena
+	{
+	public:
+		static GeometryHandle Allocate(const VertexLayout& layout, const void* vertexData, uint32_t vertexCount,
+			const uint32_t* indices, uint32_t indexCount);
+		static void Free(GeometryHandle handle);
+
+		static const GeometryRange& GetRange(GeometryHandle handle);
+		static unsigned int GetVertexArray(GeometryHandle handle);
+		static unsigned int GetPoolVertexArray(uint32_t pool);
+
+		// Compacts live allocations to the front of each pool's buffers.
+		static void Defragment();
+		static void Shutdown();
+
+		static GeometryArenaStats GetStats();
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -1,26 +1,32 @@
 #include "Mesh.h"
 #include <GL/glew.h>
 #include <Core/Logger.h>
+#include <algorithm>
+#include <limits>
 
 namespace Orca 
 {
     Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
-        : m_Vertices(vertices), m_Indices(indices), m_VAO(0), m_VBO(0), m_EBO(0) 
+        : m_Vertices(vertices), m_Indices(indices)
+    {
+        SetupMesh();
+    }
+
+    Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const VertexCompressionSettings& compression)
+        : m_Vertices(vertices), m_Indices(indices), m_Layout(VertexLayout::FromCompression(compression))
     {
         SetupMesh();
     }
 
     Mesh::Mesh(const std::string& name)
-        : m_VAO(0), m_VBO(0), m_EBO(0), name(name)
+        : name(name)
     {
         // SetupMesh();
     }
 
     Mesh::~Mesh() 
     {
-        glDeleteVertexArrays(1, &m_VAO);
-        glDeleteBuffers(1, &m_VBO);
-        glDeleteBuffers(1, &m_EBO);
+        GeometryArena::Free(m_Geometry);
     }
 
     void Mesh::SetupMesh() 
@@ -38,35 +44,34 @@ namespace Orca
             return;
         }
 
-        glGenVertexArrays(1, &m_VAO);
-        glGenBuffers(1, &m_VBO);
-        glGenBuffers(1, &m_EBO);
-
-        glBindVertexArray(m_VAO);
-
-        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-        glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(Vertex), &m_Vertices[0], GL_STATIC_DRAW);
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_Indices.size() * sizeof(unsigned int), &m_Indices[0], GL_STATIC_DRAW);
-
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+        // The mesh becomes a range inside the shared arena pool for its vertex layout.
+        if (m_Layout == VertexLayout::Standard())
+        {
+            m_Geometry = GeometryArena::Allocate(m_Layout, m_Vertices.data(), static_cast<uint32_t>(m_Vertices.size()),
+                m_Indices.data(), static_cast<uint32_t>(m_Indices.size()));
+        }
+        else
+        {
+            m_Dequantization = VertexCompression::ComputeDequantization(GetBounds(), m_Layout);
 
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+            std::vector<uint8_t> packed;
+            VertexCompression::Encode(m_Vertices, m_Layout, m_Dequantization, packed);
+            m_Geometry = GeometryArena::Allocate(m_Layout, packed.data(), static_cast<uint32_t>(m_Vertices.size()),
+                m_Indices.data(), static_cast<uint32_t>(m_Indices.size()));
+        }
 
-        glBindVertexArray(0);
+        if (!m_Geometry.IsValid())
+        {
+            Logger::Log(LogLevel::Error, "Mesh setup failed: '" + name + "' could not be placed in the geometry arena.");
+            return;
+        }
 
         m_Initialized = true;
     }
 
     void Mesh::Bind() const 
     {
-        glBindVertexArray(m_VAO);
+        glBindVertexArray(GeometryArena::GetVertexArray(m_Geometry));
     }
 
     void Mesh::Unbind() const 
@@ -74,7 +79,8 @@ namespace Orca
         glBindVertexArray(0);
     }
 
-    std::shared_ptr<Mesh> Mesh::Create(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+    std::shared_ptr<Mesh> Mesh::Create(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+        const VertexCompressionSettings& compression)
     {
         if (indices.empty())
         {
@@ -84,7 +90,7 @@ namespace Orca
 
         try 
         {
-            return std::make_shared<Mesh>(vertices, indices);
+            return std::make_shared<Mesh>(vertices, indices, compression);
         }
         catch (const std::exception& e) 
         {
@@ -95,15 +101,18 @@ namespace Orca
 
     void Mesh::Draw() const 
     {
-        if (!m_Initialized || !m_VAO || !m_VBO || m_Indices.empty()) 
+        if (!IsRenderable()) 
         {
             Logger::Log(LogLevel::Warning, "Draw skipped: mesh not initialized or missing data.");
             return;
         }
 
-        glBindVertexArray(m_VAO);
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(m_Indices.size()), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        const GeometryRange& range = GetGeometryRange();
+
+        Bind();
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.IndexCount), GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(static_cast<uintptr_t>(range.FirstIndex) * sizeof(uint32_t)), static_cast<GLint>(range.BaseVertex));
+        Unbind();
     }
 
     const Bounds& Mesh::GetBounds() const 
@@ -131,6 +140,37 @@ namespace Orca
         return bounds;
     }
 
+    void Mesh::AddLod(std::shared_ptr<Mesh> lod, float screenSize)
+    {
+        if (!lod || lod.get() == this)
+        {
+            Logger::Log(LogLevel::Warning, "AddLod ignored: '" + name + "' was given an invalid LOD mesh.");
+            return;
+        }
+
+        m_Lods.push_back({ std::move(lod), screenSize });
+    }
+
+    const Mesh* Mesh::GetLod(uint32_t level) const
+    {
+        if (level == 0 || m_Lods.empty())
+        {
+            return this;
+        }
+
+        return m_Lods[std::min<size_t>(level, m_Lods.size()) - 1].Geometry.get();
+    }
+
+    float Mesh::GetLodScreenSize(uint32_t level) const
+    {
+        if (level == 0 || m_Lods.empty())
+        {
+            return std::numeric_limits<float>::max();
+        }
+
+        return m_Lods[std::min<size_t>(level, m_Lods.size()) - 1].ScreenSize;
+    }
+
     void Mesh::SetName(std::string name)
     {
         this->name = name;
@@ -138,6 +178,6 @@ namespace Orca
 
     bool Mesh::IsRenderable() const
     { 
-        return m_Initialized && m_VAO && m_VBO && !m_Indices.empty();
+        return m_Initialized && m_Geometry.IsValid() && !m_Indices.empty();
     }
 }
\ No newline at end of file
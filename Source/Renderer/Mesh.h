@@ -13,20 +13,39 @@
 #include "../Math/Bounds.h"
 #include "../OrcaAPI.h"
 #include "Vertex.h"
+#include "VertexLayout.h"
+#include "VertexCompression.h"
+#include "GeometryArena.h"
 
 namespace Orca
 {
 #pragma warning(push)
 #pragma warning(disable: 4251)
 
+	class Mesh;
+
+	// A reduced-detail version of a mesh, used once the mesh covers less than
+	// ScreenSize of the viewport height.
+	struct MeshLod
+	{
+		std::shared_ptr<Mesh> Geometry;
+		float ScreenSize = 0.0f;
+	};
+
 	class ORCA_API Mesh
 	{
 	public:
 		Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+		Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const VertexCompressionSettings& compression);
 		Mesh(const std::string& name);
 		~Mesh();
 
-		static std::shared_ptr<Mesh> Create(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+		// A mesh owns an arena allocation; copies would free it twice.
+		Mesh(const Mesh&) = delete;
+		Mesh& operator=(const Mesh&) = delete;
+
+		static std::shared_ptr<Mesh> Create(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+			const VertexCompressionSettings& compression = VertexCompressionSettings::None());
 
 		void Bind() const;
 		void Unbind() const;
@@ -50,12 +69,32 @@ namespace Orca
 
 		void AddIndex(unsigned int index) { m_Indices.push_back(index); }
 		unsigned int GetVertexCount() const { return static_cast<unsigned int>(m_Vertices.size()); }
+		unsigned int GetIndexCount() const { return static_cast<unsigned int>(m_Indices.size()); }
+		const std::vector<Vertex>& GetVertices() const { return m_Vertices; }
+		const std::vector<unsigned int>& GetIndices() const { return m_Indices; }
+		unsigned int GetVAO() const { return GeometryArena::GetVertexArray(m_Geometry); }
+		GeometryHandle GetGeometry() const { return m_Geometry; }
+		const GeometryRange& GetGeometryRange() const { return GeometryArena::GetRange(m_Geometry); }
+
+		// Level 0 is this mesh; coarser levels must be added in order of decreasing ScreenSize.
+		void AddLod(std::shared_ptr<Mesh> lod, float screenSize);
+		uint32_t GetLodCount() const { return static_cast<uint32_t>(m_Lods.size()) + 1; }
+		const Mesh* GetLod(uint32_t level) const;
+		float GetLodScreenSize(uint32_t level) const;
+
+		const VertexLayout& GetLayout() const { return m_Layout; }
+		const VertexDequantization& GetDequantization() const { return m_Dequantization; }
+		size_t GetVertexBufferSize() const { return static_cast<size_t>(m_Layout.GetStride()) * m_Vertices.size(); }
 
 	private:
-		unsigned int m_VAO, m_VBO, m_EBO;
+		GeometryHandle m_Geometry;
 		std::vector<Vertex> m_Vertices;
 		std::vector<unsigned int> m_Indices;
 		std::string name;
+		std::vector<MeshLod> m_Lods;
+
+		VertexLayout m_Layout = VertexLayout::Standard();
+		VertexDequantization m_Dequantization;
 
 		mutable Bounds bounds;
 		mutable bool m_BoundsDirty = true;
@@ -0,0 +1,10 @@
+#include "NullCommandExecutor.h"
+
+namespace Orca
+{
+	void NullCommandExecutor::Execute(const CommandList& list, const FrameConstants&)
+	{
+		m_Stats = {};
+		m_Stats.DrawCalls = static_cast<uint32_t>(list.GetSize());
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#ifndef NULL_COMMAND_EXECUTOR_H
+#define NULL_COMMAND_EXECUTOR_H
+
+#include "CommandExecutor.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	// Drops every command list, so a frame costs only what it takes to build the list. DrawCalls
+	// counts the packets received; the other stats stay zero. Needs no graphics context.
+	class ORCA_API NullCommandExecutor : public CommandExecutor
+	{
+	public:
+		void Execute(const CommandList& list, const FrameConstants& frame) override;
+	};
+}
+
+#endif
@@ -0,0 +1,436 @@
+#include "OcclusionCuller.h"
+#include "Mesh.h"
+#include "../Core/JobSystem.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint32_t k_TileWidth = 64;
+		constexpr uint32_t k_TileHeight = 32;
+
+		// Vertices closer than this in clip-space w are treated as crossing the near plane.
+		constexpr float k_MinW = 1e-4f;
+
+		inline glm::vec4 TransformPoint(__m128 c0, __m128 c1, __m128 c2, __m128 c3, const glm::vec3& p)
+		{
+			__m128 r = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p.x)), _mm_mul_ps(c1, _mm_set1_ps(p.y))),
+				_mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p.z)), c3));
+
+			alignas(16) float out[4];
+			_mm_store_ps(out, r);
+			return glm::vec4(out[0], out[1], out[2], out[3]);
+		}
+	}
+
+	OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+		: m_Width(std::max(k_TileWidth, width / k_TileWidth * k_TileWidth)),
+		m_Height(std::max(k_TileHeight, height / k_TileHeight * k_TileHeight))
+	{
+		m_TilesX = m_Width / k_TileWidth;
+		m_TilesY = m_Height / k_TileHeight;
+		m_TileBins.resize(m_TilesX * m_TilesY);
+
+		uint32_t levelWidth = m_Width;
+		uint32_t levelHeight = m_Height;
+		while (true)
+		{
+			DepthLevel level;
+			level.Width = levelWidth;
+			level.Height = levelHeight;
+			level.Max.assign(levelWidth * levelHeight, 1.0f);
+
+			// Level 0 holds a single depth per pixel, so its minimum is its maximum.
+			if (!m_Levels.empty())
+			{
+				level.Min.assign(levelWidth * levelHeight, 1.0f);
+			}
+
+			m_Levels.push_back(std::move(level));
+
+			if (levelWidth == 1 && levelHeight == 1)
+			{
+				break;
+			}
+
+			levelWidth = std::max(1u, (levelWidth + 1) / 2);
+			levelHeight = std::max(1u, (levelHeight + 1) / 2);
+		}
+	}
+
+	void OcclusionCuller::BeginFrame(const glm::mat4& viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		m_Triangles.clear();
+
+		for (auto& bin : m_TileBins)
+		{
+			bin.clear();
+		}
+
+		std::fill(m_Levels[0].Max.begin(), m_Levels[0].Max.end(), 1.0f);
+
+		m_TestedObjects = 0;
+		m_CulledObjects = 0;
+	}
+
+	void OcclusionCuller::AddOccluder(const Mesh& mesh, const glm::mat4& model)
+	{
+		// The coarsest LOD is plenty for a low-resolution depth buffer.
+		const Mesh* source = mesh.GetLod(mesh.GetLodCount() - 1);
+		AddOccluder(source->GetVertices(), source->GetIndices(), model);
+	}
+
+	void OcclusionCuller::AddOccluder(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const glm::mat4& model)
+	{
+		const glm::mat4 mvp = m_ViewProjection * model;
+		const __m128 c0 = _mm_loadu_ps(&mvp[0][0]);
+		const __m128 c1 = _mm_loadu_ps(&mvp[1][0]);
+		const __m128 c2 = _mm_loadu_ps(&mvp[2][0]);
+		const __m128 c3 = _mm_loadu_ps(&mvp[3][0]);
+
+		std::vector<glm::vec4> screen(vertices.size());
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			glm::vec4 clip = TransformPoint(c0, c1, c2, c3, vertices[i].Position);
+			if (clip.w <= k_MinW)
+			{
+				screen[i] = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+				continue;
+			}
+
+			float invW = 1.0f / clip.w;
+			screen[i] = glm::vec4(
+				(clip.x * invW * 0.5f + 0.5f) * m_Width,
+				(clip.y * invW * 0.5f + 0.5f) * m_Height,
+				std::clamp(clip.z * invW * 0.5f + 0.5f, 0.0f, 1.0f),
+				1.0f);
+		}
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const glm::vec4& a = screen[indices[i]];
+			const glm::vec4& b = screen[indices[i + 1]];
+			const glm::vec4& c = screen[indices[i + 2]];
+
+			if (a.w < 0.0f || b.w < 0.0f || c.w < 0.0f)
+			{
+				continue;
+			}
+
+			float minX = std::min({ a.x, b.x, c.x });
+			float maxX = std::max({ a.x, b.x, c.x });
+			float minY = std::min({ a.y, b.y, c.y });
+			float maxY = std::max({ a.y, b.y, c.y });
+
+			if (maxX < 0.0f || maxY < 0.0f || minX >= m_Width || minY >= m_Height)
+			{
+				continue;
+			}
+
+			const uint32_t triangle = static_cast<uint32_t>(m_Triangles.size());
+			m_Triangles.push_back({ { glm::vec3(a), glm::vec3(b), glm::vec3(c) } });
+
+			uint32_t tileMinX = static_cast<uint32_t>(std::max(0.0f, minX)) / k_TileWidth;
+			uint32_t tileMaxX = std::min(static_cast<uint32_t>(std::min(maxX, static_cast<float>(m_Width - 1))) / k_TileWidth, m_TilesX - 1);
+			uint32_t tileMinY = static_cast<uint32_t>(std::max(0.0f, minY)) / k_TileHeight;
+			uint32_t tileMaxY = std::min(static_cast<uint32_t>(std::min(maxY, static_cast<float>(m_Height - 1))) / k_TileHeight, m_TilesY - 1);
+
+			for (uint32_t ty = tileMinY; ty <= tileMaxY; ++ty)
+			{
+				for (uint32_t tx = tileMinX; tx <= tileMaxX; ++tx)
+				{
+					m_TileBins[ty * m_TilesX + tx].push_back(triangle);
+				}
+			}
+		}
+	}
+
+	void OcclusionCuller::Rasterize()
+	{
+		if (m_Triangles.empty())
+		{
+			return;
+		}
+
+		const uint32_t tileCount = m_TilesX * m_TilesY;
+
+		// Tiles own disjoint pixel ranges, so they rasterize without synchronization.
+		if (JobSystem::IsInitialized())
+		{
+			JobSystem::Dispatch(tileCount, [this](unsigned int tile) { RasterizeTile(tile); });
+		}
+		else
+		{
+			for (uint32_t tile = 0; tile < tileCount; ++tile)
+			{
+				RasterizeTile(tile);
+			}
+		}
+
+		BuildPyramid();
+	}
+
+	void OcclusionCuller::RasterizeTile(uint32_t tile)
+	{
+		const int tileX0 = static_cast<int>((tile % m_TilesX) * k_TileWidth);
+		const int tileY0 = static_cast<int>((tile / m_TilesX) * k_TileHeight);
+		const int tileX1 = tileX0 + static_cast<int>(k_TileWidth) - 1;
+		const int tileY1 = tileY0 + static_cast<int>(k_TileHeight) - 1;
+
+		float* depth = m_Levels[0].Max.data();
+		const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+		const __m128 zero = _mm_setzero_ps();
+
+		for (uint32_t index : m_TileBins[tile])
+		{
+			glm::vec3 v0 = m_Triangles[index].Vertices[0];
+			glm::vec3 v1 = m_Triangles[index].Vertices[1];
+			glm::vec3 v2 = m_Triangles[index].Vertices[2];
+
+			// Occluders are rasterized double-sided; wind every triangle the same way.
+			float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+			if (area < 0.0f)
+			{
+				std::swap(v1, v2);
+				area = -area;
+			}
+
+			if (area <= 1e-8f)
+			{
+				continue;
+			}
+
+			int minX = std::max(tileX0, static_cast<int>(std::floor(std::min({ v0.x, v1.x, v2.x }))));
+			int maxX = std::min(tileX1, static_cast<int>(std::ceil(std::max({ v0.x, v1.x, v2.x }))));
+			int minY = std::max(tileY0, static_cast<int>(std::floor(std::min({ v0.y, v1.y, v2.y }))));
+			int maxY = std::min(tileY1, static_cast<int>(std::ceil(std::max({ v0.y, v1.y, v2.y }))));
+
+			if (minX > maxX || minY > maxY)
+			{
+				continue;
+			}
+
+			// Four pixels per step; tiles are a multiple of four wide so a step never leaves the tile.
+			minX &= ~3;
+
+			// Edge functions E(x, y) = A * x + B * y + C, non-negative inside.
+			const glm::vec3 edges[3][2] = { { v1, v2 }, { v2, v0 }, { v0, v1 } };
+			float A[3], B[3], C[3];
+			for (int e = 0; e < 3; ++e)
+			{
+				const glm::vec3& p = edges[e][0];
+				const glm::vec3& q = edges[e][1];
+				A[e] = -(q.y - p.y);
+				B[e] = q.x - p.x;
+				C[e] = (q.y - p.y) * p.x - (q.x - p.x) * p.y;
+			}
+
+			// Depth is affine in screen space after the perspective divide.
+			const float dzdx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+			const float dzdy = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+			const float dzc = v0.z - dzdx * v0.x - dzdy * v0.y;
+
+			const __m128 a0 = _mm_set1_ps(A[0]), a1 = _mm_set1_ps(A[1]), a2 = _mm_set1_ps(A[2]);
+			const __m128 zx = _mm_set1_ps(dzdx);
+
+			for (int y = minY; y <= maxY; ++y)
+			{
+				const float py = y + 0.5f;
+				const __m128 row0 = _mm_set1_ps(B[0] * py + C[0]);
+				const __m128 row1 = _mm_set1_ps(B[1] * py + C[1]);
+				const __m128 row2 = _mm_set1_ps(B[2] * py + C[2]);
+				const __m128 rowZ = _mm_set1_ps(dzdy * py + dzc);
+
+				float* rowDepth = depth + static_cast<size_t>(y) * m_Width;
+
+				for (int x = minX; x <= maxX; x += 4)
+				{
+					const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+
+					__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), row0), zero);
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), row1), zero));
+					inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), row2), zero));
+
+					if (_mm_movemask_ps(inside) == 0)
+					{
+						continue;
+					}
+
+					const __m128 z = _mm_add_ps(_mm_mul_ps(zx, px), rowZ);
+					const __m128 previous = _mm_loadu_ps(rowDepth + x);
+					const __m128 closest = _mm_min_ps(previous, z);
+					_mm_storeu_ps(rowDepth + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, previous)));
+				}
+			}
+		}
+	}
+
+	void OcclusionCuller::BuildPyramid()
+	{
+		for (size_t l = 1; l < m_Levels.size(); ++l)
+		{
+			const DepthLevel& source = m_Levels[l - 1];
+			DepthLevel& target = m_Levels[l];
+			const std::vector<float>& sourceMin = l == 1 ? source.Max : source.Min;
+
+			for (uint32_t y = 0; y < target.Height; ++y)
+			{
+				const uint32_t sy0 = std::min(y * 2, source.Height - 1);
+				const uint32_t sy1 = std::min(y * 2 + 1, source.Height - 1);
+
+				for (uint32_t x = 0; x < target.Width; ++x)
+				{
+					const uint32_t sx0 = std::min(x * 2, source.Width - 1);
+					const uint32_t sx1 = std::min(x * 2 + 1, source.Width - 1);
+
+					const uint32_t i00 = sy0 * source.Width + sx0;
+					const uint32_t i01 = sy0 * source.Width + sx1;
+					const uint32_t i10 = sy1 * source.Width + sx0;
+					const uint32_t i11 = sy1 * source.Width + sx1;
+
+					target.Min[y * target.Width + x] = std::min({ sourceMin[i00], sourceMin[i01], sourceMin[i10], sourceMin[i11] });
+					target.Max[y * target.Width + x] = std::max({ source.Max[i00], source.Max[i01], source.Max[i10], source.Max[i11] });
+				}
+			}
+		}
+	}
+
+	bool OcclusionCuller::IsVisible(const Bounds& localBounds, const glm::mat4& model) const
+	{
+		if (m_Triangles.empty())
+		{
+			return true;
+		}
+
+		m_TestedObjects++;
+
+		const glm::mat4 mvp = m_ViewProjection * model;
+		const __m128 c0 = _mm_loadu_ps(&mvp[0][0]);
+		const __m128 c1 = _mm_loadu_ps(&mvp[1][0]);
+		const __m128 c2 = _mm_loadu_ps(&mvp[2][0]);
+		const __m128 c3 = _mm_loadu_ps(&mvp[3][0]);
+
+		const glm::vec3& bmin = localBounds.GetMin();
+		const glm::vec3& bmax = localBounds.GetMax();
+
+		float minX = std::numeric_limits<float>::max();
+		float minY = std::numeric_limits<float>::max();
+		float maxX = std::numeric_limits<float>::lowest();
+		float maxY = std::numeric_limits<float>::lowest();
+		float nearest = 1.0f;
+
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			glm::vec3 p((corner & 1) ? bmax.x : bmin.x, (corner & 2) ? bmax.y : bmin.y, (corner & 4) ? bmax.z : bmin.z);
+			glm::vec4 clip = TransformPoint(c0, c1, c2, c3, p);
+
+			// Boxes reaching the near plane cannot be hidden by anything in front of them.
+			if (clip.w <= k_MinW)
+			{
+				return true;
+			}
+
+			float invW = 1.0f / clip.w;
+			float sx = (clip.x * invW * 0.5f + 0.5f) * m_Width;
+			float sy = (clip.y * invW * 0.5f + 0.5f) * m_Height;
+
+			minX = std::min(minX, sx);
+			maxX = std::max(maxX, sx);
+			minY = std::min(minY, sy);
+			maxY = std::max(maxY, sy);
+			nearest = std::min(nearest, clip.z * invW * 0.5f + 0.5f);
+		}
+
+		if (maxX < 0.0f || maxY < 0.0f || minX >= m_Width || minY >= m_Height)
+		{
+			return true;
+		}
+
+		int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+		int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+		int x1 = std::min(static_cast<int>(m_Width) - 1, static_cast<int>(std::floor(maxX)));
+		int y1 = std::min(static_cast<int>(m_Height) - 1, static_cast<int>(std::floor(maxY)));
+
+		// Start at the level where the box spans at most 2x2 texels, then refine only where needed.
+		uint32_t level = 0;
+		while (level + 1 < m_Levels.size() && (((x1 >> level) - (x0 >> level)) > 1 || ((y1 >> level) - (y0 >> level)) > 1))
+		{
+			level++;
+		}
+
+		for (int ty = y0 >> level; ty <= (y1 >> level); ++ty)
+		{
+			for (int tx = x0 >> level; tx <= (x1 >> level); ++tx)
+			{
+				if (TestRegion(level, tx, ty, x0, y0, x1, y1, std::max(nearest, 0.0f)))
+				{
+					return true;
+				}
+			}
+		}
+
+		m_CulledObjects++;
+		return false;
+	}
+
+	bool OcclusionCuller::TestRegion(uint32_t level, uint32_t x, uint32_t y, int minX, int minY, int maxX, int maxY, float nearest) const
+	{
+		const DepthLevel& depth = m_Levels[level];
+		if (x >= depth.Width || y >= depth.Height)
+		{
+			return false;
+		}
+
+		const uint32_t index = y * depth.Width + x;
+
+		// Every pixel under this texel is closer than the box: hidden here.
+		if (nearest > depth.Max[index])
+		{
+			return false;
+		}
+
+		// Every pixel under this texel is farther than the box: visible, no need to refine.
+		if (level == 0 || nearest <= depth.Min[index])
+		{
+			return true;
+		}
+
+		for (uint32_t cy = y * 2; cy <= y * 2 + 1; ++cy)
+		{
+			for (uint32_t cx = x * 2; cx <= x * 2 + 1; ++cx)
+			{
+				const int childMinX = static_cast<int>(cx << (level - 1));
+				const int childMinY = static_cast<int>(cy << (level - 1));
+				const int childMaxX = childMinX + (1 << (level - 1)) - 1;
+				const int childMaxY = childMinY + (1 << (level - 1)) - 1;
+
+				if (childMaxX < minX || childMinX > maxX || childMaxY < minY || childMinY > maxY)
+				{
+					continue;
+				}
+
+				if (TestRegion(level - 1, cx, cy, minX, minY, maxX, maxY, nearest))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	OcclusionStats OcclusionCuller::GetStats() const
+	{
+		OcclusionStats stats;
+		stats.OccluderTriangles = static_cast<uint32_t>(m_Triangles.size());
+		stats.TestedObjects = m_TestedObjects.load();
+		stats.CulledObjects = m_CulledObjects.load();
+		return stats;
+	}
+}
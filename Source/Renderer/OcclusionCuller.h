@@ -0,0 +1,95 @@
+#pragma once
+
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "Vertex.h"
+#include "../Math/Bounds.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	class Mesh;
+
+	struct OcclusionStats
+	{
+		uint32_t OccluderTriangles = 0;
+		uint32_t TestedObjects = 0;
+		uint32_t CulledObjects = 0;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Software occlusion culling on the CPU. Occluders are rasterized into a small depth buffer
+	// with SSE, one tile per job, and a min/max depth pyramid is built over the result. Occludee
+	// bounds are then tested against the pyramid without any GPU readback.
+	// Depth is NDC z remapped to [0, 1], smaller is closer. Nothing here touches GL.
+	class ORCA_API OcclusionCuller
+	{
+	public:
+		// Width must be a multiple of the tile width (64) and height of the tile height (32).
+		explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+		void BeginFrame(const glm::mat4& viewProjection);
+
+		// Triangles crossing the near plane are dropped; skipping occluder area is always safe.
+		void AddOccluder(const Mesh& mesh, const glm::mat4& model);
+		void AddOccluder(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, const glm::mat4& model);
+
+		// Rasterizes everything added since BeginFrame and builds the depth pyramid.
+		void Rasterize();
+
+		// Conservative: returns false only if the box is fully behind rasterized occluders.
+		// Safe to call from several threads once Rasterize() has returned.
+		bool IsVisible(const Bounds& localBounds, const glm::mat4& model) const;
+
+		bool HasOccluders() const { return !m_Triangles.empty(); }
+
+		uint32_t GetWidth() const { return m_Width; }
+		uint32_t GetHeight() const { return m_Height; }
+		const std::vector<float>& GetDepthBuffer() const { return m_Levels[0].Max; }
+
+		OcclusionStats GetStats() const;
+
+	private:
+		struct ScreenTriangle
+		{
+			glm::vec3 Vertices[3];	// Pixel x, pixel y, depth
+		};
+
+		// Level 0 is the full-resolution buffer; each level above halves both dimensions.
+		struct DepthLevel
+		{
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+			std::vector<float> Min;
+			std::vector<float> Max;
+		};
+
+		uint32_t m_Width;
+		uint32_t m_Height;
+		uint32_t m_TilesX;
+		uint32_t m_TilesY;
+
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+
+		std::vector<ScreenTriangle> m_Triangles;
+		std::vector<std::vector<uint32_t>> m_TileBins;
+		std::vector<DepthLevel> m_Levels;
+
+		mutable std::atomic<uint32_t> m_TestedObjects{ 0 };
+		mutable std::atomic<uint32_t> m_CulledObjects{ 0 };
+
+		void RasterizeTile(uint32_t tile);
+		void BuildPyramid();
+		bool TestRegion(uint32_t level, uint32_t x, uint32_t y, int minX, int minY, int maxX, int maxY, float nearest) const;
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -0,0 +1,232 @@
+#include "ProgramBinaryCache.h"
+#include "../Core/Logger.h"
+#include <GL/glew.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace fs = std::filesystem;
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint32_t k_Magic = 0x4342504F;	// "OPBC"
+		constexpr uint32_t k_FormatVersion = 1;
+
+		struct EntryHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t Key;
+			uint32_t BinaryFormat;
+			uint32_t Length;
+		};
+
+		uint64_t HashString(uint64_t hash, const std::string& value)
+		{
+			for (unsigned char c : value)
+			{
+				hash ^= c;
+				hash *= 1099511628211ull;
+			}
+
+			// Terminate each field so ("ab", "c") and ("a", "bc") differ.
+			hash ^= 0xFF;
+			hash *= 1099511628211ull;
+			return hash;
+		}
+
+		std::string GetString(GLenum name)
+		{
+			const GLubyte* value = glGetString(name);
+			return value ? reinterpret_cast<const char*>(value) : "";
+		}
+	}
+
+	std::mutex ProgramBinaryCache::s_Mutex;
+	std::string ProgramBinaryCache::s_Directory;
+	std::string ProgramBinaryCache::s_DriverId;
+	bool ProgramBinaryCache::s_Enabled = false;
+
+	void ProgramBinaryCache::Initialize(const std::string& directory)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		s_Enabled = false;
+		s_Directory = directory;
+		s_DriverId = GetString(GL_VENDOR) + "|" + GetString(GL_RENDERER) + "|" + GetString(GL_VERSION);
+
+		if (directory.empty())
+		{
+			return;
+		}
+
+		if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary)
+		{
+			Logger::Log(LogLevel::Info, "Program binaries are not supported by this driver, shaders will always compile from source.");
+			return;
+		}
+
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		if (formatCount <= 0)
+		{
+			Logger::Log(LogLevel::Info, "Driver exposes no program binary formats, shaders will always compile from source.");
+			return;
+		}
+
+		std::error_code error;
+		fs::create_directories(directory, error);
+		if (error)
+		{
+			Logger::Log(LogLevel::Warning, "Can't create program binary cache directory " + directory + ": " + error.message());
+			return;
+		}
+
+		s_Enabled = true;
+	}
+
+	bool ProgramBinaryCache::IsEnabled()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return s_Enabled;
+	}
+
+	uint64_t ProgramBinaryCache::MakeKey(const std::string& vertexSource, const std::string& fragmentSource, const std::vector<std::string>& defines)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		uint64_t hash = 14695981039346656037ull;
+		hash = HashString(hash, s_DriverId);
+		hash = HashString(hash, vertexSource);
+		hash = HashString(hash, fragmentSource);
+		for (const std::string& define : defines)
+		{
+			hash = HashString(hash, define);
+		}
+		return hash;
+	}
+
+	std::string ProgramBinaryCache::GetEntryPath(uint64_t key)
+	{
+		std::ostringstream name;
+		name << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+		return (fs::path(s_Directory) / name.str()).string();
+	}
+
+	bool ProgramBinaryCache::Load(uint64_t key, unsigned int program)
+	{
+		std::vector<char> binary;
+		EntryHeader header{};
+
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			if (!s_Enabled)
+			{
+				return false;
+			}
+
+			std::ifstream file(GetEntryPath(key), std::ios::binary);
+			if (!file.is_open())
+			{
+				return false;
+			}
+
+			file.read(reinterpret_cast<char*>(&header), sizeof(header));
+			if (!file || header.Magic != k_Magic || header.Version != k_FormatVersion || header.Key != key || header.Length == 0)
+			{
+				return false;
+			}
+
+			binary.resize(header.Length);
+			file.read(binary.data(), header.Length);
+			if (!file)
+			{
+				return false;
+			}
+		}
+
+		glProgramBinary(program, header.BinaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+		GLint success = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (!success)
+		{
+			// Usually a driver update that kept its version string; the rebuilt binary replaces it.
+			Logger::Log(LogLevel::Info, "Cached program binary rejected by the driver, recompiling.");
+			return false;
+		}
+
+		return true;
+	}
+
+	void ProgramBinaryCache::Store(uint64_t key, unsigned int program)
+	{
+		if (!IsEnabled())
+		{
+			return;
+		}
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+		{
+			return;
+		}
+
+		std::vector<char> binary(static_cast<size_t>(length));
+		GLenum format = 0;
+		GLsizei written = 0;
+		glGetProgramBinary(program, length, &written, &format, binary.data());
+		if (written <= 0)
+		{
+			return;
+		}
+
+		EntryHeader header{ k_Magic, k_FormatVersion, key, static_cast<uint32_t>(format), static_cast<uint32_t>(written) };
+
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		// Write beside the entry and rename, so a crash never leaves a truncated binary behind.
+		const std::string path = GetEntryPath(key);
+		const std::string tempPath = path + ".tmp";
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+			{
+				Logger::Log(LogLevel::Warning, "Can't write program binary cache entry: " + tempPath);
+				return;
+			}
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(binary.data(), written);
+		}
+
+		std::error_code error;
+		fs::rename(tempPath, path, error);
+		if (error)
+		{
+			fs::remove(tempPath, error);
+		}
+	}
+
+	void ProgramBinaryCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (s_Directory.empty())
+		{
+			return;
+		}
+
+		std::error_code error;
+		for (const auto& entry : fs::directory_iterator(s_Directory, error))
+		{
+			if (entry.path().extension() == ".bin")
+			{
+				fs::remove(entry.path(), error);
+			}
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#ifndef PROGRAM_BINARY_CACHE_H
+#define PROGRAM_BINARY_CACHE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <mutex>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// On-disk cache of linked program binaries (glGetProgramBinary / glProgramBinary).
+	// Entries are keyed by a hash of the shader sources, the defines and the GL vendor, renderer
+	// and version strings, so a driver update simply misses instead of loading a stale binary.
+	// Drivers may still reject a binary; callers then compile from source and store the result.
+	class ORCA_API ProgramBinaryCache
+	{
+	public:
+		// GL thread only; queries driver strings and format support. An empty directory disables the cache.
+		static void Initialize(const std::string& directory);
+		static bool IsEnabled();
+
+		static uint64_t MakeKey(const std::string& vertexSource, const std::string& fragmentSource, const std::vector<std::string>& defines);
+
+		// Loads the binary into an already created program. Returns false on a miss or when the
+		// driver refuses it, in which case the program must be built from source.
+		static bool Load(uint64_t key, unsigned int program);
+
+		// Call after a successful link. The program should have been linked with
+		// GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+		static void Store(uint64_t key, unsigned int program);
+
+		// Removes every cached binary, e.g. after a shader hot reload went wrong.
+		static void Clear();
+
+	private:
+		static std::mutex s_Mutex;
+		static std::string s_Directory;
+		static std::string s_DriverId;
+		static bool s_Enabled;
+
+		static std::string GetEntryPath(uint64_t key);
+	};
+#pragma warning(pop)
+}
+
+#endif
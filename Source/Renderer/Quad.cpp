@@ -33,8 +33,18 @@ namespace Orca
 
 	Quad::~Quad()
 	{
-		glDeleteVertexArrays(1, &m_VAO);
-		glDeleteBuffers(1, &m_VBO);
+		Release();
+	}
+
+	void Quad::Release()
+	{
+		if (m_VAO != 0)
+		{
+			glDeleteVertexArrays(1, &m_VAO);
+			glDeleteBuffers(1, &m_VBO);
+		}
+		m_VAO = 0;
+		m_VBO = 0;
 	}
 
 	void Quad::Render() const
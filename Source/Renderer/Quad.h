@@ -15,6 +15,11 @@ namespace Orca
 		void Init();
 		void Render() const;
 
+		// GL objects have to go while the context is still alive, not at static destruction.
+		void Release();
+
+		bool IsInitialized() const { return m_VAO != 0; }
+
 	private:
 		GLuint m_VAO = 0;
 		GLuint m_VBO = 0;
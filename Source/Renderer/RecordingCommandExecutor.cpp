@@ -0,0 +1,125 @@
+#include "RecordingCommandExecutor.h"
+#include "Mesh.h"
+#include "ClusteredLighting.h"
+#include "../Material/Material.h"
+#include <algorithm>
+
+namespace Orca
+{
+	void RecordingCommandExecutor::Execute(const CommandList& list, const FrameConstants& frame)
+	{
+		m_Stats = {};
+		m_Recorded.clear();
+		m_UploadedMaterials.clear();
+		m_Frame = frame;
+
+		BuildBatches(list, m_MultiDraw);
+
+		auto recordUpload = [this](uint64_t bytes, const Material* material)
+			{
+				RecordedCommand upload;
+				upload.Type = RecordedCommandType::Upload;
+				upload.MaterialInstance = material;
+				upload.Bytes = bytes;
+				m_Recorded.push_back(upload);
+				m_Stats.UploadBytes += bytes;
+			};
+
+		if (!m_Commands.empty())
+		{
+			recordUpload(GetBatchUploadSize(), nullptr);
+		}
+
+		// GL uploads the light lists in the lighting pass, ahead of the scene.
+		if (frame.Lighting && frame.Lighting->GetUploadSize() > 0)
+		{
+			recordUpload(frame.Lighting->GetUploadSize(), nullptr);
+		}
+
+		const auto& packets = list.GetPackets();
+		const Shader* boundProgram = nullptr;
+		uint32_t boundProgramKey = 0;
+		const Mesh* boundGeometry = nullptr;
+		const Material* boundMaterial = nullptr;
+
+		for (const Batch& batch : m_Batches)
+		{
+			const RenderPacket& first = packets[batch.FirstPacket];
+
+			if (first.Program != boundProgram || first.ProgramKey != boundProgramKey)
+			{
+				boundProgram = first.Program;
+				boundProgramKey = first.ProgramKey;
+				RecordedCommand bind{ RecordedCommandType::BindProgram, boundProgram };
+				bind.ProgramKey = boundProgramKey;
+				m_Recorded.push_back(bind);
+				m_Stats.ProgramBinds++;
+
+				// Mirrors GLCommandExecutor: a new program invalidates the bound material.
+				boundMaterial = nullptr;
+			}
+
+			if (first.MaterialInstance && first.MaterialInstance != boundMaterial)
+			{
+				boundMaterial = first.MaterialInstance;
+
+				// On GL the first bind clears the dirty flag. Recording leaves the material alone, so
+				// later binds in the same list must not count the block again.
+				const uint32_t parameterBytes = boundMaterial->GetParameterUploadSize();
+				if (parameterBytes > 0 && m_UploadedMaterials.insert(boundMaterial).second)
+				{
+					recordUpload(parameterBytes, boundMaterial);
+				}
+
+				RecordedCommand bind{ RecordedCommandType::BindMaterial, boundProgram, boundMaterial };
+				bind.Count = boundMaterial->GetTextureBindCount();
+				bind.ProgramKey = boundProgramKey;
+				m_Recorded.push_back(bind);
+				m_Stats.MaterialBinds++;
+				m_Stats.TextureBinds += bind.Count;
+			}
+
+			if (batch.MultiDraw)
+			{
+				boundGeometry = first.Geometry;
+				m_Recorded.push_back({ RecordedCommandType::BindGeometry, boundProgram, boundMaterial, boundGeometry });
+				m_Stats.GeometryBinds++;
+
+				m_Recorded.push_back({ RecordedCommandType::MultiDraw, boundProgram, boundMaterial, boundGeometry, static_cast<uint32_t>(batch.PacketCount) });
+				m_Stats.MultiDrawCalls++;
+				continue;
+			}
+
+			for (size_t i = batch.FirstPacket; i < batch.FirstPacket + batch.PacketCount; ++i)
+			{
+				const RenderPacket& packet = packets[i];
+
+				if (packet.Geometry != boundGeometry)
+				{
+					boundGeometry = packet.Geometry;
+					m_Recorded.push_back({ RecordedCommandType::BindGeometry, boundProgram, boundMaterial, boundGeometry });
+					m_Stats.GeometryBinds++;
+				}
+
+				RecordedCommand draw{ RecordedCommandType::Draw, boundProgram, boundMaterial, boundGeometry };
+				draw.Count = boundGeometry->GetIndexCount();
+				draw.ConstantsIndex = packet.ConstantsIndex;
+				m_Recorded.push_back(draw);
+				m_Stats.DrawCalls++;
+			}
+		}
+	}
+
+	void RecordingCommandExecutor::Release()
+	{
+		m_Recorded.clear();
+		m_UploadedMaterials.clear();
+		CommandExecutor::Release();
+	}
+
+	size_t RecordingCommandExecutor::CountCommands(RecordedCommandType type) const
+	{
+		return static_cast<size_t>(std::count_if(m_Recorded.begin(), m_Recorded.end(),
+			[type](const RecordedCommand& command) { return command.Type == type; }));
+	}
+}
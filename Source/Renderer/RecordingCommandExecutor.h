@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef RECORDING_COMMAND_EXECUTOR_H
+#define RECORDING_COMMAND_EXECUTOR_H
+
+#include <cstdint>
+#include <vector>
+#include <unordered_set>
+#include "CommandExecutor.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	enum class RecordedCommandType : uint8_t
+	{
+		Upload,			// Multi-draw commands and instance data, the light lists, or a material's parameter block
+		BindProgram,
+		BindMaterial,
+		BindGeometry,
+		Draw,
+		MultiDraw
+	};
+
+	struct RecordedCommand
+	{
+		RecordedCommandType Type = RecordedCommandType::Draw;
+		const Shader* Program = nullptr;			// Null when recorded headless; ProgramKey still tells programs apart
+		const Material* MaterialInstance = nullptr;	// For an Upload, the material whose parameter block it is
+		const Mesh* Geometry = nullptr;
+		uint32_t Count = 0;			// Indices for Draw, draws for MultiDraw, textures for BindMaterial
+		uint64_t Bytes = 0;			// Upload only
+		uint32_t ConstantsIndex = 0;	// Draw only
+		uint32_t ProgramKey = 0;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Walks a command list exactly as GLCommandExecutor would and records every upload, bind and draw
+	// instead of issuing it. Needs no graphics context, so the CPU side of a frame can be measured
+	// and its submission checked on machines without a GPU. The recording covers the last Execute().
+	class ORCA_API RecordingCommandExecutor : public CommandExecutor
+	{
+	public:
+		void Execute(const CommandList& list, const FrameConstants& frame) override;
+		void Release() override;
+
+		// Whether runs sharing a program, material and pool become one multi-draw, as on a GL 4.3
+		// driver. On by default.
+		void SetMultiDraw(bool enabled) { m_MultiDraw = enabled; }
+
+		const std::vector<RecordedCommand>& GetCommands() const { return m_Recorded; }
+		size_t CountCommands(RecordedCommandType type) const;
+
+		const FrameConstants& GetFrame() const { return m_Frame; }
+
+	private:
+		std::vector<RecordedCommand> m_Recorded;
+		std::unordered_set<const Material*> m_UploadedMaterials;	// Parameter blocks counted by this Execute()
+		FrameConstants m_Frame;
+		bool m_MultiDraw = true;
+	};
+#pragma warning(pop)
+}
+
+#endif
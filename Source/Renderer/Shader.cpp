@@ -4,17 +4,18 @@
 #include <sstream>
 #include <iostream>
 #include "../Core/Logger.h"
+#include "ProgramBinaryCache.h"
 
 namespace Orca
 {
-	Shader::Shader(const std::string& vertPath, const std::string& fragPath)
+	Shader::Shader(const std::string& vertPath, const std::string& fragPath, const std::vector<std::string>& defines)
 		: m_ID(0)
 	{
 		try
 		{
 			std::string vertexSrc = LoadFile(vertPath);
 			std::string fragSrc = LoadFile(fragPath);
-			LinkProgram(vertexSrc, fragSrc);
+			LinkProgram(vertexSrc, fragSrc, defines);
 		}
 
 		catch (const std::exception& e)
@@ -23,11 +24,45 @@ namespace Orca
 		}
 	}
 
+	Shader::Shader()
+		: m_ID(0)
+	{
+	}
+
 	Shader::~Shader()
 	{
+		if (m_Status == ShaderStatus::Compiling)
+		{
+			glDeleteShader(m_VertexShader);
+			glDeleteShader(m_FragmentShader);
+		}
 		glDeleteProgram(m_ID);
 	}
 
+	ShaderSource Shader::LoadSource(const std::string& vertPath, const std::string& fragPath, const std::vector<std::string>& defines)
+	{
+		ShaderSource source;
+		source.VertexPath = vertPath;
+		source.FragmentPath = fragPath;
+		source.Vertex = LoadFile(vertPath);
+		source.Fragment = LoadFile(fragPath);
+		source.Defines = defines;
+		return source;
+	}
+
+	std::unique_ptr<Shader> Shader::CreateAsync(const ShaderSource& source)
+	{
+		std::unique_ptr<Shader> shader(new Shader());
+		shader->BeginBuild(source.Vertex, source.Fragment, source.Defines);
+
+		if (shader->m_Status == ShaderStatus::Failed)
+		{
+			Logger::Log(LogLevel::Fatal, std::string("Failed to initialize shader from paths [") + source.VertexPath + " & " + source.FragmentPath + "]");
+		}
+
+		return shader;
+	}
+
 	void Shader::Bind() const
 	{
 		if (m_ID == 0)
@@ -46,8 +81,6 @@ namespace Orca
 
 	void Shader::SetFloat(const std::string& name, float val) const
 	{
-		std::cerr << "Attempting to set uniform (Float) :" << name << "/n";
-
 		GLint loc = GetUniformLocation(name);
 		if (loc == -1)
 		{
@@ -58,8 +91,6 @@ namespace Orca
 
 	void Shader::SetInt(const std::string& name, int val) const
 	{
-		std::cerr << "Attempting to set uniform (Int) :" << name << "/n";
-
 		GLint loc = GetUniformLocation(name);
 		if (loc == -1)
 		{
@@ -68,10 +99,18 @@ namespace Orca
 		glUniform1i(loc, val);
 	}
 
-	void Shader::SetVec3(const std::string& name, const glm::vec3& val) const
+	void Shader::SetVec2(const std::string& name, const glm::vec2& val) const
 	{
-		std::cerr << "Attempting to set uniform (Vec3) :" << name << "/n";
+		GLint loc = GetUniformLocation(name);
+		if (loc == -1)
+		{
+			return;
+		}
+		glUniform2f(loc, val.x, val.y);
+	}
 
+	void Shader::SetVec3(const std::string& name, const glm::vec3& val) const
+	{
 		GLint loc = GetUniformLocation(name);
 		if (loc == -1) 
 		{
@@ -82,8 +121,6 @@ namespace Orca
 
 	void Shader::SetMat4(const std::string& name, const glm::mat4& val) const
 	{
-		std::cerr << "Attempting to set uniform (Mat4) :" << name << "/n";
-		
 		GLint loc = GetUniformLocation(name);
 		if (loc == -1)
 		{
@@ -123,55 +160,169 @@ namespace Orca
 			return 0;
 		}
 
+		// The status is queried later in CheckCompileStatus, after every stage has been issued.
 		unsigned int id = glCreateShader(type);
 		const char* src = source.c_str();
 		glShaderSource(id, 1, &src, nullptr);
 		glCompileShader(id);
 
+		return id;
+	}
+
+	bool Shader::CheckCompileStatus(unsigned int shader, unsigned int type) const
+	{
 		int success;
-		glGetShaderiv(id, GL_COMPILE_STATUS, &success);
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
 		if (!success) 
 		{
 			char info[512];
-			glGetShaderInfoLog(id, 512, nullptr, info);
+			glGetShaderInfoLog(shader, 512, nullptr, info);
 			Logger::Log(LogLevel::Error,
 				std::string("Shader compilation failed for ") + (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment") + " shader:\n" + info);
 		}
 
-		return id;
+		return success != 0;
 	}
 
-	void Shader::LinkProgram(const std::string& vertexSrc, const std::string& fragmentSrc) 
+	std::string Shader::InjectDefines(const std::string& source, const std::vector<std::string>& defines)
 	{
-		unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexSrc);
-		unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentSrc);
+		if (defines.empty() || source.empty())
+		{
+			return source;
+		}
+
+		std::string block;
+		for (const std::string& define : defines)
+		{
+			block += "#define " + define + "\n";
+		}
 
-		if (vs == 0 || fs == 0) 
+		// #version has to stay the first directive.
+		size_t insertAt = 0;
+		if (source.compare(0, 8, "#version") == 0)
 		{
-			if (vs != 0) glDeleteShader(vs);
-			if (fs != 0) glDeleteShader(fs);
-			throw std::runtime_error("Shader compilation failedvertex or fragment source is invalid.");
+			size_t lineEnd = source.find('\n');
+			insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
 		}
 
+		std::string result = source;
+		if (insertAt == result.size() && !result.empty() && result.back() != '\n')
+		{
+			block = "\n" + block;
+		}
+		result.insert(insertAt, block);
+		return result;
+	}
+
+	void Shader::LinkProgram(const std::string& vertexSource, const std::string& fragmentSource, const std::vector<std::string>& defines) 
+	{
+		BeginBuild(vertexSource, fragmentSource, defines);
+		Poll(true);
+
+		if (m_Status != ShaderStatus::Ready)
+		{
+			throw std::runtime_error("Shader build failed, see the log for compiler output.");
+		}
+	}
+
+	void Shader::BeginBuild(const std::string& vertexSource, const std::string& fragmentSource, const std::vector<std::string>& defines)
+	{
+		const std::string vertexSrc = InjectDefines(vertexSource, defines);
+		const std::string fragmentSrc = InjectDefines(fragmentSource, defines);
+
+		if (vertexSrc.empty() || fragmentSrc.empty())
+		{
+			Logger::Log(LogLevel::Error, "Shader source is empty. Compilation aborted.");
+			m_Status = ShaderStatus::Failed;
+			return;
+		}
+
+		// A cached binary skips compilation and linking entirely.
+		m_StoreBinary = ProgramBinaryCache::IsEnabled();
+		m_CacheKey = m_StoreBinary ? ProgramBinaryCache::MakeKey(vertexSrc, fragmentSrc, defines) : 0;
+
+		if (m_StoreBinary)
+		{
+			m_ID = glCreateProgram();
+			if (ProgramBinaryCache::Load(m_CacheKey, m_ID))
+			{
+				m_Status = ShaderStatus::Ready;
+				return;
+			}
+
+			// A rejected binary can leave the program in an undefined state; start from a clean one.
+			glDeleteProgram(m_ID);
+			m_ID = 0;
+		}
+
+		m_VertexShader = CompileShader(GL_VERTEX_SHADER, vertexSrc);
+		m_FragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentSrc);
+
 		m_ID = glCreateProgram();
-		glAttachShader(m_ID, vs);
-		glAttachShader(m_ID, fs);
+		if (m_StoreBinary)
+		{
+			glProgramParameteri(m_ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+		glAttachShader(m_ID, m_VertexShader);
+		glAttachShader(m_ID, m_FragmentShader);
 		glLinkProgram(m_ID);
 
-		int success;
-		glGetProgramiv(m_ID, GL_LINK_STATUS, &success);
-		if (!success) 
+		m_Status = ShaderStatus::Compiling;
+	}
+
+	bool Shader::Poll(bool wait)
+	{
+		if (m_Status != ShaderStatus::Compiling)
+		{
+			return true;
+		}
+
+		if (!wait && GLEW_KHR_parallel_shader_compile)
+		{
+			GLint completed = GL_FALSE;
+			glGetProgramiv(m_ID, GL_COMPLETION_STATUS_KHR, &completed);
+			if (!completed)
+			{
+				return false;
+			}
+		}
+
+		bool compiled = CheckCompileStatus(m_VertexShader, GL_VERTEX_SHADER);
+		compiled = CheckCompileStatus(m_FragmentShader, GL_FRAGMENT_SHADER) && compiled;
+
+		int success = 0;
+		if (compiled)
+		{
+			glGetProgramiv(m_ID, GL_LINK_STATUS, &success);
+			if (!success)
+			{
+				char info[512];
+				glGetProgramInfoLog(m_ID, 512, nullptr, info);
+				Logger::Log(LogLevel::Fatal, std::string("Shader linking failed for program ID ") + std::to_string(m_ID) + ":\n" + info);
+			}
+		}
+
+		glDetachShader(m_ID, m_VertexShader);
+		glDetachShader(m_ID, m_FragmentShader);
+		glDeleteShader(m_VertexShader);
+		glDeleteShader(m_FragmentShader);
+		m_VertexShader = m_FragmentShader = 0;
+
+		if (!success)
 		{
-			char info[512];
-			glGetProgramInfoLog(m_ID, 512, nullptr, info);
-			Logger::Log(LogLevel::Fatal, std::string("Shader linking failed for program ID ") + std::to_string(m_ID) + ":\n" + info);
 			glDeleteProgram(m_ID);
 			m_ID = 0;
-			throw std::runtime_error(std::string("Shader linking failed:\n") + info);
+			m_Status = ShaderStatus::Failed;
+			return true;
+		}
+
+		if (m_StoreBinary)
+		{
+			ProgramBinaryCache::Store(m_CacheKey, m_ID);
 		}
 
-		glDeleteShader(vs);
-		glDeleteShader(fs);
+		m_Status = ShaderStatus::Ready;
+		return true;
 	}
 
 	int Shader::GetUniformLocation(const std::string& name) const
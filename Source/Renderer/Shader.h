@@ -6,7 +6,9 @@
 #pragma message("Compiling Shader.h from: " __FILE__)
 
 #include <string>
+#include <vector>
 #include <unordered_map>
+#include <memory>
 #include <cstdint>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
@@ -18,20 +20,51 @@ namespace Orca
 #pragma warning(push)
 #pragma warning(disable: 4251)
 
+	enum class ShaderStatus
+	{
+		Compiling,
+		Ready,
+		Failed
+	};
+
+	// Stage sources with defines already injected. Loading one touches no GL state,
+	// so it can run on any thread.
+	struct ShaderSource
+	{
+		std::string VertexPath;
+		std::string FragmentPath;
+		std::string Vertex;
+		std::string Fragment;
+		std::vector<std::string> Defines;
+	};
+
 	class Shader
 	{
 	public:
-		Shader(const std::string& vertPath, const std::string& fragPath);
+		// Each define is inserted as "#define <define>" right after the #version line of both stages.
+		Shader(const std::string& vertPath, const std::string& fragPath, const std::vector<std::string>& defines = {});
 		~Shader();
 
+		static ShaderSource LoadSource(const std::string& vertPath, const std::string& fragPath, const std::vector<std::string>& defines = {});
+
+		// Issues compile and link without querying any status, so the driver can overlap the work
+		// of many programs. The shader is usable once Poll() reports it finished and IsValid().
+		static std::unique_ptr<Shader> CreateAsync(const ShaderSource& source);
+
+		// Returns true once the build has finished, successfully or not. Without wait it only
+		// blocks when the driver lacks GL_KHR_parallel_shader_compile.
+		bool Poll(bool wait = false);
+		ShaderStatus GetStatus() const { return m_Status; }
+
 		void Bind() const;
 		void Unbind() const;
 
 		void SetFloat(const std::string& name, float val) const;
 		void SetInt(const std::string& name, int val) const;
+		void SetVec2(const std::string& name, const glm::vec2& val) const;
 		void SetVec3(const std::string& name, const glm::vec3& val) const;
 		void SetMat4(const std::string& name, const glm::mat4& val) const;
-		bool IsValid() const { return m_ID != 0; }
+		bool IsValid() const { return m_ID != 0 && m_Status == ShaderStatus::Ready; }
 
 		unsigned int GetID() const { return m_ID; }
 
@@ -39,9 +72,21 @@ namespace Orca
 		unsigned int m_ID;
 		mutable std::unordered_map<std::string, int> m_UniformCache;
 
-		std::string LoadFile(const std::string& path);
+		// In-flight build state, released once Poll() finishes.
+		ShaderStatus m_Status = ShaderStatus::Failed;
+		unsigned int m_VertexShader = 0;
+		unsigned int m_FragmentShader = 0;
+		uint64_t m_CacheKey = 0;
+		bool m_StoreBinary = false;
+
+		Shader();
+
+		static std::string LoadFile(const std::string& path);
 		unsigned int CompileShader(unsigned int type, const std::string& src);
-		void LinkProgram(const std::string& vertSrc, const std::string& fragSrc);
+		void LinkProgram(const std::string& vertSrc, const std::string& fragSrc, const std::vector<std::string>& defines);
+		void BeginBuild(const std::string& vertSrc, const std::string& fragSrc, const std::vector<std::string>& defines);
+		bool CheckCompileStatus(unsigned int shader, unsigned int type) const;
+		static std::string InjectDefines(const std::string& source, const std::vector<std::string>& defines);
 		int GetUniformLocation(const std::string& name) const;
 	};
 #pragma warning(pop)
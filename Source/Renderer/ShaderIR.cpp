@@ -0,0 +1,977 @@
+/*********************************************
+*
+* Copyright  2025 VEGA Enterprises LTD,.
+* Licensed under the MIT License.
+*
+**********************************************/
+
+#include "ShaderIR.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_set>
+#include <cctype>
+
+namespace Orca
+{
+	namespace
+	{
+		const std::unordered_set<std::string_view>& GetBuiltinTypes()
+		{
+			static const std::unordered_set<std::string_view> types =
+			{
+				"void", "bool", "int", "uint", "float", "double",
+				"vec2", "vec3", "vec4", "ivec2", "ivec3", "ivec4", "uvec2", "uvec3", "uvec4",
+				"bvec2", "bvec3", "bvec4", "dvec2", "dvec3", "dvec4",
+				"mat2", "mat3", "mat4", "mat2x2", "mat2x3", "mat2x4", "mat3x2", "mat3x3", "mat3x4",
+				"mat4x2", "mat4x3", "mat4x4", "dmat2", "dmat3", "dmat4",
+				"sampler1D", "sampler2D", "sampler3D", "samplerCube", "sampler2DArray", "samplerCubeArray",
+				"sampler2DShadow", "samplerCubeShadow", "sampler2DArrayShadow", "samplerBuffer", "sampler2DMS",
+				"isampler2D", "isampler3D", "isamplerBuffer", "isampler2DArray",
+				"usampler2D", "usampler3D", "usamplerBuffer", "usampler2DArray"
+			};
+			return types;
+		}
+
+		bool IsPrecisionQualifier(std::string_view text)
+		{
+			return text == "highp" || text == "mediump" || text == "lowp";
+		}
+
+		// Binary and assignment operators by precedence; 0 means "not a binary operator".
+		int GetBinaryPrecedence(std::string_view op)
+		{
+			if (op == ",") return 1;
+			if (op == "=" || op == "+=" || op == "-=" || op == "*=" || op == "/=" || op == "%=" ||
+				op == "<<=" || op == ">>=" || op == "&=" || op == "|=" || op == "^=") return 2;
+			if (op == "?") return 3;
+			if (op == "||") return 4;
+			if (op == "^^") return 5;
+			if (op == "&&") return 6;
+			if (op == "|") return 7;
+			if (op == "^") return 8;
+			if (op == "&") return 9;
+			if (op == "==" || op == "!=") return 10;
+			if (op == "<" || op == ">" || op == "<=" || op == ">=") return 11;
+			if (op == "<<" || op == ">>") return 12;
+			if (op == "+" || op == "-") return 13;
+			if (op == "*" || op == "/" || op == "%") return 14;
+			return 0;
+		}
+
+		bool IsIdentifierStart(char c)
+		{
+			return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+		}
+
+		bool IsIdentifierChar(char c)
+		{
+			return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+		}
+	}
+
+	bool TokenizeShader(std::string_view source, std::vector<ShaderToken>& outTokens, std::string& outError)
+	{
+		static const std::string_view k_ThreeCharOps[] = { "<<=", ">>=" };
+		static const std::string_view k_TwoCharOps[] =
+		{
+			"++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=",
+			"==", "!=", "<=", ">=", "&&", "||", "^^", "<<", ">>"
+		};
+
+		outTokens.clear();
+		outTokens.reserve(source.size() / 4);
+
+		size_t i = 0;
+		uint32_t line = 1;
+		bool lineStart = true;
+
+		while (i < source.size())
+		{
+			const char c = source[i];
+
+			if (c == '\n')
+			{
+				line++;
+				lineStart = true;
+				i++;
+				continue;
+			}
+
+			if (std::isspace(static_cast<unsigned char>(c)))
+			{
+				i++;
+				continue;
+			}
+
+			if (c == '/' && i + 1 < source.size() && source[i + 1] == '/')
+			{
+				while (i < source.size() && source[i] != '\n')
+				{
+					i++;
+				}
+				continue;
+			}
+
+			if (c == '/' && i + 1 < source.size() && source[i + 1] == '*')
+			{
+				size_t end = source.find("*/", i + 2);
+				if (end == std::string_view::npos)
+				{
+					outError = "Unterminated block comment at line " + std::to_string(line);
+					return false;
+				}
+
+				for (size_t k = i; k < end; ++k)
+				{
+					line += source[k] == '\n' ? 1 : 0;
+				}
+				i = end + 2;
+				continue;
+			}
+
+			const size_t start = i;
+
+			if (c == '#' && lineStart)
+			{
+				// The directive runs to the end of the line, honoring backslash continuations.
+				const uint32_t directiveLine = line;
+				while (i < source.size() && source[i] != '\n')
+				{
+					if (source[i] == '\\' && i + 1 < source.size() && (source[i + 1] == '\n' || source[i + 1] == '\r'))
+					{
+						i = source.find('\n', i);
+						line++;
+					}
+					i++;
+				}
+
+				size_t end = std::min(i, source.size());
+				while (end > start && std::isspace(static_cast<unsigned char>(source[end - 1])))
+				{
+					end--;
+				}
+
+				outTokens.push_back({ ShaderTokenType::Directive, source.substr(start, end - start), directiveLine });
+				continue;
+			}
+
+			lineStart = false;
+
+			if (IsIdentifierStart(c))
+			{
+				while (i < source.size() && IsIdentifierChar(source[i]))
+				{
+					i++;
+				}
+				outTokens.push_back({ ShaderTokenType::Identifier, source.substr(start, i - start), line });
+				continue;
+			}
+
+			if (std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && i + 1 < source.size() && std::isdigit(static_cast<unsigned char>(source[i + 1]))))
+			{
+				bool isFloat = false;
+
+				if (c == '0' && i + 1 < source.size() && (source[i + 1] == 'x' || source[i + 1] == 'X'))
+				{
+					i += 2;
+					while (i < source.size() && std::isxdigit(static_cast<unsigned char>(source[i])))
+					{
+						i++;
+					}
+				}
+				else
+				{
+					while (i < source.size() && (std::isdigit(static_cast<unsigned char>(source[i])) || source[i] == '.'))
+					{
+						isFloat |= source[i] == '.';
+						i++;
+					}
+
+					if (i < source.size() && (source[i] == 'e' || source[i] == 'E'))
+					{
+						isFloat = true;
+						i++;
+						if (i < source.size() && (source[i] == '+' || source[i] == '-'))
+						{
+							i++;
+						}
+						while (i < source.size() && std::isdigit(static_cast<unsigned char>(source[i])))
+						{
+							i++;
+						}
+					}
+				}
+
+				if (i < source.size() && (source[i] == 'u' || source[i] == 'U'))
+				{
+					i++;
+				}
+				else if (i + 1 < source.size() && (source[i] == 'l' || source[i] == 'L') && (source[i + 1] == 'f' || source[i + 1] == 'F'))
+				{
+					isFloat = true;
+					i += 2;
+				}
+				else if (i < source.size() && (source[i] == 'f' || source[i] == 'F'))
+				{
+					isFloat = true;
+					i++;
+				}
+
+				outTokens.push_back({ isFloat ? ShaderTokenType::FloatLiteral : ShaderTokenType::IntLiteral, source.substr(start, i - start), line });
+				continue;
+			}
+
+			size_t length = 1;
+			for (std::string_view op : k_ThreeCharOps)
+			{
+				if (source.compare(i, 3, op) == 0)
+				{
+					length = 3;
+					break;
+				}
+			}
+
+			if (length == 1)
+			{
+				for (std::string_view op : k_TwoCharOps)
+				{
+					if (source.compare(i, 2, op) == 0)
+					{
+						length = 2;
+						break;
+					}
+				}
+			}
+
+			if (length == 1 && std::string_view("{}()[].,;:?+-*/%<>=!~&|^").find(c) == std::string_view::npos)
+			{
+				outError = std::string("Unexpected character '") + c + "' at line " + std::to_string(line);
+				return false;
+			}
+
+			outTokens.push_back({ ShaderTokenType::Punctuator, source.substr(i, length), line });
+			i += length;
+		}
+
+		outTokens.push_back({ ShaderTokenType::End, std::string_view(), line });
+		return true;
+	}
+
+	bool ShaderModule::Parse(const std::string& source)
+	{
+		m_Source = std::make_shared<const std::string>(source);
+		m_Position = 0;
+		m_Version = 110;
+		m_Error.clear();
+
+		Items.clear();
+		Directives.clear();
+		Structs.clear();
+		Globals.clear();
+		Functions.clear();
+		Exprs.clear();
+		Stmts.clear();
+
+		if (!TokenizeShader(*m_Source, m_Tokens, m_Error))
+		{
+			return false;
+		}
+
+		try
+		{
+			while (Peek().Type != ShaderTokenType::End)
+			{
+				ParseGlobal();
+			}
+		}
+		catch (const std::exception& e)
+		{
+			m_Error = e.what();
+			return false;
+		}
+
+		return true;
+	}
+
+	const ShaderStruct* ShaderModule::FindStruct(std::string_view name) const
+	{
+		for (const ShaderStruct& shaderStruct : Structs)
+		{
+			if (shaderStruct.Name == name)
+			{
+				return &shaderStruct;
+			}
+		}
+		return nullptr;
+	}
+
+	const ShaderFunction* ShaderModule::FindFunction(std::string_view name) const
+	{
+		// Prefer the definition over a prototype.
+		const ShaderFunction* found = nullptr;
+		for (const ShaderFunction& function : Functions)
+		{
+			if (function.Name == name && (!found || function.Body != k_InvalidShaderIndex))
+			{
+				found = &function;
+			}
+		}
+		return found;
+	}
+
+	const ShaderToken& ShaderModule::Peek(size_t offset) const
+	{
+		const size_t index = std::min(m_Position + offset, m_Tokens.size() - 1);
+		return m_Tokens[index];
+	}
+
+	const ShaderToken& ShaderModule::Next()
+	{
+		const ShaderToken& token = Peek();
+		if (m_Position < m_Tokens.size() - 1)
+		{
+			m_Position++;
+		}
+		return token;
+	}
+
+	bool ShaderModule::Accept(std::string_view text)
+	{
+		const ShaderToken& token = Peek();
+		if (token.Type != ShaderTokenType::End && token.Type != ShaderTokenType::Directive && token.Text == text)
+		{
+			Next();
+			return true;
+		}
+		return false;
+	}
+
+	void ShaderModule::Expect(std::string_view text)
+	{
+		if (!Accept(text))
+		{
+			Fail("expected '" + std::string(text) + "'");
+		}
+	}
+
+	std::string_view ShaderModule::ExpectIdentifier()
+	{
+		if (Peek().Type != ShaderTokenType::Identifier)
+		{
+			Fail("expected an identifier");
+		}
+		return Next().Text;
+	}
+
+	void ShaderModule::Fail(const std::string& message) const
+	{
+		const ShaderToken& token = Peek();
+		const std::string found = token.Type == ShaderTokenType::End ? "end of file" : "'" + std::string(token.Text) + "'";
+		throw std::runtime_error("Line " + std::to_string(token.Line) + ": " + message + ", found " + found);
+	}
+
+	bool ShaderModule::IsTypeName(std::string_view name) const
+	{
+		return GetBuiltinTypes().count(name) > 0 || FindStruct(name) != nullptr;
+	}
+
+	bool ShaderModule::IsDeclarationStart() const
+	{
+		const ShaderToken& token = Peek();
+		if (token.Type != ShaderTokenType::Identifier)
+		{
+			return false;
+		}
+
+		if (token.Text == "const" || IsPrecisionQualifier(token.Text))
+		{
+			return true;
+		}
+
+		return IsTypeName(token.Text) && Peek(1).Type == ShaderTokenType::Identifier;
+	}
+
+	uint32_t ShaderModule::AddExpr(ShaderExprKind kind, std::string_view text, std::vector<uint32_t> operands)
+	{
+		Exprs.push_back({ kind, text, std::move(operands) });
+		return static_cast<uint32_t>(Exprs.size() - 1);
+	}
+
+	uint32_t ShaderModule::AddStmt(ShaderStmt stmt)
+	{
+		Stmts.push_back(std::move(stmt));
+		return static_cast<uint32_t>(Stmts.size() - 1);
+	}
+
+	void ShaderModule::ParseGlobal()
+	{
+		const ShaderToken& token = Peek();
+
+		if (token.Type == ShaderTokenType::Directive)
+		{
+			Next();
+			if (token.Text.compare(0, 8, "#version") == 0)
+			{
+				const std::string version(token.Text.substr(8));
+				m_Version = std::atoi(version.c_str());
+				return;
+			}
+
+			Directives.push_back(token.Text);
+			Items.push_back({ ShaderGlobalKind::Directive, static_cast<uint32_t>(Directives.size() - 1) });
+			return;
+		}
+
+		if (Accept(";"))
+		{
+			return;
+		}
+
+		if (Accept("precision"))
+		{
+			while (!Accept(";"))
+			{
+				if (Next().Type == ShaderTokenType::End)
+				{
+					Fail("unterminated precision statement");
+				}
+			}
+			return;
+		}
+
+		ShaderVariable prototype;
+		ParseQualifiers(prototype);
+
+		if (Peek().Text == "struct")
+		{
+			const uint32_t index = ParseStruct();
+			Items.push_back({ ShaderGlobalKind::Struct, index });
+			if (Accept(";"))
+			{
+				return;
+			}
+			prototype.Type = Structs[index].Name;
+		}
+		else if (prototype.Storage == ShaderStorage::Uniform && Peek().Type == ShaderTokenType::Identifier && Peek(1).Text == "{")
+		{
+			// Uniform block: members become plain uniforms unless the block has an instance name.
+			ShaderStruct block;
+			block.Name = Next().Text;
+			Expect("{");
+			while (!Accept("}"))
+			{
+				ShaderVariable field;
+				field.Storage = ShaderStorage::Uniform;
+				ParseQualifiers(field);
+				field.Type = ExpectIdentifier();
+				ParseDeclarators(field, block.Fields);
+			}
+
+			if (Accept(";"))
+			{
+				for (ShaderVariable& field : block.Fields)
+				{
+					field.Binding = prototype.Binding;
+					Globals.push_back(field);
+					Items.push_back({ ShaderGlobalKind::Variable, static_cast<uint32_t>(Globals.size() - 1) });
+				}
+				return;
+			}
+
+			for (ShaderVariable& field : block.Fields)
+			{
+				field.Storage = ShaderStorage::None;
+			}
+			Structs.push_back(std::move(block));
+			Items.push_back({ ShaderGlobalKind::Struct, static_cast<uint32_t>(Structs.size() - 1) });
+			prototype.Type = Structs.back().Name;
+		}
+		else
+		{
+			if (Accept(";"))
+			{
+				// Stage-wide layout such as layout(early_fragment_tests) in;
+				return;
+			}
+
+			prototype.Type = ExpectIdentifier();
+		}
+
+		if (Peek().Type == ShaderTokenType::Identifier && Peek(1).Text == "(")
+		{
+			ParseFunction(prototype.Type, Next().Text);
+			return;
+		}
+
+		std::vector<ShaderVariable> variables;
+		ParseDeclarators(prototype, variables);
+		for (ShaderVariable& variable : variables)
+		{
+			Globals.push_back(variable);
+			Items.push_back({ ShaderGlobalKind::Variable, static_cast<uint32_t>(Globals.size() - 1) });
+		}
+	}
+
+	void ShaderModule::ParseLayout(ShaderVariable& variable)
+	{
+		Expect("(");
+		do
+		{
+			std::string_view key = ExpectIdentifier();
+			int value = -1;
+			if (Accept("="))
+			{
+				const ShaderToken& token = Next();
+				if (token.Type != ShaderTokenType::IntLiteral)
+				{
+					Fail("layout values must be integer literals");
+				}
+				value = static_cast<int>(std::stol(std::string(token.Text), nullptr, 0));
+			}
+
+			if (key == "location")
+			{
+				variable.Location = value;
+			}
+			else if (key == "binding")
+			{
+				variable.Binding = value;
+			}
+		} while (Accept(","));
+		Expect(")");
+	}
+
+	void ShaderModule::ParseQualifiers(ShaderVariable& variable)
+	{
+		for (;;)
+		{
+			const std::string_view text = Peek().Text;
+			if (Peek().Type != ShaderTokenType::Identifier)
+			{
+				return;
+			}
+
+			if (text == "layout")
+			{
+				Next();
+				ParseLayout(variable);
+				continue;
+			}
+
+			if (text == "in" || text == "attribute") variable.Storage = ShaderStorage::In;
+			else if (text == "out" || text == "varying") variable.Storage = ShaderStorage::Out;
+			else if (text == "inout") variable.Storage = ShaderStorage::InOut;
+			else if (text == "uniform") variable.Storage = ShaderStorage::Uniform;
+			else if (text == "const") variable.IsConst = true;
+			else if (text == "flat") variable.Interpolation = ShaderInterpolation::Flat;
+			else if (text == "noperspective") variable.Interpolation = ShaderInterpolation::NoPerspective;
+			else if (text != "smooth" && text != "centroid" && text != "invariant" && text != "precise" && !IsPrecisionQualifier(text))
+			{
+				return;
+			}
+
+			Next();
+		}
+	}
+
+	uint32_t ShaderModule::ParseStruct()
+	{
+		Expect("struct");
+
+		ShaderStruct shaderStruct;
+		shaderStruct.Name = ExpectIdentifier();
+		Expect("{");
+		while (!Accept("}"))
+		{
+			ShaderVariable field;
+			ParseQualifiers(field);
+			field.Type = ExpectIdentifier();
+			ParseDeclarators(field, shaderStruct.Fields);
+		}
+
+		Structs.push_back(std::move(shaderStruct));
+		return static_cast<uint32_t>(Structs.size() - 1);
+	}
+
+	void ShaderModule::ParseDeclarators(ShaderVariable prototype, std::vector<ShaderVariable>& out)
+	{
+		do
+		{
+			ShaderVariable variable = prototype;
+			variable.Name = ExpectIdentifier();
+
+			if (Accept("["))
+			{
+				variable.IsArray = true;
+				if (!Accept("]"))
+				{
+					variable.ArraySize = ParseExpression(2);
+					Expect("]");
+				}
+			}
+
+			if (Accept("="))
+			{
+				variable.Initializer = ParseExpression(2);
+			}
+
+			out.push_back(variable);
+		} while (Accept(","));
+
+		Expect(";");
+	}
+
+	void ShaderModule::ParseFunction(std::string_view returnType, std::string_view name)
+	{
+		ShaderFunction function;
+		function.ReturnType = returnType;
+		function.Name = name;
+
+		Expect("(");
+		if (Peek().Text == "void" && Peek(1).Text == ")")
+		{
+			Next();
+		}
+
+		if (!Accept(")"))
+		{
+			do
+			{
+				ShaderVariable parameter;
+				parameter.Storage = ShaderStorage::In;
+				ParseQualifiers(parameter);
+				parameter.Type = ExpectIdentifier();
+				if (Peek().Type == ShaderTokenType::Identifier)
+				{
+					parameter.Name = Next().Text;
+				}
+				if (Accept("["))
+				{
+					parameter.IsArray = true;
+					parameter.ArraySize = ParseExpression(2);
+					Expect("]");
+				}
+				function.Parameters.push_back(parameter);
+			} while (Accept(","));
+			Expect(")");
+		}
+
+		if (!Accept(";"))
+		{
+			if (Peek().Text != "{")
+			{
+				Fail("expected a function body");
+			}
+			function.Body = ParseStatement();
+		}
+
+		Functions.push_back(std::move(function));
+		Items.push_back({ ShaderGlobalKind::Function, static_cast<uint32_t>(Functions.size() - 1) });
+	}
+
+	uint32_t ShaderModule::ParseStatement()
+	{
+		ShaderStmt stmt;
+
+		if (Peek().Type == ShaderTokenType::Directive)
+		{
+			Directives.push_back(Next().Text);
+			stmt.Kind = ShaderStmtKind::Directive;
+			stmt.Condition = static_cast<uint32_t>(Directives.size() - 1);
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("{"))
+		{
+			stmt.Kind = ShaderStmtKind::Block;
+			while (!Accept("}"))
+			{
+				if (Peek().Type == ShaderTokenType::End)
+				{
+					Fail("unterminated block");
+				}
+				stmt.Statements.push_back(ParseStatement());
+			}
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept(";"))
+		{
+			stmt.Kind = ShaderStmtKind::Empty;
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("if"))
+		{
+			stmt.Kind = ShaderStmtKind::If;
+			Expect("(");
+			stmt.Condition = ParseExpression();
+			Expect(")");
+			stmt.Body = ParseStatement();
+			if (Accept("else"))
+			{
+				stmt.Else = ParseStatement();
+			}
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("for"))
+		{
+			stmt.Kind = ShaderStmtKind::For;
+			Expect("(");
+			if (IsDeclarationStart())
+			{
+				stmt.Init = ParseDeclarationStatement();
+			}
+			else if (!Accept(";"))
+			{
+				ShaderStmt init;
+				init.Kind = ShaderStmtKind::Expression;
+				init.Condition = ParseExpression();
+				Expect(";");
+				stmt.Init = AddStmt(std::move(init));
+			}
+
+			if (!Accept(";"))
+			{
+				stmt.Condition = ParseExpression();
+				Expect(";");
+			}
+			if (!Accept(")"))
+			{
+				stmt.Increment = ParseExpression();
+				Expect(")");
+			}
+			stmt.Body = ParseStatement();
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("while"))
+		{
+			stmt.Kind = ShaderStmtKind::While;
+			Expect("(");
+			stmt.Condition = ParseExpression();
+			Expect(")");
+			stmt.Body = ParseStatement();
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("do"))
+		{
+			stmt.Kind = ShaderStmtKind::DoWhile;
+			stmt.Body = ParseStatement();
+			Expect("while");
+			Expect("(");
+			stmt.Condition = ParseExpression();
+			Expect(")");
+			Expect(";");
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("switch"))
+		{
+			stmt.Kind = ShaderStmtKind::Switch;
+			Expect("(");
+			stmt.Condition = ParseExpression();
+			Expect(")");
+			Expect("{");
+			while (!Accept("}"))
+			{
+				ShaderStmt label;
+				label.Kind = ShaderStmtKind::Case;
+				if (Accept("case"))
+				{
+					label.Condition = ParseExpression(2);
+					Expect(":");
+					stmt.Statements.push_back(AddStmt(std::move(label)));
+				}
+				else if (Accept("default"))
+				{
+					Expect(":");
+					stmt.Statements.push_back(AddStmt(std::move(label)));
+				}
+				else
+				{
+					stmt.Statements.push_back(ParseStatement());
+				}
+			}
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("return"))
+		{
+			stmt.Kind = ShaderStmtKind::Return;
+			if (!Accept(";"))
+			{
+				stmt.Condition = ParseExpression();
+				Expect(";");
+			}
+			return AddStmt(std::move(stmt));
+		}
+
+		if (Accept("break") || Accept("continue") || Accept("discard"))
+		{
+			const std::string_view keyword = m_Tokens[m_Position - 1].Text;
+			stmt.Kind = keyword == "break" ? ShaderStmtKind::Break : keyword == "continue" ? ShaderStmtKind::Continue : ShaderStmtKind::Discard;
+			Expect(";");
+			return AddStmt(std::move(stmt));
+		}
+
+		if (IsDeclarationStart())
+		{
+			return ParseDeclarationStatement();
+		}
+
+		stmt.Kind = ShaderStmtKind::Expression;
+		stmt.Condition = ParseExpression();
+		Expect(";");
+		return AddStmt(std::move(stmt));
+	}
+
+	uint32_t ShaderModule::ParseDeclarationStatement()
+	{
+		ShaderStmt stmt;
+		stmt.Kind = ShaderStmtKind::Declaration;
+
+		ShaderVariable prototype;
+		ParseQualifiers(prototype);
+		prototype.Type = ExpectIdentifier();
+		ParseDeclarators(prototype, stmt.Variables);
+
+		return AddStmt(std::move(stmt));
+	}
+
+	uint32_t ShaderModule::ParseExpression(int minimumPrecedence)
+	{
+		uint32_t left = ParseUnary();
+
+		for (;;)
+		{
+			const ShaderToken& token = Peek();
+			if (token.Type != ShaderTokenType::Punctuator)
+			{
+				return left;
+			}
+
+			const std::string_view op = token.Text;
+			const int precedence = GetBinaryPrecedence(op);
+			if (precedence == 0 || precedence < minimumPrecedence)
+			{
+				return left;
+			}
+
+			Next();
+
+			if (precedence == 2)
+			{
+				// Assignment is right associative.
+				uint32_t right = ParseExpression(2);
+				left = AddExpr(ShaderExprKind::Assign, op, { left, right });
+			}
+			else if (op == "?")
+			{
+				uint32_t whenTrue = ParseExpression(2);
+				Expect(":");
+				uint32_t whenFalse = ParseExpression(3);
+				left = AddExpr(ShaderExprKind::Ternary, op, { left, whenTrue, whenFalse });
+			}
+			else if (op == ",")
+			{
+				uint32_t right = ParseExpression(2);
+				left = AddExpr(ShaderExprKind::Sequence, op, { left, right });
+			}
+			else
+			{
+				uint32_t right = ParseExpression(precedence + 1);
+				left = AddExpr(ShaderExprKind::Binary, op, { left, right });
+			}
+		}
+	}
+
+	uint32_t ShaderModule::ParseUnary()
+	{
+		const ShaderToken& token = Peek();
+
+		if (token.Type == ShaderTokenType::Punctuator &&
+			(token.Text == "-" || token.Text == "+" || token.Text == "!" || token.Text == "~" || token.Text == "++" || token.Text == "--"))
+		{
+			const std::string_view op = Next().Text;
+			uint32_t operand = ParseUnary();
+			return AddExpr(ShaderExprKind::Prefix, op, { operand });
+		}
+
+		uint32_t primary = k_InvalidShaderIndex;
+
+		if (Accept("("))
+		{
+			uint32_t inner = ParseExpression();
+			Expect(")");
+			primary = AddExpr(ShaderExprKind::Paren, "()", { inner });
+		}
+		else if (token.Type == ShaderTokenType::IntLiteral || token.Type == ShaderTokenType::FloatLiteral)
+		{
+			primary = AddExpr(ShaderExprKind::Literal, Next().Text);
+		}
+		else if (token.Type == ShaderTokenType::Identifier)
+		{
+			const std::string_view name = Next().Text;
+			if (name == "true" || name == "false")
+			{
+				primary = AddExpr(ShaderExprKind::Literal, name);
+			}
+			else if (Accept("("))
+			{
+				std::vector<uint32_t> arguments;
+				if (Peek().Text == "void" && Peek(1).Text == ")")
+				{
+					Next();
+				}
+				if (!Accept(")"))
+				{
+					do
+					{
+						arguments.push_back(ParseExpression(2));
+					} while (Accept(","));
+					Expect(")");
+				}
+				primary = AddExpr(ShaderExprKind::Call, name, std::move(arguments));
+			}
+			else
+			{
+				primary = AddExpr(ShaderExprKind::Identifier, name);
+			}
+		}
+		else
+		{
+			Fail("expected an expression");
+		}
+
+		return ParsePostfix(primary);
+	}
+
+	uint32_t ShaderModule::ParsePostfix(uint32_t operand)
+	{
+		for (;;)
+		{
+			if (Accept("["))
+			{
+				uint32_t index = ParseExpression();
+				Expect("]");
+				operand = AddExpr(ShaderExprKind::Index, "[]", { operand, index });
+			}
+			else if (Accept("."))
+			{
+				operand = AddExpr(ShaderExprKind::Member, ExpectIdentifier(), { operand });
+			}
+			else if (Peek().Text == "++" || Peek().Text == "--")
+			{
+				operand = AddExpr(ShaderExprKind::Postfix, Next().Text, { operand });
+			}
+			else
+			{
+				return operand;
+			}
+		}
+	}
+}
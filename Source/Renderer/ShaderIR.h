@@ -0,0 +1,213 @@
+/*********************************************
+*
+* Copyright  2025 VEGA Enterprises LTD,.
+* Licensed under the MIT License.
+*
+**********************************************/
+
+#pragma once
+
+#ifndef SHADER_IR_H
+#define SHADER_IR_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	constexpr uint32_t k_InvalidShaderIndex = ~0u;
+
+	enum class ShaderTokenType : uint8_t
+	{
+		Identifier,
+		IntLiteral,
+		FloatLiteral,
+		Punctuator,
+		Directive,		// A whole preprocessor line
+		End
+	};
+
+	struct ShaderToken
+	{
+		ShaderTokenType Type = ShaderTokenType::End;
+		std::string_view Text;
+		uint32_t Line = 0;
+	};
+
+	// Splits GLSL source into tokens in a single pass. Comments are dropped and preprocessor
+	// lines (including continuations) come back as one Directive token each.
+	ORCA_API bool TokenizeShader(std::string_view source, std::vector<ShaderToken>& outTokens, std::string& outError);
+
+	enum class ShaderExprKind : uint8_t
+	{
+		Literal,
+		Identifier,
+		Paren,
+		Call,		// Text is the callee: a function or a constructor type
+		Member,		// Text is the field or swizzle
+		Index,
+		Prefix,
+		Postfix,
+		Binary,
+		Assign,
+		Ternary,
+		Sequence
+	};
+
+	struct ShaderExpr
+	{
+		ShaderExprKind Kind = ShaderExprKind::Literal;
+		std::string_view Text;
+		std::vector<uint32_t> Operands;		// Indices into ShaderModule::Exprs
+	};
+
+	enum class ShaderStorage : uint8_t
+	{
+		None,
+		In,
+		Out,
+		InOut,
+		Uniform,
+		Const
+	};
+
+	enum class ShaderInterpolation : uint8_t
+	{
+		Smooth,
+		Flat,
+		NoPerspective
+	};
+
+	struct ShaderVariable
+	{
+		std::string_view Type;
+		std::string_view Name;
+		ShaderStorage Storage = ShaderStorage::None;
+		ShaderInterpolation Interpolation = ShaderInterpolation::Smooth;
+		bool IsConst = false;
+		bool IsArray = false;
+		uint32_t ArraySize = k_InvalidShaderIndex;		// Expression, invalid for unsized arrays
+		uint32_t Initializer = k_InvalidShaderIndex;
+		int Location = -1;
+		int Binding = -1;
+	};
+
+	enum class ShaderStmtKind : uint8_t
+	{
+		Block,
+		Declaration,
+		Expression,
+		If,
+		For,
+		While,
+		DoWhile,
+		Switch,
+		Case,		// Condition is invalid for default:
+		Return,
+		Break,
+		Continue,
+		Discard,
+		Directive,	// Preprocessor line inside a function, Condition indexes Directives
+		Empty
+	};
+
+	struct ShaderStmt
+	{
+		ShaderStmtKind Kind = ShaderStmtKind::Empty;
+		uint32_t Condition = k_InvalidShaderIndex;	// Expression: condition, return value, case label or the statement itself
+		uint32_t Increment = k_InvalidShaderIndex;	// Expression, for loops
+		uint32_t Init = k_InvalidShaderIndex;		// Statement, for loops
+		uint32_t Body = k_InvalidShaderIndex;		// Statement: then-branch or loop body
+		uint32_t Else = k_InvalidShaderIndex;		// Statement
+		std::vector<uint32_t> Statements;			// Blocks and switch bodies
+		std::vector<ShaderVariable> Variables;		// Declarations
+	};
+
+	struct ShaderStruct
+	{
+		std::string_view Name;
+		std::vector<ShaderVariable> Fields;
+	};
+
+	struct ShaderFunction
+	{
+		std::string_view ReturnType;
+		std::string_view Name;
+		std::vector<ShaderVariable> Parameters;
+		uint32_t Body = k_InvalidShaderIndex;		// Invalid for prototypes
+	};
+
+	enum class ShaderGlobalKind : uint8_t
+	{
+		Directive,
+		Struct,
+		Variable,
+		Function
+	};
+
+	struct ShaderGlobal
+	{
+		ShaderGlobalKind Kind;
+		uint32_t Index;		// Into the vector matching Kind
+	};
+
+	// Parsed translation unit. Everything is stored in flat arrays and referenced by index, and all
+	// text is a view into the module's own copy of the source, so parsing allocates very little.
+	class ORCA_API ShaderModule
+	{
+	public:
+		bool Parse(const std::string& source);
+
+		const std::string& GetError() const { return m_Error; }
+		int GetVersion() const { return m_Version; }
+
+		const ShaderStruct* FindStruct(std::string_view name) const;
+		const ShaderFunction* FindFunction(std::string_view name) const;
+
+		std::vector<ShaderGlobal> Items;
+		std::vector<std::string_view> Directives;
+		std::vector<ShaderStruct> Structs;
+		std::vector<ShaderVariable> Globals;
+		std::vector<ShaderFunction> Functions;
+		std::vector<ShaderExpr> Exprs;
+		std::vector<ShaderStmt> Stmts;
+
+	private:
+		std::shared_ptr<const std::string> m_Source;	// Heap owned so views survive moves
+		std::vector<ShaderToken> m_Tokens;
+		size_t m_Position = 0;
+		int m_Version = 110;
+		std::string m_Error;
+
+		const ShaderToken& Peek(size_t offset = 0) const;
+		const ShaderToken& Next();
+		bool Accept(std::string_view text);
+		void Expect(std::string_view text);
+		std::string_view ExpectIdentifier();
+		[[noreturn]] void Fail(const std::string& message) const;
+
+		bool IsTypeName(std::string_view name) const;
+		bool IsDeclarationStart() const;
+
+		void ParseGlobal();
+		void ParseLayout(ShaderVariable& variable);
+		void ParseQualifiers(ShaderVariable& variable);
+		uint32_t ParseStruct();
+		void ParseDeclarators(ShaderVariable prototype, std::vector<ShaderVariable>& out);
+		void ParseFunction(std::string_view returnType, std::string_view name);
+
+		uint32_t ParseStatement();
+		uint32_t ParseDeclarationStatement();
+		uint32_t ParseExpression(int minimumPrecedence = 0);
+		uint32_t ParseUnary();
+		uint32_t ParsePostfix(uint32_t operand);
+		uint32_t AddExpr(ShaderExprKind kind, std::string_view text, std::vector<uint32_t> operands = {});
+		uint32_t AddStmt(ShaderStmt stmt);
+	};
+}
+
+#endif
@@ -1,11 +1,59 @@
 #include "ShaderRegistry.h"
 #include "../Core/Logger.h"
+#include "../Core/JobSystem.h"
+#include <GL/glew.h>
 #include <filesystem>
+#include <algorithm>
 
 namespace Orca
 {
 	std::unordered_map<std::string, std::unique_ptr<Shader>> ShaderRegistry::s_ShaderCache;
-	std::unordered_map<std::string, Shader*> ShaderRegistry::s_NameMap;
+	std::unordered_map<std::string, std::unique_ptr<ShaderVariantSet>> ShaderRegistry::s_Variants;
+	std::vector<Shader*> ShaderRegistry::s_Pending;
+	std::unique_ptr<Shader> ShaderRegistry::s_Placeholder;
+	uint32_t ShaderRegistry::s_Generation = 1;
+
+	namespace
+	{
+		// Same inputs as Unlit so it can stand in for any material, instanced or not.
+		const char* k_PlaceholderVertex = R"(#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 4) in mat4 a_InstanceModel;
+layout(location = 8) in vec4 a_InstanceColor;
+layout(location = 9) in vec4 a_InstancePositionScale;
+layout(location = 10) in vec4 a_InstancePositionOffset;
+
+uniform int u_UseInstanceData;
+uniform mat4 u_Model;
+uniform vec3 u_AlbedoColor;
+uniform mat4 u_ViewProjection;
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
+
+flat out vec3 v_AlbedoColor;
+
+void main()
+{
+    mat4 model = u_UseInstanceData != 0 ? a_InstanceModel : u_Model;
+    vec3 positionScale = u_UseInstanceData != 0 ? a_InstancePositionScale.xyz : u_PositionScale;
+    vec3 positionOffset = u_UseInstanceData != 0 ? a_InstancePositionOffset.xyz : u_PositionOffset;
+    v_AlbedoColor = u_UseInstanceData != 0 ? a_InstanceColor.rgb : u_AlbedoColor;
+    gl_Position = u_ViewProjection * model * vec4(a_Position * positionScale + positionOffset, 1.0);
+}
+)";
+
+		const char* k_PlaceholderFragment = R"(#version 330 core
+
+flat in vec3 v_AlbedoColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(v_AlbedoColor * 0.5 + 0.25, 1.0);
+}
+)";
+	}
 
 	std::string ShaderRegistry::MakeKey(const std::string& vert, const std::string& frag)
 	{
@@ -21,9 +69,8 @@ namespace Orca
 				Logger::Log(LogLevel::Fatal, "Shader file(s) missing for: " + name);
 				return;
 			}
-			auto shader = std::make_unique<Shader>(vertPath, fragPath);
-			s_NameMap[name] = shader.get();
-			s_ShaderCache[MakeKey(vertPath, fragPath)] = std::move(shader);
+			ShaderVariantSet* variants = AddVariants(name, Shader::LoadSource(vertPath, fragPath));
+			variants->Build(0)->Poll(true);
 		}
 		catch (const std::exception& e) 
 		{
@@ -44,20 +91,167 @@ namespace Orca
 
 	Shader* ShaderRegistry::Get(const std::string& name)
 	{
-		auto it = s_NameMap.find(name);
+		ShaderVariantSet* variants = GetVariants(name);
+		return variants ? variants->GetVariant(0) : nullptr;
+	}
+
+	Shader* ShaderRegistry::Find(const std::string& name)
+	{
+		ShaderVariantSet* variants = FindVariants(name);
+		return variants ? variants->GetVariant(0) : nullptr;
+	}
+
+	ShaderVariantSet* ShaderRegistry::GetVariants(const std::string& name)
+	{
+		ShaderVariantSet* variants = FindVariants(name);
 
-		if (it == s_NameMap.end())
+		if (!variants)
 		{
 			Logger::Log(LogLevel::Warning, "Shader not found in registry: " + name);
-			return nullptr;
 		}
 
-		return it != s_NameMap.end() ? it->second : nullptr;
+		return variants;
+	}
+
+	ShaderVariantSet* ShaderRegistry::FindVariants(const std::string& name)
+	{
+		auto it = s_Variants.find(name);
+		return it != s_Variants.end() ? it->second.get() : nullptr;
+	}
+
+	ShaderVariantSet* ShaderRegistry::AddVariants(const std::string& name, const ShaderSource& source)
+	{
+		auto variants = std::make_unique<ShaderVariantSet>(source);
+		if (!variants->GetKeywords().empty())
+		{
+			Logger::Log(LogLevel::Info, "Shader " + name + " declares " + std::to_string(variants->GetKeywords().size()) + " keyword(s)");
+		}
+
+		// Registering a name again replaces its set; none of the old variants may stay pending.
+		if (ShaderVariantSet* previous = FindVariants(name))
+		{
+			s_Pending.erase(std::remove_if(s_Pending.begin(), s_Pending.end(), [&](const Shader* shader) { return previous->Owns(shader); }), s_Pending.end());
+		}
+
+		ShaderVariantSet* result = variants.get();
+		s_Variants[name] = std::move(variants);
+		s_Generation++;
+		return result;
+	}
+
+	ShaderVariantSet* ShaderRegistry::Register(const std::string& name, const ShaderSource& source)
+	{
+		return AddVariants(name, source);
+	}
+
+	void ShaderRegistry::PreloadAsync(const std::vector<ShaderRequest>& requests)
+	{
+		if (!s_Placeholder)
+		{
+			ShaderSource placeholder;
+			placeholder.VertexPath = "<placeholder>";
+			placeholder.FragmentPath = "<placeholder>";
+			placeholder.Vertex = k_PlaceholderVertex;
+			placeholder.Fragment = k_PlaceholderFragment;
+			s_Placeholder = Shader::CreateAsync(placeholder);
+			s_Placeholder->Poll(true);
+		}
+
+		// File IO and define injection carry no GL state, so they fan out over the pool.
+		std::vector<ShaderSource> sources(requests.size());
+		auto loadSource = [&](unsigned int index)
+			{
+				const ShaderRequest& request = requests[index];
+				if (std::filesystem::exists(request.VertexPath) && std::filesystem::exists(request.FragmentPath))
+				{
+					sources[index] = Shader::LoadSource(request.VertexPath, request.FragmentPath);
+				}
+			};
+
+		if (JobSystem::IsInitialized())
+		{
+			JobSystem::Dispatch(static_cast<unsigned int>(requests.size()), loadSource);
+		}
+		else
+		{
+			for (unsigned int i = 0; i < requests.size(); ++i)
+			{
+				loadSource(i);
+			}
+		}
+
+		if (GLEW_KHR_parallel_shader_compile)
+		{
+			// Let the driver pick its own thread count.
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		}
+
+		for (size_t i = 0; i < requests.size(); ++i)
+		{
+			const ShaderRequest& request = requests[i];
+			if (sources[i].Vertex.empty() || sources[i].Fragment.empty())
+			{
+				Logger::Log(LogLevel::Fatal, "Shader file(s) missing for: " + request.Name);
+				continue;
+			}
+
+			Shader* shader = AddVariants(request.Name, sources[i])->Build(0);
+			if (shader->GetStatus() == ShaderStatus::Compiling)
+			{
+				s_Pending.push_back(shader);
+			}
+		}
+	}
+
+	void ShaderRegistry::Update(uint32_t maxBlockingPolls)
+	{
+		for (auto& [name, variants] : s_Variants)
+		{
+			variants->BuildRequested(s_Pending);
+		}
+
+		const bool nonBlocking = GLEW_KHR_parallel_shader_compile;
+		uint32_t polls = 0;
+
+		auto finished = [&](Shader* shader)
+			{
+				if (!nonBlocking && polls >= maxBlockingPolls)
+				{
+					return false;
+				}
+
+				polls++;
+				return shader->Poll();
+			};
+
+		s_Pending.erase(std::remove_if(s_Pending.begin(), s_Pending.end(), finished), s_Pending.end());
+	}
+
+	void ShaderRegistry::WaitForAll()
+	{
+		for (Shader* shader : s_Pending)
+		{
+			shader->Poll(true);
+		}
+		s_Pending.clear();
+	}
+
+	size_t ShaderRegistry::GetPendingCount()
+	{
+		return s_Pending.size();
+	}
+
+	Shader* ShaderRegistry::GetPlaceholder()
+	{
+		return s_Placeholder && s_Placeholder->IsValid() ? s_Placeholder.get() : nullptr;
 	}
 
 	void ShaderRegistry::Clear()
 	{
+		s_Pending.clear();
 		s_ShaderCache.clear();
-		s_NameMap.clear();
+		s_Variants.clear();
+		s_Generation++;
+		s_Placeholder.reset();
 	}
 }
\ No newline at end of file
@@ -5,25 +5,71 @@
 
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include <cstdint>
 #include "Shader.h"
+#include "ShaderVariants.h"
 
 namespace Orca
 {
 #pragma warning(push)
 #pragma warning(disable: 4251)
 
+	struct ShaderRequest
+	{
+		std::string Name;
+		std::string VertexPath;
+		std::string FragmentPath;
+	};
+
 	class ShaderRegistry
 	{
 	public:
+		// Names registered here get a ShaderVariantSet; only the keyword-free variant is built up front.
 		static void Preload(const std::string& name, const std::string& vertPath, const std::string& fragPath);
+
+		// Reads and preprocesses sources on the job system, then issues every compile and link
+		// before any status query. Names resolve immediately; Get() hands out shaders that may
+		// still be compiling and Material falls back to GetPlaceholder() until they are ready.
+		static void PreloadAsync(const std::vector<ShaderRequest>& requests);
+
+		// Registers the name's variants without building any of them, so it touches no GL state.
+		// Materials using it get a program key for sorting and batching, which is all a headless
+		// RenderSystem::Record needs; Render() skips them until a program has been built.
+		static ShaderVariantSet* Register(const std::string& name, const ShaderSource& source);
+
+		// GL thread, once per frame. Starts variants requested since the last frame and finishes
+		// whatever the driver has completed. Without GL_KHR_parallel_shader_compile each poll
+		// blocks, so at most maxBlockingPolls run.
+		static void Update(uint32_t maxBlockingPolls = 4);
+		static void WaitForAll();
+		static size_t GetPendingCount();
+
+		// Flat-colored program built synchronously on the first PreloadAsync.
+		static Shader* GetPlaceholder();
+
 		static Shader* Load(const std::string& v_path, const std::string& f_path);
+		// The keyword-free variant.
 		static Shader* Get(const std::string& name);
+		// Like Get, without the warning; for optional shaders looked up every frame.
+		static Shader* Find(const std::string& name);
+		static ShaderVariantSet* GetVariants(const std::string& name);
+		// Like GetVariants, without the warning when the name isn't registered.
+		static ShaderVariantSet* FindVariants(const std::string& name);
 		static void Clear();
 
+		// Changes whenever a name is registered again or the registry is cleared, which replaces
+		// or frees variant sets. Lets callers hold on to a ShaderVariantSet* between frames.
+		static uint32_t GetGeneration() { return s_Generation; }
+
 	private:
 		static std::unordered_map<std::string, std::unique_ptr<Shader>> s_ShaderCache;
-		static std::unordered_map<std::string, Shader*> s_NameMap;
+		static std::unordered_map<std::string, std::unique_ptr<ShaderVariantSet>> s_Variants;
+		static std::vector<Shader*> s_Pending;
+		static std::unique_ptr<Shader> s_Placeholder;
+		static uint32_t s_Generation;
 		static std::string MakeKey(const std::string& vert, const std::string& frag);
+		static ShaderVariantSet* AddVariants(const std::string& name, const ShaderSource& source);
 	};
 #pragma warning(pop)
 }
@@ -0,0 +1,205 @@
+#include "ShaderTranspileCache.h"
+#include "../Core/Logger.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint32_t k_Magic = 0x4354534F;	// "OSTC"
+		constexpr uint32_t k_FormatVersion = 1;
+
+		struct EntryHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t Key;
+			uint32_t OutputLength;
+			uint32_t BinaryWords;
+		};
+
+		uint64_t HashString(uint64_t hash, const std::string& value)
+		{
+			for (unsigned char c : value)
+			{
+				hash ^= c;
+				hash *= 1099511628211ull;
+			}
+
+			// Terminate each field so ("ab", "c") and ("a", "bc") differ.
+			hash ^= 0xFF;
+			hash *= 1099511628211ull;
+			return hash;
+		}
+
+		uint64_t HashSettings(ShaderTarget target, bool validated)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			hash = HashString(hash, std::to_string(ShaderTranspiler::k_Version));
+			hash = HashString(hash, std::to_string(static_cast<int>(target)));
+			return HashString(hash, validated ? "validated" : "");
+		}
+	}
+
+	std::mutex ShaderTranspileCache::s_Mutex;
+	std::string ShaderTranspileCache::s_Directory;
+	bool ShaderTranspileCache::s_Enabled = false;
+
+	void ShaderTranspileCache::Initialize(const std::string& directory)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		s_Enabled = false;
+		s_Directory = directory;
+
+		if (directory.empty())
+		{
+			return;
+		}
+
+		std::error_code error;
+		fs::create_directories(directory, error);
+		if (error)
+		{
+			Logger::Log(LogLevel::Warning, "Can't create transpilation cache directory " + directory + ": " + error.message());
+			return;
+		}
+
+		s_Enabled = true;
+	}
+
+	bool ShaderTranspileCache::IsEnabled()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return s_Enabled;
+	}
+
+	uint64_t ShaderTranspileCache::MakeKey(const std::string& source, ShaderTarget target, ShaderStage stage, bool validated)
+	{
+		uint64_t hash = HashSettings(target, validated);
+		hash = HashString(hash, stage == ShaderStage::Vertex ? "vertex" : "fragment");
+		return HashString(hash, source);
+	}
+
+	uint64_t ShaderTranspileCache::MakeProgramKey(const std::string& vertexSource, const std::string& fragmentSource, ShaderTarget target, bool validated)
+	{
+		uint64_t hash = HashSettings(target, validated);
+		hash = HashString(hash, "program");
+		hash = HashString(hash, vertexSource);
+		return HashString(hash, fragmentSource);
+	}
+
+	std::string ShaderTranspileCache::GetEntryPath(uint64_t key)
+	{
+		std::ostringstream name;
+		name << std::hex << std::setw(16) << std::setfill('0') << key << ".ost";
+		return (fs::path(s_Directory) / name.str()).string();
+	}
+
+	bool ShaderTranspileCache::Load(uint64_t key, TranspilationResult& outResult)
+	{
+		std::string path;
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			if (!s_Enabled)
+			{
+				return false;
+			}
+			path = GetEntryPath(key);
+		}
+
+		// Entries are immutable once renamed into place, so reads don't need the lock.
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		EntryHeader header{};
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!file || header.Magic != k_Magic || header.Version != k_FormatVersion || header.Key != key)
+		{
+			return false;
+		}
+
+		TranspilationResult result{ true, std::string(header.OutputLength, '\0'), std::vector<uint32_t>(header.BinaryWords), "" };
+		file.read(result.output.data(), header.OutputLength);
+		file.read(reinterpret_cast<char*>(result.binary.data()), static_cast<std::streamsize>(header.BinaryWords * sizeof(uint32_t)));
+		if (!file)
+		{
+			return false;
+		}
+
+		outResult = std::move(result);
+		return true;
+	}
+
+	void ShaderTranspileCache::Store(uint64_t key, const TranspilationResult& result)
+	{
+		if (!result.success)
+		{
+			return;
+		}
+
+		std::string path;
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			if (!s_Enabled)
+			{
+				return;
+			}
+			path = GetEntryPath(key);
+		}
+
+		EntryHeader header{ k_Magic, k_FormatVersion, key,
+			static_cast<uint32_t>(result.output.size()), static_cast<uint32_t>(result.binary.size()) };
+
+		// Write beside the entry and rename, so a crash never leaves a truncated entry behind. The temp
+		// name is per thread because batch tools may store the same key from two workers at once.
+		std::ostringstream tempPath;
+		tempPath << path << "." << std::this_thread::get_id() << ".tmp";
+		{
+			std::ofstream file(tempPath.str(), std::ios::binary | std::ios::trunc);
+			if (!file.is_open())
+			{
+				Logger::Log(LogLevel::Warning, "Can't write transpilation cache entry: " + tempPath.str());
+				return;
+			}
+
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(result.output.data(), static_cast<std::streamsize>(result.output.size()));
+			file.write(reinterpret_cast<const char*>(result.binary.data()), static_cast<std::streamsize>(result.binary.size() * sizeof(uint32_t)));
+		}
+
+		std::error_code error;
+		fs::rename(tempPath.str(), path, error);
+		if (error)
+		{
+			fs::remove(tempPath.str(), error);
+		}
+	}
+
+	void ShaderTranspileCache::Clear()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (s_Directory.empty())
+		{
+			return;
+		}
+
+		std::error_code error;
+		for (const auto& entry : fs::directory_iterator(s_Directory, error))
+		{
+			if (entry.path().extension() == ".ost")
+			{
+				fs::remove(entry.path(), error);
+			}
+		}
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#ifndef SHADER_TRANSPILE_CACHE_H
+#define SHADER_TRANSPILE_CACHE_H
+
+#include <string>
+#include <cstdint>
+#include <mutex>
+#include "ShaderTranspiler.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Content-addressed on-disk cache of successful TranspilationResults.
+	// Keys hash the GLSL source, target, stage, ShaderTranspiler::k_Version and whether external
+	// validation ran, so editing a shader or the emitter simply misses instead of serving stale code.
+	// Safe to use from several threads; entries are written to a temp file and renamed into place.
+	class ORCA_API ShaderTranspileCache
+	{
+	public:
+		// An empty directory disables the cache.
+		static void Initialize(const std::string& directory);
+		static bool IsEnabled();
+
+		static uint64_t MakeKey(const std::string& source, ShaderTarget target, ShaderStage stage, bool validated);
+
+		// Programs are keyed on both stages because fragment input locations follow the vertex outputs.
+		static uint64_t MakeProgramKey(const std::string& vertexSource, const std::string& fragmentSource, ShaderTarget target, bool validated);
+
+		// Returns false on a miss or a damaged entry.
+		static bool Load(uint64_t key, TranspilationResult& outResult);
+
+		// Failed results are never stored.
+		static void Store(uint64_t key, const TranspilationResult& result);
+
+		static void Clear();
+
+	private:
+		static std::mutex s_Mutex;
+		static std::string s_Directory;
+		static bool s_Enabled;
+
+		static std::string GetEntryPath(uint64_t key);
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -7,437 +7,2565 @@
 
 #define _CRT_SECURE_NO_WARNINGS
 #include "ShaderTranspiler.h"
+#include "ShaderIR.h"
+#include "ShaderTranspileCache.h"
 #include "../Core/Logger.h"
-#include <regex>
 #include <algorithm>
+#include <cstdlib>
+#include <fstream>
 #include <sstream>
+#include <thread>
+#include <map>
+#include <stdexcept>
+#include <unordered_set>
 
 namespace Orca
 {
-	TranspilationResult ShaderTranspiler::Transpile(const std::string& glslSource, ShaderTarget target, ShaderStage stage)
+	namespace
 	{
-		if (glslSource.empty())
+		// Uniforms sit above the vertex buffer slots that stage_in fetches from.
+		constexpr int k_MetalUniformBuffer = 16;
+
+		enum HelperFlags : uint32_t
 		{
-			return { false, "", {}, "Input shader source is empty" };
+			Helper_Inverse = 1 << 0,
+			Helper_SampleShadow = 1 << 1,
+			Helper_SampleArray = 1 << 2,
+			Helper_MatrixTruncate = 1 << 3
+		};
+
+		// Shared by HLSL and MSL: both use floatNxN and m[i][j], and (M^T)^-1 == (M^-1)^T, so the
+		// same cofactor expansion is correct whichever way the matrix is indexed.
+		const char* k_InverseHelpers = R"(float2x2 orca_inverse(float2x2 m)
+{
+	float invDet = 1.0 / (m[0][0] * m[1][1] - m[0][1] * m[1][0]);
+	float2x2 r;
+	r[0][0] = m[1][1] * invDet;
+	r[0][1] = -m[0][1] * invDet;
+	r[1][0] = -m[1][0] * invDet;
+	r[1][1] = m[0][0] * invDet;
+	return r;
+}
+
+float3x3 orca_inverse(float3x3 m)
+{
+	float3x3 r;
+	r[0][0] = m[1][1] * m[2][2] - m[2][1] * m[1][2];
+	r[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+	r[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	r[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	r[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+	r[1][2] = m[1][0] * m[0][2] - m[0][0] * m[1][2];
+	r[2][0] = m[1][0] * m[2][1] - m[2][0] * m[1][1];
+	r[2][1] = m[2][0] * m[0][1] - m[0][0] * m[2][1];
+	r[2][2] = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	return r * (1.0 / (m[0][0] * r[0][0] + m[0][1] * r[1][0] + m[0][2] * r[2][0]));
+}
+
+float4x4 orca_inverse(float4x4 m)
+{
+	float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+	float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+	float invDet = 1.0 / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+	float4x4 r;
+	r[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * invDet;
+	r[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * invDet;
+	r[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * invDet;
+	r[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * invDet;
+	r[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * invDet;
+	r[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * invDet;
+	r[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * invDet;
+	r[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * invDet;
+	r[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * invDet;
+	r[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * invDet;
+	r[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * invDet;
+	r[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * invDet;
+	r[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * invDet;
+	r[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * invDet;
+	r[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * invDet;
+	r[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * invDet;
+	return r;
+}
+
+)";
+
+		const char* k_HLSLShadowHelpers = R"(float orca_SampleShadow(Texture2D<float4> t, SamplerComparisonState s, float3 p) { return t.SampleCmpLevelZero(s, p.xy, p.z); }
+float orca_SampleShadow(Texture2DArray<float4> t, SamplerComparisonState s, float4 p) { return t.SampleCmpLevelZero(s, p.xyz, p.w); }
+float orca_SampleShadow(TextureCube<float4> t, SamplerComparisonState s, float4 p) { return t.SampleCmpLevelZero(s, p.xyz, p.w); }
+
+)";
+
+		const char* k_MetalShadowHelpers = R"(float orca_SampleShadow(depth2d<float> t, sampler s, float3 p) { return t.sample_compare(s, p.xy, p.z); }
+float orca_SampleShadow(depth2d_array<float> t, sampler s, float4 p) { return t.sample_compare(s, p.xy, uint(rint(p.z)), p.w); }
+float orca_SampleShadow(depthcube<float> t, sampler s, float4 p) { return t.sample_compare(s, p.xyz, p.w); }
+
+)";
+
+		const char* k_MetalArrayHelpers = R"(float4 orca_SampleArray(texture2d_array<float> t, sampler s, float3 p) { return t.sample(s, p.xy, uint(rint(p.z))); }
+
+)";
+
+		// GLSL mat3(mat4) keeps the upper-left block; MSL has no such constructor.
+		const char* k_MetalMatrixHelpers = R"(float3x3 orca_float3x3(float4x4 m) { return float3x3(m[0].xyz, m[1].xyz, m[2].xyz); }
+float2x2 orca_float2x2(float4x4 m) { return float2x2(m[0].xy, m[1].xy); }
+float2x2 orca_float2x2(float3x3 m) { return float2x2(m[0].xy, m[1].xy); }
+
+)";
+
+		enum class TextureDim
+		{
+			Tex1D,
+			Tex2D,
+			Tex3D,
+			Cube,
+			Tex2DArray,
+			CubeArray,
+			Buffer,
+			Tex2DMS
+		};
+
+		struct SamplerInfo
+		{
+			TextureDim Dim = TextureDim::Tex2D;
+			bool Shadow = false;
+			std::string Component = "float";
+		};
+
+		bool GetSamplerInfo(std::string_view type, SamplerInfo& out)
+		{
+			out = SamplerInfo();
+			if (type.size() > 2 && type.compare(type.size() - 2, 2, "[]") == 0)
+			{
+				return false;
+			}
+
+			if (!type.empty() && (type[0] == 'i' || type[0] == 'u'))
+			{
+				out.Component = type[0] == 'i' ? "int" : "uint";
+				type.remove_prefix(1);
+			}
+
+			if (type.compare(0, 7, "sampler") != 0)
+			{
+				return false;
+			}
+			type.remove_prefix(7);
+
+			if (type.size() > 6 && type.compare(type.size() - 6, 6, "Shadow") == 0)
+			{
+				out.Shadow = true;
+				type.remove_suffix(6);
+			}
+
+			if (type == "1D") out.Dim = TextureDim::Tex1D;
+			else if (type == "2D") out.Dim = TextureDim::Tex2D;
+			else if (type == "3D") out.Dim = TextureDim::Tex3D;
+			else if (type == "Cube") out.Dim = TextureDim::Cube;
+			else if (type == "2DArray") out.Dim = TextureDim::Tex2DArray;
+			else if (type == "CubeArray") out.Dim = TextureDim::CubeArray;
+			else if (type == "Buffer") out.Dim = TextureDim::Buffer;
+			else if (type == "2DMS") out.Dim = TextureDim::Tex2DMS;
+			else return false;
+
+			return true;
+		}
+
+		bool IsOpaqueType(std::string_view type)
+		{
+			SamplerInfo info;
+			return GetSamplerInfo(type, info);
+		}
+
+		bool NeedsSamplerState(const SamplerInfo& info)
+		{
+			return info.Dim != TextureDim::Buffer && info.Dim != TextureDim::Tex2DMS;
+		}
+
+		bool IsScalarType(std::string_view type)
+		{
+			return type == "float" || type == "int" || type == "uint" || type == "bool" || type == "double";
+		}
+
+		bool IsMatrixType(std::string_view type)
+		{
+			return type.compare(0, 3, "mat") == 0 || type.compare(0, 4, "dmat") == 0;
+		}
+
+		// 1 for scalars, N for vecN and friends, 0 for everything else.
+		int GetVectorSize(std::string_view type)
+		{
+			if (IsScalarType(type))
+			{
+				return 1;
+			}
+
+			const size_t pos = type.find("vec");
+			if (pos != std::string_view::npos && pos <= 1 && type.size() == pos + 4)
+			{
+				return type.back() - '0';
+			}
+			return 0;
+		}
+
+		std::string GetComponentType(std::string_view type)
+		{
+			if (IsScalarType(type))
+			{
+				return std::string(type);
+			}
+
+			switch (type.empty() ? 'v' : type[0])
+			{
+			case 'i': return "int";
+			case 'u': return "uint";
+			case 'b': return "bool";
+			case 'd': return "double";
+			default: return "float";
+			}
+		}
+
+		std::string MakeVectorType(const std::string& component, int size)
+		{
+			if (size <= 1)
+			{
+				return component;
+			}
+
+			const char* prefix = component == "int" ? "i" : component == "uint" ? "u" : component == "bool" ? "b" : component == "double" ? "d" : "";
+			return prefix + std::string("vec") + std::to_string(size);
+		}
+
+		void GetMatrixSize(std::string_view type, int& columns, int& rows)
+		{
+			if (type[0] == 'd')
+			{
+				type.remove_prefix(1);
+			}
+			columns = type[3] - '0';
+			rows = type.size() >= 6 ? type[5] - '0' : columns;
+		}
+
+		std::string MakeMatrixType(int columns, int rows)
+		{
+			return columns == rows ? "mat" + std::to_string(columns) : "mat" + std::to_string(columns) + "x" + std::to_string(rows);
+		}
+
+		std::string_view NormalizeTextureFunction(std::string_view name)
+		{
+			if (name == "texture1D" || name == "texture2D" || name == "texture3D" || name == "textureCube")
+			{
+				return "texture";
+			}
+			if (name == "texture2DLod" || name == "texture3DLod" || name == "textureCubeLod")
+			{
+				return "textureLod";
+			}
+			return name;
+		}
+
+		bool IsComparisonFunction(std::string_view name, const char*& op)
+		{
+			if (name == "lessThan") op = " < ";
+			else if (name == "lessThanEqual") op = " <= ";
+			else if (name == "greaterThan") op = " > ";
+			else if (name == "greaterThanEqual") op = " >= ";
+			else if (name == "equal") op = " == ";
+			else if (name == "notEqual") op = " != ";
+			else return false;
+			return true;
+		}
+
+		const char* RenameBuiltin(std::string_view name, ShaderTarget target)
+		{
+			static const std::unordered_map<std::string_view, const char*> hlsl =
+			{
+				{ "mix", "lerp" }, { "fract", "frac" }, { "inversesqrt", "rsqrt" }, { "dFdx", "ddx" }, { "dFdy", "ddy" },
+				{ "dFdxFine", "ddx_fine" }, { "dFdyFine", "ddy_fine" }, { "dFdxCoarse", "ddx_coarse" }, { "dFdyCoarse", "ddy_coarse" },
+				{ "floatBitsToInt", "asint" }, { "floatBitsToUint", "asuint" }, { "intBitsToFloat", "asfloat" }, { "uintBitsToFloat", "asfloat" },
+				{ "bitCount", "countbits" }, { "findLSB", "firstbitlow" }, { "findMSB", "firstbithigh" }, { "bitfieldReverse", "reversebits" },
+				{ "fma", "mad" }, { "roundEven", "round" }
+			};
+			static const std::unordered_map<std::string_view, const char*> metal =
+			{
+				{ "inversesqrt", "rsqrt" }, { "dFdx", "dfdx" }, { "dFdy", "dfdy" }, { "bitCount", "popcount" },
+				{ "findLSB", "ctz" }, { "bitfieldReverse", "reverse_bits" }, { "roundEven", "rint" }
+			};
+
+			const auto& table = target == ShaderTarget::HLSL ? hlsl : metal;
+			auto it = table.find(name);
+			return it != table.end() ? it->second : nullptr;
+		}
+
+		// Walks a ShaderModule once and writes the target language. HLSL keeps GLSL's matrix memory
+		// layout by declaring matrices row_major and swapping multiplication operands, so every
+		// matrix is the transpose of its GLSL counterpart and indexing m[i] still yields column i.
+		class ShaderEmitter
+		{
+		public:
+			ShaderEmitter(const ShaderModule& module, ShaderTarget target, ShaderStage stage, std::unordered_map<std::string, int>& varyingLocations)
+				: m_Module(module), m_Target(target), m_Stage(stage), m_VaryingLocations(varyingLocations),
+				  m_ExprTypes(module.Exprs.size()), m_ExprTypeKnown(module.Exprs.size(), false)
+			{
+				for (const ShaderVariable& variable : module.Globals)
+				{
+					m_Globals[variable.Name] = &variable;
+				}
+
+				for (const ShaderExpr& expr : module.Exprs)
+				{
+					if (expr.Kind == ShaderExprKind::Identifier)
+					{
+						m_UsedNames.insert(expr.Text);
+					}
+				}
+			}
+
+			std::string Emit();
+
+		private:
+			struct StageVariable
+			{
+				std::string Type;		// GLSL type
+				std::string Name;
+				std::string Semantic;	// HLSL semantic or MSL attribute
+				ShaderInterpolation Interpolation = ShaderInterpolation::Smooth;
+				int Location = -1;
+				bool EntryParameter = false;	// MSL builtins passed beside stage_in
+			};
+
+			const ShaderModule& m_Module;
+			ShaderTarget m_Target;
+			ShaderStage m_Stage;
+			std::unordered_map<std::string, int>& m_VaryingLocations;
+
+			std::string m_Out;
+			int m_Indent = 0;
+			uint32_t m_Helpers = 0;
+			std::map<std::string, TextureDim> m_TextureSizeTypes;
+
+			std::unordered_map<std::string_view, const ShaderVariable*> m_Globals;
+			std::unordered_set<std::string_view> m_UsedNames;
+			std::vector<const ShaderVariable*> m_Locals;
+			std::vector<size_t> m_Scopes;
+			std::vector<std::string> m_ExprTypes;
+			std::vector<bool> m_ExprTypeKnown;
+
+			std::vector<const ShaderVariable*> m_Uniforms;
+			std::vector<const ShaderVariable*> m_Samplers;
+			std::vector<StageVariable> m_Inputs;
+			std::vector<StageVariable> m_Outputs;
+
+			void Write(std::string_view text) { m_Out.append(text.data(), text.size()); }
+			void WriteIndent() { m_Out.append(static_cast<size_t>(m_Indent), '\t'); }
+
+			void PushScope() { m_Scopes.push_back(m_Locals.size()); }
+			void PopScope() { m_Locals.resize(m_Scopes.back()); m_Scopes.pop_back(); }
+			const ShaderVariable* FindLocal(std::string_view name) const;
+
+			std::string MapType(std::string_view type) const;
+			std::string GetTextureType(const SamplerInfo& info) const;
+			std::string GetSamplerStateType(const SamplerInfo& info) const;
+			int GetSlotCount(const ShaderVariable& variable) const;
+
+			const std::string& TypeOf(uint32_t index);
+			std::string ComputeType(uint32_t index);
+			std::string GetCallType(const ShaderExpr& expr);
+			std::string GetVariableType(std::string_view name) const;
+			bool IsConstructor(std::string_view name) const;
+			bool IsMatrixProduct(uint32_t left, uint32_t right);
+
+			void CollectResources();
+			bool IsEmittedFirst(const ShaderGlobal& item, size_t itemIndex, size_t firstFunction) const;
+			void EmitGlobal(const ShaderGlobal& item);
+			void EmitStruct(const ShaderStruct& shaderStruct);
+			void EmitResources();
+			void EmitFunction(const ShaderFunction& function);
+			void EmitParameter(const ShaderVariable& parameter);
+			void EmitEntryPoint();
+			void EmitHLSLEntryPoint();
+			void EmitMetalEntryPoint();
+			std::string EmitHelpers() const;
+
+			void EmitDeclarator(const ShaderVariable& variable);
+			void EmitDeclaration(const ShaderStmt& stmt);
+			void EmitStatement(uint32_t index);
+			void EmitBody(uint32_t index);
+
+			void EmitExpression(uint32_t index);
+			void EmitIdentifier(std::string_view name);
+			void EmitLiteral(std::string_view text);
+			void EmitArguments(const std::vector<uint32_t>& operands, size_t first, bool expandSamplers);
+			void EmitCall(uint32_t index);
+			void EmitConstructor(const ShaderExpr& expr);
+			bool EmitTextureCall(const ShaderExpr& expr);
+		};
+
+		const ShaderVariable* ShaderEmitter::FindLocal(std::string_view name) const
+		{
+			for (auto it = m_Locals.rbegin(); it != m_Locals.rend(); ++it)
+			{
+				if ((*it)->Name == name)
+				{
+					return *it;
+				}
+			}
+			return nullptr;
+		}
+
+		std::string ShaderEmitter::MapType(std::string_view type) const
+		{
+			if (m_Target == ShaderTarget::Vulkan)
+			{
+				return std::string(type);
+			}
+
+			SamplerInfo info;
+			if (GetSamplerInfo(type, info))
+			{
+				return GetTextureType(info);
+			}
+
+			const int size = GetVectorSize(type);
+			if (size > 1)
+			{
+				std::string component = GetComponentType(type);
+				if (m_Target == ShaderTarget::Metal && component == "double")
+				{
+					component = "float";
+				}
+				return component + std::to_string(size);
+			}
+
+			if (IsMatrixType(type))
+			{
+				int columns, rows;
+				GetMatrixSize(type, columns, rows);
+				const char* component = type[0] == 'd' && m_Target == ShaderTarget::HLSL ? "double" : "float";
+				return component + std::to_string(columns) + "x" + std::to_string(rows);
+			}
+
+			if (type == "double" && m_Target == ShaderTarget::Metal)
+			{
+				return "float";
+			}
+
+			return std::string(type);
+		}
+
+		std::string ShaderEmitter::GetTextureType(const SamplerInfo& info) const
+		{
+			if (m_Target == ShaderTarget::HLSL)
+			{
+				static const char* names[] = { "Texture1D", "Texture2D", "Texture3D", "TextureCube", "Texture2DArray", "TextureCubeArray", "Buffer", "Texture2DMS" };
+				return names[static_cast<int>(info.Dim)] + ("<" + info.Component + "4>");
+			}
+
+			if (info.Shadow)
+			{
+				static const char* names[] = { "depth2d", "depth2d", "depth2d", "depthcube", "depth2d_array", "depthcube_array", "depth2d", "depth2d_ms" };
+				return names[static_cast<int>(info.Dim)] + std::string("<float>");
+			}
+
+			static const char* names[] = { "texture1d", "texture2d", "texture3d", "texturecube", "texture2d_array", "texturecube_array", "texture_buffer", "texture2d_ms" };
+			return names[static_cast<int>(info.Dim)] + ("<" + info.Component + ">");
+		}
+
+		std::string ShaderEmitter::GetSamplerStateType(const SamplerInfo& info) const
+		{
+			if (m_Target == ShaderTarget::Metal)
+			{
+				return "sampler";
+			}
+			return info.Shadow ? "SamplerComparisonState" : "SamplerState";
+		}
+
+		int ShaderEmitter::GetSlotCount(const ShaderVariable& variable) const
+		{
+			int slots = 1;
+			if (IsMatrixType(variable.Type))
+			{
+				int rows;
+				GetMatrixSize(variable.Type, slots, rows);
+			}
+
+			if (variable.IsArray && variable.ArraySize != k_InvalidShaderIndex)
+			{
+				const ShaderExpr& size = m_Module.Exprs[variable.ArraySize];
+				if (size.Kind == ShaderExprKind::Literal)
+				{
+					slots *= std::max(1, std::atoi(std::string(size.Text).c_str()));
+				}
+			}
+			return slots;
+		}
+
+		const std::string& ShaderEmitter::TypeOf(uint32_t index)
+		{
+			// Each expression node appears once in the tree, so its type never depends on where it is asked from.
+			if (!m_ExprTypeKnown[index])
+			{
+				m_ExprTypes[index] = ComputeType(index);
+				m_ExprTypeKnown[index] = true;
+			}
+			return m_ExprTypes[index];
+		}
+
+		std::string ShaderEmitter::GetVariableType(std::string_view name) const
+		{
+			const ShaderVariable* variable = FindLocal(name);
+			if (!variable)
+			{
+				auto it = m_Globals.find(name);
+				variable = it != m_Globals.end() ? it->second : nullptr;
+			}
+
+			if (variable)
+			{
+				return std::string(variable->Type) + (variable->IsArray ? "[]" : "");
+			}
+
+			if (name == "gl_Position" || name == "gl_FragCoord" || name == "gl_FragColor") return "vec4";
+			if (name == "gl_VertexID" || name == "gl_InstanceID") return "int";
+			if (name == "gl_FrontFacing") return "bool";
+			if (name == "gl_FragDepth") return "float";
+			if (name == "gl_PointCoord") return "vec2";
+			return "";
+		}
+
+		bool ShaderEmitter::IsConstructor(std::string_view name) const
+		{
+			return GetVectorSize(name) > 0 || IsMatrixType(name) || m_Module.FindStruct(name) != nullptr;
+		}
+
+		std::string ShaderEmitter::ComputeType(uint32_t index)
+		{
+			const ShaderExpr& expr = m_Module.Exprs[index];
+
+			switch (expr.Kind)
+			{
+			case ShaderExprKind::Literal:
+			{
+				const std::string_view text = expr.Text;
+				if (text == "true" || text == "false")
+				{
+					return "bool";
+				}
+				const bool hex = text.size() > 1 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+				if (!hex && text.find_first_of(".eEfF") != std::string_view::npos)
+				{
+					return "float";
+				}
+				return text.back() == 'u' || text.back() == 'U' ? "uint" : "int";
+			}
+			case ShaderExprKind::Identifier:
+				return GetVariableType(expr.Text);
+			case ShaderExprKind::Paren:
+			case ShaderExprKind::Postfix:
+			case ShaderExprKind::Assign:
+				return TypeOf(expr.Operands[0]);
+			case ShaderExprKind::Prefix:
+				return expr.Text == "!" ? "bool" : TypeOf(expr.Operands[0]);
+			case ShaderExprKind::Ternary:
+			case ShaderExprKind::Sequence:
+				return TypeOf(expr.Operands[1]);
+			case ShaderExprKind::Call:
+				return GetCallType(expr);
+			case ShaderExprKind::Member:
+			{
+				const std::string& base = TypeOf(expr.Operands[0]);
+				if (const ShaderStruct* shaderStruct = m_Module.FindStruct(base))
+				{
+					for (const ShaderVariable& field : shaderStruct->Fields)
+					{
+						if (field.Name == expr.Text)
+						{
+							return std::string(field.Type) + (field.IsArray ? "[]" : "");
+						}
+					}
+					return "";
+				}
+				return GetVectorSize(base) > 0 ? MakeVectorType(GetComponentType(base), static_cast<int>(expr.Text.size())) : "";
+			}
+			case ShaderExprKind::Index:
+			{
+				const std::string& base = TypeOf(expr.Operands[0]);
+				if (base.size() > 2 && base.compare(base.size() - 2, 2, "[]") == 0)
+				{
+					return base.substr(0, base.size() - 2);
+				}
+				if (IsMatrixType(base))
+				{
+					int columns, rows;
+					GetMatrixSize(base, columns, rows);
+					return MakeVectorType(base[0] == 'd' ? "double" : "float", rows);
+				}
+				return GetVectorSize(base) > 1 ? GetComponentType(base) : "";
+			}
+			case ShaderExprKind::Binary:
+			{
+				const std::string_view op = expr.Text;
+				if (op == "==" || op == "!=" || op == "<" || op == ">" || op == "<=" || op == ">=" || op == "&&" || op == "||" || op == "^^")
+				{
+					return "bool";
+				}
+
+				const std::string& left = TypeOf(expr.Operands[0]);
+				const std::string& right = TypeOf(expr.Operands[1]);
+				if (op == "*" && (IsMatrixType(left) || IsMatrixType(right)))
+				{
+					int leftColumns = 0, leftRows = 0, rightColumns = 0, rightRows = 0;
+					if (IsMatrixType(left)) GetMatrixSize(left, leftColumns, leftRows);
+					if (IsMatrixType(right)) GetMatrixSize(right, rightColumns, rightRows);
+
+					if (leftColumns && rightColumns) return MakeMatrixType(rightColumns, leftRows);
+					if (leftColumns && GetVectorSize(right) > 1) return MakeVectorType("float", leftRows);
+					if (rightColumns && GetVectorSize(left) > 1) return MakeVectorType("float", rightColumns);
+				}
+
+				if (IsScalarType(left) && !right.empty())
+				{
+					return right;
+				}
+				return left.empty() ? right : left;
+			}
+			}
+
+			return "";
+		}
+
+		std::string ShaderEmitter::GetCallType(const ShaderExpr& expr)
+		{
+			const std::string_view name = expr.Text;
+			if (IsConstructor(name))
+			{
+				return std::string(name);
+			}
+
+			if (const ShaderFunction* function = m_Module.FindFunction(name))
+			{
+				return std::string(function->ReturnType);
+			}
+
+			if (expr.Operands.empty())
+			{
+				return "";
+			}
+
+			const std::string& first = TypeOf(expr.Operands[0]);
+
+			SamplerInfo info;
+			if (GetSamplerInfo(first, info))
+			{
+				if (name == "textureSize")
+				{
+					switch (info.Dim)
+					{
+					case TextureDim::Tex1D:
+					case TextureDim::Buffer:
+						return "int";
+					case TextureDim::Tex3D:
+					case TextureDim::Tex2DArray:
+					case TextureDim::CubeArray:
+						return "ivec3";
+					default:
+						return "ivec2";
+					}
+				}
+				return info.Shadow ? "float" : MakeVectorType(info.Component, 4);
+			}
+
+			const char* op;
+			if (IsComparisonFunction(name, op))
+			{
+				return MakeVectorType("bool", GetVectorSize(first));
+			}
+			if (name == "dot" || name == "length" || name == "distance" || name == "determinant")
+			{
+				return "float";
+			}
+			if (name == "any" || name == "all")
+			{
+				return "bool";
+			}
+			if (name == "floatBitsToInt" || name == "floatBitsToUint" || name == "intBitsToFloat" || name == "uintBitsToFloat")
+			{
+				const char* component = name == "floatBitsToInt" ? "int" : name == "floatBitsToUint" ? "uint" : "float";
+				return MakeVectorType(component, GetVectorSize(first));
+			}
+
+			// Component-wise builtins take the shape of their widest argument, e.g. mix(vec3, vec3, float).
+			for (uint32_t operand : expr.Operands)
+			{
+				const std::string& type = TypeOf(operand);
+				if (GetVectorSize(type) > 1 || IsMatrixType(type))
+				{
+					return type;
+				}
+			}
+			return first;
+		}
+
+		bool ShaderEmitter::IsMatrixProduct(uint32_t left, uint32_t right)
+		{
+			if (m_Target != ShaderTarget::HLSL)
+			{
+				return false;
+			}
+
+			const std::string& leftType = TypeOf(left);
+			const std::string& rightType = TypeOf(right);
+			return (IsMatrixType(leftType) || IsMatrixType(rightType)) && !leftType.empty() && !rightType.empty() &&
+				!IsScalarType(leftType) && !IsScalarType(rightType);
+		}
+
+		void ShaderEmitter::CollectResources()
+		{
+			const bool vertex = m_Stage == ShaderStage::Vertex;
+			const bool metal = m_Target == ShaderTarget::Metal;
+			int inputLocation = 0;
+			int outputLocation = 0;
+
+			for (const ShaderVariable& variable : m_Module.Globals)
+			{
+				if (variable.Storage == ShaderStorage::Uniform)
+				{
+					if (IsOpaqueType(variable.Type) && variable.IsArray)
+					{
+						throw std::runtime_error("Sampler arrays are not supported: " + std::string(variable.Name));
+					}
+					(IsOpaqueType(variable.Type) ? m_Samplers : m_Uniforms).push_back(&variable);
+					continue;
+				}
+
+				if (variable.Storage != ShaderStorage::In && variable.Storage != ShaderStorage::Out)
+				{
+					continue;
+				}
+
+				StageVariable stageVariable;
+				stageVariable.Type = variable.Type;
+				stageVariable.Name = variable.Name;
+				stageVariable.Interpolation = variable.Interpolation;
+
+				if (variable.Storage == ShaderStorage::In && vertex)
+				{
+					stageVariable.Location = variable.Location >= 0 ? variable.Location : inputLocation;
+					inputLocation = stageVariable.Location + GetSlotCount(variable);
+					stageVariable.Semantic = metal ? "attribute(" + std::to_string(stageVariable.Location) + ")" : "TEXCOORD" + std::to_string(stageVariable.Location);
+					m_Inputs.push_back(stageVariable);
+				}
+				else if (variable.Storage == ShaderStorage::Out && !vertex)
+				{
+					stageVariable.Location = variable.Location >= 0 ? variable.Location : outputLocation;
+					outputLocation = stageVariable.Location + 1;
+					stageVariable.Semantic = metal ? "color(" + std::to_string(stageVariable.Location) + ")" : "SV_Target" + std::to_string(stageVariable.Location);
+					m_Outputs.push_back(stageVariable);
+				}
+				else
+				{
+					// Varyings: HLSL and MSL link them by name, Vulkan by location.
+					std::vector<StageVariable>& list = variable.Storage == ShaderStorage::Out ? m_Outputs : m_Inputs;
+					int& nextLocation = variable.Storage == ShaderStorage::Out ? outputLocation : inputLocation;
+
+					auto known = m_VaryingLocations.find(stageVariable.Name);
+					stageVariable.Location = known != m_VaryingLocations.end() ? known->second : variable.Location >= 0 ? variable.Location : nextLocation;
+					nextLocation = std::max(nextLocation, stageVariable.Location + GetSlotCount(variable));
+					if (vertex)
+					{
+						m_VaryingLocations[stageVariable.Name] = stageVariable.Location;
+					}
+
+					stageVariable.Semantic = metal ? "user(" + stageVariable.Name + ")" : stageVariable.Name;
+					if (metal && !vertex && variable.Interpolation == ShaderInterpolation::Flat)
+					{
+						stageVariable.Semantic += ", flat";
+					}
+					else if (metal && !vertex && variable.Interpolation == ShaderInterpolation::NoPerspective)
+					{
+						stageVariable.Semantic += ", center_no_perspective";
+					}
+					list.push_back(stageVariable);
+				}
+			}
+
+			if (m_Target == ShaderTarget::Vulkan)
+			{
+				return;
+			}
+
+			auto addBuiltin = [&](std::vector<StageVariable>& list, const char* type, const char* name, const char* hlsl, const char* msl, bool parameter, bool front)
+			{
+				StageVariable builtin;
+				builtin.Type = type;
+				builtin.Name = name;
+				builtin.Semantic = metal ? msl : hlsl;
+				builtin.EntryParameter = metal && parameter;
+				list.insert(front ? list.begin() : list.end(), builtin);
+			};
+
+			if (vertex)
+			{
+				addBuiltin(m_Outputs, "vec4", "gl_Position", "SV_Position", "position", false, true);
+				if (m_UsedNames.count("gl_VertexID")) addBuiltin(m_Inputs, "int", "gl_VertexID", "SV_VertexID", "vertex_id", true, false);
+				if (m_UsedNames.count("gl_InstanceID")) addBuiltin(m_Inputs, "int", "gl_InstanceID", "SV_InstanceID", "instance_id", true, false);
+			}
+			else
+			{
+				// Always present so the pixel shader input signature lines up with the vertex output.
+				addBuiltin(m_Inputs, "vec4", "gl_FragCoord", "SV_Position", "position", false, true);
+				if (m_UsedNames.count("gl_FrontFacing")) addBuiltin(m_Inputs, "bool", "gl_FrontFacing", "SV_IsFrontFace", "front_facing", true, false);
+				if (m_UsedNames.count("gl_FragColor")) addBuiltin(m_Outputs, "vec4", "gl_FragColor", "SV_Target0", "color(0)", false, false);
+				if (m_UsedNames.count("gl_FragDepth")) addBuiltin(m_Outputs, "float", "gl_FragDepth", "SV_Depth", "depth(any)", false, false);
+			}
+		}
+
+		bool ShaderEmitter::IsEmittedFirst(const ShaderGlobal& item, size_t itemIndex, size_t firstFunction) const
+		{
+			// Structs, constants and the directives around them go ahead of the uniform declarations,
+			// which may size arrays with those constants.
+			switch (item.Kind)
+			{
+			case ShaderGlobalKind::Directive:
+				return itemIndex < firstFunction;
+			case ShaderGlobalKind::Struct:
+				return true;
+			case ShaderGlobalKind::Variable:
+				return m_Module.Globals[item.Index].IsConst;
+			default:
+				return false;
+			}
+		}
+
+		std::string ShaderEmitter::Emit()
+		{
+			CollectResources();
+
+			const std::vector<ShaderGlobal>& items = m_Module.Items;
+			size_t firstFunction = items.size();
+			for (size_t i = 0; i < items.size(); ++i)
+			{
+				if (items[i].Kind == ShaderGlobalKind::Function)
+				{
+					firstFunction = i;
+					break;
+				}
+			}
+
+			m_Out.reserve(m_Module.Exprs.size() * 16);
+
+			for (size_t i = 0; i < items.size(); ++i)
+			{
+				if (IsEmittedFirst(items[i], i, firstFunction))
+				{
+					EmitGlobal(items[i]);
+				}
+			}
+
+			if (m_Out.size() >= 2 && m_Out.compare(m_Out.size() - 2, 2, "\n\n") != 0)
+			{
+				Write("\n");
+			}
+
+			EmitResources();
+
+			for (size_t i = 0; i < items.size(); ++i)
+			{
+				if (!IsEmittedFirst(items[i], i, firstFunction))
+				{
+					EmitGlobal(items[i]);
+				}
+			}
+
+			if (m_Target == ShaderTarget::Metal)
+			{
+				m_Indent--;
+				Write("};\n\n");
+			}
+
+			EmitEntryPoint();
+
+			std::string prologue;
+			switch (m_Target)
+			{
+			case ShaderTarget::HLSL:
+				prologue = ShaderTranspiler::GetTargetVersionString(ShaderTarget::HLSL) + "\n\n";
+				break;
+			case ShaderTarget::Metal:
+				prologue = ShaderTranspiler::GetTargetVersionString(ShaderTarget::Metal) + "\n#include <metal_stdlib>\nusing namespace metal;\n\n";
+				break;
+			default:
+				prologue = ShaderTranspiler::GetTargetVersionString(m_Target) + "\n\n";
+				break;
+			}
+
+			return prologue + EmitHelpers() + m_Out;
+		}
+
+		std::string ShaderEmitter::EmitHelpers() const
+		{
+			std::string helpers;
+
+			if (m_Helpers & Helper_Inverse)
+			{
+				helpers += k_InverseHelpers;
+			}
+			if (m_Helpers & Helper_SampleShadow)
+			{
+				helpers += m_Target == ShaderTarget::HLSL ? k_HLSLShadowHelpers : k_MetalShadowHelpers;
+			}
+			if (m_Helpers & Helper_SampleArray)
+			{
+				helpers += k_MetalArrayHelpers;
+			}
+			if (m_Helpers & Helper_MatrixTruncate)
+			{
+				helpers += k_MetalMatrixHelpers;
+			}
+
+			// HLSL reads sizes through out parameters, so textureSize() needs a function per texture type.
+			for (const auto& [type, dim] : m_TextureSizeTypes)
+			{
+				switch (dim)
+				{
+				case TextureDim::Tex1D:
+					helpers += "int orca_TextureSize(" + type + " t, int lod) { uint w, levels; t.GetDimensions(lod, w, levels); return int(w); }\n";
+					break;
+				case TextureDim::Tex2D:
+				case TextureDim::Cube:
+					helpers += "int2 orca_TextureSize(" + type + " t, int lod) { uint w, h, levels; t.GetDimensions(lod, w, h, levels); return int2(w, h); }\n";
+					break;
+				case TextureDim::Tex3D:
+				case TextureDim::Tex2DArray:
+				case TextureDim::CubeArray:
+					helpers += "int3 orca_TextureSize(" + type + " t, int lod) { uint w, h, d, levels; t.GetDimensions(lod, w, h, d, levels); return int3(w, h, d); }\n";
+					break;
+				case TextureDim::Buffer:
+					helpers += "int orca_TextureSize(" + type + " t) { uint w; t.GetDimensions(w); return int(w); }\n";
+					break;
+				case TextureDim::Tex2DMS:
+					helpers += "int2 orca_TextureSize(" + type + " t) { uint w, h, samples; t.GetDimensions(w, h, samples); return int2(w, h); }\n";
+					break;
+				}
+			}
+			if (!m_TextureSizeTypes.empty())
+			{
+				helpers += "\n";
+			}
+
+			return helpers;
+		}
+
+		void ShaderEmitter::EmitGlobal(const ShaderGlobal& item)
+		{
+			switch (item.Kind)
+			{
+			case ShaderGlobalKind::Directive:
+			{
+				const std::string_view directive = m_Module.Directives[item.Index];
+				if (m_Target != ShaderTarget::Vulkan && directive.find("extension") != std::string_view::npos)
+				{
+					return;
+				}
+				Write(directive);
+				Write("\n");
+				return;
+			}
+			case ShaderGlobalKind::Struct:
+				EmitStruct(m_Module.Structs[item.Index]);
+				return;
+			case ShaderGlobalKind::Function:
+				EmitFunction(m_Module.Functions[item.Index]);
+				return;
+			case ShaderGlobalKind::Variable:
+				break;
+			}
+
+			const ShaderVariable& variable = m_Module.Globals[item.Index];
+			if (variable.Storage != ShaderStorage::None)
+			{
+				return;
+			}
+
+			WriteIndent();
+			if (variable.IsConst)
+			{
+				Write(m_Target == ShaderTarget::HLSL ? "static const " : m_Target == ShaderTarget::Metal ? "constant " : "const ");
+			}
+			else if (m_Target == ShaderTarget::HLSL)
+			{
+				Write("static ");
+			}
+
+			EmitDeclarator(variable);
+			if (variable.Initializer != k_InvalidShaderIndex)
+			{
+				Write(" = ");
+				EmitExpression(variable.Initializer);
+			}
+			Write(";\n");
+		}
+
+		void ShaderEmitter::EmitStruct(const ShaderStruct& shaderStruct)
+		{
+			Write("struct ");
+			Write(shaderStruct.Name);
+			Write("\n{\n");
+			for (const ShaderVariable& field : shaderStruct.Fields)
+			{
+				Write("\t");
+				if (m_Target == ShaderTarget::HLSL && IsMatrixType(field.Type))
+				{
+					Write("row_major ");
+				}
+				EmitDeclarator(field);
+				Write(";\n");
+			}
+			Write("};\n\n");
+
+			if (m_Target != ShaderTarget::HLSL)
+			{
+				return;
+			}
+
+			// HLSL has no struct constructors; S(a, b) becomes S_ctor(a, b).
+			Write(shaderStruct.Name);
+			Write(" ");
+			Write(shaderStruct.Name);
+			Write("_ctor(");
+			for (size_t i = 0; i < shaderStruct.Fields.size(); ++i)
+			{
+				Write(i > 0 ? ", " : "");
+				EmitDeclarator(shaderStruct.Fields[i]);
+			}
+			Write(")\n{\n\t");
+			Write(shaderStruct.Name);
+			Write(" result;\n");
+			for (const ShaderVariable& field : shaderStruct.Fields)
+			{
+				Write("\tresult.");
+				Write(field.Name);
+				Write(" = ");
+				Write(field.Name);
+				Write(";\n");
+			}
+			Write("\treturn result;\n}\n\n");
+		}
+
+		void ShaderEmitter::EmitResources()
+		{
+			if (m_Target == ShaderTarget::Vulkan)
+			{
+				if (!m_Uniforms.empty())
+				{
+					Write("layout(set = 0, binding = 0, std140) uniform Uniforms\n{\n");
+					for (const ShaderVariable* uniform : m_Uniforms)
+					{
+						Write("\t");
+						EmitDeclarator(*uniform);
+						Write(";\n");
+					}
+					Write("};\n\n");
+				}
+
+				int binding = 1;
+				for (const ShaderVariable* sampler : m_Samplers)
+				{
+					Write("layout(set = 0, binding = " + std::to_string(binding++) + ") uniform ");
+					EmitDeclarator(*sampler);
+					Write(";\n");
+				}
+
+				for (int pass = 0; pass < 2; ++pass)
+				{
+					for (const StageVariable& stageVariable : pass == 0 ? m_Inputs : m_Outputs)
+					{
+						Write("layout(location = " + std::to_string(stageVariable.Location) + ") ");
+						Write(stageVariable.Interpolation == ShaderInterpolation::Flat ? "flat " : stageVariable.Interpolation == ShaderInterpolation::NoPerspective ? "noperspective " : "");
+						Write(pass == 0 ? "in " : "out ");
+						EmitDeclarator(*m_Globals[stageVariable.Name]);
+						Write(";\n");
+					}
+				}
+				Write("\n");
+				return;
+			}
+
+			if (m_Target == ShaderTarget::HLSL)
+			{
+				if (!m_Uniforms.empty())
+				{
+					Write("cbuffer Uniforms : register(b0)\n{\n");
+					for (const ShaderVariable* uniform : m_Uniforms)
+					{
+						Write(IsMatrixType(uniform->Type) ? "\trow_major " : "\t");
+						EmitDeclarator(*uniform);
+						Write(";\n");
+					}
+					Write("};\n\n");
+				}
+
+				int textureRegister = 0;
+				int samplerRegister = 0;
+				for (const ShaderVariable* sampler : m_Samplers)
+				{
+					SamplerInfo info;
+					GetSamplerInfo(sampler->Type, info);
+					Write(GetTextureType(info) + " ");
+					Write(sampler->Name);
+					Write(" : register(t" + std::to_string(textureRegister++) + ");\n");
+					if (NeedsSamplerState(info))
+					{
+						Write(GetSamplerStateType(info) + " ");
+						Write(sampler->Name);
+						Write("_Sampler : register(s" + std::to_string(samplerRegister++) + ");\n");
+					}
+				}
+				if (!m_Samplers.empty())
+				{
+					Write("\n");
+				}
+
+				for (int pass = 0; pass < 2; ++pass)
+				{
+					for (const StageVariable& stageVariable : pass == 0 ? m_Inputs : m_Outputs)
+					{
+						Write("static " + MapType(stageVariable.Type) + " " + stageVariable.Name + ";\n");
+					}
+				}
+				Write("\n");
+				return;
+			}
+
+			// MSL has no globals outside the constant address space, so the shader becomes a struct whose
+			// members are the GLSL globals and whose methods are the GLSL functions.
+			if (!m_Uniforms.empty())
+			{
+				Write("struct Orca_Uniforms\n{\n");
+				for (const ShaderVariable* uniform : m_Uniforms)
+				{
+					Write("\t");
+					EmitDeclarator(*uniform);
+					Write(";\n");
+				}
+				Write("};\n\n");
+			}
+
+			Write("struct Orca_Shader\n{\n");
+			m_Indent++;
+
+			if (!m_Uniforms.empty())
+			{
+				Write("\tconstant Orca_Uniforms* uniforms;\n");
+			}
+
+			for (const ShaderVariable* sampler : m_Samplers)
+			{
+				SamplerInfo info;
+				GetSamplerInfo(sampler->Type, info);
+				Write("\t" + GetTextureType(info) + " ");
+				Write(sampler->Name);
+				Write(";\n");
+				if (NeedsSamplerState(info))
+				{
+					Write("\tsampler ");
+					Write(sampler->Name);
+					Write("_Sampler;\n");
+				}
+			}
+
+			for (int pass = 0; pass < 2; ++pass)
+			{
+				for (const StageVariable& stageVariable : pass == 0 ? m_Inputs : m_Outputs)
+				{
+					Write("\t" + MapType(stageVariable.Type) + " " + stageVariable.Name + ";\n");
+				}
+			}
+			Write("\n");
+		}
+
+		void ShaderEmitter::EmitFunction(const ShaderFunction& function)
+		{
+			// Methods of Orca_Shader can call each other in any order.
+			if (m_Target == ShaderTarget::Metal && function.Body == k_InvalidShaderIndex)
+			{
+				return;
+			}
+
+			const bool renameMain = m_Target != ShaderTarget::Vulkan && function.Name == "main";
+
+			WriteIndent();
+			Write(MapType(function.ReturnType));
+			Write(" ");
+			Write(renameMain ? "orca_main" : function.Name);
+			Write("(");
+			for (size_t i = 0; i < function.Parameters.size(); ++i)
+			{
+				Write(i > 0 ? ", " : "");
+				EmitParameter(function.Parameters[i]);
+			}
+			Write(")");
+
+			if (function.Body == k_InvalidShaderIndex)
+			{
+				Write(";\n\n");
+				return;
+			}
+
+			Write("\n");
+			PushScope();
+			for (const ShaderVariable& parameter : function.Parameters)
+			{
+				m_Locals.push_back(&parameter);
+			}
+			EmitStatement(function.Body);
+			PopScope();
+			Write("\n");
+		}
+
+		void ShaderEmitter::EmitParameter(const ShaderVariable& parameter)
+		{
+			SamplerInfo info;
+			if (m_Target != ShaderTarget::Vulkan && GetSamplerInfo(parameter.Type, info))
+			{
+				Write(GetTextureType(info) + " ");
+				Write(parameter.Name);
+				if (NeedsSamplerState(info))
+				{
+					Write(", " + GetSamplerStateType(info) + " ");
+					Write(parameter.Name);
+					Write("_Sampler");
+				}
+				return;
+			}
+
+			const bool output = parameter.Storage == ShaderStorage::Out || parameter.Storage == ShaderStorage::InOut;
+			if (parameter.IsConst)
+			{
+				Write("const ");
+			}
+
+			if (m_Target == ShaderTarget::Metal && output)
+			{
+				Write("thread " + MapType(parameter.Type) + "& ");
+				Write(parameter.Name);
+				return;
+			}
+
+			if (output)
+			{
+				Write(parameter.Storage == ShaderStorage::Out ? "out " : "inout ");
+			}
+			EmitDeclarator(parameter);
+		}
+
+		void ShaderEmitter::EmitEntryPoint()
+		{
+			if (m_Target == ShaderTarget::HLSL)
+			{
+				EmitHLSLEntryPoint();
+			}
+			else if (m_Target == ShaderTarget::Metal)
+			{
+				EmitMetalEntryPoint();
+			}
 		}
 
-		if (glslSource.find("{") == std::string::npos || glslSource.find("}") == std::string::npos)
-		{
-			return { false, "", {}, "ERROR: Missing curly braces in shader source. Please fix the problem." };
-		}
+		void ShaderEmitter::EmitHLSLEntryPoint()
+		{
+			const bool vertex = m_Stage == ShaderStage::Vertex;
+
+			for (int pass = 0; pass < 2; ++pass)
+			{
+				const std::vector<StageVariable>& list = pass == 0 ? m_Inputs : m_Outputs;
+				if (list.empty())
+				{
+					continue;
+				}
+
+				Write(pass == 0 ? "struct Orca_StageInput\n{\n" : "struct Orca_StageOutput\n{\n");
+				for (const StageVariable& stageVariable : list)
+				{
+					Write("\t");
+					Write(stageVariable.Interpolation == ShaderInterpolation::Flat ? "nointerpolation " : stageVariable.Interpolation == ShaderInterpolation::NoPerspective ? "noperspective " : "");
+					Write(IsMatrixType(stageVariable.Type) ? "row_major " : "");
+					Write(stageVariable.Semantic == "SV_VertexID" || stageVariable.Semantic == "SV_InstanceID" ? "uint" : MapType(stageVariable.Type));
+					Write(" " + stageVariable.Name + " : " + stageVariable.Semantic + ";\n");
+				}
+				Write("};\n\n");
+			}
+
+			Write(m_Outputs.empty() ? "void main(" : "Orca_StageOutput main(");
+			Write(m_Inputs.empty() ? ")\n{\n" : "Orca_StageInput stageInput)\n{\n");
+			for (const StageVariable& input : m_Inputs)
+			{
+				Write("\t" + input.Name + " = stageInput." + input.Name + ";\n");
+			}
+			Write("\n\torca_main();\n");
+
+			if (m_Outputs.empty())
+			{
+				Write("}\n");
+				return;
+			}
+
+			Write("\n\tOrca_StageOutput stageOutput;\n");
+			for (const StageVariable& output : m_Outputs)
+			{
+				Write("\tstageOutput." + output.Name + " = " + output.Name + ";\n");
+			}
+			if (vertex)
+			{
+				Write("\n\t// GL clip space depth is [-w, w], D3D expects [0, w].\n");
+				Write("\tstageOutput.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;\n");
+			}
+			Write("\treturn stageOutput;\n}\n");
+		}
+
+		void ShaderEmitter::EmitMetalEntryPoint()
+		{
+			const bool vertex = m_Stage == ShaderStage::Vertex;
+
+			bool hasStageIn = false;
+			for (const StageVariable& input : m_Inputs)
+			{
+				hasStageIn |= !input.EntryParameter;
+			}
+
+			if (hasStageIn)
+			{
+				Write("struct Orca_StageIn\n{\n");
+				for (const StageVariable& input : m_Inputs)
+				{
+					if (input.EntryParameter)
+					{
+						continue;
+					}
+
+					if (!IsMatrixType(input.Type))
+					{
+						Write("\t" + MapType(input.Type) + " " + input.Name + " [[" + input.Semantic + "]];\n");
+						continue;
+					}
+
+					// Matrix attributes arrive one column per attribute slot.
+					int columns, rows;
+					GetMatrixSize(input.Type, columns, rows);
+					for (int column = 0; column < columns; ++column)
+					{
+						const std::string semantic = vertex ? "attribute(" + std::to_string(input.Location + column) + ")" : input.Semantic;
+						Write("\tfloat" + std::to_string(rows) + " " + input.Name + "_" + std::to_string(column) + " [[" + semantic + "]];\n");
+					}
+				}
+				Write("};\n\n");
+			}
+
+			if (!m_Outputs.empty())
+			{
+				Write("struct Orca_StageOut\n{\n");
+				for (const StageVariable& output : m_Outputs)
+				{
+					Write("\t" + MapType(output.Type) + " " + output.Name + " [[" + output.Semantic + "]];\n");
+				}
+				Write("};\n\n");
+			}
+
+			Write(vertex ? "vertex " : "fragment ");
+			Write(m_Outputs.empty() ? "void" : "Orca_StageOut");
+			Write(" main0(");
+
+			std::vector<std::string> parameters;
+			if (hasStageIn)
+			{
+				parameters.push_back("Orca_StageIn stageIn [[stage_in]]");
+			}
+			for (const StageVariable& input : m_Inputs)
+			{
+				if (input.EntryParameter)
+				{
+					parameters.push_back((input.Type == "bool" ? "bool " : "uint ") + input.Name + " [[" + input.Semantic + "]]");
+				}
+			}
+			if (!m_Uniforms.empty())
+			{
+				parameters.push_back("constant Orca_Uniforms& uniforms [[buffer(" + std::to_string(k_MetalUniformBuffer) + ")]]");
+			}
+
+			int textureIndex = 0;
+			int samplerIndex = 0;
+			for (const ShaderVariable* sampler : m_Samplers)
+			{
+				SamplerInfo info;
+				GetSamplerInfo(sampler->Type, info);
+				const std::string name(sampler->Name);
+				parameters.push_back(GetTextureType(info) + " " + name + " [[texture(" + std::to_string(textureIndex++) + ")]]");
+				if (NeedsSamplerState(info))
+				{
+					parameters.push_back("sampler " + name + "_Sampler [[sampler(" + std::to_string(samplerIndex++) + ")]]");
+				}
+			}
+
+			for (size_t i = 0; i < parameters.size(); ++i)
+			{
+				Write(i > 0 ? ", " : "");
+				Write(parameters[i]);
+			}
+			Write(")\n{\n\tOrca_Shader shader;\n");
+
+			if (!m_Uniforms.empty())
+			{
+				Write("\tshader.uniforms = &uniforms;\n");
+			}
+			for (const ShaderVariable* sampler : m_Samplers)
+			{
+				SamplerInfo info;
+				GetSamplerInfo(sampler->Type, info);
+				const std::string name(sampler->Name);
+				Write("\tshader." + name + " = " + name + ";\n");
+				if (NeedsSamplerState(info))
+				{
+					Write("\tshader." + name + "_Sampler = " + name + "_Sampler;\n");
+				}
+			}
+
+			for (const StageVariable& input : m_Inputs)
+			{
+				Write("\tshader." + input.Name + " = ");
+				if (input.EntryParameter)
+				{
+					Write(input.Name + ";\n");
+					continue;
+				}
+
+				if (!IsMatrixType(input.Type))
+				{
+					Write("stageIn." + input.Name + ";\n");
+					continue;
+				}
+
+				int columns, rows;
+				GetMatrixSize(input.Type, columns, rows);
+				Write(MapType(input.Type) + "(");
+				for (int column = 0; column < columns; ++column)
+				{
+					Write((column > 0 ? ", stageIn." : "stageIn.") + input.Name + "_" + std::to_string(column));
+				}
+				Write(");\n");
+			}
+
+			Write("\n\tshader.orca_main();\n");
+
+			if (m_Outputs.empty())
+			{
+				Write("}\n");
+				return;
+			}
+
+			Write("\n\tOrca_StageOut stageOut;\n");
+			for (const StageVariable& output : m_Outputs)
+			{
+				Write("\tstageOut." + output.Name + " = shader." + output.Name + ";\n");
+			}
+			if (vertex)
+			{
+				Write("\n\t// GL clip space depth is [-w, w], Metal expects [0, w].\n");
+				Write("\tstageOut.gl_Position.z = (stageOut.gl_Position.z + stageOut.gl_Position.w) * 0.5;\n");
+			}
+			Write("\treturn stageOut;\n}\n");
+		}
+
+		void ShaderEmitter::EmitDeclarator(const ShaderVariable& variable)
+		{
+			Write(MapType(variable.Type));
+			Write(" ");
+			Write(variable.Name);
+			if (variable.IsArray)
+			{
+				Write("[");
+				if (variable.ArraySize != k_InvalidShaderIndex)
+				{
+					EmitExpression(variable.ArraySize);
+				}
+				Write("]");
+			}
+		}
+
+		void ShaderEmitter::EmitDeclaration(const ShaderStmt& stmt)
+		{
+			if (stmt.Variables.front().IsConst)
+			{
+				Write("const ");
+			}
+			Write(MapType(stmt.Variables.front().Type));
+
+			for (size_t i = 0; i < stmt.Variables.size(); ++i)
+			{
+				const ShaderVariable& variable = stmt.Variables[i];
+				Write(i > 0 ? ", " : " ");
+				Write(variable.Name);
+				if (variable.IsArray)
+				{
+					Write("[");
+					if (variable.ArraySize != k_InvalidShaderIndex)
+					{
+						EmitExpression(variable.ArraySize);
+					}
+					Write("]");
+				}
+				if (variable.Initializer != k_InvalidShaderIndex)
+				{
+					Write(" = ");
+					EmitExpression(variable.Initializer);
+				}
+
+				// Declared after the initializer, which still sees any outer variable of the same name.
+				m_Locals.push_back(&variable);
+			}
+		}
+
+		void ShaderEmitter::EmitBody(uint32_t index)
+		{
+			if (m_Module.Stmts[index].Kind == ShaderStmtKind::Block)
+			{
+				EmitStatement(index);
+				return;
+			}
+
+			m_Indent++;
+			EmitStatement(index);
+			m_Indent--;
+		}
+
+		void ShaderEmitter::EmitStatement(uint32_t index)
+		{
+			const ShaderStmt& stmt = m_Module.Stmts[index];
+
+			switch (stmt.Kind)
+			{
+			case ShaderStmtKind::Block:
+				WriteIndent();
+				Write("{\n");
+				m_Indent++;
+				PushScope();
+				for (uint32_t child : stmt.Statements)
+				{
+					EmitStatement(child);
+				}
+				PopScope();
+				m_Indent--;
+				WriteIndent();
+				Write("}\n");
+				break;
+
+			case ShaderStmtKind::Declaration:
+				WriteIndent();
+				EmitDeclaration(stmt);
+				Write(";\n");
+				break;
+
+			case ShaderStmtKind::Expression:
+				WriteIndent();
+				EmitExpression(stmt.Condition);
+				Write(";\n");
+				break;
+
+			case ShaderStmtKind::If:
+				WriteIndent();
+				Write("if (");
+				EmitExpression(stmt.Condition);
+				Write(")\n");
+				EmitBody(stmt.Body);
+				if (stmt.Else != k_InvalidShaderIndex)
+				{
+					WriteIndent();
+					Write("else\n");
+					EmitBody(stmt.Else);
+				}
+				break;
+
+			case ShaderStmtKind::For:
+				PushScope();
+				WriteIndent();
+				Write("for (");
+				if (stmt.Init != k_InvalidShaderIndex)
+				{
+					const ShaderStmt& init = m_Module.Stmts[stmt.Init];
+					if (init.Kind == ShaderStmtKind::Declaration)
+					{
+						EmitDeclaration(init);
+					}
+					else
+					{
+						EmitExpression(init.Condition);
+					}
+				}
+				Write("; ");
+				if (stmt.Condition != k_InvalidShaderIndex)
+				{
+					EmitExpression(stmt.Condition);
+				}
+				Write("; ");
+				if (stmt.Increment != k_InvalidShaderIndex)
+				{
+					EmitExpression(stmt.Increment);
+				}
+				Write(")\n");
+				EmitBody(stmt.Body);
+				PopScope();
+				break;
+
+			case ShaderStmtKind::While:
+				WriteIndent();
+				Write("while (");
+				EmitExpression(stmt.Condition);
+				Write(")\n");
+				EmitBody(stmt.Body);
+				break;
+
+			case ShaderStmtKind::DoWhile:
+				WriteIndent();
+				Write("do\n");
+				EmitBody(stmt.Body);
+				WriteIndent();
+				Write("while (");
+				EmitExpression(stmt.Condition);
+				Write(");\n");
+				break;
+
+			case ShaderStmtKind::Switch:
+				WriteIndent();
+				Write("switch (");
+				EmitExpression(stmt.Condition);
+				Write(")\n");
+				WriteIndent();
+				Write("{\n");
+				PushScope();
+				for (uint32_t child : stmt.Statements)
+				{
+					const ShaderStmt& label = m_Module.Stmts[child];
+					if (label.Kind != ShaderStmtKind::Case)
+					{
+						m_Indent++;
+						EmitStatement(child);
+						m_Indent--;
+						continue;
+					}
+
+					WriteIndent();
+					if (label.Condition == k_InvalidShaderIndex)
+					{
+						Write("default:\n");
+					}
+					else
+					{
+						Write("case ");
+						EmitExpression(label.Condition);
+						Write(":\n");
+					}
+				}
+				PopScope();
+				WriteIndent();
+				Write("}\n");
+				break;
+
+			case ShaderStmtKind::Return:
+				WriteIndent();
+				Write("return");
+				if (stmt.Condition != k_InvalidShaderIndex)
+				{
+					Write(" ");
+					EmitExpression(stmt.Condition);
+				}
+				Write(";\n");
+				break;
+
+			case ShaderStmtKind::Break:
+				WriteIndent();
+				Write("break;\n");
+				break;
+
+			case ShaderStmtKind::Continue:
+				WriteIndent();
+				Write("continue;\n");
+				break;
+
+			case ShaderStmtKind::Discard:
+				WriteIndent();
+				Write(m_Target == ShaderTarget::Metal ? "discard_fragment();\n" : "discard;\n");
+				break;
+
+			case ShaderStmtKind::Directive:
+				Write(m_Module.Directives[stmt.Condition]);
+				Write("\n");
+				break;
+
+			case ShaderStmtKind::Case:
+			case ShaderStmtKind::Empty:
+				WriteIndent();
+				Write(";\n");
+				break;
+			}
+		}
+
+		void ShaderEmitter::EmitExpression(uint32_t index)
+		{
+			const ShaderExpr& expr = m_Module.Exprs[index];
+
+			switch (expr.Kind)
+			{
+			case ShaderExprKind::Literal:
+				EmitLiteral(expr.Text);
+				break;
+
+			case ShaderExprKind::Identifier:
+				EmitIdentifier(expr.Text);
+				break;
+
+			case ShaderExprKind::Paren:
+				Write("(");
+				EmitExpression(expr.Operands[0]);
+				Write(")");
+				break;
 
-		try
-		{
-			TranspilationResult result;
+			case ShaderExprKind::Call:
+				EmitCall(index);
+				break;
 
-			switch (target)
+			case ShaderExprKind::Member:
 			{
-			case ShaderTarget::GLSL:
-				// Already GLSL, minimal conversion
-				result = { true, glslSource, {}, "" };
+				EmitExpression(expr.Operands[0]);
+				Write(".");
+				if (m_Target == ShaderTarget::Vulkan || GetVectorSize(TypeOf(expr.Operands[0])) == 0)
+				{
+					Write(expr.Text);
+					break;
+				}
+
+				// Neither HLSL nor MSL know the stpq swizzle set.
+				std::string swizzle(expr.Text);
+				for (char& c : swizzle)
+				{
+					c = c == 's' ? 'x' : c == 't' ? 'y' : c == 'p' ? 'z' : c == 'q' ? 'w' : c;
+				}
+				Write(swizzle);
 				break;
-			case ShaderTarget::HLSL:
-				result = TranspileToHLSL(glslSource, stage);
+			}
+
+			case ShaderExprKind::Index:
+				EmitExpression(expr.Operands[0]);
+				Write("[");
+				EmitExpression(expr.Operands[1]);
+				Write("]");
 				break;
-			case ShaderTarget::Vulkan:
-				result = TranspileToVulkan(glslSource, stage);
+
+			case ShaderExprKind::Prefix:
+				Write(expr.Text);
+				if (m_Module.Exprs[expr.Operands[0]].Kind == ShaderExprKind::Prefix)
+				{
+					Write(" ");
+				}
+				EmitExpression(expr.Operands[0]);
 				break;
-			case ShaderTarget::Metal:
-				result = TranspileToMetal(glslSource, stage);
+
+			case ShaderExprKind::Postfix:
+				EmitExpression(expr.Operands[0]);
+				Write(expr.Text);
+				break;
+
+			case ShaderExprKind::Binary:
+				if (m_Target != ShaderTarget::Vulkan && expr.Text == "^^")
+				{
+					Write("(");
+					EmitExpression(expr.Operands[0]);
+					Write(" != ");
+					EmitExpression(expr.Operands[1]);
+					Write(")");
+				}
+				else if (expr.Text == "*" && IsMatrixProduct(expr.Operands[0], expr.Operands[1]))
+				{
+					Write("mul(");
+					EmitExpression(expr.Operands[1]);
+					Write(", ");
+					EmitExpression(expr.Operands[0]);
+					Write(")");
+				}
+				else
+				{
+					EmitExpression(expr.Operands[0]);
+					Write(" ");
+					Write(expr.Text);
+					Write(" ");
+					EmitExpression(expr.Operands[1]);
+				}
+				break;
+
+			case ShaderExprKind::Assign:
+				EmitExpression(expr.Operands[0]);
+				if (expr.Text == "*=" && IsMatrixProduct(expr.Operands[0], expr.Operands[1]))
+				{
+					Write(" = mul(");
+					EmitExpression(expr.Operands[1]);
+					Write(", ");
+					EmitExpression(expr.Operands[0]);
+					Write(")");
+					break;
+				}
+				Write(" ");
+				Write(expr.Text);
+				Write(" ");
+				EmitExpression(expr.Operands[1]);
+				break;
+
+			case ShaderExprKind::Ternary:
+				EmitExpression(expr.Operands[0]);
+				Write(" ? ");
+				EmitExpression(expr.Operands[1]);
+				Write(" : ");
+				EmitExpression(expr.Operands[2]);
+				break;
+
+			case ShaderExprKind::Sequence:
+				EmitExpression(expr.Operands[0]);
+				Write(", ");
+				EmitExpression(expr.Operands[1]);
 				break;
-			default:
-				result = { false, "", {}, "Unknown shader target" };
 			}
+		}
 
-			if (result.success)
+		void ShaderEmitter::EmitLiteral(std::string_view text)
+		{
+			if (m_Target != ShaderTarget::Vulkan && text.size() > 2)
 			{
-				Logger::Log(LogLevel::Info, "Shader transpilation successful");
+				const std::string_view suffix = text.substr(text.size() - 2);
+				if (suffix == "lf" || suffix == "LF")
+				{
+					text.remove_suffix(2);
+				}
 			}
-			else
+			Write(text);
+		}
+
+		void ShaderEmitter::EmitIdentifier(std::string_view name)
+		{
+			if (m_Target == ShaderTarget::Vulkan)
 			{
-				Logger::Log(LogLevel::Error, "Shader transpilation failed: " + result.errorMessage);
+				Write(name == "gl_VertexID" ? "gl_VertexIndex" : name == "gl_InstanceID" ? "gl_InstanceIndex" : name);
+				return;
 			}
 
-			return result;
-		}
-		catch (const std::exception& e)
-		{
-			return { false, "", {}, std::string("Transpilation exception: ") + e.what() };
+			if (m_Target == ShaderTarget::Metal && !FindLocal(name))
+			{
+				auto it = m_Globals.find(name);
+				if (it != m_Globals.end() && it->second->Storage == ShaderStorage::Uniform && !IsOpaqueType(it->second->Type))
+				{
+					Write("uniforms->");
+				}
+			}
+			Write(name);
 		}
-	}
 
-	TranspilationResult ShaderTranspiler::TranspileProgram(const std::string& vertexSource, const std::string& fragmentSource, ShaderTarget target)
-	{
-		auto vertResult = Transpile(vertexSource, target, ShaderStage::Vertex);
-		if (!vertResult.success)
+		void ShaderEmitter::EmitArguments(const std::vector<uint32_t>& operands, size_t first, bool expandSamplers)
 		{
-			return vertResult;
+			for (size_t i = first; i < operands.size(); ++i)
+			{
+				Write(i > first ? ", " : "");
+				EmitExpression(operands[i]);
+
+				// Texture parameters take their sampler state as a second argument.
+				SamplerInfo info;
+				if (expandSamplers && GetSamplerInfo(TypeOf(operands[i]), info) && NeedsSamplerState(info))
+				{
+					const ShaderExpr& argument = m_Module.Exprs[operands[i]];
+					if (argument.Kind != ShaderExprKind::Identifier)
+					{
+						throw std::runtime_error("Samplers can only be passed by name");
+					}
+					Write(", ");
+					Write(argument.Text);
+					Write("_Sampler");
+				}
+			}
 		}
 
-		auto fragResult = Transpile(fragmentSource, target, ShaderStage::Fragment);
-		if (!fragResult.success)
+		void ShaderEmitter::EmitCall(uint32_t index)
 		{
-			return fragResult;
-		}
+			const ShaderExpr& expr = m_Module.Exprs[index];
+			const std::string_view name = expr.Text;
+			const std::vector<uint32_t>& args = expr.Operands;
 
-		// Combine results with appropriate separators
-		std::string combined = "// === VERTEX SHADER ===\n" + vertResult.output + 
-							   "\n\n// === FRAGMENT SHADER ===\n" + fragResult.output;
+			if (IsConstructor(name))
+			{
+				EmitConstructor(expr);
+				return;
+			}
 
-		return { true, combined, {}, "" };
-	}
+			if (m_Module.FindFunction(name))
+			{
+				Write(m_Target != ShaderTarget::Vulkan && name == "main" ? "orca_main" : name);
+				Write("(");
+				EmitArguments(args, 0, m_Target != ShaderTarget::Vulkan);
+				Write(")");
+				return;
+			}
 
-	TranspilationResult ShaderTranspiler::TranspileToHLSL(const std::string& glslSource, ShaderStage stage)
-	{
-		std::string cleanedSource = std::regex_replace(glslSource, std::regex(R"(#version\s+\d+\s*\n)"), "");
+			if (EmitTextureCall(expr))
+			{
+				return;
+			}
 
-		std::string converted = ConvertUniformDeclarations(cleanedSource, ShaderTarget::HLSL);
-		converted = ConvertAttributeDeclarations(converted, ShaderTarget::HLSL, stage);
-		converted = ConvertVaryingDeclarations(converted, ShaderTarget::HLSL, stage);
-		converted = ConvertBuiltinFunctions(converted, ShaderTarget::HLSL);
-		converted = ConvertMatrixOperations(converted, ShaderTarget::HLSL);
+			if (m_Target == ShaderTarget::Vulkan)
+			{
+				Write(name);
+				Write("(");
+				EmitArguments(args, 0, false);
+				Write(")");
+				return;
+			}
 
-		converted = ReplaceGLSLBuiltins(converted, ShaderTarget::HLSL, stage);
+			const char* op;
+			if (IsComparisonFunction(name, op) && args.size() == 2)
+			{
+				Write("(");
+				EmitExpression(args[0]);
+				Write(op);
+				EmitExpression(args[1]);
+				Write(")");
+				return;
+			}
 
-		std::string hlsl = GetTargetVersionString(ShaderTarget::HLSL) + "\n";
+			if (name == "not" && args.size() == 1)
+			{
+				Write("(!");
+				EmitExpression(args[0]);
+				Write(")");
+				return;
+			}
 
-		if (hlsl.find("inverse") != std::string::npos) 
-		{
-			hlsl = R"(
-				float4x4 inverse(float4x4 m) {
-					// In a real engine, you'd inject a full matrix inversion here
-					// or pass the inverse matrix as a separate uniform.
-					return m; // Placeholder: this will stop the error but math will be wrong
-				})" + hlsl;
-		}
+			if (name == "mod" && args.size() == 2)
+			{
+				// GLSL mod floors, while fmod in HLSL and MSL truncates.
+				Write("((");
+				EmitExpression(args[0]);
+				Write(") - (");
+				EmitExpression(args[1]);
+				Write(") * floor((");
+				EmitExpression(args[0]);
+				Write(") / (");
+				EmitExpression(args[1]);
+				Write(")))");
+				return;
+			}
 
-		hlsl += converted;
+			if (name == "inverse")
+			{
+				m_Helpers |= Helper_Inverse;
+				Write("orca_inverse");
+			}
+			else if (name == "atan" && args.size() == 2)
+			{
+				Write("atan2");
+			}
+			else if (m_Target == ShaderTarget::Metal && (name == "floatBitsToInt" || name == "floatBitsToUint" || name == "intBitsToFloat" || name == "uintBitsToFloat"))
+			{
+				Write("as_type<" + MapType(TypeOf(index)) + ">");
+			}
+			else if (const char* renamed = RenameBuiltin(name, m_Target))
+			{
+				Write(renamed);
+			}
+			else
+			{
+				Write(name);
+			}
 
-		std::string tempPath = "Saved/ShaderCache/validate.hlsl";
-		std::ofstream outFile(tempPath);
-		if (outFile.is_open()) 
-		{
-			outFile << hlsl;
-			outFile.close();
+			Write("(");
+			EmitArguments(args, 0, false);
+			Write(")");
 		}
 
-		const char* sdkEnv = std::getenv("VULKAN_SDK");
-		std::string sdkPath = sdkEnv ? sdkEnv : "C:/VulkanSDK/default";
+		void ShaderEmitter::EmitConstructor(const ShaderExpr& expr)
+		{
+			const std::string_view type = expr.Text;
+			const std::vector<uint32_t>& args = expr.Operands;
 
-		std::string targetProfile = (stage == ShaderStage::Vertex) ? "vs_6_0" : "ps_6_0";
+			if (m_Target == ShaderTarget::Vulkan)
+			{
+				Write(type);
+				Write("(");
+				EmitArguments(args, 0, false);
+				Write(")");
+				return;
+			}
 
-		std::string cmd = "\"" + sdkPath + "\\Bin\\dxc.exe\" -T " + targetProfile + " -E main " + tempPath;
+			if (m_Module.FindStruct(type))
+			{
+				Write(type);
+				Write(m_Target == ShaderTarget::HLSL ? "_ctor(" : "{");
+				EmitArguments(args, 0, false);
+				Write(m_Target == ShaderTarget::HLSL ? ")" : "}");
+				return;
+			}
 
-		if (std::system(cmd.c_str()) != 0) 
-		{
-			return { false, hlsl, {}, "DXC Validation Failed! Check shader syntax." };
-		}
+			const std::string target = MapType(type);
+			const bool hlsl = m_Target == ShaderTarget::HLSL;
 
-		return { true, hlsl, {}, "" };
-	}
+			if (args.size() == 1)
+			{
+				const std::string& argType = TypeOf(args[0]);
+
+				if (IsMatrixType(type) && IsMatrixType(argType) && argType != type)
+				{
+					// HLSL casts keep the upper-left block like GLSL; MSL goes through a helper.
+					if (!hlsl)
+					{
+						m_Helpers |= Helper_MatrixTruncate;
+					}
+					Write(hlsl ? "((" + target + ")(" : "orca_" + target + "(");
+					EmitExpression(args[0]);
+					Write(hlsl ? "))" : ")");
+					return;
+				}
+
+				if (IsMatrixType(type) && IsScalarType(argType) && hlsl)
+				{
+					int columns, rows;
+					GetMatrixSize(type, columns, rows);
+					Write(target + "(");
+					for (int column = 0; column < columns; ++column)
+					{
+						for (int row = 0; row < rows; ++row)
+						{
+							Write(column + row > 0 ? ", " : "");
+							if (column == row)
+							{
+								EmitExpression(args[0]);
+							}
+							else
+							{
+								Write("0");
+							}
+						}
+					}
+					Write(")");
+					return;
+				}
+
+				const int targetSize = GetVectorSize(type);
+				const int argSize = GetVectorSize(argType);
+
+				if (hlsl && targetSize > 1 && argSize == 1)
+				{
+					// float3(x) does not splat in HLSL.
+					Write("((" + target + ")(");
+					EmitExpression(args[0]);
+					Write("))");
+					return;
+				}
+
+				if (targetSize >= 1 && argSize > targetSize)
+				{
+					if (hlsl && targetSize > 1)
+					{
+						Write("((" + target + ")(");
+						EmitExpression(args[0]);
+						Write("))");
+						return;
+					}
+
+					static const char* swizzles[] = { "", ".x", ".xy", ".xyz" };
+					Write(target + "((");
+					EmitExpression(args[0]);
+					Write(")");
+					Write(swizzles[targetSize]);
+					Write(")");
+					return;
+				}
+			}
 
-	TranspilationResult ShaderTranspiler::TranspileToVulkan(const std::string& glslSource, ShaderStage stage)
-	{
-		std::string output = "#version 450 core\n\n" + glslSource;
-		std::string tempIn = "Saved/ShaderCache/temp_input.glsl";
-		std::string tempOut = "Saved/ShaderCache/temp_input.spv";
+			Write(target + "(");
+			EmitArguments(args, 0, false);
+			Write(")");
+		}
 
-		std::ofstream outFile(tempIn);
-		outFile << output;
-		outFile.close();
+		bool ShaderEmitter::EmitTextureCall(const ShaderExpr& expr)
+		{
+			const std::vector<uint32_t>& args = expr.Operands;
+			SamplerInfo info;
+			if (args.empty() || !GetSamplerInfo(TypeOf(args[0]), info))
+			{
+				return false;
+			}
 
-		std::string sdkPath = std::getenv("VULKAN_SDK") ? std::getenv("VULKAN_SDK") : "C:/Program Files/VulkanSDK/1.4.313.1";
-		std::string command = "\"" + sdkPath + "/Bin/glslang.exe\" -V " + tempIn + " -o " + tempOut;
+			const std::string_view name = NormalizeTextureFunction(expr.Text);
 
-		if (std::system(command.c_str()) == 0)
-		{
-			std::ifstream binFile(tempOut, std::ios::binary | std::ios::ate);
-			std::streamsize size = binFile.tellg();
-			binFile.seekg(0, std::ios::beg);
+			if (m_Target == ShaderTarget::Vulkan)
+			{
+				Write(name);
+				Write("(");
+				EmitArguments(args, 0, false);
+				Write(")");
+				return true;
+			}
 
-			std::vector<uint32_t> buffer(size / sizeof(uint32_t));
-			binFile.read((char*)buffer.data(), size);
+			const ShaderExpr& textureExpr = m_Module.Exprs[args[0]];
+			if (textureExpr.Kind != ShaderExprKind::Identifier)
+			{
+				throw std::runtime_error("Textures can only be sampled by name");
+			}
 
-			return { true, output, buffer, "SPIR-V compilation success!"};
-		}
+			const std::string texture(textureExpr.Text);
+			const std::string sampler = texture + "_Sampler";
+			const bool hlsl = m_Target == ShaderTarget::HLSL;
+			auto arg = [&](size_t i) { EmitExpression(args[i]); };
 
-		return { true, "", {}, "SPIR-V compilation failed!"};
-	}
+			if (name == "textureSize")
+			{
+				if (hlsl)
+				{
+					m_TextureSizeTypes[GetTextureType(info)] = info.Dim;
+					Write("orca_TextureSize(" + texture);
+					if (args.size() > 1 && info.Dim != TextureDim::Buffer && info.Dim != TextureDim::Tex2DMS)
+					{
+						Write(", ");
+						arg(1);
+					}
+					Write(")");
+					return true;
+				}
+
+				auto dimension = [&](const char* getter)
+				{
+					Write("int(" + texture + "." + getter + "(");
+					if (args.size() > 1 && info.Dim != TextureDim::Buffer && info.Dim != TextureDim::Tex2DMS)
+					{
+						Write("uint(");
+						arg(1);
+						Write(")");
+					}
+					Write("))");
+				};
+
+				switch (info.Dim)
+				{
+				case TextureDim::Tex1D:
+				case TextureDim::Buffer:
+					dimension("get_width");
+					break;
+				case TextureDim::Tex3D:
+					Write("int3(");
+					dimension("get_width");
+					Write(", ");
+					dimension("get_height");
+					Write(", ");
+					dimension("get_depth");
+					Write(")");
+					break;
+				case TextureDim::Tex2DArray:
+				case TextureDim::CubeArray:
+					Write("int3(");
+					dimension("get_width");
+					Write(", ");
+					dimension("get_height");
+					Write(", int(" + texture + ".get_array_size()))");
+					break;
+				default:
+					Write("int2(");
+					dimension("get_width");
+					Write(", ");
+					dimension("get_height");
+					Write(")");
+					break;
+				}
+				return true;
+			}
 
-	TranspilationResult ShaderTranspiler::TranspileToMetal(const std::string& glslSource, ShaderStage stage)
-	{
-		auto vResult = TranspileToVulkan(glslSource, stage);
-		if (!vResult.success) return vResult;
+			if (name == "texelFetch")
+			{
+				if (hlsl)
+				{
+					Write(texture + ".Load(");
+					switch (info.Dim)
+					{
+					case TextureDim::Buffer:
+						arg(1);
+						break;
+					case TextureDim::Tex2DMS:
+						arg(1);
+						Write(", ");
+						arg(2);
+						break;
+					default:
+						Write(info.Dim == TextureDim::Tex1D ? "int2(" : info.Dim == TextureDim::Tex2D ? "int3(" : "int4(");
+						arg(1);
+						Write(", ");
+						arg(2);
+						Write(")");
+						break;
+					}
+					Write(")");
+					return true;
+				}
+
+				Write(texture + ".read(");
+				switch (info.Dim)
+				{
+				case TextureDim::Buffer:
+					Write("uint(");
+					arg(1);
+					Write(")");
+					break;
+				case TextureDim::Tex2DArray:
+					Write("uint2((");
+					arg(1);
+					Write(").xy), uint((");
+					arg(1);
+					Write(").z), uint(");
+					arg(2);
+					Write(")");
+					break;
+				default:
+					Write(info.Dim == TextureDim::Tex1D ? "uint(" : info.Dim == TextureDim::Tex3D ? "uint3(" : "uint2(");
+					arg(1);
+					Write("), uint(");
+					arg(2);
+					Write(")");
+					break;
+				}
+				Write(")");
+				return true;
+			}
 
-		std::string tempSpv = "Saved/ShaderCache/temp_vulkan.spv";
-		std::string tempMetal = "Saved/ShaderCache/temp_output.metal";
-		std::string sdkPath = std::getenv("VULKAN_SDK");
+			if (name == "texture" && info.Shadow)
+			{
+				m_Helpers |= Helper_SampleShadow;
+				Write("orca_SampleShadow(" + texture + ", " + sampler + ", ");
+				arg(1);
+				Write(")");
+				return true;
+			}
 
-		std::string command = "\"" + sdkPath + "/Bin/spirv-cross.exe\" -V " + tempSpv + " -o " + tempMetal;
+			if (name == "texture")
+			{
+				if (!hlsl && info.Dim == TextureDim::Tex2DArray)
+				{
+					m_Helpers |= Helper_SampleArray;
+					Write("orca_SampleArray(" + texture + ", " + sampler + ", ");
+					arg(1);
+					Write(")");
+					return true;
+				}
+
+				Write(texture + (hlsl && args.size() > 2 ? ".SampleBias(" : hlsl ? ".Sample(" : ".sample(") + sampler + ", ");
+				arg(1);
+				if (args.size() > 2)
+				{
+					Write(hlsl ? ", " : ", bias(");
+					arg(2);
+					Write(hlsl ? "" : ")");
+				}
+				Write(")");
+				return true;
+			}
 
-		if (std::system(command.c_str()) == 0)
-		{
-			std::ifstream ifs(tempMetal);
-			std::string metalSource((std::istreambuf_iterator<char>(ifs)), (std::istreambuf_iterator<char>()));
-			return { true, metalSource, {}, "Metal transpilation success!" };
-		}
+			if (name == "textureLod" && !info.Shadow)
+			{
+				if (hlsl)
+				{
+					Write(texture + ".SampleLevel(" + sampler + ", ");
+					arg(1);
+					Write(", ");
+					arg(2);
+					Write(")");
+					return true;
+				}
+
+				Write(texture + ".sample(" + sampler + ", ");
+				if (info.Dim == TextureDim::Tex2DArray)
+				{
+					Write("(");
+					arg(1);
+					Write(").xy, uint(rint((");
+					arg(1);
+					Write(").z))");
+				}
+				else
+				{
+					arg(1);
+				}
+				Write(", level(");
+				arg(2);
+				Write("))");
+				return true;
+			}
 
-		return { false, "", {}, "Metal transpilation failed!" };
+			throw std::runtime_error("Unsupported texture function '" + std::string(expr.Text) + "' for " + (hlsl ? "HLSL" : "MSL"));
+		}
 	}
 
-	std::vector<UniformBinding> ShaderTranspiler::ExtractUniforms(const std::string& glslSource)
+	TranspilationResult ShaderTranspiler::Transpile(const std::string& glslSource, ShaderTarget target, ShaderStage stage)
 	{
-		std::vector<UniformBinding> uniforms;
-		std::regex uniformRegex(R"(uniform\s+(\w+)\s+(\w+);)");
-		std::smatch match;
-
-		std::string::const_iterator searchStart(glslSource.cbegin());
-		while (std::regex_search(searchStart, glslSource.cend(), match, uniformRegex))
+		if (glslSource.empty())
 		{
-			UniformBinding binding;
-			binding.type = match[1].str();
-			binding.name = match[2].str();
-			binding.binding = static_cast<int>(uniforms.size());
-			binding.set = 0;
-			uniforms.push_back(binding);
-
-			searchStart = match.suffix().first;
+			return { false, "", {}, "Input shader source is empty" };
 		}
 
-		return uniforms;
-	}
-
-	std::vector<VertexAttribute> ShaderTranspiler::ExtractAttributes(const std::string& glslSource)
-	{
-		std::vector<VertexAttribute> attributes;
-		std::regex attrRegex(R"(layout\s*\(\s*location\s*=\s*(\d+)\s*\)\s*in\s+(\w+)\s+(\w+);)");
-		std::smatch match;
+		TranspilationResult result;
 
-		std::string::const_iterator searchStart(glslSource.cbegin());
-		while (std::regex_search(searchStart, glslSource.cend(), match, attrRegex))
+		if (target == ShaderTarget::GLSL)
 		{
-			VertexAttribute attr;
-			attr.location = std::stoi(match[1].str());
-			attr.type = match[2].str();
-			attr.name = match[3].str();
-			attributes.push_back(attr);
-
-			searchStart = match.suffix().first;
+			// Already GLSL, minimal conversion
+			result = { true, glslSource, {}, "" };
 		}
+		else
+		{
+			const uint64_t cacheKey = ShaderTranspileCache::MakeKey(glslSource, target, stage, m_ExternalValidation);
+			if (ShaderTranspileCache::Load(cacheKey, result))
+			{
+				return result;
+			}
 
-		return attributes;
-	}
+			ShaderModule module;
+			if (module.Parse(glslSource))
+			{
+				std::unordered_map<std::string, int> varyingLocations;
+				result = Emit(module, target, stage, varyingLocations);
+				ShaderTranspileCache::Store(cacheKey, result);
+			}
+			else
+			{
+				result = { false, "", {}, "GLSL parse error: " + module.GetError() };
+			}
+		}
 
-	std::string ShaderTranspiler::GetTargetVersionString(ShaderTarget target)
-	{
-		switch (target)
+		if (result.success)
 		{
-		case ShaderTarget::GLSL:
-			return "#version 330 core";
-		case ShaderTarget::HLSL:
-			return "// HLSL Shader (Target: Direct3D 11)";
-		case ShaderTarget::Vulkan:
-			return "#version 450 core";
-		case ShaderTarget::Metal:
-			return "// Metal Shader Language";
-		default:
-			return "";
+			Logger::Log(LogLevel::Info, "Shader transpilation successful");
+		}
+		else
+		{
+			Logger::Log(LogLevel::Error, "Shader transpilation failed: " + result.errorMessage);
 		}
+
+		return result;
 	}
 
-	std::string ShaderTranspiler::ReplaceGLSLBuiltins(const std::string& source, ShaderTarget target, ShaderStage stage)
+	TranspilationResult ShaderTranspiler::TranspileProgram(const std::string& vertexSource, const std::string& fragmentSource, ShaderTarget target)
 	{
-		std::string output = source;
+		TranspilationResult vertResult;
+		TranspilationResult fragResult;
 
-		if (target == ShaderTarget::HLSL)
+		const uint64_t cacheKey = ShaderTranspileCache::MakeProgramKey(vertexSource, fragmentSource, target, m_ExternalValidation);
+		if (target != ShaderTarget::GLSL && ShaderTranspileCache::Load(cacheKey, vertResult))
 		{
-			if (stage == ShaderStage::Vertex)
-			{
-				output = std::regex_replace(output, std::regex(R"(\bgl_Position\b)"), "position");
-			}
-			else
-			{
-				output = std::regex_replace(output, std::regex(R"(\bgl_FragColor\b)"), "output");
-			}
+			return vertResult;
 		}
-		else if (target == ShaderTarget::Metal)
+
+		if (target == ShaderTarget::GLSL)
+		{
+			vertResult = Transpile(vertexSource, target, ShaderStage::Vertex);
+			fragResult = Transpile(fragmentSource, target, ShaderStage::Fragment);
+		}
+		else
 		{
-			if (stage == ShaderStage::Vertex)
+			ShaderModule vertexModule;
+			ShaderModule fragmentModule;
+			if (!vertexModule.Parse(vertexSource))
 			{
-				output = std::regex_replace(output, std::regex(R"(\bgl_Position\b)"), "out.position");
+				return { false, "", {}, "Vertex shader parse error: " + vertexModule.GetError() };
 			}
-			else
+			if (!fragmentModule.Parse(fragmentSource))
 			{
-				output = std::regex_replace(output, std::regex(R"(\bgl_FragColor\b)"), "out.color");
+				return { false, "", {}, "Fragment shader parse error: " + fragmentModule.GetError() };
 			}
+
+			// The vertex pass records where each varying went so the fragment inputs match it.
+			std::unordered_map<std::string, int> varyingLocations;
+			vertResult = Emit(vertexModule, target, ShaderStage::Vertex, varyingLocations);
+			fragResult = Emit(fragmentModule, target, ShaderStage::Fragment, varyingLocations);
 		}
 
-		return output;
-	}
+		if (!vertResult.success)
+		{
+			return vertResult;
+		}
 
-	std::string ShaderTranspiler::ConvertUniformDeclarations(const std::string& source, ShaderTarget target)
-	{
-		if (target != ShaderTarget::HLSL) return source;
+		if (!fragResult.success)
+		{
+			return fragResult;
+		}
 
-		auto uniforms = ExtractUniforms(source);
-		if (uniforms.empty()) return source;
+		// Combine results with appropriate separators
+		std::string combined = "// === VERTEX SHADER ===\n" + vertResult.output +
+							   "\n\n// === FRAGMENT SHADER ===\n" + fragResult.output;
 
-		std::stringstream ss;
-		ss << "cbuffer Uniforms : register(b0)\n{\n";
-		for (const auto& uniform : uniforms)
+		TranspilationResult result{ true, combined, {}, "" };
+		if (target != ShaderTarget::GLSL)
 		{
-			std::string hlslType = uniform.type;
-			if (hlslType == "vec2") hlslType = "float2";
-			else if (hlslType == "vec3") hlslType = "float3";
-			else if (hlslType == "vec4") hlslType = "float4";
-			else if (hlslType == "mat3") hlslType = "float3x3";
-			else if (hlslType == "mat4") hlslType = "float4x4";
-			ss << "    " << hlslType << " " << uniform.name << ";\n";
+			ShaderTranspileCache::Store(cacheKey, result);
 		}
-
-		std::string cleanedSource = std::regex_replace(source, std::regex(R"(uniform\s+.*?)"), "");
-		return ss.str() + cleanedSource;
+		return result;
 	}
 
-	std::string ShaderTranspiler::ConvertAttributeDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage)
+	TranspilationResult ShaderTranspiler::Emit(const ShaderModule& module, ShaderTarget target, ShaderStage stage, std::unordered_map<std::string, int>& varyingLocations)
 	{
-		std::string output = source;
+		try
+		{
+			ShaderEmitter emitter(module, target, stage, varyingLocations);
+			TranspilationResult result{ true, emitter.Emit(), {}, "" };
 
-		if (stage != ShaderStage::Vertex) return output;
+			if (m_ExternalValidation)
+			{
+				result.success = ValidateExternally(result, target, stage);
+			}
 
-		if (target == ShaderTarget::HLSL)
-		{
-			// Convert layout in to struct input
-			output = std::regex_replace(output, std::regex(R"(layout\s*\(\s*location\s*=\s*(\d+)\s*\)\s*in\s+(\w+)\s+(\w+);)"),
-				"$2 $3 : TEXCOORD$1;");
+			return result;
 		}
-		else if (target == ShaderTarget::Metal)
+		catch (const std::exception& e)
 		{
-			// Convert to Metal attributes
-			output = std::regex_replace(output, std::regex(R"(layout\s*\(\s*location\s*=\s*(\d+)\s*\)\s*in\s+(\w+)\s+(\w+);)"),
-				"$2 $3 [[attribute($1)]];");
+			return { false, "", {}, std::string("Transpilation exception: ") + e.what() };
 		}
-
-		return output;
 	}
 
-	std::string ShaderTranspiler::ConvertVaryingDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage)
+	bool ShaderTranspiler::ValidateExternally(TranspilationResult& result, ShaderTarget target, ShaderStage stage)
 	{
-		std::string output = source;
+		if (target != ShaderTarget::HLSL && target != ShaderTarget::Vulkan)
+		{
+			return true;
+		}
 
-		if (target == ShaderTarget::HLSL)
+		const char* sdkEnv = std::getenv("VULKAN_SDK");
+		const std::string sdkPath = sdkEnv ? sdkEnv : "C:/VulkanSDK/default";
+
+		// glslang picks the stage from the extension. The name is per thread so batch transpiles
+		// running on several workers don't validate each other's files.
+		const std::string extension = target == ShaderTarget::HLSL ? ".hlsl" : stage == ShaderStage::Vertex ? ".vert" : ".frag";
+		std::ostringstream tempName;
+		tempName << "Saved/ShaderCache/validate_" << std::this_thread::get_id() << extension;
+		const std::string tempPath = tempName.str();
 		{
-			// Convert out/in to struct members
-			if (stage == ShaderStage::Vertex)
+			std::ofstream outFile(tempPath);
+			if (!outFile.is_open())
 			{
-				output = std::regex_replace(output, std::regex(R"(\bout\s+(\w+)\s+(\w+);)"),
-					"$1 $2 : TEXCOORD0;");
-			}
-			else
-			{
-				output = std::regex_replace(output, std::regex(R"(\bin\s+(\w+)\s+(\w+);)"),
-					"$1 $2 : TEXCOORD0;");
+				result.errorMessage = "Can't write " + tempPath + " for validation";
+				return false;
 			}
+			outFile << result.output;
 		}
-		else if (target == ShaderTarget::Metal)
+
+		if (target == ShaderTarget::HLSL)
 		{
-			if (stage == ShaderStage::Vertex)
+			const std::string targetProfile = (stage == ShaderStage::Vertex) ? "vs_6_0" : "ps_6_0";
+			const std::string cmd = "\"" + sdkPath + "/Bin/dxc.exe\" -T " + targetProfile + " -E main " + tempPath;
+			if (std::system(cmd.c_str()) != 0)
 			{
-				output = std::regex_replace(output, std::regex(R"(\bout\s+(\w+)\s+(\w+);)"),
-					"$1 $2 [[user(locn0)]];");
+				result.errorMessage = "DXC Validation Failed! Check shader syntax.";
+				return false;
 			}
+			return true;
 		}
 
-		return output;
-	}
-
-	std::string ShaderTranspiler::ConvertMatrixOperations(const std::string& source, ShaderTarget target)
-	{
-		if (target != ShaderTarget::HLSL) return source;
-
-		std::string output = source;
-		std::regex mathRegex(R"((\w+)\s*\*\s*([\w\d\(\).]+))");
+		const std::string tempOut = tempPath + ".spv";
+		const std::string command = "\"" + sdkPath + "/Bin/glslang.exe\" -V " + tempPath + " -o " + tempOut;
+		if (std::system(command.c_str()) != 0)
+		{
+			result.errorMessage = "SPIR-V compilation failed!";
+			return false;
+		}
 
-		output = std::regex_replace(output, mathRegex, "mul($1, $2)");
+		std::ifstream binFile(tempOut, std::ios::binary | std::ios::ate);
+		const std::streamsize size = binFile.tellg();
+		if (size <= 0)
+		{
+			result.errorMessage = "SPIR-V compilation produced no output";
+			return false;
+		}
 
-		return output;
+		binFile.seekg(0, std::ios::beg);
+		result.binary.resize(static_cast<size_t>(size) / sizeof(uint32_t));
+		binFile.read(reinterpret_cast<char*>(result.binary.data()), size);
+		return true;
 	}
 
-	std::string ShaderTranspiler::ConvertBuiltinFunctions(const std::string& source, ShaderTarget target)
+	std::vector<UniformBinding> ShaderTranspiler::ExtractUniforms(const std::string& glslSource)
 	{
-		std::string output = source;
+		std::vector<UniformBinding> uniforms;
 
-		if (target == ShaderTarget::HLSL)
+		ShaderModule module;
+		if (!module.Parse(glslSource))
 		{
-			// Convert GLSL built-ins to HLSL equivalents
-			output = std::regex_replace(output, std::regex(R"(\bnormalize\b)"), "normalize");
-			output = std::regex_replace(output, std::regex(R"(\bdot\b)"), "dot");
-			output = std::regex_replace(output, std::regex(R"(\bmax\b)"), "max");
-			output = std::regex_replace(output, std::regex(R"(\btranspose\b)"), "transpose");
-			output = std::regex_replace(output, std::regex(R"(\binverse\b)"), "inverse");
-			output = std::regex_replace(output, std::regex(R"(\bmat3\b)"), "float3x3");
-			output = std::regex_replace(output, std::regex(R"(\bmat4\b)"), "float4x4");
-			output = std::regex_replace(output, std::regex(R"(\bvec2\b)"), "float2");
-			output = std::regex_replace(output, std::regex(R"(\bvec3\b)"), "float3");
-			output = std::regex_replace(output, std::regex(R"(\bvec4\b)"), "float4");
-		}
-		else if (target == ShaderTarget::Metal)
-		{
-			// Metal has similar built-ins but needs type conversions
-			output = std::regex_replace(output, std::regex(R"(\bmat3\b)"), "float3x3");
-			output = std::regex_replace(output, std::regex(R"(\bmat4\b)"), "float4x4");
-			output = std::regex_replace(output, std::regex(R"(\bvec2\b)"), "float2");
-			output = std::regex_replace(output, std::regex(R"(\bvec3\b)"), "float3");
-			output = std::regex_replace(output, std::regex(R"(\bvec4\b)"), "float4");
-		}
-
-		return output;
-	}
+			Logger::Log(LogLevel::Warning, "Can't extract uniforms: " + module.GetError());
+			return uniforms;
+		}
 
-	std::string ShaderTranspiler::ExtractIdentifier(const std::string& source, size_t& pos)
-	{
-		while (pos < source.size() && !std::isalnum(source[pos]) && source[pos] != '_') pos++;
+		for (const ShaderVariable& variable : module.Globals)
+		{
+			if (variable.Storage != ShaderStorage::Uniform)
+			{
+				continue;
+			}
 
-		size_t start = pos;
-		while (pos < source.size() && (std::isalnum(source[pos]) || source[pos] == '_')) pos++;
+			UniformBinding binding;
+			binding.type = variable.Type;
+			binding.name = variable.Name;
+			binding.binding = variable.Binding >= 0 ? variable.Binding : static_cast<int>(uniforms.size());
+			binding.set = 0;
+			uniforms.push_back(binding);
+		}
 
-		return source.substr(start, pos - start);
+		return uniforms;
 	}
 
-	std::vector<std::string> ShaderTranspiler::SplitLines(const std::string& source)
+	std::vector<VertexAttribute> ShaderTranspiler::ExtractAttributes(const std::string& glslSource)
 	{
-		std::vector<std::string> lines;
-		std::stringstream ss(source);
-		std::string line;
+		std::vector<VertexAttribute> attributes;
 
-		while (std::getline(ss, line))
+		ShaderModule module;
+		if (!module.Parse(glslSource))
 		{
-			lines.push_back(line);
+			Logger::Log(LogLevel::Warning, "Can't extract attributes: " + module.GetError());
+			return attributes;
 		}
 
-		return lines;
-	}
-
-	bool ShaderTranspiler::IsBuiltinType(const std::string& type)
-	{
-		static const std::unordered_map<std::string, bool> builtinTypes = {
-			{ "float", true }, { "int", true }, { "uint", true },
-			{ "vec2", true }, { "vec3", true }, { "vec4", true },
-			{ "ivec2", true }, { "ivec3", true }, { "ivec4", true },
-			{ "mat2", true }, { "mat3", true }, { "mat4", true },
-			{ "sampler2D", true }, { "samplerCube", true }
-		};
+		for (const ShaderVariable& variable : module.Globals)
+		{
+			if (variable.Storage != ShaderStorage::In || variable.Location < 0)
+			{
+				continue;
+			}
 
-		return builtinTypes.find(type) != builtinTypes.end();
-	}
+			VertexAttribute attr;
+			attr.location = variable.Location;
+			attr.type = variable.Type;
+			attr.name = variable.Name;
+			attributes.push_back(attr);
+		}
 
-	bool ShaderTranspiler::IsUniformDeclaration(const std::string& line)
-	{
-		return line.find("uniform") != std::string::npos;
+		return attributes;
 	}
 
-	bool ShaderTranspiler::IsAttributeDeclaration(const std::string& line)
+	std::string ShaderTranspiler::GetTargetVersionString(ShaderTarget target)
 	{
-		return line.find("layout") != std::string::npos && line.find("in") != std::string::npos;
+		switch (target)
+		{
+		case ShaderTarget::GLSL:
+			return "#version 330 core";
+		case ShaderTarget::HLSL:
+			return "// HLSL Shader (Target: Direct3D 11)";
+		case ShaderTarget::Vulkan:
+			return "#version 450 core";
+		case ShaderTarget::Metal:
+			return "// Metal Shader Language";
+		default:
+			return "";
+		}
 	}
-}
\ No newline at end of file
+}
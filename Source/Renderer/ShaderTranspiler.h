@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <cstdint>
 #include "../OrcaAPI.h"
 
 namespace Orca
@@ -55,16 +56,24 @@ namespace Orca
 		std::string errorMessage;
 	};
 
+	class ShaderModule;
+
+	// Translates GLSL 330+ into HLSL, Vulkan GLSL or MSL. The source is tokenized and parsed once
+	// into a ShaderModule (see ShaderIR.h), then each target is emitted in a single walk over it.
 	class ORCA_API ShaderTranspiler
 	{
 	public:
+		// Bump whenever emitted code changes so ShaderTranspileCache entries from older builds miss.
+		static constexpr uint32_t k_Version = 1;
+
 		ShaderTranspiler() = default;
 		~ShaderTranspiler() = default;
 
-		// Transpile a shader from GLSL to target language
+		// Transpile a shader from GLSL to target language. Successful results are reused from
+		// ShaderTranspileCache when it has been initialized.
 		TranspilationResult Transpile(const std::string& glslSource, ShaderTarget target, ShaderStage stage);
 
-		// Transpile both vertex and fragment shaders
+		// Transpile both vertex and fragment shaders. Varying locations are matched between stages.
 		TranspilationResult TranspileProgram(const std::string& vertexSource, const std::string& fragmentSource, ShaderTarget target);
 
 		// Parse shader metadata
@@ -74,26 +83,15 @@ namespace Orca
 		// Get the target language version string
 		static std::string GetTargetVersionString(ShaderTarget target);
 
+		// Runs dxc (HLSL) or glslang (Vulkan, fills TranspilationResult::binary) on every result.
+		// Off by default: it needs the Vulkan SDK and spawns a process per shader.
+		void SetExternalValidation(bool enabled) { m_ExternalValidation = enabled; }
+
 	private:
-		// Transpilation methods for each target
-		TranspilationResult TranspileToHLSL(const std::string& glslSource, ShaderStage stage);
-		TranspilationResult TranspileToVulkan(const std::string& glslSource, ShaderStage stage);
-		TranspilationResult TranspileToMetal(const std::string& glslSource, ShaderStage stage);
-
-		// Helper methods
-		std::string ReplaceGLSLBuiltins(const std::string& source, ShaderTarget target, ShaderStage stage);
-		std::string ConvertUniformDeclarations(const std::string& source, ShaderTarget target);
-		std::string ConvertAttributeDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage);
-		std::string ConvertVaryingDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage);
-		std::string ConvertMatrixOperations(const std::string& source, ShaderTarget target);
-		std::string ConvertBuiltinFunctions(const std::string& source, ShaderTarget target);
-
-		// Utility parsing helpers
-		std::string ExtractIdentifier(const std::string& source, size_t& pos);
-		std::vector<std::string> SplitLines(const std::string& source);
-		bool IsBuiltinType(const std::string& type);
-		bool IsUniformDeclaration(const std::string& line);
-		bool IsAttributeDeclaration(const std::string& line);
+		bool m_ExternalValidation = false;
+
+		TranspilationResult Emit(const ShaderModule& module, ShaderTarget target, ShaderStage stage, std::unordered_map<std::string, int>& varyingLocations);
+		bool ValidateExternally(TranspilationResult& result, ShaderTarget target, ShaderStage stage);
 	};
 }
 
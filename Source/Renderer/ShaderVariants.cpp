@@ -0,0 +1,153 @@
+#include "ShaderVariants.h"
+#include "../Core/Logger.h"
+#include <algorithm>
+#include <sstream>
+
+namespace Orca
+{
+	std::mutex ShaderKeywords::s_Mutex;
+	std::vector<std::string> ShaderKeywords::s_Names;
+	std::atomic<uint32_t> ShaderVariantSet::s_NextID{ 1 };
+
+	ShaderKeywordMask ShaderKeywords::Get(const std::string& keyword)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		auto it = std::find(s_Names.begin(), s_Names.end(), keyword);
+		if (it != s_Names.end())
+		{
+			return ShaderKeywordMask(1) << (it - s_Names.begin());
+		}
+
+		if (s_Names.size() >= k_MaxKeywords)
+		{
+			Logger::Log(LogLevel::Error, "Too many shader keywords, ignoring: " + keyword);
+			return 0;
+		}
+
+		s_Names.push_back(keyword);
+		return ShaderKeywordMask(1) << (s_Names.size() - 1);
+	}
+
+	ShaderVariantSet::ShaderVariantSet(const ShaderSource& source)
+		: m_ID(s_NextID.fetch_add(1, std::memory_order_relaxed)), m_Source(source)
+	{
+		ParseKeywords(source.Vertex);
+		ParseKeywords(source.Fragment);
+
+		const size_t variantCount = size_t(1) << m_Keywords.size();
+		m_Variants.resize(variantCount);
+		m_Requested = std::make_unique<std::atomic<bool>[]>(variantCount);
+		for (size_t i = 0; i < variantCount; ++i)
+		{
+			m_Requested[i] = false;
+		}
+	}
+
+	void ShaderVariantSet::ParseKeywords(const std::string& source)
+	{
+		std::istringstream lines(source);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			std::istringstream tokens(line);
+			std::string directive, pragma;
+			tokens >> directive >> pragma;
+			if (directive != "#pragma" || pragma != "keywords")
+			{
+				continue;
+			}
+
+			std::string keyword;
+			while (tokens >> keyword)
+			{
+				if (std::find(m_Keywords.begin(), m_Keywords.end(), keyword) != m_Keywords.end())
+				{
+					continue;
+				}
+
+				if (m_Keywords.size() >= k_MaxKeywords)
+				{
+					Logger::Log(LogLevel::Error, "Too many keywords in " + m_Source.VertexPath + ", ignoring: " + keyword);
+					continue;
+				}
+
+				m_Keywords.push_back(keyword);
+				m_KeywordBits.push_back(ShaderKeywords::Get(keyword));
+			}
+		}
+	}
+
+	uint32_t ShaderVariantSet::GetVariantIndex(ShaderKeywordMask keywords) const
+	{
+		uint32_t index = 0;
+		for (size_t i = 0; i < m_KeywordBits.size(); ++i)
+		{
+			if (keywords & m_KeywordBits[i])
+			{
+				index |= 1u << i;
+			}
+		}
+		return index;
+	}
+
+	Shader* ShaderVariantSet::Request(uint32_t index)
+	{
+		if (Shader* variant = m_Variants[index].get())
+		{
+			return variant;
+		}
+
+		// Only the first request for a variant takes the lock.
+		if (!m_Requested[index].exchange(true))
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			m_Queue.push_back(index);
+		}
+		return nullptr;
+	}
+
+	bool ShaderVariantSet::Owns(const Shader* shader) const
+	{
+		return std::any_of(m_Variants.begin(), m_Variants.end(), [&](const std::unique_ptr<Shader>& variant) { return variant.get() == shader; });
+	}
+
+	Shader* ShaderVariantSet::Build(uint32_t index)
+	{
+		if (m_Variants[index])
+		{
+			return m_Variants[index].get();
+		}
+
+		ShaderSource source = m_Source;
+		for (size_t i = 0; i < m_Keywords.size(); ++i)
+		{
+			if (index & (1u << i))
+			{
+				source.Defines.push_back(m_Keywords[i]);
+			}
+		}
+
+		m_Requested[index] = true;
+		m_Variants[index] = Shader::CreateAsync(source);
+		return m_Variants[index].get();
+	}
+
+	void ShaderVariantSet::BuildRequested(std::vector<Shader*>& pending)
+	{
+		std::vector<uint32_t> queue;
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			queue.swap(m_Queue);
+		}
+
+		for (uint32_t index : queue)
+		{
+			Shader* variant = Build(index);
+			if (variant->GetStatus() == ShaderStatus::Compiling)
+			{
+				pending.push_back(variant);
+			}
+		}
+	}
+}
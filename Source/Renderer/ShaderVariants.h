@@ -0,0 +1,97 @@
+#pragma once
+
+#ifndef SHADER_VARIANTS_H
+#define SHADER_VARIANTS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include "Shader.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// One bit per keyword name, shared by every shader so a material's keyword set does not
+	// depend on which shader it ends up using.
+	using ShaderKeywordMask = uint64_t;
+
+	class ORCA_API ShaderKeywords
+	{
+	public:
+		static constexpr uint32_t k_MaxKeywords = 64;
+
+		// Returns the keyword's bit, registering it on first use. Returns 0 once all bits are taken.
+		static ShaderKeywordMask Get(const std::string& keyword);
+
+	private:
+		static std::mutex s_Mutex;
+		static std::vector<std::string> s_Names;
+	};
+
+	// Every permutation of one shader. Keywords are declared in either stage with
+	//
+	//     #pragma keywords NAME [NAME ...]
+	//
+	// and a variant is the program built with "#define NAME" for each enabled keyword. Variants live
+	// in a flat array indexed by the shader's own keyword bits, so resolving one per draw is a few
+	// mask tests and an index, never a hash lookup.
+	class ShaderVariantSet
+	{
+	public:
+		// Limits a shader to 256 variants.
+		static constexpr uint32_t k_MaxKeywords = 8;
+
+		// The source must not have defines of its own; each variant supplies them.
+		explicit ShaderVariantSet(const ShaderSource& source);
+
+		const std::vector<std::string>& GetKeywords() const { return m_Keywords; }
+
+		// Unique among live sets and known before any variant is built, so together with a variant
+		// index it names a program without a GL context.
+		uint32_t GetID() const { return m_ID; }
+
+		// Keywords the shader doesn't declare are ignored, so materials can share one keyword set.
+		uint32_t GetVariantIndex(ShaderKeywordMask keywords) const;
+
+		// Null until the variant has been built.
+		Shader* GetVariant(uint32_t index) const { return m_Variants[index].get(); }
+
+		// Whether shader is one of this set's variants.
+		bool Owns(const Shader* shader) const;
+
+		// Safe from the recording jobs. Returns the variant if it exists, otherwise queues it for
+		// BuildRequested() and returns null. The array is only written on the GL thread between
+		// frames, never while jobs are recording.
+		Shader* Request(uint32_t index);
+
+		// GL thread. Starts the build of one variant, from the program binary cache when possible.
+		Shader* Build(uint32_t index);
+
+		// GL thread. Starts every queued build and appends the ones still compiling to pending.
+		void BuildRequested(std::vector<Shader*>& pending);
+
+	private:
+		static std::atomic<uint32_t> s_NextID;
+
+		uint32_t m_ID;
+		ShaderSource m_Source;
+		std::vector<std::string> m_Keywords;
+		std::vector<ShaderKeywordMask> m_KeywordBits;
+		std::vector<std::unique_ptr<Shader>> m_Variants;
+
+		std::unique_ptr<std::atomic<bool>[]> m_Requested;
+		std::mutex m_QueueMutex;
+		std::vector<uint32_t> m_Queue;
+
+		void ParseKeywords(const std::string& source);
+	};
+#pragma warning(pop)
+}
+
+#endif
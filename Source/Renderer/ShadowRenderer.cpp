@@ -0,0 +1,730 @@
+#include "ShadowRenderer.h"
+#include "Shader.h"
+#include "Mesh.h"
+#include "../Core/JobSystem.h"
+#include "../Math/Frustum.h"
+#include <GL/glew.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace Orca
+{
+	namespace
+	{
+		// Fixed units next to the clustered lighting buffers (13..15).
+		constexpr int k_ShadowMatrixUnit = 10;
+		constexpr int k_CascadeUnit = 11;
+		constexpr int k_AtlasUnit = 12;
+
+		constexpr float k_LocalNearPlane = 0.05f;
+		constexpr float k_SpotAngleMargin = 5.0f;	// Degrees, keeps the penumbra inside the map
+		constexpr float k_CascadeImportance = 100.0f;
+
+		constexpr uint64_t k_HashBasis = 14695981039346656037ull;
+
+		uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		glm::vec3 PickUpVector(const glm::vec3& direction)
+		{
+			return std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+		}
+
+		// Maps clip space of a view into [0, 1] texture space of the given sub-rectangle.
+		glm::mat4 TextureMatrix(float offsetX, float offsetY, float scale)
+		{
+			glm::mat4 matrix(1.0f);
+			matrix[0][0] = 0.5f * scale;
+			matrix[1][1] = 0.5f * scale;
+			matrix[2][2] = 0.5f;
+			matrix[3] = glm::vec4(offsetX + 0.5f * scale, offsetY + 0.5f * scale, 0.5f, 1.0f);
+			return matrix;
+		}
+
+		unsigned int CreateDepthTexture(GLenum target, uint32_t size, uint32_t layers, bool comparison)
+		{
+			unsigned int texture = 0;
+			glGenTextures(1, &texture);
+			glBindTexture(target, texture);
+
+			if (target == GL_TEXTURE_2D_ARRAY)
+			{
+				glTexImage3D(target, 0, GL_DEPTH_COMPONENT24, size, size, layers, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+			}
+			else
+			{
+				glTexImage2D(target, 0, GL_DEPTH_COMPONENT24, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+			}
+
+			// Lookups outside a map read the far plane, i.e. lit.
+			const float border[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+			glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+			glTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, border);
+
+			const GLint filter = comparison ? GL_LINEAR : GL_NEAREST;
+			glTexParameteri(target, GL_TEXTURE_MIN_FILTER, filter);
+			glTexParameteri(target, GL_TEXTURE_MAG_FILTER, filter);
+			if (comparison)
+			{
+				glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+				glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+			}
+
+			glBindTexture(target, 0);
+			return texture;
+		}
+	}
+
+	void ShadowRenderer::SetSettings(const ShadowSettings& settings)
+	{
+		m_Settings = settings;
+		m_Settings.CascadeCount = std::clamp<uint32_t>(m_Settings.CascadeCount, 1, k_MaxCascades);
+		m_Settings.AtlasTileResolution = std::clamp<uint32_t>(m_Settings.AtlasTileResolution, 16, std::max<uint32_t>(m_Settings.AtlasResolution, 16));
+		m_Dirty = true;
+	}
+
+	void ShadowRenderer::ResetTargets()
+	{
+		unsigned int textures[] = { m_CascadeTexture, m_CascadeCache, m_AtlasTexture, m_AtlasCache };
+		glDeleteTextures(4, textures);
+		m_CascadeTexture = m_CascadeCache = m_AtlasTexture = m_AtlasCache = 0;
+
+		// Everything cached refers to the old textures.
+		m_Cascades = {};
+		for (uint32_t i = 0; i < k_MaxCascades; ++i)
+		{
+			m_Cascades[i].IsCascade = true;
+			m_Cascades[i].Layer = i;
+		}
+		m_LightShadows.clear();
+		m_ShadowIndices.clear();
+
+		const uint32_t slotsPerRow = m_Settings.AtlasResolution / m_Settings.AtlasTileResolution;
+		m_FreeSlots.clear();
+		for (uint32_t slot = slotsPerRow * slotsPerRow; slot > 0; --slot)
+		{
+			m_FreeSlots.push_back(slot - 1);
+		}
+
+		m_Dirty = false;
+	}
+
+	void ShadowRenderer::CreateCascadeTargets()
+	{
+		m_CascadeTexture = CreateDepthTexture(GL_TEXTURE_2D_ARRAY, m_Settings.CascadeResolution, m_Settings.CascadeCount, true);
+		m_CascadeCache = CreateDepthTexture(GL_TEXTURE_2D_ARRAY, m_Settings.CascadeResolution, m_Settings.CascadeCount, false);
+		CreateFramebuffers();
+	}
+
+	void ShadowRenderer::CreateAtlasTargets()
+	{
+		m_AtlasTexture = CreateDepthTexture(GL_TEXTURE_2D, m_Settings.AtlasResolution, 1, true);
+		m_AtlasCache = CreateDepthTexture(GL_TEXTURE_2D, m_Settings.AtlasResolution, 1, false);
+		CreateFramebuffers();
+	}
+
+	void ShadowRenderer::CreateFramebuffers()
+	{
+		if (m_Framebuffer != 0)
+		{
+			return;
+		}
+
+		unsigned int framebuffers[2] = { 0, 0 };
+		glGenFramebuffers(2, framebuffers);
+		m_Framebuffer = framebuffers[0];
+		m_CacheFramebuffer = framebuffers[1];
+
+		// Depth only.
+		for (unsigned int framebuffer : framebuffers)
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+			glDrawBuffer(GL_NONE);
+			glReadBuffer(GL_NONE);
+		}
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	void ShadowRenderer::Render(const std::vector<ShadowCaster>& casters, const DirectionalLight* directional,
+		const std::vector<ShadowLight>& lights, const glm::mat4& cameraView, const glm::mat4& cameraProjection,
+		float cameraNear, float cameraFar, const Shader& depthShader)
+	{
+		m_Stats = {};
+
+		if (m_Dirty)
+		{
+			ResetTargets();
+		}
+
+		m_ActiveViews.clear();
+		m_ActiveCascades = 0;
+
+		// Each kind of map is only allocated once a view of that kind shows up.
+		if (directional)
+		{
+			if (m_CascadeTexture == 0)
+			{
+				CreateCascadeTargets();
+			}
+
+			FitCascades(*directional, cameraView, cameraProjection, cameraNear, cameraFar);
+			for (uint32_t i = 0; i < m_Settings.CascadeCount; ++i)
+			{
+				m_ActiveViews.push_back(&m_Cascades[i]);
+			}
+		}
+
+		AssignLightViews(lights);
+		if (!m_LightShadows.empty() && m_AtlasTexture == 0)
+		{
+			CreateAtlasTargets();
+		}
+		m_Stats.ActiveViews = static_cast<uint32_t>(m_ActiveViews.size());
+
+		CullViews(casters);
+
+		// A view needs work if its static cache is stale or dynamic casters were or are in it.
+		std::vector<ShadowView*> pending;
+		for (ShadowView* view : m_ActiveViews)
+		{
+			if (view->StaticDirty || !view->DynamicCasters.empty() || view->HadDynamicCasters)
+			{
+				pending.push_back(view);
+			}
+			else
+			{
+				view->FramesSinceUpdate = 0;
+			}
+		}
+
+		auto priority = [](const ShadowView* view)
+			{
+				if (view->IsCascade && view->Layer == 0)
+				{
+					return std::numeric_limits<float>::max();
+				}
+				return view->Importance * static_cast<float>(1 + view->FramesSinceUpdate);
+			};
+
+		std::stable_sort(pending.begin(), pending.end(), [&](const ShadowView* a, const ShadowView* b)
+			{
+				return priority(a) > priority(b);
+			});
+
+		size_t budget = m_Settings.MaxViewUpdatesPerFrame;
+		if (!pending.empty() && pending.front()->IsCascade && pending.front()->Layer == 0)
+		{
+			budget++;
+		}
+		const size_t updateCount = std::min(pending.size(), budget);
+
+		if (updateCount > 0)
+		{
+			GLint previousViewport[4] = { 0, 0, 1, 1 };
+			GLint previousFramebuffer = 0;
+			glGetIntegerv(GL_VIEWPORT, previousViewport);
+			glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+			glEnable(GL_DEPTH_TEST);
+			glDepthMask(GL_TRUE);
+			glEnable(GL_SCISSOR_TEST);
+			glEnable(GL_POLYGON_OFFSET_FILL);
+			glPolygonOffset(m_Settings.DepthBiasFactor, m_Settings.DepthBiasUnits);
+
+			for (size_t i = 0; i < updateCount; ++i)
+			{
+				RenderView(*pending[i], casters, depthShader);
+			}
+
+			glDisable(GL_POLYGON_OFFSET_FILL);
+			glDisable(GL_SCISSOR_TEST);
+			glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+			glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+		}
+
+		for (size_t i = updateCount; i < pending.size(); ++i)
+		{
+			pending[i]->FramesSinceUpdate++;
+			m_Stats.DeferredViews++;
+		}
+
+		// The shader walks cascades in order, so only a rendered prefix is usable.
+		if (directional)
+		{
+			while (m_ActiveCascades < m_Settings.CascadeCount && m_Cascades[m_ActiveCascades].Rendered)
+			{
+				m_ActiveCascades++;
+			}
+		}
+
+		UploadMatrices(lights);
+	}
+
+	void ShadowRenderer::FitCascades(const DirectionalLight& directional, const glm::mat4& cameraView, const glm::mat4& cameraProjection,
+		float cameraNear, float cameraFar)
+	{
+		const uint32_t count = m_Settings.CascadeCount;
+		const float shadowFar = std::max(std::min(cameraFar, m_Settings.ShadowDistance), cameraNear * 2.0f);
+
+		// Practical split scheme: a blend of logarithmic and uniform distribution.
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const float p = static_cast<float>(i + 1) / count;
+			const float logSplit = cameraNear * std::pow(shadowFar / cameraNear, p);
+			const float uniformSplit = cameraNear + (shadowFar - cameraNear) * p;
+			m_CascadeSplits[i] = m_Settings.CascadeSplitLambda * logSplit + (1.0f - m_Settings.CascadeSplitLambda) * uniformSplit;
+		}
+
+		const glm::vec3 direction = glm::normalize(directional.Direction);
+		const bool directionChanged = glm::dot(direction, m_DirectionalDirection) < 0.99999f;
+		m_DirectionalDirection = direction;
+
+		const glm::mat4 inverseView = glm::inverse(cameraView);
+		const float tanX = cameraProjection[0][0] != 0.0f ? 1.0f / cameraProjection[0][0] : 1.0f;
+		const float tanY = cameraProjection[1][1] != 0.0f ? 1.0f / cameraProjection[1][1] : 1.0f;
+		const float resolution = static_cast<float>(m_Settings.CascadeResolution);
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const float d0 = i == 0 ? cameraNear : m_CascadeSplits[i - 1];
+			const float d1 = m_CascadeSplits[i];
+
+			glm::vec3 corners[8];
+			glm::vec3 center(0.0f);
+			for (uint32_t c = 0; c < 8; ++c)
+			{
+				const float depth = (c & 4) ? d1 : d0;
+				const float x = ((c & 1) ? 1.0f : -1.0f) * depth * tanX;
+				const float y = ((c & 2) ? 1.0f : -1.0f) * depth * tanY;
+				corners[c] = glm::vec3(inverseView * glm::vec4(x, y, -depth, 1.0f));
+				center += corners[c] * 0.125f;
+			}
+
+			float radius = 0.0f;
+			for (const glm::vec3& corner : corners)
+			{
+				radius = std::max(radius, glm::length(corner - center));
+			}
+
+			// The sphere size only depends on the projection, so rounding keeps texel size constant.
+			radius = std::ceil(radius * 16.0f) / 16.0f;
+			const float extent = radius * std::max(m_Settings.CascadePadding, 1.0f);
+
+			ShadowView& cascade = m_Cascades[i];
+			if (!cascade.Rendered || directionChanged || glm::length(center - m_CascadeCenters[i]) + radius > extent)
+			{
+				m_CascadeCenters[i] = center;
+			}
+
+			const glm::vec3 fitCenter = m_CascadeCenters[i];
+			const glm::vec3 eye = fitCenter - direction * (extent + m_Settings.CasterExtrusion);
+			const glm::mat4 lightView = glm::lookAt(eye, fitCenter, PickUpVector(direction));
+			glm::mat4 lightProjection = glm::ortho(-extent, extent, -extent, extent, 0.0f, 2.0f * extent + m_Settings.CasterExtrusion);
+
+			// Snap the origin to whole texels so edges do not shimmer when the fit moves.
+			glm::vec4 origin = lightProjection * lightView * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+			origin *= resolution * 0.5f;
+			lightProjection[3][0] += (std::round(origin.x) - origin.x) * 2.0f / resolution;
+			lightProjection[3][1] += (std::round(origin.y) - origin.y) * 2.0f / resolution;
+
+			cascade.ViewProjection = lightProjection * lightView;
+			cascade.Importance = k_CascadeImportance / static_cast<float>(i + 1);
+		}
+	}
+
+	void ShadowRenderer::AssignLightViews(const std::vector<ShadowLight>& lights)
+	{
+		const uint32_t slotsPerRow = m_Settings.AtlasResolution / m_Settings.AtlasTileResolution;
+		uint32_t freeSlots = slotsPerRow * slotsPerRow;
+
+		std::vector<const ShadowLight*> ranked;
+		ranked.reserve(lights.size());
+		for (const ShadowLight& light : lights)
+		{
+			ranked.push_back(&light);
+		}
+		std::stable_sort(ranked.begin(), ranked.end(), [](const ShadowLight* a, const ShadowLight* b)
+			{
+				return a->Importance > b->Importance;
+			});
+
+		// Greedy by importance; a point light that no longer fits does not block smaller spot lights.
+		std::unordered_map<const void*, const ShadowLight*> accepted;
+		for (const ShadowLight* light : ranked)
+		{
+			const uint32_t faces = light->Type == ClusterLightType::Point ? k_PointLightFaces : 1;
+			if (faces <= freeSlots)
+			{
+				accepted[light->Id] = light;
+				freeSlots -= faces;
+			}
+		}
+
+		// Release before allocating so accepted lights always find room.
+		for (auto it = m_LightShadows.begin(); it != m_LightShadows.end();)
+		{
+			auto match = accepted.find(it->first);
+			if (match == accepted.end() || match->second->Type != it->second.Type)
+			{
+				for (const ShadowView& face : it->second.Faces)
+				{
+					m_FreeSlots.push_back(face.Layer);
+				}
+				it = m_LightShadows.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		static const glm::vec3 k_FaceAxes[k_PointLightFaces] =
+		{
+			{ 1.0f, 0.0f, 0.0f }, { -1.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f }, { 0.0f, -1.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, -1.0f }
+		};
+
+		for (const ShadowLight* light : ranked)
+		{
+			if (accepted.find(light->Id) == accepted.end())
+			{
+				continue;
+			}
+
+			LightShadow& shadow = m_LightShadows[light->Id];
+			if (shadow.Faces.empty())
+			{
+				shadow.Type = light->Type;
+				shadow.Faces.resize(light->Type == ClusterLightType::Point ? k_PointLightFaces : 1);
+				for (ShadowView& face : shadow.Faces)
+				{
+					face.Layer = m_FreeSlots.back();
+					m_FreeSlots.pop_back();
+				}
+			}
+
+			const float range = std::max(light->Range, k_LocalNearPlane * 2.0f);
+
+			if (light->Type == ClusterLightType::Point)
+			{
+				const glm::mat4 projection = glm::perspective(glm::radians(90.0f), 1.0f, k_LocalNearPlane, range);
+				for (uint32_t face = 0; face < k_PointLightFaces; ++face)
+				{
+					const glm::vec3& axis = k_FaceAxes[face];
+					shadow.Faces[face].ViewProjection = projection * glm::lookAt(light->Position, light->Position + axis, PickUpVector(axis));
+				}
+			}
+			else
+			{
+				const glm::vec3 direction = glm::normalize(light->Direction);
+				const float fov = std::min(light->SpotAngle + k_SpotAngleMargin, 170.0f);
+				const glm::mat4 projection = glm::perspective(glm::radians(fov), 1.0f, k_LocalNearPlane, range);
+				shadow.Faces[0].ViewProjection = projection * glm::lookAt(light->Position, light->Position + direction, PickUpVector(direction));
+			}
+
+			for (ShadowView& face : shadow.Faces)
+			{
+				face.Importance = light->Importance;
+				m_ActiveViews.push_back(&face);
+			}
+		}
+	}
+
+	void ShadowRenderer::CullViews(const std::vector<ShadowCaster>& casters)
+	{
+		auto cullView = [&](unsigned int index)
+			{
+				ShadowView& view = *m_ActiveViews[index];
+				view.StaticCasters.clear();
+				view.DynamicCasters.clear();
+
+				const Frustum frustum(view.ViewProjection);
+				uint64_t hash = HashBytes(k_HashBasis, &view.ViewProjection, sizeof(glm::mat4));
+
+				for (uint32_t i = 0; i < casters.size(); ++i)
+				{
+					const ShadowCaster& caster = casters[i];
+					if (!caster.Geometry || !frustum.Intersects(caster.LocalBounds, caster.Model))
+					{
+						continue;
+					}
+
+					if (caster.Static)
+					{
+						// A static caster entering, leaving or moving inside the view changes the hash.
+						view.StaticCasters.push_back(i);
+						hash = HashBytes(hash, &caster.Geometry, sizeof(caster.Geometry));
+						hash = HashBytes(hash, &caster.Model, sizeof(glm::mat4));
+					}
+					else
+					{
+						view.DynamicCasters.push_back(i);
+					}
+				}
+
+				view.PendingStaticHash = hash;
+				view.StaticDirty = !view.Rendered || hash != view.StaticHash;
+			};
+
+		if (JobSystem::IsInitialized())
+		{
+			JobSystem::Dispatch(static_cast<unsigned int>(m_ActiveViews.size()), cullView);
+		}
+		else
+		{
+			for (unsigned int i = 0; i < m_ActiveViews.size(); ++i)
+			{
+				cullView(i);
+			}
+		}
+	}
+
+	void ShadowRenderer::RenderView(ShadowView& view, const std::vector<ShadowCaster>& casters, const Shader& depthShader)
+	{
+		int x = 0, y = 0, size = 0;
+		GetViewRect(view, x, y, size);
+
+		const unsigned int target = view.IsCascade ? m_CascadeTexture : m_AtlasTexture;
+		const unsigned int cache = view.IsCascade ? m_CascadeCache : m_AtlasCache;
+
+		glViewport(x, y, size, size);
+		glScissor(x, y, size, size);
+
+		if (view.StaticDirty)
+		{
+			AttachView(m_CacheFramebuffer, cache, view);
+			glClear(GL_DEPTH_BUFFER_BIT);
+			DrawCasters(view.StaticCasters, casters, view.ViewProjection, depthShader);
+
+			view.RenderedViewProjection = view.ViewProjection;
+			view.StaticHash = view.PendingStaticHash;
+			view.Rendered = true;
+			m_Stats.StaticRedraws++;
+		}
+
+		// Restore the static depth, then composite dynamic casters on top.
+		AttachView(m_CacheFramebuffer, cache, view);
+		AttachView(m_Framebuffer, target, view);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, m_CacheFramebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_Framebuffer);
+		glBlitFramebuffer(x, y, x + size, y + size, x, y, x + size, y + size, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+		DrawCasters(view.DynamicCasters, casters, view.RenderedViewProjection, depthShader);
+
+		view.HadDynamicCasters = !view.DynamicCasters.empty();
+		view.FramesSinceUpdate = 0;
+		m_Stats.UpdatedViews++;
+	}
+
+	void ShadowRenderer::DrawCasters(const std::vector<uint32_t>& indices, const std::vector<ShadowCaster>& casters,
+		const glm::mat4& viewProjection, const Shader& depthShader)
+	{
+		if (indices.empty())
+		{
+			return;
+		}
+
+		m_Commands.Reset();
+		m_Commands.Reserve(indices.size());
+
+		for (uint32_t index : indices)
+		{
+			const ShadowCaster& caster = casters[index];
+			if (!caster.Geometry->IsRenderable())
+			{
+				continue;
+			}
+
+			DrawConstants constants;
+			constants.Model = caster.Model;
+			constants.AlbedoColor = glm::vec4(1.0f);
+			// Keyed by vertex layout like the scene, so meshes sharing a layout batch together.
+			const uint32_t geometryKey = static_cast<uint32_t>(caster.Geometry->GetLayout().GetHash());
+			m_Commands.RecordDraw(RenderSortKey::Make(depthShader.GetID(), 0, geometryKey, 0.0f), &depthShader, depthShader.GetID(), caster.Geometry, nullptr, constants);
+		}
+
+		m_Commands.Sort();
+
+		FrameConstants frame;
+		frame.ViewProjection = viewProjection;
+		m_Executor.Execute(m_Commands, frame);
+
+		m_Stats.CasterDraws += static_cast<uint32_t>(m_Commands.GetSize());
+	}
+
+	void ShadowRenderer::AttachView(unsigned int framebuffer, unsigned int texture, const ShadowView& view) const
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		if (view.IsCascade)
+		{
+			glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, texture, 0, view.Layer);
+		}
+		else
+		{
+			glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, texture, 0);
+		}
+	}
+
+	void ShadowRenderer::GetViewRect(const ShadowView& view, int& x, int& y, int& size) const
+	{
+		if (view.IsCascade)
+		{
+			x = 0;
+			y = 0;
+			size = static_cast<int>(m_Settings.CascadeResolution);
+			return;
+		}
+
+		const uint32_t slotsPerRow = m_Settings.AtlasResolution / m_Settings.AtlasTileResolution;
+		size = static_cast<int>(m_Settings.AtlasTileResolution);
+		x = static_cast<int>(view.Layer % slotsPerRow) * size;
+		y = static_cast<int>(view.Layer / slotsPerRow) * size;
+	}
+
+	void ShadowRenderer::UploadMatrices(const std::vector<ShadowLight>& lights)
+	{
+		m_MatrixData.clear();
+		m_ShadowIndices.clear();
+
+		const float tileScale = static_cast<float>(m_Settings.AtlasTileResolution) / m_Settings.AtlasResolution;
+
+		for (const ShadowLight& light : lights)
+		{
+			auto it = m_LightShadows.find(light.Id);
+			if (it == m_LightShadows.end())
+			{
+				continue;
+			}
+
+			const std::vector<ShadowView>& faces = it->second.Faces;
+			bool complete = std::all_of(faces.begin(), faces.end(), [](const ShadowView& face) { return face.Rendered; });
+			if (!complete)
+			{
+				continue;
+			}
+
+			m_ShadowIndices[light.Id] = static_cast<int>(m_MatrixData.size() / 4);
+			for (const ShadowView& face : faces)
+			{
+				int x = 0, y = 0, size = 0;
+				GetViewRect(face, x, y, size);
+
+				const glm::mat4 matrix = TextureMatrix(static_cast<float>(x) / m_Settings.AtlasResolution,
+					static_cast<float>(y) / m_Settings.AtlasResolution, tileScale) * face.RenderedViewProjection;
+				for (int column = 0; column < 4; ++column)
+				{
+					m_MatrixData.push_back(matrix[column]);
+				}
+			}
+			m_Stats.ShadowedLights++;
+		}
+
+		if (m_MatrixBuffer == 0)
+		{
+			glGenBuffers(1, &m_MatrixBuffer);
+			glGenTextures(1, &m_MatrixTexture);
+
+			glBindBuffer(GL_TEXTURE_BUFFER, m_MatrixBuffer);
+			glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+
+			glBindTexture(GL_TEXTURE_BUFFER, m_MatrixTexture);
+			glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_MatrixBuffer);
+			glBindTexture(GL_TEXTURE_BUFFER, 0);
+		}
+
+		const size_t bytes = m_MatrixData.size() * sizeof(glm::vec4);
+		glBindBuffer(GL_TEXTURE_BUFFER, m_MatrixBuffer);
+		glBufferData(GL_TEXTURE_BUFFER, std::max(bytes, sizeof(glm::mat4)), nullptr, GL_STREAM_DRAW);
+		if (bytes > 0)
+		{
+			glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, m_MatrixData.data());
+		}
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	}
+
+	int ShadowRenderer::GetShadowIndex(const void* lightId) const
+	{
+		auto it = m_ShadowIndices.find(lightId);
+		return it != m_ShadowIndices.end() ? it->second : -1;
+	}
+
+	void ShadowRenderer::CreateFallbacks() const
+	{
+		m_FallbackCascade = CreateDepthTexture(GL_TEXTURE_2D_ARRAY, 1, 1, true);
+		m_FallbackAtlas = CreateDepthTexture(GL_TEXTURE_2D, 1, 1, true);
+
+		const glm::vec4 zero[4] = {};
+		glGenBuffers(1, &m_FallbackMatrixBuffer);
+		glBindBuffer(GL_TEXTURE_BUFFER, m_FallbackMatrixBuffer);
+		glBufferData(GL_TEXTURE_BUFFER, sizeof(zero), zero, GL_STATIC_DRAW);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		glGenTextures(1, &m_FallbackMatrixTexture);
+		glBindTexture(GL_TEXTURE_BUFFER, m_FallbackMatrixTexture);
+		glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_FallbackMatrixBuffer);
+		glBindTexture(GL_TEXTURE_BUFFER, 0);
+	}
+
+	void ShadowRenderer::Apply(const Shader& shader) const
+	{
+		if (m_FallbackCascade == 0)
+		{
+			CreateFallbacks();
+		}
+
+		// Nothing samples a placeholder: there are no cascades and every light's shadow index is -1.
+		const uint32_t cascades = m_CascadeTexture != 0 ? m_ActiveCascades : 0;
+
+		glActiveTexture(GL_TEXTURE0 + k_ShadowMatrixUnit);
+		glBindTexture(GL_TEXTURE_BUFFER, m_MatrixTexture != 0 ? m_MatrixTexture : m_FallbackMatrixTexture);
+		glActiveTexture(GL_TEXTURE0 + k_CascadeUnit);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, m_CascadeTexture != 0 ? m_CascadeTexture : m_FallbackCascade);
+		glActiveTexture(GL_TEXTURE0 + k_AtlasUnit);
+		glBindTexture(GL_TEXTURE_2D, m_AtlasTexture != 0 ? m_AtlasTexture : m_FallbackAtlas);
+		glActiveTexture(GL_TEXTURE0);
+
+		shader.SetInt("u_ShadowMatrices", k_ShadowMatrixUnit);
+		shader.SetInt("u_CascadeShadowMap", k_CascadeUnit);
+		shader.SetInt("u_ShadowAtlas", k_AtlasUnit);
+
+		shader.SetInt("u_CascadeCount", static_cast<int>(cascades));
+		for (uint32_t i = 0; i < cascades; ++i)
+		{
+			const std::string index = "[" + std::to_string(i) + "]";
+			shader.SetMat4("u_CascadeMatrices" + index, TextureMatrix(0.0f, 0.0f, 1.0f) * m_Cascades[i].RenderedViewProjection);
+			shader.SetFloat("u_CascadeSplits" + index, m_CascadeSplits[i]);
+		}
+	}
+
+	void ShadowRenderer::Release()
+	{
+		unsigned int textures[] = { m_CascadeTexture, m_CascadeCache, m_AtlasTexture, m_AtlasCache, m_MatrixTexture,
+			m_FallbackCascade, m_FallbackAtlas, m_FallbackMatrixTexture };
+		unsigned int framebuffers[] = { m_Framebuffer, m_CacheFramebuffer };
+		unsigned int buffers[] = { m_MatrixBuffer, m_FallbackMatrixBuffer };
+		glDeleteTextures(8, textures);
+		glDeleteFramebuffers(2, framebuffers);
+		glDeleteBuffers(2, buffers);
+		m_Executor.Release();
+
+		m_CascadeTexture = m_CascadeCache = m_AtlasTexture = m_AtlasCache = m_MatrixTexture = 0;
+		m_FallbackCascade = m_FallbackAtlas = m_FallbackMatrixTexture = 0;
+		m_Framebuffer = m_CacheFramebuffer = 0;
+		m_MatrixBuffer = m_FallbackMatrixBuffer = 0;
+		m_Dirty = true;
+	}
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#ifndef SHADOW_RENDERER_H
+#define SHADOW_RENDERER_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "CommandList.h"
+#include "GLCommandExecutor.h"
+#include "ClusteredLighting.h"
+#include "../Math/Bounds.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	class Shader;
+	class Mesh;
+
+	struct ShadowSettings
+	{
+		uint32_t CascadeCount = 4;				// 1..ShadowRenderer::k_MaxCascades
+		uint32_t CascadeResolution = 2048;
+		float ShadowDistance = 100.0f;			// Directional shadows end here or at the far plane
+		float CascadeSplitLambda = 0.75f;		// 0 = uniform splits, 1 = logarithmic splits
+		float CascadePadding = 1.25f;			// Cascades only re-fit once the view slice leaves this margin
+		float CasterExtrusion = 100.0f;			// How far behind a cascade casters are still captured
+
+		uint32_t AtlasResolution = 4096;
+		uint32_t AtlasTileResolution = 512;		// One tile per spot light, six per point light
+
+		uint32_t MaxViewUpdatesPerFrame = 8;	// Cascade 0 is refreshed on top of this
+		float DepthBiasFactor = 2.0f;
+		float DepthBiasUnits = 4.0f;
+	};
+
+	// A mesh instance that may cast shadows this frame. Static casters are cached per shadow view.
+	struct ShadowCaster
+	{
+		const Mesh* Geometry = nullptr;
+		glm::mat4 Model = glm::mat4(1.0f);
+		Bounds LocalBounds;
+		bool Static = false;
+	};
+
+	// A point or spot light asking for a shadow. Id only has to stay stable across frames.
+	struct ShadowLight
+	{
+		const void* Id = nullptr;
+		ClusterLightType Type = ClusterLightType::Point;
+		glm::vec3 Position = glm::vec3(0.0f);
+		glm::vec3 Direction = glm::vec3(0.0f, 0.0f, -1.0f);
+		float Range = 10.0f;
+		float SpotAngle = 45.0f;
+		float Importance = 1.0f;	// Decides who gets atlas space and update budget first
+	};
+
+	struct ShadowStats
+	{
+		uint32_t ActiveViews = 0;
+		uint32_t UpdatedViews = 0;
+		uint32_t StaticRedraws = 0;
+		uint32_t DeferredViews = 0;
+		uint32_t CasterDraws = 0;
+		uint32_t ShadowedLights = 0;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Shadow maps for the main directional light (cascades in a depth texture array) and for
+	// point and spot lights (tiles in a depth atlas, six per point light).
+	// Every shadow view keeps a second depth texture holding only its static casters. That cache is
+	// redrawn when the view's matrix or the static casters it sees change; otherwise an update is a
+	// depth blit from the cache plus a draw of the dynamic casters. Views that need an update are
+	// ranked by importance and staleness and at most MaxViewUpdatesPerFrame are redrawn per frame;
+	// the rest keep sampling their previous contents with the matrix they were rendered with.
+	class ORCA_API ShadowRenderer
+	{
+	public:
+		static constexpr uint32_t k_MaxCascades = 4;
+		static constexpr uint32_t k_PointLightFaces = 6;
+
+		// Takes effect on the next Render(); textures are freed and every cache is dropped. The
+		// cascade array and the atlas are each allocated by the first Render() that needs them.
+		void SetSettings(const ShadowSettings& settings);
+		const ShadowSettings& GetSettings() const { return m_Settings; }
+
+		// GL thread only. directional may be null. Leaves framebuffer 0 and the viewport restored.
+		void Render(const std::vector<ShadowCaster>& casters, const DirectionalLight* directional,
+			const std::vector<ShadowLight>& lights, const glm::mat4& cameraView, const glm::mat4& cameraProjection,
+			float cameraNear, float cameraFar, const Shader& depthShader);
+
+		// First matrix of the light in u_ShadowMatrices, or -1 while it has no complete shadow map.
+		int GetShadowIndex(const void* lightId) const;
+
+		// Call on every program bind, rendered or not: the shadow samplers must sit on their own
+		// units even before the first Render(), or they share unit 0 with the material's textures.
+		// Maps that do not exist yet are replaced by 1x1 placeholders and no cascades.
+		void Apply(const Shader& shader) const;
+		void Release();
+
+		const ShadowStats& GetStats() const { return m_Stats; }
+
+	private:
+		struct ShadowView
+		{
+			glm::mat4 ViewProjection = glm::mat4(1.0f);		// Fitted this frame
+			glm::mat4 RenderedViewProjection = glm::mat4(1.0f);	// Matches the cached depth
+			uint64_t StaticHash = 0;
+			uint32_t Layer = 0;		// Cascade layer or atlas slot
+			bool IsCascade = false;
+			bool Rendered = false;
+			bool HadDynamicCasters = false;
+			uint32_t FramesSinceUpdate = 0;
+			float Importance = 0.0f;
+
+			// Rebuilt every frame by the culling jobs.
+			std::vector<uint32_t> StaticCasters;
+			std::vector<uint32_t> DynamicCasters;
+			uint64_t PendingStaticHash = 0;
+			bool StaticDirty = false;
+		};
+
+		struct LightShadow
+		{
+			ClusterLightType Type = ClusterLightType::Point;
+			std::vector<ShadowView> Faces;
+		};
+
+		ShadowSettings m_Settings;
+		ShadowStats m_Stats;
+		bool m_Dirty = true;
+
+		std::array<ShadowView, k_MaxCascades> m_Cascades;
+		std::array<glm::vec3, k_MaxCascades> m_CascadeCenters{};
+		std::array<float, k_MaxCascades> m_CascadeSplits{};
+		glm::vec3 m_DirectionalDirection = glm::vec3(0.0f);
+		uint32_t m_ActiveCascades = 0;
+
+		std::unordered_map<const void*, LightShadow> m_LightShadows;
+		std::unordered_map<const void*, int> m_ShadowIndices;
+		std::vector<uint32_t> m_FreeSlots;
+
+		std::vector<ShadowView*> m_ActiveViews;
+		std::vector<glm::vec4> m_MatrixData;	// Four texels per matrix
+		CommandList m_Commands;
+		GLCommandExecutor m_Executor;
+
+		unsigned int m_CascadeTexture = 0;
+		unsigned int m_CascadeCache = 0;
+		unsigned int m_AtlasTexture = 0;
+		unsigned int m_AtlasCache = 0;
+		unsigned int m_Framebuffer = 0;
+		unsigned int m_CacheFramebuffer = 0;
+		unsigned int m_MatrixBuffer = 0;
+		unsigned int m_MatrixTexture = 0;
+
+		// Placeholders bound by Apply() in place of maps that have not been created; made on first use.
+		mutable unsigned int m_FallbackCascade = 0;
+		mutable unsigned int m_FallbackAtlas = 0;
+		mutable unsigned int m_FallbackMatrixBuffer = 0;
+		mutable unsigned int m_FallbackMatrixTexture = 0;
+
+		void ResetTargets();
+		void CreateCascadeTargets();
+		void CreateAtlasTargets();
+		void CreateFramebuffers();
+		void CreateFallbacks() const;
+		void FitCascades(const DirectionalLight& directional, const glm::mat4& cameraView, const glm::mat4& cameraProjection, float cameraNear, float cameraFar);
+		void AssignLightViews(const std::vector<ShadowLight>& lights);
+		void CullViews(const std::vector<ShadowCaster>& casters);
+		void RenderView(ShadowView& view, const std::vector<ShadowCaster>& casters, const Shader& depthShader);
+		void DrawCasters(const std::vector<uint32_t>& indices, const std::vector<ShadowCaster>& casters, const glm::mat4& viewProjection, const Shader& depthShader);
+		void AttachView(unsigned int framebuffer, unsigned int texture, const ShadowView& view) const;
+		void GetViewRect(const ShadowView& view, int& x, int& y, int& size) const;
+		void UploadMatrices(const std::vector<ShadowLight>& lights);
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -0,0 +1,233 @@
+#include "SpriteBatch.h"
+#include "Shader.h"
+#include "ShaderRegistry.h"
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+
+namespace Orca
+{
+	namespace
+	{
+		constexpr uint64_t k_ArrayTextureBit = 1ull << 32;
+
+		// Texture units the shader samples plain textures and texture arrays from.
+		constexpr GLint k_TextureUnit = 0;
+		constexpr GLint k_ArrayTextureUnit = 1;
+
+		uint32_t PackColor(const glm::vec4& color)
+		{
+			const glm::vec4 scaled = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+			return static_cast<uint32_t>(scaled.x) | (static_cast<uint32_t>(scaled.y) << 8) |
+				(static_cast<uint32_t>(scaled.z) << 16) | (static_cast<uint32_t>(scaled.w) << 24);
+		}
+	}
+
+	SpriteBatch::~SpriteBatch()
+	{
+		Release();
+	}
+
+	void SpriteBatch::Begin(const glm::mat4& viewProjection, SpriteSortMode sortMode)
+	{
+		m_ViewProjection = viewProjection;
+		m_SortMode = sortMode;
+		m_Instances.clear();
+		m_Keys.clear();
+	}
+
+	void SpriteBatch::Draw(const Sprite& sprite)
+	{
+		const bool isArray = sprite.Texture != 0 && sprite.Layer >= 0;
+
+		Instance instance;
+		instance.PositionSize = glm::vec4(sprite.Position, sprite.Size);
+		instance.OriginRotation = glm::vec4(sprite.Origin, sprite.Rotation, isArray ? static_cast<float>(sprite.Layer) : 0.0f);
+		instance.UVRect = sprite.UVRect;
+		instance.Color = PackColor(sprite.Color);
+
+		m_Instances.push_back(instance);
+		m_Keys.push_back(static_cast<TextureKey>(sprite.Texture) | (isArray ? k_ArrayTextureBit : 0));
+	}
+
+	void SpriteBatch::Draw(unsigned int texture, const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+	{
+		Sprite sprite;
+		sprite.Position = position;
+		sprite.Size = size;
+		sprite.Origin = glm::vec2(0.0f);
+		sprite.Color = color;
+		sprite.Texture = texture;
+		Draw(sprite);
+	}
+
+	bool SpriteBatch::End()
+	{
+		m_Stats = {};
+		if (m_Instances.empty())
+		{
+			return true;
+		}
+
+		Shader* shader = ShaderRegistry::Find("Sprite");
+		if (!shader || !shader->IsValid())
+		{
+			m_Instances.clear();
+			m_Keys.clear();
+			return false;
+		}
+
+		if (m_VAO == 0)
+		{
+			CreateResources();
+		}
+
+		const std::vector<Instance>* instances = &m_Instances;
+		if (m_SortMode == SpriteSortMode::Texture)
+		{
+			// Stable, so sprites sharing a texture keep their submission order.
+			m_Order.resize(m_Instances.size());
+			std::iota(m_Order.begin(), m_Order.end(), 0u);
+			std::stable_sort(m_Order.begin(), m_Order.end(), [this](uint32_t a, uint32_t b) { return m_Keys[a] < m_Keys[b]; });
+
+			m_Sorted.resize(m_Instances.size());
+			for (size_t i = 0; i < m_Order.size(); ++i)
+			{
+				m_Sorted[i] = m_Instances[m_Order[i]];
+			}
+			std::sort(m_Keys.begin(), m_Keys.end());
+			instances = &m_Sorted;
+		}
+
+		// Orphan, then refill: the driver hands back fresh storage instead of waiting on last frame's draws.
+		const size_t bytes = instances->size() * sizeof(Instance);
+		glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+		if (bytes > m_Capacity)
+		{
+			m_Capacity = std::max(bytes, m_Capacity * 2);
+		}
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_Capacity), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), instances->data());
+		m_Stats.UploadBytes = bytes;
+
+		const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+		const GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+		const GLboolean blend = glIsEnabled(GL_BLEND);
+		glDisable(GL_DEPTH_TEST);
+		glDisable(GL_CULL_FACE);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+		shader->Bind();
+		shader->SetMat4("u_ViewProjection", m_ViewProjection);
+		shader->SetInt("u_Texture", k_TextureUnit);
+		shader->SetInt("u_TextureArray", k_ArrayTextureUnit);
+		glBindVertexArray(m_VAO);
+
+		TextureKey boundKey = ~0ull;
+		int useArray = -1;
+		size_t first = 0;
+
+		while (first < m_Keys.size())
+		{
+			size_t end = first + 1;
+			while (end < m_Keys.size() && m_Keys[end] == m_Keys[first])
+			{
+				end++;
+			}
+
+			const TextureKey key = m_Keys[first];
+			if (key != boundKey)
+			{
+				boundKey = key;
+				const bool isArray = (key & k_ArrayTextureBit) != 0;
+				const GLuint texture = static_cast<GLuint>(key & ~k_ArrayTextureBit);
+
+				glActiveTexture(GL_TEXTURE0 + (isArray ? k_ArrayTextureUnit : k_TextureUnit));
+				glBindTexture(isArray ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D, texture != 0 ? texture : m_WhiteTexture);
+				m_Stats.TextureBinds++;
+
+				if (useArray != (isArray ? 1 : 0))
+				{
+					useArray = isArray ? 1 : 0;
+					shader->SetInt("u_UseArray", useArray);
+				}
+			}
+
+			SetInstanceOffset(first);
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(end - first));
+			m_Stats.DrawCalls++;
+
+			first = end;
+		}
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glActiveTexture(GL_TEXTURE0);
+		shader->Unbind();
+
+		if (depthTest) glEnable(GL_DEPTH_TEST);
+		if (cullFace) glEnable(GL_CULL_FACE);
+		if (!blend) glDisable(GL_BLEND);
+
+		m_Stats.Sprites = static_cast<uint32_t>(m_Instances.size());
+		m_Instances.clear();
+		m_Keys.clear();
+		return true;
+	}
+
+	void SpriteBatch::Release()
+	{
+		if (m_VAO != 0)
+		{
+			glDeleteVertexArrays(1, &m_VAO);
+			glDeleteBuffers(1, &m_Buffer);
+			glDeleteTextures(1, &m_WhiteTexture);
+		}
+
+		m_VAO = 0;
+		m_Buffer = 0;
+		m_WhiteTexture = 0;
+		m_Capacity = 0;
+		m_Instances.clear();
+		m_Keys.clear();
+		m_Order.clear();
+		m_Sorted.clear();
+	}
+
+	void SpriteBatch::CreateResources()
+	{
+		glGenVertexArrays(1, &m_VAO);
+		glGenBuffers(1, &m_Buffer);
+
+		glBindVertexArray(m_VAO);
+		for (GLuint location = 0; location < 4; ++location)
+		{
+			glEnableVertexAttribArray(location);
+			glVertexAttribDivisor(location, 1);
+		}
+		glBindVertexArray(0);
+
+		// Untextured sprites sample this, so they need no shader variant of their own.
+		const uint32_t white = 0xFFFFFFFFu;
+		glGenTextures(1, &m_WhiteTexture);
+		glBindTexture(GL_TEXTURE_2D, m_WhiteTexture);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &white);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+
+	void SpriteBatch::SetInstanceOffset(size_t firstInstance) const
+	{
+		// Pointing the attributes at the run's first instance works without base-instance draws (GL 4.2).
+		const GLsizei stride = sizeof(Instance);
+		const uintptr_t base = firstInstance * sizeof(Instance);
+
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(base + offsetof(Instance, PositionSize)));
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(base + offsetof(Instance, OriginRotation)));
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(base + offsetof(Instance, UVRect)));
+		glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, reinterpret_cast<const void*>(base + offsetof(Instance, Color)));
+	}
+}
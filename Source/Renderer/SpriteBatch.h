@@ -0,0 +1,107 @@
+#pragma once
+
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	struct Sprite
+	{
+		glm::vec2 Position = glm::vec2(0.0f);			// Where Origin lands
+		glm::vec2 Size = glm::vec2(1.0f);
+		glm::vec2 Origin = glm::vec2(0.5f);				// Pivot for rotation, as a fraction of Size
+		float Rotation = 0.0f;							// Radians, counter-clockwise
+		glm::vec4 UVRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);	// Min and max uv, e.g. an atlas region
+		glm::vec4 Color = glm::vec4(1.0f);
+		unsigned int Texture = 0;						// 0 draws the sprite untextured
+		int Layer = -1;									// 0 or more: Texture is a GL_TEXTURE_2D_ARRAY
+	};
+
+	enum class SpriteSortMode : uint8_t
+	{
+		Deferred,		// Submission order; a draw per run of sprites sharing a texture
+		Texture			// Grouped by texture, so a draw per texture; only for sprites that don't overlap or blend
+	};
+
+	struct SpriteBatchStats
+	{
+		uint32_t Sprites = 0;
+		uint32_t DrawCalls = 0;
+		uint32_t TextureBinds = 0;
+		uint64_t UploadBytes = 0;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	// Collects sprites between Begin() and End() and draws them instanced from one streaming vertex
+	// buffer: a sprite is one 52-byte instance, expanded to a quad in the vertex shader. Sprites only
+	// split a draw when their texture changes, so atlases (one texture, a UV rect per sprite) and
+	// texture arrays (one texture, a layer per sprite) draw any number of sprites in one call.
+	//
+	// The buffer is orphaned and refilled once per End(). Draws with alpha blending and no depth test
+	// into whatever framebuffer is bound. Uses the "Sprite" shader from the registry; until that is
+	// ready, End() drops the sprites.
+	//
+	// GL thread only.
+	class ORCA_API SpriteBatch
+	{
+	public:
+		SpriteBatch() = default;
+		~SpriteBatch();
+
+		SpriteBatch(const SpriteBatch&) = delete;
+		SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+		// viewProjection maps sprite positions to clip space, e.g. glm::ortho over the viewport.
+		void Begin(const glm::mat4& viewProjection, SpriteSortMode sortMode = SpriteSortMode::Deferred);
+		void Draw(const Sprite& sprite);
+		void Draw(unsigned int texture, const glm::vec2& position, const glm::vec2& size, const glm::vec4& color = glm::vec4(1.0f));
+
+		// Returns false if the sprites were dropped.
+		bool End();
+
+		void Release();
+
+		size_t GetCount() const { return m_Instances.size(); }
+		const SpriteBatchStats& GetStats() const { return m_Stats; }
+
+	private:
+		// Per-instance vertex data, laid out as the Sprite shader's attributes.
+		struct Instance
+		{
+			glm::vec4 PositionSize;
+			glm::vec4 OriginRotation;		// w: array layer
+			glm::vec4 UVRect;
+			uint32_t Color;					// RGBA8
+		};
+
+		// Texture in the low bits, array flag above it.
+		using TextureKey = uint64_t;
+
+		std::vector<Instance> m_Instances;
+		std::vector<TextureKey> m_Keys;
+		std::vector<uint32_t> m_Order;
+		std::vector<Instance> m_Sorted;
+
+		glm::mat4 m_ViewProjection = glm::mat4(1.0f);
+		SpriteSortMode m_SortMode = SpriteSortMode::Deferred;
+		SpriteBatchStats m_Stats;
+
+		unsigned int m_VAO = 0;
+		unsigned int m_Buffer = 0;
+		size_t m_Capacity = 0;			// Bytes
+		unsigned int m_WhiteTexture = 0;
+
+		void CreateResources();
+		void SetInstanceOffset(size_t firstInstance) const;
+	};
+#pragma warning(pop)
+}
+
+#endif
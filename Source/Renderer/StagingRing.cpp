@@ -0,0 +1,177 @@
+#include "StagingRing.h"
+#include <GL/glew.h>
+
+namespace Orca
+{
+	namespace
+	{
+		// Keeps every allocation aligned for any texel block and for the driver's DMA.
+		constexpr size_t k_Alignment = 256;
+
+		bool IsSignaled(void* sync)
+		{
+			const GLenum status = glClientWaitSync(static_cast<GLsync>(sync), 0, 0);
+			return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+		}
+	}
+
+	StagingRing::~StagingRing()
+	{
+		Release();
+	}
+
+	bool StagingRing::Create(size_t capacity)
+	{
+		Release();
+
+		if (!(GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage))
+		{
+			return false;
+		}
+
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glGenBuffers(1, &m_Buffer);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Buffer);
+		glBufferStorage(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+		m_Mapped = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(capacity), flags));
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		if (!m_Mapped)
+		{
+			glDeleteBuffers(1, &m_Buffer);
+			m_Buffer = 0;
+			return false;
+		}
+
+		m_Capacity = capacity;
+		m_Head = 0;
+		return true;
+	}
+
+	void StagingRing::Release()
+	{
+		for (const Block& block : m_Blocks)
+		{
+			if (block.Sync)
+			{
+				glDeleteSync(static_cast<GLsync>(block.Sync));
+			}
+		}
+		m_Blocks.clear();
+
+		if (m_Buffer != 0)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_Buffer);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			glDeleteBuffers(1, &m_Buffer);
+		}
+
+		m_Buffer = 0;
+		m_Mapped = nullptr;
+		m_Capacity = 0;
+		m_Head = 0;
+	}
+
+	StagingAllocation StagingRing::Allocate(size_t bytes)
+	{
+		bytes = (bytes + k_Alignment - 1) / k_Alignment * k_Alignment;
+		if (!m_Mapped || bytes == 0 || bytes > m_Capacity)
+		{
+			return {};
+		}
+
+		Retire();
+
+		size_t offset = 0;
+		if (m_Blocks.empty())
+		{
+			m_Head = 0;
+		}
+		else
+		{
+			const size_t tail = m_Blocks.front().Offset;
+			if (m_Head > tail)
+			{
+				// Free space runs to the end and then from the start up to the oldest block.
+				if (m_Head + bytes <= m_Capacity)
+				{
+					offset = m_Head;
+				}
+				else if (bytes <= tail)
+				{
+					offset = 0;
+				}
+				else
+				{
+					return {};
+				}
+			}
+			else if (m_Head + bytes <= tail)
+			{
+				offset = m_Head;
+			}
+			else
+			{
+				return {};
+			}
+		}
+
+		m_Blocks.push_back({ offset, bytes });
+		m_Head = offset + bytes;
+		return { offset, bytes, m_Mapped + offset };
+	}
+
+	void StagingRing::Free(const StagingAllocation& allocation, bool usedByGpu)
+	{
+		for (Block& block : m_Blocks)
+		{
+			if (block.Offset == allocation.Offset && !block.Freed)
+			{
+				block.Freed = true;
+				block.AwaitingFence = usedByGpu;
+				break;
+			}
+		}
+
+		Retire();
+	}
+
+	void StagingRing::Fence()
+	{
+		for (Block& block : m_Blocks)
+		{
+			if (block.AwaitingFence)
+			{
+				block.Sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				block.AwaitingFence = false;
+			}
+		}
+
+		Retire();
+	}
+
+	void StagingRing::Retire()
+	{
+		while (!m_Blocks.empty())
+		{
+			Block& block = m_Blocks.front();
+			if (!block.Freed || block.AwaitingFence || (block.Sync && !IsSignaled(block.Sync)))
+			{
+				break;
+			}
+
+			if (block.Sync)
+			{
+				glDeleteSync(static_cast<GLsync>(block.Sync));
+			}
+			m_Blocks.pop_front();
+		}
+
+		if (m_Blocks.empty())
+		{
+			m_Head = 0;
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef STAGING_RING_H
+#define STAGING_RING_H
+
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	struct StagingAllocation
+	{
+		size_t Offset = 0;
+		size_t Size = 0;
+		unsigned char* Data = nullptr;		// Mapped; any thread may write it until Release()
+
+		explicit operator bool() const { return Data != nullptr; }
+	};
+
+	// A persistently mapped pixel unpack buffer handed out front to back. Workers write into their
+	// allocation directly, and the GL thread uploads from it with the buffer bound to
+	// GL_PIXEL_UNPACK_BUFFER, so the upload is a DMA from pinned memory instead of a copy from the
+	// heap. Space comes back in allocation order, once the GPU has finished reading it.
+	//
+	// Every method is GL thread only; only the mapped memory is shared.
+	class ORCA_API StagingRing
+	{
+	public:
+		StagingRing() = default;
+		~StagingRing();
+
+		StagingRing(const StagingRing&) = delete;
+		StagingRing& operator=(const StagingRing&) = delete;
+
+		// Fails without GL 4.4 or ARB_buffer_storage; callers then stage on the heap.
+		bool Create(size_t capacity);
+		void Release();
+
+		bool IsCreated() const { return m_Buffer != 0; }
+		size_t GetCapacity() const { return m_Capacity; }
+		unsigned int GetBuffer() const { return m_Buffer; }
+
+		// Empty if the space isn't free yet.
+		StagingAllocation Allocate(size_t bytes);
+
+		// Returns the allocation. If the GPU read it, the space is reused only after the next Fence().
+		void Free(const StagingAllocation& allocation, bool usedByGpu);
+
+		// Once per frame after the uploads: covers everything freed since the last fence.
+		void Fence();
+
+	private:
+		struct Block
+		{
+			size_t Offset;
+			size_t Size;
+			bool Freed = false;
+			bool AwaitingFence = false;
+			void* Sync = nullptr;
+		};
+
+		unsigned int m_Buffer = 0;
+		unsigned char* m_Mapped = nullptr;
+		size_t m_Capacity = 0;
+		size_t m_Head = 0;			// Next allocation starts here
+		std::deque<Block> m_Blocks;	// Live allocations, oldest first
+
+		void Retire();
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -1,6 +1,10 @@
 #include "Texture.h"
+#include "TextureStreamer.h"
+#include "../Asset/Image/KTX2.h"
+#include "../Core/Logger.h"
 #include <GL/glew.h>
 #include <stb_image.h>
+#include <algorithm>
 #include <iostream>
 
 namespace Orca
@@ -8,6 +12,12 @@ namespace Orca
 	Texture::Texture(const std::string& path)
 		: m_Path(path), m_ID(0), m_Width(0), m_Height(0), m_Channels(0)
 	{
+        if (KTX2::IsKTX2Path(path))
+        {
+            LoadKTX2();
+            return;
+        }
+
         stbi_set_flip_vertically_on_load(true);
         unsigned char* data = stbi_load(path.c_str(), &m_Width, &m_Height, &m_Channels, 0);
         if (!data) {
@@ -30,6 +40,64 @@ namespace Orca
         stbi_image_free(data);
 	}
 
+    Texture::Texture(const std::string& path, int width, int height)
+        : m_Path(path), m_ID(0), m_Width(width), m_Height(height), m_Channels(4)
+    {
+    }
+
+    void Texture::LoadKTX2()
+    {
+        KTX2Image image;
+        if (!KTX2::Read(m_Path, image))
+        {
+            return;
+        }
+
+        m_Width = static_cast<int>(image.Width);
+        m_Height = static_cast<int>(image.Height);
+        m_Channels = 4;
+        m_Format = image.Format;
+        m_SRGB = image.SRGB;
+
+        glGenTextures(1, &m_ID);
+        glBindTexture(GL_TEXTURE_2D, m_ID);
+
+        const GLenum internalFormat = GetInternalFormat(m_Format, m_SRGB);
+        for (uint32_t mip = 0; mip < image.LevelCount; ++mip)
+        {
+            const GLsizei width = std::max(1, m_Width >> mip);
+            const GLsizei height = std::max(1, m_Height >> mip);
+            const std::vector<uint8_t>& level = image.Levels[mip];
+
+            if (IsBlockCompressed(m_Format))
+            {
+                glCompressedTexImage2D(GL_TEXTURE_2D, mip, internalFormat, width, height, 0, static_cast<GLsizei>(level.size()), level.data());
+            }
+            else
+            {
+                glTexImage2D(GL_TEXTURE_2D, mip, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data());
+            }
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.LevelCount - 1));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    unsigned int Texture::GetInternalFormat(TextureFormat format, bool srgb)
+    {
+        switch (format)
+        {
+        case TextureFormat::BC1: return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case TextureFormat::BC3: return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case TextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+        case TextureFormat::BC7: return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+        default: return srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+        }
+    }
+
     Texture::~Texture()
     {
         glDeleteTextures(1, &m_ID);
@@ -38,7 +106,9 @@ namespace Orca
     void Texture::Bind(unsigned int slot) const 
     {
         glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, m_ID);
+
+        // A streamed texture has nothing resident until its first mips arrive.
+        glBindTexture(GL_TEXTURE_2D, m_ID != 0 ? m_ID : TextureStreamer::GetFallbackTexture());
     }
 
     void Texture::Unbind() const 
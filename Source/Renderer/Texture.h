@@ -4,6 +4,8 @@
 #define TEXTURE_H
 
 #include <string>
+#include <cstdint>
+#include "../Asset/Image/BlockCompression.h"
 
 namespace Orca
 {
@@ -13,6 +15,8 @@ namespace Orca
 	class Texture
 	{
 	public:
+		// .ktx2 files are uploaded as stored, mips included; other images are decoded and get
+		// their mips generated.
 		Texture(const std::string& path);
 		~Texture();
 
@@ -20,12 +24,30 @@ namespace Orca
 		void Unbind() const;
 
 		unsigned int GetID() const;
+		const std::string& GetPath() const { return m_Path; }
+
+		// Full resolution, even when only smaller mips are resident.
+		int GetWidth() const { return m_Width; }
+		int GetHeight() const { return m_Height; }
+		TextureFormat GetFormat() const { return m_Format; }
+
 	private:
+		friend class TextureStreamer;
+
 		using Uint = unsigned int;
 		Uint m_ID;
 		std::string m_Path;
 
 		int m_Width, m_Height, m_Channels;
+		TextureFormat m_Format = TextureFormat::RGBA8;
+		bool m_SRGB = false;
+
+		void LoadKTX2();
+		static unsigned int GetInternalFormat(TextureFormat format, bool srgb);
+
+		// Streamed textures are created by TextureStreamer, which owns the GL object from then on.
+		uint32_t m_StreamIndex = ~0u;
+		Texture(const std::string& path, int width, int height);
 	};
 #pragma warning(pop)
 }
@@ -0,0 +1,735 @@
+#include "TextureStreamer.h"
+#include "../Core/JobSystem.h"
+#include "../Core/Logger.h"
+#include "../Asset/Image/KTX2.h"
+#include "../Asset/Image/TextureCooker.h"
+#include <GL/glew.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace Orca
+{
+	namespace
+	{
+		uint32_t MipDimension(int size, uint32_t mip)
+		{
+			return std::max(1u, static_cast<uint32_t>(size) >> mip);
+		}
+
+		// Runs on a worker. PNG and JPEG can't be decoded partially, so the whole image is decoded
+		// and reduced to the requested mips; only those are kept.
+		bool DecodeMips(const std::string& path, int expectedWidth, int expectedHeight, uint32_t topMip, uint32_t mipCount,
+			std::vector<std::vector<unsigned char>>& levels)
+		{
+			int width = 0, height = 0, channels = 0;
+			unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+			if (!pixels)
+			{
+				return false;
+			}
+
+			if (width != expectedWidth || height != expectedHeight)
+			{
+				stbi_image_free(pixels);
+				return false;
+			}
+
+			// Flipped here; stbi_set_flip_vertically_on_load is global and the workers share it.
+			const size_t rowBytes = size_t(width) * 4;
+			std::vector<unsigned char> current(rowBytes * height);
+			for (int y = 0; y < height; ++y)
+			{
+				std::memcpy(&current[y * rowBytes], pixels + (height - 1 - y) * rowBytes, rowBytes);
+			}
+			stbi_image_free(pixels);
+
+			uint32_t mipWidth = static_cast<uint32_t>(width);
+			uint32_t mipHeight = static_cast<uint32_t>(height);
+			std::vector<unsigned char> next;
+			for (uint32_t mip = 0; mip < mipCount; ++mip)
+			{
+				if (mip >= topMip)
+				{
+					levels.push_back(current);
+				}
+
+				if (mip + 1 < mipCount)
+				{
+					TextureCooker::Downsample(current, mipWidth, mipHeight, next);
+					current.swap(next);
+					mipWidth = std::max(1u, mipWidth / 2);
+					mipHeight = std::max(1u, mipHeight / 2);
+				}
+			}
+			return true;
+		}
+
+		void SetSamplerState(uint32_t levelCount)
+		{
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount - 1));
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
+	}
+
+	TextureStreamingSettings TextureStreamer::s_Settings;
+	TextureStreamingStats TextureStreamer::s_Stats;
+	std::vector<std::unique_ptr<TextureStreamer::Entry>> TextureStreamer::s_Entries;
+	std::unordered_map<std::string, uint32_t> TextureStreamer::s_Lookup;
+	std::vector<uint32_t> TextureStreamer::s_FreeSlots;
+	std::atomic<uint64_t> TextureStreamer::s_Frame{ 0 };
+	unsigned int TextureStreamer::s_Fallback = 0;
+	StagingRing TextureStreamer::s_Staging;
+	std::mutex TextureStreamer::s_ReleaseMutex;
+	std::vector<Texture*> TextureStreamer::s_Released;
+	bool TextureStreamer::s_Running = false;
+	std::mutex TextureStreamer::s_CompletedMutex;
+	std::vector<TextureStreamer::LoadResult> TextureStreamer::s_Completed;
+	std::vector<std::future<void>> TextureStreamer::s_InFlight;
+
+	void TextureStreamer::Initialize(const TextureStreamingSettings& settings)
+	{
+		s_Settings = settings;
+		s_Stats.BudgetBytes = settings.BudgetBytes;
+
+		if (s_Fallback == 0)
+		{
+			const unsigned char grey[4] = { 128, 128, 128, 255 };
+			glGenTextures(1, &s_Fallback);
+			glBindTexture(GL_TEXTURE_2D, s_Fallback);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, grey);
+			SetSamplerState(1);
+			glBindTexture(GL_TEXTURE_2D, 0);
+		}
+
+		if (settings.StagingBytes > 0 && !s_Staging.Create(settings.StagingBytes))
+		{
+			Logger::Log(LogLevel::Info, "Persistent buffer mapping unavailable; texture uploads are staged on the heap.");
+		}
+
+		std::lock_guard<std::mutex> lock(s_ReleaseMutex);
+		s_Running = true;
+	}
+
+	void TextureStreamer::Shutdown()
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_ReleaseMutex);
+			s_Released.clear();
+			s_Running = false;
+		}
+
+		for (auto& load : s_InFlight)
+		{
+			load.wait();
+		}
+		s_InFlight.clear();
+		s_Completed.clear();
+		s_Staging.Release();
+		s_Entries.clear();
+		s_Lookup.clear();
+		s_FreeSlots.clear();
+		s_Stats = TextureStreamingStats{};
+
+		glDeleteTextures(1, &s_Fallback);
+		s_Fallback = 0;
+	}
+
+	void TextureStreamer::SetBudget(size_t bytes)
+	{
+		s_Settings.BudgetBytes = bytes;
+		s_Stats.BudgetBytes = bytes;
+	}
+
+	Texture* TextureStreamer::Load(const std::string& path, float priority)
+	{
+		auto existing = s_Lookup.find(path);
+		if (existing != s_Lookup.end())
+		{
+			Entry& entry = *s_Entries[existing->second];
+			entry.Priority = std::max(entry.Priority, priority);
+			return entry.Resource.get();
+		}
+
+		// Cooked textures carry their own mip chain and format; anything else is decoded to RGBA8.
+		KTX2Image header;
+		const bool cooked = KTX2::IsKTX2Path(path);
+		int width = 0, height = 0, channels = 0;
+		if (cooked ? !KTX2::ReadHeader(path, header) : !stbi_info(path.c_str(), &width, &height, &channels))
+		{
+			Logger::Log(LogLevel::Error, "Failed to load texture: " + path);
+			return nullptr;
+		}
+
+		if (cooked)
+		{
+			width = static_cast<int>(header.Width);
+			height = static_cast<int>(header.Height);
+		}
+
+		// A released slot is reused once its last load has come back.
+		auto freeSlot = std::find_if(s_FreeSlots.begin(), s_FreeSlots.end(), [](uint32_t slot) { return !s_Entries[slot]->Loading; });
+		const uint32_t index = freeSlot != s_FreeSlots.end() ? *freeSlot : static_cast<uint32_t>(s_Entries.size());
+		if (freeSlot != s_FreeSlots.end())
+		{
+			s_FreeSlots.erase(freeSlot);
+		}
+
+		auto entry = std::make_unique<Entry>();
+		entry->Resource.reset(new Texture(path, width, height));
+		entry->Resource->m_StreamIndex = index;
+		entry->Resource->m_Format = header.Format;
+		entry->Resource->m_SRGB = header.SRGB;
+		entry->Priority = priority;
+		entry->MipCount = cooked ? header.LevelCount : 1 + static_cast<uint32_t>(std::log2(static_cast<float>(std::max(width, height))));
+
+		while (entry->FloorMip + 1 < entry->MipCount &&
+			std::max(MipDimension(width, entry->FloorMip), MipDimension(height, entry->FloorMip)) > s_Settings.InitialMaxSize)
+		{
+			entry->FloorMip++;
+		}
+
+		entry->ResidentMip = entry->MipCount;
+		entry->WantedMip = entry->FloorMip;
+		entry->LastUsedFrame = s_Frame.load();
+
+		Texture* texture = entry->Resource.get();
+		if (index < s_Entries.size())
+		{
+			s_Entries[index] = std::move(entry);
+		}
+		else
+		{
+			s_Entries.push_back(std::move(entry));
+		}
+		s_Lookup[path] = index;
+		return texture;
+	}
+
+	void TextureStreamer::Unload(Texture& texture)
+	{
+		const uint32_t index = texture.m_StreamIndex;
+		if (index >= s_Entries.size() || s_Entries[index]->Resource.get() != &texture)
+		{
+			return;
+		}
+
+		Entry& entry = *s_Entries[index];
+		s_Lookup.erase(texture.GetPath());
+		entry.Callbacks.clear();
+		entry.Resource.reset();
+		entry.ResidentMip = entry.MipCount;
+		s_FreeSlots.push_back(index);
+	}
+
+	void TextureStreamer::Release(Texture& texture)
+	{
+		std::lock_guard<std::mutex> lock(s_ReleaseMutex);
+		if (s_Running)
+		{
+			s_Released.push_back(&texture);
+		}
+	}
+
+	void TextureStreamer::Request(const Texture& texture, float screenTexels)
+	{
+		if (texture.m_StreamIndex >= s_Entries.size())
+		{
+			return;
+		}
+
+		Entry& entry = *s_Entries[texture.m_StreamIndex];
+
+		const float ratio = static_cast<float>(std::max(texture.m_Width, texture.m_Height)) / std::max(screenTexels, 1.0f);
+		uint32_t mip = ratio > 1.0f ? static_cast<uint32_t>(std::log2(ratio)) : 0;
+		mip = std::min(mip, entry.FloorMip);
+
+		// Several draws may share the texture; the sharpest request wins.
+		uint32_t current = entry.RequestedMip.load(std::memory_order_relaxed);
+		while (mip < current && !entry.RequestedMip.compare_exchange_weak(current, mip, std::memory_order_relaxed))
+		{
+		}
+
+		entry.LastUsedFrame.store(s_Frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	void TextureStreamer::Update()
+	{
+		s_Frame.fetch_add(1);
+		s_Stats.MipsStreamedIn = 0;
+		s_Stats.MipsEvicted = 0;
+		s_Stats.UploadedBytes = 0;
+
+		std::vector<Texture*> released;
+		{
+			std::lock_guard<std::mutex> lock(s_ReleaseMutex);
+			released.swap(s_Released);
+		}
+		for (Texture* texture : released)
+		{
+			Unload(*texture);
+		}
+
+		// Uploads are capped in bytes per frame so a burst of finished decodes doesn't become a hitch.
+		std::vector<LoadResult> completed;
+		{
+			std::lock_guard<std::mutex> lock(s_CompletedMutex);
+			size_t count = 0;
+			size_t bytes = 0;
+			while (count < s_Completed.size() && (count == 0 || bytes + s_Completed[count].Bytes <= s_Settings.UploadBytesPerFrame))
+			{
+				bytes += s_Completed[count].Bytes;
+				count++;
+			}
+			std::move(s_Completed.begin(), s_Completed.begin() + count, std::back_inserter(completed));
+			s_Completed.erase(s_Completed.begin(), s_Completed.begin() + count);
+		}
+
+		for (const LoadResult& result : completed)
+		{
+			Entry& entry = *s_Entries[result.EntryIndex];
+			entry.Loading = false;
+
+			bool uploaded = false;
+			if (!entry.Resource)
+			{
+				// Unloaded while decoding.
+			}
+			else if (!result.Loaded)
+			{
+				Logger::Log(LogLevel::Error, "Failed to load texture: " + entry.Resource->GetPath());
+				entry.Failed = true;
+				NotifyReady(entry, false);
+			}
+			else if (result.TopMip < entry.ResidentMip)
+			{
+				Upload(entry, result);
+				uploaded = true;
+				s_Stats.UploadedBytes += result.Bytes;
+				NotifyReady(entry, true);
+			}
+
+			if (result.Staging)
+			{
+				s_Staging.Free(result.Staging, uploaded);
+			}
+		}
+
+		// Staging space read by this frame's uploads is reused once the GPU is past them.
+		s_Staging.Fence();
+
+		s_InFlight.erase(std::remove_if(s_InFlight.begin(), s_InFlight.end(), [](const std::future<void>& load)
+			{
+				return load.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+			}), s_InFlight.end());
+
+		size_t committedBytes = 0;
+		uint32_t loadsInFlight = 0;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> victims;
+
+		for (uint32_t i = 0; i < s_Entries.size(); ++i)
+		{
+			Entry& entry = *s_Entries[i];
+			if (!entry.Resource)
+			{
+				loadsInFlight += entry.Loading ? 1 : 0;
+				continue;
+			}
+
+			const uint32_t requested = entry.RequestedMip.exchange(k_NoRequest, std::memory_order_relaxed);
+			entry.WantedMip = requested == k_NoRequest ? entry.FloorMip : requested;
+
+			committedBytes += GetRangeBytes(entry, entry.ResidentMip, entry.MipCount);
+			if (entry.Loading)
+			{
+				committedBytes += GetRangeBytes(entry, entry.LoadingMip, entry.ResidentMip);
+				loadsInFlight++;
+				continue;
+			}
+
+			if (!entry.Failed && entry.WantedMip < entry.ResidentMip)
+			{
+				candidates.push_back(i);
+			}
+			if (entry.ResidentMip < entry.FloorMip)
+			{
+				victims.push_back(i);
+			}
+		}
+
+		// Highest priority first, then the biggest jump in sharpness.
+		std::sort(candidates.begin(), candidates.end(), [](uint32_t a, uint32_t b)
+			{
+				const Entry& left = *s_Entries[a];
+				const Entry& right = *s_Entries[b];
+				if (left.Priority != right.Priority)
+				{
+					return left.Priority > right.Priority;
+				}
+				return left.ResidentMip - left.WantedMip > right.ResidentMip - right.WantedMip;
+			});
+
+		// Mips nobody asked for go first, then lower priorities, least recently used first.
+		std::sort(victims.begin(), victims.end(), [](uint32_t a, uint32_t b)
+			{
+				const Entry& left = *s_Entries[a];
+				const Entry& right = *s_Entries[b];
+				const bool leftUnwanted = left.ResidentMip < left.WantedMip;
+				const bool rightUnwanted = right.ResidentMip < right.WantedMip;
+				if (leftUnwanted != rightUnwanted)
+				{
+					return leftUnwanted;
+				}
+				if (left.Priority != right.Priority)
+				{
+					return left.Priority < right.Priority;
+				}
+				return left.LastUsedFrame.load(std::memory_order_relaxed) < right.LastUsedFrame.load(std::memory_order_relaxed);
+			});
+
+		// Frees room for bytesNeeded by evicting mips that are unwanted or belong to textures below
+		// priority. Returns whether the budget now fits.
+		size_t nextVictim = 0;
+		auto makeRoom = [&](size_t bytesNeeded, float priority, uint32_t requester)
+			{
+				while (committedBytes + bytesNeeded > s_Settings.BudgetBytes && nextVictim < victims.size())
+				{
+					const uint32_t victimIndex = victims[nextVictim];
+					Entry& victim = *s_Entries[victimIndex];
+					const bool unwanted = victim.ResidentMip < victim.WantedMip;
+
+					if (victimIndex == requester || victim.ResidentMip >= victim.FloorMip)
+					{
+						nextVictim++;
+						continue;
+					}
+					if (!unwanted && victim.Priority >= priority)
+					{
+						break;
+					}
+
+					committedBytes -= GetMipBytes(victim, victim.ResidentMip);
+					DropTopMip(victim);
+
+					if (victim.ResidentMip >= (unwanted ? victim.WantedMip : victim.FloorMip))
+					{
+						nextVictim++;
+					}
+				}
+
+				return committedBytes + bytesNeeded <= s_Settings.BudgetBytes;
+			};
+
+		// A lowered budget is enforced even when nothing new is wanted.
+		makeRoom(0, std::numeric_limits<float>::infinity(), k_NoRequest);
+
+		for (uint32_t index : candidates)
+		{
+			if (loadsInFlight >= s_Settings.MaxLoadsInFlight)
+			{
+				break;
+			}
+
+			Entry& entry = *s_Entries[index];
+			uint32_t topMip = entry.WantedMip;
+			size_t bytes = GetRangeBytes(entry, topMip, entry.ResidentMip);
+
+			if (!makeRoom(bytes, entry.Priority, index))
+			{
+				// The small mips always load so every texture has something to draw.
+				if (entry.ResidentMip < entry.MipCount)
+				{
+					continue;
+				}
+				topMip = entry.FloorMip;
+				bytes = GetRangeBytes(entry, topMip, entry.ResidentMip);
+			}
+
+			if (!StartLoad(index, topMip))
+			{
+				continue;
+			}
+
+			committedBytes += bytes;
+			loadsInFlight++;
+		}
+
+		size_t residentBytes = 0;
+		for (const auto& entry : s_Entries)
+		{
+			if (entry->Resource)
+			{
+				residentBytes += GetRangeBytes(*entry, entry->ResidentMip, entry->MipCount);
+			}
+		}
+
+		s_Stats.ResidentBytes = residentBytes;
+		s_Stats.TextureCount = static_cast<uint32_t>(s_Entries.size() - s_FreeSlots.size());
+		s_Stats.LoadsInFlight = loadsInFlight;
+	}
+
+	void TextureStreamer::OnReady(Texture& texture, TextureReadyCallback callback)
+	{
+		if (texture.m_StreamIndex >= s_Entries.size())
+		{
+			callback(texture, texture.m_ID != 0);
+			return;
+		}
+
+		Entry& entry = *s_Entries[texture.m_StreamIndex];
+		if (entry.Failed)
+		{
+			callback(texture, false);
+		}
+		else if (entry.ResidentMip < entry.MipCount)
+		{
+			callback(texture, true);
+		}
+		else
+		{
+			entry.Callbacks.push_back(std::move(callback));
+		}
+	}
+
+	unsigned int TextureStreamer::GetFallbackTexture()
+	{
+		return s_Fallback;
+	}
+
+	const TextureStreamingStats& TextureStreamer::GetStats()
+	{
+		return s_Stats;
+	}
+
+	size_t TextureStreamer::GetMipBytes(const Entry& entry, uint32_t mip)
+	{
+		const Texture& texture = *entry.Resource;
+		return GetImageBytes(texture.m_Format, MipDimension(texture.m_Width, mip), MipDimension(texture.m_Height, mip));
+	}
+
+	size_t TextureStreamer::GetRangeBytes(const Entry& entry, uint32_t firstMip, uint32_t endMip)
+	{
+		size_t bytes = 0;
+		for (uint32_t mip = firstMip; mip < endMip; ++mip)
+		{
+			bytes += GetMipBytes(entry, mip);
+		}
+		return bytes;
+	}
+
+	bool TextureStreamer::StartLoad(uint32_t entryIndex, uint32_t topMip)
+	{
+		Entry& entry = *s_Entries[entryIndex];
+
+		// Loads too big for the ring at all go through the heap; others wait for space.
+		const size_t bytes = GetRangeBytes(entry, topMip, entry.MipCount);
+		StagingAllocation staging;
+		if (s_Staging.IsCreated() && bytes <= s_Staging.GetCapacity())
+		{
+			staging = s_Staging.Allocate(bytes);
+			if (!staging)
+			{
+				return false;
+			}
+		}
+
+		entry.Loading = true;
+		entry.LoadingMip = topMip;
+
+		const std::string path = entry.Resource->GetPath();
+		const int width = entry.Resource->m_Width;
+		const int height = entry.Resource->m_Height;
+		const uint32_t mipCount = entry.MipCount;
+		const bool cooked = KTX2::IsKTX2Path(path);
+
+		auto load = [=]()
+			{
+				LoadResult result{ entryIndex, topMip };
+				result.Staging = staging;
+
+				std::vector<std::vector<unsigned char>> levels;
+				if (cooked)
+				{
+					// Only the wanted levels are read from the file.
+					KTX2Image image;
+					if (KTX2::Read(path, image, topMip, mipCount) && image.LevelCount == mipCount)
+					{
+						std::move(image.Levels.begin() + topMip, image.Levels.end(), std::back_inserter(levels));
+						result.Loaded = true;
+					}
+				}
+				else
+				{
+					result.Loaded = DecodeMips(path, width, height, topMip, mipCount, levels);
+				}
+
+				for (const auto& level : levels)
+				{
+					result.Bytes += level.size();
+				}
+
+				if (result.Loaded && staging && result.Bytes <= staging.Size)
+				{
+					unsigned char* out = staging.Data;
+					for (const auto& level : levels)
+					{
+						std::memcpy(out, level.data(), level.size());
+						out += level.size();
+					}
+				}
+				else
+				{
+					result.Levels = std::move(levels);
+				}
+
+				std::lock_guard<std::mutex> lock(s_CompletedMutex);
+				s_Completed.push_back(std::move(result));
+			};
+
+		if (JobSystem::IsInitialized())
+		{
+			s_InFlight.push_back(JobSystem::Submit(load));
+		}
+		else
+		{
+			load();
+		}
+		return true;
+	}
+
+	void TextureStreamer::Upload(Entry& entry, const LoadResult& result)
+	{
+		Texture& texture = *entry.Resource;
+		const uint32_t levelCount = entry.MipCount - result.TopMip;
+
+		GLuint id = 0;
+		glGenTextures(1, &id);
+		glBindTexture(GL_TEXTURE_2D, id);
+
+		// From the staging buffer the data pointers are offsets into it.
+		const bool staged = result.Levels.empty();
+		if (staged)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_Staging.GetBuffer());
+		}
+
+		const GLenum internalFormat = Texture::GetInternalFormat(texture.m_Format, texture.m_SRGB);
+		size_t offset = result.Staging.Offset;
+		for (uint32_t level = 0; level < levelCount; ++level)
+		{
+			const uint32_t mip = result.TopMip + level;
+			const size_t size = GetMipBytes(entry, mip);
+			const void* data = staged ? reinterpret_cast<const void*>(offset) : result.Levels[level].data();
+			offset += size;
+
+			if (IsBlockCompressed(texture.m_Format))
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, MipDimension(texture.m_Width, mip), MipDimension(texture.m_Height, mip),
+					0, static_cast<GLsizei>(size), data);
+			}
+			else
+			{
+				glTexImage2D(GL_TEXTURE_2D, level, internalFormat, MipDimension(texture.m_Width, mip), MipDimension(texture.m_Height, mip),
+					0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+			}
+		}
+
+		if (staged)
+		{
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		}
+
+		SetSamplerState(levelCount);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glDeleteTextures(1, &texture.m_ID);
+		texture.m_ID = id;
+
+		s_Stats.MipsStreamedIn += std::min(entry.ResidentMip, entry.MipCount) - result.TopMip;
+		entry.ResidentMip = result.TopMip;
+	}
+
+	void TextureStreamer::NotifyReady(Entry& entry, bool loaded)
+	{
+		std::vector<TextureReadyCallback> callbacks;
+		callbacks.swap(entry.Callbacks);
+		for (auto& callback : callbacks)
+		{
+			callback(*entry.Resource, loaded);
+		}
+	}
+
+	void TextureStreamer::DropTopMip(Entry& entry)
+	{
+		Texture& texture = *entry.Resource;
+		const uint32_t newTop = entry.ResidentMip + 1;
+		const uint32_t levelCount = entry.MipCount - newTop;
+
+		// Without copy_image the surviving mips are read back; they're a quarter of the texture at most.
+		const bool gpuCopy = GLEW_VERSION_4_3 || GLEW_ARB_copy_image;
+		const bool compressed = IsBlockCompressed(texture.m_Format);
+		const GLenum internalFormat = Texture::GetInternalFormat(texture.m_Format, texture.m_SRGB);
+		std::vector<unsigned char> pixels;
+
+		GLuint id = 0;
+		glGenTextures(1, &id);
+
+		for (uint32_t level = 0; level < levelCount; ++level)
+		{
+			const uint32_t mip = newTop + level;
+			const uint32_t width = MipDimension(texture.m_Width, mip);
+			const uint32_t height = MipDimension(texture.m_Height, mip);
+			const size_t bytes = GetImageBytes(texture.m_Format, width, height);
+
+			const void* data = nullptr;
+			if (!gpuCopy)
+			{
+				pixels.resize(bytes);
+				glBindTexture(GL_TEXTURE_2D, texture.m_ID);
+				if (compressed)
+				{
+					glGetCompressedTexImage(GL_TEXTURE_2D, level + 1, pixels.data());
+				}
+				else
+				{
+					glGetTexImage(GL_TEXTURE_2D, level + 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+				}
+				data = pixels.data();
+			}
+
+			glBindTexture(GL_TEXTURE_2D, id);
+			if (compressed)
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, static_cast<GLsizei>(bytes), data);
+			}
+			else
+			{
+				glTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+			}
+
+			if (gpuCopy)
+			{
+				glCopyImageSubData(texture.m_ID, GL_TEXTURE_2D, level + 1, 0, 0, 0, id, GL_TEXTURE_2D, level, 0, 0, 0, width, height, 1);
+			}
+		}
+
+		glBindTexture(GL_TEXTURE_2D, id);
+		SetSamplerState(levelCount);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		glDeleteTextures(1, &texture.m_ID);
+		texture.m_ID = id;
+
+		entry.ResidentMip = newTop;
+		s_Stats.MipsEvicted++;
+	}
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <cstdint>
+#include "Texture.h"
+#include "StagingRing.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	struct TextureStreamingSettings
+	{
+		size_t BudgetBytes = size_t(256) << 20;
+		uint32_t InitialMaxSize = 64;		// Mips up to this many texels across load without being requested
+		uint32_t MaxLoadsInFlight = 4;
+		size_t UploadBytesPerFrame = size_t(16) << 20;	// At least one load is uploaded per frame
+		size_t StagingBytes = size_t(64) << 20;		// Pinned upload memory; 0 stages on the heap
+	};
+
+	struct TextureStreamingStats
+	{
+		size_t ResidentBytes = 0;
+		size_t BudgetBytes = 0;
+		uint32_t TextureCount = 0;
+		uint32_t LoadsInFlight = 0;
+		uint32_t MipsStreamedIn = 0;		// This frame
+		uint32_t MipsEvicted = 0;			// This frame
+		size_t UploadedBytes = 0;			// This frame
+	};
+
+	// Called on the GL thread once a texture has its first mips, or with loaded false if it failed.
+	using TextureReadyCallback = std::function<void(Texture& texture, bool loaded)>;
+
+	// Keeps only the mips the renderer asks for resident. Load() registers a texture and queues its
+	// small mips; the renderer then calls Request() with the texel density each draw needs and
+	// Update() decodes larger mips on the job system and uploads them. When resident mips exceed the
+	// budget, the largest mips go first from textures that no longer need them, then from textures
+	// with a lower priority, least recently used first.
+	//
+	// Workers decode straight into a persistently mapped pixel buffer, and uploads are spread over
+	// frames by byte count. A residency change reallocates the GL texture at the new size, so
+	// evicting really frees memory.
+	class ORCA_API TextureStreamer
+	{
+	public:
+		// GL thread.
+		static void Initialize(const TextureStreamingSettings& settings = {});
+		static void Shutdown();
+
+		static void SetBudget(size_t bytes);
+
+		// Main thread, not while recording jobs are running. Only reads the image header; returns
+		// null if the file can't be read. Textures with a higher priority win when the budget is tight.
+		// Cooked .ktx2 files stream the mips they store, in their compressed format.
+		static Texture* Load(const std::string& path, float priority = 1.0f);
+
+		// Main thread, between frames. Frees the texture and its GPU memory; the texture must no
+		// longer be referenced. A decode still in flight is discarded when it completes.
+		static void Unload(Texture& texture);
+
+		// Any thread. Unloads the texture at the start of the next Update(), for owners that drop
+		// their last reference at any point, like ResourceCache handles. Ignored after Shutdown(),
+		// which has freed every texture already.
+		static void Release(Texture& texture);
+
+		// Any thread. screenTexels is how many texels across the draw needs, roughly its projected
+		// size in pixels times the UV tiling. Requests are collected until the next Update().
+		static void Request(const Texture& texture, float screenTexels);
+
+		// GL thread. Runs the callback now if the texture is already usable; textures not created
+		// by the streamer count as loaded when they have a GL texture.
+		static void OnReady(Texture& texture, TextureReadyCallback callback);
+
+		// GL thread, once per frame.
+		static void Update();
+
+		// 1x1 grey, bound in place of textures that have nothing resident yet.
+		static unsigned int GetFallbackTexture();
+
+		static const TextureStreamingStats& GetStats();
+
+	private:
+		static constexpr uint32_t k_NoRequest = ~0u;
+
+		struct Entry
+		{
+			std::unique_ptr<Texture> Resource;		// Null once unloaded
+			float Priority = 1.0f;
+			uint32_t MipCount = 1;
+			uint32_t FloorMip = 0;			// Smallest mip set that is always kept
+			uint32_t ResidentMip = 0;		// Largest resident mip; MipCount when nothing is
+			uint32_t WantedMip = 0;
+			uint32_t LoadingMip = 0;		// Top mip of the decode in flight
+			bool Loading = false;
+			bool Failed = false;
+			std::atomic<uint32_t> RequestedMip{ k_NoRequest };
+			std::atomic<uint64_t> LastUsedFrame{ 0 };
+			std::vector<TextureReadyCallback> Callbacks;
+		};
+
+		struct LoadResult
+		{
+			uint32_t EntryIndex;
+			uint32_t TopMip;
+			bool Loaded = false;
+			size_t Bytes = 0;
+			StagingAllocation Staging;		// Levels packed TopMip first; empty when staged on the heap
+			std::vector<std::vector<unsigned char>> Levels;		// In the texture's format, TopMip first
+		};
+
+		static TextureStreamingSettings s_Settings;
+		static TextureStreamingStats s_Stats;
+		static std::vector<std::unique_ptr<Entry>> s_Entries;
+		static std::unordered_map<std::string, uint32_t> s_Lookup;
+		static std::vector<uint32_t> s_FreeSlots;		// Unloaded entries
+		static std::atomic<uint64_t> s_Frame;
+		static unsigned int s_Fallback;
+		static StagingRing s_Staging;
+
+		static std::mutex s_ReleaseMutex;
+		static std::vector<Texture*> s_Released;
+		static bool s_Running;
+
+		static std::mutex s_CompletedMutex;
+		static std::vector<LoadResult> s_Completed;
+		static std::vector<std::future<void>> s_InFlight;
+
+		static size_t GetMipBytes(const Entry& entry, uint32_t mip);
+		static size_t GetRangeBytes(const Entry& entry, uint32_t firstMip, uint32_t endMip);
+		static bool StartLoad(uint32_t entryIndex, uint32_t topMip);
+		static void Upload(Entry& entry, const LoadResult& result);
+		static void DropTopMip(Entry& entry);
+		static void NotifyReady(Entry& entry, bool loaded);
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -0,0 +1,240 @@
+#include "VertexCompression.h"
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+namespace Orca
+{
+	uint16_t VertexCompression::FloatToHalf(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		uint32_t sign = (bits >> 16) & 0x8000u;
+		int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+		uint32_t mantissa = bits & 0x007FFFFFu;
+
+		if (((bits >> 23) & 0xFFu) == 0xFFu)
+		{
+			// Inf stays Inf, NaN keeps a quiet bit set.
+			return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x0200u : 0u));
+		}
+
+		if (exponent >= 31)
+		{
+			return static_cast<uint16_t>(sign | 0x7C00u);
+		}
+
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+			{
+				return static_cast<uint16_t>(sign);
+			}
+
+			// Denormal: shift in the implicit bit and round to nearest even.
+			mantissa |= 0x00800000u;
+			uint32_t shift = static_cast<uint32_t>(14 - exponent);
+			uint32_t half = mantissa >> shift;
+			uint32_t remainder = mantissa & ((1u << shift) - 1u);
+			uint32_t midpoint = 1u << (shift - 1u);
+			if (remainder > midpoint || (remainder == midpoint && (half & 1u)))
+			{
+				half++;
+			}
+			return static_cast<uint16_t>(sign | half);
+		}
+
+		uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+		uint32_t remainder = mantissa & 0x1FFFu;
+		if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+		{
+			// May carry into the exponent, which correctly rounds up to the next power of two or Inf.
+			half++;
+		}
+
+		return static_cast<uint16_t>(half);
+	}
+
+	float VertexCompression::HalfToFloat(uint16_t value)
+	{
+		uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+		uint32_t exponent = (value >> 10) & 0x1Fu;
+		uint32_t mantissa = value & 0x03FFu;
+		uint32_t bits;
+
+		if (exponent == 0)
+		{
+			if (mantissa == 0)
+			{
+				bits = sign;
+			}
+			else
+			{
+				// Renormalize the denormal.
+				exponent = 127 - 15 + 1;
+				while ((mantissa & 0x0400u) == 0)
+				{
+					mantissa <<= 1;
+					exponent--;
+				}
+				mantissa &= 0x03FFu;
+				bits = sign | (exponent << 23) | (mantissa << 13);
+			}
+		}
+		else if (exponent == 31)
+		{
+			bits = sign | 0x7F800000u | (mantissa << 13);
+		}
+		else
+		{
+			bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+		}
+
+		float result;
+		std::memcpy(&result, &bits, sizeof(result));
+		return result;
+	}
+
+	int16_t VertexCompression::ToSNorm16(float value)
+	{
+		return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+	}
+
+	uint16_t VertexCompression::ToUNorm16(float value)
+	{
+		return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+	}
+
+	glm::vec2 VertexCompression::OctEncode(const glm::vec3& n)
+	{
+		float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+		if (l1 <= 0.0f)
+		{
+			return glm::vec2(0.0f);
+		}
+
+		glm::vec2 p(n.x / l1, n.y / l1);
+		if (n.z < 0.0f)
+		{
+			// Fold the lower hemisphere over the diagonals.
+			glm::vec2 folded(
+				(1.0f - std::abs(p.y)) * (p.x >= 0.0f ? 1.0f : -1.0f),
+				(1.0f - std::abs(p.x)) * (p.y >= 0.0f ? 1.0f : -1.0f));
+			p = folded;
+		}
+
+		return p;
+	}
+
+	glm::vec3 VertexCompression::OctDecode(const glm::vec2& e)
+	{
+		glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+		if (n.z < 0.0f)
+		{
+			float x = (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f);
+			float y = (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f);
+			n.x = x;
+			n.y = y;
+		}
+
+		return glm::normalize(n);
+	}
+
+	VertexDequantization VertexCompression::ComputeDequantization(const Bounds& bounds, const VertexLayout& layout)
+	{
+		VertexDequantization result;
+
+		const VertexAttributeDesc* position = layout.Find(VertexSemantic::Position);
+		if (!position)
+		{
+			return result;
+		}
+
+		if (position->Format == VertexFormat::Half4)
+		{
+			// Centering first keeps the half-float exponent small, which is where its precision lives.
+			result.Offset = bounds.GetCenter();
+		}
+		else if (position->Format == VertexFormat::UNorm16x4)
+		{
+			glm::vec3 size = bounds.GetSize();
+			result.Offset = bounds.GetMin();
+			result.Scale = glm::vec3(
+				size.x > 0.0f ? size.x : 1.0f,
+				size.y > 0.0f ? size.y : 1.0f,
+				size.z > 0.0f ? size.z : 1.0f);
+		}
+
+		return result;
+	}
+
+	void VertexCompression::Encode(const std::vector<Vertex>& vertices, const VertexLayout& layout,
+		const VertexDequantization& dequantization, std::vector<uint8_t>& out)
+	{
+		const uint32_t stride = layout.GetStride();
+		out.assign(vertices.size() * stride, 0);
+
+		const glm::vec3 inverseScale = 1.0f / dequantization.Scale;
+
+		for (size_t i = 0; i < vertices.size(); ++i)
+		{
+			const Vertex& vertex = vertices[i];
+			uint8_t* base = out.data() + i * stride;
+
+			for (const auto& attribute : layout.GetAttributes())
+			{
+				uint8_t* dst = base + attribute.Offset;
+
+				glm::vec4 value(0.0f);
+				switch (attribute.Semantic)
+				{
+				case VertexSemantic::Position:
+					value = glm::vec4((vertex.Position - dequantization.Offset) * inverseScale, 0.0f);
+					break;
+				case VertexSemantic::Normal:
+					value = glm::vec4(vertex.Normal, 0.0f);
+					break;
+				case VertexSemantic::TexCoord0:
+					value = glm::vec4(vertex.TexCoords, 0.0f, 0.0f);
+					break;
+				case VertexSemantic::Tangent:
+					break;
+				}
+
+				switch (attribute.Format)
+				{
+				case VertexFormat::Float2:
+					std::memcpy(dst, &value.x, sizeof(float) * 2);
+					break;
+				case VertexFormat::Float3:
+					std::memcpy(dst, &value.x, sizeof(float) * 3);
+					break;
+				case VertexFormat::Float4:
+					std::memcpy(dst, &value.x, sizeof(float) * 4);
+					break;
+				case VertexFormat::Half2:
+				case VertexFormat::Half4:
+				{
+					uint16_t packed[4] = { FloatToHalf(value.x), FloatToHalf(value.y), FloatToHalf(value.z), 0 };
+					std::memcpy(dst, packed, attribute.Format == VertexFormat::Half2 ? 4 : 8);
+					break;
+				}
+				case VertexFormat::UNorm16x4:
+				{
+					uint16_t packed[4] = { ToUNorm16(value.x), ToUNorm16(value.y), ToUNorm16(value.z), 0 };
+					std::memcpy(dst, packed, sizeof(packed));
+					break;
+				}
+				case VertexFormat::SNorm16x2:
+				{
+					glm::vec2 oct = OctEncode(glm::vec3(value));
+					int16_t packed[2] = { ToSNorm16(oct.x), ToSNorm16(oct.y) };
+					std::memcpy(dst, packed, sizeof(packed));
+					break;
+				}
+				}
+			}
+		}
+	}
+}
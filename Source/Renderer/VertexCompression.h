@@ -0,0 +1,48 @@
+#pragma once
+
+#ifndef VERTEX_COMPRESSION_H
+#define VERTEX_COMPRESSION_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "Vertex.h"
+#include "VertexLayout.h"
+#include "../Math/Bounds.h"
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	// Reconstructs object-space positions in the vertex shader: position = stored * Scale + Offset.
+	struct VertexDequantization
+	{
+		glm::vec3 Scale = glm::vec3(1.0f);
+		glm::vec3 Offset = glm::vec3(0.0f);
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	class ORCA_API VertexCompression
+	{
+	public:
+		static uint16_t FloatToHalf(float value);
+		static float HalfToFloat(uint16_t value);
+
+		static int16_t ToSNorm16(float value);
+		static uint16_t ToUNorm16(float value);
+
+		// Maps a unit vector onto the [-1, 1]^2 octahedron.
+		static glm::vec2 OctEncode(const glm::vec3& n);
+		static glm::vec3 OctDecode(const glm::vec2& e);
+
+		static VertexDequantization ComputeDequantization(const Bounds& bounds, const VertexLayout& layout);
+
+		// Packs vertices into layout.GetStride() * vertices.size() bytes.
+		static void Encode(const std::vector<Vertex>& vertices, const VertexLayout& layout,
+			const VertexDequantization& dequantization, std::vector<uint8_t>& out);
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -0,0 +1,149 @@
+#include "VertexLayout.h"
+#include <GL/glew.h>
+
+namespace Orca
+{
+	VertexLayout& VertexLayout::Add(VertexSemantic semantic, VertexFormat format)
+	{
+		m_Attributes.push_back({ semantic, format, m_Stride });
+		m_Stride += GetFormatSize(format);
+		return *this;
+	}
+
+	const VertexAttributeDesc* VertexLayout::Find(VertexSemantic semantic) const
+	{
+		for (const auto& attribute : m_Attributes)
+		{
+			if (attribute.Semantic == semantic)
+			{
+				return &attribute;
+			}
+		}
+
+		return nullptr;
+	}
+
+	uint64_t VertexLayout::GetHash() const
+	{
+		// FNV-1a over (semantic, format) pairs; offsets follow from the order.
+		uint64_t hash = 14695981039346656037ull;
+		for (const auto& attribute : m_Attributes)
+		{
+			hash ^= static_cast<uint64_t>(attribute.Semantic);
+			hash *= 1099511628211ull;
+			hash ^= static_cast<uint64_t>(attribute.Format);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	bool VertexLayout::UsesOctahedralNormals() const
+	{
+		const VertexAttributeDesc* normal = Find(VertexSemantic::Normal);
+		return normal && normal->Format == VertexFormat::SNorm16x2;
+	}
+
+	void VertexLayout::Apply(uint32_t baseOffset) const
+	{
+		for (const auto& attribute : m_Attributes)
+		{
+			GLuint location = static_cast<GLuint>(attribute.Semantic);
+			const void* offset = reinterpret_cast<const void*>(static_cast<uintptr_t>(baseOffset + attribute.Offset));
+
+			glEnableVertexAttribArray(location);
+
+			switch (attribute.Format)
+			{
+			case VertexFormat::Float2:
+				glVertexAttribPointer(location, 2, GL_FLOAT, GL_FALSE, m_Stride, offset);
+				break;
+			case VertexFormat::Float3:
+				glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, m_Stride, offset);
+				break;
+			case VertexFormat::Float4:
+				glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, m_Stride, offset);
+				break;
+			case VertexFormat::Half2:
+				glVertexAttribPointer(location, 2, GL_HALF_FLOAT, GL_FALSE, m_Stride, offset);
+				break;
+			case VertexFormat::Half4:
+				glVertexAttribPointer(location, 3, GL_HALF_FLOAT, GL_FALSE, m_Stride, offset);
+				break;
+			case VertexFormat::UNorm16x4:
+				glVertexAttribPointer(location, 3, GL_UNSIGNED_SHORT, GL_TRUE, m_Stride, offset);
+				break;
+			case VertexFormat::SNorm16x2:
+				glVertexAttribPointer(location, 2, GL_SHORT, GL_TRUE, m_Stride, offset);
+				break;
+			}
+		}
+	}
+
+	VertexLayout VertexLayout::Standard()
+	{
+		VertexLayout layout;
+		layout.Add(VertexSemantic::Position, VertexFormat::Float3)
+			.Add(VertexSemantic::Normal, VertexFormat::Float3)
+			.Add(VertexSemantic::TexCoord0, VertexFormat::Float2);
+		return layout;
+	}
+
+	VertexLayout VertexLayout::FromCompression(const VertexCompressionSettings& settings)
+	{
+		VertexLayout layout;
+
+		switch (settings.Positions)
+		{
+		case PositionEncoding::Float:
+			layout.Add(VertexSemantic::Position, VertexFormat::Float3);
+			break;
+		case PositionEncoding::Half:
+			layout.Add(VertexSemantic::Position, VertexFormat::Half4);
+			break;
+		case PositionEncoding::UNorm16:
+			layout.Add(VertexSemantic::Position, VertexFormat::UNorm16x4);
+			break;
+		}
+
+		layout.Add(VertexSemantic::Normal, settings.OctahedralNormals ? VertexFormat::SNorm16x2 : VertexFormat::Float3);
+		layout.Add(VertexSemantic::TexCoord0, settings.HalfTexCoords ? VertexFormat::Half2 : VertexFormat::Float2);
+
+		return layout;
+	}
+
+	uint32_t VertexLayout::GetFormatSize(VertexFormat format)
+	{
+		switch (format)
+		{
+		case VertexFormat::Float2:    return 8;
+		case VertexFormat::Float3:    return 12;
+		case VertexFormat::Float4:    return 16;
+		case VertexFormat::Half2:     return 4;
+		case VertexFormat::Half4:     return 8;
+		case VertexFormat::UNorm16x4: return 8;
+		case VertexFormat::SNorm16x2: return 4;
+		}
+
+		return 0;
+	}
+
+	bool VertexLayout::operator==(const VertexLayout& other) const
+	{
+		if (m_Stride != other.m_Stride || m_Attributes.size() != other.m_Attributes.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < m_Attributes.size(); ++i)
+		{
+			if (m_Attributes[i].Semantic != other.m_Attributes[i].Semantic ||
+				m_Attributes[i].Format != other.m_Attributes[i].Format)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifndef VERTEX_LAYOUT_H
+#define VERTEX_LAYOUT_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "../OrcaAPI.h"
+
+namespace Orca
+{
+	// The semantic doubles as the shader attribute location.
+	enum class VertexSemantic : uint8_t
+	{
+		Position = 0,
+		Normal = 1,
+		TexCoord0 = 2,
+		Tangent = 3
+	};
+
+	enum class VertexFormat : uint8_t
+	{
+		Float2,
+		Float3,
+		Float4,
+		Half2,
+		Half4,		// Half3 padded to 8 bytes for alignment
+		UNorm16x4,	// UNorm16x3 padded to 8 bytes
+		SNorm16x2	// Octahedral-encoded unit vector
+	};
+
+	enum class PositionEncoding : uint8_t
+	{
+		Float,
+		Half,	 // Relative to the bounds center
+		UNorm16	 // Normalized to the bounds
+	};
+
+	struct VertexCompressionSettings
+	{
+		PositionEncoding Positions = PositionEncoding::Float;
+		bool OctahedralNormals = false;
+		bool HalfTexCoords = false;
+
+		static VertexCompressionSettings None() { return {}; }
+		static VertexCompressionSettings Compact() { return { PositionEncoding::UNorm16, true, true }; }
+	};
+
+	struct VertexAttributeDesc
+	{
+		VertexSemantic Semantic;
+		VertexFormat Format;
+		uint32_t Offset;
+	};
+
+#pragma warning(push)
+#pragma warning(disable: 4251)
+
+	class ORCA_API VertexLayout
+	{
+	public:
+		VertexLayout() = default;
+
+		VertexLayout& Add(VertexSemantic semantic, VertexFormat format);
+
+		const std::vector<VertexAttributeDesc>& GetAttributes() const { return m_Attributes; }
+		const VertexAttributeDesc* Find(VertexSemantic semantic) const;
+		uint32_t GetStride() const { return m_Stride; }
+		uint64_t GetHash() const;
+
+		bool UsesOctahedralNormals() const;
+
+		// Enables and describes every attribute for the currently bound VAO/VBO.
+		void Apply(uint32_t baseOffset = 0) const;
+
+		// Layout matching the uncompressed ::Vertex struct.
+		static VertexLayout Standard();
+		static VertexLayout FromCompression(const VertexCompressionSettings& settings);
+
+		static uint32_t GetFormatSize(VertexFormat format);
+
+		bool operator==(const VertexLayout& other) const;
+		bool operator!=(const VertexLayout& other) const { return !(*this == other); }
+
+	private:
+		std::vector<VertexAttributeDesc> m_Attributes;
+		uint32_t m_Stride = 0;
+	};
+#pragma warning(pop)
+}
+
+#endif
@@ -7,19 +7,65 @@
 #include "../Core/Logger.h"
 #include <filesystem>
 #include "../Renderer/ShaderRegistry.h"
+#include "../Renderer/ProgramBinaryCache.h"
+#include "../Renderer/ShaderTranspileCache.h"
+#include "../Renderer/TextureStreamer.h"
+#include "../Asset/ResourceCache.h"
 #include "../Scene/CameraComponent.h"
+#include "../Scene/LightComponent.h"
+#include "../Core/JobSystem.h"
+#include "../Math/Frustum.h"
+#include "../Renderer/GeometryArena.h"
+#include "../Renderer/DebugDraw.h"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include <algorithm>
 
 namespace fs = std::filesystem;
 
 namespace Orca
 {
-    void RenderSystem::Initialize()
+    namespace
+    {
+        // Below this many drawables per job, the dispatch overhead outweighs the recording work.
+        constexpr size_t k_MinDrawablesPerJob = 64;
+
+        // Render() draws meshes from their arena allocation; Record() only needs the index data.
+        bool CanRecord(const Mesh& mesh, bool gpuResources)
+        {
+            return gpuResources ? mesh.IsRenderable() : mesh.GetIndexCount() > 0;
+        }
+
+        constexpr const char* k_DefaultShaderDirectory = "C:\\Users\\Administrator\\OneDrive\\Documents\\Projects\\Orca\\Source\\Runtime\\Shaders";
+
+        // Generated output stays out of the shader sources, next to the transpiler's other files.
+        constexpr const char* k_ProgramCacheDirectory = "Saved/ShaderCache/Programs";
+        constexpr const char* k_TranspileCacheDirectory = "Saved/ShaderCache/Transpiled";
+    }
+
+    std::vector<CommandList> RenderSystem::s_JobCommandLists;
+    CommandList RenderSystem::s_MergedCommandList;
+    GLCommandExecutor RenderSystem::s_Executor;
+    CommandExecutor* RenderSystem::s_SceneExecutor = &RenderSystem::s_Executor;
+    OcclusionCuller RenderSystem::s_OcclusionCuller;
+    ClusteredLighting RenderSystem::s_Lighting;
+    std::vector<ClusterLight> RenderSystem::s_Lights;
+    std::vector<DirectionalLight> RenderSystem::s_DirectionalLights;
+    ShadowRenderer RenderSystem::s_Shadows;
+    std::vector<ShadowCaster> RenderSystem::s_ShadowCasters;
+    std::vector<ShadowLight> RenderSystem::s_ShadowLights;
+    std::vector<size_t> RenderSystem::s_ShadowLightIndices;
+    FrameGraph RenderSystem::s_FrameGraph;
+    DynamicResolution RenderSystem::s_DynamicResolution;
+    Quad RenderSystem::s_FullscreenQuad;
+    unsigned int RenderSystem::s_TargetFramebuffer = 0;
+    glm::uvec2 RenderSystem::s_TargetSize(0);
+
+    void RenderSystem::Initialize(const std::string& shaderDirectory)
     {
         try
         {
-            const std::string shaderDir = "C:\\Users\\Administrator\\OneDrive\\Documents\\Projects\\Orca\\Source\\Runtime\\Shaders";
+            const std::string shaderDir = shaderDirectory.empty() ? k_DefaultShaderDirectory : shaderDirectory;
 
             if (!fs::exists(shaderDir))
             {
@@ -27,6 +73,11 @@ namespace Orca
                 return;
             }
 
+            // Linked programs and transpiled sources are cached on disk so later launches skip that work.
+            ProgramBinaryCache::Initialize(k_ProgramCacheDirectory);
+            ShaderTranspileCache::Initialize(k_TranspileCacheDirectory);
+            TextureStreamer::Initialize();
+
             std::unordered_map<std::string, std::string> vertShaders;
             std::unordered_map<std::string, std::string> fragShaders;
 
@@ -42,19 +93,22 @@ namespace Orca
                 else if (ext == ".frag") fragShaders[name] = path;
             }
 
+            std::vector<ShaderRequest> requests;
             for (const auto& [name, vertPath] : vertShaders)
             {
                 if (fragShaders.find(name) != fragShaders.end())
                 {
-                    const std::string& fragPath = fragShaders.at(name);
-                    ShaderRegistry::Preload(name, vertPath, fragPath);
-                    Logger::Log(LogLevel::Info, "Shader loaded: " + name);
+                    requests.push_back({ name, vertPath, fragShaders.at(name) });
+                    Logger::Log(LogLevel::Info, "Shader queued: " + name);
                 }
                 else
                 {
                     Logger::Log(LogLevel::Warning, "Missing fragment shader for: " + name);
                 }
             }
+
+            // Programs finish compiling over the next frames; see ShaderRegistry::Update.
+            ShaderRegistry::PreloadAsync(requests);
         }
         catch (const fs::filesystem_error& e)
         {
@@ -70,13 +124,15 @@ namespace Orca
 
     void RenderSystem::Render(RuntimeContext& ctx)
     {
-        Logger::Log(LogLevel::Info, "RenderSystem::Render: Entry: Starting frame draw sequence...");
-
         try
         {
-            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            Logger::Log(LogLevel::Info, "RenderSystem::Render: OpenGL buffers cleared. Starting scene access...");
+            ShaderRegistry::Update();
+
+            // Nothing from last frame is still in use here, so unreferenced resources can go.
+            ResourceCache::Collect();
+
+            // Applies the mip requests recorded last frame.
+            TextureStreamer::Update();
 
             std::shared_ptr<Scene> activeScene = ctx.GetActiveSceneShared();
 
@@ -86,102 +142,194 @@ namespace Orca
                 return;
             }
 
-            std::string sceneAddress = std::to_string(reinterpret_cast<std::uintptr_t>(activeScene.get()));
-            Logger::Log(LogLevel::Info, "RenderSystem::Render invoked. Scene address: " + sceneAddress);
-
-            glm::mat4 viewProjectionMatrix(1.0f);
+            // The scene renders at a scale of the window picked from recent GPU frame times and
+            // is upscaled at the end; at full scale it renders straight into the window.
+            glm::uvec2 outputSize = s_TargetSize;
+            if (outputSize.x == 0 || outputSize.y == 0)
+            {
+                GLint viewport[4] = { 0, 0, 1, 1 };
+                glGetIntegerv(GL_VIEWPORT, viewport);
+                outputSize = glm::uvec2(static_cast<uint32_t>(viewport[2]), static_cast<uint32_t>(viewport[3]));
+            }
 
-            auto cameras = activeScene->GetEntitiesWith<CameraComponent, TransformComponent>();
+            s_DynamicResolution.Update();
+            const glm::uvec2 renderSize = s_DynamicResolution.GetRenderSize(outputSize.x, outputSize.y);
+            const bool scaled = renderSize != outputSize;
 
-            if (!cameras.empty())
+#ifdef ORCA_EDITOR
+            // Components draw their gizmos through DebugDraw; they show up in this frame's DebugDraw pass.
+            for (auto& entity : activeScene->GetEntities())
             {
-                Entity* cameraEntity = cameras.front();
-                CameraComponent* camera = cameraEntity->GetComponent<CameraComponent>();
-                TransformComponent* cameraTransform = cameraEntity->GetComponent<TransformComponent>();
-
-                if (camera && cameraTransform)
-                {
-                    viewProjectionMatrix = camera->GetViewMatrix();
-                    Logger::Log(LogLevel::Info, "Successfully calculated ViewProjection matrix from primary camera.");
-                }
-                else
-                {
-                    Logger::Log(LogLevel::Warning, "Camera components were present but invalid.");
-                }
+                entity->Render();
             }
-            else
+#endif
+
+            FrameSetup setup;
+            BuildFrame(*activeScene, renderSize, true, setup);
+
+            FrameConstants& frame = setup.Frame;
+            const glm::mat4& view = setup.View;
+            const glm::mat4& projection = setup.Projection;
+            const float nearPlane = setup.NearPlane;
+            const float farPlane = setup.FarPlane;
+
+            // GPU work goes through the frame graph. The shadow maps and light lists live across
+            // frames, so they are imported rather than transient.
+            s_FrameGraph.Reset();
+
+            const FrameGraphResource backbuffer = s_FrameGraph.ImportRenderTarget("Backbuffer", s_TargetFramebuffer, { outputSize.x, outputSize.y, RenderTargetFormat::RGBA8 });
+            FrameGraphResource sceneColor = backbuffer;
+            FrameGraphResource sceneDepth;
+            if (scaled)
             {
-                Logger::Log(LogLevel::Error, "No active CameraComponent found. ViewProjection matrix is Identity.");
+                sceneColor = s_FrameGraph.CreateTexture("SceneColor", { renderSize.x, renderSize.y, RenderTargetFormat::RGBA8 });
+                sceneDepth = s_FrameGraph.CreateTexture("SceneDepth", { renderSize.x, renderSize.y, RenderTargetFormat::Depth24Stencil8 });
             }
+            const FrameGraphResource shadowMaps = s_FrameGraph.ImportTexture("ShadowMaps", 0, {});
+            const FrameGraphResource lightLists = s_FrameGraph.ImportBuffer("LightLists", 0, {});
+
+            // Bound even when the pass below is skipped, so lit programs always find their shadow
+            // samplers on their own units.
+            frame.Shadows = &s_Shadows;
 
-            for (auto& entity : activeScene->GetEntitiesWith<MeshComponent, TransformComponent>())
+            // Shadow maps go first so the lights can point at the views that were actually rendered.
+            // A shader directory without a Shadow program just renders unshadowed.
+            Shader* depthShader = ShaderRegistry::Find("Shadow");
+            if (depthShader && depthShader->IsValid())
             {
-                MeshComponent* mesh = entity->GetComponent<MeshComponent>();
-                TransformComponent* transform = entity->GetComponent<TransformComponent>();
+                s_FrameGraph.AddPass("Shadows",
+                    [&](FrameGraphBuilder& builder) { builder.Write(shadowMaps); },
+                    [&](const FrameGraphContext&)
+                    {
+                        const DirectionalLight* directional = s_DirectionalLights.empty() ? nullptr : &s_DirectionalLights.front();
+                        s_Shadows.Render(s_ShadowCasters, directional, s_ShadowLights, view, projection, nearPlane, farPlane, *depthShader);
 
-                if (!mesh || !transform)
-                {
-                    Logger::Log(LogLevel::Warning, "Missing componentsskipping entity: " + entity->GetName());
-                    continue;
-                }
+                        for (size_t i = 0; i < s_ShadowLights.size(); ++i)
+                        {
+                            s_Lights[s_ShadowLightIndices[i]].ShadowIndex = s_Shadows.GetShadowIndex(s_ShadowLights[i].Id);
+                        }
+                    });
+            }
 
-                Material* material = mesh->GetMaterial().get();
-                if (!material)
+            // Light binning fans out over the job system.
+            s_FrameGraph.AddPass("Lighting",
+                [&](FrameGraphBuilder& builder)
                 {
-                    Logger::Log(LogLevel::Warning, "Material is nullskipping entity: " + entity->GetName());
-                    continue;
-                }
-
-                Mesh* meshAsset = mesh->GetMesh().get();
-                if (!meshAsset || !meshAsset->IsRenderable())
+                    builder.Read(shadowMaps);
+                    builder.Write(lightLists);
+                },
+                [&](const FrameGraphContext&)
                 {
-                    Logger::Log(LogLevel::Warning, "Mesh asset is not renderableskipping entity: " + entity->GetName());
-                    continue;
-                }
+                    s_Lighting.Build(s_Lights, s_DirectionalLights, view, projection, nearPlane, farPlane);
+                    s_Lighting.Upload();
+                    frame.Lighting = &s_Lighting;
+                });
 
-                if (mesh && transform)
+            s_FrameGraph.AddPass("Clear",
+                [&](FrameGraphBuilder& builder)
                 {
-                    Shader& shader = material->GetShader();
-                    if (!shader.IsValid())
+                    builder.Write(sceneColor);
+                    if (scaled)
                     {
-                        Logger::Log(LogLevel::Warning, "Shader is invalidskipping draw for entity: " + entity->GetName());
-                        continue;
+                        builder.Write(sceneDepth);
                     }
+                },
+                [&](const FrameGraphContext& context)
+                {
+                    context.BindRenderTarget({ sceneColor }, sceneDepth);
+                    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+                    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                });
 
-                    try
+            s_FrameGraph.AddPass("Scene",
+                [&](FrameGraphBuilder& builder)
+                {
+                    builder.Read(shadowMaps);
+                    builder.Read(lightLists);
+                    builder.Read(sceneColor);
+                    builder.Write(sceneColor);
+                    if (scaled)
                     {
-                        Logger::Log(LogLevel::Info, "Binding shader for entity: " + entity->GetName());
-                        shader.Bind();
-
-                        Logger::Log(LogLevel::Info, "Setting u_ViewProjection...");
-                        shader.SetMat4("u_ViewProjection", viewProjectionMatrix);
-
-                        Logger::Log(LogLevel::Info, "Setting u_Model...");
-                        shader.SetMat4("u_Model", transform->GetMatrix());
+                        builder.Read(sceneDepth);
+                        builder.Write(sceneDepth);
                     }
-                    catch (const std::exception& e)
+                },
+                [&](const FrameGraphContext& context)
+                {
+                    context.BindRenderTarget({ sceneColor }, sceneDepth);
+                    s_SceneExecutor->Execute(s_MergedCommandList, frame);
+                });
+
+#if ORCA_DEBUG_DRAW
+            // Before the upscale, so depth-tested lines test against the scene's depth.
+            s_FrameGraph.AddPass("DebugDraw",
+                [&](FrameGraphBuilder& builder)
+                {
+                    builder.Read(sceneColor);
+                    builder.Write(sceneColor);
+                    if (scaled)
                     {
-                        Logger::Log(LogLevel::Fatal, "Shader binding or uniform upload failed: " + std::string(e.what()));
-                        throw;
+                        builder.Read(sceneDepth);
                     }
-                    try
+                },
+                [&](const FrameGraphContext& context)
+                {
+                    context.BindRenderTarget({ sceneColor }, sceneDepth);
+                    DebugDraw::Render(view, projection, frame.ViewportSize, ctx.GetDeltaTime());
+                });
+#endif
+
+            if (scaled)
+            {
+                s_FrameGraph.AddPass("Upscale",
+                    [&](FrameGraphBuilder& builder)
                     {
-                        Logger::Log(LogLevel::Info, "Drawing mesh...");
-                        meshAsset->Draw();
-                        shader.Unbind();
-                    }
-                    catch (const std::exception& e)
+                        builder.Read(sceneColor);
+                        builder.Write(backbuffer);
+                    },
+                    [&](const FrameGraphContext& context)
                     {
-                        Logger::Log(LogLevel::Fatal, "Mesh draw failed: " + std::string(e.what()));
-                        throw;
-                    }
+                        Shader* upscale = ShaderRegistry::Find("Upscale");
+                        if (!upscale || !upscale->IsValid())
+                        {
+                            // Until the shader is ready, a plain bilinear blit does.
+                            context.BindRenderTarget({ sceneColor });
+                            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, s_TargetFramebuffer);
+                            glBlitFramebuffer(0, 0, static_cast<GLint>(renderSize.x), static_cast<GLint>(renderSize.y),
+                                0, 0, static_cast<GLint>(outputSize.x), static_cast<GLint>(outputSize.y), GL_COLOR_BUFFER_BIT, GL_LINEAR);
+                            glViewport(0, 0, static_cast<GLsizei>(outputSize.x), static_cast<GLsizei>(outputSize.y));
+                            return;
+                        }
 
-                    GLenum err = glGetError();
-                    if (err != GL_NO_ERROR)
-                    {
-                        Logger::Log(LogLevel::Error, "OpenGL error after draw: " + std::to_string(err));
-                    }
-                }
+                        if (!s_FullscreenQuad.IsInitialized())
+                        {
+                            s_FullscreenQuad.Init();
+                        }
+
+                        context.BindRenderTarget({ backbuffer });
+                        glDisable(GL_DEPTH_TEST);
+
+                        upscale->Bind();
+                        glActiveTexture(GL_TEXTURE0);
+                        glBindTexture(GL_TEXTURE_2D, context.GetTexture(sceneColor));
+                        upscale->SetInt("u_Source", 0);
+                        upscale->SetVec2("u_SourceTexelSize", 1.0f / glm::vec2(renderSize));
+                        upscale->SetFloat("u_Sharpness", s_DynamicResolution.GetSettings().Sharpness);
+                        s_FullscreenQuad.Render();
+                        upscale->Unbind();
+
+                        glEnable(GL_DEPTH_TEST);
+                    });
+            }
+
+            s_DynamicResolution.BeginFrame();
+            s_FrameGraph.Execute();
+            s_DynamicResolution.EndFrame();
+
+            GLenum err = glGetError();
+            if (err != GL_NO_ERROR)
+            {
+                Logger::Log(LogLevel::Error, "OpenGL error after scene submission: " + std::to_string(err));
             }
         }
         catch (const std::runtime_error& e)
@@ -195,8 +343,361 @@ namespace Orca
         }
     }
 
+    void RenderSystem::BuildFrame(Scene& scene, const glm::uvec2& renderSize, bool gpuResources, FrameSetup& out)
+    {
+        out = {};
+        out.Frame.ViewportSize = glm::vec2(renderSize);
+        float projectionScale = 1.0f;
+
+        auto cameras = scene.GetEntitiesWith<CameraComponent, TransformComponent>();
+
+        if (!cameras.empty())
+        {
+            Entity* cameraEntity = cameras.front();
+            CameraComponent* camera = cameraEntity->GetComponent<CameraComponent>();
+            TransformComponent* cameraTransform = cameraEntity->GetComponent<TransformComponent>();
+
+            if (camera && cameraTransform)
+            {
+                out.View = camera->GetViewMatrix();
+                out.Projection = camera->GetProjectionMatrix();
+                const Vector3& position = cameraTransform->GetPosition();
+
+                out.Frame.ViewProjection = out.Projection * out.View;
+                out.Frame.CameraPosition = glm::vec3(position.x, position.y, position.z);
+                out.NearPlane = camera->GetNearPlane();
+                out.FarPlane = camera->GetFarPlane();
+                projectionScale = out.Projection[1][1];
+            }
+            else
+            {
+                Logger::Log(LogLevel::Warning, "Camera components were present but invalid.");
+            }
+        }
+        else
+        {
+            Logger::Log(LogLevel::Error, "No active CameraComponent found. ViewProjection matrix is Identity.");
+        }
+
+        Frustum frustum(out.Frame.ViewProjection);
+        std::vector<Entity*> drawables = scene.GetEntitiesWith<MeshComponent, TransformComponent>();
+
+        GatherLights(scene.GetEntitiesWith<LightComponent, TransformComponent>(), out.Frame.CameraPosition);
+        GatherShadowCasters(drawables);
+
+        // Occluder rasterization is CPU only and has to finish before recording culls against it.
+        RasterizeOccluders(drawables, frustum, out.Frame.ViewProjection);
+        const OcclusionCuller* occlusion = s_OcclusionCuller.HasOccluders() ? &s_OcclusionCuller : nullptr;
+
+        // Culling, sort-key building and constant packing are recorded in parallel,
+        // one command list per job. Only the merged list touches GL.
+        ViewInfo viewInfo{ &frustum, out.Frame.CameraPosition, out.FarPlane, projectionScale, out.Frame.ViewportSize.y, occlusion, gpuResources };
+
+        size_t maxJobs = static_cast<size_t>(JobSystem::GetWorkerCount()) + 1;
+        if (s_JobCommandLists.size() < maxJobs)
+        {
+            s_JobCommandLists.resize(maxJobs);
+        }
+
+        for (auto& list : s_JobCommandLists)
+        {
+            list.Reset();
+        }
+
+        JobSystem::ParallelFor(drawables.size(), k_MinDrawablesPerJob, [&](unsigned int jobIndex, size_t begin, size_t end)
+            {
+                CommandList& list = s_JobCommandLists[jobIndex];
+                RecordDrawables(drawables, begin, end, viewInfo, list);
+                list.Sort();
+            });
+
+        CommandList::Merge(s_JobCommandLists, s_MergedCommandList);
+    }
+
+    void RenderSystem::Record(RuntimeContext& ctx, CommandExecutor& executor, uint32_t width, uint32_t height)
+    {
+        std::shared_ptr<Scene> activeScene = ctx.GetActiveSceneShared();
+        if (!activeScene)
+        {
+            Logger::Log(LogLevel::Error, "RenderSystem::Record failed: no active scene.");
+            return;
+        }
+
+        FrameSetup setup;
+        BuildFrame(*activeScene, glm::uvec2(std::max(width, 1u), std::max(height, 1u)), false, setup);
+
+        // Light binning is CPU work too; uploading it is not, but the executor counts what would be.
+        s_Lighting.Build(s_Lights, s_DirectionalLights, setup.View, setup.Projection, setup.NearPlane, setup.FarPlane);
+        setup.Frame.Lighting = &s_Lighting;
+        executor.Execute(s_MergedCommandList, setup.Frame);
+    }
+
+    void RenderSystem::GatherLights(const std::vector<Entity*>& entities, const glm::vec3& cameraPosition)
+    {
+        s_Lights.clear();
+        s_DirectionalLights.clear();
+        s_ShadowLights.clear();
+        s_ShadowLightIndices.clear();
+
+        for (Entity* entity : entities)
+        {
+            LightComponent* light = entity->GetComponent<LightComponent>();
+            TransformComponent* transform = entity->GetComponent<TransformComponent>();
+
+            if (!light || !transform || light->Intensity <= 0.0f)
+            {
+                continue;
+            }
+
+            const Vector3& position = transform->GetPosition();
+            Vector3 forward = transform->GetRotation() * Vector3(0.0f, 0.0f, -1.0f);
+            glm::vec3 color = glm::vec3(light->Color.x, light->Color.y, light->Color.z) * light->Intensity;
+
+            if (light->Type == LightType::Directional)
+            {
+                s_DirectionalLights.push_back({ glm::vec3(forward.x, forward.y, forward.z), color });
+                continue;
+            }
+
+            ClusterLight clusterLight;
+            clusterLight.Position = glm::vec3(position.x, position.y, position.z);
+            clusterLight.Range = light->Range;
+            clusterLight.Color = color;
+            clusterLight.Type = light->Type == LightType::Spot ? ClusterLightType::Spot : ClusterLightType::Point;
+            clusterLight.Direction = glm::vec3(forward.x, forward.y, forward.z);
+            clusterLight.SpotAngle = light->SpotAngle;
+
+            if (light->CastShadows)
+            {
+                // Bright, large lights near the camera get atlas space and update budget first.
+                ShadowLight shadowLight;
+                shadowLight.Id = light;
+                shadowLight.Type = clusterLight.Type;
+                shadowLight.Position = clusterLight.Position;
+                shadowLight.Direction = clusterLight.Direction;
+                shadowLight.Range = clusterLight.Range;
+                shadowLight.SpotAngle = clusterLight.SpotAngle;
+                shadowLight.Importance = light->Intensity * light->Range / (1.0f + glm::length(clusterLight.Position - cameraPosition));
+                s_ShadowLights.push_back(shadowLight);
+                s_ShadowLightIndices.push_back(s_Lights.size());
+            }
+
+            s_Lights.push_back(clusterLight);
+        }
+    }
+
+    void RenderSystem::GatherShadowCasters(const std::vector<Entity*>& entities)
+    {
+        s_ShadowCasters.clear();
+
+        for (Entity* entity : entities)
+        {
+            MeshComponent* mesh = entity->GetComponent<MeshComponent>();
+            TransformComponent* transform = entity->GetComponent<TransformComponent>();
+
+            if (!mesh || !transform || !mesh->CastsShadows() || !mesh->GetMesh() || !mesh->GetMesh()->IsRenderable())
+            {
+                continue;
+            }
+
+            ShadowCaster caster;
+            caster.Geometry = mesh->GetMesh().get();
+            caster.Model = transform->GetMatrix();
+            caster.LocalBounds = mesh->GetBounds();
+            caster.Static = mesh->IsStatic();
+            s_ShadowCasters.push_back(caster);
+        }
+    }
+
+    void RenderSystem::RasterizeOccluders(const std::vector<Entity*>& entities, const Frustum& frustum, const glm::mat4& viewProjection)
+    {
+        s_OcclusionCuller.BeginFrame(viewProjection);
+
+        for (Entity* entity : entities)
+        {
+            MeshComponent* mesh = entity->GetComponent<MeshComponent>();
+            TransformComponent* transform = entity->GetComponent<TransformComponent>();
+
+            if (!mesh || !transform || !mesh->IsOccluder() || !mesh->GetMesh())
+            {
+                continue;
+            }
+
+            glm::mat4 model = transform->GetMatrix();
+            if (frustum.Intersects(mesh->GetBounds(), model))
+            {
+                s_OcclusionCuller.AddOccluder(*mesh->GetMesh(), model);
+            }
+        }
+
+        s_OcclusionCuller.Rasterize();
+    }
+
+    void RenderSystem::RecordDrawables(const std::vector<Entity*>& entities, size_t begin, size_t end, const ViewInfo& view, CommandList& out)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            Entity* entity = entities[i];
+            MeshComponent* mesh = entity->GetComponent<MeshComponent>();
+            TransformComponent* transform = entity->GetComponent<TransformComponent>();
+
+            if (!mesh || !transform)
+            {
+                Logger::Log(LogLevel::Warning, "Missing components, skipping entity: " + entity->GetName());
+                continue;
+            }
+
+            Material* material = mesh->GetMaterial().get();
+            if (!material)
+            {
+                Logger::Log(LogLevel::Warning, "Material is null, skipping entity: " + entity->GetName());
+                continue;
+            }
+
+            const Mesh* meshAsset = mesh->GetMesh().get();
+            if (!meshAsset || !CanRecord(*meshAsset, view.GpuResources))
+            {
+                Logger::Log(LogLevel::Warning, "Mesh asset is not renderable, skipping entity: " + entity->GetName());
+                continue;
+            }
+
+            // The component caches the bounds on the main thread; Mesh::GetBounds() computes
+            // lazily and must not race between jobs that share a mesh.
+            const Bounds& bounds = mesh->GetBounds();
+            glm::mat4 model = transform->GetMatrix();
+            if (!view.ViewFrustum->Intersects(bounds, model))
+            {
+                continue;
+            }
+
+            // Occluders would only ever test against their own depth, so they skip the query.
+            if (view.Occlusion && !mesh->IsOccluder() && !view.Occlusion->IsVisible(bounds, model))
+            {
+                continue;
+            }
+
+            const uint32_t programKey = material->GetProgramKey();
+            if (programKey == 0)
+            {
+                Logger::Log(LogLevel::Warning, "Shader is not registered, skipping entity: " + entity->GetName());
+                continue;
+            }
+
+            // Only Render() binds programs; a headless recording goes by the key alone.
+            Shader* shader = nullptr;
+            if (view.GpuResources)
+            {
+                try
+                {
+                    shader = &material->GetShader();
+                }
+                catch (const std::exception& e)
+                {
+                    Logger::Log(LogLevel::Warning, std::string(e.what()) + " Skipping entity: " + entity->GetName());
+                    continue;
+                }
+
+                if (!shader->IsValid())
+                {
+                    Logger::Log(LogLevel::Warning, "Shader is invalid, skipping draw for entity: " + entity->GetName());
+                    continue;
+                }
+            }
+
+            glm::vec3 worldCenter = glm::vec3(model * glm::vec4(bounds.GetCenter(), 1.0f));
+            float distance = glm::length(worldCenter - view.CameraPosition);
+            float depth = distance / view.FarPlane;
+
+            // Projected height of the bounding sphere as a fraction of the viewport. Each entity is
+            // recorded by exactly one job, so updating the component's LOD state here does not race.
+            float maxScale = std::max({ glm::length(glm::vec3(model[0])), glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2])) });
+            float radius = 0.5f * glm::length(bounds.GetSize()) * maxScale;
+            float screenSize = distance > radius ? radius * view.ProjectionScale / distance : 1.0f;
+
+            const Mesh* lod = meshAsset->GetLod(mesh->UpdateLod(screenSize));
+            material->RequestTextures(screenSize * view.ViewportHeight);
+            if (lod && CanRecord(*lod, view.GpuResources))
+            {
+                meshAsset = lod;
+            }
+
+            DrawConstants constants;
+            constants.Model = model;
+            constants.AlbedoColor = glm::vec4(material->GetAlbedoColor(), 1.0f);
+
+            // The arena keeps one pool, and so one VAO, per vertex layout; the layout groups draws the
+            // same way without needing the allocation.
+            const uint32_t geometryKey = static_cast<uint32_t>(meshAsset->GetLayout().GetHash());
+            out.RecordDraw(RenderSortKey::Make(programKey, material->GetID(), geometryKey, depth), shader, programKey, meshAsset, material, constants);
+        }
+    }
+
+    const SubmissionStats& RenderSystem::GetSubmissionStats()
+    {
+        return s_SceneExecutor->GetStats();
+    }
+
+    OcclusionStats RenderSystem::GetOcclusionStats()
+    {
+        return s_OcclusionCuller.GetStats();
+    }
+
+    const ClusterStats& RenderSystem::GetLightingStats()
+    {
+        return s_Lighting.GetStats();
+    }
+
+    const ShadowStats& RenderSystem::GetShadowStats()
+    {
+        return s_Shadows.GetStats();
+    }
+
+    const FrameGraphStats& RenderSystem::GetFrameGraphStats()
+    {
+        return s_FrameGraph.GetStats();
+    }
+
+    const DynamicResolutionStats& RenderSystem::GetDynamicResolutionStats()
+    {
+        return s_DynamicResolution.GetStats();
+    }
+
+    void RenderSystem::SetShadowSettings(const ShadowSettings& settings)
+    {
+        s_Shadows.SetSettings(settings);
+    }
+
+    void RenderSystem::SetDynamicResolutionSettings(const DynamicResolutionSettings& settings)
+    {
+        s_DynamicResolution.SetSettings(settings);
+    }
+
+    void RenderSystem::SetCommandExecutor(CommandExecutor* executor)
+    {
+        s_SceneExecutor = executor ? executor : &s_Executor;
+    }
+
+    void RenderSystem::SetRenderTarget(unsigned int framebuffer, uint32_t width, uint32_t height)
+    {
+        s_TargetFramebuffer = framebuffer;
+        s_TargetSize = glm::uvec2(width, height);
+    }
+
     void RenderSystem::Shutdown()
     {
+        s_JobCommandLists.clear();
+        s_MergedCommandList.Reset();
+        s_Executor.Release();
+        s_Lighting.Release();
+        s_Shadows.Release();
+        s_ShadowCasters.clear();
+        s_FrameGraph.Release();
+        s_DynamicResolution.Release();
+        s_FullscreenQuad.Release();
+        DebugDraw::Shutdown();
         ShaderRegistry::Clear();
+        ResourceCache::Clear();
+        TextureStreamer::Shutdown();
+        GeometryArena::Shutdown();
     }
 }
\ No newline at end of file
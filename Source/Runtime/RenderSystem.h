@@ -3,7 +3,18 @@
 #ifndef RENDER_SYSTEM_H
 #define RENDER_SYSTEM_H
 
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
 #include "RuntimeContext.h"
+#include "../Renderer/CommandList.h"
+#include "../Renderer/GLCommandExecutor.h"
+#include "../Renderer/OcclusionCuller.h"
+#include "../Renderer/ClusteredLighting.h"
+#include "../Renderer/ShadowRenderer.h"
+#include "../Renderer/FrameGraph.h"
+#include "../Renderer/DynamicResolution.h"
+#include "../Renderer/Quad.h"
 #include "../OrcaAPI.h"
 
 namespace Orca
@@ -11,12 +22,88 @@ namespace Orca
 #pragma warning(push)
 #pragma warning(disable: 4251)
 
+	class Entity;
+	class Frustum;
+	class Scene;
+
 	class ORCA_API RenderSystem
 	{
 	public:
-		static void Initialize();
+		// Compiles every .vert/.frag pair in shaderDirectory; empty uses the engine's Shaders folder.
+		static void Initialize(const std::string& shaderDirectory = "");
 		static void Render(RuntimeContext& ctx);
+
+		// The CPU half of a frame: culls, sorts and packs the active scene for a width x height view,
+		// bins its lights and hands the merged list to executor. Touches no GL state, so with a
+		// NullCommandExecutor or RecordingCommandExecutor it runs without a graphics context. Meshes
+		// need only their index data and materials only a registered shader (see
+		// ShaderRegistry::Register); packets carry no programs, only Material::GetProgramKey().
+		static void Record(RuntimeContext& ctx, CommandExecutor& executor, uint32_t width, uint32_t height);
 		static void Shutdown();
+
+		static const SubmissionStats& GetSubmissionStats();
+		static OcclusionStats GetOcclusionStats();
+		static const ClusterStats& GetLightingStats();
+		static const ShadowStats& GetShadowStats();
+		static const FrameGraphStats& GetFrameGraphStats();
+		static const DynamicResolutionStats& GetDynamicResolutionStats();
+
+		// Takes effect next frame and drops every cached shadow map.
+		static void SetShadowSettings(const ShadowSettings& settings);
+		static void SetDynamicResolutionSettings(const DynamicResolutionSettings& settings);
+
+		// Where Render() submits the scene pass; null restores the GL executor. Not owned.
+		static void SetCommandExecutor(CommandExecutor* executor);
+
+		// Where the frame ends up. Framebuffer 0 with a zero size is the window, sized by the
+		// current viewport; anything else, e.g. an offscreen FBO, is rendered at the given size.
+		static void SetRenderTarget(unsigned int framebuffer, uint32_t width, uint32_t height);
+
+	private:
+		struct FrameSetup
+		{
+			FrameConstants Frame;
+			glm::mat4 View = glm::mat4(1.0f);
+			glm::mat4 Projection = glm::mat4(1.0f);
+			float NearPlane = 0.1f;
+			float FarPlane = 1000.0f;
+		};
+
+		struct ViewInfo
+		{
+			const Frustum* ViewFrustum;
+			glm::vec3 CameraPosition;
+			float FarPlane;
+			float ProjectionScale;	// projection[1][1], i.e. 1 / tan(fov / 2)
+			float ViewportHeight;
+			const OcclusionCuller* Occlusion;	// Null when no occluders were rasterized
+			bool GpuResources;					// Render(): draws need arena geometry and a linked program
+		};
+
+		// One command list per recording job, reused across frames.
+		static std::vector<CommandList> s_JobCommandLists;
+		static CommandList s_MergedCommandList;
+		static GLCommandExecutor s_Executor;
+		static CommandExecutor* s_SceneExecutor;
+		static OcclusionCuller s_OcclusionCuller;
+		static ClusteredLighting s_Lighting;
+		static std::vector<ClusterLight> s_Lights;
+		static std::vector<DirectionalLight> s_DirectionalLights;
+		static ShadowRenderer s_Shadows;
+		static std::vector<ShadowCaster> s_ShadowCasters;
+		static std::vector<ShadowLight> s_ShadowLights;
+		static std::vector<size_t> s_ShadowLightIndices;	// Into s_Lights, parallel to s_ShadowLights
+		static FrameGraph s_FrameGraph;
+		static DynamicResolution s_DynamicResolution;
+		static Quad s_FullscreenQuad;
+		static unsigned int s_TargetFramebuffer;
+		static glm::uvec2 s_TargetSize;			// Zero: the current viewport
+
+		static void BuildFrame(Scene& scene, const glm::uvec2& renderSize, bool gpuResources, FrameSetup& out);
+		static void GatherLights(const std::vector<Entity*>& entities, const glm::vec3& cameraPosition);
+		static void GatherShadowCasters(const std::vector<Entity*>& entities);
+		static void RasterizeOccluders(const std::vector<Entity*>& entities, const Frustum& frustum, const glm::mat4& viewProjection);
+		static void RecordDrawables(const std::vector<Entity*>& entities, size_t begin, size_t end, const ViewInfo& view, CommandList& out);
 	};
 #pragma warning(pop)
 }
@@ -0,0 +1,10 @@
+#version 330 core
+
+in vec4 v_Color;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = v_Color;
+}
\ No newline at end of file
@@ -2,17 +2,60 @@
 
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
+layout(location = 2) in vec2 a_TexCoords;
 
+// Per-draw data on the multi-draw path, selected by the indirect command's BaseInstance.
+layout(location = 4) in mat4 a_InstanceModel;
+layout(location = 8) in vec4 a_InstanceColor;
+layout(location = 9) in vec4 a_InstancePositionScale;
+layout(location = 10) in vec4 a_InstancePositionOffset;
+
+uniform int u_UseInstanceData;
 uniform mat4 u_Model;
+uniform vec3 u_AlbedoColor;
 uniform mat4 u_ViewProjection;
 
+// Vertex compression: position = stored * scale + offset, normals may be octahedral-encoded.
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
+uniform int u_OctNormals;
+
 out vec3 v_Normal;
 out vec3 v_FragPos;
+out vec2 v_TexCoords;
+flat out vec3 v_AlbedoColor;
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+    {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
 
 void main()
 {
-    v_FragPos = vec3(u_Model * vec4(a_Position, 1.0));
-    v_Normal = mat3(transpose(inverse(u_Model))) * a_Normal;
+    mat4 model = u_Model;
+    vec3 positionScale = u_PositionScale;
+    vec3 positionOffset = u_PositionOffset;
+    v_AlbedoColor = u_AlbedoColor;
+
+    if (u_UseInstanceData != 0)
+    {
+        model = a_InstanceModel;
+        positionScale = a_InstancePositionScale.xyz;
+        positionOffset = a_InstancePositionOffset.xyz;
+        v_AlbedoColor = a_InstanceColor.rgb;
+    }
+
+    vec3 position = a_Position * positionScale + positionOffset;
+    vec3 normal = u_OctNormals != 0 ? OctDecode(a_Normal.xy) : a_Normal;
+
+    v_FragPos = vec3(model * vec4(position, 1.0));
+    v_Normal = mat3(transpose(inverse(model))) * normal;
+    v_TexCoords = a_TexCoords;
 
     gl_Position = u_ViewProjection * vec4(v_FragPos, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,6 @@
+#version 330 core
+
+// Depth-only pass for shadow maps; the rasterizer writes depth.
+void main()
+{
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#version 330 core
+
+in vec3 v_TexCoord;
+in vec4 v_Color;
+
+out vec4 FragColor;
+
+// A batch samples either a plain texture or a layer of a texture array, on separate units.
+uniform sampler2D u_Texture;
+uniform sampler2DArray u_TextureArray;
+uniform int u_UseArray;
+
+void main()
+{
+    vec4 texel;
+    if (u_UseArray != 0)
+    {
+        texel = texture(u_TextureArray, v_TexCoord);
+    }
+    else
+    {
+        texel = texture(u_Texture, v_TexCoord.xy);
+    }
+
+    FragColor = texel * v_Color;
+}
\ No newline at end of file
@@ -1,11 +1,10 @@
 #version 330 core
 
 in vec2 v_TexCoord;
+flat in vec3 v_AlbedoColor;
 out vec4 FragColor;
 
-uniform vec3 u_AlbedoColor;
-
 void main()
 {
-    FragColor = vec4(u_AlbedoColor, 1.0);
+    FragColor = vec4(v_AlbedoColor, 1.0);
 }
\ No newline at end of file
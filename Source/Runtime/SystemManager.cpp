@@ -2,11 +2,13 @@
 #include "ScriptSystem.h"
 #include "PhysicsSystem.h"
 #include "RenderSystem.h"
+#include "../Core/JobSystem.h"
 
 namespace Orca 
 {
     void SystemManager::Initialize(RuntimeContext& r_Ctx) 
     {
+        JobSystem::Initialize();
         ScriptSystem::Initialize(r_Ctx);
         PhysicsSystem::Initialize();
         RenderSystem::Initialize();
@@ -28,6 +30,7 @@ namespace Orca
         RenderSystem::Shutdown();
         PhysicsSystem::Shutdown();
         ScriptSystem::Shutdown();
+        JobSystem::Shutdown();
     }
 
 }
\ No newline at end of file
@@ -67,6 +67,16 @@ namespace Orca
 		return pImpl->id != 0;
 	}
 
+	bool Entity::IsSelected() const
+	{
+		return pImpl->selected;
+	}
+
+	void Entity::SetSelected(bool selected)
+	{
+		pImpl->selected = selected;
+	}
+
 	Component* Entity::GetComponentInternal(std::type_index type)
 	{
 		auto it = pImpl->m_Components.find(type);
@@ -92,6 +92,10 @@ namespace Orca
 
 		bool IsValid() const;
 
+		// Editor selection; selected entities draw their gizmos.
+		bool IsSelected() const;
+		void SetSelected(bool selected);
+
 	private:
 		struct Impl;
 		std::unique_ptr<Impl> pImpl;
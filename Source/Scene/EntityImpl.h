@@ -17,6 +17,7 @@ namespace Orca
         std::unordered_map<std::type_index, std::shared_ptr<Component>> m_Components;
         std::string name;
         uint32_t id;
+        bool selected = false;
 
         Impl() : id(0), name("New Entity") {}
         Impl(uint32_t entityID) : id(entityID), name("Entity" + std::to_string(entityID)) {}
@@ -33,6 +33,7 @@ namespace Orca
         Vector3 Color = Vector3(1.0f);
         float Range = 10.0f;
         float SpotAngle = 45.0f;
+        bool CastShadows = true;
 
         std::string GetColorHex() const;
     };
@@ -1,5 +1,6 @@
 #include "MeshComponent.h"
 #include "../Core/Logger.h"
+#include <algorithm>
 
 namespace Orca {
 
@@ -15,6 +16,7 @@ namespace Orca {
     void MeshComponent::SetMesh(std::shared_ptr<Mesh> mesh) 
     {
         m_Mesh = mesh;
+        m_CurrentLod = 0;
         if (mesh) {
             m_Bounds = mesh->GetBounds();
         }
@@ -30,6 +32,30 @@ namespace Orca {
         return m_Bounds;
     }
 
+    uint32_t MeshComponent::UpdateLod(float screenSize)
+    {
+        if (!m_Mesh || m_Mesh->GetLodCount() <= 1)
+        {
+            m_CurrentLod = 0;
+            return m_CurrentLod;
+        }
+
+        const uint32_t lodCount = m_Mesh->GetLodCount();
+        m_CurrentLod = std::min(m_CurrentLod, lodCount - 1);
+
+        while (m_CurrentLod + 1 < lodCount && screenSize < m_Mesh->GetLodScreenSize(m_CurrentLod + 1) * (1.0f - m_LodHysteresis))
+        {
+            m_CurrentLod++;
+        }
+
+        while (m_CurrentLod > 0 && screenSize > m_Mesh->GetLodScreenSize(m_CurrentLod) * (1.0f + m_LodHysteresis))
+        {
+            m_CurrentLod--;
+        }
+
+        return m_CurrentLod;
+    }
+
     void MeshComponent::Draw() const 
     {
         if (!m_Mesh) 
@@ -31,12 +31,38 @@ namespace Orca
 
         const Bounds& GetBounds() const;
 
+        // Picks the LOD for a mesh covering screenSize of the viewport height. A level only changes
+        // once the size has moved past its threshold by the hysteresis margin, so objects hovering
+        // at a boundary do not pop back and forth every frame.
+        uint32_t UpdateLod(float screenSize);
+        uint32_t GetCurrentLod() const { return m_CurrentLod; }
+
+        // Occluders are rasterized into the CPU depth buffer each frame; large, simple walls work best.
+        void SetOccluder(bool occluder) { m_IsOccluder = occluder; }
+        bool IsOccluder() const { return m_IsOccluder; }
+
+        // Static meshes are cached in shadow maps and only redrawn there when they move.
+        void SetStatic(bool isStatic) { m_IsStatic = isStatic; }
+        bool IsStatic() const { return m_IsStatic; }
+
+        void SetCastShadows(bool castShadows) { m_CastShadows = castShadows; }
+        bool CastsShadows() const { return m_CastShadows; }
+
+        void SetLodHysteresis(float hysteresis) { m_LodHysteresis = hysteresis; }
+        float GetLodHysteresis() const { return m_LodHysteresis; }
+
         void Draw() const;
 
     private:
         std::shared_ptr<Mesh> m_Mesh;
         std::shared_ptr<Material> m_Material;
         Bounds m_Bounds;
+
+        uint32_t m_CurrentLod = 0;
+        float m_LodHysteresis = 0.1f;
+        bool m_IsOccluder = false;
+        bool m_IsStatic = false;
+        bool m_CastShadows = true;
     };
 
 }
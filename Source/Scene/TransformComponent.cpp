@@ -2,6 +2,7 @@
 #include "Entity.h"
 #include "../Math/MathUtils.h"
 #include "RigidBodyComponent.h"
+#include "../Renderer/DebugDraw.h"
 
 namespace Orca
 {
@@ -24,12 +25,13 @@ namespace Orca
 #ifdef ORCA_EDITOR
 		if (owner && owner->IsSelected())
 		{
-			DebugDraw::DrawSphere(Position, 0.1f, Color::Yellow);
+			const Vector3& position = GetPosition();
+			DebugDraw::DrawSphere(glm::vec3(position.x, position.y, position.z), 0.1f, DebugColor::Yellow);
 
-			Matrix4 model = GetMatrix();
+			glm::mat4 model = GetMatrix();
 			DebugDraw::DrawAxes(model, 0.5f);
 
-			DebugDraw::DrawBox(model, Vector3(1.0f), Color::Cyan);
+			DebugDraw::DrawBox(model, glm::vec3(1.0f), DebugColor::Cyan);
 		}
 #endif
 	}
@@ -0,0 +1,465 @@
+// OrcaHeadlessChecks: engine checks that need no window, GL context or GPU.
+//
+//   OrcaHeadlessChecks [--check <name>]... [--list] [--verbose]
+//
+// Every check drives CPU-side engine code with scripted input and compares the outcome with
+// known answers, so it runs on build machines without a graphics stack. Each failed expectation
+// is printed with its check; the exit code is 1 if any check failed.
+
+#include "Core/JobSystem.h"
+#include "Core/Logger.h"
+#include "Material/Material.h"
+#include "Math/Bounds.h"
+#include "Renderer/ClusteredLighting.h"
+#include "Renderer/Mesh.h"
+#include "Renderer/NullCommandExecutor.h"
+#include "Renderer/OcclusionCuller.h"
+#include "Renderer/RecordingCommandExecutor.h"
+#include "Renderer/ShaderRegistry.h"
+#include "Renderer/Vertex.h"
+#include "Runtime/RenderSystem.h"
+#include "Runtime/RuntimeContext.h"
+#include "Scene/CameraComponent.h"
+#include "Scene/Entity.h"
+#include "Scene/LightComponent.h"
+#include "Scene/MeshComponent.h"
+#include "Scene/Scene.h"
+#include "Scene/TransformComponent.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace Orca;
+
+namespace
+{
+	class CheckContext
+	{
+	public:
+		explicit CheckContext(const std::string& name) : m_Name(name) {}
+
+		void Expect(bool condition, const std::string& what)
+		{
+			if (!condition)
+			{
+				std::cout << "  FAILED " << m_Name << ": " << what << "\n";
+				m_Failures++;
+			}
+		}
+
+		template<typename T>
+		void ExpectEqual(const T& actual, const T& expected, const std::string& what)
+		{
+			if (!(actual == expected))
+			{
+				std::cout << "  FAILED " << m_Name << ": " << what << " is " << actual << ", expected " << expected << "\n";
+				m_Failures++;
+			}
+		}
+
+		uint32_t GetFailures() const { return m_Failures; }
+
+	private:
+		std::string m_Name;
+		uint32_t m_Failures = 0;
+	};
+
+	struct Check
+	{
+		const char* Name;
+		const char* Description;
+		std::function<void(CheckContext&)> Run;
+	};
+
+	struct Options
+	{
+		std::vector<std::string> Checks;
+		bool List = false;
+		bool Verbose = false;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: OrcaHeadlessChecks [--check <name>]... [--list] [--verbose]\n";
+	}
+
+	// A camera at the origin looking down -z, matching the culler's default 2:1 buffer.
+	glm::mat4 CullerViewProjection()
+	{
+		const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 100.0f);
+		const glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+		return projection * view;
+	}
+
+	// A 6 x 6 wall facing the camera, 5 units in front of it.
+	void AddWallOccluder(OcclusionCuller& culler)
+	{
+		const std::vector<Vertex> vertices =
+		{
+			{ glm::vec3(-3.0f, -3.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 0.0f) },
+			{ glm::vec3(3.0f, -3.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 0.0f) },
+			{ glm::vec3(3.0f, 3.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 1.0f) },
+			{ glm::vec3(-3.0f, 3.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 1.0f) }
+		};
+		const std::vector<unsigned int> indices = { 0, 1, 2, 0, 2, 3 };
+
+		culler.AddOccluder(vertices, indices, glm::mat4(1.0f));
+	}
+
+	Bounds UnitBox(const glm::vec3& center)
+	{
+		return Bounds(center - glm::vec3(0.5f), center + glm::vec3(0.5f));
+	}
+
+	void CheckOcclusionCulling(CheckContext& check)
+	{
+		OcclusionCuller culler;
+		culler.BeginFrame(CullerViewProjection());
+		AddWallOccluder(culler);
+		culler.Rasterize();
+
+		check.Expect(culler.HasOccluders(), "the wall was not kept as an occluder");
+
+		// The wall covers |x| < 6 at a depth of 10, and the view reaches |x| < 11.5 there.
+		const glm::mat4 identity(1.0f);
+		check.Expect(!culler.IsVisible(UnitBox(glm::vec3(0.0f, 0.0f, -10.0f)), identity), "a box straight behind the wall is visible");
+		check.Expect(culler.IsVisible(UnitBox(glm::vec3(8.0f, 0.0f, -10.0f)), identity), "a box beside the wall is hidden");
+		check.Expect(culler.IsVisible(UnitBox(glm::vec3(0.0f, 0.0f, -3.0f)), identity), "a box in front of the wall is hidden");
+		check.Expect(culler.IsVisible(UnitBox(glm::vec3(5.5f, 0.0f, -10.0f)), identity), "a box half behind the wall edge is hidden");
+
+		// The box sits behind the wall only once the model matrix moves it there.
+		const glm::mat4 pushedBack = glm::translate(identity, glm::vec3(0.0f, 0.0f, -20.0f));
+		check.Expect(!culler.IsVisible(UnitBox(glm::vec3(0.0f)), pushedBack), "a translated box behind the wall is visible");
+
+		const OcclusionStats stats = culler.GetStats();
+		check.ExpectEqual(stats.OccluderTriangles, 2u, "occluder triangles");
+		check.ExpectEqual(stats.TestedObjects, 5u, "tested objects");
+		check.ExpectEqual(stats.CulledObjects, 2u, "culled objects");
+	}
+
+	void CheckOcclusionNearPlane(CheckContext& check)
+	{
+		OcclusionCuller culler;
+		culler.BeginFrame(CullerViewProjection());
+		AddWallOccluder(culler);
+		culler.Rasterize();
+
+		// Straddles the near plane (0.1), so part of it is in front of everything.
+		check.Expect(culler.IsVisible(UnitBox(glm::vec3(0.0f)), glm::mat4(1.0f)), "a box straddling the near plane is hidden");
+
+		// Entirely behind the camera: not for the culler to decide, so it must stay visible.
+		check.Expect(culler.IsVisible(UnitBox(glm::vec3(0.0f, 0.0f, 5.0f)), glm::mat4(1.0f)), "a box behind the camera is hidden");
+	}
+
+	void CheckOcclusionWithoutOccluders(CheckContext& check)
+	{
+		OcclusionCuller culler;
+		culler.BeginFrame(CullerViewProjection());
+		culler.Rasterize();
+
+		check.Expect(!culler.HasOccluders(), "an empty frame reports occluders");
+		check.Expect(culler.IsVisible(UnitBox(glm::vec3(0.0f, 0.0f, -10.0f)), glm::mat4(1.0f)), "a box is hidden with nothing rasterized");
+
+		// Occluders crossing the near plane are dropped rather than clipped.
+		const std::vector<Vertex> vertices =
+		{
+			{ glm::vec3(-3.0f, -3.0f, 1.0f), glm::vec3(0.0f), glm::vec2(0.0f) },
+			{ glm::vec3(3.0f, -3.0f, -5.0f), glm::vec3(0.0f), glm::vec2(0.0f) },
+			{ glm::vec3(0.0f, 3.0f, -5.0f), glm::vec3(0.0f), glm::vec2(0.0f) }
+		};
+		culler.BeginFrame(CullerViewProjection());
+		culler.AddOccluder(vertices, { 0, 1, 2 }, glm::mat4(1.0f));
+		culler.Rasterize();
+		check.Expect(!culler.HasOccluders(), "a near-plane-crossing occluder was kept");
+		check.Expect(culler.IsVisible(UnitBox(glm::vec3(0.0f, 0.0f, -10.0f)), glm::mat4(1.0f)), "a box is hidden by a near-plane-crossing occluder");
+	}
+
+	// Vertex and fragment text for a shader that is registered but never compiled.
+	ShaderSource HeadlessShaderSource(const std::string& name)
+	{
+		ShaderSource source;
+		source.VertexPath = "<" + name + ".vert>";
+		source.FragmentPath = "<" + name + ".frag>";
+		source.Vertex = "#version 330 core\nlayout(location = 0) in vec3 a_Position;\nuniform mat4 u_ViewProjection;\nuniform mat4 u_Model;\n"
+			"void main() { gl_Position = u_ViewProjection * u_Model * vec4(a_Position, 1.0); }\n";
+		source.Fragment = "#version 330 core\nout vec4 FragColor;\nvoid main() { FragColor = vec4(1.0); }\n";
+		return source;
+	}
+
+	// A unit quad facing +z that only exists on the CPU: it never goes through the geometry arena.
+	std::shared_ptr<Mesh> CreateHeadlessQuad()
+	{
+		auto quad = std::make_shared<Mesh>("HeadlessQuad");
+		quad->AddVertex(glm::vec3(-0.5f, -0.5f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 0.0f));
+		quad->AddVertex(glm::vec3(0.5f, -0.5f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 0.0f));
+		quad->AddVertex(glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 1.0f));
+		quad->AddVertex(glm::vec3(-0.5f, 0.5f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 1.0f));
+		for (unsigned int index : { 0u, 1u, 2u, 0u, 2u, 3u })
+		{
+			quad->AddIndex(index);
+		}
+		return quad;
+	}
+
+	// Six visible quads and one behind the camera, lit by one point light. Stone and brick share the
+	// HeadlessLit shader, glow uses HeadlessUnlit; stone has three quads, brick one and glow two.
+	struct RecordingScene
+	{
+		RuntimeContext Context;
+		std::shared_ptr<Scene> World;
+		std::vector<std::shared_ptr<Material>> Materials;
+	};
+
+	void BuildRecordingScene(RecordingScene& out)
+	{
+		ShaderRegistry::Register("HeadlessLit", HeadlessShaderSource("HeadlessLit"));
+		ShaderRegistry::Register("HeadlessUnlit", HeadlessShaderSource("HeadlessUnlit"));
+
+		auto createMaterial = [&](const std::string& name, const std::string& shader)
+			{
+				auto material = std::make_shared<Material>(name);
+				material->SetShaderName(shader);
+				out.Materials.push_back(material);
+				return material;
+			};
+
+		// Created in sort order: material ids break ties between draws on the same program.
+		const auto stone = createMaterial("Stone", "HeadlessLit");
+		const auto brick = createMaterial("Brick", "HeadlessLit");
+		const auto glow = createMaterial("Glow", "HeadlessUnlit");
+
+		out.World = std::make_shared<Scene>(out.Context);
+		const std::shared_ptr<Mesh> quad = CreateHeadlessQuad();
+
+		auto addQuad = [&](const std::shared_ptr<Material>& material, const Vector3& position)
+			{
+				Entity* entity = out.World->CreateEntity();
+				auto transform = std::make_shared<TransformComponent>();
+				transform->SetPosition(position);
+				entity->AddComponent(transform);
+				entity->AddComponent(std::make_shared<MeshComponent>(quad, material));
+			};
+
+		addQuad(stone, Vector3(-3.0f, 0.0f, 0.0f));
+		addQuad(stone, Vector3(-2.0f, 0.0f, 0.0f));
+		addQuad(stone, Vector3(-1.0f, 0.0f, 0.0f));
+		addQuad(brick, Vector3(0.0f, 0.0f, 0.0f));
+		addQuad(glow, Vector3(1.0f, 0.0f, 0.0f));
+		addQuad(glow, Vector3(2.0f, 0.0f, 0.0f));
+		addQuad(stone, Vector3(0.0f, 0.0f, 20.0f));
+
+		Entity* camera = out.World->CreateEntity();
+		auto cameraTransform = std::make_shared<TransformComponent>();
+		cameraTransform->SetPosition(Vector3(0.0f, 0.0f, 10.0f));
+		camera->AddComponent(cameraTransform);
+		camera->AddComponent(std::make_shared<CameraComponent>(60.0f, 16.0f / 9.0f, 0.1f, 100.0f));
+
+		Entity* light = out.World->CreateEntity();
+		auto lightTransform = std::make_shared<TransformComponent>();
+		lightTransform->SetPosition(Vector3(0.0f, 2.0f, 2.0f));
+		light->AddComponent(lightTransform);
+		light->AddComponent(std::make_shared<LightComponent>());
+
+		out.Context.SetActiveScene(out.World);
+
+		// Builds the camera's view matrix from its transform.
+		out.World->Update(0.0f);
+	}
+
+	// What ClusteredLighting::Upload() copies for the last recorded frame.
+	uint64_t LightListBytes()
+	{
+		const ClusterStats& lighting = RenderSystem::GetLightingStats();
+		return lighting.LightCount * 4 * sizeof(glm::vec4) + ClusteredLighting::k_ClusterCount * 2 * sizeof(uint32_t) +
+			lighting.LightIndexCount * sizeof(uint32_t);
+	}
+
+	uint64_t ParameterBlockBytes(const RecordingScene& scene)
+	{
+		uint64_t bytes = 0;
+		for (const auto& material : scene.Materials)
+		{
+			bytes += material->GetTemplate().GetBlockSize();
+		}
+		return bytes;
+	}
+
+	void CheckRecording(CheckContext& check)
+	{
+		RecordingScene scene;
+		BuildRecordingScene(scene);
+
+		RecordingCommandExecutor executor;
+		RenderSystem::Record(scene.Context, executor, 1280, 720);
+		const SubmissionStats& stats = executor.GetStats();
+
+		// Stone's quads become one multi-draw and glow's another; brick's single quad draws on its
+		// own, reusing the pool stone's multi-draw bound.
+		check.ExpectEqual(stats.ProgramBinds, 2u, "program binds");
+		check.ExpectEqual(stats.MaterialBinds, 3u, "material binds");
+		check.ExpectEqual(stats.GeometryBinds, 2u, "geometry binds");
+		check.ExpectEqual(stats.TextureBinds, 0u, "texture binds");
+		check.ExpectEqual(stats.MultiDrawCalls, 2u, "multi-draws");
+		check.ExpectEqual(stats.DrawCalls, 1u, "draws");
+		check.ExpectEqual(RenderSystem::GetLightingStats().LightCount, 1u, "binned lights");
+
+		// Indirect commands and instance data for five draws, the light lists, and each parameter
+		// block once, as none has been uploaded yet.
+		const uint64_t batchBytes = 5 * (sizeof(DrawElementsIndirectCommand) + sizeof(InstanceData));
+		check.ExpectEqual(stats.UploadBytes, batchBytes + LightListBytes() + ParameterBlockBytes(scene), "upload bytes");
+		check.ExpectEqual(executor.CountCommands(RecordedCommandType::Upload), size_t(5), "upload commands");
+		check.ExpectEqual(executor.CountCommands(RecordedCommandType::MultiDraw), size_t(2), "recorded multi-draws");
+	}
+
+	void CheckRecordingSingleDraws(CheckContext& check)
+	{
+		RecordingScene scene;
+		BuildRecordingScene(scene);
+
+		RecordingCommandExecutor executor;
+		executor.SetMultiDraw(false);
+		RenderSystem::Record(scene.Context, executor, 1280, 720);
+		const SubmissionStats& stats = executor.GetStats();
+
+		// Every quad shares one mesh, so it is bound once for the whole frame.
+		check.ExpectEqual(stats.ProgramBinds, 2u, "program binds");
+		check.ExpectEqual(stats.MaterialBinds, 3u, "material binds");
+		check.ExpectEqual(stats.GeometryBinds, 1u, "geometry binds");
+		check.ExpectEqual(stats.MultiDrawCalls, 0u, "multi-draws");
+		check.ExpectEqual(stats.DrawCalls, 6u, "draws");
+		check.ExpectEqual(stats.UploadBytes, LightListBytes() + ParameterBlockBytes(scene), "upload bytes");
+
+		for (const RecordedCommand& command : executor.GetCommands())
+		{
+			if (command.Type == RecordedCommandType::Draw)
+			{
+				check.ExpectEqual(command.Count, 6u, "indices per draw");
+			}
+		}
+
+		// Recording never clears a parameter block's dirty flag, so the next frame counts it again.
+		RenderSystem::Record(scene.Context, executor, 1280, 720);
+		check.ExpectEqual(executor.GetStats().UploadBytes, LightListBytes() + ParameterBlockBytes(scene), "upload bytes of the next frame");
+	}
+
+	void CheckRecordingNull(CheckContext& check)
+	{
+		RecordingScene scene;
+		BuildRecordingScene(scene);
+
+		NullCommandExecutor executor;
+		RenderSystem::Record(scene.Context, executor, 1280, 720);
+		const SubmissionStats& stats = executor.GetStats();
+
+		check.ExpectEqual(stats.DrawCalls, 6u, "packets");
+		check.ExpectEqual(stats.GetStateChanges(), 0u, "state changes");
+		check.ExpectEqual(stats.UploadBytes, uint64_t(0), "upload bytes");
+	}
+
+	std::vector<Check> CreateChecks()
+	{
+		return
+		{
+			{ "occlusion", "a wall hides the box behind it but not the ones beside or in front", CheckOcclusionCulling },
+			{ "occlusion-near-plane", "boxes at or behind the near plane are never culled", CheckOcclusionNearPlane },
+			{ "occlusion-empty", "nothing is culled without usable occluders", CheckOcclusionWithoutOccluders },
+			{ "recording", "a headless frame batches, binds and uploads as the GL executor would", CheckRecording },
+			{ "recording-single-draw", "without multi-draw every visible mesh is its own draw", CheckRecordingSingleDraws },
+			{ "recording-null", "the null executor receives every visible mesh and submits nothing", CheckRecordingNull }
+		};
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+
+			if (arg == "--check" && i + 1 < argc)
+			{
+				options.Checks.push_back(argv[++i]);
+			}
+			else if (arg == "--list")
+			{
+				options.List = true;
+			}
+			else if (arg == "--verbose")
+			{
+				options.Verbose = true;
+			}
+			else
+			{
+				std::cerr << "Unknown argument: " << arg << "\n";
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	Logger::SetLogLevel(options.Verbose ? LogLevel::Info : LogLevel::Warning);
+
+	std::vector<Check> checks = CreateChecks();
+	if (options.List)
+	{
+		for (const Check& check : checks)
+		{
+			std::cout << check.Name << ": " << check.Description << "\n";
+		}
+		return 0;
+	}
+
+	for (const std::string& name : options.Checks)
+	{
+		if (std::none_of(checks.begin(), checks.end(), [&](const Check& check) { return name == check.Name; }))
+		{
+			std::cerr << "Unknown check: " << name << "\n";
+			return 2;
+		}
+	}
+
+	// The culler and recording paths fan out over jobs, as they do in the engine.
+	JobSystem::Initialize();
+
+	uint32_t failed = 0;
+	uint32_t run = 0;
+	for (const Check& check : checks)
+	{
+		if (!options.Checks.empty() && std::find(options.Checks.begin(), options.Checks.end(), check.Name) == options.Checks.end())
+		{
+			continue;
+		}
+
+		CheckContext context(check.Name);
+		check.Run(context);
+		run++;
+
+		if (context.GetFailures() > 0)
+		{
+			failed++;
+		}
+		std::cout << (context.GetFailures() > 0 ? "FAIL " : "ok   ") << check.Name << "\n";
+	}
+
+	JobSystem::Shutdown();
+	Logger::Shutdown();
+
+	std::cout << run - failed << " of " << run << " checks passed\n";
+	return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,1020 @@
+// OrcaRenderBenchmark: renders scripted stress scenes offscreen and checks them against golden images.
+//
+//   OrcaRenderBenchmark <shaderDir> [--scene objects|materials|lights|shadows|sprites|all] [--size <w>x<h>]
+//                       [--frames <count>] [--warmup <count>] [--finish] [--csv <file>]
+//                       [--golden <dir>] [--output <dir>] [--tolerance <0-255>] [--max-diff <fraction>]
+//                       [--update-golden] [--context native|egl|osmesa] [--verbose]
+//
+// Every scene is built from generated geometry and advanced with a fixed time step, so the last
+// frame is the same on every run. Frames render through RenderSystem into an FBO behind a hidden
+// window; with --context osmesa and a GLFW that has the null platform, no display is needed at all.
+//
+// Timings are CPU wall time of RenderSystem::Render, or of Render plus glFinish with --finish.
+// Submission counters are averaged per frame. With --golden, the last frame of each scene is
+// compared per channel against <golden>/<scene>.ppm; a scene regresses when more than --max-diff
+// of its pixels differ by more than --tolerance, and the exit code is 1. The rendered frame, and
+// a diff image for regressions, go to --output.
+//
+// Golden images are not checked in: they depend on the rasterizer, and at the default size the
+// five scenes come to 14 MB. Each machine that runs the check keeps its own set, made once from
+// a known-good build with the exact options the check will use, since the last frame depends on
+// --size, --warmup and --frames:
+//
+//   OrcaRenderBenchmark Source/Runtime/Shaders --context osmesa --size 640x360 --golden <dir> --update-golden
+//
+// Mesa's llvmpipe through OSMesa gives the same images on any CPU. Keep <dir> outside the
+// repository, e.g. in the build machine's cache, and remake the set whenever a rendering change
+// is intended; the diff images in --output show what moved.
+
+#include "Core/JobSystem.h"
+#include "Core/Logger.h"
+#include "Renderer/Mesh.h"
+#include "Renderer/ShaderRegistry.h"
+#include "Renderer/SpriteBatch.h"
+#include "Material/Material.h"
+#include "Runtime/RenderSystem.h"
+#include "Runtime/RuntimeContext.h"
+#include "Scene/CameraComponent.h"
+#include "Scene/Entity.h"
+#include "Scene/LightComponent.h"
+#include "Scene/MeshComponent.h"
+#include "Scene/Scene.h"
+#include "Scene/TransformComponent.h"
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Orca;
+
+namespace
+{
+	// Fixed so animation, and with it the golden frame, does not depend on how fast a frame renders.
+	constexpr float k_FrameTime = 1.0f / 60.0f;
+
+	constexpr uint32_t k_SpriteCount = 100000;
+	constexpr uint32_t k_SpriteLayers = 4;
+	constexpr uint32_t k_SpriteTextureSize = 32;
+
+	struct Options
+	{
+		fs::path ShaderDir;
+		std::vector<std::string> Scenes;
+		uint32_t Width = 1280;
+		uint32_t Height = 720;
+		uint32_t Frames = 300;
+		uint32_t Warmup = 30;
+		bool Finish = false;
+		fs::path CsvPath;
+		fs::path GoldenDir;
+		fs::path OutputDir = "BenchmarkOutput";
+		int Tolerance = 8;
+		double MaxDiff = 0.001;
+		bool UpdateGolden = false;
+		int ContextApi = GLFW_NATIVE_CONTEXT_API;
+		bool Verbose = false;
+	};
+
+	struct Image
+	{
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		std::vector<uint8_t> Pixels;	// RGB, top row first
+	};
+
+	// Rotations of these transforms advance every frame.
+	struct SceneContents
+	{
+		std::vector<TransformComponent*> Animated;
+	};
+
+	struct BenchmarkScene
+	{
+		const char* Name;
+		const char* Description;
+		std::function<void(Scene&, SceneContents&)> Build;
+		std::function<void(uint32_t frame)> Overlay;	// Optional 2D pass drawn over the 3D frame
+	};
+
+	struct SpriteResources
+	{
+		SpriteBatch Batch;
+		unsigned int TextureArray = 0;
+	};
+
+	struct SceneResult
+	{
+		std::string Name;
+		std::vector<double> FrameMs;
+		SubmissionStats Submission;		// Summed over the measured frames
+		uint64_t ShadowCasterDraws = 0;
+		uint64_t Sprites = 0;
+		uint64_t SpriteDrawCalls = 0;
+		uint32_t Passes = 0;
+		bool Compared = false;
+		bool Passed = true;
+		double DiffFraction = 0.0;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: OrcaRenderBenchmark <shaderDir> [--scene objects|materials|lights|shadows|sprites|all] [--size <w>x<h>]\n"
+					 "                           [--frames <count>] [--warmup <count>] [--finish] [--csv <file>]\n"
+					 "                           [--golden <dir>] [--output <dir>] [--tolerance <0-255>] [--max-diff <fraction>]\n"
+					 "                           [--update-golden] [--context native|egl|osmesa] [--verbose]\n";
+	}
+
+	Quaternion AxisAngle(const Vector3& axis, float radians)
+	{
+		const float s = std::sin(radians * 0.5f);
+		return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f)).Normalized();
+	}
+
+	std::shared_ptr<Mesh> CreateCube()
+	{
+		const glm::vec3 normals[] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+		std::vector<Vertex> vertices;
+		std::vector<unsigned int> indices;
+		for (const glm::vec3& normal : normals)
+		{
+			// Two axes spanning the face, ordered so the face winds counter-clockwise seen from outside.
+			const glm::vec3 u = std::abs(normal.y) > 0.5f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+			const glm::vec3 v = glm::cross(normal, u);
+			const unsigned int base = static_cast<unsigned int>(vertices.size());
+
+			vertices.push_back({ 0.5f * (normal - u - v), normal, { 0, 0 } });
+			vertices.push_back({ 0.5f * (normal + u - v), normal, { 1, 0 } });
+			vertices.push_back({ 0.5f * (normal + u + v), normal, { 1, 1 } });
+			vertices.push_back({ 0.5f * (normal - u + v), normal, { 0, 1 } });
+			indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+		}
+		return Mesh::Create(vertices, indices);
+	}
+
+	std::shared_ptr<Mesh> CreatePlane()
+	{
+		const glm::vec3 up(0, 1, 0);
+		std::vector<Vertex> vertices =
+		{
+			{ { -0.5f, 0, 0.5f }, up, { 0, 0 } },
+			{ { 0.5f, 0, 0.5f }, up, { 1, 0 } },
+			{ { 0.5f, 0, -0.5f }, up, { 1, 1 } },
+			{ { -0.5f, 0, -0.5f }, up, { 0, 1 } }
+		};
+		return Mesh::Create(vertices, { 0, 1, 2, 0, 2, 3 });
+	}
+
+	std::shared_ptr<Material> CreateMaterial(const std::string& name, const glm::vec3& color, float metallic, float roughness)
+	{
+		auto material = std::make_shared<Material>(name);
+		material->SetShaderName("DefaultLit");
+		material->SetAlbedoColor(color);
+		material->SetMetallic(metallic);
+		material->SetRoughness(roughness);
+		return material;
+	}
+
+	// A repeatable color per index, spread around the hue circle.
+	glm::vec3 IndexColor(uint32_t index)
+	{
+		const float hue = std::fmod(static_cast<float>(index) * 0.618034f, 1.0f) * 6.0f;
+		const float x = 1.0f - std::abs(std::fmod(hue, 2.0f) - 1.0f);
+		const glm::vec3 table[] = { { 1, x, 0 }, { x, 1, 0 }, { 0, 1, x }, { 0, x, 1 }, { x, 0, 1 }, { 1, 0, x } };
+		return 0.2f + 0.8f * table[static_cast<int>(hue) % 6];
+	}
+
+	Entity* AddMesh(Scene& scene, std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> material, const Vector3& position, const Vector3& scale)
+	{
+		Entity* entity = scene.CreateEntity();
+		auto transform = std::make_shared<TransformComponent>();
+		transform->SetPosition(position);
+		transform->SetScale(scale);
+		entity->AddComponent(transform);
+		entity->AddComponent(std::make_shared<MeshComponent>(std::move(mesh), std::move(material)));
+		return entity;
+	}
+
+	void AddCamera(Scene& scene, const Vector3& position, float pitchRadians, float aspect)
+	{
+		Entity* entity = scene.CreateEntity();
+		auto transform = std::make_shared<TransformComponent>();
+		transform->SetPosition(position);
+		transform->SetRotation(AxisAngle(Vector3(1, 0, 0), pitchRadians));
+		entity->AddComponent(transform);
+		entity->AddComponent(std::make_shared<CameraComponent>(60.0f, aspect, 0.1f, 500.0f));
+	}
+
+	LightComponent* AddLight(Scene& scene, LightType type, const Vector3& position, const Quaternion& rotation, const glm::vec3& color, float range, bool castShadows)
+	{
+		Entity* entity = scene.CreateEntity();
+		auto transform = std::make_shared<TransformComponent>();
+		transform->SetPosition(position);
+		transform->SetRotation(rotation);
+		entity->AddComponent(transform);
+
+		auto light = std::make_shared<LightComponent>();
+		light->Type = type;
+		light->Color = Vector3(color.x, color.y, color.z);
+		light->Range = range;
+		light->CastShadows = castShadows;
+		entity->AddComponent(light);
+		return light.get();
+	}
+
+	// A grid of spinning cubes over a ground plane, with one material per materialCount cubes.
+	void BuildCubeGrid(Scene& scene, SceneContents& contents, uint32_t side, uint32_t materialCount, bool castShadows)
+	{
+		std::shared_ptr<Mesh> cube = CreateCube();
+		std::vector<std::shared_ptr<Material>> materials;
+		for (uint32_t i = 0; i < materialCount; ++i)
+		{
+			materials.push_back(CreateMaterial("Benchmark" + std::to_string(i), IndexColor(i), (i % 4) / 3.0f, 0.2f + 0.6f * ((i / 4) % 4) / 3.0f));
+		}
+
+		const float spacing = 2.0f;
+		const float offset = 0.5f * spacing * static_cast<float>(side - 1);
+		for (uint32_t z = 0; z < side; ++z)
+		{
+			for (uint32_t x = 0; x < side; ++x)
+			{
+				const uint32_t index = z * side + x;
+				Entity* entity = AddMesh(scene, cube, materials[index % materials.size()],
+					Vector3(static_cast<float>(x) * spacing - offset, 0.5f, -static_cast<float>(z) * spacing), Vector3(1.0f));
+				entity->GetComponent<MeshComponent>()->SetCastShadows(castShadows);
+				contents.Animated.push_back(entity->GetComponent<TransformComponent>());
+			}
+		}
+
+		const float extent = spacing * static_cast<float>(side) + 20.0f;
+		Entity* ground = AddMesh(scene, CreatePlane(), CreateMaterial("BenchmarkGround", glm::vec3(0.6f), 0.0f, 0.9f),
+			Vector3(0.0f, 0.0f, -0.5f * extent + 10.0f), Vector3(extent, 1.0f, extent));
+		MeshComponent* groundMesh = ground->GetComponent<MeshComponent>();
+		groundMesh->SetStatic(true);
+		groundMesh->SetCastShadows(false);
+	}
+
+	// Four 32x32 shapes in one texture array, so every sprite draws from the same texture.
+	unsigned int CreateSpriteTextures()
+	{
+		const uint32_t size = k_SpriteTextureSize;
+		std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4 * k_SpriteLayers);
+
+		for (uint32_t layer = 0; layer < k_SpriteLayers; ++layer)
+		{
+			for (uint32_t y = 0; y < size; ++y)
+			{
+				for (uint32_t x = 0; x < size; ++x)
+				{
+					const float u = (static_cast<float>(x) + 0.5f) / size * 2.0f - 1.0f;
+					const float v = (static_cast<float>(y) + 0.5f) / size * 2.0f - 1.0f;
+					const float radius = std::sqrt(u * u + v * v);
+
+					bool inside = false;
+					switch (layer)
+					{
+					case 0: inside = radius < 0.9f; break;
+					case 1: inside = radius < 0.9f && radius > 0.5f; break;
+					case 2: inside = std::abs(u) + std::abs(v) < 0.9f; break;
+					default: inside = ((x / 8) + (y / 8)) % 2 == 0; break;
+					}
+
+					uint8_t* pixel = &pixels[((static_cast<size_t>(layer) * size + y) * size + x) * 4];
+					pixel[0] = pixel[1] = pixel[2] = 255;
+					pixel[3] = inside ? 255 : 0;
+				}
+			}
+		}
+
+		unsigned int texture = 0;
+		glGenTextures(1, &texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, static_cast<GLsizei>(size), static_cast<GLsizei>(size), static_cast<GLsizei>(k_SpriteLayers),
+			0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		return texture;
+	}
+
+	// k_SpriteCount spinning sprites on a grid covering the target, in pixel coordinates.
+	void DrawSprites(SpriteResources& sprites, uint32_t frame, uint32_t width, uint32_t height)
+	{
+		if (sprites.TextureArray == 0)
+		{
+			sprites.TextureArray = CreateSpriteTextures();
+		}
+
+		const float time = static_cast<float>(frame) * k_FrameTime;
+		const uint32_t columns = static_cast<uint32_t>(std::ceil(std::sqrt(k_SpriteCount * static_cast<float>(width) / static_cast<float>(height))));
+		const uint32_t rows = (k_SpriteCount + columns - 1) / columns;
+		const glm::vec2 cell(static_cast<float>(width) / columns, static_cast<float>(height) / rows);
+
+		const glm::mat4 projection(
+			glm::vec4(2.0f / static_cast<float>(width), 0.0f, 0.0f, 0.0f),
+			glm::vec4(0.0f, 2.0f / static_cast<float>(height), 0.0f, 0.0f),
+			glm::vec4(0.0f, 0.0f, -1.0f, 0.0f),
+			glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f));
+
+		sprites.Batch.Begin(projection);
+		for (uint32_t i = 0; i < k_SpriteCount; ++i)
+		{
+			Sprite sprite;
+			sprite.Position = glm::vec2(static_cast<float>(i % columns) + 0.5f, static_cast<float>(i / columns) + 0.5f) * cell;
+			sprite.Size = cell * 1.5f;
+			sprite.Rotation = time * (1.0f + 0.25f * static_cast<float>(i % 5));
+			sprite.Color = glm::vec4(IndexColor(i), 0.8f);
+			sprite.Texture = sprites.TextureArray;
+			sprite.Layer = static_cast<int>(i % k_SpriteLayers);
+			sprites.Batch.Draw(sprite);
+		}
+		sprites.Batch.End();
+	}
+
+	std::vector<BenchmarkScene> CreateScenes(float aspect, const Options& options, SpriteResources& sprites)
+	{
+		return
+		{
+			{ "objects", "2500 cubes sharing 4 materials, one directional light",
+				[aspect](Scene& scene, SceneContents& contents)
+				{
+					BuildCubeGrid(scene, contents, 50, 4, false);
+					AddLight(scene, LightType::Directional, Vector3(0.0f), AxisAngle(Vector3(1, 0, 0), -1.0f), glm::vec3(1.0f), 0.0f, false);
+					AddCamera(scene, Vector3(0.0f, 25.0f, 20.0f), -0.6f, aspect);
+				} },
+			{ "materials", "1024 cubes, each with its own material",
+				[aspect](Scene& scene, SceneContents& contents)
+				{
+					BuildCubeGrid(scene, contents, 32, 1024, false);
+					AddLight(scene, LightType::Directional, Vector3(0.0f), AxisAngle(Vector3(1, 0, 0), -1.0f), glm::vec3(1.0f), 0.0f, false);
+					AddCamera(scene, Vector3(0.0f, 20.0f, 16.0f), -0.6f, aspect);
+				} },
+			{ "lights", "400 cubes lit by 512 point lights",
+				[aspect](Scene& scene, SceneContents& contents)
+				{
+					BuildCubeGrid(scene, contents, 20, 8, false);
+					for (uint32_t i = 0; i < 512; ++i)
+					{
+						const float x = static_cast<float>(i % 32) * 1.25f - 19.5f;
+						const float z = -static_cast<float>(i / 32) * 2.5f;
+						AddLight(scene, LightType::Point, Vector3(x, 1.5f + (i % 3) * 0.5f, z), Quaternion(), IndexColor(i), 4.0f, false);
+					}
+					AddCamera(scene, Vector3(0.0f, 15.0f, 12.0f), -0.6f, aspect);
+				} },
+			{ "shadows", "144 shadow casters, a directional light and 8 shadowed spot lights",
+				[aspect](Scene& scene, SceneContents& contents)
+				{
+					BuildCubeGrid(scene, contents, 12, 8, true);
+					AddLight(scene, LightType::Directional, Vector3(0.0f), AxisAngle(Vector3(1, 0, 0), -0.9f), glm::vec3(0.6f), 0.0f, true);
+					for (uint32_t i = 0; i < 8; ++i)
+					{
+						const float x = static_cast<float>(i % 4) * 7.0f - 10.5f;
+						const float z = -static_cast<float>(i / 4) * 12.0f - 5.0f;
+						LightComponent* spot = AddLight(scene, LightType::Spot, Vector3(x, 8.0f, z), AxisAngle(Vector3(1, 0, 0), -1.5f), IndexColor(i), 20.0f, true);
+						spot->SpotAngle = 40.0f;
+					}
+					AddCamera(scene, Vector3(0.0f, 14.0f, 10.0f), -0.7f, aspect);
+				} },
+			{ "sprites", "100000 rotating sprites from one texture array, drawn by SpriteBatch",
+				[aspect](Scene& scene, SceneContents&)
+				{
+					AddCamera(scene, Vector3(0.0f, 0.0f, 10.0f), 0.0f, aspect);
+				},
+				[&options, &sprites](uint32_t frame)
+				{
+					DrawSprites(sprites, frame, options.Width, options.Height);
+				} }
+		};
+	}
+
+	bool ParseSize(const std::string& text, uint32_t& width, uint32_t& height)
+	{
+		const size_t separator = text.find('x');
+		if (separator == std::string::npos)
+		{
+			return false;
+		}
+
+		width = static_cast<uint32_t>(std::stoul(text.substr(0, separator)));
+		height = static_cast<uint32_t>(std::stoul(text.substr(separator + 1)));
+		return width > 0 && height > 0;
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		std::vector<std::string> positional;
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+
+			if (arg == "--scene" && hasValue)
+			{
+				options.Scenes.push_back(argv[++i]);
+			}
+			else if (arg == "--size" && hasValue)
+			{
+				if (!ParseSize(argv[++i], options.Width, options.Height))
+				{
+					std::cerr << "Invalid size: " << argv[i] << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--frames" && hasValue)
+			{
+				options.Frames = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+			}
+			else if (arg == "--warmup" && hasValue)
+			{
+				options.Warmup = static_cast<uint32_t>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--finish")
+			{
+				options.Finish = true;
+			}
+			else if (arg == "--csv" && hasValue)
+			{
+				options.CsvPath = argv[++i];
+			}
+			else if (arg == "--golden" && hasValue)
+			{
+				options.GoldenDir = argv[++i];
+			}
+			else if (arg == "--output" && hasValue)
+			{
+				options.OutputDir = argv[++i];
+			}
+			else if (arg == "--tolerance" && hasValue)
+			{
+				options.Tolerance = std::clamp(std::stoi(argv[++i]), 0, 255);
+			}
+			else if (arg == "--max-diff" && hasValue)
+			{
+				options.MaxDiff = std::clamp(std::stod(argv[++i]), 0.0, 1.0);
+			}
+			else if (arg == "--update-golden")
+			{
+				options.UpdateGolden = true;
+			}
+			else if (arg == "--context" && hasValue)
+			{
+				const std::string api = argv[++i];
+				if (api == "native") options.ContextApi = GLFW_NATIVE_CONTEXT_API;
+				else if (api == "egl") options.ContextApi = GLFW_EGL_CONTEXT_API;
+				else if (api == "osmesa") options.ContextApi = GLFW_OSMESA_CONTEXT_API;
+				else
+				{
+					std::cerr << "Unknown context API: " << api << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--verbose")
+			{
+				options.Verbose = true;
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				std::cerr << "Unknown option: " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				positional.push_back(arg);
+			}
+		}
+
+		if (positional.size() != 1)
+		{
+			return false;
+		}
+
+		options.ShaderDir = positional[0];
+		if (options.UpdateGolden && options.GoldenDir.empty())
+		{
+			std::cerr << "--update-golden needs --golden <dir>\n";
+			return false;
+		}
+		return true;
+	}
+
+	// Binary PPM (P6): no dependency, and every image viewer and diff tool reads it.
+	bool WritePPM(const fs::path& path, const Image& image)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file << "P6\n" << image.Width << " " << image.Height << "\n255\n";
+		file.write(reinterpret_cast<const char*>(image.Pixels.data()), static_cast<std::streamsize>(image.Pixels.size()));
+		return file.good();
+	}
+
+	bool ReadPPM(const fs::path& path, Image& image)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		// Header fields are separated by whitespace and may be interleaved with # comments.
+		auto readField = [&file](std::string& field)
+		{
+			field.clear();
+			while (file)
+			{
+				const int c = file.get();
+				if (c == '#')
+				{
+					std::string comment;
+					std::getline(file, comment);
+				}
+				else if (std::isspace(c) || c == EOF)
+				{
+					if (!field.empty()) return true;
+				}
+				else
+				{
+					field.push_back(static_cast<char>(c));
+				}
+			}
+			return !field.empty();
+		};
+
+		std::string magic, width, height, maxValue;
+		if (!readField(magic) || magic != "P6" || !readField(width) || !readField(height) || !readField(maxValue) || maxValue != "255")
+		{
+			return false;
+		}
+
+		image.Width = static_cast<uint32_t>(std::stoul(width));
+		image.Height = static_cast<uint32_t>(std::stoul(height));
+		image.Pixels.resize(static_cast<size_t>(image.Width) * image.Height * 3);
+		file.read(reinterpret_cast<char*>(image.Pixels.data()), static_cast<std::streamsize>(image.Pixels.size()));
+		return file.gcount() == static_cast<std::streamsize>(image.Pixels.size());
+	}
+
+	Image ReadFramebuffer(unsigned int framebuffer, uint32_t width, uint32_t height)
+	{
+		Image image;
+		image.Width = width;
+		image.Height = height;
+		image.Pixels.resize(static_cast<size_t>(width) * height * 3);
+
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGB, GL_UNSIGNED_BYTE, image.Pixels.data());
+
+		// GL rows start at the bottom.
+		const size_t rowSize = static_cast<size_t>(width) * 3;
+		for (uint32_t y = 0; y < height / 2; ++y)
+		{
+			std::swap_ranges(image.Pixels.begin() + y * rowSize, image.Pixels.begin() + (y + 1) * rowSize,
+				image.Pixels.begin() + (height - 1 - y) * rowSize);
+		}
+		return image;
+	}
+
+	// Fraction of pixels with any channel off by more than tolerance; the diff image marks them red
+	// over a darkened copy of the reference.
+	double CompareImages(const Image& actual, const Image& expected, int tolerance, Image& diff)
+	{
+		diff.Width = expected.Width;
+		diff.Height = expected.Height;
+		diff.Pixels.resize(expected.Pixels.size());
+
+		size_t differing = 0;
+		for (size_t i = 0; i < expected.Pixels.size(); i += 3)
+		{
+			bool differs = false;
+			for (size_t c = 0; c < 3; ++c)
+			{
+				differs |= std::abs(static_cast<int>(actual.Pixels[i + c]) - static_cast<int>(expected.Pixels[i + c])) > tolerance;
+			}
+
+			if (differs)
+			{
+				++differing;
+				diff.Pixels[i] = 255;
+				diff.Pixels[i + 1] = 0;
+				diff.Pixels[i + 2] = 0;
+			}
+			else
+			{
+				for (size_t c = 0; c < 3; ++c)
+				{
+					diff.Pixels[i + c] = static_cast<uint8_t>(expected.Pixels[i + c] / 4);
+				}
+			}
+		}
+
+		const size_t pixelCount = expected.Pixels.size() / 3;
+		return pixelCount > 0 ? static_cast<double>(differing) / static_cast<double>(pixelCount) : 0.0;
+	}
+
+	double Percentile(std::vector<double> values, double fraction)
+	{
+		if (values.empty())
+		{
+			return 0.0;
+		}
+
+		std::sort(values.begin(), values.end());
+		const size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5);
+		return values[std::min(index, values.size() - 1)];
+	}
+
+	double Average(const std::vector<double>& values)
+	{
+		double total = 0.0;
+		for (double value : values)
+		{
+			total += value;
+		}
+		return values.empty() ? 0.0 : total / static_cast<double>(values.size());
+	}
+
+	// The render target RenderSystem draws into instead of the window.
+	class OffscreenTarget
+	{
+	public:
+		bool Create(uint32_t width, uint32_t height)
+		{
+			glGenRenderbuffers(2, m_Renderbuffers);
+			glBindRenderbuffer(GL_RENDERBUFFER, m_Renderbuffers[0]);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+			glBindRenderbuffer(GL_RENDERBUFFER, m_Renderbuffers[1]);
+			glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+			glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+			glGenFramebuffers(1, &m_Framebuffer);
+			glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_Renderbuffers[0]);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_Renderbuffers[1]);
+			const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			return complete;
+		}
+
+		void Release()
+		{
+			if (m_Framebuffer != 0)
+			{
+				glDeleteFramebuffers(1, &m_Framebuffer);
+				glDeleteRenderbuffers(2, m_Renderbuffers);
+				m_Framebuffer = 0;
+			}
+		}
+
+		unsigned int GetFramebuffer() const { return m_Framebuffer; }
+
+	private:
+		unsigned int m_Framebuffer = 0;
+		unsigned int m_Renderbuffers[2] = {};
+	};
+
+	SceneResult RunScene(const BenchmarkScene& benchmark, const Options& options, RuntimeContext& context, const OffscreenTarget& target, const SpriteBatch* sprites)
+	{
+		SceneResult result;
+		result.Name = benchmark.Name;
+
+		// Cached shadow maps are keyed by light; the previous scene's lights are gone.
+		RenderSystem::SetShadowSettings(ShadowSettings{});
+
+		auto scene = std::make_shared<Scene>(context);
+		SceneContents contents;
+		benchmark.Build(*scene, contents);
+		context.SetActiveScene(scene);
+
+		uint32_t frame = 0;
+		auto step = [&]()
+		{
+			const float time = static_cast<float>(frame++) * k_FrameTime;
+			for (size_t i = 0; i < contents.Animated.size(); ++i)
+			{
+				contents.Animated[i]->SetRotation(AxisAngle(Vector3(0, 1, 0), time * (0.5f + 0.1f * static_cast<float>(i % 7))));
+			}
+			context.SetDeltaTime(k_FrameTime);
+			scene->Update(k_FrameTime);
+		};
+
+		// Drawn straight into the target after the frame, as a game's UI pass would be.
+		auto overlay = [&]()
+		{
+			if (benchmark.Overlay)
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, target.GetFramebuffer());
+				glViewport(0, 0, static_cast<GLsizei>(options.Width), static_cast<GLsizei>(options.Height));
+				benchmark.Overlay(frame);
+			}
+		};
+
+		// Warm-up frames give shader variants, shadow caches and the frame graph pool time to settle.
+		for (uint32_t i = 0; i < options.Warmup; ++i)
+		{
+			step();
+			RenderSystem::Render(context);
+			overlay();
+		}
+		ShaderRegistry::WaitForAll();
+		glFinish();
+
+		result.FrameMs.reserve(options.Frames);
+		for (uint32_t i = 0; i < options.Frames; ++i)
+		{
+			step();
+
+			const auto start = std::chrono::steady_clock::now();
+			RenderSystem::Render(context);
+			overlay();
+			if (options.Finish)
+			{
+				glFinish();
+			}
+			const auto end = std::chrono::steady_clock::now();
+			result.FrameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+			const SubmissionStats& submission = RenderSystem::GetSubmissionStats();
+			result.Submission.DrawCalls += submission.DrawCalls;
+			result.Submission.MultiDrawCalls += submission.MultiDrawCalls;
+			result.Submission.ProgramBinds += submission.ProgramBinds;
+			result.Submission.MaterialBinds += submission.MaterialBinds;
+			result.Submission.GeometryBinds += submission.GeometryBinds;
+			result.ShadowCasterDraws += RenderSystem::GetShadowStats().CasterDraws;
+			result.Passes = RenderSystem::GetFrameGraphStats().Passes;
+			if (benchmark.Overlay && sprites)
+			{
+				result.Sprites += sprites->GetStats().Sprites;
+				result.SpriteDrawCalls += sprites->GetStats().DrawCalls;
+			}
+		}
+
+		glFinish();
+		const Image image = ReadFramebuffer(target.GetFramebuffer(), options.Width, options.Height);
+		const fs::path outputPath = options.OutputDir / (result.Name + ".ppm");
+		if (!WritePPM(outputPath, image))
+		{
+			Logger::Log(LogLevel::Error, "Can't write " + outputPath.string());
+		}
+
+		if (options.UpdateGolden)
+		{
+			const fs::path goldenPath = options.GoldenDir / (result.Name + ".ppm");
+			if (!WritePPM(goldenPath, image))
+			{
+				Logger::Log(LogLevel::Error, "Can't write " + goldenPath.string());
+				result.Passed = false;
+			}
+		}
+		else if (!options.GoldenDir.empty())
+		{
+			result.Compared = true;
+
+			Image golden;
+			const fs::path goldenPath = options.GoldenDir / (result.Name + ".ppm");
+			if (!ReadPPM(goldenPath, golden))
+			{
+				Logger::Log(LogLevel::Error, "No golden image at " + goldenPath.string() + "; run with --update-golden to create it");
+				result.Passed = false;
+			}
+			else if (golden.Width != image.Width || golden.Height != image.Height)
+			{
+				Logger::Log(LogLevel::Error, "Golden image " + goldenPath.string() + " is " + std::to_string(golden.Width) + "x" +
+					std::to_string(golden.Height) + ", rendered " + std::to_string(image.Width) + "x" + std::to_string(image.Height));
+				result.Passed = false;
+			}
+			else
+			{
+				Image diff;
+				result.DiffFraction = CompareImages(image, golden, options.Tolerance, diff);
+				result.Passed = result.DiffFraction <= options.MaxDiff;
+				if (!result.Passed)
+				{
+					WritePPM(options.OutputDir / (result.Name + ".diff.ppm"), diff);
+				}
+			}
+		}
+
+		context.SetActiveScene(nullptr);
+		return result;
+	}
+
+	void PrintResult(const SceneResult& result)
+	{
+		const double frames = static_cast<double>(std::max<size_t>(result.FrameMs.size(), 1));
+
+		std::cout << std::fixed << std::setprecision(2)
+				  << result.Name << ": " << result.FrameMs.size() << " frames, avg " << Average(result.FrameMs)
+				  << " ms, p50 " << Percentile(result.FrameMs, 0.5) << ", p95 " << Percentile(result.FrameMs, 0.95)
+				  << ", p99 " << Percentile(result.FrameMs, 0.99) << ", max " << Percentile(result.FrameMs, 1.0) << "\n"
+				  << std::setprecision(1)
+				  << "    per frame: " << result.Submission.DrawCalls / frames << " draws (" << result.Submission.MultiDrawCalls / frames
+				  << " multi-draw), " << result.Submission.ProgramBinds / frames << " program, " << result.Submission.MaterialBinds / frames
+				  << " material, " << result.Submission.GeometryBinds / frames << " geometry binds, " << result.ShadowCasterDraws / frames
+				  << " shadow draws, " << result.Passes << " passes\n";
+
+		if (result.Sprites > 0)
+		{
+			std::cout << "    sprites: " << result.Sprites / frames << " per frame in " << result.SpriteDrawCalls / frames << " draws\n";
+		}
+
+		if (result.Compared)
+		{
+			std::cout << std::setprecision(4) << "    image: " << (result.Passed ? "match" : "REGRESSION") << ", "
+					  << result.DiffFraction * 100.0 << "% of pixels differ\n";
+		}
+	}
+
+	void WriteCsv(const fs::path& path, const std::vector<SceneResult>& results)
+	{
+		std::ofstream file(path, std::ios::trunc);
+		if (!file.is_open())
+		{
+			Logger::Log(LogLevel::Error, "Can't write " + path.string());
+			return;
+		}
+
+		file << "scene,frames,avg_ms,p50_ms,p95_ms,p99_ms,max_ms,draw_calls,multi_draw_calls,program_binds,material_binds,geometry_binds,shadow_draws,sprites,sprite_draw_calls,passes,diff_fraction,passed\n";
+		for (const SceneResult& result : results)
+		{
+			const double frames = static_cast<double>(std::max<size_t>(result.FrameMs.size(), 1));
+			file << result.Name << "," << result.FrameMs.size() << "," << Average(result.FrameMs) << ","
+				 << Percentile(result.FrameMs, 0.5) << "," << Percentile(result.FrameMs, 0.95) << ","
+				 << Percentile(result.FrameMs, 0.99) << "," << Percentile(result.FrameMs, 1.0) << ","
+				 << result.Submission.DrawCalls / frames << "," << result.Submission.MultiDrawCalls / frames << ","
+				 << result.Submission.ProgramBinds / frames << "," << result.Submission.MaterialBinds / frames << ","
+				 << result.Submission.GeometryBinds / frames << "," << result.ShadowCasterDraws / frames << ","
+				 << result.Sprites / frames << "," << result.SpriteDrawCalls / frames << ","
+				 << result.Passes << "," << result.DiffFraction << "," << (result.Passed ? 1 : 0) << "\n";
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	Logger::SetLogLevel(options.Verbose ? LogLevel::Info : LogLevel::Warning);
+
+	SpriteResources sprites;
+	std::vector<BenchmarkScene> scenes = CreateScenes(static_cast<float>(options.Width) / static_cast<float>(options.Height), options, sprites);
+	if (!options.Scenes.empty() && std::find(options.Scenes.begin(), options.Scenes.end(), "all") == options.Scenes.end())
+	{
+		std::vector<BenchmarkScene> selected;
+		for (const std::string& name : options.Scenes)
+		{
+			auto it = std::find_if(scenes.begin(), scenes.end(), [&](const BenchmarkScene& scene) { return name == scene.Name; });
+			if (it == scenes.end())
+			{
+				std::cerr << "Unknown scene: " << name << "\n";
+				PrintUsage();
+				return 2;
+			}
+			selected.push_back(*it);
+		}
+		scenes = std::move(selected);
+	}
+
+	std::error_code error;
+	if (!fs::is_directory(options.ShaderDir, error))
+	{
+		Logger::Log(LogLevel::Error, "Shader directory not found: " + options.ShaderDir.string());
+		Logger::Shutdown();
+		return 1;
+	}
+	fs::create_directories(options.OutputDir, error);
+	if (options.UpdateGolden)
+	{
+		fs::create_directories(options.GoldenDir, error);
+	}
+
+#ifdef GLFW_PLATFORM_NULL
+	// OSMesa renders in software and needs no display, so it doesn't need a windowing platform either.
+	if (options.ContextApi == GLFW_OSMESA_CONTEXT_API)
+	{
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	}
+#endif
+
+	if (!glfwInit())
+	{
+		Logger::Log(LogLevel::Error, "Failed to initialize GLFW!");
+		Logger::Shutdown();
+		return 1;
+	}
+
+	// The window only owns the context; frames go to an FBO.
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	glfwWindowHint(GLFW_CONTEXT_CREATION_API, options.ContextApi);
+	// Same version as the engine's own window; software drivers such as llvmpipe stop at 4.5.
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+	GLFWwindow* window = glfwCreateWindow(static_cast<int>(options.Width), static_cast<int>(options.Height), "OrcaRenderBenchmark", nullptr, nullptr);
+	if (!window)
+	{
+		Logger::Log(LogLevel::Error, "Failed to create an OpenGL 3.3 core context!");
+		glfwTerminate();
+		Logger::Shutdown();
+		return 1;
+	}
+
+	glfwMakeContextCurrent(window);
+	glfwSwapInterval(0);
+
+	glewExperimental = GL_TRUE;
+	if (glewInit() != GLEW_OK)
+	{
+		Logger::Log(LogLevel::Error, "Failed to initialize GLEW!");
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		Logger::Shutdown();
+		return 1;
+	}
+
+	std::cout << "Renderer: " << reinterpret_cast<const char*>(glGetString(GL_RENDERER)) << " ("
+			  << reinterpret_cast<const char*>(glGetString(GL_VERSION)) << "), " << options.Width << "x" << options.Height << "\n";
+
+	OffscreenTarget target;
+	if (!target.Create(options.Width, options.Height))
+	{
+		Logger::Log(LogLevel::Error, "Offscreen framebuffer is incomplete!");
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		Logger::Shutdown();
+		return 1;
+	}
+
+	int exitCode = 0;
+	{
+		RuntimeContext context;
+
+		JobSystem::Initialize();
+		RenderSystem::Initialize(options.ShaderDir.string());
+		ShaderRegistry::WaitForAll();
+
+		// Timings compare like with like only at a fixed resolution.
+		DynamicResolutionSettings resolution;
+		resolution.Enabled = false;
+		RenderSystem::SetDynamicResolutionSettings(resolution);
+		RenderSystem::SetRenderTarget(target.GetFramebuffer(), options.Width, options.Height);
+
+		std::vector<SceneResult> results;
+		for (const BenchmarkScene& scene : scenes)
+		{
+			std::cout << "Running " << scene.Name << ": " << scene.Description << "\n";
+			results.push_back(RunScene(scene, options, context, target, &sprites.Batch));
+			PrintResult(results.back());
+
+			if (!results.back().Passed)
+			{
+				exitCode = 1;
+			}
+		}
+
+		if (!options.CsvPath.empty())
+		{
+			WriteCsv(options.CsvPath, results);
+		}
+
+		sprites.Batch.Release();
+		if (sprites.TextureArray != 0)
+		{
+			glDeleteTextures(1, &sprites.TextureArray);
+		}
+
+		RenderSystem::SetRenderTarget(0, 0, 0);
+		RenderSystem::Shutdown();
+		JobSystem::Shutdown();
+	}
+
+	target.Release();
+	glfwDestroyWindow(window);
+	glfwTerminate();
+
+	Logger::Shutdown();
+	return exitCode;
+}
@@ -0,0 +1,286 @@
+// OrcaShaderTranspile: transpiles every .vert/.frag pair in a directory ahead of time.
+//
+//   OrcaShaderTranspile <shaderDir> <outputDir> [--target hlsl|vulkan|metal|all] [--cache <dir>]
+//                       [--jobs <count>] [--validate] [--clean] [--verbose]
+//
+// Programs are transpiled in parallel on the engine JobSystem. Results go through
+// ShaderTranspileCache, so a rerun only transpiles programs whose sources (or the transpiler)
+// changed and only rewrites outputs that are missing or differ from the cached result.
+
+#include "Core/JobSystem.h"
+#include "Core/Logger.h"
+#include "Renderer/ShaderTranspiler.h"
+#include "Renderer/ShaderTranspileCache.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Orca;
+
+namespace
+{
+	struct TargetInfo
+	{
+		ShaderTarget Target;
+		const char* Name;
+		const char* Extension;
+	};
+
+	constexpr TargetInfo k_Targets[] =
+	{
+		{ ShaderTarget::HLSL, "hlsl", ".hlsl" },
+		{ ShaderTarget::Vulkan, "vulkan", ".vk.glsl" },
+		{ ShaderTarget::Metal, "metal", ".metal" }
+	};
+
+	struct Program
+	{
+		std::string Name;
+		std::string VertexSource;
+		std::string FragmentSource;
+	};
+
+	struct Options
+	{
+		fs::path ShaderDir;
+		fs::path OutputDir;
+		fs::path CacheDir;
+		std::vector<TargetInfo> Targets;
+		unsigned int Jobs = 0;
+		bool Validate = false;
+		bool Clean = false;
+		bool Verbose = false;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: OrcaShaderTranspile <shaderDir> <outputDir> [--target hlsl|vulkan|metal|all]\n"
+					 "                           [--cache <dir>] [--jobs <count>] [--validate] [--clean] [--verbose]\n";
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		std::vector<std::string> positional;
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+
+			if (arg == "--target" && hasValue)
+			{
+				const std::string name = argv[++i];
+				for (const TargetInfo& target : k_Targets)
+				{
+					if (name == "all" || name == target.Name)
+					{
+						options.Targets.push_back(target);
+					}
+				}
+				if (options.Targets.empty())
+				{
+					std::cerr << "Unknown target: " << name << "\n";
+					return false;
+				}
+			}
+			else if (arg == "--cache" && hasValue)
+			{
+				options.CacheDir = argv[++i];
+			}
+			else if (arg == "--jobs" && hasValue)
+			{
+				options.Jobs = static_cast<unsigned int>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--validate")
+			{
+				options.Validate = true;
+			}
+			else if (arg == "--clean")
+			{
+				options.Clean = true;
+			}
+			else if (arg == "--verbose")
+			{
+				options.Verbose = true;
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				std::cerr << "Unknown option: " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				positional.push_back(arg);
+			}
+		}
+
+		if (positional.size() != 2)
+		{
+			return false;
+		}
+
+		options.ShaderDir = positional[0];
+		options.OutputDir = positional[1];
+		if (options.CacheDir.empty())
+		{
+			options.CacheDir = options.OutputDir / "Cache";
+		}
+		if (options.Targets.empty())
+		{
+			options.Targets.assign(std::begin(k_Targets), std::end(k_Targets));
+		}
+		return true;
+	}
+
+	bool ReadFile(const fs::path& path, std::string& out)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::ostringstream contents;
+		contents << file.rdbuf();
+		out = contents.str();
+		return true;
+	}
+
+	// Pairs <name>.vert with <name>.frag the same way RenderSystem does at startup.
+	std::vector<Program> CollectPrograms(const fs::path& shaderDir)
+	{
+		std::map<std::string, fs::path> vertexPaths;
+		std::map<std::string, fs::path> fragmentPaths;
+
+		for (const auto& entry : fs::directory_iterator(shaderDir))
+		{
+			if (!entry.is_regular_file()) continue;
+
+			const std::string name = entry.path().stem().string();
+			const std::string ext = entry.path().extension().string();
+
+			if (ext == ".vert") vertexPaths[name] = entry.path();
+			else if (ext == ".frag") fragmentPaths[name] = entry.path();
+		}
+
+		std::vector<Program> programs;
+		for (const auto& [name, vertexPath] : vertexPaths)
+		{
+			auto fragment = fragmentPaths.find(name);
+			if (fragment == fragmentPaths.end())
+			{
+				Logger::Log(LogLevel::Warning, "No fragment shader for " + name + ", skipped");
+				continue;
+			}
+
+			Program program{ name };
+			if (!ReadFile(vertexPath, program.VertexSource) || !ReadFile(fragment->second, program.FragmentSource))
+			{
+				Logger::Log(LogLevel::Error, "Can't read sources for " + name);
+				continue;
+			}
+			programs.push_back(std::move(program));
+		}
+		return programs;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	// Transpile() logs every success; only problems are interesting in a batch run.
+	Logger::SetLogLevel(options.Verbose ? LogLevel::Info : LogLevel::Warning);
+
+	std::error_code error;
+	if (!fs::is_directory(options.ShaderDir, error))
+	{
+		Logger::Log(LogLevel::Error, "Shader directory not found: " + options.ShaderDir.string());
+		Logger::Shutdown();
+		return 1;
+	}
+
+	ShaderTranspileCache::Initialize(options.CacheDir.string());
+	if (options.Clean)
+	{
+		ShaderTranspileCache::Clear();
+	}
+
+	for (const TargetInfo& target : options.Targets)
+	{
+		fs::create_directories(options.OutputDir / target.Name, error);
+	}
+
+	const std::vector<Program> programs = CollectPrograms(options.ShaderDir);
+	const unsigned int jobCount = static_cast<unsigned int>(programs.size() * options.Targets.size());
+
+	std::atomic<unsigned int> built{ 0 };
+	std::atomic<unsigned int> upToDate{ 0 };
+	std::atomic<unsigned int> failed{ 0 };
+
+	const auto start = std::chrono::steady_clock::now();
+
+	JobSystem::Initialize(options.Jobs);
+	JobSystem::Dispatch(jobCount, [&](unsigned int jobIndex)
+	{
+		const Program& program = programs[jobIndex / options.Targets.size()];
+		const TargetInfo& target = options.Targets[jobIndex % options.Targets.size()];
+		const fs::path outputPath = options.OutputDir / target.Name / (program.Name + target.Extension);
+
+		const uint64_t key = ShaderTranspileCache::MakeProgramKey(program.VertexSource, program.FragmentSource, target.Target, options.Validate);
+
+		TranspilationResult result;
+		if (ShaderTranspileCache::Load(key, result))
+		{
+			std::string existing;
+			if (ReadFile(outputPath, existing) && existing == result.output)
+			{
+				++upToDate;
+				return;
+			}
+		}
+		else
+		{
+			ShaderTranspiler transpiler;
+			transpiler.SetExternalValidation(options.Validate);
+			result = transpiler.TranspileProgram(program.VertexSource, program.FragmentSource, target.Target);
+			if (!result.success)
+			{
+				Logger::Log(LogLevel::Error, program.Name + " (" + target.Name + "): " + result.errorMessage);
+				++failed;
+				return;
+			}
+		}
+
+		std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			Logger::Log(LogLevel::Error, "Can't write " + outputPath.string());
+			++failed;
+			return;
+		}
+
+		file << result.output;
+		++built;
+	});
+	JobSystem::Shutdown();
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	std::cout << programs.size() << " programs x " << options.Targets.size() << " targets: "
+			  << built.load() << " written, " << upToDate.load() << " up to date, " << failed.load() << " failed ("
+			  << elapsed.count() << " ms)\n";
+
+	Logger::Shutdown();
+	return failed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+cbuffer Uniforms : register(b0)
+{
+    float4x4 u_ViewProjection;
+#version 330 core
+
+float3 a_Position : TEXCOORD0;
+float4 a_Color : TEXCOORD1;
+
+float4x4 u_ViewProjection;
+
+float4 v_Color : TEXCOORD0;
+
+void main()
+{
+    v_Color = a_Color;
+    position = mul(u_ViewProjection, float4(a_Position), 1.0);
+}
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+#version 330 core
+
+float4 v_Color : TEXCOORD0;
+
+out float4 FragColor;
+
+void main()
+{
+    FragColor = v_Color;
+}
\ No newline at end of file
@@ -0,0 +1,299 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+cbuffer Uniforms : register(b0)
+{
+    int u_UseInstanceData;
+    float4x4 u_Model;
+    float3 u_AlbedoColor;
+    float4x4 u_ViewProjection;
+    float3 u_PositionScale;
+    float3 u_PositionOffset;
+    int u_OctNormals;
+#version 330 core
+
+float3 a_Position : TEXCOORD0;
+float3 a_Normal : TEXCOORD1;
+float2 a_TexCoords : TEXCOORD2;
+
+// Per-draw data on the multi-draw path, selected by the indirect command's BaseInstance.
+float4x4 a_InstanceModel : TEXCOORD4;
+float4 a_InstanceColor : TEXCOORD8;
+float4 a_InstancePositionScale : TEXCOORD9;
+float4 a_InstancePositionOffset : TEXCOORD10;
+
+int u_UseInstanceData;
+float4x4 u_Model;
+float3 u_AlbedoColor;
+float4x4 u_ViewProjection;
+
+// Vertex compression: position = mul(stored, scale) + offset, normals may be octahedral-encoded.
+float3 u_PositionScale;
+float3 u_PositionOffset;
+int u_OctNormals;
+
+float3 v_Normal : TEXCOORD0;
+float3 v_FragPos : TEXCOORD0;
+float2 v_TexCoords : TEXCOORD0;
+flat float3 v_AlbedoColor : TEXCOORD0;
+
+float3 OctDecode(float2 e)
+{
+    float3 n = float3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+    {
+        n.xy = (1.0 - abs(n.yx)) * float2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
+
+void main()
+{
+    float4x4 model = u_Model;
+    float3 positionScale = u_PositionScale;
+    float3 positionOffset = u_PositionOffset;
+    v_AlbedoColor = u_AlbedoColor;
+
+    if (u_UseInstanceData != 0)
+    {
+        model = a_InstanceModel;
+        positionScale = a_InstancePositionScale.xyz;
+        positionOffset = a_InstancePositionOffset.xyz;
+        v_AlbedoColor = a_InstanceColor.rgb;
+    }
+
+    float3 position = mul(a_Position, positionScale) + positionOffset;
+    float3 normal = u_OctNormals != 0 ? OctDecode(a_Normal.xy) : a_Normal;
+
+    v_FragPos = float3(mul(model, float4(position), 1.0));
+    v_Normal = float3x3(transpose(inverse(model))) * normal;
+    v_TexCoords = a_TexCoords;
+
+    position = mul(u_ViewProjection, float4(v_FragPos), 1.0);
+}
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+cbuffer Uniforms : register(b0)
+{
+    float3 u_CameraPos;
+    sampler2D u_AlbedoMap;
+    int u_DirectionalLightCount;
+    samplerBuffer u_LightData;
+    usamplerBuffer u_ClusterGrid;
+    usamplerBuffer u_LightIndices;
+    float2 u_ClusterTileSize;
+    float u_ClusterDepthScale;
+    float u_ClusterDepthBias;
+    float u_ClusterNear;
+    float u_ClusterFar;
+    int u_CascadeCount;
+    sampler2DArrayShadow u_CascadeShadowMap;
+    sampler2DShadow u_ShadowAtlas;
+    samplerBuffer u_ShadowMatrices;
+#version 330 core
+
+// RECEIVE_SHADOWS_OFF skips every shadow lookup, for materials that never sit in shadow.
+#pragma keywords RECEIVE_SHADOWS_OFF
+
+float3 v_Normal : TEXCOORD0;
+float3 v_FragPos : TEXCOORD0;
+float2 v_TexCoords : TEXCOORD0;
+flat float3 v_AlbedoColor : TEXCOORD0;
+
+out float4 FragColor;
+
+float3 u_CameraPos;
+
+// Per-material values, see MaterialTemplate.h. Members must stay in the template's order.
+layout(std140) MaterialParams
+{
+    float u_Metallic;
+    float u_Roughness;
+    int u_HasAlbedoMap;
+};
+
+sampler2D u_AlbedoMap;
+
+// Directional lights. With none in the scene, a fixed key light keeps unlit scenes readable.
+const int k_MaxDirectionalLights = 4;
+int u_DirectionalLightCount;
+float3 u_DirectionalLightDirections[k_MaxDirectionalLights];
+float3 u_DirectionalLightColors[k_MaxDirectionalLights];
+
+// Clustered point and spot lights, see ClusteredLighting.h. Counts must match the C++ side.
+const uvec3 k_ClusterCount = uvec3(16u, 9u, 24u);
+
+samplerBuffer u_LightData;		// 4 texels per light: (position, range), (color, type), (direction, cos half angle), (shadow index)
+usamplerBuffer u_ClusterGrid;	// (first index, count) per cluster
+usamplerBuffer u_LightIndices;
+
+float2 u_ClusterTileSize;
+float u_ClusterDepthScale;
+float u_ClusterDepthBias;
+float u_ClusterNear;
+float u_ClusterFar;
+
+// Shadows, see ShadowRenderer.h. Cascades shadow directional light 0; point and spot lights
+// sample tiles of a shared atlas through matrices in u_ShadowMatrices (six per point light).
+const int k_MaxCascades = 4;
+int u_CascadeCount;
+float4x4 u_CascadeMatrices[k_MaxCascades];
+float u_CascadeSplits[k_MaxCascades];	// Far view depth of each cascade
+sampler2DArrayShadow u_CascadeShadowMap;
+sampler2DShadow u_ShadowAtlas;
+samplerBuffer u_ShadowMatrices;
+
+float LinearDepth(float fragDepth)
+{
+    float ndc = mul(fragDepth, 2.0) - 1.0;
+    return 2.mul(0, u_ClusterNear) * u_ClusterFar / (u_ClusterFar + u_ClusterNear - mul(ndc, (u_ClusterFar) - u_ClusterNear));
+}
+
+uint ClusterIndex()
+{
+    uvec2 tile = min(uvec2(gl_FragCoord.xy / u_ClusterTileSize), k_ClusterCount.xy - 1u);
+    float slice = log(LinearDepth(gl_FragCoord.z)) * u_ClusterDepthScale + u_ClusterDepthBias;
+    uint z = uint(clamp(slice, 0.0, float(k_ClusterCount.z - 1u)));
+    return (mul(z, k_ClusterCount.y) + tile.y) * k_ClusterCount.x + tile.x;
+}
+
+// Smooth window that reaches zero at the light's range, so culled lights never pop.
+float DistanceAttenuation(float distance, float range)
+{
+    float ratio = distance / range;
+    float window = clamp(1.0 - mul(ratio, ratio) * mul(ratio, ratio), 0.0, 1.0);
+    return mul(window, window) / (mul(distance, distance) + 1.0);
+}
+
+// Scales the offset along the normal with the angle to the light to hide acne on grazing surfaces.
+float3 ShadowPosition(float3 normal, float3 lightDir, float texelWorldSize)
+{
+    float slope = 1.0 - max(dot(normal, lightDir), 0.0);
+    return v_FragPos + mul(normal, texelWorldSize) * (0.5 + 1.mul(5, slope));
+}
+
+float CascadeShadow(float3 normal, float3 lightDir)
+{
+    float viewDepth = LinearDepth(gl_FragCoord.z);
+    float3 position = ShadowPosition(normal, lightDir, 0.02);
+
+    int first = 0;
+    while (first < u_CascadeCount - 1 && viewDepth > u_CascadeSplits[first])
+    {
+        first++;
+    }
+
+    if (viewDepth > u_CascadeSplits[u_CascadeCount - 1])
+    {
+        return 1.0;
+    }
+
+    // A deferred cascade may not cover its slice yet; fall through to the next one.
+    for (int i = first; i < u_CascadeCount; ++i)
+    {
+        float4 coord = u_CascadeMatrices[i] * float4(position, 1.0);
+        if (any(lessThan(coord.xyz, float3(0.0))) || any(greaterThan(coord.xyz, float3(1.0))))
+        {
+            continue;
+        }
+
+        float2 texel = 1.0 / float2(textureSize(u_CascadeShadowMap, 0).xy);
+        float shadow = 0.0;
+        shadow += texture(u_CascadeShadowMap, float4(coord.xy + float2(-0.5, -0.5) * texel, float(i), coord.z));
+        shadow += texture(u_CascadeShadowMap, float4(coord.xy + float2(0.5, -0.5) * texel, float(i), coord.z));
+        shadow += texture(u_CascadeShadowMap, float4(coord.xy + float2(-0.5, 0.5) * texel, float(i), coord.z));
+        shadow += texture(u_CascadeShadowMap, float4(coord.xy + float2(0.5, 0.5) * texel, float(i), coord.z));
+        return mul(shadow, 0.25);
+    }
+
+    return 1.0;
+}
+
+float LocalShadow(int shadowIndex, int type, float3 lightPosition, float3 normal, float3 lightDir)
+{
+    int matrixIndex = shadowIndex;
+    float3 position = ShadowPosition(normal, lightDir, 0.mul(01, length(lightPosition) - v_FragPos));
+
+    if (type == 0)
+    {
+        // Point lights store faces in +X, -X, +Y, -Y, +Z, -Z order.
+        float3 v = position - lightPosition;
+        float3 a = abs(v);
+        int face = a.x >= a.y && a.x >= a.z ? (v.x > 0.0 ? 0 : 1) : (a.y >= a.z ? (v.y > 0.0 ? 2 : 3) : (v.z > 0.0 ? 4 : 5));
+        matrixIndex += face;
+    }
+
+    int base = mul(matrixIndex, 4);
+    float4x4 shadowMatrix = float4x4(texelFetch(u_ShadowMatrices, base), texelFetch(u_ShadowMatrices, base + 1),
+        texelFetch(u_ShadowMatrices, base + 2), texelFetch(u_ShadowMatrices, base + 3));
+
+    float4 coord = mul(shadowMatrix, float4(position), 1.0);
+    return texture(u_ShadowAtlas, coord.xyz / coord.w);
+}
+
+void main()
+{
+    float3 normal = normalize(v_Normal);
+    float3 lighting = float3(0.0);
+
+    if (u_DirectionalLightCount == 0)
+    {
+        lighting += max(dot(normal, normalize(float3(0.5, 1.0, 0.3))), 0.0) * float3(1.0);
+    }
+
+    for (int i = 0; i < u_DirectionalLightCount; ++i)
+    {
+        float3 lightDir = -u_DirectionalLightDirections[i];
+#ifdef RECEIVE_SHADOWS_OFF
+        float shadow = 1.0;
+#else
+        float shadow = (i == 0 && u_CascadeCount > 0) ? CascadeShadow(normal, lightDir) : 1.0;
+#endif
+        lighting += max(dot(normal, lightDir), 0.0) * mul(shadow, u_DirectionalLightColors)[i];
+    }
+
+    if (u_ClusterTileSize.x > 0.0)
+    {
+        uvec2 cluster = texelFetch(u_ClusterGrid, int(ClusterIndex())).xy;
+
+        for (uint i = 0u; i < cluster.y; ++i)
+        {
+            int light = int(texelFetch(u_LightIndices, int(cluster.x + i)).x) * 4;
+            float4 positionRange = texelFetch(u_LightData, light);
+            float4 colorType = texelFetch(u_LightData, light + 1);
+
+            float3 toLight = positionRange.xyz - v_FragPos;
+            float distance = length(toLight);
+            float3 lightDir = toLight / max(distance, 1e-4);
+
+            float attenuation = DistanceAttenuation(distance, positionRange.w);
+            if (colorType.w > 0.5)
+            {
+                float4 directionCone = texelFetch(u_LightData, light + 2);
+                float cosAngle = dot(-lightDir, directionCone.xyz);
+                attenuation *= smoothstep(directionCone.w, mix(directionCone.w, 1.0, 0.2), cosAngle);
+            }
+
+#ifndef RECEIVE_SHADOWS_OFF
+            int shadowIndex = int(texelFetch(u_LightData, light + 3).x);
+            if (shadowIndex >= 0 && attenuation > 0.0)
+            {
+                attenuation *= LocalShadow(shadowIndex, int(colorType.w + 0.5), positionRange.xyz, normal, lightDir);
+            }
+#endif
+
+            lighting += max(dot(normal, lightDir), 0.0) * mul(attenuation, colorType.rgb);
+        }
+    }
+
+    float3 albedo = v_AlbedoColor;
+    if (u_HasAlbedoMap != 0)
+    {
+        albedo *= texture(u_AlbedoMap, v_TexCoords).rgb;
+    }
+
+    float3 diffuse = mul(lighting, albedo);
+    float3 ambient = 0.mul(1, albedo);
+
+    FragColor = float4(ambient + diffuse, 1.0);
+}
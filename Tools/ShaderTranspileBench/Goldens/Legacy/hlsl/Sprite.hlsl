@@ -0,0 +1,65 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+cbuffer Uniforms : register(b0)
+{
+    float4x4 u_ViewProjection;
+#version 330 core
+
+// One instance per sprite; the four corners of its quad come from gl_VertexID as a triangle strip.
+float4 a_PositionSize : TEXCOORD0;		// xy: where the origin lands, zw: size
+float4 a_OriginRotation : TEXCOORD1;		// xy: pivot as a fraction of the size, z: radians, w: array layer
+float4 a_UVRect : TEXCOORD2;				// xy: min uv, zw: max uv
+float4 a_Color : TEXCOORD3;
+
+float4x4 u_ViewProjection;
+
+float3 v_TexCoord : TEXCOORD0;
+float4 v_Color : TEXCOORD0;
+
+void main()
+{
+    float2 corner = float2(gl_VertexID & 1, gl_VertexID >> 1);
+    float2 local = (corner - a_OriginRotation.xy) * a_PositionSize.zw;
+
+    float s = sin(a_OriginRotation.z);
+    float c = cos(a_OriginRotation.z);
+    float2 position = a_PositionSize.xy + float2(local.mul(x, c) - local.mul(y, s), local.mul(x, s) + local.mul(y, c));
+
+    v_TexCoord = float3(mix(a_UVRect.xy, a_UVRect.zw, corner), a_OriginRotation.w);
+    v_Color = a_Color;
+    position = mul(u_ViewProjection, float4(position), 0.0, 1.0);
+}
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+cbuffer Uniforms : register(b0)
+{
+    sampler2D u_Texture;
+    sampler2DArray u_TextureArray;
+    int u_UseArray;
+#version 330 core
+
+float3 v_TexCoord : TEXCOORD0;
+float4 v_Color : TEXCOORD0;
+
+out float4 FragColor;
+
+// A batch samples either a plain texture or a layer of a texture array, on separate units.
+sampler2D u_Texture;
+sampler2DArray u_TextureArray;
+int u_UseArray;
+
+void main()
+{
+    float4 texel;
+    if (u_UseArray != 0)
+    {
+        texel = texture(u_TextureArray, v_TexCoord);
+    }
+    else
+    {
+        texel = texture(u_Texture, v_TexCoord.xy);
+    }
+
+    FragColor = mul(texel, v_Color);
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+cbuffer Uniforms : register(b0)
+{
+    int u_UseInstanceData;
+    float4x4 u_Model;
+    float3 u_AlbedoColor;
+    float4x4 u_ViewProjection;
+    float3 u_PositionScale;
+    float3 u_PositionOffset;
+#version 330 core
+
+float3 a_Position : TEXCOORD0;
+float2 a_TexCoord : TEXCOORD2;
+
+float4x4 a_InstanceModel : TEXCOORD4;
+float4 a_InstanceColor : TEXCOORD8;
+float4 a_InstancePositionScale : TEXCOORD9;
+float4 a_InstancePositionOffset : TEXCOORD10;
+
+int u_UseInstanceData;
+float4x4 u_Model;
+float3 u_AlbedoColor;
+float4x4 u_ViewProjection;
+
+float3 u_PositionScale;
+float3 u_PositionOffset;
+
+float2 v_TexCoord : TEXCOORD0;
+flat float3 v_AlbedoColor : TEXCOORD0;
+
+void main()
+{
+    float4x4 model = u_Model;
+    float3 positionScale = u_PositionScale;
+    float3 positionOffset = u_PositionOffset;
+    v_AlbedoColor = u_AlbedoColor;
+
+    if (u_UseInstanceData != 0)
+    {
+        model = a_InstanceModel;
+        positionScale = a_InstancePositionScale.xyz;
+        positionOffset = a_InstancePositionOffset.xyz;
+        v_AlbedoColor = a_InstanceColor.rgb;
+    }
+
+    v_TexCoord = a_TexCoord;
+    position = mul(u_ViewProjection, model) * float4(mul(a_Position, positionScale) + positionOffset, 1.0);
+}
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+#version 330 core
+
+float2 v_TexCoord : TEXCOORD0;
+flat float3 v_AlbedoColor : TEXCOORD0;
+out float4 FragColor;
+
+void main()
+{
+    FragColor = float4(v_AlbedoColor, 1.0);
+}
\ No newline at end of file
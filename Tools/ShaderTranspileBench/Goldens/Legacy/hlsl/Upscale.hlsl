@@ -0,0 +1,57 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+#version 330 core
+
+// Fullscreen Quad: clip-space positions and matching texture coordinates.
+float2 a_Position : TEXCOORD0;
+float2 a_TexCoord : TEXCOORD1;
+
+float2 v_TexCoord : TEXCOORD0;
+
+void main()
+{
+    v_TexCoord = a_TexCoord;
+    position = float4(a_Position, 0.0, 1.0);
+}
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+cbuffer Uniforms : register(b0)
+{
+    sampler2D u_Source;
+    float2 u_SourceTexelSize;
+    float u_Sharpness;
+#version 330 core
+
+// Bilinear upscale of the dynamically scaled scene, with optional contrast-adaptive sharpening
+// to win back some of the detail lost to the lower render resolution.
+float2 v_TexCoord : TEXCOORD0;
+
+out float4 FragColor;
+
+sampler2D u_Source;
+float2 u_SourceTexelSize;
+float u_Sharpness;		// 0 disables sharpening
+
+void main()
+{
+    float3 center = texture(u_Source, v_TexCoord).rgb;
+
+    if (u_Sharpness > 0.0)
+    {
+        float3 north = texture(u_Source, v_TexCoord + float2(0.0, u_SourceTexelSize.y)).rgb;
+        float3 south = texture(u_Source, v_TexCoord - float2(0.0, u_SourceTexelSize.y)).rgb;
+        float3 east = texture(u_Source, v_TexCoord + float2(u_SourceTexelSize.x, 0.0)).rgb;
+        float3 west = texture(u_Source, v_TexCoord - float2(u_SourceTexelSize.x, 0.0)).rgb;
+
+        // Sharpen less where the neighbourhood already spans most of the range, to avoid halos.
+        float3 minimum = min(center, min(min(north, south), min(east, west)));
+        float3 maximum = max(center, max(max(north, south), max(east, west)));
+        float3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, float3(1e-4)), 0.0, 1.0));
+        float3 weight = -mul(amount, mix(0.125), 0.2, clamp(u_Sharpness, 0.0, 1.0));
+
+        center = clamp((center + (north + south + east + west) * weight) / (1.0 + 4.mul(0, weight)), 0.0, 1.0);
+    }
+
+    FragColor = float4(center, 1.0);
+}
\ No newline at end of file
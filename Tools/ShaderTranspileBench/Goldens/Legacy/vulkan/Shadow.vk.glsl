@@ -0,0 +1,44 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+
+layout(location = 4) in mat4 a_InstanceModel;
+layout(location = 9) in vec4 a_InstancePositionScale;
+layout(location = 10) in vec4 a_InstancePositionOffset;
+
+uniform int u_UseInstanceData;
+uniform mat4 u_Model;
+uniform mat4 u_ViewProjection;
+
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
+
+void main()
+{
+    mat4 model = u_Model;
+    vec3 positionScale = u_PositionScale;
+    vec3 positionOffset = u_PositionOffset;
+
+    if (u_UseInstanceData != 0)
+    {
+        model = a_InstanceModel;
+        positionScale = a_InstancePositionScale.xyz;
+        positionOffset = a_InstancePositionOffset.xyz;
+    }
+
+    gl_Position = u_ViewProjection * model * vec4(a_Position * positionScale + positionOffset, 1.0);
+}
+
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+#version 330 core
+
+// Depth-only pass for shadow maps; the rasterizer writes depth.
+void main()
+{
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+#version 330 core
+
+// One instance per sprite; the four corners of its quad come from gl_VertexID as a triangle strip.
+layout(location = 0) in vec4 a_PositionSize;		// xy: where the origin lands, zw: size
+layout(location = 1) in vec4 a_OriginRotation;		// xy: pivot as a fraction of the size, z: radians, w: array layer
+layout(location = 2) in vec4 a_UVRect;				// xy: min uv, zw: max uv
+layout(location = 3) in vec4 a_Color;
+
+uniform mat4 u_ViewProjection;
+
+out vec3 v_TexCoord;
+out vec4 v_Color;
+
+void main()
+{
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    vec2 local = (corner - a_OriginRotation.xy) * a_PositionSize.zw;
+
+    float s = sin(a_OriginRotation.z);
+    float c = cos(a_OriginRotation.z);
+    vec2 position = a_PositionSize.xy + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    v_TexCoord = vec3(mix(a_UVRect.xy, a_UVRect.zw, corner), a_OriginRotation.w);
+    v_Color = a_Color;
+    gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
+}
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+#version 330 core
+
+in vec3 v_TexCoord;
+in vec4 v_Color;
+
+out vec4 FragColor;
+
+// A batch samples either a plain texture or a layer of a texture array, on separate units.
+uniform sampler2D u_Texture;
+uniform sampler2DArray u_TextureArray;
+uniform int u_UseArray;
+
+void main()
+{
+    vec4 texel;
+    if (u_UseArray != 0)
+    {
+        texel = texture(u_TextureArray, v_TexCoord);
+    }
+    else
+    {
+        texel = texture(u_Texture, v_TexCoord.xy);
+    }
+
+    FragColor = texel * v_Color;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+#version 330 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 2) in vec2 a_TexCoord;
+
+layout(location = 4) in mat4 a_InstanceModel;
+layout(location = 8) in vec4 a_InstanceColor;
+layout(location = 9) in vec4 a_InstancePositionScale;
+layout(location = 10) in vec4 a_InstancePositionOffset;
+
+uniform int u_UseInstanceData;
+uniform mat4 u_Model;
+uniform vec3 u_AlbedoColor;
+uniform mat4 u_ViewProjection;
+
+uniform vec3 u_PositionScale;
+uniform vec3 u_PositionOffset;
+
+out vec2 v_TexCoord;
+flat out vec3 v_AlbedoColor;
+
+void main()
+{
+    mat4 model = u_Model;
+    vec3 positionScale = u_PositionScale;
+    vec3 positionOffset = u_PositionOffset;
+    v_AlbedoColor = u_AlbedoColor;
+
+    if (u_UseInstanceData != 0)
+    {
+        model = a_InstanceModel;
+        positionScale = a_InstancePositionScale.xyz;
+        positionOffset = a_InstancePositionOffset.xyz;
+        v_AlbedoColor = a_InstanceColor.rgb;
+    }
+
+    v_TexCoord = a_TexCoord;
+    gl_Position = u_ViewProjection * model * vec4(a_Position * positionScale + positionOffset, 1.0);
+}
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+#version 330 core
+
+in vec2 v_TexCoord;
+flat in vec3 v_AlbedoColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(v_AlbedoColor, 1.0);
+}
\ No newline at end of file
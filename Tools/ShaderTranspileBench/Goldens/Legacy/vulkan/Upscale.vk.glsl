@@ -0,0 +1,54 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+#version 330 core
+
+// Fullscreen Quad: clip-space positions and matching texture coordinates.
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+
+out vec2 v_TexCoord;
+
+void main()
+{
+    v_TexCoord = a_TexCoord;
+    gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+#version 330 core
+
+// Bilinear upscale of the dynamically scaled scene, with optional contrast-adaptive sharpening
+// to win back some of the detail lost to the lower render resolution.
+in vec2 v_TexCoord;
+
+out vec4 FragColor;
+
+uniform sampler2D u_Source;
+uniform vec2 u_SourceTexelSize;
+uniform float u_Sharpness;		// 0 disables sharpening
+
+void main()
+{
+    vec3 center = texture(u_Source, v_TexCoord).rgb;
+
+    if (u_Sharpness > 0.0)
+    {
+        vec3 north = texture(u_Source, v_TexCoord + vec2(0.0, u_SourceTexelSize.y)).rgb;
+        vec3 south = texture(u_Source, v_TexCoord - vec2(0.0, u_SourceTexelSize.y)).rgb;
+        vec3 east = texture(u_Source, v_TexCoord + vec2(u_SourceTexelSize.x, 0.0)).rgb;
+        vec3 west = texture(u_Source, v_TexCoord - vec2(u_SourceTexelSize.x, 0.0)).rgb;
+
+        // Sharpen less where the neighbourhood already spans most of the range, to avoid halos.
+        vec3 minimum = min(center, min(min(north, south), min(east, west)));
+        vec3 maximum = max(center, max(max(north, south), max(east, west)));
+        vec3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, vec3(1e-4)), 0.0, 1.0));
+        vec3 weight = -amount * mix(0.125, 0.2, clamp(u_Sharpness, 0.0, 1.0));
+
+        center = clamp((center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight), 0.0, 1.0);
+    }
+
+    FragColor = vec4(center, 1.0);
+}
\ No newline at end of file
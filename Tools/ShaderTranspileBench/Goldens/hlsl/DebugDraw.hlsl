@@ -0,0 +1,82 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+cbuffer Uniforms : register(b0)
+{
+	row_major float4x4 u_ViewProjection;
+};
+
+static float3 a_Position;
+static float4 a_Color;
+static float4 gl_Position;
+static float4 v_Color;
+
+void orca_main()
+{
+	v_Color = a_Color;
+	gl_Position = mul(float4(a_Position, 1.0), u_ViewProjection);
+}
+
+struct Orca_StageInput
+{
+	float3 a_Position : TEXCOORD0;
+	float4 a_Color : TEXCOORD1;
+};
+
+struct Orca_StageOutput
+{
+	float4 gl_Position : SV_Position;
+	float4 v_Color : v_Color;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	a_Position = stageInput.a_Position;
+	a_Color = stageInput.a_Color;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.gl_Position = gl_Position;
+	stageOutput.v_Color = v_Color;
+
+	// GL clip space depth is [-w, w], D3D expects [0, w].
+	stageOutput.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+	return stageOutput;
+}
+
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+static float4 gl_FragCoord;
+static float4 v_Color;
+static float4 FragColor;
+
+void orca_main()
+{
+	FragColor = v_Color;
+}
+
+struct Orca_StageInput
+{
+	float4 gl_FragCoord : SV_Position;
+	float4 v_Color : v_Color;
+};
+
+struct Orca_StageOutput
+{
+	float4 FragColor : SV_Target0;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	gl_FragCoord = stageInput.gl_FragCoord;
+	v_Color = stageInput.v_Color;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.FragColor = FragColor;
+	return stageOutput;
+}
@@ -0,0 +1,374 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+float2x2 orca_inverse(float2x2 m)
+{
+	float invDet = 1.0 / (m[0][0] * m[1][1] - m[0][1] * m[1][0]);
+	float2x2 r;
+	r[0][0] = m[1][1] * invDet;
+	r[0][1] = -m[0][1] * invDet;
+	r[1][0] = -m[1][0] * invDet;
+	r[1][1] = m[0][0] * invDet;
+	return r;
+}
+
+float3x3 orca_inverse(float3x3 m)
+{
+	float3x3 r;
+	r[0][0] = m[1][1] * m[2][2] - m[2][1] * m[1][2];
+	r[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+	r[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	r[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	r[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+	r[1][2] = m[1][0] * m[0][2] - m[0][0] * m[1][2];
+	r[2][0] = m[1][0] * m[2][1] - m[2][0] * m[1][1];
+	r[2][1] = m[2][0] * m[0][1] - m[0][0] * m[2][1];
+	r[2][2] = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	return r * (1.0 / (m[0][0] * r[0][0] + m[0][1] * r[1][0] + m[0][2] * r[2][0]));
+}
+
+float4x4 orca_inverse(float4x4 m)
+{
+	float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+	float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+	float invDet = 1.0 / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+	float4x4 r;
+	r[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * invDet;
+	r[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * invDet;
+	r[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * invDet;
+	r[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * invDet;
+	r[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * invDet;
+	r[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * invDet;
+	r[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * invDet;
+	r[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * invDet;
+	r[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * invDet;
+	r[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * invDet;
+	r[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * invDet;
+	r[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * invDet;
+	r[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * invDet;
+	r[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * invDet;
+	r[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * invDet;
+	r[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * invDet;
+	return r;
+}
+
+cbuffer Uniforms : register(b0)
+{
+	int u_UseInstanceData;
+	row_major float4x4 u_Model;
+	float3 u_AlbedoColor;
+	row_major float4x4 u_ViewProjection;
+	float3 u_PositionScale;
+	float3 u_PositionOffset;
+	int u_OctNormals;
+};
+
+static float3 a_Position;
+static float3 a_Normal;
+static float2 a_TexCoords;
+static float4x4 a_InstanceModel;
+static float4 a_InstanceColor;
+static float4 a_InstancePositionScale;
+static float4 a_InstancePositionOffset;
+static float4 gl_Position;
+static float3 v_Normal;
+static float3 v_FragPos;
+static float2 v_TexCoords;
+static float3 v_AlbedoColor;
+
+float3 OctDecode(float2 e)
+{
+	float3 n = float3(e, 1.0 - abs(e.x) - abs(e.y));
+	if (n.z < 0.0)
+	{
+		n.xy = (1.0 - abs(n.yx)) * float2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	}
+	return normalize(n);
+}
+
+void orca_main()
+{
+	float4x4 model = u_Model;
+	float3 positionScale = u_PositionScale;
+	float3 positionOffset = u_PositionOffset;
+	v_AlbedoColor = u_AlbedoColor;
+	if (u_UseInstanceData != 0)
+	{
+		model = a_InstanceModel;
+		positionScale = a_InstancePositionScale.xyz;
+		positionOffset = a_InstancePositionOffset.xyz;
+		v_AlbedoColor = a_InstanceColor.rgb;
+	}
+	float3 position = a_Position * positionScale + positionOffset;
+	float3 normal = u_OctNormals != 0 ? OctDecode(a_Normal.xy) : a_Normal;
+	v_FragPos = ((float3)(mul(float4(position, 1.0), model)));
+	v_Normal = mul(normal, ((float3x3)(transpose(orca_inverse(model)))));
+	v_TexCoords = a_TexCoords;
+	gl_Position = mul(float4(v_FragPos, 1.0), u_ViewProjection);
+}
+
+struct Orca_StageInput
+{
+	float3 a_Position : TEXCOORD0;
+	float3 a_Normal : TEXCOORD1;
+	float2 a_TexCoords : TEXCOORD2;
+	row_major float4x4 a_InstanceModel : TEXCOORD4;
+	float4 a_InstanceColor : TEXCOORD8;
+	float4 a_InstancePositionScale : TEXCOORD9;
+	float4 a_InstancePositionOffset : TEXCOORD10;
+};
+
+struct Orca_StageOutput
+{
+	float4 gl_Position : SV_Position;
+	float3 v_Normal : v_Normal;
+	float3 v_FragPos : v_FragPos;
+	float2 v_TexCoords : v_TexCoords;
+	nointerpolation float3 v_AlbedoColor : v_AlbedoColor;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	a_Position = stageInput.a_Position;
+	a_Normal = stageInput.a_Normal;
+	a_TexCoords = stageInput.a_TexCoords;
+	a_InstanceModel = stageInput.a_InstanceModel;
+	a_InstanceColor = stageInput.a_InstanceColor;
+	a_InstancePositionScale = stageInput.a_InstancePositionScale;
+	a_InstancePositionOffset = stageInput.a_InstancePositionOffset;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.gl_Position = gl_Position;
+	stageOutput.v_Normal = v_Normal;
+	stageOutput.v_FragPos = v_FragPos;
+	stageOutput.v_TexCoords = v_TexCoords;
+	stageOutput.v_AlbedoColor = v_AlbedoColor;
+
+	// GL clip space depth is [-w, w], D3D expects [0, w].
+	stageOutput.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+	return stageOutput;
+}
+
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+float orca_SampleShadow(Texture2D<float4> t, SamplerComparisonState s, float3 p) { return t.SampleCmpLevelZero(s, p.xy, p.z); }
+float orca_SampleShadow(Texture2DArray<float4> t, SamplerComparisonState s, float4 p) { return t.SampleCmpLevelZero(s, p.xyz, p.w); }
+float orca_SampleShadow(TextureCube<float4> t, SamplerComparisonState s, float4 p) { return t.SampleCmpLevelZero(s, p.xyz, p.w); }
+
+int3 orca_TextureSize(Texture2DArray<float4> t, int lod) { uint w, h, d, levels; t.GetDimensions(lod, w, h, d, levels); return int3(w, h, d); }
+
+#pragma keywords RECEIVE_SHADOWS_OFF
+static const int k_MaxDirectionalLights = 4;
+static const uint3 k_ClusterCount = uint3(16u, 9u, 24u);
+static const int k_MaxCascades = 4;
+
+cbuffer Uniforms : register(b0)
+{
+	float3 u_CameraPos;
+	float u_Metallic;
+	float u_Roughness;
+	int u_HasAlbedoMap;
+	int u_DirectionalLightCount;
+	float3 u_DirectionalLightDirections[k_MaxDirectionalLights];
+	float3 u_DirectionalLightColors[k_MaxDirectionalLights];
+	float2 u_ClusterTileSize;
+	float u_ClusterDepthScale;
+	float u_ClusterDepthBias;
+	float u_ClusterNear;
+	float u_ClusterFar;
+	int u_CascadeCount;
+	row_major float4x4 u_CascadeMatrices[k_MaxCascades];
+	float u_CascadeSplits[k_MaxCascades];
+};
+
+Texture2D<float4> u_AlbedoMap : register(t0);
+SamplerState u_AlbedoMap_Sampler : register(s0);
+Buffer<float4> u_LightData : register(t1);
+Buffer<uint4> u_ClusterGrid : register(t2);
+Buffer<uint4> u_LightIndices : register(t3);
+Texture2DArray<float4> u_CascadeShadowMap : register(t4);
+SamplerComparisonState u_CascadeShadowMap_Sampler : register(s1);
+Texture2D<float4> u_ShadowAtlas : register(t5);
+SamplerComparisonState u_ShadowAtlas_Sampler : register(s2);
+Buffer<float4> u_ShadowMatrices : register(t6);
+
+static float4 gl_FragCoord;
+static float3 v_Normal;
+static float3 v_FragPos;
+static float2 v_TexCoords;
+static float3 v_AlbedoColor;
+static float4 FragColor;
+
+float LinearDepth(float fragDepth)
+{
+	float ndc = fragDepth * 2.0 - 1.0;
+	return 2.0 * u_ClusterNear * u_ClusterFar / (u_ClusterFar + u_ClusterNear - ndc * (u_ClusterFar - u_ClusterNear));
+}
+
+uint ClusterIndex()
+{
+	uint2 tile = min(uint2(gl_FragCoord.xy / u_ClusterTileSize), k_ClusterCount.xy - 1u);
+	float slice = log(LinearDepth(gl_FragCoord.z)) * u_ClusterDepthScale + u_ClusterDepthBias;
+	uint z = uint(clamp(slice, 0.0, float(k_ClusterCount.z - 1u)));
+	return (z * k_ClusterCount.y + tile.y) * k_ClusterCount.x + tile.x;
+}
+
+float DistanceAttenuation(float distance, float range)
+{
+	float ratio = distance / range;
+	float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+	return window * window / (distance * distance + 1.0);
+}
+
+float3 ShadowPosition(float3 normal, float3 lightDir, float texelWorldSize)
+{
+	float slope = 1.0 - max(dot(normal, lightDir), 0.0);
+	return v_FragPos + normal * texelWorldSize * (0.5 + 1.5 * slope);
+}
+
+float CascadeShadow(float3 normal, float3 lightDir)
+{
+	float viewDepth = LinearDepth(gl_FragCoord.z);
+	float3 position = ShadowPosition(normal, lightDir, 0.02);
+	int first = 0;
+	while (first < u_CascadeCount - 1 && viewDepth > u_CascadeSplits[first])
+	{
+		first++;
+	}
+	if (viewDepth > u_CascadeSplits[u_CascadeCount - 1])
+	{
+		return 1.0;
+	}
+	for (int i = first; i < u_CascadeCount; ++i)
+	{
+		float4 coord = mul(float4(position, 1.0), u_CascadeMatrices[i]);
+		if (any((coord.xyz < ((float3)(0.0)))) || any((coord.xyz > ((float3)(1.0)))))
+		{
+			continue;
+		}
+		float2 texel = 1.0 / float2(orca_TextureSize(u_CascadeShadowMap, 0).xy);
+		float shadow = 0.0;
+		shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(-0.5, -0.5) * texel, float(i), coord.z));
+		shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(0.5, -0.5) * texel, float(i), coord.z));
+		shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(-0.5, 0.5) * texel, float(i), coord.z));
+		shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(0.5, 0.5) * texel, float(i), coord.z));
+		return shadow * 0.25;
+	}
+	return 1.0;
+}
+
+float LocalShadow(int shadowIndex, int type, float3 lightPosition, float3 normal, float3 lightDir)
+{
+	int matrixIndex = shadowIndex;
+	float3 position = ShadowPosition(normal, lightDir, 0.01 * length(lightPosition - v_FragPos));
+	if (type == 0)
+	{
+		float3 v = position - lightPosition;
+		float3 a = abs(v);
+		int face = a.x >= a.y && a.x >= a.z ? (v.x > 0.0 ? 0 : 1) : (a.y >= a.z ? (v.y > 0.0 ? 2 : 3) : (v.z > 0.0 ? 4 : 5));
+		matrixIndex += face;
+	}
+	int base = matrixIndex * 4;
+	float4x4 shadowMatrix = float4x4(u_ShadowMatrices.Load(base), u_ShadowMatrices.Load(base + 1), u_ShadowMatrices.Load(base + 2), u_ShadowMatrices.Load(base + 3));
+	float4 coord = mul(float4(position, 1.0), shadowMatrix);
+	return orca_SampleShadow(u_ShadowAtlas, u_ShadowAtlas_Sampler, coord.xyz / coord.w);
+}
+
+void orca_main()
+{
+	float3 normal = normalize(v_Normal);
+	float3 lighting = ((float3)(0.0));
+	if (u_DirectionalLightCount == 0)
+	{
+		lighting += max(dot(normal, normalize(float3(0.5, 1.0, 0.3))), 0.0) * ((float3)(1.0));
+	}
+	for (int i = 0; i < u_DirectionalLightCount; ++i)
+	{
+		float3 lightDir = -u_DirectionalLightDirections[i];
+#ifdef RECEIVE_SHADOWS_OFF
+		float shadow = 1.0;
+#else
+		float shadow = (i == 0 && u_CascadeCount > 0) ? CascadeShadow(normal, lightDir) : 1.0;
+#endif
+		lighting += max(dot(normal, lightDir), 0.0) * shadow * u_DirectionalLightColors[i];
+	}
+	if (u_ClusterTileSize.x > 0.0)
+	{
+		uint2 cluster = u_ClusterGrid.Load(int(ClusterIndex())).xy;
+		for (uint i = 0u; i < cluster.y; ++i)
+		{
+			int light = int(u_LightIndices.Load(int(cluster.x + i)).x) * 4;
+			float4 positionRange = u_LightData.Load(light);
+			float4 colorType = u_LightData.Load(light + 1);
+			float3 toLight = positionRange.xyz - v_FragPos;
+			float distance = length(toLight);
+			float3 lightDir = toLight / max(distance, 1e-4);
+			float attenuation = DistanceAttenuation(distance, positionRange.w);
+			if (colorType.w > 0.5)
+			{
+				float4 directionCone = u_LightData.Load(light + 2);
+				float cosAngle = dot(-lightDir, directionCone.xyz);
+				attenuation *= smoothstep(directionCone.w, lerp(directionCone.w, 1.0, 0.2), cosAngle);
+			}
+#ifndef RECEIVE_SHADOWS_OFF
+			int shadowIndex = int(u_LightData.Load(light + 3).x);
+			if (shadowIndex >= 0 && attenuation > 0.0)
+			{
+				attenuation *= LocalShadow(shadowIndex, int(colorType.w + 0.5), positionRange.xyz, normal, lightDir);
+			}
+#endif
+			lighting += max(dot(normal, lightDir), 0.0) * attenuation * colorType.rgb;
+		}
+	}
+	float3 albedo = v_AlbedoColor;
+	if (u_HasAlbedoMap != 0)
+	{
+		albedo *= u_AlbedoMap.Sample(u_AlbedoMap_Sampler, v_TexCoords).rgb;
+	}
+	float3 diffuse = lighting * albedo;
+	float3 ambient = 0.1 * albedo;
+	FragColor = float4(ambient + diffuse, 1.0);
+}
+
+struct Orca_StageInput
+{
+	float4 gl_FragCoord : SV_Position;
+	float3 v_Normal : v_Normal;
+	float3 v_FragPos : v_FragPos;
+	float2 v_TexCoords : v_TexCoords;
+	nointerpolation float3 v_AlbedoColor : v_AlbedoColor;
+};
+
+struct Orca_StageOutput
+{
+	float4 FragColor : SV_Target0;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	gl_FragCoord = stageInput.gl_FragCoord;
+	v_Normal = stageInput.v_Normal;
+	v_FragPos = stageInput.v_FragPos;
+	v_TexCoords = stageInput.v_TexCoords;
+	v_AlbedoColor = stageInput.v_AlbedoColor;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.FragColor = FragColor;
+	return stageOutput;
+}
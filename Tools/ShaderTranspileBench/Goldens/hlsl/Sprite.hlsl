@@ -0,0 +1,122 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+cbuffer Uniforms : register(b0)
+{
+	row_major float4x4 u_ViewProjection;
+};
+
+static float4 a_PositionSize;
+static float4 a_OriginRotation;
+static float4 a_UVRect;
+static float4 a_Color;
+static int gl_VertexID;
+static float4 gl_Position;
+static float3 v_TexCoord;
+static float4 v_Color;
+
+void orca_main()
+{
+	float2 corner = float2(gl_VertexID & 1, gl_VertexID >> 1);
+	float2 local = (corner - a_OriginRotation.xy) * a_PositionSize.zw;
+	float s = sin(a_OriginRotation.z);
+	float c = cos(a_OriginRotation.z);
+	float2 position = a_PositionSize.xy + float2(local.x * c - local.y * s, local.x * s + local.y * c);
+	v_TexCoord = float3(lerp(a_UVRect.xy, a_UVRect.zw, corner), a_OriginRotation.w);
+	v_Color = a_Color;
+	gl_Position = mul(float4(position, 0.0, 1.0), u_ViewProjection);
+}
+
+struct Orca_StageInput
+{
+	float4 a_PositionSize : TEXCOORD0;
+	float4 a_OriginRotation : TEXCOORD1;
+	float4 a_UVRect : TEXCOORD2;
+	float4 a_Color : TEXCOORD3;
+	uint gl_VertexID : SV_VertexID;
+};
+
+struct Orca_StageOutput
+{
+	float4 gl_Position : SV_Position;
+	float3 v_TexCoord : v_TexCoord;
+	float4 v_Color : v_Color;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	a_PositionSize = stageInput.a_PositionSize;
+	a_OriginRotation = stageInput.a_OriginRotation;
+	a_UVRect = stageInput.a_UVRect;
+	a_Color = stageInput.a_Color;
+	gl_VertexID = stageInput.gl_VertexID;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.gl_Position = gl_Position;
+	stageOutput.v_TexCoord = v_TexCoord;
+	stageOutput.v_Color = v_Color;
+
+	// GL clip space depth is [-w, w], D3D expects [0, w].
+	stageOutput.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+	return stageOutput;
+}
+
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+cbuffer Uniforms : register(b0)
+{
+	int u_UseArray;
+};
+
+Texture2D<float4> u_Texture : register(t0);
+SamplerState u_Texture_Sampler : register(s0);
+Texture2DArray<float4> u_TextureArray : register(t1);
+SamplerState u_TextureArray_Sampler : register(s1);
+
+static float4 gl_FragCoord;
+static float3 v_TexCoord;
+static float4 v_Color;
+static float4 FragColor;
+
+void orca_main()
+{
+	float4 texel;
+	if (u_UseArray != 0)
+	{
+		texel = u_TextureArray.Sample(u_TextureArray_Sampler, v_TexCoord);
+	}
+	else
+	{
+		texel = u_Texture.Sample(u_Texture_Sampler, v_TexCoord.xy);
+	}
+	FragColor = texel * v_Color;
+}
+
+struct Orca_StageInput
+{
+	float4 gl_FragCoord : SV_Position;
+	float3 v_TexCoord : v_TexCoord;
+	float4 v_Color : v_Color;
+};
+
+struct Orca_StageOutput
+{
+	float4 FragColor : SV_Target0;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	gl_FragCoord = stageInput.gl_FragCoord;
+	v_TexCoord = stageInput.v_TexCoord;
+	v_Color = stageInput.v_Color;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.FragColor = FragColor;
+	return stageOutput;
+}
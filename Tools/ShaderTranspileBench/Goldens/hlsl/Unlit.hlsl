@@ -0,0 +1,116 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+cbuffer Uniforms : register(b0)
+{
+	int u_UseInstanceData;
+	row_major float4x4 u_Model;
+	float3 u_AlbedoColor;
+	row_major float4x4 u_ViewProjection;
+	float3 u_PositionScale;
+	float3 u_PositionOffset;
+};
+
+static float3 a_Position;
+static float2 a_TexCoord;
+static float4x4 a_InstanceModel;
+static float4 a_InstanceColor;
+static float4 a_InstancePositionScale;
+static float4 a_InstancePositionOffset;
+static float4 gl_Position;
+static float2 v_TexCoord;
+static float3 v_AlbedoColor;
+
+void orca_main()
+{
+	float4x4 model = u_Model;
+	float3 positionScale = u_PositionScale;
+	float3 positionOffset = u_PositionOffset;
+	v_AlbedoColor = u_AlbedoColor;
+	if (u_UseInstanceData != 0)
+	{
+		model = a_InstanceModel;
+		positionScale = a_InstancePositionScale.xyz;
+		positionOffset = a_InstancePositionOffset.xyz;
+		v_AlbedoColor = a_InstanceColor.rgb;
+	}
+	v_TexCoord = a_TexCoord;
+	gl_Position = mul(float4(a_Position * positionScale + positionOffset, 1.0), mul(model, u_ViewProjection));
+}
+
+struct Orca_StageInput
+{
+	float3 a_Position : TEXCOORD0;
+	float2 a_TexCoord : TEXCOORD2;
+	row_major float4x4 a_InstanceModel : TEXCOORD4;
+	float4 a_InstanceColor : TEXCOORD8;
+	float4 a_InstancePositionScale : TEXCOORD9;
+	float4 a_InstancePositionOffset : TEXCOORD10;
+};
+
+struct Orca_StageOutput
+{
+	float4 gl_Position : SV_Position;
+	float2 v_TexCoord : v_TexCoord;
+	nointerpolation float3 v_AlbedoColor : v_AlbedoColor;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	a_Position = stageInput.a_Position;
+	a_TexCoord = stageInput.a_TexCoord;
+	a_InstanceModel = stageInput.a_InstanceModel;
+	a_InstanceColor = stageInput.a_InstanceColor;
+	a_InstancePositionScale = stageInput.a_InstancePositionScale;
+	a_InstancePositionOffset = stageInput.a_InstancePositionOffset;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.gl_Position = gl_Position;
+	stageOutput.v_TexCoord = v_TexCoord;
+	stageOutput.v_AlbedoColor = v_AlbedoColor;
+
+	// GL clip space depth is [-w, w], D3D expects [0, w].
+	stageOutput.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+	return stageOutput;
+}
+
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+static float4 gl_FragCoord;
+static float2 v_TexCoord;
+static float3 v_AlbedoColor;
+static float4 FragColor;
+
+void orca_main()
+{
+	FragColor = float4(v_AlbedoColor, 1.0);
+}
+
+struct Orca_StageInput
+{
+	float4 gl_FragCoord : SV_Position;
+	float2 v_TexCoord : v_TexCoord;
+	nointerpolation float3 v_AlbedoColor : v_AlbedoColor;
+};
+
+struct Orca_StageOutput
+{
+	float4 FragColor : SV_Target0;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	gl_FragCoord = stageInput.gl_FragCoord;
+	v_TexCoord = stageInput.v_TexCoord;
+	v_AlbedoColor = stageInput.v_AlbedoColor;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.FragColor = FragColor;
+	return stageOutput;
+}
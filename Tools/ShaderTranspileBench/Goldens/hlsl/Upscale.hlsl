@@ -0,0 +1,99 @@
+// === VERTEX SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+static float2 a_Position;
+static float2 a_TexCoord;
+static float4 gl_Position;
+static float2 v_TexCoord;
+
+void orca_main()
+{
+	v_TexCoord = a_TexCoord;
+	gl_Position = float4(a_Position, 0.0, 1.0);
+}
+
+struct Orca_StageInput
+{
+	float2 a_Position : TEXCOORD0;
+	float2 a_TexCoord : TEXCOORD1;
+};
+
+struct Orca_StageOutput
+{
+	float4 gl_Position : SV_Position;
+	float2 v_TexCoord : v_TexCoord;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	a_Position = stageInput.a_Position;
+	a_TexCoord = stageInput.a_TexCoord;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.gl_Position = gl_Position;
+	stageOutput.v_TexCoord = v_TexCoord;
+
+	// GL clip space depth is [-w, w], D3D expects [0, w].
+	stageOutput.gl_Position.z = (gl_Position.z + gl_Position.w) * 0.5;
+	return stageOutput;
+}
+
+
+// === FRAGMENT SHADER ===
+// HLSL Shader (Target: Direct3D 11)
+
+cbuffer Uniforms : register(b0)
+{
+	float2 u_SourceTexelSize;
+	float u_Sharpness;
+};
+
+Texture2D<float4> u_Source : register(t0);
+SamplerState u_Source_Sampler : register(s0);
+
+static float4 gl_FragCoord;
+static float2 v_TexCoord;
+static float4 FragColor;
+
+void orca_main()
+{
+	float3 center = u_Source.Sample(u_Source_Sampler, v_TexCoord).rgb;
+	if (u_Sharpness > 0.0)
+	{
+		float3 north = u_Source.Sample(u_Source_Sampler, v_TexCoord + float2(0.0, u_SourceTexelSize.y)).rgb;
+		float3 south = u_Source.Sample(u_Source_Sampler, v_TexCoord - float2(0.0, u_SourceTexelSize.y)).rgb;
+		float3 east = u_Source.Sample(u_Source_Sampler, v_TexCoord + float2(u_SourceTexelSize.x, 0.0)).rgb;
+		float3 west = u_Source.Sample(u_Source_Sampler, v_TexCoord - float2(u_SourceTexelSize.x, 0.0)).rgb;
+		float3 minimum = min(center, min(min(north, south), min(east, west)));
+		float3 maximum = max(center, max(max(north, south), max(east, west)));
+		float3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, ((float3)(1e-4))), 0.0, 1.0));
+		float3 weight = -amount * lerp(0.125, 0.2, clamp(u_Sharpness, 0.0, 1.0));
+		center = clamp((center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight), 0.0, 1.0);
+	}
+	FragColor = float4(center, 1.0);
+}
+
+struct Orca_StageInput
+{
+	float4 gl_FragCoord : SV_Position;
+	float2 v_TexCoord : v_TexCoord;
+};
+
+struct Orca_StageOutput
+{
+	float4 FragColor : SV_Target0;
+};
+
+Orca_StageOutput main(Orca_StageInput stageInput)
+{
+	gl_FragCoord = stageInput.gl_FragCoord;
+	v_TexCoord = stageInput.v_TexCoord;
+
+	orca_main();
+
+	Orca_StageOutput stageOutput;
+	stageOutput.FragColor = FragColor;
+	return stageOutput;
+}
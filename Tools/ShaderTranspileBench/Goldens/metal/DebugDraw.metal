@@ -0,0 +1,98 @@
+// === VERTEX SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+struct Orca_Uniforms
+{
+	float4x4 u_ViewProjection;
+};
+
+struct Orca_Shader
+{
+	constant Orca_Uniforms* uniforms;
+	float3 a_Position;
+	float4 a_Color;
+	float4 gl_Position;
+	float4 v_Color;
+
+	void orca_main()
+	{
+		v_Color = a_Color;
+		gl_Position = uniforms->u_ViewProjection * float4(a_Position, 1.0);
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float3 a_Position [[attribute(0)]];
+	float4 a_Color [[attribute(1)]];
+};
+
+struct Orca_StageOut
+{
+	float4 gl_Position [[position]];
+	float4 v_Color [[user(v_Color)]];
+};
+
+vertex Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]], constant Orca_Uniforms& uniforms [[buffer(16)]])
+{
+	Orca_Shader shader;
+	shader.uniforms = &uniforms;
+	shader.a_Position = stageIn.a_Position;
+	shader.a_Color = stageIn.a_Color;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.gl_Position = shader.gl_Position;
+	stageOut.v_Color = shader.v_Color;
+
+	// GL clip space depth is [-w, w], Metal expects [0, w].
+	stageOut.gl_Position.z = (stageOut.gl_Position.z + stageOut.gl_Position.w) * 0.5;
+	return stageOut;
+}
+
+
+// === FRAGMENT SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+struct Orca_Shader
+{
+	float4 gl_FragCoord;
+	float4 v_Color;
+	float4 FragColor;
+
+	void orca_main()
+	{
+		FragColor = v_Color;
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float4 gl_FragCoord [[position]];
+	float4 v_Color [[user(v_Color)]];
+};
+
+struct Orca_StageOut
+{
+	float4 FragColor [[color(0)]];
+};
+
+fragment Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]])
+{
+	Orca_Shader shader;
+	shader.gl_FragCoord = stageIn.gl_FragCoord;
+	shader.v_Color = stageIn.v_Color;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.FragColor = shader.FragColor;
+	return stageOut;
+}
@@ -0,0 +1,406 @@
+// === VERTEX SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+float2x2 orca_inverse(float2x2 m)
+{
+	float invDet = 1.0 / (m[0][0] * m[1][1] - m[0][1] * m[1][0]);
+	float2x2 r;
+	r[0][0] = m[1][1] * invDet;
+	r[0][1] = -m[0][1] * invDet;
+	r[1][0] = -m[1][0] * invDet;
+	r[1][1] = m[0][0] * invDet;
+	return r;
+}
+
+float3x3 orca_inverse(float3x3 m)
+{
+	float3x3 r;
+	r[0][0] = m[1][1] * m[2][2] - m[2][1] * m[1][2];
+	r[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+	r[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+	r[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+	r[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+	r[1][2] = m[1][0] * m[0][2] - m[0][0] * m[1][2];
+	r[2][0] = m[1][0] * m[2][1] - m[2][0] * m[1][1];
+	r[2][1] = m[2][0] * m[0][1] - m[0][0] * m[2][1];
+	r[2][2] = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	return r * (1.0 / (m[0][0] * r[0][0] + m[0][1] * r[1][0] + m[0][2] * r[2][0]));
+}
+
+float4x4 orca_inverse(float4x4 m)
+{
+	float s0 = m[0][0] * m[1][1] - m[1][0] * m[0][1];
+	float s1 = m[0][0] * m[1][2] - m[1][0] * m[0][2];
+	float s2 = m[0][0] * m[1][3] - m[1][0] * m[0][3];
+	float s3 = m[0][1] * m[1][2] - m[1][1] * m[0][2];
+	float s4 = m[0][1] * m[1][3] - m[1][1] * m[0][3];
+	float s5 = m[0][2] * m[1][3] - m[1][2] * m[0][3];
+	float c5 = m[2][2] * m[3][3] - m[3][2] * m[2][3];
+	float c4 = m[2][1] * m[3][3] - m[3][1] * m[2][3];
+	float c3 = m[2][1] * m[3][2] - m[3][1] * m[2][2];
+	float c2 = m[2][0] * m[3][3] - m[3][0] * m[2][3];
+	float c1 = m[2][0] * m[3][2] - m[3][0] * m[2][2];
+	float c0 = m[2][0] * m[3][1] - m[3][0] * m[2][1];
+	float invDet = 1.0 / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+	float4x4 r;
+	r[0][0] = (m[1][1] * c5 - m[1][2] * c4 + m[1][3] * c3) * invDet;
+	r[0][1] = (-m[0][1] * c5 + m[0][2] * c4 - m[0][3] * c3) * invDet;
+	r[0][2] = (m[3][1] * s5 - m[3][2] * s4 + m[3][3] * s3) * invDet;
+	r[0][3] = (-m[2][1] * s5 + m[2][2] * s4 - m[2][3] * s3) * invDet;
+	r[1][0] = (-m[1][0] * c5 + m[1][2] * c2 - m[1][3] * c1) * invDet;
+	r[1][1] = (m[0][0] * c5 - m[0][2] * c2 + m[0][3] * c1) * invDet;
+	r[1][2] = (-m[3][0] * s5 + m[3][2] * s2 - m[3][3] * s1) * invDet;
+	r[1][3] = (m[2][0] * s5 - m[2][2] * s2 + m[2][3] * s1) * invDet;
+	r[2][0] = (m[1][0] * c4 - m[1][1] * c2 + m[1][3] * c0) * invDet;
+	r[2][1] = (-m[0][0] * c4 + m[0][1] * c2 - m[0][3] * c0) * invDet;
+	r[2][2] = (m[3][0] * s4 - m[3][1] * s2 + m[3][3] * s0) * invDet;
+	r[2][3] = (-m[2][0] * s4 + m[2][1] * s2 - m[2][3] * s0) * invDet;
+	r[3][0] = (-m[1][0] * c3 + m[1][1] * c1 - m[1][2] * c0) * invDet;
+	r[3][1] = (m[0][0] * c3 - m[0][1] * c1 + m[0][2] * c0) * invDet;
+	r[3][2] = (-m[3][0] * s3 + m[3][1] * s1 - m[3][2] * s0) * invDet;
+	r[3][3] = (m[2][0] * s3 - m[2][1] * s1 + m[2][2] * s0) * invDet;
+	return r;
+}
+
+float3x3 orca_float3x3(float4x4 m) { return float3x3(m[0].xyz, m[1].xyz, m[2].xyz); }
+float2x2 orca_float2x2(float4x4 m) { return float2x2(m[0].xy, m[1].xy); }
+float2x2 orca_float2x2(float3x3 m) { return float2x2(m[0].xy, m[1].xy); }
+
+struct Orca_Uniforms
+{
+	int u_UseInstanceData;
+	float4x4 u_Model;
+	float3 u_AlbedoColor;
+	float4x4 u_ViewProjection;
+	float3 u_PositionScale;
+	float3 u_PositionOffset;
+	int u_OctNormals;
+};
+
+struct Orca_Shader
+{
+	constant Orca_Uniforms* uniforms;
+	float3 a_Position;
+	float3 a_Normal;
+	float2 a_TexCoords;
+	float4x4 a_InstanceModel;
+	float4 a_InstanceColor;
+	float4 a_InstancePositionScale;
+	float4 a_InstancePositionOffset;
+	float4 gl_Position;
+	float3 v_Normal;
+	float3 v_FragPos;
+	float2 v_TexCoords;
+	float3 v_AlbedoColor;
+
+	float3 OctDecode(float2 e)
+	{
+		float3 n = float3(e, 1.0 - abs(e.x) - abs(e.y));
+		if (n.z < 0.0)
+		{
+			n.xy = (1.0 - abs(n.yx)) * float2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+		}
+		return normalize(n);
+	}
+
+	void orca_main()
+	{
+		float4x4 model = uniforms->u_Model;
+		float3 positionScale = uniforms->u_PositionScale;
+		float3 positionOffset = uniforms->u_PositionOffset;
+		v_AlbedoColor = uniforms->u_AlbedoColor;
+		if (uniforms->u_UseInstanceData != 0)
+		{
+			model = a_InstanceModel;
+			positionScale = a_InstancePositionScale.xyz;
+			positionOffset = a_InstancePositionOffset.xyz;
+			v_AlbedoColor = a_InstanceColor.rgb;
+		}
+		float3 position = a_Position * positionScale + positionOffset;
+		float3 normal = uniforms->u_OctNormals != 0 ? OctDecode(a_Normal.xy) : a_Normal;
+		v_FragPos = float3((model * float4(position, 1.0)).xyz);
+		v_Normal = orca_float3x3(transpose(orca_inverse(model))) * normal;
+		v_TexCoords = a_TexCoords;
+		gl_Position = uniforms->u_ViewProjection * float4(v_FragPos, 1.0);
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float3 a_Position [[attribute(0)]];
+	float3 a_Normal [[attribute(1)]];
+	float2 a_TexCoords [[attribute(2)]];
+	float4 a_InstanceModel_0 [[attribute(4)]];
+	float4 a_InstanceModel_1 [[attribute(5)]];
+	float4 a_InstanceModel_2 [[attribute(6)]];
+	float4 a_InstanceModel_3 [[attribute(7)]];
+	float4 a_InstanceColor [[attribute(8)]];
+	float4 a_InstancePositionScale [[attribute(9)]];
+	float4 a_InstancePositionOffset [[attribute(10)]];
+};
+
+struct Orca_StageOut
+{
+	float4 gl_Position [[position]];
+	float3 v_Normal [[user(v_Normal)]];
+	float3 v_FragPos [[user(v_FragPos)]];
+	float2 v_TexCoords [[user(v_TexCoords)]];
+	float3 v_AlbedoColor [[user(v_AlbedoColor)]];
+};
+
+vertex Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]], constant Orca_Uniforms& uniforms [[buffer(16)]])
+{
+	Orca_Shader shader;
+	shader.uniforms = &uniforms;
+	shader.a_Position = stageIn.a_Position;
+	shader.a_Normal = stageIn.a_Normal;
+	shader.a_TexCoords = stageIn.a_TexCoords;
+	shader.a_InstanceModel = float4x4(stageIn.a_InstanceModel_0, stageIn.a_InstanceModel_1, stageIn.a_InstanceModel_2, stageIn.a_InstanceModel_3);
+	shader.a_InstanceColor = stageIn.a_InstanceColor;
+	shader.a_InstancePositionScale = stageIn.a_InstancePositionScale;
+	shader.a_InstancePositionOffset = stageIn.a_InstancePositionOffset;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.gl_Position = shader.gl_Position;
+	stageOut.v_Normal = shader.v_Normal;
+	stageOut.v_FragPos = shader.v_FragPos;
+	stageOut.v_TexCoords = shader.v_TexCoords;
+	stageOut.v_AlbedoColor = shader.v_AlbedoColor;
+
+	// GL clip space depth is [-w, w], Metal expects [0, w].
+	stageOut.gl_Position.z = (stageOut.gl_Position.z + stageOut.gl_Position.w) * 0.5;
+	return stageOut;
+}
+
+
+// === FRAGMENT SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+float orca_SampleShadow(depth2d<float> t, sampler s, float3 p) { return t.sample_compare(s, p.xy, p.z); }
+float orca_SampleShadow(depth2d_array<float> t, sampler s, float4 p) { return t.sample_compare(s, p.xy, uint(rint(p.z)), p.w); }
+float orca_SampleShadow(depthcube<float> t, sampler s, float4 p) { return t.sample_compare(s, p.xyz, p.w); }
+
+#pragma keywords RECEIVE_SHADOWS_OFF
+constant int k_MaxDirectionalLights = 4;
+constant uint3 k_ClusterCount = uint3(16u, 9u, 24u);
+constant int k_MaxCascades = 4;
+
+struct Orca_Uniforms
+{
+	float3 u_CameraPos;
+	float u_Metallic;
+	float u_Roughness;
+	int u_HasAlbedoMap;
+	int u_DirectionalLightCount;
+	float3 u_DirectionalLightDirections[k_MaxDirectionalLights];
+	float3 u_DirectionalLightColors[k_MaxDirectionalLights];
+	float2 u_ClusterTileSize;
+	float u_ClusterDepthScale;
+	float u_ClusterDepthBias;
+	float u_ClusterNear;
+	float u_ClusterFar;
+	int u_CascadeCount;
+	float4x4 u_CascadeMatrices[k_MaxCascades];
+	float u_CascadeSplits[k_MaxCascades];
+};
+
+struct Orca_Shader
+{
+	constant Orca_Uniforms* uniforms;
+	texture2d<float> u_AlbedoMap;
+	sampler u_AlbedoMap_Sampler;
+	texture_buffer<float> u_LightData;
+	texture_buffer<uint> u_ClusterGrid;
+	texture_buffer<uint> u_LightIndices;
+	depth2d_array<float> u_CascadeShadowMap;
+	sampler u_CascadeShadowMap_Sampler;
+	depth2d<float> u_ShadowAtlas;
+	sampler u_ShadowAtlas_Sampler;
+	texture_buffer<float> u_ShadowMatrices;
+	float4 gl_FragCoord;
+	float3 v_Normal;
+	float3 v_FragPos;
+	float2 v_TexCoords;
+	float3 v_AlbedoColor;
+	float4 FragColor;
+
+	float LinearDepth(float fragDepth)
+	{
+		float ndc = fragDepth * 2.0 - 1.0;
+		return 2.0 * uniforms->u_ClusterNear * uniforms->u_ClusterFar / (uniforms->u_ClusterFar + uniforms->u_ClusterNear - ndc * (uniforms->u_ClusterFar - uniforms->u_ClusterNear));
+	}
+
+	uint ClusterIndex()
+	{
+		uint2 tile = min(uint2(gl_FragCoord.xy / uniforms->u_ClusterTileSize), k_ClusterCount.xy - 1u);
+		float slice = log(LinearDepth(gl_FragCoord.z)) * uniforms->u_ClusterDepthScale + uniforms->u_ClusterDepthBias;
+		uint z = uint(clamp(slice, 0.0, float(k_ClusterCount.z - 1u)));
+		return (z * k_ClusterCount.y + tile.y) * k_ClusterCount.x + tile.x;
+	}
+
+	float DistanceAttenuation(float distance, float range)
+	{
+		float ratio = distance / range;
+		float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+		return window * window / (distance * distance + 1.0);
+	}
+
+	float3 ShadowPosition(float3 normal, float3 lightDir, float texelWorldSize)
+	{
+		float slope = 1.0 - max(dot(normal, lightDir), 0.0);
+		return v_FragPos + normal * texelWorldSize * (0.5 + 1.5 * slope);
+	}
+
+	float CascadeShadow(float3 normal, float3 lightDir)
+	{
+		float viewDepth = LinearDepth(gl_FragCoord.z);
+		float3 position = ShadowPosition(normal, lightDir, 0.02);
+		int first = 0;
+		while (first < uniforms->u_CascadeCount - 1 && viewDepth > uniforms->u_CascadeSplits[first])
+		{
+			first++;
+		}
+		if (viewDepth > uniforms->u_CascadeSplits[uniforms->u_CascadeCount - 1])
+		{
+			return 1.0;
+		}
+		for (int i = first; i < uniforms->u_CascadeCount; ++i)
+		{
+			float4 coord = uniforms->u_CascadeMatrices[i] * float4(position, 1.0);
+			if (any((coord.xyz < float3(0.0))) || any((coord.xyz > float3(1.0))))
+			{
+				continue;
+			}
+			float2 texel = 1.0 / float2(int3(int(u_CascadeShadowMap.get_width(uint(0))), int(u_CascadeShadowMap.get_height(uint(0))), int(u_CascadeShadowMap.get_array_size())).xy);
+			float shadow = 0.0;
+			shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(-0.5, -0.5) * texel, float(i), coord.z));
+			shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(0.5, -0.5) * texel, float(i), coord.z));
+			shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(-0.5, 0.5) * texel, float(i), coord.z));
+			shadow += orca_SampleShadow(u_CascadeShadowMap, u_CascadeShadowMap_Sampler, float4(coord.xy + float2(0.5, 0.5) * texel, float(i), coord.z));
+			return shadow * 0.25;
+		}
+		return 1.0;
+	}
+
+	float LocalShadow(int shadowIndex, int type, float3 lightPosition, float3 normal, float3 lightDir)
+	{
+		int matrixIndex = shadowIndex;
+		float3 position = ShadowPosition(normal, lightDir, 0.01 * length(lightPosition - v_FragPos));
+		if (type == 0)
+		{
+			float3 v = position - lightPosition;
+			float3 a = abs(v);
+			int face = a.x >= a.y && a.x >= a.z ? (v.x > 0.0 ? 0 : 1) : (a.y >= a.z ? (v.y > 0.0 ? 2 : 3) : (v.z > 0.0 ? 4 : 5));
+			matrixIndex += face;
+		}
+		int base = matrixIndex * 4;
+		float4x4 shadowMatrix = float4x4(u_ShadowMatrices.read(uint(base)), u_ShadowMatrices.read(uint(base + 1)), u_ShadowMatrices.read(uint(base + 2)), u_ShadowMatrices.read(uint(base + 3)));
+		float4 coord = shadowMatrix * float4(position, 1.0);
+		return orca_SampleShadow(u_ShadowAtlas, u_ShadowAtlas_Sampler, coord.xyz / coord.w);
+	}
+
+	void orca_main()
+	{
+		float3 normal = normalize(v_Normal);
+		float3 lighting = float3(0.0);
+		if (uniforms->u_DirectionalLightCount == 0)
+		{
+			lighting += max(dot(normal, normalize(float3(0.5, 1.0, 0.3))), 0.0) * float3(1.0);
+		}
+		for (int i = 0; i < uniforms->u_DirectionalLightCount; ++i)
+		{
+			float3 lightDir = -uniforms->u_DirectionalLightDirections[i];
+#ifdef RECEIVE_SHADOWS_OFF
+			float shadow = 1.0;
+#else
+			float shadow = (i == 0 && uniforms->u_CascadeCount > 0) ? CascadeShadow(normal, lightDir) : 1.0;
+#endif
+			lighting += max(dot(normal, lightDir), 0.0) * shadow * uniforms->u_DirectionalLightColors[i];
+		}
+		if (uniforms->u_ClusterTileSize.x > 0.0)
+		{
+			uint2 cluster = u_ClusterGrid.read(uint(int(ClusterIndex()))).xy;
+			for (uint i = 0u; i < cluster.y; ++i)
+			{
+				int light = int(u_LightIndices.read(uint(int(cluster.x + i))).x) * 4;
+				float4 positionRange = u_LightData.read(uint(light));
+				float4 colorType = u_LightData.read(uint(light + 1));
+				float3 toLight = positionRange.xyz - v_FragPos;
+				float distance = length(toLight);
+				float3 lightDir = toLight / max(distance, 1e-4);
+				float attenuation = DistanceAttenuation(distance, positionRange.w);
+				if (colorType.w > 0.5)
+				{
+					float4 directionCone = u_LightData.read(uint(light + 2));
+					float cosAngle = dot(-lightDir, directionCone.xyz);
+					attenuation *= smoothstep(directionCone.w, mix(directionCone.w, 1.0, 0.2), cosAngle);
+				}
+#ifndef RECEIVE_SHADOWS_OFF
+				int shadowIndex = int(u_LightData.read(uint(light + 3)).x);
+				if (shadowIndex >= 0 && attenuation > 0.0)
+				{
+					attenuation *= LocalShadow(shadowIndex, int(colorType.w + 0.5), positionRange.xyz, normal, lightDir);
+				}
+#endif
+				lighting += max(dot(normal, lightDir), 0.0) * attenuation * colorType.rgb;
+			}
+		}
+		float3 albedo = v_AlbedoColor;
+		if (uniforms->u_HasAlbedoMap != 0)
+		{
+			albedo *= u_AlbedoMap.sample(u_AlbedoMap_Sampler, v_TexCoords).rgb;
+		}
+		float3 diffuse = lighting * albedo;
+		float3 ambient = 0.1 * albedo;
+		FragColor = float4(ambient + diffuse, 1.0);
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float4 gl_FragCoord [[position]];
+	float3 v_Normal [[user(v_Normal)]];
+	float3 v_FragPos [[user(v_FragPos)]];
+	float2 v_TexCoords [[user(v_TexCoords)]];
+	float3 v_AlbedoColor [[user(v_AlbedoColor), flat]];
+};
+
+struct Orca_StageOut
+{
+	float4 FragColor [[color(0)]];
+};
+
+fragment Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]], constant Orca_Uniforms& uniforms [[buffer(16)]], texture2d<float> u_AlbedoMap [[texture(0)]], sampler u_AlbedoMap_Sampler [[sampler(0)]], texture_buffer<float> u_LightData [[texture(1)]], texture_buffer<uint> u_ClusterGrid [[texture(2)]], texture_buffer<uint> u_LightIndices [[texture(3)]], depth2d_array<float> u_CascadeShadowMap [[texture(4)]], sampler u_CascadeShadowMap_Sampler [[sampler(1)]], depth2d<float> u_ShadowAtlas [[texture(5)]], sampler u_ShadowAtlas_Sampler [[sampler(2)]], texture_buffer<float> u_ShadowMatrices [[texture(6)]])
+{
+	Orca_Shader shader;
+	shader.uniforms = &uniforms;
+	shader.u_AlbedoMap = u_AlbedoMap;
+	shader.u_AlbedoMap_Sampler = u_AlbedoMap_Sampler;
+	shader.u_LightData = u_LightData;
+	shader.u_ClusterGrid = u_ClusterGrid;
+	shader.u_LightIndices = u_LightIndices;
+	shader.u_CascadeShadowMap = u_CascadeShadowMap;
+	shader.u_CascadeShadowMap_Sampler = u_CascadeShadowMap_Sampler;
+	shader.u_ShadowAtlas = u_ShadowAtlas;
+	shader.u_ShadowAtlas_Sampler = u_ShadowAtlas_Sampler;
+	shader.u_ShadowMatrices = u_ShadowMatrices;
+	shader.gl_FragCoord = stageIn.gl_FragCoord;
+	shader.v_Normal = stageIn.v_Normal;
+	shader.v_FragPos = stageIn.v_FragPos;
+	shader.v_TexCoords = stageIn.v_TexCoords;
+	shader.v_AlbedoColor = stageIn.v_AlbedoColor;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.FragColor = shader.FragColor;
+	return stageOut;
+}
@@ -0,0 +1,102 @@
+// === VERTEX SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+struct Orca_Uniforms
+{
+	int u_UseInstanceData;
+	float4x4 u_Model;
+	float4x4 u_ViewProjection;
+	float3 u_PositionScale;
+	float3 u_PositionOffset;
+};
+
+struct Orca_Shader
+{
+	constant Orca_Uniforms* uniforms;
+	float3 a_Position;
+	float4x4 a_InstanceModel;
+	float4 a_InstancePositionScale;
+	float4 a_InstancePositionOffset;
+	float4 gl_Position;
+
+	void orca_main()
+	{
+		float4x4 model = uniforms->u_Model;
+		float3 positionScale = uniforms->u_PositionScale;
+		float3 positionOffset = uniforms->u_PositionOffset;
+		if (uniforms->u_UseInstanceData != 0)
+		{
+			model = a_InstanceModel;
+			positionScale = a_InstancePositionScale.xyz;
+			positionOffset = a_InstancePositionOffset.xyz;
+		}
+		gl_Position = uniforms->u_ViewProjection * model * float4(a_Position * positionScale + positionOffset, 1.0);
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float3 a_Position [[attribute(0)]];
+	float4 a_InstanceModel_0 [[attribute(4)]];
+	float4 a_InstanceModel_1 [[attribute(5)]];
+	float4 a_InstanceModel_2 [[attribute(6)]];
+	float4 a_InstanceModel_3 [[attribute(7)]];
+	float4 a_InstancePositionScale [[attribute(9)]];
+	float4 a_InstancePositionOffset [[attribute(10)]];
+};
+
+struct Orca_StageOut
+{
+	float4 gl_Position [[position]];
+};
+
+vertex Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]], constant Orca_Uniforms& uniforms [[buffer(16)]])
+{
+	Orca_Shader shader;
+	shader.uniforms = &uniforms;
+	shader.a_Position = stageIn.a_Position;
+	shader.a_InstanceModel = float4x4(stageIn.a_InstanceModel_0, stageIn.a_InstanceModel_1, stageIn.a_InstanceModel_2, stageIn.a_InstanceModel_3);
+	shader.a_InstancePositionScale = stageIn.a_InstancePositionScale;
+	shader.a_InstancePositionOffset = stageIn.a_InstancePositionOffset;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.gl_Position = shader.gl_Position;
+
+	// GL clip space depth is [-w, w], Metal expects [0, w].
+	stageOut.gl_Position.z = (stageOut.gl_Position.z + stageOut.gl_Position.w) * 0.5;
+	return stageOut;
+}
+
+
+// === FRAGMENT SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+struct Orca_Shader
+{
+	float4 gl_FragCoord;
+
+	void orca_main()
+	{
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float4 gl_FragCoord [[position]];
+};
+
+fragment void main0(Orca_StageIn stageIn [[stage_in]])
+{
+	Orca_Shader shader;
+	shader.gl_FragCoord = stageIn.gl_FragCoord;
+
+	shader.orca_main();
+}
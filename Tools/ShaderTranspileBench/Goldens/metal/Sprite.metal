@@ -0,0 +1,144 @@
+// === VERTEX SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+struct Orca_Uniforms
+{
+	float4x4 u_ViewProjection;
+};
+
+struct Orca_Shader
+{
+	constant Orca_Uniforms* uniforms;
+	float4 a_PositionSize;
+	float4 a_OriginRotation;
+	float4 a_UVRect;
+	float4 a_Color;
+	int gl_VertexID;
+	float4 gl_Position;
+	float3 v_TexCoord;
+	float4 v_Color;
+
+	void orca_main()
+	{
+		float2 corner = float2(gl_VertexID & 1, gl_VertexID >> 1);
+		float2 local = (corner - a_OriginRotation.xy) * a_PositionSize.zw;
+		float s = sin(a_OriginRotation.z);
+		float c = cos(a_OriginRotation.z);
+		float2 position = a_PositionSize.xy + float2(local.x * c - local.y * s, local.x * s + local.y * c);
+		v_TexCoord = float3(mix(a_UVRect.xy, a_UVRect.zw, corner), a_OriginRotation.w);
+		v_Color = a_Color;
+		gl_Position = uniforms->u_ViewProjection * float4(position, 0.0, 1.0);
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float4 a_PositionSize [[attribute(0)]];
+	float4 a_OriginRotation [[attribute(1)]];
+	float4 a_UVRect [[attribute(2)]];
+	float4 a_Color [[attribute(3)]];
+};
+
+struct Orca_StageOut
+{
+	float4 gl_Position [[position]];
+	float3 v_TexCoord [[user(v_TexCoord)]];
+	float4 v_Color [[user(v_Color)]];
+};
+
+vertex Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]], uint gl_VertexID [[vertex_id]], constant Orca_Uniforms& uniforms [[buffer(16)]])
+{
+	Orca_Shader shader;
+	shader.uniforms = &uniforms;
+	shader.a_PositionSize = stageIn.a_PositionSize;
+	shader.a_OriginRotation = stageIn.a_OriginRotation;
+	shader.a_UVRect = stageIn.a_UVRect;
+	shader.a_Color = stageIn.a_Color;
+	shader.gl_VertexID = gl_VertexID;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.gl_Position = shader.gl_Position;
+	stageOut.v_TexCoord = shader.v_TexCoord;
+	stageOut.v_Color = shader.v_Color;
+
+	// GL clip space depth is [-w, w], Metal expects [0, w].
+	stageOut.gl_Position.z = (stageOut.gl_Position.z + stageOut.gl_Position.w) * 0.5;
+	return stageOut;
+}
+
+
+// === FRAGMENT SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+float4 orca_SampleArray(texture2d_array<float> t, sampler s, float3 p) { return t.sample(s, p.xy, uint(rint(p.z))); }
+
+struct Orca_Uniforms
+{
+	int u_UseArray;
+};
+
+struct Orca_Shader
+{
+	constant Orca_Uniforms* uniforms;
+	texture2d<float> u_Texture;
+	sampler u_Texture_Sampler;
+	texture2d_array<float> u_TextureArray;
+	sampler u_TextureArray_Sampler;
+	float4 gl_FragCoord;
+	float3 v_TexCoord;
+	float4 v_Color;
+	float4 FragColor;
+
+	void orca_main()
+	{
+		float4 texel;
+		if (uniforms->u_UseArray != 0)
+		{
+			texel = orca_SampleArray(u_TextureArray, u_TextureArray_Sampler, v_TexCoord);
+		}
+		else
+		{
+			texel = u_Texture.sample(u_Texture_Sampler, v_TexCoord.xy);
+		}
+		FragColor = texel * v_Color;
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float4 gl_FragCoord [[position]];
+	float3 v_TexCoord [[user(v_TexCoord)]];
+	float4 v_Color [[user(v_Color)]];
+};
+
+struct Orca_StageOut
+{
+	float4 FragColor [[color(0)]];
+};
+
+fragment Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]], constant Orca_Uniforms& uniforms [[buffer(16)]], texture2d<float> u_Texture [[texture(0)]], sampler u_Texture_Sampler [[sampler(0)]], texture2d_array<float> u_TextureArray [[texture(1)]], sampler u_TextureArray_Sampler [[sampler(1)]])
+{
+	Orca_Shader shader;
+	shader.uniforms = &uniforms;
+	shader.u_Texture = u_Texture;
+	shader.u_Texture_Sampler = u_Texture_Sampler;
+	shader.u_TextureArray = u_TextureArray;
+	shader.u_TextureArray_Sampler = u_TextureArray_Sampler;
+	shader.gl_FragCoord = stageIn.gl_FragCoord;
+	shader.v_TexCoord = stageIn.v_TexCoord;
+	shader.v_Color = stageIn.v_Color;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.FragColor = shader.FragColor;
+	return stageOut;
+}
@@ -0,0 +1,116 @@
+// === VERTEX SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+struct Orca_Shader
+{
+	float2 a_Position;
+	float2 a_TexCoord;
+	float4 gl_Position;
+	float2 v_TexCoord;
+
+	void orca_main()
+	{
+		v_TexCoord = a_TexCoord;
+		gl_Position = float4(a_Position, 0.0, 1.0);
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float2 a_Position [[attribute(0)]];
+	float2 a_TexCoord [[attribute(1)]];
+};
+
+struct Orca_StageOut
+{
+	float4 gl_Position [[position]];
+	float2 v_TexCoord [[user(v_TexCoord)]];
+};
+
+vertex Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]])
+{
+	Orca_Shader shader;
+	shader.a_Position = stageIn.a_Position;
+	shader.a_TexCoord = stageIn.a_TexCoord;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.gl_Position = shader.gl_Position;
+	stageOut.v_TexCoord = shader.v_TexCoord;
+
+	// GL clip space depth is [-w, w], Metal expects [0, w].
+	stageOut.gl_Position.z = (stageOut.gl_Position.z + stageOut.gl_Position.w) * 0.5;
+	return stageOut;
+}
+
+
+// === FRAGMENT SHADER ===
+// Metal Shader Language
+#include <metal_stdlib>
+using namespace metal;
+
+struct Orca_Uniforms
+{
+	float2 u_SourceTexelSize;
+	float u_Sharpness;
+};
+
+struct Orca_Shader
+{
+	constant Orca_Uniforms* uniforms;
+	texture2d<float> u_Source;
+	sampler u_Source_Sampler;
+	float4 gl_FragCoord;
+	float2 v_TexCoord;
+	float4 FragColor;
+
+	void orca_main()
+	{
+		float3 center = u_Source.sample(u_Source_Sampler, v_TexCoord).rgb;
+		if (uniforms->u_Sharpness > 0.0)
+		{
+			float3 north = u_Source.sample(u_Source_Sampler, v_TexCoord + float2(0.0, uniforms->u_SourceTexelSize.y)).rgb;
+			float3 south = u_Source.sample(u_Source_Sampler, v_TexCoord - float2(0.0, uniforms->u_SourceTexelSize.y)).rgb;
+			float3 east = u_Source.sample(u_Source_Sampler, v_TexCoord + float2(uniforms->u_SourceTexelSize.x, 0.0)).rgb;
+			float3 west = u_Source.sample(u_Source_Sampler, v_TexCoord - float2(uniforms->u_SourceTexelSize.x, 0.0)).rgb;
+			float3 minimum = min(center, min(min(north, south), min(east, west)));
+			float3 maximum = max(center, max(max(north, south), max(east, west)));
+			float3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, float3(1e-4)), 0.0, 1.0));
+			float3 weight = -amount * mix(0.125, 0.2, clamp(uniforms->u_Sharpness, 0.0, 1.0));
+			center = clamp((center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight), 0.0, 1.0);
+		}
+		FragColor = float4(center, 1.0);
+	}
+
+};
+
+struct Orca_StageIn
+{
+	float4 gl_FragCoord [[position]];
+	float2 v_TexCoord [[user(v_TexCoord)]];
+};
+
+struct Orca_StageOut
+{
+	float4 FragColor [[color(0)]];
+};
+
+fragment Orca_StageOut main0(Orca_StageIn stageIn [[stage_in]], constant Orca_Uniforms& uniforms [[buffer(16)]], texture2d<float> u_Source [[texture(0)]], sampler u_Source_Sampler [[sampler(0)]])
+{
+	Orca_Shader shader;
+	shader.uniforms = &uniforms;
+	shader.u_Source = u_Source;
+	shader.u_Source_Sampler = u_Source_Sampler;
+	shader.gl_FragCoord = stageIn.gl_FragCoord;
+	shader.v_TexCoord = stageIn.v_TexCoord;
+
+	shader.orca_main();
+
+	Orca_StageOut stageOut;
+	stageOut.FragColor = shader.FragColor;
+	return stageOut;
+}
@@ -0,0 +1,31 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+layout(set = 0, binding = 0, std140) uniform Uniforms
+{
+	mat4 u_ViewProjection;
+};
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 0) out vec4 v_Color;
+
+void main()
+{
+	v_Color = a_Color;
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+
+
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+layout(location = 0) in vec4 v_Color;
+layout(location = 0) out vec4 FragColor;
+
+void main()
+{
+	FragColor = v_Color;
+}
+
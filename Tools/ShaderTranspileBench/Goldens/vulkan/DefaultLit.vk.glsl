@@ -0,0 +1,230 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+layout(set = 0, binding = 0, std140) uniform Uniforms
+{
+	int u_UseInstanceData;
+	mat4 u_Model;
+	vec3 u_AlbedoColor;
+	mat4 u_ViewProjection;
+	vec3 u_PositionScale;
+	vec3 u_PositionOffset;
+	int u_OctNormals;
+};
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec3 a_Normal;
+layout(location = 2) in vec2 a_TexCoords;
+layout(location = 4) in mat4 a_InstanceModel;
+layout(location = 8) in vec4 a_InstanceColor;
+layout(location = 9) in vec4 a_InstancePositionScale;
+layout(location = 10) in vec4 a_InstancePositionOffset;
+layout(location = 0) out vec3 v_Normal;
+layout(location = 1) out vec3 v_FragPos;
+layout(location = 2) out vec2 v_TexCoords;
+layout(location = 3) flat out vec3 v_AlbedoColor;
+
+vec3 OctDecode(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	if (n.z < 0.0)
+	{
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	}
+	return normalize(n);
+}
+
+void main()
+{
+	mat4 model = u_Model;
+	vec3 positionScale = u_PositionScale;
+	vec3 positionOffset = u_PositionOffset;
+	v_AlbedoColor = u_AlbedoColor;
+	if (u_UseInstanceData != 0)
+	{
+		model = a_InstanceModel;
+		positionScale = a_InstancePositionScale.xyz;
+		positionOffset = a_InstancePositionOffset.xyz;
+		v_AlbedoColor = a_InstanceColor.rgb;
+	}
+	vec3 position = a_Position * positionScale + positionOffset;
+	vec3 normal = u_OctNormals != 0 ? OctDecode(a_Normal.xy) : a_Normal;
+	v_FragPos = vec3(model * vec4(position, 1.0));
+	v_Normal = mat3(transpose(inverse(model))) * normal;
+	v_TexCoords = a_TexCoords;
+	gl_Position = u_ViewProjection * vec4(v_FragPos, 1.0);
+}
+
+
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+#pragma keywords RECEIVE_SHADOWS_OFF
+const int k_MaxDirectionalLights = 4;
+const uvec3 k_ClusterCount = uvec3(16u, 9u, 24u);
+const int k_MaxCascades = 4;
+
+layout(set = 0, binding = 0, std140) uniform Uniforms
+{
+	vec3 u_CameraPos;
+	float u_Metallic;
+	float u_Roughness;
+	int u_HasAlbedoMap;
+	int u_DirectionalLightCount;
+	vec3 u_DirectionalLightDirections[k_MaxDirectionalLights];
+	vec3 u_DirectionalLightColors[k_MaxDirectionalLights];
+	vec2 u_ClusterTileSize;
+	float u_ClusterDepthScale;
+	float u_ClusterDepthBias;
+	float u_ClusterNear;
+	float u_ClusterFar;
+	int u_CascadeCount;
+	mat4 u_CascadeMatrices[k_MaxCascades];
+	float u_CascadeSplits[k_MaxCascades];
+};
+
+layout(set = 0, binding = 1) uniform sampler2D u_AlbedoMap;
+layout(set = 0, binding = 2) uniform samplerBuffer u_LightData;
+layout(set = 0, binding = 3) uniform usamplerBuffer u_ClusterGrid;
+layout(set = 0, binding = 4) uniform usamplerBuffer u_LightIndices;
+layout(set = 0, binding = 5) uniform sampler2DArrayShadow u_CascadeShadowMap;
+layout(set = 0, binding = 6) uniform sampler2DShadow u_ShadowAtlas;
+layout(set = 0, binding = 7) uniform samplerBuffer u_ShadowMatrices;
+layout(location = 0) in vec3 v_Normal;
+layout(location = 1) in vec3 v_FragPos;
+layout(location = 2) in vec2 v_TexCoords;
+layout(location = 3) flat in vec3 v_AlbedoColor;
+layout(location = 0) out vec4 FragColor;
+
+float LinearDepth(float fragDepth)
+{
+	float ndc = fragDepth * 2.0 - 1.0;
+	return 2.0 * u_ClusterNear * u_ClusterFar / (u_ClusterFar + u_ClusterNear - ndc * (u_ClusterFar - u_ClusterNear));
+}
+
+uint ClusterIndex()
+{
+	uvec2 tile = min(uvec2(gl_FragCoord.xy / u_ClusterTileSize), k_ClusterCount.xy - 1u);
+	float slice = log(LinearDepth(gl_FragCoord.z)) * u_ClusterDepthScale + u_ClusterDepthBias;
+	uint z = uint(clamp(slice, 0.0, float(k_ClusterCount.z - 1u)));
+	return (z * k_ClusterCount.y + tile.y) * k_ClusterCount.x + tile.x;
+}
+
+float DistanceAttenuation(float distance, float range)
+{
+	float ratio = distance / range;
+	float window = clamp(1.0 - ratio * ratio * ratio * ratio, 0.0, 1.0);
+	return window * window / (distance * distance + 1.0);
+}
+
+vec3 ShadowPosition(vec3 normal, vec3 lightDir, float texelWorldSize)
+{
+	float slope = 1.0 - max(dot(normal, lightDir), 0.0);
+	return v_FragPos + normal * texelWorldSize * (0.5 + 1.5 * slope);
+}
+
+float CascadeShadow(vec3 normal, vec3 lightDir)
+{
+	float viewDepth = LinearDepth(gl_FragCoord.z);
+	vec3 position = ShadowPosition(normal, lightDir, 0.02);
+	int first = 0;
+	while (first < u_CascadeCount - 1 && viewDepth > u_CascadeSplits[first])
+	{
+		first++;
+	}
+	if (viewDepth > u_CascadeSplits[u_CascadeCount - 1])
+	{
+		return 1.0;
+	}
+	for (int i = first; i < u_CascadeCount; ++i)
+	{
+		vec4 coord = u_CascadeMatrices[i] * vec4(position, 1.0);
+		if (any(lessThan(coord.xyz, vec3(0.0))) || any(greaterThan(coord.xyz, vec3(1.0))))
+		{
+			continue;
+		}
+		vec2 texel = 1.0 / vec2(textureSize(u_CascadeShadowMap, 0).xy);
+		float shadow = 0.0;
+		shadow += texture(u_CascadeShadowMap, vec4(coord.xy + vec2(-0.5, -0.5) * texel, float(i), coord.z));
+		shadow += texture(u_CascadeShadowMap, vec4(coord.xy + vec2(0.5, -0.5) * texel, float(i), coord.z));
+		shadow += texture(u_CascadeShadowMap, vec4(coord.xy + vec2(-0.5, 0.5) * texel, float(i), coord.z));
+		shadow += texture(u_CascadeShadowMap, vec4(coord.xy + vec2(0.5, 0.5) * texel, float(i), coord.z));
+		return shadow * 0.25;
+	}
+	return 1.0;
+}
+
+float LocalShadow(int shadowIndex, int type, vec3 lightPosition, vec3 normal, vec3 lightDir)
+{
+	int matrixIndex = shadowIndex;
+	vec3 position = ShadowPosition(normal, lightDir, 0.01 * length(lightPosition - v_FragPos));
+	if (type == 0)
+	{
+		vec3 v = position - lightPosition;
+		vec3 a = abs(v);
+		int face = a.x >= a.y && a.x >= a.z ? (v.x > 0.0 ? 0 : 1) : (a.y >= a.z ? (v.y > 0.0 ? 2 : 3) : (v.z > 0.0 ? 4 : 5));
+		matrixIndex += face;
+	}
+	int base = matrixIndex * 4;
+	mat4 shadowMatrix = mat4(texelFetch(u_ShadowMatrices, base), texelFetch(u_ShadowMatrices, base + 1), texelFetch(u_ShadowMatrices, base + 2), texelFetch(u_ShadowMatrices, base + 3));
+	vec4 coord = shadowMatrix * vec4(position, 1.0);
+	return texture(u_ShadowAtlas, coord.xyz / coord.w);
+}
+
+void main()
+{
+	vec3 normal = normalize(v_Normal);
+	vec3 lighting = vec3(0.0);
+	if (u_DirectionalLightCount == 0)
+	{
+		lighting += max(dot(normal, normalize(vec3(0.5, 1.0, 0.3))), 0.0) * vec3(1.0);
+	}
+	for (int i = 0; i < u_DirectionalLightCount; ++i)
+	{
+		vec3 lightDir = -u_DirectionalLightDirections[i];
+#ifdef RECEIVE_SHADOWS_OFF
+		float shadow = 1.0;
+#else
+		float shadow = (i == 0 && u_CascadeCount > 0) ? CascadeShadow(normal, lightDir) : 1.0;
+#endif
+		lighting += max(dot(normal, lightDir), 0.0) * shadow * u_DirectionalLightColors[i];
+	}
+	if (u_ClusterTileSize.x > 0.0)
+	{
+		uvec2 cluster = texelFetch(u_ClusterGrid, int(ClusterIndex())).xy;
+		for (uint i = 0u; i < cluster.y; ++i)
+		{
+			int light = int(texelFetch(u_LightIndices, int(cluster.x + i)).x) * 4;
+			vec4 positionRange = texelFetch(u_LightData, light);
+			vec4 colorType = texelFetch(u_LightData, light + 1);
+			vec3 toLight = positionRange.xyz - v_FragPos;
+			float distance = length(toLight);
+			vec3 lightDir = toLight / max(distance, 1e-4);
+			float attenuation = DistanceAttenuation(distance, positionRange.w);
+			if (colorType.w > 0.5)
+			{
+				vec4 directionCone = texelFetch(u_LightData, light + 2);
+				float cosAngle = dot(-lightDir, directionCone.xyz);
+				attenuation *= smoothstep(directionCone.w, mix(directionCone.w, 1.0, 0.2), cosAngle);
+			}
+#ifndef RECEIVE_SHADOWS_OFF
+			int shadowIndex = int(texelFetch(u_LightData, light + 3).x);
+			if (shadowIndex >= 0 && attenuation > 0.0)
+			{
+				attenuation *= LocalShadow(shadowIndex, int(colorType.w + 0.5), positionRange.xyz, normal, lightDir);
+			}
+#endif
+			lighting += max(dot(normal, lightDir), 0.0) * attenuation * colorType.rgb;
+		}
+	}
+	vec3 albedo = v_AlbedoColor;
+	if (u_HasAlbedoMap != 0)
+	{
+		albedo *= texture(u_AlbedoMap, v_TexCoords).rgb;
+	}
+	vec3 diffuse = lighting * albedo;
+	vec3 ambient = 0.1 * albedo;
+	FragColor = vec4(ambient + diffuse, 1.0);
+}
+
@@ -0,0 +1,41 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+layout(set = 0, binding = 0, std140) uniform Uniforms
+{
+	int u_UseInstanceData;
+	mat4 u_Model;
+	mat4 u_ViewProjection;
+	vec3 u_PositionScale;
+	vec3 u_PositionOffset;
+};
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 4) in mat4 a_InstanceModel;
+layout(location = 9) in vec4 a_InstancePositionScale;
+layout(location = 10) in vec4 a_InstancePositionOffset;
+
+void main()
+{
+	mat4 model = u_Model;
+	vec3 positionScale = u_PositionScale;
+	vec3 positionOffset = u_PositionOffset;
+	if (u_UseInstanceData != 0)
+	{
+		model = a_InstanceModel;
+		positionScale = a_InstancePositionScale.xyz;
+		positionOffset = a_InstancePositionOffset.xyz;
+	}
+	gl_Position = u_ViewProjection * model * vec4(a_Position * positionScale + positionOffset, 1.0);
+}
+
+
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+
+void main()
+{
+}
+
@@ -0,0 +1,57 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+layout(set = 0, binding = 0, std140) uniform Uniforms
+{
+	mat4 u_ViewProjection;
+};
+
+layout(location = 0) in vec4 a_PositionSize;
+layout(location = 1) in vec4 a_OriginRotation;
+layout(location = 2) in vec4 a_UVRect;
+layout(location = 3) in vec4 a_Color;
+layout(location = 0) out vec3 v_TexCoord;
+layout(location = 1) out vec4 v_Color;
+
+void main()
+{
+	vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+	vec2 local = (corner - a_OriginRotation.xy) * a_PositionSize.zw;
+	float s = sin(a_OriginRotation.z);
+	float c = cos(a_OriginRotation.z);
+	vec2 position = a_PositionSize.xy + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+	v_TexCoord = vec3(mix(a_UVRect.xy, a_UVRect.zw, corner), a_OriginRotation.w);
+	v_Color = a_Color;
+	gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
+}
+
+
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+layout(set = 0, binding = 0, std140) uniform Uniforms
+{
+	int u_UseArray;
+};
+
+layout(set = 0, binding = 1) uniform sampler2D u_Texture;
+layout(set = 0, binding = 2) uniform sampler2DArray u_TextureArray;
+layout(location = 0) in vec3 v_TexCoord;
+layout(location = 1) in vec4 v_Color;
+layout(location = 0) out vec4 FragColor;
+
+void main()
+{
+	vec4 texel;
+	if (u_UseArray != 0)
+	{
+		texel = texture(u_TextureArray, v_TexCoord);
+	}
+	else
+	{
+		texel = texture(u_Texture, v_TexCoord.xy);
+	}
+	FragColor = texel * v_Color;
+}
+
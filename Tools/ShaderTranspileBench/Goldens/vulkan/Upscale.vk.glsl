@@ -0,0 +1,46 @@
+// === VERTEX SHADER ===
+#version 450 core
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoord;
+layout(location = 0) out vec2 v_TexCoord;
+
+void main()
+{
+	v_TexCoord = a_TexCoord;
+	gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+
+
+// === FRAGMENT SHADER ===
+#version 450 core
+
+layout(set = 0, binding = 0, std140) uniform Uniforms
+{
+	vec2 u_SourceTexelSize;
+	float u_Sharpness;
+};
+
+layout(set = 0, binding = 1) uniform sampler2D u_Source;
+layout(location = 0) in vec2 v_TexCoord;
+layout(location = 0) out vec4 FragColor;
+
+void main()
+{
+	vec3 center = texture(u_Source, v_TexCoord).rgb;
+	if (u_Sharpness > 0.0)
+	{
+		vec3 north = texture(u_Source, v_TexCoord + vec2(0.0, u_SourceTexelSize.y)).rgb;
+		vec3 south = texture(u_Source, v_TexCoord - vec2(0.0, u_SourceTexelSize.y)).rgb;
+		vec3 east = texture(u_Source, v_TexCoord + vec2(u_SourceTexelSize.x, 0.0)).rgb;
+		vec3 west = texture(u_Source, v_TexCoord - vec2(u_SourceTexelSize.x, 0.0)).rgb;
+		vec3 minimum = min(center, min(min(north, south), min(east, west)));
+		vec3 maximum = max(center, max(max(north, south), max(east, west)));
+		vec3 amount = sqrt(clamp(min(minimum, 1.0 - maximum) / max(maximum, vec3(1e-4)), 0.0, 1.0));
+		vec3 weight = -amount * mix(0.125, 0.2, clamp(u_Sharpness, 0.0, 1.0));
+		center = clamp((center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight), 0.0, 1.0);
+	}
+	FragColor = vec4(center, 1.0);
+}
+
@@ -0,0 +1,245 @@
+#include "LegacyShaderTranspiler.h"
+#include "Core/Logger.h"
+#include <regex>
+#include <sstream>
+
+namespace Orca
+{
+	TranspilationResult LegacyShaderTranspiler::Transpile(const std::string& glslSource, ShaderTarget target, ShaderStage stage)
+	{
+		if (glslSource.empty())
+		{
+			return { false, "", {}, "Input shader source is empty" };
+		}
+
+		if (glslSource.find("{") == std::string::npos || glslSource.find("}") == std::string::npos)
+		{
+			return { false, "", {}, "ERROR: Missing curly braces in shader source. Please fix the problem." };
+		}
+
+		try
+		{
+			TranspilationResult result;
+
+			switch (target)
+			{
+			case ShaderTarget::GLSL:
+				result = { true, glslSource, {}, "" };
+				break;
+			case ShaderTarget::HLSL:
+				result = TranspileToHLSL(glslSource, stage);
+				break;
+			case ShaderTarget::Vulkan:
+				result = TranspileToVulkan(glslSource, stage);
+				break;
+			default:
+				result = { false, "", {}, "The legacy pipeline has no text output for this target" };
+			}
+
+			if (result.success)
+			{
+				Logger::Log(LogLevel::Info, "Shader transpilation successful");
+			}
+			else
+			{
+				Logger::Log(LogLevel::Error, "Shader transpilation failed: " + result.errorMessage);
+			}
+
+			return result;
+		}
+		catch (const std::exception& e)
+		{
+			return { false, "", {}, std::string("Transpilation exception: ") + e.what() };
+		}
+	}
+
+	TranspilationResult LegacyShaderTranspiler::TranspileProgram(const std::string& vertexSource, const std::string& fragmentSource, ShaderTarget target)
+	{
+		auto vertResult = Transpile(vertexSource, target, ShaderStage::Vertex);
+		if (!vertResult.success)
+		{
+			return vertResult;
+		}
+
+		auto fragResult = Transpile(fragmentSource, target, ShaderStage::Fragment);
+		if (!fragResult.success)
+		{
+			return fragResult;
+		}
+
+		std::string combined = "// === VERTEX SHADER ===\n" + vertResult.output +
+							   "\n\n// === FRAGMENT SHADER ===\n" + fragResult.output;
+
+		return { true, combined, {}, "" };
+	}
+
+	TranspilationResult LegacyShaderTranspiler::TranspileToHLSL(const std::string& glslSource, ShaderStage stage)
+	{
+		std::string cleanedSource = std::regex_replace(glslSource, std::regex(R"(#version\s+\d+\s*\n)"), "");
+
+		std::string converted = ConvertUniformDeclarations(cleanedSource, ShaderTarget::HLSL);
+		converted = ConvertAttributeDeclarations(converted, ShaderTarget::HLSL, stage);
+		converted = ConvertVaryingDeclarations(converted, ShaderTarget::HLSL, stage);
+		converted = ConvertBuiltinFunctions(converted, ShaderTarget::HLSL);
+		converted = ConvertMatrixOperations(converted, ShaderTarget::HLSL);
+
+		converted = ReplaceGLSLBuiltins(converted, ShaderTarget::HLSL, stage);
+
+		std::string hlsl = ShaderTranspiler::GetTargetVersionString(ShaderTarget::HLSL) + "\n";
+
+		// The old code tested the header rather than the body, so this never fired; kept as it was.
+		if (hlsl.find("inverse") != std::string::npos)
+		{
+			hlsl = R"(
+				float4x4 inverse(float4x4 m) {
+					// In a real engine, you'd inject a full matrix inversion here
+					// or pass the inverse matrix as a separate uniform.
+					return m; // Placeholder: this will stop the error but math will be wrong
+				})" + hlsl;
+		}
+
+		hlsl += converted;
+
+		return { true, hlsl, {}, "" };
+	}
+
+	TranspilationResult LegacyShaderTranspiler::TranspileToVulkan(const std::string& glslSource, ShaderStage stage)
+	{
+		std::string output = "#version 450 core\n\n" + glslSource;
+		return { true, output, {}, "" };
+	}
+
+	std::vector<UniformBinding> LegacyShaderTranspiler::ExtractUniforms(const std::string& glslSource)
+	{
+		std::vector<UniformBinding> uniforms;
+		std::regex uniformRegex(R"(uniform\s+(\w+)\s+(\w+);)");
+		std::smatch match;
+
+		std::string::const_iterator searchStart(glslSource.cbegin());
+		while (std::regex_search(searchStart, glslSource.cend(), match, uniformRegex))
+		{
+			UniformBinding binding;
+			binding.type = match[1].str();
+			binding.name = match[2].str();
+			binding.binding = static_cast<int>(uniforms.size());
+			binding.set = 0;
+			uniforms.push_back(binding);
+
+			searchStart = match.suffix().first;
+		}
+
+		return uniforms;
+	}
+
+	std::string LegacyShaderTranspiler::ReplaceGLSLBuiltins(const std::string& source, ShaderTarget target, ShaderStage stage)
+	{
+		std::string output = source;
+
+		if (target == ShaderTarget::HLSL)
+		{
+			if (stage == ShaderStage::Vertex)
+			{
+				output = std::regex_replace(output, std::regex(R"(\bgl_Position\b)"), "position");
+			}
+			else
+			{
+				output = std::regex_replace(output, std::regex(R"(\bgl_FragColor\b)"), "output");
+			}
+		}
+
+		return output;
+	}
+
+	std::string LegacyShaderTranspiler::ConvertUniformDeclarations(const std::string& source, ShaderTarget target)
+	{
+		if (target != ShaderTarget::HLSL) return source;
+
+		auto uniforms = ExtractUniforms(source);
+		if (uniforms.empty()) return source;
+
+		std::stringstream ss;
+		ss << "cbuffer Uniforms : register(b0)\n{\n";
+		for (const auto& uniform : uniforms)
+		{
+			std::string hlslType = uniform.type;
+			if (hlslType == "vec2") hlslType = "float2";
+			else if (hlslType == "vec3") hlslType = "float3";
+			else if (hlslType == "vec4") hlslType = "float4";
+			else if (hlslType == "mat3") hlslType = "float3x3";
+			else if (hlslType == "mat4") hlslType = "float4x4";
+			ss << "    " << hlslType << " " << uniform.name << ";\n";
+		}
+
+		std::string cleanedSource = std::regex_replace(source, std::regex(R"(uniform\s+.*?)"), "");
+		return ss.str() + cleanedSource;
+	}
+
+	std::string LegacyShaderTranspiler::ConvertAttributeDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage)
+	{
+		std::string output = source;
+
+		if (stage != ShaderStage::Vertex) return output;
+
+		if (target == ShaderTarget::HLSL)
+		{
+			output = std::regex_replace(output, std::regex(R"(layout\s*\(\s*location\s*=\s*(\d+)\s*\)\s*in\s+(\w+)\s+(\w+);)"),
+				"$2 $3 : TEXCOORD$1;");
+		}
+
+		return output;
+	}
+
+	std::string LegacyShaderTranspiler::ConvertVaryingDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage)
+	{
+		std::string output = source;
+
+		if (target == ShaderTarget::HLSL)
+		{
+			if (stage == ShaderStage::Vertex)
+			{
+				output = std::regex_replace(output, std::regex(R"(\bout\s+(\w+)\s+(\w+);)"),
+					"$1 $2 : TEXCOORD0;");
+			}
+			else
+			{
+				output = std::regex_replace(output, std::regex(R"(\bin\s+(\w+)\s+(\w+);)"),
+					"$1 $2 : TEXCOORD0;");
+			}
+		}
+
+		return output;
+	}
+
+	std::string LegacyShaderTranspiler::ConvertMatrixOperations(const std::string& source, ShaderTarget target)
+	{
+		if (target != ShaderTarget::HLSL) return source;
+
+		std::string output = source;
+		std::regex mathRegex(R"((\w+)\s*\*\s*([\w\d\(\).]+))");
+
+		output = std::regex_replace(output, mathRegex, "mul($1, $2)");
+
+		return output;
+	}
+
+	std::string LegacyShaderTranspiler::ConvertBuiltinFunctions(const std::string& source, ShaderTarget target)
+	{
+		std::string output = source;
+
+		if (target == ShaderTarget::HLSL)
+		{
+			output = std::regex_replace(output, std::regex(R"(\bnormalize\b)"), "normalize");
+			output = std::regex_replace(output, std::regex(R"(\bdot\b)"), "dot");
+			output = std::regex_replace(output, std::regex(R"(\bmax\b)"), "max");
+			output = std::regex_replace(output, std::regex(R"(\btranspose\b)"), "transpose");
+			output = std::regex_replace(output, std::regex(R"(\binverse\b)"), "inverse");
+			output = std::regex_replace(output, std::regex(R"(\bmat3\b)"), "float3x3");
+			output = std::regex_replace(output, std::regex(R"(\bmat4\b)"), "float4x4");
+			output = std::regex_replace(output, std::regex(R"(\bvec2\b)"), "float2");
+			output = std::regex_replace(output, std::regex(R"(\bvec3\b)"), "float3");
+			output = std::regex_replace(output, std::regex(R"(\bvec4\b)"), "float4");
+		}
+
+		return output;
+	}
+}
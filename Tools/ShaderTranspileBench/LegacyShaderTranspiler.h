@@ -0,0 +1,39 @@
+// The regex-based transpiler the engine used before ShaderIR, kept only as a baseline for
+// OrcaShaderTranspileBench. It is the old ShaderTranspiler's text passes, unchanged, minus the
+// dxc/glslang/spirv-cross runs: those wrote temp files and spawned processes, and their results
+// never fed back into the text. Metal went through glslang and spirv-cross entirely, so there is
+// no legacy Metal output to compare against.
+
+#pragma once
+
+#ifndef LEGACY_SHADER_TRANSPILER_H
+#define LEGACY_SHADER_TRANSPILER_H
+
+#include "Renderer/ShaderTranspiler.h"
+#include <string>
+#include <vector>
+
+namespace Orca
+{
+	class LegacyShaderTranspiler
+	{
+	public:
+		// HLSL and Vulkan only.
+		TranspilationResult Transpile(const std::string& glslSource, ShaderTarget target, ShaderStage stage);
+		TranspilationResult TranspileProgram(const std::string& vertexSource, const std::string& fragmentSource, ShaderTarget target);
+
+	private:
+		TranspilationResult TranspileToHLSL(const std::string& glslSource, ShaderStage stage);
+		TranspilationResult TranspileToVulkan(const std::string& glslSource, ShaderStage stage);
+
+		std::vector<UniformBinding> ExtractUniforms(const std::string& glslSource);
+		std::string ReplaceGLSLBuiltins(const std::string& source, ShaderTarget target, ShaderStage stage);
+		std::string ConvertUniformDeclarations(const std::string& source, ShaderTarget target);
+		std::string ConvertAttributeDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage);
+		std::string ConvertVaryingDeclarations(const std::string& source, ShaderTarget target, ShaderStage stage);
+		std::string ConvertMatrixOperations(const std::string& source, ShaderTarget target);
+		std::string ConvertBuiltinFunctions(const std::string& source, ShaderTarget target);
+	};
+}
+
+#endif
@@ -0,0 +1,473 @@
+// OrcaShaderTranspileBench: checks ShaderTranspiler output against golden files and times it
+// against the regex pipeline it replaced.
+//
+//   OrcaShaderTranspileBench <shaderDir> <goldenDir> [--update] [--capture-legacy]
+//                            [--variants <count>] [--no-bench] [--verbose]
+//
+// From the solution directory: OrcaShaderTranspileBench Source/Runtime/Shaders Tools/ShaderTranspileBench/Goldens
+//
+// Goldens are <goldenDir>/<target>/<Program><ext>, one per .vert/.frag pair. An output that differs
+// from its golden fails the run; after a deliberate emitter change, rerun with --update, review the
+// golden diff and bump ShaderTranspiler::k_Version. <goldenDir>/Legacy/ holds what the regex
+// pipeline (LegacyShaderTranspiler) made of the same sources. It is for reference only: each run
+// reports how much of it the current output still shares, and --capture-legacy regenerates it.
+//
+// The benchmark builds keyword variants the way ShaderVariantSet does, a "#define NAME" after
+// #version for each enabled "#pragma keywords" name, cycling through every program's permutations
+// until --variants programs are made. Each pipeline then transpiles all of them to HLSL and Vulkan
+// on this thread, with the transpile cache off.
+
+#include "Core/Logger.h"
+#include "Renderer/ShaderTranspiler.h"
+#include "LegacyShaderTranspiler.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Orca;
+
+namespace
+{
+	struct TargetInfo
+	{
+		ShaderTarget Target;
+		const char* Name;
+		const char* Extension;
+		bool Legacy;			// The regex pipeline had text output for it
+	};
+
+	constexpr TargetInfo k_Targets[] =
+	{
+		{ ShaderTarget::HLSL, "hlsl", ".hlsl", true },
+		{ ShaderTarget::Vulkan, "vulkan", ".vk.glsl", true },
+		{ ShaderTarget::Metal, "metal", ".metal", false }
+	};
+
+	constexpr uint32_t k_MaxKeywords = 8;
+
+	struct Program
+	{
+		std::string Name;
+		std::string VertexSource;
+		std::string FragmentSource;
+		std::vector<std::string> Keywords;
+	};
+
+	struct Options
+	{
+		fs::path ShaderDir;
+		fs::path GoldenDir;
+		uint32_t Variants = 300;
+		bool Update = false;
+		bool CaptureLegacy = false;
+		bool Bench = true;
+		bool Verbose = false;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: OrcaShaderTranspileBench <shaderDir> <goldenDir> [--update] [--capture-legacy]\n"
+					 "                                [--variants <count>] [--no-bench] [--verbose]\n";
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		std::vector<std::string> positional;
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+
+			if (arg == "--variants" && i + 1 < argc)
+			{
+				options.Variants = static_cast<uint32_t>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--update")
+			{
+				options.Update = true;
+			}
+			else if (arg == "--capture-legacy")
+			{
+				options.CaptureLegacy = true;
+			}
+			else if (arg == "--no-bench")
+			{
+				options.Bench = false;
+			}
+			else if (arg == "--verbose")
+			{
+				options.Verbose = true;
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				std::cerr << "Unknown option: " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				positional.push_back(arg);
+			}
+		}
+
+		if (positional.size() != 2)
+		{
+			return false;
+		}
+
+		options.ShaderDir = positional[0];
+		options.GoldenDir = positional[1];
+		return true;
+	}
+
+	// Drops carriage returns, so goldens compare equal whatever line endings git checked them out with.
+	bool ReadFile(const fs::path& path, std::string& out)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::ostringstream contents;
+		contents << file.rdbuf();
+		out = contents.str();
+		out.erase(std::remove(out.begin(), out.end(), '\r'), out.end());
+		return true;
+	}
+
+	bool WriteFile(const fs::path& path, const std::string& contents)
+	{
+		std::error_code error;
+		fs::create_directories(path.parent_path(), error);
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			Logger::Log(LogLevel::Error, "Can't write " + path.string());
+			return false;
+		}
+
+		file << contents;
+		return true;
+	}
+
+	std::vector<std::string> SplitLines(const std::string& text)
+	{
+		std::vector<std::string> lines;
+		std::istringstream stream(text);
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			lines.push_back(line);
+		}
+		return lines;
+	}
+
+	// Same parse as ShaderVariantSet::ParseKeywords.
+	void ParseKeywords(const std::string& source, std::vector<std::string>& keywords)
+	{
+		std::istringstream lines(source);
+		std::string line;
+		while (std::getline(lines, line))
+		{
+			std::istringstream tokens(line);
+			std::string directive, pragma;
+			tokens >> directive >> pragma;
+			if (directive != "#pragma" || pragma != "keywords")
+			{
+				continue;
+			}
+
+			std::string keyword;
+			while (tokens >> keyword)
+			{
+				if (keywords.size() < k_MaxKeywords && std::find(keywords.begin(), keywords.end(), keyword) == keywords.end())
+				{
+					keywords.push_back(keyword);
+				}
+			}
+		}
+	}
+
+	// Same placement as Shader::InjectDefines.
+	std::string InjectDefines(const std::string& source, const std::vector<std::string>& defines)
+	{
+		if (defines.empty())
+		{
+			return source;
+		}
+
+		std::string block;
+		for (const std::string& define : defines)
+		{
+			block += "#define " + define + "\n";
+		}
+
+		size_t insertAt = 0;
+		if (source.compare(0, 8, "#version") == 0)
+		{
+			const size_t lineEnd = source.find('\n');
+			if (lineEnd == std::string::npos)
+			{
+				return source + "\n" + block;
+			}
+			insertAt = lineEnd + 1;
+		}
+
+		std::string result = source;
+		result.insert(insertAt, block);
+		return result;
+	}
+
+	// Pairs <name>.vert with <name>.frag the same way RenderSystem does at startup.
+	std::vector<Program> CollectPrograms(const fs::path& shaderDir)
+	{
+		std::map<std::string, fs::path> vertexPaths;
+		std::map<std::string, fs::path> fragmentPaths;
+
+		for (const auto& entry : fs::directory_iterator(shaderDir))
+		{
+			if (!entry.is_regular_file()) continue;
+
+			const std::string name = entry.path().stem().string();
+			const std::string ext = entry.path().extension().string();
+
+			if (ext == ".vert") vertexPaths[name] = entry.path();
+			else if (ext == ".frag") fragmentPaths[name] = entry.path();
+		}
+
+		std::vector<Program> programs;
+		for (const auto& [name, vertexPath] : vertexPaths)
+		{
+			auto fragment = fragmentPaths.find(name);
+			if (fragment == fragmentPaths.end())
+			{
+				Logger::Log(LogLevel::Warning, "No fragment shader for " + name + ", skipped");
+				continue;
+			}
+
+			Program program{ name };
+			if (!ReadFile(vertexPath, program.VertexSource) || !ReadFile(fragment->second, program.FragmentSource))
+			{
+				Logger::Log(LogLevel::Error, "Can't read sources for " + name);
+				continue;
+			}
+
+			ParseKeywords(program.VertexSource, program.Keywords);
+			ParseKeywords(program.FragmentSource, program.Keywords);
+			programs.push_back(std::move(program));
+		}
+		return programs;
+	}
+
+	// Length of the longest common subsequence of lines: how much of the legacy output survived.
+	size_t CountCommonLines(const std::vector<std::string>& a, const std::vector<std::string>& b)
+	{
+		std::vector<size_t> previous(b.size() + 1, 0);
+		std::vector<size_t> current(b.size() + 1, 0);
+		for (size_t i = 1; i <= a.size(); ++i)
+		{
+			for (size_t j = 1; j <= b.size(); ++j)
+			{
+				current[j] = a[i - 1] == b[j - 1] ? previous[j - 1] + 1 : std::max(previous[j], current[j - 1]);
+			}
+			std::swap(previous, current);
+		}
+		return previous[b.size()];
+	}
+
+	void ReportMismatch(const std::string& label, const std::string& expected, const std::string& actual)
+	{
+		const std::vector<std::string> expectedLines = SplitLines(expected);
+		const std::vector<std::string> actualLines = SplitLines(actual);
+
+		size_t line = 0;
+		while (line < expectedLines.size() && line < actualLines.size() && expectedLines[line] == actualLines[line])
+		{
+			line++;
+		}
+
+		std::cout << "FAIL " << label << ": differs from the golden at line " << line + 1 << "\n"
+				  << "  golden: " << (line < expectedLines.size() ? expectedLines[line] : "<end of file>") << "\n"
+				  << "  output: " << (line < actualLines.size() ? actualLines[line] : "<end of file>") << "\n";
+	}
+
+	// Returns the number of outputs that failed to transpile or didn't match their golden.
+	uint32_t CheckGoldens(const std::vector<Program>& programs, const Options& options)
+	{
+		uint32_t failures = 0;
+		uint32_t updated = 0;
+
+		for (const Program& program : programs)
+		{
+			for (const TargetInfo& target : k_Targets)
+			{
+				const std::string label = program.Name + " (" + target.Name + ")";
+
+				ShaderTranspiler transpiler;
+				const TranspilationResult result = transpiler.TranspileProgram(program.VertexSource, program.FragmentSource, target.Target);
+				if (!result.success)
+				{
+					std::cout << "FAIL " << label << ": " << result.errorMessage << "\n";
+					failures++;
+					continue;
+				}
+
+				const fs::path goldenPath = options.GoldenDir / target.Name / (program.Name + target.Extension);
+				std::string golden;
+				const bool hasGolden = ReadFile(goldenPath, golden);
+
+				if (options.Update)
+				{
+					if (!hasGolden || golden != result.output)
+					{
+						updated += WriteFile(goldenPath, result.output) ? 1 : 0;
+					}
+				}
+				else if (!hasGolden)
+				{
+					std::cout << "FAIL " << label << ": no golden at " << goldenPath.string() << "\n";
+					failures++;
+				}
+				else if (golden != result.output)
+				{
+					ReportMismatch(label, golden, result.output);
+					failures++;
+				}
+
+				if (!target.Legacy)
+				{
+					continue;
+				}
+
+				const fs::path legacyPath = options.GoldenDir / "Legacy" / target.Name / (program.Name + target.Extension);
+				std::string legacy;
+				if (options.CaptureLegacy)
+				{
+					LegacyShaderTranspiler legacyTranspiler;
+					legacy = legacyTranspiler.TranspileProgram(program.VertexSource, program.FragmentSource, target.Target).output;
+					WriteFile(legacyPath, legacy);
+				}
+				else if (!ReadFile(legacyPath, legacy))
+				{
+					continue;
+				}
+
+				if (options.Verbose)
+				{
+					const std::vector<std::string> legacyLines = SplitLines(legacy);
+					const std::vector<std::string> outputLines = SplitLines(result.output);
+					std::cout << "     " << label << ": " << outputLines.size() << " lines, "
+							  << CountCommonLines(legacyLines, outputLines) << " of the legacy output's " << legacyLines.size() << " unchanged\n";
+				}
+			}
+		}
+
+		if (options.Update)
+		{
+			std::cout << updated << " goldens updated\n";
+		}
+		return failures;
+	}
+
+	template<typename Transpiler>
+	double TimeVariants(const std::vector<Program>& variants)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (const Program& variant : variants)
+		{
+			for (const TargetInfo& target : k_Targets)
+			{
+				if (!target.Legacy)
+				{
+					continue;
+				}
+
+				Transpiler transpiler;
+				const TranspilationResult result = transpiler.TranspileProgram(variant.VertexSource, variant.FragmentSource, target.Target);
+				if (!result.success)
+				{
+					Logger::Log(LogLevel::Warning, variant.Name + " (" + target.Name + "): " + result.errorMessage);
+				}
+			}
+		}
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void RunBenchmark(const std::vector<Program>& programs, uint32_t count)
+	{
+		std::vector<Program> variants;
+		variants.reserve(count);
+		for (uint32_t mask = 0; variants.size() < count; ++mask)
+		{
+			for (const Program& program : programs)
+			{
+				if (variants.size() == count)
+				{
+					break;
+				}
+
+				const uint32_t permutations = 1u << program.Keywords.size();
+				std::vector<std::string> defines;
+				for (size_t bit = 0; bit < program.Keywords.size(); ++bit)
+				{
+					if ((mask % permutations) & (1u << bit))
+					{
+						defines.push_back(program.Keywords[bit]);
+					}
+				}
+
+				variants.push_back({ program.Name, InjectDefines(program.VertexSource, defines), InjectDefines(program.FragmentSource, defines) });
+			}
+		}
+
+		const double legacyMs = TimeVariants<LegacyShaderTranspiler>(variants);
+		const double currentMs = TimeVariants<ShaderTranspiler>(variants);
+
+		std::cout << std::fixed << std::setprecision(2)
+				  << variants.size() << " variants to hlsl + vulkan:\n"
+				  << "  regex pipeline  " << std::setw(10) << legacyMs << " ms  (" << legacyMs / variants.size() << " ms per variant)\n"
+				  << "  ShaderIR        " << std::setw(10) << currentMs << " ms  (" << currentMs / variants.size() << " ms per variant)\n"
+				  << "  " << std::setprecision(1) << legacyMs / std::max(currentMs, 0.001) << "x faster\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	// Both pipelines log every success; only problems are interesting here.
+	Logger::SetLogLevel(options.Verbose ? LogLevel::Info : LogLevel::Warning);
+
+	std::error_code error;
+	if (!fs::is_directory(options.ShaderDir, error))
+	{
+		Logger::Log(LogLevel::Error, "Shader directory not found: " + options.ShaderDir.string());
+		Logger::Shutdown();
+		return 1;
+	}
+
+	const std::vector<Program> programs = CollectPrograms(options.ShaderDir);
+	const uint32_t failures = CheckGoldens(programs, options);
+	std::cout << programs.size() << " programs x " << std::size(k_Targets) << " targets checked, " << failures << " failed\n";
+
+	if (options.Bench && !programs.empty() && options.Variants > 0)
+	{
+		RunBenchmark(programs, options.Variants);
+	}
+
+	Logger::Shutdown();
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+// OrcaTextureCook: cooks every image in a directory to block-compressed KTX2 ahead of time.
+//
+//   OrcaTextureCook <sourceDir> <outputDir> [--format auto|bc1|bc3|bc5|bc7] [--srgb]
+//                   [--normal-suffix <suffix>] [--no-mips] [--jobs <count>] [--clean] [--verbose]
+//
+// Images are cooked in parallel on the engine JobSystem by TextureCooker::CookFolder, to
+// <outputDir>/<name>.ktx2. Outputs newer than their source are left alone, so a rerun only cooks
+// what changed; --clean deletes the existing .ktx2 files first. Point materials at the cooked
+// files and Texture and TextureStreamer upload them as stored, mips included.
+
+#include "Core/JobSystem.h"
+#include "Core/Logger.h"
+#include "Asset/Image/TextureCooker.h"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace Orca;
+
+namespace
+{
+	struct FormatInfo
+	{
+		const char* Name;
+		TextureFormat Format;
+	};
+
+	constexpr FormatInfo k_Formats[] =
+	{
+		{ "bc1", TextureFormat::BC1 },
+		{ "bc3", TextureFormat::BC3 },
+		{ "bc5", TextureFormat::BC5 },
+		{ "bc7", TextureFormat::BC7 }
+	};
+
+	struct Options
+	{
+		fs::path SourceDir;
+		fs::path OutputDir;
+		TextureCookSettings Settings;
+		unsigned int Jobs = 0;
+		bool Clean = false;
+		bool Verbose = false;
+	};
+
+	void PrintUsage()
+	{
+		std::cout << "Usage: OrcaTextureCook <sourceDir> <outputDir> [--format auto|bc1|bc3|bc5|bc7] [--srgb]\n"
+					 "                       [--normal-suffix <suffix>] [--no-mips] [--jobs <count>] [--clean] [--verbose]\n";
+	}
+
+	bool ParseFormat(const std::string& name, TextureCookSettings& settings)
+	{
+		if (name == "auto")
+		{
+			settings.AutoFormat = true;
+			return true;
+		}
+
+		for (const FormatInfo& format : k_Formats)
+		{
+			if (name == format.Name)
+			{
+				settings.AutoFormat = false;
+				settings.Format = format.Format;
+				return true;
+			}
+		}
+
+		std::cerr << "Unknown format: " << name << "\n";
+		return false;
+	}
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		std::vector<std::string> positional;
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+
+			if (arg == "--format" && hasValue)
+			{
+				if (!ParseFormat(argv[++i], options.Settings))
+				{
+					return false;
+				}
+			}
+			else if (arg == "--normal-suffix" && hasValue)
+			{
+				options.Settings.NormalMapSuffix = argv[++i];
+			}
+			else if (arg == "--srgb")
+			{
+				options.Settings.SRGB = true;
+			}
+			else if (arg == "--no-mips")
+			{
+				options.Settings.GenerateMips = false;
+			}
+			else if (arg == "--jobs" && hasValue)
+			{
+				options.Jobs = static_cast<unsigned int>(std::stoul(argv[++i]));
+			}
+			else if (arg == "--clean")
+			{
+				options.Clean = true;
+			}
+			else if (arg == "--verbose")
+			{
+				options.Verbose = true;
+			}
+			else if (!arg.empty() && arg[0] == '-')
+			{
+				std::cerr << "Unknown option: " << arg << "\n";
+				return false;
+			}
+			else
+			{
+				positional.push_back(arg);
+			}
+		}
+
+		if (positional.size() != 2)
+		{
+			return false;
+		}
+
+		options.SourceDir = positional[0];
+		options.OutputDir = positional[1];
+		return true;
+	}
+
+	void RemoveCookedFiles(const fs::path& outputDir)
+	{
+		std::error_code error;
+		for (const auto& entry : fs::directory_iterator(outputDir, error))
+		{
+			if (entry.is_regular_file() && entry.path().extension() == ".ktx2")
+			{
+				fs::remove(entry.path(), error);
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	Logger::SetLogLevel(options.Verbose ? LogLevel::Info : LogLevel::Warning);
+
+	std::error_code error;
+	if (!fs::is_directory(options.SourceDir, error))
+	{
+		Logger::Log(LogLevel::Error, "Source directory not found: " + options.SourceDir.string());
+		Logger::Shutdown();
+		return 1;
+	}
+
+	if (options.Clean)
+	{
+		RemoveCookedFiles(options.OutputDir);
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	JobSystem::Initialize(options.Jobs);
+	const TextureCookStats stats = TextureCooker::CookFolder(options.SourceDir.string(), options.OutputDir.string(), options.Settings);
+	JobSystem::Shutdown();
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+	std::cout << stats.Cooked << " cooked, " << stats.UpToDate << " up to date, " << stats.Failed << " failed ("
+			  << elapsed.count() << " ms)\n";
+
+	Logger::Shutdown();
+	return stats.Failed == 0 ? 0 : 1;
+}